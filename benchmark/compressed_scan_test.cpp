@@ -0,0 +1,157 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <mutex>
+#include <stdexcept>
+#include <string.h>
+#include <sys/stat.h>
+#include <benchmark/benchmark.h>
+
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/table/table.h"
+#include "storage/trx/vacuous_trx.h"
+#include "common/log/log.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 全表扫描一张比缓冲池大很多的表，比较数据页面压缩和不压缩时的磁盘读取量和扫描速度
+ * @details 两张表的数据相同，有小范围的整数和重复较多的字符串，接近常见的业务数据。
+ * 缓冲池只有128个页面，每次扫描都要从文件中重新加载页面。
+ * 文件内容通常在操作系统的页缓存中，这里的耗时主要体现解压的开销，read_bytes 体现磁盘IO量的变化。
+ */
+class PageCompressionBenchmark : public Fixture
+{
+public:
+  static constexpr int RECORD_NUM = 100000;
+
+  virtual void SetUp(const State &state)
+  {
+    call_once(init_flag_, []() { init_tables(); });
+  }
+
+  void Scan(State &state, Table &table)
+  {
+    VacuousTrx      trx;
+    DiskBufferPool *buffer_pool = table.data_buffer_pool();
+    int64_t         count       = 0;
+    buffer_pool->reset_io_stats();
+    for (auto _ : state) {
+      RecordFileScanner scanner;
+      RC rc = table.get_record_scanner(scanner, &trx, true /*readonly*/);
+      if (rc != RC::SUCCESS) {
+        state.SkipWithError("failed to open record scanner");
+        return;
+      }
+
+      Record record;
+      while (scanner.has_next()) {
+        if (scanner.next(record) != RC::SUCCESS) {
+          state.SkipWithError("failed to scan record");
+          return;
+        }
+        count++;
+      }
+      scanner.close_scan();
+    }
+
+    DoNotOptimize(count);
+    const BPIoStats &stats = buffer_pool->io_stats();
+    state.SetItemsProcessed(state.iterations() * RECORD_NUM);
+    state.counters["read_bytes"] = Counter(static_cast<double>(stats.read_bytes) / state.iterations());
+    state.counters["read_pages"] = Counter(static_cast<double>(stats.read_count) / state.iterations());
+    state.counters["disk_bytes"] = Counter(static_cast<double>(disk_usage(table)));
+  }
+
+private:
+  static int64_t disk_usage(Table &table)
+  {
+    struct stat st;
+    if (fstat(table.data_buffer_pool()->file_desc(), &st) != 0) {
+      return -1;
+    }
+    return static_cast<int64_t>(st.st_blocks) * 512;
+  }
+
+  static void init_table(Table &table, const char *table_name, PageCompression page_compression)
+  {
+    const string meta_file = string(table_name) + ".table";
+    ::remove(meta_file.c_str());
+    ::remove((string(table_name) + ".data").c_str());
+
+    vector<AttrInfoSqlNode> attrs(4);
+    attrs[0] = AttrInfoSqlNode{INTS, "id", sizeof(int32_t), false};
+    attrs[1] = AttrInfoSqlNode{INTS, "status", sizeof(int32_t), false};
+    attrs[2] = AttrInfoSqlNode{FLOATS, "price", sizeof(float), false};
+    attrs[3] = AttrInfoSqlNode{CHARS, "city", 16, false};
+    RC rc = table.create(1, meta_file.c_str(), table_name, ".", static_cast<int>(attrs.size()), attrs.data(),
+        StorageFormat::ROW, page_compression);
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to create table");
+    }
+
+    const char *cities[] = {"beijing", "shanghai", "hangzhou", "shenzhen", "chengdu"};
+    vector<Value>  values(attrs.size());
+    for (int32_t i = 0; i < RECORD_NUM; i++) {
+      values[0] = Value(i);
+      values[1] = Value(i % 3);
+      values[2] = Value(static_cast<float>(i % 100) + 0.5f);
+      values[3] = Value(cities[i / 7 % 5]);
+
+      Record record;
+      rc = table.make_record(static_cast<int>(values.size()), values.data(), record);
+      if (rc == RC::SUCCESS) {
+        rc = table.insert_record(record);
+      }
+      if (rc != RC::SUCCESS) {
+        throw runtime_error("failed to insert record");
+      }
+    }
+
+    rc = table.sync();
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to sync table");
+    }
+  }
+
+  static void init_tables()
+  {
+    LoggerFactory::init_default("page_compression.log", LOG_LEVEL_WARN);
+    BufferPoolManager::set_instance(&bpm_);
+    RC rc = TrxKit::init_global("vacuous");
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to init trx kit");
+    }
+
+    init_table(plain_table_, "page_compression_none", PageCompression::NONE);
+    init_table(lz4_table_, "page_compression_lz4", PageCompression::LZ4);
+  }
+
+protected:
+  static once_flag         init_flag_;
+  static BufferPoolManager bpm_;
+  static Table             plain_table_;
+  static Table             lz4_table_;
+};
+
+once_flag         PageCompressionBenchmark::init_flag_;
+BufferPoolManager PageCompressionBenchmark::bpm_{1024};
+Table             PageCompressionBenchmark::plain_table_;
+Table             PageCompressionBenchmark::lz4_table_;
+
+BENCHMARK_DEFINE_F(PageCompressionBenchmark, ScanNone)(State &state) { Scan(state, plain_table_); }
+BENCHMARK_DEFINE_F(PageCompressionBenchmark, ScanLz4)(State &state) { Scan(state, lz4_table_); }
+
+BENCHMARK_REGISTER_F(PageCompressionBenchmark, ScanNone);
+BENCHMARK_REGISTER_F(PageCompressionBenchmark, ScanLz4);
+
+BENCHMARK_MAIN();
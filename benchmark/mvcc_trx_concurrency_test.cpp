@@ -0,0 +1,103 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+
+#include "storage/trx/mvcc_trx.h"
+#include "common/log/log.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 测试大量很小的事务时，事务管理本身的开销
+ * @details 每个事务只做事务的创建、开始、可见性判断、提交和销毁，不访问表数据，也不写日志
+ */
+class MvccTrxBenchmark : public Fixture
+{
+public:
+  virtual void SetUp(const State &state)
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    LoggerFactory::init_default("mvcc_trx.log", LOG_LEVEL_WARN);
+    trx_kit_ = new MvccTrxKit();
+    [[maybe_unused]] RC rc = trx_kit_->init();
+    ASSERT(rc == RC::SUCCESS, "failed to init trx kit. rc=%s", strrc(rc));
+  }
+
+  virtual void TearDown(const State &state)
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    delete trx_kit_;
+    trx_kit_ = nullptr;
+  }
+
+  /**
+   * @brief 一个事务的完整过程
+   * @param visits 事务中做多少次可见性判断
+   */
+  void RunTrx(int visits, int64_t &visible_count)
+  {
+    MvccTrx *trx = static_cast<MvccTrx *>(trx_kit_->create_trx(nullptr /*log_manager*/));
+    trx_kit_->start_trx(*trx);
+
+    shared_ptr<const MvccReadView> read_view = trx_kit_->read_view(*trx);
+    // 判断最近的一些提交是否可见，这些提交事务号最可能在活跃事务中
+    for (int32_t xid = read_view->high() - visits; xid < read_view->high(); xid++) {
+      if (read_view->visible(xid)) {
+        visible_count++;
+      }
+    }
+
+    const int32_t commit_xid = trx_kit_->start_commit(*trx);
+    trx_kit_->finish_trx(*trx, commit_xid);
+    trx_kit_->destroy_trx(trx);
+  }
+
+protected:
+  MvccTrxKit *trx_kit_ = nullptr;
+};
+
+BENCHMARK_DEFINE_F(MvccTrxBenchmark, TinyTrx)(State &state)
+{
+  int64_t visible_count = 0;
+  for (auto _ : state) {
+    RunTrx(static_cast<int>(state.range(0)), visible_count);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.counters["visible"] = Counter(visible_count, Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(MvccTrxBenchmark, TinyTrx)->Threads(1)->Threads(4)->Threads(16)->Arg(0)->Arg(16);
+
+////////////////////////////////////////////////////////////////////////////////
+
+BENCHMARK_DEFINE_F(MvccTrxBenchmark, ReadView)(State &state)
+{
+  for (auto _ : state) {
+    shared_ptr<const MvccReadView> read_view = trx_kit_->read_view();
+    DoNotOptimize(read_view->low());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_REGISTER_F(MvccTrxBenchmark, ReadView)->Threads(1)->Threads(16);
+
+////////////////////////////////////////////////////////////////////////////////
+
+BENCHMARK_MAIN();
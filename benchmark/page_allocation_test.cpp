@@ -0,0 +1,78 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <benchmark/benchmark.h>
+
+#include "storage/buffer/disk_buffer_pool.h"
+#include "common/log/log.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 模拟批量导入数据，不断分配新的页面并写满数据
+ * @details 每次迭代分配一个页面。writes_per_page 是每个页面写磁盘的次数，包括分配页面时扩展文件的写入，
+ * 以及缓冲区满了之后淘汰页面的写入。
+ */
+class PageAllocationBenchmark : public Fixture
+{
+public:
+  void SetUp(const State &state) override
+  {
+    LoggerFactory::init_default("page_allocation.log", LOG_LEVEL_WARN);
+    ::remove(file_name_);
+    bpm_ = new BufferPoolManager(static_cast<int>(state.range(0)) * BP_PAGE_SIZE);
+    RC rc = bpm_->create_file(file_name_);
+    if (rc == RC::SUCCESS) {
+      rc = bpm_->open_file(file_name_, buffer_pool_);
+    }
+    ASSERT(rc == RC::SUCCESS, "failed to open buffer pool file. rc=%s", strrc(rc));
+  }
+
+  void TearDown(const State &state) override
+  {
+    bpm_->close_file(file_name_);
+    delete bpm_;
+    bpm_ = nullptr;
+    ::remove(file_name_);
+  }
+
+protected:
+  const char        *file_name_   = "page_allocation.bp";
+  BufferPoolManager *bpm_         = nullptr;
+  DiskBufferPool    *buffer_pool_ = nullptr;
+};
+
+BENCHMARK_DEFINE_F(PageAllocationBenchmark, BulkLoad)(State &state)
+{
+  for (auto _ : state) {
+    Frame *frame = nullptr;
+    RC     rc    = buffer_pool_->allocate_page(&frame);
+    if (rc != RC::SUCCESS) {
+      state.SkipWithError("failed to allocate page");
+      break;
+    }
+    memset(frame->data(), 1, BP_PAGE_DATA_SIZE);
+    frame->mark_dirty();
+    buffer_pool_->unpin_page(frame);
+  }
+  buffer_pool_->flush_all_pages();
+
+  state.SetItemsProcessed(state.iterations());
+  state.counters["writes_per_page"] =
+      Counter(static_cast<double>(buffer_pool_->io_stats().write_count) / state.iterations());
+}
+
+// 参数是缓冲区能放下的页面个数
+BENCHMARK_REGISTER_F(PageAllocationBenchmark, BulkLoad)->Arg(256)->Iterations(20000);
+
+BENCHMARK_MAIN();
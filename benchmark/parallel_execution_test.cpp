@@ -0,0 +1,212 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <mutex>
+#include <stdexcept>
+#include <benchmark/benchmark.h>
+
+#include "sql/expr/expression.h"
+#include "sql/operator/aggr_physical_operator.h"
+#include "sql/operator/chunk_to_row_physical_operator.h"
+#include "sql/operator/morsel_queue.h"
+#include "sql/operator/parallel_hash_join_physical_operator.h"
+#include "sql/operator/table_scan_physical_operator.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/table/table.h"
+#include "storage/trx/vacuous_trx.h"
+#include "common/log/log.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 比较不同并行度的扫描聚合和哈希连接
+ * @details 参数是并行度，即共享同一个 MorselQueue 的扫描流水线个数，每个流水线由一个线程执行
+ */
+class ParallelExecutionBenchmark : public Fixture
+{
+public:
+  static constexpr int FIELD_NUM  = 4;
+  static constexpr int RECORD_NUM = 400000;
+  static constexpr int DIM_NUM    = 1000;
+
+  virtual void SetUp(const State &state)
+  {
+    call_once(init_flag_, []() { init_table(); });
+  }
+
+  /**
+   * @brief select sum(f1) from t where f0 < 50
+   * @details 创建 dop 个 扫描 + 过滤 的流水线，由同一个聚合算子汇总
+   */
+  static unique_ptr<PhysicalOperator> create_scan_plan(int dop)
+  {
+    const FieldMeta *f0 = table_.table_meta().field("f0");
+    const FieldMeta *f1 = table_.table_meta().field("f1");
+
+    vector<Expression *> aggr_exprs{new AggregationExpr(Field(&table_, f1), SUM_AGGR_T)};
+    unique_ptr<PhysicalOperator> oper(new AggrPhysicalOperator(aggr_exprs, {}, {}));
+
+    auto morsel_queue = make_shared<MorselQueue>(table_.data_buffer_pool()->page_count());
+    for (int i = 0; i < dop; i++) {
+      vector<unique_ptr<Expression>> predicates;
+      predicates.emplace_back(new ComparisonExpr(
+          LESS_THAN, make_unique<FieldExpr>(&table_, f0), make_unique<ValueExpr>(Value(50))));
+
+      auto scan_oper = make_unique<TableScanPhysicalOperator>(&table_, true /*readonly*/);
+      scan_oper->set_predicates(std::move(predicates));
+      scan_oper->set_projection({Field(&table_, f0), Field(&table_, f1)});
+      scan_oper->set_morsel_queue(morsel_queue);
+      oper->add_child(std::move(scan_oper));
+    }
+
+    unique_ptr<PhysicalOperator> chunk_to_row_oper(new ChunkToRowPhysicalOperator);
+    chunk_to_row_oper->add_child(std::move(oper));
+    return chunk_to_row_oper;
+  }
+
+  /**
+   * @brief select sum(fact.f2) from t fact, t dim where fact.f0 = dim.f1 and dim.f1 <= DIM_NUM
+   * @details 模拟事实表和维度表的星型连接：用前 DIM_NUM 行作为维度表构建哈希表，整个表作为事实表探测。
+   * 构建端和探测端都是 dop 个流水线
+   */
+  static unique_ptr<PhysicalOperator> create_join_plan(int dop)
+  {
+    const Field f0(&table_, table_.table_meta().field("f0"));
+    const Field f1(&table_, table_.table_meta().field("f1"));
+    const Field f2(&table_, table_.table_meta().field("f2"));
+
+    vector<unique_ptr<Expression>> build_keys;
+    build_keys.emplace_back(new FieldExpr(f1));
+    auto build = make_shared<ParallelHashJoinBuild>(std::move(build_keys), vector<Field>{f1}, 1LL << 30);
+
+    vector<Expression *> aggr_exprs{new AggregationExpr(f2, SUM_AGGR_T)};
+    unique_ptr<PhysicalOperator> oper(new AggrPhysicalOperator(aggr_exprs, {}, {}));
+
+    auto probe_queue = make_shared<MorselQueue>(table_.data_buffer_pool()->page_count());
+    auto build_queue = make_shared<MorselQueue>(table_.data_buffer_pool()->page_count());
+    for (int i = 0; i < dop; i++) {
+      auto probe_oper = make_unique<TableScanPhysicalOperator>(&table_, true /*readonly*/);
+      probe_oper->set_projection({f0, f2});
+      probe_oper->set_morsel_queue(probe_queue);
+
+      vector<unique_ptr<Expression>> probe_keys;
+      probe_keys.emplace_back(new FieldExpr(f0));
+      auto join_oper = make_unique<ParallelHashJoinPhysicalOperator>(std::move(probe_keys), build, true /*build_left*/);
+      join_oper->add_child(std::move(probe_oper));
+      oper->add_child(std::move(join_oper));
+    }
+
+    // 构建端的流水线都放在第一个连接算子中
+    PhysicalOperator *owner = oper->children().front().get();
+    for (int i = 0; i < dop; i++) {
+      vector<unique_ptr<Expression>> predicates;
+      predicates.emplace_back(
+          new ComparisonExpr(LESS_EQUAL, make_unique<FieldExpr>(f1), make_unique<ValueExpr>(Value(DIM_NUM))));
+
+      auto build_oper = make_unique<TableScanPhysicalOperator>(&table_, true /*readonly*/);
+      build_oper->set_predicates(std::move(predicates));
+      build_oper->set_projection({f1});
+      build_oper->set_morsel_queue(build_queue);
+      owner->add_child(std::move(build_oper));
+    }
+    return oper;
+  }
+
+  void Execute(State &state, unique_ptr<PhysicalOperator> (*create_plan)(int))
+  {
+    VacuousTrx trx;
+    int        result_rows = 0;
+    for (auto _ : state) {
+      unique_ptr<PhysicalOperator> oper = create_plan(static_cast<int>(state.range(0)));
+
+      RC rc = oper->open(&trx);
+      if (rc != RC::SUCCESS) {
+        state.SkipWithError("failed to open plan");
+        return;
+      }
+
+      while (RC::SUCCESS == (rc = oper->next())) {
+        result_rows++;
+      }
+      oper->close();
+      if (rc != RC::RECORD_EOF) {
+        state.SkipWithError("failed to execute plan");
+        return;
+      }
+    }
+
+    DoNotOptimize(result_rows);
+    state.SetItemsProcessed(state.iterations() * RECORD_NUM);
+  }
+
+private:
+  static void init_table()
+  {
+    LoggerFactory::init_default("parallel_execution.log", LOG_LEVEL_WARN);
+    BufferPoolManager::set_instance(&bpm_);
+    RC rc = TrxKit::init_global("vacuous");
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to init trx kit");
+    }
+
+    const char *table_name = "parallel_execution";
+    const string meta_file = string(table_name) + ".table";
+    ::remove(meta_file.c_str());
+    ::remove((string(table_name) + ".data").c_str());
+
+    vector<AttrInfoSqlNode> attrs(FIELD_NUM);
+    for (int i = 0; i < FIELD_NUM; i++) {
+      attrs[i].type     = INTS;
+      attrs[i].name     = "f" + to_string(i);
+      attrs[i].length   = sizeof(int32_t);
+      attrs[i].nullable = false;
+    }
+    rc = table_.create(1, meta_file.c_str(), table_name, ".", FIELD_NUM, attrs.data());
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to create table");
+    }
+
+    vector<Value> values(FIELD_NUM);
+    for (int32_t i = 0; i < RECORD_NUM; i++) {
+      values[0] = Value(i % 100);
+      for (int f = 1; f < FIELD_NUM; f++) {
+        values[f] = Value(i + f);
+      }
+
+      Record record;
+      rc = table_.make_record(FIELD_NUM, values.data(), record);
+      if (rc == RC::SUCCESS) {
+        rc = table_.insert_record(record);
+      }
+      if (rc != RC::SUCCESS) {
+        throw runtime_error("failed to insert record");
+      }
+    }
+  }
+
+protected:
+  static once_flag         init_flag_;
+  static BufferPoolManager bpm_;
+  static Table             table_;
+};
+
+once_flag         ParallelExecutionBenchmark::init_flag_;
+BufferPoolManager ParallelExecutionBenchmark::bpm_{8192};
+Table             ParallelExecutionBenchmark::table_;
+
+BENCHMARK_DEFINE_F(ParallelExecutionBenchmark, ScanAggregate)(State &state) { Execute(state, create_scan_plan); }
+BENCHMARK_DEFINE_F(ParallelExecutionBenchmark, HashJoin)(State &state) { Execute(state, create_join_plan); }
+
+BENCHMARK_REGISTER_F(ParallelExecutionBenchmark, ScanAggregate)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+BENCHMARK_REGISTER_F(ParallelExecutionBenchmark, HashJoin)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+BENCHMARK_MAIN();
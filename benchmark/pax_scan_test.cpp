@@ -0,0 +1,137 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <mutex>
+#include <stdexcept>
+#include <string.h>
+#include <benchmark/benchmark.h>
+
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/table/table.h"
+#include "storage/trx/vacuous_trx.h"
+#include "common/log/log.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 在一张宽表上计算一个字段的和，比较行存和列存(PAX)的表
+ * @details 两张表的数据相同，都有 FIELD_NUM 个整数字段。直接使用记录扫描器，列存的表只读取需要的字段
+ */
+class PaxScanBenchmark : public Fixture
+{
+public:
+  static constexpr int FIELD_NUM  = 16;
+  static constexpr int RECORD_NUM = 50000;
+
+  virtual void SetUp(const State &state)
+  {
+    call_once(init_flag_, []() { init_tables(); });
+  }
+
+  void Sum(State &state, Table &table)
+  {
+    VacuousTrx       trx;
+    const FieldMeta *field = table.table_meta().field(table.table_meta().sys_field_num());
+    int64_t          sum   = 0;
+    for (auto _ : state) {
+      RecordFileScanner scanner;
+      RC rc = table.get_record_scanner(scanner, &trx, true /*readonly*/, {field});
+      if (rc != RC::SUCCESS) {
+        state.SkipWithError("failed to open record scanner");
+        return;
+      }
+
+      Record record;
+      while (scanner.has_next()) {
+        if (scanner.next(record) != RC::SUCCESS) {
+          state.SkipWithError("failed to scan record");
+          return;
+        }
+        int32_t value;
+        memcpy(&value, record.data() + field->offset(), sizeof(value));
+        sum += value;
+      }
+      scanner.close_scan();
+    }
+
+    DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * RECORD_NUM);
+  }
+
+private:
+  static void init_table(Table &table, const char *table_name, StorageFormat storage_format)
+  {
+    const string meta_file = string(table_name) + ".table";
+    ::remove(meta_file.c_str());
+    ::remove((string(table_name) + ".data").c_str());
+
+    vector<AttrInfoSqlNode> attrs(FIELD_NUM);
+    for (int i = 0; i < FIELD_NUM; i++) {
+      attrs[i].type     = INTS;
+      attrs[i].name     = "f" + to_string(i);
+      attrs[i].length   = sizeof(int32_t);
+      attrs[i].nullable = false;
+    }
+    RC rc = table.create(1, meta_file.c_str(), table_name, ".", FIELD_NUM, attrs.data(), storage_format);
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to create table");
+    }
+
+    vector<Value> values(FIELD_NUM);
+    for (int32_t i = 0; i < RECORD_NUM; i++) {
+      for (int f = 0; f < FIELD_NUM; f++) {
+        values[f] = Value(i + f);
+      }
+
+      Record record;
+      rc = table.make_record(FIELD_NUM, values.data(), record);
+      if (rc == RC::SUCCESS) {
+        rc = table.insert_record(record);
+      }
+      if (rc != RC::SUCCESS) {
+        throw runtime_error("failed to insert record");
+      }
+    }
+  }
+
+  static void init_tables()
+  {
+    LoggerFactory::init_default("pax_scan.log", LOG_LEVEL_WARN);
+    BufferPoolManager::set_instance(&bpm_);
+    RC rc = TrxKit::init_global("vacuous");
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to init trx kit");
+    }
+
+    init_table(row_table_, "pax_scan_row", StorageFormat::ROW);
+    init_table(columnar_table_, "pax_scan_columnar", StorageFormat::COLUMNAR);
+  }
+
+protected:
+  static once_flag         init_flag_;
+  static BufferPoolManager bpm_;
+  static Table             row_table_;
+  static Table             columnar_table_;
+};
+
+once_flag         PaxScanBenchmark::init_flag_;
+BufferPoolManager PaxScanBenchmark::bpm_{1024};
+Table             PaxScanBenchmark::row_table_;
+Table             PaxScanBenchmark::columnar_table_;
+
+BENCHMARK_DEFINE_F(PaxScanBenchmark, RowSum)(State &state) { Sum(state, row_table_); }
+BENCHMARK_DEFINE_F(PaxScanBenchmark, ColumnarSum)(State &state) { Sum(state, columnar_table_); }
+
+BENCHMARK_REGISTER_F(PaxScanBenchmark, RowSum);
+BENCHMARK_REGISTER_F(PaxScanBenchmark, ColumnarSum);
+
+BENCHMARK_MAIN();
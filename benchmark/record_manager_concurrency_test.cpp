@@ -250,7 +250,8 @@ BENCHMARK_DEFINE_F(InsertionBenchmark, Insertion)(State &state)
   state.counters["other"]   = Counter(stat.insert_other_count, Counter::kIsRate);
 }
 
-BENCHMARK_REGISTER_F(InsertionBenchmark, Insertion)->Threads(10);
+// 不同线程数下的插入吞吐，用来观察并发插入是否能扩展
+BENCHMARK_REGISTER_F(InsertionBenchmark, Insertion)->ThreadRange(1, 16)->UseRealTime();
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,162 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <mutex>
+#include <stdexcept>
+#include <strings.h>
+#include <benchmark/benchmark.h>
+
+#include "sql/operator/table_scan_physical_operator.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/table/table.h"
+#include "storage/trx/vacuous_trx.h"
+#include "common/log/log.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 全表扫描并读取每一列，比较 NULL 位图和以前在字段中保存 "null" 字符串两种判断方式
+ * @details 表有 FIELD_NUM 个可以为 NULL 的整数列，每4个值中有一个 NULL。
+ */
+class RowTupleScanBenchmark : public Fixture
+{
+public:
+  static constexpr int FIELD_NUM  = 8;
+  static constexpr int RECORD_NUM = 20000;
+
+  virtual void SetUp(const State &state)
+  {
+    call_once(init_flag_, []() { init_table(); });
+  }
+
+  /**
+   * @brief 扫描整张表，对每一行调用 cell_visitor
+   */
+  template <typename CellVisitor>
+  void Scan(State &state, CellVisitor cell_visitor)
+  {
+    VacuousTrx trx;
+    int64_t    null_count = 0;
+    for (auto _ : state) {
+      TableScanPhysicalOperator scan_oper(&table_, true /*readonly*/);
+      RC rc = scan_oper.open(&trx);
+      if (rc != RC::SUCCESS) {
+        state.SkipWithError("failed to open table scan");
+        return;
+      }
+
+      while (RC::SUCCESS == (rc = scan_oper.next())) {
+        RowTuple *tuple = static_cast<RowTuple *>(scan_oper.current_tuple());
+        null_count += cell_visitor(*tuple);
+      }
+      scan_oper.close();
+    }
+
+    DoNotOptimize(null_count);
+    state.SetItemsProcessed(state.iterations() * RECORD_NUM);
+  }
+
+private:
+  static void init_table()
+  {
+    LoggerFactory::init_default("row_tuple_scan.log", LOG_LEVEL_WARN);
+    BufferPoolManager::set_instance(&bpm_);
+    RC rc = TrxKit::init_global("vacuous");
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to init trx kit");
+    }
+
+    const char *table_name = "row_tuple_scan";
+    const string meta_file = string(table_name) + ".table";
+    ::remove(meta_file.c_str());
+    ::remove((string(table_name) + ".data").c_str());
+
+    vector<AttrInfoSqlNode> attrs(FIELD_NUM);
+    for (int i = 0; i < FIELD_NUM; i++) {
+      attrs[i].type     = INTS;
+      attrs[i].name     = "f" + to_string(i);
+      attrs[i].length   = sizeof(int32_t);
+      attrs[i].nullable = true;
+    }
+    rc = table_.create(1, meta_file.c_str(), table_name, ".", FIELD_NUM, attrs.data());
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to create table");
+    }
+
+    vector<Value> values(FIELD_NUM);
+    for (int32_t i = 0; i < RECORD_NUM; i++) {
+      for (int f = 0; f < FIELD_NUM; f++) {
+        values[f] = ((i + f) % 4 == 0) ? Value(NULLS) : Value(i);
+      }
+
+      Record record;
+      rc = table_.make_record(FIELD_NUM, values.data(), record);
+      if (rc == RC::SUCCESS) {
+        rc = table_.insert_record(record);
+      }
+      if (rc != RC::SUCCESS) {
+        throw runtime_error("failed to insert record");
+      }
+    }
+  }
+
+protected:
+  static once_flag         init_flag_;
+  static BufferPoolManager bpm_;
+  static Table             table_;
+};
+
+once_flag         RowTupleScanBenchmark::init_flag_;
+BufferPoolManager RowTupleScanBenchmark::bpm_{512};
+Table             RowTupleScanBenchmark::table_;
+
+BENCHMARK_DEFINE_F(RowTupleScanBenchmark, NullBitmap)(State &state)
+{
+  Scan(state, [](const RowTuple &tuple) {
+    int   nulls = 0;
+    Value cell;
+    for (int i = 0; i < tuple.cell_num(); i++) {
+      tuple.cell_at(i, cell);
+      nulls += (cell.attr_type() == NULLS);
+    }
+    return nulls;
+  });
+}
+
+/**
+ * @brief 以前的判断方式：每个字段都和 "null" 字符串比较一次
+ * @details 只用来对比开销。现在的记录中 NULL 字段是全0，这里不会识别出 NULL
+ */
+BENCHMARK_DEFINE_F(RowTupleScanBenchmark, NullString)(State &state)
+{
+  Scan(state, [](const RowTuple &tuple) {
+    int                           nulls  = 0;
+    const char                   *data   = tuple.record().data();
+    const std::vector<FieldMeta> &fields = *table_.table_meta().field_metas();
+    Value                         cell;
+    for (const FieldMeta &field : fields) {
+      if (strcasecmp(data + field.offset(), "null") == 0) {
+        cell.set_type(NULLS);
+        nulls++;
+      } else {
+        cell.set_type(field.type());
+        cell.set_data(const_cast<char *>(data + field.offset()), field.len());
+      }
+    }
+    return nulls;
+  });
+}
+
+BENCHMARK_REGISTER_F(RowTupleScanBenchmark, NullBitmap);
+BENCHMARK_REGISTER_F(RowTupleScanBenchmark, NullString);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,194 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <benchmark/benchmark.h>
+
+#include "sql/operator/table_scan_physical_operator.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/table/table.h"
+#include "storage/trx/vacuous_trx.h"
+#include "common/log/log.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * 替换 glibc 的 malloc 等函数，统计扫描过程中内存分配的次数和大小。
+ * new 也是通过 malloc 分配内存的，同样会统计进来。
+ */
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t num, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void  __libc_free(void *ptr);
+
+static atomic<bool>    counting{false};
+static atomic<int64_t> alloc_count{0};
+static atomic<int64_t> alloc_bytes{0};
+
+static void count_alloc(size_t size)
+{
+  if (counting.load(memory_order_relaxed)) {
+    alloc_count.fetch_add(1, memory_order_relaxed);
+    alloc_bytes.fetch_add(static_cast<int64_t>(size), memory_order_relaxed);
+  }
+}
+
+void *malloc(size_t size)
+{
+  count_alloc(size);
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t num, size_t size)
+{
+  count_alloc(num * size);
+  return __libc_calloc(num, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+  count_alloc(size);
+  return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) { __libc_free(ptr); }
+}
+
+/**
+ * @brief 全表扫描时每一行的内存分配次数和分配的字节数
+ * @details 记录数据分配的内存基本上都是用来复制数据的，alloc_bytes 可以看作每行复制的数据量。
+ * Scan 只读取每一列，不需要复制记录。Materialize 模拟排序和聚合，需要把每一行都复制下来。
+ */
+class ScanAllocationBenchmark : public Fixture
+{
+public:
+  static constexpr int FIELD_NUM  = 8;
+  static constexpr int RECORD_NUM = 20000;
+
+  virtual void SetUp(const State &state)
+  {
+    call_once(init_flag_, []() { init_table(); });
+  }
+
+  template <typename RowVisitor>
+  void Scan(State &state, RowVisitor row_visitor)
+  {
+    VacuousTrx trx;
+    int64_t    sum = 0;
+
+    alloc_count = 0;
+    alloc_bytes = 0;
+    counting    = true;
+    for (auto _ : state) {
+      TableScanPhysicalOperator scan_oper(&table_, true /*readonly*/);
+      RC rc = scan_oper.open(&trx);
+      if (rc != RC::SUCCESS) {
+        state.SkipWithError("failed to open table scan");
+        break;
+      }
+
+      while (RC::SUCCESS == (rc = scan_oper.next())) {
+        sum += row_visitor(*scan_oper.current_tuple());
+      }
+      scan_oper.close();
+    }
+    counting = false;
+
+    DoNotOptimize(sum);
+    const double rows = static_cast<double>(state.iterations()) * RECORD_NUM;
+    state.SetItemsProcessed(state.iterations() * RECORD_NUM);
+    state.counters["allocs_per_row"] = Counter(static_cast<double>(alloc_count.load()) / rows);
+    state.counters["alloc_bytes_per_row"] = Counter(static_cast<double>(alloc_bytes.load()) / rows);
+  }
+
+private:
+  static void init_table()
+  {
+    LoggerFactory::init_default("scan_allocation.log", LOG_LEVEL_WARN);
+    BufferPoolManager::set_instance(&bpm_);
+    RC rc = TrxKit::init_global("vacuous");
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to init trx kit");
+    }
+
+    const char *table_name = "scan_allocation";
+    const string meta_file = string(table_name) + ".table";
+    ::remove(meta_file.c_str());
+    ::remove((string(table_name) + ".data").c_str());
+
+    vector<AttrInfoSqlNode> attrs(FIELD_NUM);
+    for (int i = 0; i < FIELD_NUM; i++) {
+      attrs[i].type   = INTS;
+      attrs[i].name   = "f" + to_string(i);
+      attrs[i].length = sizeof(int32_t);
+    }
+    rc = table_.create(1, meta_file.c_str(), table_name, ".", FIELD_NUM, attrs.data());
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to create table");
+    }
+
+    vector<Value> values(FIELD_NUM);
+    for (int32_t i = 0; i < RECORD_NUM; i++) {
+      for (int f = 0; f < FIELD_NUM; f++) {
+        values[f] = Value(i + f);
+      }
+
+      Record record;
+      rc = table_.make_record(FIELD_NUM, values.data(), record);
+      if (rc == RC::SUCCESS) {
+        rc = table_.insert_record(record);
+      }
+      if (rc != RC::SUCCESS) {
+        throw runtime_error("failed to insert record");
+      }
+    }
+  }
+
+protected:
+  static once_flag         init_flag_;
+  static BufferPoolManager bpm_;
+  static Table             table_;
+};
+
+once_flag         ScanAllocationBenchmark::init_flag_;
+BufferPoolManager ScanAllocationBenchmark::bpm_{512};
+Table             ScanAllocationBenchmark::table_;
+
+static int64_t sum_cells(const Tuple &tuple)
+{
+  int64_t sum = 0;
+  Value   cell;
+  for (int i = 0; i < tuple.cell_num(); i++) {
+    tuple.cell_at(i, cell);
+    sum += cell.get_int();
+  }
+  return sum;
+}
+
+BENCHMARK_DEFINE_F(ScanAllocationBenchmark, Scan)(State &state) { Scan(state, sum_cells); }
+
+BENCHMARK_DEFINE_F(ScanAllocationBenchmark, Materialize)(State &state)
+{
+  Scan(state, [](const Tuple &tuple) {
+    unique_ptr<Tuple> copy(tuple.clone());
+    return sum_cells(*copy);
+  });
+}
+
+BENCHMARK_REGISTER_F(ScanAllocationBenchmark, Scan);
+BENCHMARK_REGISTER_F(ScanAllocationBenchmark, Materialize);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,118 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdlib.h>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "sql/expr/chunk.h"
+#include "sql/expr/comparison_kernel.h"
+#include "sql/expr/expression.h"
+
+using namespace std;
+using namespace benchmark;
+
+/**
+ * @brief 比较一批定长值的几种方式
+ * @details 每次比较 Chunk::DEFAULT_CAPACITY 个值。PerRow 是以前的做法，每一行取出 Value 调用 compare_value；
+ * Scalar 和 Simd 是 ComparisonKernel 的两种实现。参数是列的类型
+ */
+class SimdFilterBenchmark : public Fixture
+{
+public:
+  static constexpr int ROWS = Chunk::DEFAULT_CAPACITY;
+
+  void SetUp(const State &state) override
+  {
+    type_ = static_cast<AttrType>(state.range(0));
+    left_.init(type_, ROWS);
+    right_.init(type_, ROWS);
+    srand(0);
+    for (int i = 0; i < ROWS; i++) {
+      left_.append_value(make_value(rand() % 1000));
+      right_.append_value(make_value(rand() % 1000));
+    }
+    constant_ = make_value(500);
+    select_.resize(ROWS);
+  }
+
+  Value make_value(int i) const
+  {
+    switch (type_) {
+      case FLOATS: return Value(i / 10.0f);
+      case DATES: return Value(static_cast<date>(20000101 + i));
+      default: return Value(i);
+    }
+  }
+
+  void Kernel(State &state, bool constant, ComparisonKernel::Mode mode)
+  {
+    for (auto _ : state) {
+      if (constant) {
+        ComparisonKernel::compare(LESS_THAN, type_, left_.data(), constant_, ROWS, select_.data(), mode);
+      } else {
+        ComparisonKernel::compare(LESS_THAN, type_, left_.data(), right_.data(), ROWS, select_.data(), mode);
+      }
+      DoNotOptimize(select_.data());
+      ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+  }
+
+  void PerRow(State &state, bool constant)
+  {
+    ComparisonExpr expr(LESS_THAN, make_unique<ValueExpr>(constant_), make_unique<ValueExpr>(constant_));
+    for (auto _ : state) {
+      for (int i = 0; i < ROWS; i++) {
+        bool result = false;
+        expr.compare_value(left_.get_value(i), constant ? constant_ : right_.get_value(i), result);
+        select_[i] = result;
+      }
+      DoNotOptimize(select_.data());
+      ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * ROWS);
+  }
+
+protected:
+  AttrType        type_ = INTS;
+  Column          left_;
+  Column          right_;
+  Value           constant_;
+  vector<uint8_t> select_;
+};
+
+BENCHMARK_DEFINE_F(SimdFilterBenchmark, ConstantPerRow)(State &state) { PerRow(state, true); }
+BENCHMARK_DEFINE_F(SimdFilterBenchmark, ConstantScalar)(State &state)
+{
+  Kernel(state, true, ComparisonKernel::Mode::SCALAR);
+}
+BENCHMARK_DEFINE_F(SimdFilterBenchmark, ConstantSimd)(State &state)
+{
+  Kernel(state, true, ComparisonKernel::Mode::SIMD);
+}
+BENCHMARK_DEFINE_F(SimdFilterBenchmark, ColumnPerRow)(State &state) { PerRow(state, false); }
+BENCHMARK_DEFINE_F(SimdFilterBenchmark, ColumnScalar)(State &state)
+{
+  Kernel(state, false, ComparisonKernel::Mode::SCALAR);
+}
+BENCHMARK_DEFINE_F(SimdFilterBenchmark, ColumnSimd)(State &state)
+{
+  Kernel(state, false, ComparisonKernel::Mode::SIMD);
+}
+
+BENCHMARK_REGISTER_F(SimdFilterBenchmark, ConstantPerRow)->Arg(INTS)->Arg(FLOATS)->Arg(DATES);
+BENCHMARK_REGISTER_F(SimdFilterBenchmark, ConstantScalar)->Arg(INTS)->Arg(FLOATS)->Arg(DATES);
+BENCHMARK_REGISTER_F(SimdFilterBenchmark, ConstantSimd)->Arg(INTS)->Arg(FLOATS)->Arg(DATES);
+BENCHMARK_REGISTER_F(SimdFilterBenchmark, ColumnPerRow)->Arg(INTS)->Arg(FLOATS)->Arg(DATES);
+BENCHMARK_REGISTER_F(SimdFilterBenchmark, ColumnScalar)->Arg(INTS)->Arg(FLOATS)->Arg(DATES);
+BENCHMARK_REGISTER_F(SimdFilterBenchmark, ColumnSimd)->Arg(INTS)->Arg(FLOATS)->Arg(DATES);
+
+BENCHMARK_MAIN();
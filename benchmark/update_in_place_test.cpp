@@ -0,0 +1,177 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <benchmark/benchmark.h>
+
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/clog/clog.h"
+#include "storage/record/record.h"
+#include "storage/table/table.h"
+#include "storage/trx/mvcc_trx.h"
+#include "common/log/log.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 在有三个二级索引的表上执行更新
+ * @details 每个事务更新 ROWS_PER_TRX 行然后提交，参数表示更新哪个字段:
+ * 0 更新没有索引的字段 v，1 更新有索引的字段 a。
+ * log_bytes_per_update 是每次更新写的日志量(包括索引日志和提交日志)，
+ * full_update_log_bytes 是记录完整的前后两个版本时每次更新的记录数据量，用来对比。
+ */
+class UpdateInPlaceBenchmark : public Fixture
+{
+public:
+  static constexpr int RECORD_NUM   = 10000;
+  static constexpr int ROWS_PER_TRX = 100;
+
+  virtual void SetUp(const State &state)
+  {
+    call_once(init_flag_, []() { init_table(); });
+  }
+
+  void Update(State &state, const char *field_name)
+  {
+    const FieldMeta *field_meta = table_.table_meta().field(field_name);
+    TrxKit          *trx_kit    = TrxKit::instance();
+    int32_t          next_value = 0;
+    int64_t          updates    = 0;
+    int64_t          slot       = 0;
+
+    log_manager_.sync();
+    const LSN begin_lsn = log_manager_.flushed_lsn();
+    for (auto _ : state) {
+      Trx *trx = trx_kit->create_trx(&log_manager_);
+      for (int i = 0; i < ROWS_PER_TRX; i++, slot++) {
+        const RID &rid = rids_[slot % rids_.size()];
+        RC         rc  = RC::SUCCESS;
+        table_.visit_record(rid, false /*readonly*/, [&](Record &record) {
+          rc = trx->visit_record(&table_, record, false /*readonly*/);
+          vector<char> new_data;
+          if (OB_SUCC(rc)) {
+            rc = table_.make_record(record, field_meta, Value(RECORD_NUM + next_value++), new_data);
+          }
+          if (OB_SUCC(rc)) {
+            rc = trx->update_record(&table_, record, new_data.data());
+          }
+        });
+        if (OB_FAIL(rc)) {
+          state.SkipWithError("failed to update record");
+          break;
+        }
+        updates++;
+      }
+      trx->commit();
+      trx_kit->destroy_trx(trx);
+
+      state.PauseTiming();
+      static_cast<MvccTrxKit *>(trx_kit)->vacuum(vector<Table *>{&table_});
+      state.ResumeTiming();
+    }
+
+    const LSN end_lsn = log_manager_.flushed_lsn();
+    state.SetItemsProcessed(updates);
+    state.counters["log_bytes_per_update"] =
+        Counter(updates == 0 ? 0 : static_cast<double>(end_lsn - begin_lsn) / updates);
+    state.counters["full_update_log_bytes"] = Counter(table_.table_meta().record_size() * 2);
+  }
+
+private:
+  static void init_table()
+  {
+    LoggerFactory::init_default("update_in_place.log", LOG_LEVEL_WARN);
+    BufferPoolManager::set_instance(&bpm_);
+    RC rc = TrxKit::init_global("mvcc");
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to init trx kit");
+    }
+
+    const char *table_name = "update_in_place";
+    const string base_dir  = table_name;
+    filesystem::remove_all(base_dir);
+    filesystem::create_directories(base_dir);
+    rc = log_manager_.init(base_dir.c_str());
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to init clog");
+    }
+
+    const char *field_names[] = {"id", "a", "b", "c", "v"};
+    vector<AttrInfoSqlNode> attrs(sizeof(field_names) / sizeof(field_names[0]));
+    for (size_t i = 0; i < attrs.size(); i++) {
+      attrs[i].type   = INTS;
+      attrs[i].name   = field_names[i];
+      attrs[i].length = sizeof(int32_t);
+    }
+    const string meta_file = base_dir + "/" + table_name + ".table";
+    rc = table_.create(1, meta_file.c_str(), table_name, base_dir.c_str(), static_cast<int>(attrs.size()), attrs.data());
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to create table");
+    }
+    table_.set_log_manager(&log_manager_);
+
+    Trx *trx = TrxKit::instance()->create_trx(&log_manager_);
+    for (const char *index_field : {"a", "b", "c"}) {
+      const string index_name = string("i_") + index_field;
+      rc = table_.create_index(trx, table_.table_meta().field(index_field), index_name.c_str(), false /*unique*/);
+      if (rc != RC::SUCCESS) {
+        throw runtime_error("failed to create index");
+      }
+    }
+
+    vector<Value> values(attrs.size());
+    for (int32_t i = 0; i < RECORD_NUM; i++) {
+      for (size_t f = 0; f < values.size(); f++) {
+        values[f] = Value(i);
+      }
+
+      Record record;
+      rc = table_.make_record(static_cast<int>(values.size()), values.data(), record);
+      if (rc == RC::SUCCESS) {
+        rc = trx->insert_record(&table_, record);
+      }
+      if (rc != RC::SUCCESS) {
+        throw runtime_error("failed to insert record");
+      }
+      rids_.push_back(record.rid());
+    }
+    rc = trx->commit();
+    TrxKit::instance()->destroy_trx(trx);
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to commit");
+    }
+  }
+
+protected:
+  static once_flag         init_flag_;
+  static BufferPoolManager bpm_;
+  static CLogManager       log_manager_;
+  static Table             table_;
+  static vector<RID>       rids_;
+};
+
+once_flag         UpdateInPlaceBenchmark::init_flag_;
+BufferPoolManager UpdateInPlaceBenchmark::bpm_{512};
+CLogManager       UpdateInPlaceBenchmark::log_manager_;
+Table             UpdateInPlaceBenchmark::table_;
+vector<RID>       UpdateInPlaceBenchmark::rids_;
+
+BENCHMARK_DEFINE_F(UpdateInPlaceBenchmark, UpdateField)(State &state)
+{
+  Update(state, state.range(0) == 0 ? "v" : "a");
+}
+
+BENCHMARK_REGISTER_F(UpdateInPlaceBenchmark, UpdateField)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
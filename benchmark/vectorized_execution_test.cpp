@@ -0,0 +1,160 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <mutex>
+#include <stdexcept>
+#include <benchmark/benchmark.h>
+
+#include "sql/expr/expression.h"
+#include "sql/operator/aggr_physical_operator.h"
+#include "sql/operator/chunk_to_row_physical_operator.h"
+#include "sql/operator/table_scan_physical_operator.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/table/table.h"
+#include "storage/trx/vacuous_trx.h"
+#include "common/log/log.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 执行 select sum(f1) from t where f0 < x，比较按行执行和批量执行
+ * @details 表有 FIELD_NUM 个整数列，f0 是 0 到 99 循环的值，参数是过滤条件的选择率(百分比)
+ */
+class VectorizedExecutionBenchmark : public Fixture
+{
+public:
+  static constexpr int FIELD_NUM  = 4;
+  static constexpr int RECORD_NUM = 100000;
+
+  virtual void SetUp(const State &state)
+  {
+    call_once(init_flag_, []() { init_table(); });
+  }
+
+  /**
+   * @brief 创建 扫描 + 过滤 + 聚合 的物理计划
+   */
+  static unique_ptr<PhysicalOperator> create_plan(int selectivity, bool vectorized)
+  {
+    const FieldMeta *f0 = table_.table_meta().field("f0");
+    const FieldMeta *f1 = table_.table_meta().field("f1");
+
+    vector<unique_ptr<Expression>> predicates;
+    predicates.emplace_back(new ComparisonExpr(
+        LESS_THAN, make_unique<FieldExpr>(&table_, f0), make_unique<ValueExpr>(Value(selectivity))));
+
+    auto scan_oper = make_unique<TableScanPhysicalOperator>(&table_, true /*readonly*/);
+    scan_oper->set_predicates(std::move(predicates));
+    scan_oper->set_projection({Field(&table_, f0), Field(&table_, f1)});
+
+    vector<Expression *> aggr_exprs{new AggregationExpr(Field(&table_, f1), SUM_AGGR_T)};
+    unique_ptr<PhysicalOperator> oper(new AggrPhysicalOperator(aggr_exprs, {}, {}));
+    oper->add_child(std::move(scan_oper));
+
+    if (vectorized) {
+      unique_ptr<PhysicalOperator> chunk_to_row_oper(new ChunkToRowPhysicalOperator);
+      chunk_to_row_oper->add_child(std::move(oper));
+      oper = std::move(chunk_to_row_oper);
+    }
+    return oper;
+  }
+
+  void Run(State &state, bool vectorized)
+  {
+    VacuousTrx trx;
+    int        result_rows = 0;
+    for (auto _ : state) {
+      unique_ptr<PhysicalOperator> oper = create_plan(static_cast<int>(state.range(0)), vectorized);
+
+      RC rc = oper->open(&trx);
+      if (rc != RC::SUCCESS) {
+        state.SkipWithError("failed to open plan");
+        return;
+      }
+
+      while (RC::SUCCESS == (rc = oper->next())) {
+        result_rows++;
+      }
+      oper->close();
+      if (rc != RC::RECORD_EOF) {
+        state.SkipWithError("failed to execute plan");
+        return;
+      }
+    }
+
+    DoNotOptimize(result_rows);
+    state.SetItemsProcessed(state.iterations() * RECORD_NUM);
+  }
+
+private:
+  static void init_table()
+  {
+    LoggerFactory::init_default("vectorized_execution.log", LOG_LEVEL_WARN);
+    BufferPoolManager::set_instance(&bpm_);
+    RC rc = TrxKit::init_global("vacuous");
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to init trx kit");
+    }
+
+    const char *table_name = "vectorized_execution";
+    const string meta_file = string(table_name) + ".table";
+    ::remove(meta_file.c_str());
+    ::remove((string(table_name) + ".data").c_str());
+
+    vector<AttrInfoSqlNode> attrs(FIELD_NUM);
+    for (int i = 0; i < FIELD_NUM; i++) {
+      attrs[i].type     = INTS;
+      attrs[i].name     = "f" + to_string(i);
+      attrs[i].length   = sizeof(int32_t);
+      attrs[i].nullable = false;
+    }
+    rc = table_.create(1, meta_file.c_str(), table_name, ".", FIELD_NUM, attrs.data());
+    if (rc != RC::SUCCESS) {
+      throw runtime_error("failed to create table");
+    }
+
+    vector<Value> values(FIELD_NUM);
+    for (int32_t i = 0; i < RECORD_NUM; i++) {
+      values[0] = Value(i % 100);
+      for (int f = 1; f < FIELD_NUM; f++) {
+        values[f] = Value(i + f);
+      }
+
+      Record record;
+      rc = table_.make_record(FIELD_NUM, values.data(), record);
+      if (rc == RC::SUCCESS) {
+        rc = table_.insert_record(record);
+      }
+      if (rc != RC::SUCCESS) {
+        throw runtime_error("failed to insert record");
+      }
+    }
+  }
+
+protected:
+  static once_flag         init_flag_;
+  static BufferPoolManager bpm_;
+  static Table             table_;
+};
+
+once_flag         VectorizedExecutionBenchmark::init_flag_;
+BufferPoolManager VectorizedExecutionBenchmark::bpm_{2048};
+Table             VectorizedExecutionBenchmark::table_;
+
+BENCHMARK_DEFINE_F(VectorizedExecutionBenchmark, Row)(State &state) { Run(state, false /*vectorized*/); }
+
+BENCHMARK_DEFINE_F(VectorizedExecutionBenchmark, Chunk)(State &state) { Run(state, true /*vectorized*/); }
+
+BENCHMARK_REGISTER_F(VectorizedExecutionBenchmark, Row)->Arg(10)->Arg(50)->Arg(100);
+BENCHMARK_REGISTER_F(VectorizedExecutionBenchmark, Chunk)->Arg(10)->Arg(50)->Arg(100);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,245 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "common/io/lz4.h"
+
+namespace common {
+
+/*
+ * LZ4 block 格式由一串 sequence 组成，每个 sequence 是:
+ *   token(高4位是字面量长度，低4位是匹配长度-4) [字面量长度扩展] 字面量 offset(2字节小端) [匹配长度扩展]
+ * 长度大于等于15时，后面跟着若干个扩展字节，每个字节加到长度上，直到某个字节不是255。
+ * 最后一个 sequence 只有字面量。格式要求最后5个字节一定是字面量，最后一个匹配的起始位置距离结尾至少12个字节。
+ */
+static constexpr int MIN_MATCH     = 4;
+static constexpr int LAST_LITERALS = 5;
+static constexpr int MF_LIMIT      = 12;
+static constexpr int MAX_OFFSET    = 65535;
+static constexpr int HASH_LOG      = 12;
+static constexpr int MAX_INPUT     = 64 * 1024;
+
+static inline uint32_t read32(const char *p)
+{
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline uint32_t hash32(uint32_t v) { return (v * 2654435761U) >> (32 - HASH_LOG); }
+
+/**
+ * @brief 写长度的扩展字节，返回写入后的位置。空间不够时返回 nullptr
+ */
+static inline char *write_length(char *op, const char *op_end, int length)
+{
+  while (length >= 255) {
+    if (op >= op_end) {
+      return nullptr;
+    }
+    *op++ = (char)255;
+    length -= 255;
+  }
+  if (op >= op_end) {
+    return nullptr;
+  }
+  *op++ = (char)length;
+  return op;
+}
+
+/**
+ * @brief 输出一个 sequence。match_length 为0表示最后一个只有字面量的 sequence
+ */
+static char *write_sequence(
+    char *op, const char *op_end, const char *literals, int literal_length, int offset, int match_length)
+{
+  if (op >= op_end) {
+    return nullptr;
+  }
+  char *token = op++;
+  *token      = 0;
+
+  if (literal_length >= 15) {
+    *token = (char)(15 << 4);
+    if ((op = write_length(op, op_end, literal_length - 15)) == nullptr) {
+      return nullptr;
+    }
+  } else {
+    *token = (char)(literal_length << 4);
+  }
+
+  if (op_end - op < literal_length) {
+    return nullptr;
+  }
+  memcpy(op, literals, literal_length);
+  op += literal_length;
+
+  if (match_length == 0) {
+    return op;
+  }
+
+  if (op_end - op < 2) {
+    return nullptr;
+  }
+  *op++ = (char)(offset & 0xFF);
+  *op++ = (char)((offset >> 8) & 0xFF);
+
+  const int ml = match_length - MIN_MATCH;
+  if (ml >= 15) {
+    *token = (char)(*token | 15);
+    op     = write_length(op, op_end, ml - 15);
+  } else {
+    *token = (char)(*token | ml);
+  }
+  return op;
+}
+
+int lz4_compress(const char *src, int src_size, char *dst, int dst_capacity)
+{
+  if (src_size < 0 || src_size > MAX_INPUT || dst_capacity <= 0) {
+    return 0;
+  }
+
+  const char *op_end = dst + dst_capacity;
+  char       *op     = dst;
+  int         anchor = 0;
+
+  if (src_size >= MF_LIMIT + 1) {
+    int table[1 << HASH_LOG];
+    memset(table, -1, sizeof(table));
+
+    const int match_limit = src_size - MF_LIMIT;
+    const int match_end   = src_size - LAST_LITERALS;
+    int       ip          = 0;
+    while (ip < match_limit) {
+      const uint32_t sequence = read32(src + ip);
+      const uint32_t h        = hash32(sequence);
+      int            ref      = table[h];
+      table[h]                = ip;
+      if (ref < 0 || ip - ref > MAX_OFFSET || read32(src + ref) != sequence) {
+        ip++;
+        continue;
+      }
+
+      // 向前扩展匹配，可以少输出一些字面量
+      while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1]) {
+        ip--;
+        ref--;
+      }
+
+      int match_length = MIN_MATCH;
+      while (ip + match_length < match_end && src[ip + match_length] == src[ref + match_length]) {
+        match_length++;
+      }
+
+      op = write_sequence(op, op_end, src + anchor, ip - anchor, ip - ref, match_length);
+      if (op == nullptr) {
+        return 0;
+      }
+
+      ip += match_length;
+      anchor = ip;
+      if (ip - 2 >= 0 && ip < match_limit) {
+        table[hash32(read32(src + ip - 2))] = ip - 2;
+      }
+    }
+  }
+
+  op = write_sequence(op, op_end, src + anchor, src_size - anchor, 0, 0);
+  if (op == nullptr) {
+    return 0;
+  }
+  return static_cast<int>(op - dst);
+}
+
+int lz4_decompress(const char *src, int src_size, char *dst, int dst_capacity)
+{
+  const unsigned char *ip     = reinterpret_cast<const unsigned char *>(src);
+  const unsigned char *ip_end = ip + src_size;
+  char                *op     = dst;
+  char                *op_end = dst + dst_capacity;
+
+  if (src_size <= 0) {
+    return -1;
+  }
+
+  while (true) {
+    const unsigned token = *ip++;
+
+    size_t literal_length = token >> 4;
+    if (literal_length == 15) {
+      unsigned b = 0;
+      do {
+        if (ip >= ip_end) {
+          return -1;
+        }
+        b = *ip++;
+        literal_length += b;
+      } while (b == 255);
+    }
+
+    if (static_cast<size_t>(ip_end - ip) < literal_length || static_cast<size_t>(op_end - op) < literal_length) {
+      return -1;
+    }
+    memcpy(op, ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+
+    if (ip == ip_end) {
+      break;  // 最后一个 sequence
+    }
+
+    if (ip_end - ip < 2) {
+      return -1;
+    }
+    const size_t offset = ip[0] | (ip[1] << 8);
+    ip += 2;
+    if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+      return -1;
+    }
+
+    size_t match_length = token & 15;
+    if (match_length == 15) {
+      unsigned b = 0;
+      do {
+        if (ip >= ip_end) {
+          return -1;
+        }
+        b = *ip++;
+        match_length += b;
+      } while (b == 255);
+    }
+    match_length += MIN_MATCH;
+
+    if (static_cast<size_t>(op_end - op) < match_length) {
+      return -1;
+    }
+
+    // 匹配的数据可能和要写的位置重叠，需要逐个字节复制
+    const char *match = op - offset;
+    if (offset >= match_length) {
+      memcpy(op, match, match_length);
+      op += match_length;
+    } else {
+      for (size_t i = 0; i < match_length; i++) {
+        *op++ = *match++;
+      }
+    }
+
+    if (ip >= ip_end) {
+      return -1;  // 最后一个 sequence 必须只有字面量
+    }
+  }
+  return static_cast<int>(op - dst);
+}
+
+}  // namespace common
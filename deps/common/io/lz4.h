@@ -0,0 +1,34 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+namespace common {
+
+/**
+ * @brief 按照 LZ4 block 格式压缩一段数据
+ * @details 只实现了 LZ4 的快速压缩模式(单个哈希表，贪心匹配)，输出可以被标准的 LZ4_decompress_safe 解压。
+ * 适合压缩数据页面这样的小块数据，输入不能超过 64KB。
+ * @param src      待压缩的数据
+ * @param src_size 待压缩数据的长度
+ * @param dst      压缩后的数据
+ * @param dst_capacity dst 的空间大小
+ * @return 压缩后的长度。dst 空间不够时返回0
+ */
+int lz4_compress(const char *src, int src_size, char *dst, int dst_capacity);
+
+/**
+ * @brief 解压 LZ4 block 格式的数据
+ * @details 会检查输入的合法性，不会读写越界
+ * @return 解压后的长度。数据不合法或者 dst 空间不够时返回 -1
+ */
+int lz4_decompress(const char *src, int src_size, char *dst, int dst_capacity);
+
+}  // namespace common
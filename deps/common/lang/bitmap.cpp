@@ -82,9 +82,8 @@ int Bitmap::next_unsetted_bit(int start)
         ret = iter * 8 + index_in_byte;
         break;
       }
-
-      start_in_byte = 0;
     }
+    start_in_byte = 0;
   }
 
   if (ret >= size_) {
@@ -105,9 +104,8 @@ int Bitmap::next_setted_bit(int start)
         ret = iter * 8 + index_in_byte;
         break;
       }
-
-      start_in_byte = 0;
     }
+    start_in_byte = 0;
   }
 
   if (ret >= size_) {
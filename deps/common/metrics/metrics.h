@@ -21,6 +21,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/metrics/timer_snapshot.h"
 #include "common/metrics/uniform_reservoir.h"
 #include <sys/time.h>
+#include <atomic>
 
 namespace common {
 
@@ -33,6 +34,25 @@ public:
   }
 };
 
+// report the current value of an atomic counter owned by someone else
+class AtomicGauge : public Gauge {
+public:
+  explicit AtomicGauge(const std::atomic<long> &value) : value_(value)
+  {
+    set_snapshot(&snapshot_);
+  }
+
+  void snapshot()
+  {
+    long value = value_.load();
+    snapshot_.setValue(value);
+  }
+
+private:
+  const std::atomic<long> &value_;
+  SnapshotBasic<long> snapshot_;
+};
+
 class Counter : public Metric {
   void set_snapshot(SnapshotBasic<long> *value)
   {
@@ -59,6 +59,8 @@ See the Mulan PSL v2 for more details. */
   DEFINE_RC(LOCKED_UNLOCK)                  \
   DEFINE_RC(LOCKED_NEED_WAIT)               \
   DEFINE_RC(LOCKED_CONCURRENCY_CONFLICT)    \
+  DEFINE_RC(LOCKED_WAIT_TIMEOUT)            \
+  DEFINE_RC(LOCKED_DEADLOCK)                \
   DEFINE_RC(FILE_EXIST)                     \
   DEFINE_RC(FILE_NOT_EXIST)                 \
   DEFINE_RC(FILE_NAME)                      \
@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <stdint.h>
 
 /// 磁盘文件，包括存放数据的文件和索引(B+-Tree)文件，都按照页来组织
 /// 每一页都有一个编号，称为PageNum
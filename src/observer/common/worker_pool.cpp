@@ -0,0 +1,124 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <thread>
+
+#include "common/worker_pool.h"
+
+using namespace std;
+
+WorkerPool::WorkerPool(int max_thread_num, chrono::milliseconds idle_timeout)
+    : max_thread_num_(max_thread_num), idle_timeout_(idle_timeout)
+{}
+
+WorkerPool::~WorkerPool()
+{
+  // 线程都是 detach 的，退出前最后一次修改 thread_num_
+  unique_lock<mutex> guard(lock_);
+  stop_ = true;
+  cond_.notify_all();
+  exit_cond_.wait(guard, [this]() { return thread_num_ == 0; });
+}
+
+WorkerPool &WorkerPool::instance()
+{
+  static WorkerPool pool;
+  return pool;
+}
+
+void WorkerPool::submit(function<void()> task)
+{
+  lock_guard<mutex> guard(lock_);
+  tasks_.push_back(std::move(task));
+  if (static_cast<int>(tasks_.size()) <= idle_num_) {
+    cond_.notify_one();
+  } else if (thread_num_ < max_thread_num_) {
+    thread_num_++;
+    thread(&WorkerPool::thread_func, this).detach();
+  }
+  // 否则等待正在执行任务的线程空闲下来
+}
+
+RC WorkerPool::run(int task_num, const function<RC(int)> &task)
+{
+  // 提交的任务可能在 run 返回之后才被线程取出，这时已经没有要执行的任务了，但是仍然会访问这里的状态
+  struct RunState
+  {
+    mutex              lock;
+    condition_variable cond;
+    int                next     = 1;  ///< 下一个还没有开始的任务
+    int                finished = 0;
+    RC                 result   = RC::SUCCESS;
+  };
+  auto state = make_shared<RunState>();
+
+  // 取走一个还没有开始的任务执行，没有时返回 false
+  auto run_next = [state, task_num, &task]() {
+    int index = 0;
+    {
+      lock_guard<mutex> guard(state->lock);
+      if (state->next >= task_num) {
+        return false;
+      }
+      index = state->next++;
+    }
+
+    RC rc = task(index);
+
+    lock_guard<mutex> guard(state->lock);
+    if (rc != RC::SUCCESS && state->result == RC::SUCCESS) {
+      state->result = rc;
+    }
+    if (++state->finished == task_num - 1) {
+      state->cond.notify_all();
+    }
+    return true;
+  };
+
+  for (int i = 1; i < task_num; i++) {
+    submit([run_next]() { run_next(); });
+  }
+
+  RC rc = task_num > 0 ? task(0) : RC::SUCCESS;
+  while (run_next()) {
+  }
+
+  unique_lock<mutex> guard(state->lock);
+  state->cond.wait(guard, [&state, task_num]() { return state->finished >= task_num - 1; });
+  return rc != RC::SUCCESS ? rc : state->result;
+}
+
+int WorkerPool::thread_num()
+{
+  lock_guard<mutex> guard(lock_);
+  return thread_num_;
+}
+
+void WorkerPool::thread_func()
+{
+  unique_lock<mutex> guard(lock_);
+  while (true) {
+    idle_num_++;
+    const bool has_task = cond_.wait_for(guard, idle_timeout_, [this]() { return stop_ || !tasks_.empty(); });
+    idle_num_--;
+    if (!has_task || tasks_.empty()) {
+      break;  // 空闲超时或者 stop_
+    }
+
+    function<void()> task = std::move(tasks_.front());
+    tasks_.pop_front();
+    guard.unlock();
+    task();
+    guard.lock();
+  }
+
+  thread_num_--;
+  exit_cond_.notify_all();
+}
@@ -0,0 +1,73 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include "common/rc.h"
+
+/**
+ * @brief 查询并行执行时使用的线程
+ * @details 提交的任务在线程个数没有达到上限时总是马上开始执行：有空闲的线程时交给空闲的线程，没有时新建一个线程。
+ * 这样任务之间可以互相等待，比如一个任务等待另一个任务产生的数据，不会因为线程不够而死锁。
+ * 线程个数达到上限后，新的任务排队等待空闲的线程。run 的调用者会自己执行还没有开始的任务，所以不会一直等下去；
+ * 但是互相等待的任务，同时执行的个数就不能超过上限了。
+ * 上限默认是最大并行度的两倍，一个查询中 Gather 的流水线和并行哈希连接构建的任务都能马上开始执行。
+ * 空闲的线程等待一段时间没有任务后退出。
+ */
+class WorkerPool
+{
+public:
+  static constexpr int                       DEFAULT_MAX_THREAD_NUM = 128;
+  static constexpr std::chrono::milliseconds DEFAULT_IDLE_TIMEOUT{60 * 1000};
+
+  explicit WorkerPool(
+      int max_thread_num = DEFAULT_MAX_THREAD_NUM, std::chrono::milliseconds idle_timeout = DEFAULT_IDLE_TIMEOUT);
+  ~WorkerPool();
+
+  static WorkerPool &instance();
+
+  /**
+   * @brief 提交一个任务，不等待任务执行完成
+   */
+  void submit(std::function<void()> task);
+
+  /**
+   * @brief 并行执行 task(0) 到 task(task_num - 1)，调用者所在的线程执行 task(0)，全部执行完成后返回
+   * @details 调用者执行完 task(0) 后，还没有被线程取走的任务也由调用者执行
+   * @return 都成功时返回 SUCCESS，否则返回第一个失败的任务的结果
+   */
+  RC run(int task_num, const std::function<RC(int)> &task);
+
+  /**
+   * @brief 当前的线程个数
+   */
+  int thread_num();
+
+private:
+  void thread_func();
+
+private:
+  const int                       max_thread_num_;
+  const std::chrono::milliseconds idle_timeout_;
+
+  std::mutex                        lock_;
+  std::condition_variable           cond_;
+  std::condition_variable           exit_cond_;  ///< 析构时等待所有线程退出
+  std::deque<std::function<void()>> tasks_;
+  int                               thread_num_ = 0;
+  int                               idle_num_   = 0;  ///< 正在等待任务的线程个数
+  bool                              stop_       = false;
+};
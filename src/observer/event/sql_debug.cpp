@@ -38,7 +38,7 @@ const list<string> &SqlDebug::get_debug_infos() const
 void sql_debug(const char *fmt, ...)
 {
   Session *session  = Session::current_session();
-  if (nullptr == session) {
+  if (nullptr == session || !session->sql_debug_on()) {
     return;
   }
 
@@ -62,3 +62,9 @@ void sql_debug(const char *fmt, ...)
 
   delete[] str;
 }
+
+bool sql_debug_on()
+{
+  Session *session = Session::current_session();
+  return session != nullptr && session->sql_debug_on();
+}
@@ -46,3 +46,9 @@ private:
  * 在普通文本场景下，调试信息会直接输出到客户端，并增加 '#' 作为前缀。
  */
 void sql_debug(const char *fmt, ...);
+
+/**
+ * @brief 当前会话是否打开了SQL调试信息
+ * @details 准备调试信息本身开销较大时(比如每一行都转换成字符串)，先判断一下
+ */
+bool sql_debug_on();
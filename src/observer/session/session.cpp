@@ -24,7 +24,12 @@ Session &Session::default_session()
   return session;
 }
 
-Session::Session(const Session &other) : db_(other.db_)
+Session::Session(const Session &other)
+    : db_(other.db_),
+      vectorized_execution_(other.vectorized_execution_),
+      hash_join_memory_limit_(other.hash_join_memory_limit_),
+      sort_memory_limit_(other.sort_memory_limit_),
+      parallel_degree_(other.parallel_degree_)
 {}
 
 Session::~Session()
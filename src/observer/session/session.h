@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <stdint.h>
 #include <string>
 
 class Trx;
@@ -33,6 +34,11 @@ public:
    */
   static Session &default_session();
 
+  static constexpr int64_t DEFAULT_HASH_JOIN_MEMORY_LIMIT = 64 * 1024 * 1024;
+  static constexpr int64_t DEFAULT_SORT_MEMORY_LIMIT      = 64 * 1024 * 1024;
+  static constexpr int     DEFAULT_PARALLEL_DEGREE        = 1;
+  static constexpr int     MAX_PARALLEL_DEGREE            = 64;
+
 public:
   Session() = default;
   ~Session();
@@ -79,6 +85,18 @@ public:
   void set_sql_debug(bool sql_debug) { sql_debug_ = sql_debug; }
   bool sql_debug_on() const { return sql_debug_; }
 
+  void set_vectorized_execution(bool vectorized) { vectorized_execution_ = vectorized; }
+  bool vectorized_execution() const { return vectorized_execution_; }
+
+  void set_hash_join_memory_limit(int64_t limit) { hash_join_memory_limit_ = limit; }
+  int64_t hash_join_memory_limit() const { return hash_join_memory_limit_; }
+
+  void set_sort_memory_limit(int64_t limit) { sort_memory_limit_ = limit; }
+  int64_t sort_memory_limit() const { return sort_memory_limit_; }
+
+  void set_parallel_degree(int degree) { parallel_degree_ = degree; }
+  int  parallel_degree() const { return parallel_degree_; }
+
   /**
    * @brief 将指定会话设置到线程变量中
    * 
@@ -97,4 +115,8 @@ private:
   SessionEvent *current_request_ = nullptr; ///< 当前正在处理的请求
   bool trx_multi_operation_mode_ = false;   ///< 当前事务的模式，是否多语句模式. 单语句模式自动提交
   bool sql_debug_ = false;                  ///< 是否输出SQL调试信息
+  bool vectorized_execution_ = true;        ///< 查询是否尽量批量执行
+  int64_t hash_join_memory_limit_ = DEFAULT_HASH_JOIN_MEMORY_LIMIT; ///< 哈希连接构建端最多使用的内存，超过时把数据写到临时文件中
+  int64_t sort_memory_limit_ = DEFAULT_SORT_MEMORY_LIMIT;            ///< 排序最多使用的内存，超过时把排好序的数据写到临时文件中
+  int parallel_degree_ = DEFAULT_PARALLEL_DEGREE;                     ///< 一个查询最多同时使用的线程数，1表示不并行执行
 };
@@ -60,11 +60,11 @@ RC insert_record_from_file(Table *table,
     const FieldMeta *field = table->table_meta().field(i + sys_field_num);
 
     std::string &file_value = file_values[i];
-    if (field->type() != CHARS) {
+    if (field->value_type() != CHARS) {
       common::strip(file_value);
     }
 
-    switch (field->type()) {
+    switch (field->value_type()) {
       case INTS: {
         deserialize_stream.clear();  // 清理stream的状态，防止多次解析出现异常
         deserialize_stream.str(file_value);
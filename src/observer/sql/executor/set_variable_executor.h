@@ -49,6 +49,37 @@ public:
 
       session->set_sql_debug(bool_value);
       LOG_TRACE("set sql_debug to %d", bool_value);
+    } else if (strcasecmp(var_name, "vectorized_execution") == 0) {
+      bool bool_value = false;
+      rc = var_value_to_boolean(var_value, bool_value);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+
+      session->set_vectorized_execution(bool_value);
+      LOG_TRACE("set vectorized_execution to %d", bool_value);
+    } else if (strcasecmp(var_name, "hash_join_memory_limit") == 0) {
+      if (var_value.attr_type() != AttrType::INTS || var_value.get_int() <= 0) {
+        return RC::VARIABLE_NOT_VALID;
+      }
+
+      session->set_hash_join_memory_limit(var_value.get_int());
+      LOG_TRACE("set hash_join_memory_limit to %d", var_value.get_int());
+    } else if (strcasecmp(var_name, "sort_memory_limit") == 0) {
+      if (var_value.attr_type() != AttrType::INTS || var_value.get_int() <= 0) {
+        return RC::VARIABLE_NOT_VALID;
+      }
+
+      session->set_sort_memory_limit(var_value.get_int());
+      LOG_TRACE("set sort_memory_limit to %d", var_value.get_int());
+    } else if (strcasecmp(var_name, "parallel_degree") == 0) {
+      if (var_value.attr_type() != AttrType::INTS || var_value.get_int() <= 0 ||
+          var_value.get_int() > Session::MAX_PARALLEL_DEGREE) {
+        return RC::VARIABLE_NOT_VALID;
+      }
+
+      session->set_parallel_degree(var_value.get_int());
+      LOG_TRACE("set parallel_degree to %d", var_value.get_int());
     } else {
       rc = RC::VARIABLE_NOT_EXISTS;
     }
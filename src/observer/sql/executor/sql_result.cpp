@@ -33,7 +33,11 @@ RC SqlResult::open()
   }
 
   Trx *trx = session_->current_trx();
-  trx->start_if_need();
+  RC   rc  = trx->start_if_need();
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to start trx. rc=%s", strrc(rc));
+    return rc;
+  }
   return operator_->open(trx);
 }
 
@@ -0,0 +1,212 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <algorithm>
+
+#include "sql/expr/chunk.h"
+#include "common/log/log.h"
+
+using namespace std;
+
+void Column::init(AttrType attr_type, int capacity)
+{
+  attr_type_ = attr_type;
+  constant_  = false;
+  count_     = 0;
+  has_null_  = false;
+  data_.clear();
+  strings_.clear();
+  nulls_.clear();
+  reserve(capacity);
+}
+
+void Column::init_constant(const Value &value, int count)
+{
+  init(value.attr_type(), 1);
+  append_value(value);
+  constant_ = true;
+  count_    = count;
+}
+
+void Column::reserve(int count)
+{
+  if (static_cast<int>(nulls_.size()) >= count) {
+    return;
+  }
+
+  const int capacity = std::max(count, static_cast<int>(nulls_.size()) * 2);
+  nulls_.resize(capacity);
+  if (is_fixed(attr_type_)) {
+    data_.resize(capacity * FIXED_WIDTH);
+  } else if (attr_type_ == CHARS) {
+    strings_.resize(capacity);
+  }
+}
+
+void Column::append_null()
+{
+  reserve(count_ + 1);
+  has_null_        = true;
+  nulls_[count_++] = 1;
+}
+
+void Column::append_value(const Value &value)
+{
+  if (value.attr_type() == NULLS || attr_type_ == NULLS) {
+    append_null();
+    return;
+  }
+
+  // 与 Value::set_value 一样，类型不同时按照列的类型转换
+  switch (attr_type_) {
+    case INTS: {
+      int32_t val = value.get_int();
+      append_fixed(reinterpret_cast<const char *>(&val));
+    } break;
+    case FLOATS: {
+      float val = value.get_float();
+      append_fixed(reinterpret_cast<const char *>(&val));
+    } break;
+    case DATES: {
+      date val = value.get_date();
+      append_fixed(reinterpret_cast<const char *>(&val));
+    } break;
+    case BOOLEANS: {
+      int32_t val = value.get_boolean() ? 1 : 0;
+      append_fixed(reinterpret_cast<const char *>(&val));
+    } break;
+    case CHARS: {
+      if (value.attr_type() == CHARS) {
+        append_string(value.data(), value.length());
+      } else {
+        string str = value.to_string();
+        append_string(str.c_str(), static_cast<int>(str.size()));
+      }
+    } break;
+    default: {
+      LOG_WARN("unsupported column type: %d", attr_type_);
+      append_null();
+    } break;
+  }
+}
+
+Value Column::get_value(int index) const
+{
+  const int slot = constant_ ? 0 : index;
+  if (has_null_ && nulls_[slot] != 0) {
+    return Value(NULLS);
+  }
+
+  if (attr_type_ == CHARS) {
+    const string &str = strings_[slot];
+    return Value(str.c_str(), static_cast<int>(str.size()));
+  }
+
+  Value value;
+  value.set_type(attr_type_);
+  value.set_data(data_.data() + slot * FIXED_WIDTH, FIXED_WIDTH);
+  return value;
+}
+
+void Column::filter(const vector<uint8_t> &select, int selected)
+{
+  if (constant_) {
+    count_ = selected;
+    return;
+  }
+
+  const bool fixed = is_fixed(attr_type_);
+  const bool chars = attr_type_ == CHARS;
+  int        pos   = 0;
+  for (int i = 0; i < count_; i++) {
+    if (select[i] == 0) {
+      continue;
+    }
+    if (pos != i) {
+      if (fixed) {
+        memcpy(data_.data() + pos * FIXED_WIDTH, data_.data() + i * FIXED_WIDTH, FIXED_WIDTH);
+      } else if (chars) {
+        strings_[pos].swap(strings_[i]);
+      }
+      nulls_[pos] = nulls_[i];
+    }
+    pos++;
+  }
+  count_ = pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Chunk::add_column(shared_ptr<Column> column, const TupleCellSpec &spec)
+{
+  if (speces_.use_count() > 1) {
+    speces_ = make_shared<vector<TupleCellSpec>>(*speces_);
+  }
+  columns_.push_back(std::move(column));
+  speces_->push_back(spec);
+}
+
+void Chunk::reset()
+{
+  columns_.clear();
+  if (speces_.use_count() > 1) {
+    speces_ = make_shared<vector<TupleCellSpec>>();
+  } else {
+    speces_->clear();
+  }
+  rows_ = 0;
+}
+
+void Chunk::reset_data()
+{
+  for (shared_ptr<Column> &column : columns_) {
+    column->reset();
+  }
+  rows_ = 0;
+}
+
+void Chunk::filter(const vector<uint8_t> &select)
+{
+  int selected = 0;
+  for (int i = 0; i < rows_; i++) {
+    selected += (select[i] != 0);
+  }
+  if (selected == rows_) {
+    return;
+  }
+
+  for (shared_ptr<Column> &column : columns_) {
+    column->filter(select, selected);
+  }
+  rows_ = selected;
+}
+
+int Chunk::find_spec(const vector<TupleCellSpec> &speces, const TupleCellSpec &spec)
+{
+  const int size = static_cast<int>(speces.size());
+  for (int i = 0; i < size; i++) {
+    const TupleCellSpec &column_spec = speces[i];
+    if (0 == strcmp(spec.field_name(), column_spec.field_name()) &&
+        0 == strcmp(spec.table_name(), column_spec.table_name()) &&
+        0 == strcmp(spec.alias(), column_spec.alias())) {
+      return i;
+    }
+  }
+
+  for (int i = 0; i < size; i++) {
+    const TupleCellSpec &column_spec = speces[i];
+    if (0 == strcmp(spec.field_name(), column_spec.field_name()) &&
+        0 == strcmp(spec.table_name(), column_spec.table_name()) &&
+        0 == strcmp(column_spec.field_name(), column_spec.alias())) {
+      return i;
+    }
+  }
+  return -1;
+}
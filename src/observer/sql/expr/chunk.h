@@ -0,0 +1,206 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/rc.h"
+#include "sql/expr/tuple_cell.h"
+#include "sql/parser/value.h"
+
+/**
+ * @defgroup Chunk
+ * @brief 批量执行时算子之间传递的一批数据
+ * @details 按行执行时算子每次返回一个 Tuple，批量执行时每次返回一个 Chunk，
+ * Chunk 中每个字段的数据放在一个 Column 中，表达式和聚合可以按列处理整批数据
+ */
+
+/**
+ * @brief 一列数据
+ * @ingroup Chunk
+ * @details INTS、FLOATS、DATES、BOOLEANS 都是4字节的定长值，连续存放，可以直接当作数组访问。
+ * 字符串(包括 VARCHAR 和 TEXT 字段读出来的值)每个值一个 std::string，清空之后再次使用时会复用字符串的内存。
+ * 常量列只保存一个值，每一行都是这个值
+ */
+class Column
+{
+public:
+  Column() = default;
+  Column(AttrType attr_type, int capacity) { init(attr_type, capacity); }
+
+  void init(AttrType attr_type, int capacity);
+
+  /**
+   * @brief 初始化成常量列
+   * @param count 有多少行
+   */
+  void init_constant(const Value &value, int count);
+
+  /**
+   * @brief 清空数据，保留类型和已经分配的内存
+   */
+  void reset()
+  {
+    count_    = 0;
+    has_null_ = false;
+  }
+
+  void append_value(const Value &value);
+  void append_null();
+
+  /**
+   * @brief 追加一个定长值，data 指向4字节的数据
+   */
+  void append_fixed(const char *data)
+  {
+    reserve(count_ + 1);
+    memcpy(data_.data() + count_ * FIXED_WIDTH, data, FIXED_WIDTH);
+    nulls_[count_++] = 0;
+  }
+
+  /**
+   * @brief 追加一个字符串，列的类型需要是 CHARS
+   */
+  void append_string(const char *str, int len)
+  {
+    reserve(count_ + 1);
+    strings_[count_].assign(str, len);
+    nulls_[count_++] = 0;
+  }
+
+  Value get_value(int index) const;
+
+  bool is_null(int index) const { return has_null_ && nulls_[constant_ ? 0 : index] != 0; }
+  bool has_null() const { return has_null_; }
+
+  AttrType attr_type() const { return attr_type_; }
+  bool     constant() const { return constant_; }
+  int      count() const { return count_; }
+
+  /**
+   * @brief 定长值的数组
+   */
+  template <typename T>
+  const T *values() const
+  {
+    static_assert(sizeof(T) == FIXED_WIDTH, "column values are 4 bytes");
+    return reinterpret_cast<const T *>(data_.data());
+  }
+
+  /**
+   * @brief 定长值的原始数据，每个值 FIXED_WIDTH 字节
+   */
+  const char *data() const { return data_.data(); }
+
+  const std::string &string_at(int index) const { return strings_[constant_ ? 0 : index]; }
+
+  /**
+   * @brief 只保留 select 中不为0的行，顺序不变
+   * @param select 每一行一个标记，长度不少于 count
+   * @param selected 保留下来的行数
+   */
+  void filter(const std::vector<uint8_t> &select, int selected);
+
+public:
+  static constexpr int FIXED_WIDTH = 4;
+
+  /**
+   * @brief 按照类型确定值是定长的还是字符串，NULLS 类型的列没有数据
+   */
+  static bool is_fixed(AttrType attr_type)
+  {
+    return attr_type == INTS || attr_type == FLOATS || attr_type == DATES || attr_type == BOOLEANS;
+  }
+
+private:
+  void reserve(int count);
+
+private:
+  AttrType attr_type_ = UNDEFINED;
+  bool     constant_  = false;
+  bool     has_null_  = false;
+  int      count_     = 0;
+
+  std::vector<char>        data_;     ///< 定长值
+  std::vector<std::string> strings_;  ///< 字符串值
+  std::vector<uint8_t>     nulls_;    ///< 每一行是否为 NULL
+};
+
+/**
+ * @brief 一批数据
+ * @ingroup Chunk
+ * @details 每一列有一个 TupleCellSpec 描述它是哪个字段或者哪个聚合的结果，与 Tuple::find_cell 一样按照描述查找列。
+ * 列使用 shared_ptr 保存，投影这样的算子可以直接引用子算子的列，不需要复制数据。
+ * 行数单独记录，没有任何列时(比如只需要 COUNT(*))也能表示有多少行。
+ * 复制出来的 ChunkTuple 共享列的描述，修改描述时如果有共享就先复制一份
+ */
+class Chunk
+{
+public:
+  static constexpr int DEFAULT_CAPACITY = 1024;
+
+  Chunk() : speces_(std::make_shared<std::vector<TupleCellSpec>>()) {}
+
+  void add_column(std::shared_ptr<Column> column, const TupleCellSpec &spec);
+
+  /**
+   * @brief 去掉所有的列
+   */
+  void reset();
+
+  /**
+   * @brief 清空所有列的数据，保留列
+   */
+  void reset_data();
+
+  int column_num() const { return static_cast<int>(columns_.size()); }
+
+  Column       &column(int index) { return *columns_[index]; }
+  const Column &column(int index) const { return *columns_[index]; }
+
+  const std::shared_ptr<Column> &column_ptr(int index) const { return columns_[index]; }
+
+  const TupleCellSpec &spec(int index) const { return (*speces_)[index]; }
+
+  std::shared_ptr<const std::vector<TupleCellSpec>> speces() const { return speces_; }
+
+  /**
+   * @brief 查找 spec 描述的列，找不到时返回-1
+   */
+  int column_index(const TupleCellSpec &spec) const { return find_spec(*speces_, spec); }
+
+  int  rows() const { return rows_; }
+  void set_rows(int rows) { rows_ = rows; }
+  int  capacity() const { return capacity_; }
+  void set_capacity(int capacity) { capacity_ = capacity; }
+
+  /**
+   * @brief 只保留 select 中不为0的行
+   */
+  void filter(const std::vector<uint8_t> &select);
+
+  /**
+   * @brief 在列的描述中查找 spec
+   * @details 先找表名、字段名和别名都一样的，比如投影和聚合的结果。
+   * 再找表名和字段名一样的普通字段(别名就是字段名)，与 RowTuple::find_cell 一样不关心别名
+   */
+  static int find_spec(const std::vector<TupleCellSpec> &speces, const TupleCellSpec &spec);
+
+private:
+  std::vector<std::shared_ptr<Column>>         columns_;
+  std::shared_ptr<std::vector<TupleCellSpec>>  speces_;
+  int                                          rows_     = 0;
+  int                                          capacity_ = DEFAULT_CAPACITY;
+};
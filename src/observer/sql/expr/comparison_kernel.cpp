@@ -0,0 +1,314 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <math.h>
+#include <string.h>
+#include <array>
+
+#include "sql/expr/comparison_kernel.h"
+#include "common/defs.h"
+#include "common/log/log.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define KERNEL_WITH_AVX2
+#include <immintrin.h>
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+namespace {
+
+/**
+ * @brief 与 common::compare_float 一样的判断：a - b > EPSILON 时 a 比较大
+ * @details SIMD 中用 float 比较，所以取大于 EPSILON 的最小的 float，a - b >= 它和 a - b > EPSILON 的结果相同
+ */
+float float_epsilon()
+{
+  float eps = static_cast<float>(EPSILON);
+  if (static_cast<double>(eps) <= EPSILON) {
+    eps = nextafterf(eps, INFINITY);
+  }
+  return eps;
+}
+
+const float FLOAT_EPSILON = float_epsilon();
+
+/**
+ * @brief 每种类型的比较方式
+ * @details gt/lt 是逐个比较，simd_gt/simd_lt 一次比较8个值，返回每个值一个全1或全0的掩码
+ */
+struct IntTraits
+{
+  using T = int32_t;
+  static bool gt(T a, T b) { return a > b; }
+  static bool lt(T a, T b) { return a < b; }
+
+#ifdef KERNEL_WITH_AVX2
+  AVX2_TARGET static __m256i simd_gt(__m256i a, __m256i b) { return _mm256_cmpgt_epi32(a, b); }
+  AVX2_TARGET static __m256i simd_lt(__m256i a, __m256i b) { return _mm256_cmpgt_epi32(b, a); }
+#endif
+};
+
+struct DateTraits
+{
+  using T = uint32_t;
+  static bool gt(T a, T b) { return a > b; }
+  static bool lt(T a, T b) { return a < b; }
+
+#ifdef KERNEL_WITH_AVX2
+  // AVX2 只有有符号整数的比较，翻转最高位之后有符号比较的结果就是无符号比较的结果
+  AVX2_TARGET static __m256i flip(__m256i a) { return _mm256_xor_si256(a, _mm256_set1_epi32(INT32_MIN)); }
+  AVX2_TARGET static __m256i simd_gt(__m256i a, __m256i b) { return _mm256_cmpgt_epi32(flip(a), flip(b)); }
+  AVX2_TARGET static __m256i simd_lt(__m256i a, __m256i b) { return _mm256_cmpgt_epi32(flip(b), flip(a)); }
+#endif
+};
+
+struct FloatTraits
+{
+  using T = float;
+  static bool gt(T a, T b) { return a - b > EPSILON; }
+  static bool lt(T a, T b) { return a - b < -EPSILON; }
+
+#ifdef KERNEL_WITH_AVX2
+  AVX2_TARGET static __m256i simd_gt(__m256i a, __m256i b)
+  {
+    __m256 diff = _mm256_sub_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b));
+    return _mm256_castps_si256(_mm256_cmp_ps(diff, _mm256_set1_ps(FLOAT_EPSILON), _CMP_GE_OQ));
+  }
+  AVX2_TARGET static __m256i simd_lt(__m256i a, __m256i b)
+  {
+    __m256 diff = _mm256_sub_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b));
+    return _mm256_castps_si256(_mm256_cmp_ps(diff, _mm256_set1_ps(-FLOAT_EPSILON), _CMP_LE_OQ));
+  }
+#endif
+};
+
+/**
+ * @brief 根据大于和小于的结果得到比较运算的结果，相等就是既不大于也不小于
+ */
+template <CompOp COMP, typename B>
+inline B combine(B gt, B lt, B all)
+{
+  if constexpr (COMP == EQUAL_TO) {
+    return ~(gt | lt) & all;
+  } else if constexpr (COMP == NOT_EQUAL) {
+    return gt | lt;
+  } else if constexpr (COMP == LESS_THAN) {
+    return lt;
+  } else if constexpr (COMP == LESS_EQUAL) {
+    return ~gt & all;
+  } else if constexpr (COMP == GREAT_THAN) {
+    return gt;
+  } else {
+    static_assert(COMP == GREAT_EQUAL, "unsupported comparison");
+    return ~lt & all;
+  }
+}
+
+template <CompOp COMP>
+constexpr bool need_gt()
+{
+  return COMP != LESS_THAN && COMP != GREAT_EQUAL;
+}
+
+template <CompOp COMP>
+constexpr bool need_lt()
+{
+  return COMP != GREAT_THAN && COMP != LESS_EQUAL;
+}
+
+/**
+ * @brief 逐个比较。CONSTANT 为 true 时 right 只有一个值
+ */
+template <typename Traits, CompOp COMP, bool CONSTANT>
+void scalar_kernel(const char *left_data, const char *right_data, int count, uint8_t *select)
+{
+  using T          = typename Traits::T;
+  const T *left    = reinterpret_cast<const T *>(left_data);
+  const T *right   = reinterpret_cast<const T *>(right_data);
+  for (int i = 0; i < count; i++) {
+    const T a = left[i];
+    const T b = CONSTANT ? right[0] : right[i];
+    const unsigned gt = need_gt<COMP>() ? Traits::gt(a, b) : 0;
+    const unsigned lt = need_lt<COMP>() ? Traits::lt(a, b) : 0;
+    select[i]         = static_cast<uint8_t>(combine<COMP>(gt, lt, 1u));
+  }
+}
+
+#ifdef KERNEL_WITH_AVX2
+
+/**
+ * @brief 8个比较结果的位图展开成8个字节，每个字节是0或1
+ */
+constexpr std::array<uint64_t, 256> make_bit_bytes()
+{
+  std::array<uint64_t, 256> table{};
+  for (int bits = 0; bits < 256; bits++) {
+    uint64_t bytes = 0;
+    for (int i = 0; i < 8; i++) {
+      if (bits & (1 << i)) {
+        bytes |= uint64_t(1) << (i * 8);
+      }
+    }
+    table[bits] = bytes;
+  }
+  return table;
+}
+
+constexpr std::array<uint64_t, 256> BIT_BYTES = make_bit_bytes();
+
+template <typename Traits, CompOp COMP, bool CONSTANT>
+AVX2_TARGET void simd_kernel(const char *left_data, const char *right_data, int count, uint8_t *select)
+{
+  constexpr int LANES = 8;
+
+  __m256i right = CONSTANT ? _mm256_set1_epi32(*reinterpret_cast<const int32_t *>(right_data)) : _mm256_setzero_si256();
+
+  int i = 0;
+  for (; i + LANES <= count; i += LANES) {
+    __m256i left = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(left_data + i * sizeof(int32_t)));
+    if constexpr (!CONSTANT) {
+      right = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(right_data + i * sizeof(int32_t)));
+    }
+
+    unsigned gt = 0;
+    unsigned lt = 0;
+    if constexpr (need_gt<COMP>()) {
+      gt = _mm256_movemask_ps(_mm256_castsi256_ps(Traits::simd_gt(left, right)));
+    }
+    if constexpr (need_lt<COMP>()) {
+      lt = _mm256_movemask_ps(_mm256_castsi256_ps(Traits::simd_lt(left, right)));
+    }
+    const uint64_t bytes = BIT_BYTES[combine<COMP>(gt, lt, 0xFFu)];
+    memcpy(select + i, &bytes, sizeof(bytes));
+  }
+
+  // 剩下不足8个的逐个比较
+  scalar_kernel<Traits, COMP, CONSTANT>(left_data + i * sizeof(int32_t),
+      CONSTANT ? right_data : right_data + i * sizeof(int32_t),
+      count - i,
+      select + i);
+}
+
+bool detect_avx2()
+{
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+const bool AVX2_AVAILABLE = detect_avx2();
+
+#endif  // KERNEL_WITH_AVX2
+
+using KernelFunc = void (*)(const char *left, const char *right, int count, uint8_t *select);
+
+template <typename Traits, CompOp COMP, bool CONSTANT>
+KernelFunc choose_kernel(bool simd)
+{
+#ifdef KERNEL_WITH_AVX2
+  if (simd) {
+    return simd_kernel<Traits, COMP, CONSTANT>;
+  }
+#endif
+  return scalar_kernel<Traits, COMP, CONSTANT>;
+}
+
+template <typename Traits, bool CONSTANT>
+KernelFunc choose_kernel(CompOp comp, bool simd)
+{
+  switch (comp) {
+    case EQUAL_TO: return choose_kernel<Traits, EQUAL_TO, CONSTANT>(simd);
+    case NOT_EQUAL: return choose_kernel<Traits, NOT_EQUAL, CONSTANT>(simd);
+    case LESS_THAN: return choose_kernel<Traits, LESS_THAN, CONSTANT>(simd);
+    case LESS_EQUAL: return choose_kernel<Traits, LESS_EQUAL, CONSTANT>(simd);
+    case GREAT_THAN: return choose_kernel<Traits, GREAT_THAN, CONSTANT>(simd);
+    case GREAT_EQUAL: return choose_kernel<Traits, GREAT_EQUAL, CONSTANT>(simd);
+    default: return nullptr;
+  }
+}
+
+template <bool CONSTANT>
+KernelFunc choose_kernel(CompOp comp, AttrType type, ComparisonKernel::Mode mode)
+{
+  const bool simd = mode != ComparisonKernel::Mode::SCALAR && ComparisonKernel::simd_available();
+  switch (type) {
+    case INTS: return choose_kernel<IntTraits, CONSTANT>(comp, simd);
+    case FLOATS: return choose_kernel<FloatTraits, CONSTANT>(comp, simd);
+    case DATES: return choose_kernel<DateTraits, CONSTANT>(comp, simd);
+    default: return nullptr;
+  }
+}
+
+}  // namespace
+
+bool ComparisonKernel::support(CompOp comp, AttrType left_type, AttrType right_type)
+{
+  if (comp != EQUAL_TO && comp != NOT_EQUAL && comp != LESS_THAN && comp != LESS_EQUAL && comp != GREAT_THAN &&
+      comp != GREAT_EQUAL) {
+    return false;
+  }
+  if (left_type != INTS && left_type != FLOATS && left_type != DATES) {
+    return false;
+  }
+  return left_type == right_type || (left_type == FLOATS && right_type == INTS);
+}
+
+void ComparisonKernel::compare(
+    CompOp comp, AttrType type, const char *left, const Value &right, int count, uint8_t *select, Mode mode)
+{
+  // 常量按照列的类型转换成4字节的值
+  char value[sizeof(int32_t)];
+  switch (type) {
+    case INTS: {
+      int32_t val = right.get_int();
+      memcpy(value, &val, sizeof(val));
+    } break;
+    case FLOATS: {
+      float val = right.get_float();
+      memcpy(value, &val, sizeof(val));
+    } break;
+    case DATES: {
+      date val = right.get_date();
+      memcpy(value, &val, sizeof(val));
+    } break;
+    default: break;
+  }
+
+  KernelFunc kernel = choose_kernel<true>(comp, type, mode);
+  ASSERT(kernel != nullptr, "unsupported comparison. comp=%d, type=%d", comp, type);
+  kernel(left, value, count, select);
+}
+
+void ComparisonKernel::compare(
+    CompOp comp, AttrType type, const char *left, const char *right, int count, uint8_t *select, Mode mode)
+{
+  KernelFunc kernel = choose_kernel<false>(comp, type, mode);
+  ASSERT(kernel != nullptr, "unsupported comparison. comp=%d, type=%d", comp, type);
+  kernel(left, right, count, select);
+}
+
+CompOp ComparisonKernel::swap(CompOp comp)
+{
+  switch (comp) {
+    case LESS_THAN: return GREAT_THAN;
+    case LESS_EQUAL: return GREAT_EQUAL;
+    case GREAT_THAN: return LESS_THAN;
+    case GREAT_EQUAL: return LESS_EQUAL;
+    default: return comp;
+  }
+}
+
+bool ComparisonKernel::simd_available()
+{
+#ifdef KERNEL_WITH_AVX2
+  return AVX2_AVAILABLE;
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,65 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "sql/parser/parse_defs.h"
+#include "sql/parser/value.h"
+
+/**
+ * @brief 按列比较定长值的过滤函数
+ * @ingroup Chunk
+ * @details 一次比较一整列 INTS、FLOATS 或 DATES 类型的值，每一行的结果写到 select 中，满足条件是1，否则是0。
+ * 每种类型和比较运算都在编译期生成一个函数，循环中没有类型判断。CPU 支持 AVX2 时每次比较8个值，否则逐个比较。
+ * 比较的语义与 Value::compare 一样：浮点数的差在 EPSILON 之内认为相等，日期按照无符号数比较。
+ * 这里不处理 NULL，调用者需要自己把 NULL 所在行的结果清掉
+ */
+class ComparisonKernel
+{
+public:
+  enum class Mode
+  {
+    AUTO,    ///< CPU 支持时使用 AVX2
+    SCALAR,  ///< 逐个比较
+    SIMD,    ///< 使用 AVX2，CPU 不支持时退化成逐个比较
+  };
+
+  /**
+   * @brief 是否可以用这里的函数比较
+   * @param left_type  列的类型
+   * @param right_type 另一列或者常量的类型。FLOATS 列可以和 INTS 常量比较，常量会先转换成浮点数
+   */
+  static bool support(CompOp comp, AttrType left_type, AttrType right_type);
+
+  /**
+   * @brief 列与常量比较，left[i] comp right
+   * @param left 连续存放的 count 个4字节的值
+   */
+  static void compare(CompOp comp, AttrType type, const char *left, const Value &right, int count, uint8_t *select,
+      Mode mode = Mode::AUTO);
+
+  /**
+   * @brief 两列比较，left[i] comp right[i]，两列的类型相同
+   */
+  static void compare(CompOp comp, AttrType type, const char *left, const char *right, int count, uint8_t *select,
+      Mode mode = Mode::AUTO);
+
+  /**
+   * @brief 交换左右两边之后等价的比较运算，比如 a < b 等价于 b > a
+   */
+  static CompOp swap(CompOp comp);
+
+  /**
+   * @brief 当前 CPU 是否支持 AVX2
+   */
+  static bool simd_available();
+};
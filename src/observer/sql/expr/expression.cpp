@@ -14,20 +14,86 @@ See the Mulan PSL v2 for more details. */
 
 #include "sql/expr/expression.h"
 #include "sql/expr/tuple.h"
+#include "sql/expr/comparison_kernel.h"
 
 using namespace std;
 
+RC Expression::get_column(Chunk &chunk, shared_ptr<Column> &column) const
+{
+  column = make_shared<Column>(value_type(), chunk.rows());
+
+  ChunkTuple tuple;
+  Value      value;
+  for (int i = 0; i < chunk.rows(); i++) {
+    tuple.set_row(&chunk, i);
+    RC rc = get_value(tuple, value);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to get value of expression. rc=%s", strrc(rc));
+      return rc;
+    }
+    column->append_value(value);
+  }
+  return RC::SUCCESS;
+}
+
+RC Expression::eval(Chunk &chunk, vector<uint8_t> &select) const
+{
+  shared_ptr<Column> column;
+  RC rc = get_column(chunk, column);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  select.resize(chunk.rows());
+  for (int i = 0; i < chunk.rows(); i++) {
+    select[i] = !column->is_null(i) && column->get_value(i).get_boolean();
+  }
+  return RC::SUCCESS;
+}
+
+unique_ptr<Expression> FieldExpr::copy() const
+{
+  auto expr = make_unique<FieldExpr>(field_);
+  expr->set_name(name());
+  return expr;
+}
+
 RC FieldExpr::get_value(const Tuple &tuple, Value &value) const
 {
   return tuple.find_cell(TupleCellSpec(table_name(), field_name()), value);
 }
 
+RC FieldExpr::get_column(Chunk &chunk, shared_ptr<Column> &column) const
+{
+  const int index = chunk.column_index(TupleCellSpec(table_name(), field_name()));
+  if (index < 0) {
+    LOG_WARN("no such column in chunk. table=%s, field=%s", table_name(), field_name());
+    return RC::NOTFOUND;
+  }
+  column = chunk.column_ptr(index);
+  return RC::SUCCESS;
+}
+
+unique_ptr<Expression> ValueExpr::copy() const
+{
+  auto expr = make_unique<ValueExpr>(value_);
+  expr->set_name(name());
+  return expr;
+}
+
 RC ValueExpr::get_value(const Tuple &tuple, Value &value) const
 {
   value = value_;
   return RC::SUCCESS;
 }
 
+RC ValueExpr::get_column(Chunk &chunk, shared_ptr<Column> &column) const
+{
+  column = make_shared<Column>();
+  column->init_constant(value_, chunk.rows());
+  return RC::SUCCESS;
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 CastExpr::CastExpr(unique_ptr<Expression> child, AttrType cast_type)
     : child_(std::move(child)), cast_type_(cast_type)
@@ -36,6 +102,13 @@ CastExpr::CastExpr(unique_ptr<Expression> child, AttrType cast_type)
 CastExpr::~CastExpr()
 {}
 
+unique_ptr<Expression> CastExpr::copy() const
+{
+  auto expr = make_unique<CastExpr>(child_->copy(), cast_type_);
+  expr->set_name(name());
+  return expr;
+}
+
 RC CastExpr::cast(const Value &value, Value &cast_value) const
 {
   RC rc = RC::SUCCESS;
@@ -86,6 +159,13 @@ ComparisonExpr::ComparisonExpr(CompOp comp, unique_ptr<Expression> left, unique_
 ComparisonExpr::~ComparisonExpr()
 {}
 
+unique_ptr<Expression> ComparisonExpr::copy() const
+{
+  auto expr = make_unique<ComparisonExpr>(comp_, left_->copy(), right_->copy());
+  expr->set_name(name());
+  return expr;
+}
+
 RC ComparisonExpr::compare_value(const Value &left, const Value &right, bool &result) const
 {
   RC rc = RC::SUCCESS;
@@ -100,6 +180,9 @@ RC ComparisonExpr::compare_value(const Value &left, const Value &right, bool &re
       // 其他一律返回false
       result = false;
     }
+  } else if (left.attr_type() == NULLS) {
+    // NULL 和任何值比较的结果都不成立
+    result = false;
   } else {
     int cmp_result = left.compare(right);
     switch (comp_) {
@@ -176,11 +259,104 @@ RC ComparisonExpr::get_value(const Tuple &tuple, Value &value) const
   return rc;
 }
 
+RC ComparisonExpr::eval(Chunk &chunk, vector<uint8_t> &select) const
+{
+  shared_ptr<Column> left_column;
+  shared_ptr<Column> right_column;
+  RC rc = left_->get_column(chunk, left_column);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to get column of left expression. rc=%s", strrc(rc));
+    return rc;
+  }
+  rc = right_->get_column(chunk, right_column);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to get column of right expression. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  const int rows = chunk.rows();
+  select.resize(rows);
+  if (eval_fixed(*left_column, *right_column, rows, select)) {
+    return RC::SUCCESS;
+  }
+
+  // 常量只需要取一次值
+  Value left_value;
+  Value right_value;
+  if (left_column->constant()) {
+    left_value = left_column->get_value(0);
+  }
+  if (right_column->constant()) {
+    right_value = right_column->get_value(0);
+  }
+
+  for (int i = 0; i < rows && rc == RC::SUCCESS; i++) {
+    if (!left_column->constant()) {
+      left_value = left_column->get_value(i);
+    }
+    if (!right_column->constant()) {
+      right_value = right_column->get_value(i);
+    }
+
+    bool result = false;
+    rc          = compare_value(left_value, right_value, result);
+    select[i]   = result;
+  }
+  return rc;
+}
+
+bool ComparisonExpr::eval_fixed(const Column &left, const Column &right, int rows, vector<uint8_t> &select) const
+{
+  if (left.constant() && right.constant()) {
+    return false;
+  }
+
+  // 常量放在右边
+  const Column *column = &left;
+  const Column *other  = &right;
+  CompOp        comp   = comp_;
+  if (left.constant()) {
+    std::swap(column, other);
+    comp = ComparisonKernel::swap(comp_);
+  }
+
+  if (!ComparisonKernel::support(comp, column->attr_type(), other->attr_type())) {
+    return false;
+  }
+
+  if (other->constant()) {
+    ComparisonKernel::compare(comp, column->attr_type(), column->data(), other->get_value(0), rows, select.data());
+  } else {
+    ComparisonKernel::compare(comp, column->attr_type(), column->data(), other->data(), rows, select.data());
+  }
+
+  // NULL 和任何值比较的结果都不成立
+  for (const Column *col : {column, other}) {
+    if (col->has_null()) {
+      for (int i = 0; i < rows; i++) {
+        select[i] &= !col->is_null(i);
+      }
+    }
+  }
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ConjunctionExpr::ConjunctionExpr(Type type, vector<unique_ptr<Expression>> &children)
     : conjunction_type_(type), children_(std::move(children))
 {}
 
+unique_ptr<Expression> ConjunctionExpr::copy() const
+{
+  vector<unique_ptr<Expression>> children;
+  for (const unique_ptr<Expression> &child : children_) {
+    children.push_back(child->copy());
+  }
+  auto expr = make_unique<ConjunctionExpr>(conjunction_type_, children);
+  expr->set_name(name());
+  return expr;
+}
+
 RC ConjunctionExpr::get_value(const Tuple &tuple, Value &value) const
 {
   RC rc = RC::SUCCESS;
@@ -208,6 +384,32 @@ RC ConjunctionExpr::get_value(const Tuple &tuple, Value &value) const
   return rc;
 }
 
+RC ConjunctionExpr::eval(Chunk &chunk, vector<uint8_t> &select) const
+{
+  const int rows = chunk.rows();
+  select.assign(rows, conjunction_type_ == Type::AND ? 1 : 0);
+
+  vector<uint8_t> child_select;
+  for (const unique_ptr<Expression> &expr : children_) {
+    RC rc = expr->eval(chunk, child_select);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to eval child expression. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    if (conjunction_type_ == Type::AND) {
+      for (int i = 0; i < rows; i++) {
+        select[i] &= child_select[i];
+      }
+    } else {
+      for (int i = 0; i < rows; i++) {
+        select[i] |= child_select[i];
+      }
+    }
+  }
+  return RC::SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 ArithmeticExpr::ArithmeticExpr(ArithmeticExpr::Type type, Expression *left, Expression *right)
@@ -217,6 +419,14 @@ ArithmeticExpr::ArithmeticExpr(ArithmeticExpr::Type type, unique_ptr<Expression>
     : arithmetic_type_(type), left_(std::move(left)), right_(std::move(right))
 {}
 
+unique_ptr<Expression> ArithmeticExpr::copy() const
+{
+  // 取负数时没有右边的表达式
+  auto expr = make_unique<ArithmeticExpr>(arithmetic_type_, left_->copy(), right_ ? right_->copy() : nullptr);
+  expr->set_name(name());
+  return expr;
+}
+
 AttrType ArithmeticExpr::value_type() const
 {
   if (!right_) {
@@ -374,6 +584,13 @@ AggregationExpr::AggregationExpr(Field field, AggrFuncType aggr_type)
   }
 }
 
+unique_ptr<Expression> AggregationExpr::copy() const
+{
+  auto expr = make_unique<AggregationExpr>(field_, aggr_type_);
+  expr->set_name(name());
+  return expr;
+}
+
 RC AggregationExpr::get_value(const Tuple &tuple, Value &value) const { return RC::SUCCESS; }
 
 RC AggregationExpr::try_get_value(Value &value) const { return RC::SUCCESS; }
@@ -410,49 +627,146 @@ TupleCellSpec AggregationExpr::cell_spec(bool with_table_name) const
   return TupleCellSpec(field_.table_name(), field_.field_name(), alias.c_str());
 }
 
-RC AggregationExpr::begin_aggr() 
+void AggregationExpr::begin_aggr(AggrState &state) const
 { 
-  i_val_ = 0;
-  f_val_ = 0;
-  value_ = Value();
-  has_record = false;
-  return RC::SUCCESS;
+  state = AggrState();
 }
 
-RC AggregationExpr::aggr_tuple(Tuple *&tuple) 
+RC AggregationExpr::aggr_tuple(AggrState &state, const Tuple &tuple) const
 { 
   Value value;
-  field_expr_->get_value(*tuple, value);
+  field_expr_->get_value(tuple, value);
   // 当要聚合的值不是NULL时才进行聚合
   if(value.attr_type()!=NULLS){
-    has_record=true;
-    return (this->*aggr_func_)(value);
+    state.has_record=true;
+    return (this->*aggr_func_)(state, value);
+  }
+  return RC::SUCCESS;
+}
+
+RC AggregationExpr::aggr_chunk(AggrState &state, const Chunk &chunk) const
+{
+  // COUNT(*) 的字段在表中不存在，按行执行时每一行都会计数
+  if (aggr_type_ == COUNT_AGGR_T && 0 == strcmp(field_.field_name(), "*")) {
+    state.i_val += chunk.rows();
+    state.has_record = state.has_record || chunk.rows() > 0;
+    return RC::SUCCESS;
+  }
+
+  const int index = chunk.column_index(field_expr_->cell_spec());
+  if (index < 0) {
+    LOG_WARN("no such column in chunk. table=%s, field=%s", field_.table_name(), field_.field_name());
+    return RC::NOTFOUND;
+  }
+
+  const Column &column = chunk.column(index);
+  const int     rows   = chunk.rows();
+  const bool    typed  = column.attr_type() == field_.attr_type() &&
+                     (column.attr_type() == INTS || column.attr_type() == FLOATS) && !column.constant();
+  if (typed && (aggr_type_ == SUM_AGGR_T || aggr_type_ == AVG_AGGR_T || aggr_type_ == COUNT_AGGR_T)) {
+    // 与 sum_aggr_func 等函数的计算方式一致，只是不再为每一行构造 Value
+    const bool has_null = column.has_null();
+    long long  count    = 0;
+    if (column.attr_type() == INTS) {
+      const int32_t *values = column.values<int32_t>();
+      long long      i_sum  = 0;
+      long double    f_sum  = 0;
+      for (int i = 0; i < rows; i++) {
+        if (has_null && column.is_null(i)) {
+          continue;
+        }
+        count++;
+        i_sum += values[i];
+        f_sum += static_cast<float>(values[i]);
+      }
+      if (aggr_type_ == SUM_AGGR_T) {
+        state.i_val += i_sum;
+      } else if (aggr_type_ == AVG_AGGR_T) {
+        state.f_val += f_sum;
+        state.i_val += count;
+      } else {
+        state.i_val += count;
+      }
+    } else {
+      const float *values = column.values<float>();
+      long double  f_sum  = 0;
+      for (int i = 0; i < rows; i++) {
+        if (has_null && column.is_null(i)) {
+          continue;
+        }
+        count++;
+        f_sum += values[i];
+      }
+      if (aggr_type_ != COUNT_AGGR_T) {
+        state.f_val += f_sum;
+      }
+      if (aggr_type_ != SUM_AGGR_T) {
+        state.i_val += count;
+      }
+    }
+    state.has_record = state.has_record || count > 0;
+    return RC::SUCCESS;
+  }
+
+  Value value;
+  for (int i = 0; i < rows; i++) {
+    if (column.is_null(i)) {
+      continue;
+    }
+    value = column.get_value(i);
+    state.has_record = true;
+    RC rc = (this->*aggr_func_)(state, value);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC AggregationExpr::merge_state(AggrState &state, const AggrState &other) const
+{
+  switch (aggr_type_) {
+    case MAX_AGGR_T:
+    case MIN_AGGR_T: {
+      if (other.value.attr_type() != AttrType::UNDEFINED) {
+        RC rc = (this->*aggr_func_)(state, other.value);
+        if (rc != RC::SUCCESS) {
+          return rc;
+        }
+      }
+    } break;
+    default: {
+      // COUNT、SUM、AVG 的状态都是累加的计数和总和
+      state.i_val += other.i_val;
+      state.f_val += other.f_val;
+    } break;
   }
+  state.has_record = state.has_record || other.has_record;
   return RC::SUCCESS;
 }
 
-RC AggregationExpr::get_result(Value &value) 
+RC AggregationExpr::get_result(const AggrState &state, Value &value) const
 { 
-  if(has_record){
+  if(state.has_record){
     switch (aggr_type_ ) {
       case MAX_AGGR_T:
       case MIN_AGGR_T: {
-        value = value_;
+        value = state.value;
       } break;
       case COUNT_AGGR_T: {
-        value = Value((int)i_val_);
+        value = Value((int)state.i_val);
       } break;
       case SUM_AGGR_T: {
         if (attr_type_ == AttrType::INTS)
-          value = Value((int)i_val_);
+          value = Value((int)state.i_val);
         else
-          value = Value((float)f_val_);
+          value = Value((float)state.f_val);
       } break;
       case AVG_AGGR_T: {
-        if (i_val_ == 0) {
+        if (state.i_val == 0) {
           value = Value((float)0);
         } else {
-          value = Value((float)(f_val_ / i_val_));
+          value = Value((float)(state.f_val / state.i_val));
         }
       } break;
       default: {
@@ -462,7 +776,7 @@ RC AggregationExpr::get_result(Value &value)
   }else{
     // 没有被聚合的元组时，除了COUNT都返回NULL
     if(aggr_type_==COUNT_AGGR_T){
-      value = Value((int)i_val_);
+      value = Value((int)state.i_val);
     }else{
       value=Value(NULLS);
     }
@@ -471,40 +785,40 @@ RC AggregationExpr::get_result(Value &value)
   return RC::SUCCESS;
 }
 
-RC AggregationExpr::max_aggr_func(Value &value) 
+RC AggregationExpr::max_aggr_func(AggrState &state, const Value &value) const
 { 
-  if (value_.attr_type() == AttrType::UNDEFINED) {
-    value_ = value;
+  if (state.value.attr_type() == AttrType::UNDEFINED) {
+    state.value = value;
     return RC::SUCCESS;
   }
-  int rt = value_.compare(value);
+  int rt = state.value.compare(value);
   if (rt < 0) {
-    value_ = value;
+    state.value = value;
   }
   return RC::SUCCESS;
 }
 
-RC AggregationExpr::min_aggr_func(Value &value) 
+RC AggregationExpr::min_aggr_func(AggrState &state, const Value &value) const
 { 
-  if (value_.attr_type() == AttrType::UNDEFINED) {
-    value_ = value;
+  if (state.value.attr_type() == AttrType::UNDEFINED) {
+    state.value = value;
     return RC::SUCCESS;
   }
-  int rt = value_.compare(value);
+  int rt = state.value.compare(value);
   if (rt > 0) {
-    value_ = value;
+    state.value = value;
   }
   return RC::SUCCESS;
 }
 
-RC AggregationExpr::sum_aggr_func(Value &value) 
+RC AggregationExpr::sum_aggr_func(AggrState &state, const Value &value) const
 { 
   switch (attr_type_ ) {
     case INTS: {
-      i_val_ += value.get_int();
+      state.i_val += value.get_int();
     } break;
     case FLOATS: {
-      f_val_ += value.get_float();
+      state.f_val += value.get_float();
     } break;
     default: {
       return RC::INTERNAL;
@@ -513,25 +827,25 @@ RC AggregationExpr::sum_aggr_func(Value &value)
   return RC::SUCCESS;
 }
 
-RC AggregationExpr::avg_aggr_func(Value &value) 
+RC AggregationExpr::avg_aggr_func(AggrState &state, const Value &value) const
 { 
   switch (attr_type_ ) {
     case INTS: {
-      f_val_ += (float)value.get_int();
+      state.f_val += (float)value.get_int();
     } break;
     case FLOATS: {
-      f_val_ += value.get_float();
+      state.f_val += value.get_float();
     } break;
     default: {
       return RC::INTERNAL;
     }
   }
-  i_val_ += 1; 
+  state.i_val += 1; 
   return RC::SUCCESS;
 }
 
-RC AggregationExpr::count_aggr_func(Value &value) 
+RC AggregationExpr::count_aggr_func(AggrState &state, const Value &value) const
 { 
-  i_val_ += 1; 
+  state.i_val += 1; 
   return RC::SUCCESS;
 }
\ No newline at end of file
@@ -14,9 +14,11 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <stdint.h>
 #include <string.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "storage/field/field.h"
 #include "sql/parser/value.h"
@@ -24,6 +26,8 @@ See the Mulan PSL v2 for more details. */
 #include "sql/expr/tuple_cell.h"
 
 class Tuple;
+class Chunk;
+class Column;
 
 /**
  * @defgroup Expression
@@ -70,6 +74,19 @@ public:
    */
   virtual RC get_value(const Tuple &tuple, Value &value) const = 0;
 
+  /**
+   * @brief 批量计算表达式的值，chunk 中的每一行得到一个值
+   * @details 默认逐行调用 get_value。字段、常量这样的表达式可以直接给出整列
+   * @param column 计算结果，可能直接引用 chunk 中的列，不能修改
+   */
+  virtual RC get_column(Chunk &chunk, std::shared_ptr<Column> &column) const;
+
+  /**
+   * @brief 把表达式当作过滤条件批量计算
+   * @param select 每一行是否满足条件，值为 NULL 的行不满足
+   */
+  virtual RC eval(Chunk &chunk, std::vector<uint8_t> &select) const;
+
   /**
    * @brief 在没有实际运行的情况下，也就是无法获取tuple的情况下，尝试获取表达式的值
    * @details 有些表达式的值是固定的，比如ValueExpr，这种情况下可以直接获取值
@@ -91,6 +108,12 @@ public:
    */
   virtual AttrType value_type() const = 0;
 
+  /**
+   * @brief 复制一个相同的表达式
+   * @details 并行执行时每个流水线都要有自己的算子，算子中的表达式也各自复制一份
+   */
+  virtual std::unique_ptr<Expression> copy() const = 0;
+
   /**
    * @brief 表达式的名字，比如是字段名称，或者用户在执行SQL语句时输入的内容
    */
@@ -119,6 +142,8 @@ public:
   ExprType type() const override { return ExprType::FIELD; }
   AttrType value_type() const override { return field_.attr_type(); }
 
+  std::unique_ptr<Expression> copy() const override;
+
   Field &field() { return field_; }
 
   const Field &field() const { return field_; }
@@ -128,6 +153,7 @@ public:
   const char *field_name() const { return field_.field_name(); }
 
   RC get_value(const Tuple &tuple, Value &value) const override;
+  RC get_column(Chunk &chunk, std::shared_ptr<Column> &column) const override;
 
   TupleCellSpec cell_spec(bool with_table_name = false)
   {
@@ -155,12 +181,15 @@ public:
   virtual ~ValueExpr() = default;
 
   RC get_value(const Tuple &tuple, Value &value) const override;
+  RC get_column(Chunk &chunk, std::shared_ptr<Column> &column) const override;
   RC try_get_value(Value &value) const override { value = value_; return RC::SUCCESS; }
 
   ExprType type() const override { return ExprType::VALUE; }
 
   AttrType value_type() const override { return value_.attr_type(); }
 
+  std::unique_ptr<Expression> copy() const override;
+
   void get_value(Value &value) const { value = value_; }
 
   const Value &get_value() const { return value_; }
@@ -189,6 +218,8 @@ public:
 
   AttrType value_type() const override { return cast_type_; }
 
+  std::unique_ptr<Expression> copy() const override;
+
   std::unique_ptr<Expression> &child() { return child_; }
 
 private:
@@ -212,9 +243,12 @@ public:
   ExprType type() const override { return ExprType::COMPARISON; }
 
   RC get_value(const Tuple &tuple, Value &value) const override;
+  RC eval(Chunk &chunk, std::vector<uint8_t> &select) const override;
 
   AttrType value_type() const override { return BOOLEANS; }
 
+  std::unique_ptr<Expression> copy() const override;
+
   CompOp comp() const { return comp_; }
 
   std::unique_ptr<Expression> &left()  { return left_;  }
@@ -232,6 +266,13 @@ public:
    */
   RC compare_value(const Value &left, const Value &right, bool &value) const;
 
+private:
+  /**
+   * @brief 定长值的列用 ComparisonKernel 整列比较
+   * @return 不能这样比较时返回 false，由调用者逐行比较
+   */
+  bool eval_fixed(const Column &left, const Column &right, int rows, std::vector<uint8_t> &select) const;
+
 private:
   CompOp comp_;
   std::unique_ptr<Expression> left_;
@@ -260,7 +301,10 @@ public:
 
   AttrType value_type() const override { return BOOLEANS; }
 
+  std::unique_ptr<Expression> copy() const override;
+
   RC get_value(const Tuple &tuple, Value &value) const override;
+  RC eval(Chunk &chunk, std::vector<uint8_t> &select) const override;
 
   Type conjunction_type() const { return conjunction_type_; }
 
@@ -295,6 +339,8 @@ public:
 
   AttrType value_type() const override;
 
+  std::unique_ptr<Expression> copy() const override;
+
   RC get_value(const Tuple &tuple, Value &value) const override;
   RC try_get_value(Value &value) const override;
 
@@ -312,6 +358,18 @@ private:
   std::unique_ptr<Expression> right_;
 };
 
+/**
+ * @brief 聚合函数的中间状态
+ * @details 聚合表达式本身不保存状态，分组聚合时每个分组一份，由聚合算子保存
+ */
+struct AggrState
+{
+  bool          has_record = false;  // 是否聚合过不是 NULL 的值
+  Value         value;               // MAX/MIN 的当前结果
+  long long int i_val = 0;
+  long double   f_val = 0;
+};
+
 class AggregationExpr : public Expression
 {
 public:
@@ -325,6 +383,7 @@ public:
 
   ExprType type() const override { return ExprType::AGGREGATION; }
   AttrType value_type() const override { return attr_type_; };
+  std::unique_ptr<Expression> copy() const override;
 public:
   RC get_value(const Tuple &tuple, Value &value) const override;
   RC try_get_value(Value &value) const override;
@@ -334,27 +393,26 @@ public:
 public:
   AggrFuncType aggr_type() const { return aggr_type_; }
   // 开始聚合
-  RC begin_aggr();
+  void begin_aggr(AggrState &state) const;
   // 添加聚合
-  RC aggr_tuple(Tuple *&tuple);
+  RC aggr_tuple(AggrState &state, const Tuple &tuple) const;
+  // 批量添加聚合，按列累加，不需要为每一行生成元组
+  RC aggr_chunk(AggrState &state, const Chunk &chunk) const;
+  // 把另一份聚合状态合并进来，比如并行执行时各个线程分别聚合的结果
+  RC merge_state(AggrState &state, const AggrState &other) const;
   // 获取聚合结果
-  RC get_result(Value &value);
+  RC get_result(const AggrState &state, Value &value) const;
 public:
-  RC max_aggr_func(Value &value);
-  RC min_aggr_func(Value &value);
-  RC sum_aggr_func(Value &value);
-  RC avg_aggr_func(Value &value);
-  RC count_aggr_func(Value &value);
+  RC max_aggr_func(AggrState &state, const Value &value) const;
+  RC min_aggr_func(AggrState &state, const Value &value) const;
+  RC sum_aggr_func(AggrState &state, const Value &value) const;
+  RC avg_aggr_func(AggrState &state, const Value &value) const;
+  RC count_aggr_func(AggrState &state, const Value &value) const;
 
 private:
   AggrFuncType aggr_type_;  // 聚合函数类型
   AttrType attr_type_;      // 聚合结果类型
   Field field_;             // 要聚合的列
   FieldExpr *field_expr_ = nullptr;
-private:
-  bool has_record = false;
-  Value value_;
-  long long int i_val_;
-  long double   f_val_;
-  RC (AggregationExpr:: *aggr_func_)(Value &value);
+  RC (AggregationExpr:: *aggr_func_)(AggrState &state, const Value &value) const;
 };
\ No newline at end of file
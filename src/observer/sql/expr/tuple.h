@@ -20,10 +20,12 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/log/log.h"
 #include "sql/expr/tuple_cell.h"
+#include "sql/expr/chunk.h"
 #include "sql/parser/parse.h"
 #include "sql/parser/value.h"
 #include "sql/expr/expression.h"
 #include "storage/record/record.h"
+#include "storage/table/table.h"
 
 class Table;
 
@@ -110,6 +112,15 @@ public:
    */
   virtual RC find_cell(const TupleCellSpec &spec, Value &cell) const = 0;
 
+  /**
+   * @brief 获取指定位置的Cell的描述
+   * @details 把元组中的值复制出来时使用，按照这个描述可以在复制出来的元组中找到对应的Cell
+   *
+   * @param index 位置
+   * @param[out] spec 返回的描述
+   */
+  virtual RC spec_at(int index, TupleCellSpec &spec) const = 0;
+
   virtual std::string to_string() const
   {
     std::string str;
@@ -139,28 +150,27 @@ class RowTuple : public Tuple
 {
 public:
   RowTuple() = default;
-  virtual ~RowTuple()
-  {
-    for (FieldExpr *spec : speces_) {
-      delete spec;
-    }
-    speces_.clear();
-  }
+  virtual ~RowTuple() = default;
 
-  RowTuple(const RowTuple &other)
-  {
-    if (other.record_)
-      record_ = new Record(*(other.record_));
-    table_ = other.table_;
-    for (auto fieldExpr : other.speces_) {
-      if (fieldExpr) {
-        speces_.push_back(new FieldExpr(*fieldExpr));
-      } else {
-        speces_.push_back(nullptr);
-      }
+  /**
+   * @details 扫描出来的记录直接指向页面，扫描继续往后走之后记录数据就无效了。
+   * 需要物化的算子(排序、聚合等)通过复制元组保存数据，所以这里把记录数据复制一份。
+   * 字段描述在所有复制出来的元组之间共享，不再复制
+   */
+  RowTuple(const RowTuple &other) : table_(other.table_), speces_(other.speces_)
+  {
+    if (other.record_) {
+      const int len  = other.record_->len();
+      char     *data = static_cast<char *>(malloc(len));
+      memcpy(data, other.record_->data(), len);
+      owned_record_.set_rid(other.record_->rid());
+      owned_record_.set_data_owner(data, len);
+      record_ = &owned_record_;
     }
   }
 
+  RowTuple &operator=(const RowTuple &other) = delete;
+
   Tuple* clone() const override {
     return new RowTuple(*this);
   }
@@ -173,30 +183,47 @@ public:
   void set_schema(const Table *table, const std::vector<FieldMeta> *fields)
   {
     table_ = table;
-    this->speces_.reserve(fields->size());
+    auto speces = std::make_shared<std::vector<FieldExpr>>();
+    speces->reserve(fields->size());
     for (const FieldMeta &field : *fields) {
-      speces_.push_back(new FieldExpr(table, &field));
+      speces->emplace_back(table, &field);
     }
+    speces_ = std::move(speces);
   }
 
   int cell_num() const override
   {
-    return speces_.size();
+    return speces_ ? static_cast<int>(speces_->size()) : 0;
   }
 
   RC cell_at(int index, Value &cell) const override
   {
-    if (index < 0 || index >= static_cast<int>(speces_.size())) {
+    if (index < 0 || index >= cell_num()) {
       LOG_WARN("invalid argument. index=%d", index);
       return RC::INVALID_ARGUMENT;
     }
 
-    FieldExpr *field_expr = speces_[index];
-    const FieldMeta *field_meta = field_expr->field().meta();
-    if(strcasecmp(this->record_->data() + field_meta->offset(),"null")==0){
+    const FieldMeta *field_meta = (*speces_)[index].field().meta();
+    // speces_ 与表的字段顺序一致，下标就是字段在 NULL 位图中的位置
+    if (table_->table_meta().is_null(this->record_->data(), index)) {
       cell.set_type(NULLS);
-      cell.set_data(this->record_->data() + field_meta->offset(), 4);
-    }else{
+      cell.set_data(this->record_->data() + field_meta->offset(), 0);
+    } else if (field_meta->type() == VARCHARS) {
+      VarcharRef ref;
+      memcpy(&ref, this->record_->data() + field_meta->offset(), sizeof(ref));
+      cell.set_string(ref.len > 0 ? this->record_->data() + ref.offset : "", ref.len);
+    } else if (field_meta->type() == TEXTS) {
+      // 访问到这个字段时才读取溢出页
+      TextRef     ref;
+      std::string text;
+      memcpy(&ref, this->record_->data() + field_meta->offset(), sizeof(ref));
+      RC rc = table_->read_text(ref, text);
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to read text. table=%s, field=%s, rc=%s", table_->name(), field_meta->name(), strrc(rc));
+        return rc;
+      }
+      cell.set_string(text.c_str(), static_cast<int>(text.size()));
+    } else {
       cell.set_type(field_meta->type());
       cell.set_data(this->record_->data() + field_meta->offset(), field_meta->len());
     }
@@ -211,9 +238,8 @@ public:
       return RC::NOTFOUND;
     }
 
-    for (size_t i = 0; i < speces_.size(); ++i) {
-      const FieldExpr *field_expr = speces_[i];
-      const Field &field = field_expr->field();
+    for (int i = 0; i < cell_num(); ++i) {
+      const Field &field = (*speces_)[i].field();
       if (0 == strcmp(field_name, field.field_name())) {
         return cell_at(i, cell);
       }
@@ -221,6 +247,18 @@ public:
     return RC::NOTFOUND;
   }
 
+  RC spec_at(int index, TupleCellSpec &spec) const override
+  {
+    if (index < 0 || index >= cell_num()) {
+      LOG_WARN("invalid argument. index=%d", index);
+      return RC::INVALID_ARGUMENT;
+    }
+
+    const Field &field = (*speces_)[index].field();
+    spec = TupleCellSpec(table_->name(), field.field_name(), field.field_name());
+    return RC::SUCCESS;
+  }
+
 #if 0
   RC cell_spec_at(int index, const TupleCellSpec *&spec) const override
   {
@@ -245,8 +283,9 @@ public:
 
 private:
   Record *record_ = nullptr;
+  Record  owned_record_;  ///< 复制元组时复制出来的记录，record_ 指向它
   const Table *table_ = nullptr;
-  std::vector<FieldExpr *> speces_;
+  std::shared_ptr<const std::vector<FieldExpr>> speces_;
 };
 
 /**
@@ -279,6 +318,10 @@ public:
   {
     speces_.push_back(spec);
   }
+  const TupleCellSpec &cell_spec_at(int index) const
+  {
+    return *speces_[index];
+  }
   int cell_num() const override
   {
     return speces_.size();
@@ -302,6 +345,15 @@ public:
     return tuple_->find_cell(spec, cell);
   }
 
+  RC spec_at(int index, TupleCellSpec &spec) const override
+  {
+    if (index < 0 || index >= static_cast<int>(speces_.size())) {
+      return RC::INTERNAL;
+    }
+    spec = *speces_[index];
+    return RC::SUCCESS;
+  }
+
 #if 0
   RC cell_spec_at(int index, const TupleCellSpec *&spec) const override
   {
@@ -356,6 +408,14 @@ public:
     return RC::NOTFOUND;
   }
 
+  RC spec_at(int index, TupleCellSpec &spec) const override
+  {
+    if (index < 0 || index >= static_cast<int>(expressions_.size())) {
+      return RC::INTERNAL;
+    }
+    spec = TupleCellSpec(expressions_[index]->name().c_str());
+    return RC::SUCCESS;
+  }
 
 private:
   const std::vector<std::unique_ptr<Expression>> &expressions_;
@@ -411,6 +471,16 @@ public:
     return RC::EMPTY;
   }
 
+  virtual RC spec_at(int index, TupleCellSpec &spec) const override
+  {
+    if (index < 0 || index >= static_cast<int>(cellSpecs_.size())) {
+      return RC::NOTFOUND;
+    }
+
+    spec = cellSpecs_[index];
+    return RC::SUCCESS;
+  }
+
 private:
   std::vector<Value> cells_;
   std::vector<TupleCellSpec> cellSpecs_;
@@ -456,7 +526,7 @@ public:
   RC cell_at(int index, Value &value) const override
   {
     const int left_cell_num = left_->cell_num();
-    if (index > 0 && index < left_cell_num) {
+    if (index >= 0 && index < left_cell_num) {
       return left_->cell_at(index, value);
     }
 
@@ -477,7 +547,114 @@ public:
     return right_->find_cell(spec, value);
   }
 
+  RC spec_at(int index, TupleCellSpec &spec) const override
+  {
+    const int left_cell_num = left_->cell_num();
+    if (index >= 0 && index < left_cell_num) {
+      return left_->spec_at(index, spec);
+    }
+
+    if (index >= left_cell_num && index < left_cell_num + right_->cell_num()) {
+      return right_->spec_at(index - left_cell_num, spec);
+    }
+
+    return RC::NOTFOUND;
+  }
+
 private:
   Tuple *left_ = nullptr;
   Tuple *right_ = nullptr;
 };
+
+/**
+ * @brief Chunk 中的一行
+ * @ingroup Tuple
+ * @details 批量执行的算子把数据交给按行执行的算子时使用，直接访问 Chunk 中的列，不复制数据。
+ * Chunk 取下一批数据之后这一行就无效了，所以复制元组时把这一行的值复制出来，列的描述在复制出来的元组之间共享
+ */
+class ChunkTuple : public Tuple
+{
+public:
+  ChunkTuple() = default;
+  virtual ~ChunkTuple() = default;
+
+  ChunkTuple(const ChunkTuple &other)
+      : speces_(other.chunk_ != nullptr ? other.chunk_->speces() : other.speces_)
+  {
+    const int cell_num = other.cell_num();
+    values_.resize(cell_num);
+    for (int i = 0; i < cell_num; i++) {
+      other.cell_at(i, values_[i]);
+    }
+  }
+
+  ChunkTuple &operator=(const ChunkTuple &other) = delete;
+
+  Tuple *clone() const override { return new ChunkTuple(*this); }
+
+  void set_row(const Chunk *chunk, int row)
+  {
+    chunk_ = chunk;
+    row_   = row;
+  }
+
+  /**
+   * @brief 不引用 Chunk，直接使用给定的值，与复制出来的元组一样
+   */
+  void set_values(std::shared_ptr<const std::vector<TupleCellSpec>> speces, std::vector<Value> values)
+  {
+    chunk_  = nullptr;
+    speces_ = std::move(speces);
+    values_ = std::move(values);
+  }
+
+  int cell_num() const override
+  {
+    if (chunk_ != nullptr) {
+      return chunk_->column_num();
+    }
+    return speces_ ? static_cast<int>(speces_->size()) : 0;
+  }
+
+  RC cell_at(int index, Value &cell) const override
+  {
+    if (index < 0 || index >= cell_num()) {
+      LOG_WARN("invalid argument. index=%d", index);
+      return RC::INVALID_ARGUMENT;
+    }
+
+    cell = chunk_ != nullptr ? chunk_->column(index).get_value(row_) : values_[index];
+    return RC::SUCCESS;
+  }
+
+  RC find_cell(const TupleCellSpec &spec, Value &cell) const override
+  {
+    int index = -1;
+    if (chunk_ != nullptr) {
+      index = chunk_->column_index(spec);
+    } else if (speces_) {
+      index = Chunk::find_spec(*speces_, spec);
+    }
+    if (index < 0) {
+      return RC::NOTFOUND;
+    }
+    return cell_at(index, cell);
+  }
+
+  RC spec_at(int index, TupleCellSpec &spec) const override
+  {
+    if (index < 0 || index >= cell_num()) {
+      LOG_WARN("invalid argument. index=%d", index);
+      return RC::INVALID_ARGUMENT;
+    }
+
+    spec = chunk_ != nullptr ? chunk_->spec(index) : (*speces_)[index];
+    return RC::SUCCESS;
+  }
+
+private:
+  const Chunk *chunk_ = nullptr;  ///< 复制出来的元组为空，值在 values_ 中
+  int          row_   = 0;
+  std::vector<Value> values_;
+  std::shared_ptr<const std::vector<TupleCellSpec>> speces_;
+};
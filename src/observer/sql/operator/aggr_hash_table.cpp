@@ -0,0 +1,202 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+
+#include "sql/operator/aggr_hash_table.h"
+
+using namespace std;
+
+char *AggrHashTable::Arena::allocate(size_t size)
+{
+  if (size > BLOCK_SIZE) {
+    // 特别长的键单独分配一块，插到前面，当前块还可以继续使用
+    blocks_.insert(blocks_.begin(), make_unique<char[]>(size));
+    return blocks_.front().get();
+  }
+
+  if (block_used_ + size > BLOCK_SIZE) {
+    blocks_.push_back(make_unique<char[]>(BLOCK_SIZE));
+    block_used_ = 0;
+  }
+  char *result = blocks_.back().get() + block_used_;
+  block_used_ += size;
+  return result;
+}
+
+void AggrHashTable::Arena::clear()
+{
+  blocks_.clear();
+  block_used_ = BLOCK_SIZE;
+}
+
+AggrHashTable::AggrHashTable(int state_num) : state_num_(state_num) {}
+
+void AggrHashTable::clear()
+{
+  arena_.clear();
+  slots_.clear();
+  mask_ = 0;
+  groups_.clear();
+  states_.clear();
+}
+
+void AggrHashTable::encode(const vector<Value> &keys, string &buffer)
+{
+  buffer.clear();
+  for (const Value &key : keys) {
+    buffer.push_back(static_cast<char>(key.attr_type()));
+    switch (key.attr_type()) {
+      case INTS:
+      case DATES: {
+        buffer.append(key.data(), 4);
+      } break;
+      case FLOATS: {
+        // 0 和 -0 比较时相等，要放到同一个分组
+        float value = key.get_float();
+        if (value == 0) {
+          value = 0;
+        }
+        buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+      } break;
+      case BOOLEANS: {
+        buffer.push_back(key.get_boolean() ? 1 : 0);
+      } break;
+      case CHARS: {
+        const uint32_t len = static_cast<uint32_t>(key.length());
+        buffer.append(reinterpret_cast<const char *>(&len), sizeof(len));
+        buffer.append(key.data(), len);
+      } break;
+      default: {
+        // NULL 只有类型
+      } break;
+    }
+  }
+}
+
+uint64_t AggrHashTable::hash(const char *data, size_t len)
+{
+  static constexpr uint64_t MULTIPLIER = 0x9e3779b97f4a7c15ULL;
+
+  uint64_t result = len * MULTIPLIER;
+  size_t   pos    = 0;
+  for (; pos + sizeof(uint64_t) <= len; pos += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data + pos, sizeof(word));
+    result = (result ^ word) * MULTIPLIER;
+    result ^= result >> 29;
+  }
+  if (pos < len) {
+    uint64_t word = 0;
+    memcpy(&word, data + pos, len - pos);
+    result = (result ^ word) * MULTIPLIER;
+  }
+
+  result ^= result >> 33;
+  result *= 0xff51afd7ed558ccdULL;
+  result ^= result >> 33;
+  return result;
+}
+
+void AggrHashTable::grow()
+{
+  const uint64_t capacity = slots_.empty() ? 16 : slots_.size() * 2;
+  vector<Slot>   slots(capacity);
+  mask_ = capacity - 1;
+  for (const Slot &slot : slots_) {
+    if (slot.group < 0) {
+      continue;
+    }
+    uint64_t pos = slot.hash & mask_;
+    while (slots[pos].group >= 0) {
+      pos = (pos + 1) & mask_;
+    }
+    slots[pos] = slot;
+  }
+  slots_.swap(slots);
+}
+
+int AggrHashTable::find_or_insert(const vector<Value> &keys, bool &created)
+{
+  encode(keys, key_buffer_);
+  const uint64_t key_hash = hash(key_buffer_.data(), key_buffer_.size());
+
+  if (groups_.size() * 2 >= slots_.size()) {
+    grow();
+  }
+
+  uint64_t pos = key_hash & mask_;
+  while (slots_[pos].group >= 0) {
+    const Slot &slot = slots_[pos];
+    if (slot.hash == key_hash) {
+      const Group &group = groups_[slot.group];
+      if (group.key_len == key_buffer_.size() && 0 == memcmp(group.key, key_buffer_.data(), group.key_len)) {
+        created = false;
+        return slot.group;
+      }
+    }
+    pos = (pos + 1) & mask_;
+  }
+
+  Group group;
+  group.key_len = static_cast<uint32_t>(key_buffer_.size());
+  char *key     = arena_.allocate(group.key_len);
+  memcpy(key, key_buffer_.data(), group.key_len);
+  group.key = key;
+
+  const int32_t group_id = static_cast<int32_t>(groups_.size());
+  groups_.push_back(group);
+  states_.resize(states_.size() + state_num_);
+  slots_[pos].hash  = key_hash;
+  slots_[pos].group = group_id;
+
+  created = true;
+  return group_id;
+}
+
+void AggrHashTable::keys(int group_id, vector<Value> &keys) const
+{
+  const Group &group = groups_[group_id];
+  const char  *data  = group.key;
+  const char  *end   = group.key + group.key_len;
+
+  keys.clear();
+  while (data < end) {
+    const AttrType type = static_cast<AttrType>(*data++);
+    Value          value;
+    switch (type) {
+      case INTS:
+      case DATES:
+      case FLOATS: {
+        value.set_type(type);
+        value.set_data(data, 4);
+        data += 4;
+      } break;
+      case BOOLEANS: {
+        value.set_boolean(*data != 0);
+        data += 1;
+      } break;
+      case CHARS: {
+        uint32_t len = 0;
+        memcpy(&len, data, sizeof(len));
+        data += sizeof(len);
+        // 长度是0时 set_string 会按照 C 字符串处理
+        value.set_string(len == 0 ? "" : data, len);
+        data += len;
+      } break;
+      case NULLS: {
+        value = Value(NULLS);
+      } break;
+      default: {
+      } break;
+    }
+    keys.emplace_back(std::move(value));
+  }
+}
@@ -0,0 +1,98 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "sql/expr/expression.h"
+#include "sql/parser/value.h"
+
+/**
+ * @brief 分组聚合的哈希表
+ * @ingroup PhysicalOperator
+ * @details 分组键按照类型编码成一段字节，放在按块分配的内存中，比较分组键只需要比较字节。
+ * 开放寻址、线性探测，槽位中只放哈希值和分组编号，槽位个数保持在分组数的2倍以上。
+ * 每个分组的聚合状态连续存放，读取一行只需要查找一次哈希表，然后原地更新聚合状态。
+ *
+ * 与 GROUP BY 的语义一致，分组键是 NULL 的行都属于同一个分组。
+ */
+class AggrHashTable
+{
+public:
+  /**
+   * @param state_num 每个分组的聚合状态个数，就是聚合函数的个数
+   */
+  explicit AggrHashTable(int state_num = 0);
+
+  /**
+   * @brief 找到分组键相同的分组，没有时新建一个
+   * @param created 是否新建了分组，新分组的聚合状态是初始值
+   * @return 分组的编号，从0开始按照出现的顺序编号
+   */
+  int find_or_insert(const std::vector<Value> &keys, bool &created);
+
+  AggrState *states(int group) { return &states_[static_cast<size_t>(group) * state_num_]; }
+
+  /**
+   * @brief 取出分组键的值
+   */
+  void keys(int group, std::vector<Value> &keys) const;
+
+  int size() const { return static_cast<int>(groups_.size()); }
+
+  void clear();
+
+private:
+  /**
+   * @brief 按块分配内存，只能整体释放
+   */
+  class Arena
+  {
+  public:
+    char *allocate(size_t size);
+    void  clear();
+
+  private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    size_t                               block_used_ = BLOCK_SIZE;
+  };
+
+  struct Slot
+  {
+    uint64_t hash  = 0;
+    int32_t  group = -1;  ///< -1 表示空的槽位
+  };
+
+  struct Group
+  {
+    const char *key     = nullptr;
+    uint32_t    key_len = 0;
+  };
+
+  static void     encode(const std::vector<Value> &keys, std::string &buffer);
+  static uint64_t hash(const char *data, size_t len);
+
+  void grow();
+
+private:
+  int                    state_num_ = 0;
+  Arena                  arena_;
+  std::vector<Slot>      slots_;
+  uint64_t               mask_ = 0;
+  std::vector<Group>     groups_;
+  std::vector<AggrState> states_;  ///< 每个分组 state_num_ 个
+  std::string            key_buffer_;
+};
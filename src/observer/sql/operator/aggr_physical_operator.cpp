@@ -2,17 +2,33 @@
 // Created by NieYang on 2023/10/20.
 //
 
+#include <inttypes.h>
+
 #include "sql/operator/aggr_physical_operator.h"
 #include "storage/table/table.h"
 #include "event/sql_debug.h"
 #include "sql/stmt/group_stmt.h"
+#include "common/worker_pool.h"
 
-std::vector<std::vector<Tuple *>> group_by_field(std::vector<Tuple *> tuples,const TupleCellSpec &tuple_schema);
+AggrPhysicalOperator::AggrPhysicalOperator(
+    std::vector<Expression*> expressions,std::vector<Field> query_fields,std::vector<GroupUnit*> groups)
+    :expressions_(expressions),groups_(groups),query_fields_(query_fields)
+{
+    for (auto &group : groups_) {
+        group_exprs_.emplace_back(new FieldExpr(group->field()));
+    }
+    for (Field &field : query_fields_) {
+        speces_.push_back(FieldExpr(field).cell_spec());
+    }
+    for (size_t i = 0; i < expressions_.size(); i++) {
+        speces_.push_back(aggr_expr(i)->cell_spec());
+    }
+}
 
 RC AggrPhysicalOperator::open(Trx *trx) 
 { 
-    if (children_.size() != 1) {
-        LOG_WARN("aggregation operator must has one child");
+    if (children_.empty()) {
+        LOG_WARN("aggregation operator must has at least one child");
         return RC::INTERNAL;
     }
     RC rc = RC::SUCCESS;
@@ -22,125 +38,183 @@ RC AggrPhysicalOperator::open(Trx *trx)
         }
     }
 
-    rc = fetch_and_split();
-
+    // 按行还是批量执行由上层算子决定，所以等到第一次获取数据时再聚合
+    aggred_tuples_.clear();
+    partials_.clear();
+    index_ = -1;
+    fetched_ = false;
     return rc;
 }
 
-RC AggrPhysicalOperator::fetch_and_split() {
-    RC rc = RC::SUCCESS;
-    PhysicalOperator *child_oper = children_.front().get();
-    std::vector<Tuple *> tuples;// 所有元组
-    // 循环从子算子获取所有元组
-    while (RC::SUCCESS == (rc = child_oper->next())) {
-        Tuple* tuple = child_oper->current_tuple()->clone();
-        tuples.push_back(tuple);
+RC AggrPhysicalOperator::fetch(bool chunk)
+{
+    // 先把每个流水线的中间结果都建好，执行时不会再移动
+    partials_.clear();
+    partials_.reserve(children_.size());
+    for (size_t i = 0; i < children_.size(); i++) {
+        partials_.emplace_back(static_cast<int>(expressions_.size()));
     }
 
-    std::vector<std::vector<Tuple *>> tuples_list;
+    RC rc = WorkerPool::instance().run(static_cast<int>(children_.size()), [this, chunk](int i) {
+        PhysicalOperator &child = *children_[i];
+        AggrPartial &partial = partials_[i];
+        if (!groups_.empty()) {
+            return aggregate_groups(child, partial);
+        }
+        return chunk ? aggregate_chunks(child, partial) : aggregate(child, partial);
+    });
+    if (rc != RC::SUCCESS) {
+        return rc;
+    }
 
-    tuples_list.push_back(tuples);
+    for (size_t i = 1; i < partials_.size(); i++) {
+        rc = merge(partials_[0], partials_[i]);
+        if (rc != RC::SUCCESS) {
+            return rc;
+        }
+    }
+    return RC::SUCCESS;
+}
 
-    // 分组
-    for (auto &group: groups_) {
-        auto table_name = group->field().table()->name();
-        auto field_name = group->field().field_name();
-        auto tuple_schema = TupleCellSpec(table_name, field_name);
+RC AggrPhysicalOperator::aggregate(PhysicalOperator &child, AggrPartial &partial)
+{
+    partial.states.assign(expressions_.size(), AggrState());
+    partial.first_values.assign(query_fields_.size(), Value());
 
-        std::vector<std::vector<Tuple *>> tmp;
+    // 非聚合的字段取第一行的值
+    RC rc = RC::SUCCESS;
+    while (RC::SUCCESS == (rc = child.next())) {
+        Tuple *tuple = child.current_tuple();
+        if (partial.row_num++ == 0) {
+            for (size_t i = 0; i < query_fields_.size(); i++) {
+                FieldExpr(query_fields_[i]).get_value(*tuple, partial.first_values[i]);
+            }
+        }
 
-        for(auto tuples:tuples_list){
-            auto splited_tuples=group_by_field(tuples,tuple_schema);
-            for(auto t : splited_tuples){
-                tmp.push_back(t);
+        for (size_t i = 0; i < expressions_.size(); i++) {
+            rc = aggr_expr(i)->aggr_tuple(partial.states[i], *tuple);
+            if (rc != RC::SUCCESS) {
+                return rc;
             }
         }
-        tuples_list.swap(tmp);
     }
+    return rc == RC::RECORD_EOF ? RC::SUCCESS : rc;
+}
 
-    for(auto tuples:tuples_list){
-        if(tuples.empty())
-            continue;
-        ValueListTuple aggred_tuple;
-        aggr_tuples(tuples,aggred_tuple);
-        aggred_tuples_.push_back(aggred_tuple);
-    }
+RC AggrPhysicalOperator::aggregate_chunks(PhysicalOperator &child, AggrPartial &partial)
+{
+    partial.states.assign(expressions_.size(), AggrState());
+    partial.first_values.assign(query_fields_.size(), Value());
 
-    index_ = -1;
-    return RC::SUCCESS;
-}
+    // 非聚合的字段取第一行的值，与按行执行一致
+    RC rc = RC::SUCCESS;
+    Chunk chunk;
+    while (RC::SUCCESS == (rc = child.next(chunk))) {
+        if (partial.row_num == 0 && chunk.rows() > 0) {
+            ChunkTuple tuple;
+            tuple.set_row(&chunk, 0);
+            for (size_t i = 0; i < query_fields_.size(); i++) {
+                FieldExpr(query_fields_[i]).get_value(tuple, partial.first_values[i]);
+            }
+        }
 
-std::vector<std::vector<Tuple *>> group_by_field(std::vector<Tuple *> tuples,const TupleCellSpec &tuple_schema){
-    /// 排序
-    std::sort(tuples.begin(), tuples.end(), [&](Tuple *left, Tuple *right) {
-        Value left_value;
-        left->find_cell(tuple_schema, left_value);
-        Value right_value;
-        right->find_cell(tuple_schema, right_value);
-        int res = left_value.compare(right_value);
-        return res < 0;
-    });
-    /// 分割
-    Value last_value(NULLS);
-    Value cur_value(NULLS);
-    std::vector<Tuple*> cur_tuples;
-    std::vector<std::vector<Tuple *>> tuples_list;
-    for(auto tuple : tuples){
-        tuple->find_cell(tuple_schema,cur_value);
-        if(last_value.attr_type()==NULLS || last_value.compare(cur_value)==0){
-        cur_tuples.push_back(tuple);
-        last_value = cur_value;
-        }else if(last_value.compare(cur_value)!=0){
-        std::vector<Tuple*> tmp;
-        tmp.swap(cur_tuples);
-        tuples_list.push_back(tmp);
-        cur_tuples.push_back(tuple);
-        last_value = cur_value;
-        }
-    }
-    if(cur_tuples.size()>0){
-        tuples_list.push_back(cur_tuples);
-    }
-    return tuples_list;
+        partial.row_num += chunk.rows();
+        for (size_t i = 0; i < expressions_.size(); i++) {
+            rc = aggr_expr(i)->aggr_chunk(partial.states[i], chunk);
+            if (rc != RC::SUCCESS) {
+                return rc;
+            }
+        }
+    }
+    return rc == RC::RECORD_EOF ? RC::SUCCESS : rc;
 }
 
-RC AggrPhysicalOperator::aggr_tuples(std::vector<Tuple *> tuples , ValueListTuple &result){
-    Tuple *tuple = nullptr;
+RC AggrPhysicalOperator::aggregate_groups(PhysicalOperator &child, AggrPartial &partial)
+{
+    // 每个分组中第一行的非聚合字段的值，按照分组编号存放
+    RC rc = RC::SUCCESS;
+    std::vector<Value> &first_values = partial.first_values;
+    std::vector<Value> keys(group_exprs_.size());
+    while (RC::SUCCESS == (rc = child.next())) {
+        Tuple *tuple = child.current_tuple();
+        partial.row_num++;
+        for (size_t i = 0; i < group_exprs_.size(); i++) {
+            group_exprs_[i]->get_value(*tuple, keys[i]);
+        }
 
-    // 遍历所有聚合函数表达式，开始聚合
-    for (Expression* expr: expressions_) {
-        AggregationExpr *aggr_expr = static_cast<AggregationExpr *>(expr);
-        aggr_expr->begin_aggr();
-    }
+        bool created = false;
+        const int group = partial.hash_table.find_or_insert(keys, created);
+        if (created) {
+            first_values.resize(first_values.size() + query_fields_.size());
+            Value *values = &first_values[static_cast<size_t>(group) * query_fields_.size()];
+            for (size_t i = 0; i < query_fields_.size(); i++) {
+                FieldExpr(query_fields_[i]).get_value(*tuple, values[i]);
+            }
+        }
 
-    // 遍历所有元组
-    for(auto tuple:tuples){
-        // 遍历所有聚合函数表达式，聚合当前元组
-        for (Expression* expr: expressions_) {
-            AggregationExpr *aggr_expr = static_cast<AggregationExpr *>(expr);
-            aggr_expr->aggr_tuple(tuple);
+        AggrState *states = partial.hash_table.states(group);
+        for (size_t i = 0; i < expressions_.size(); i++) {
+            rc = aggr_expr(i)->aggr_tuple(states[i], *tuple);
+            if (rc != RC::SUCCESS) {
+                return rc;
+            }
         }
     }
+    return rc == RC::RECORD_EOF ? RC::SUCCESS : rc;
+}
+
+RC AggrPhysicalOperator::merge(AggrPartial &partial, AggrPartial &other)
+{
+    if (other.row_num == 0) {
+        return RC::SUCCESS;
+    }
 
-    // 获取结果
-    std::vector<Value> results;
-    std::vector<TupleCellSpec> speces;
-    for (Field field: query_fields_) {
-        Value value;
-        FieldExpr *field_expr = new FieldExpr(field);
-        field_expr->get_value(*tuples[0], value);
-        results.push_back(value);
-        speces.push_back(field_expr->cell_spec());
+    RC rc = RC::SUCCESS;
+    if (groups_.empty()) {
+        if (partial.row_num == 0) {
+            partial.first_values = other.first_values;
+        }
+        for (size_t i = 0; i < expressions_.size() && rc == RC::SUCCESS; i++) {
+            rc = aggr_expr(i)->merge_state(partial.states[i], other.states[i]);
+        }
+    } else {
+        // 第一次出现的分组连同非聚合字段的值一起加进来
+        std::vector<Value> keys;
+        for (int group = 0; group < other.hash_table.size() && rc == RC::SUCCESS; group++) {
+            other.hash_table.keys(group, keys);
+            bool created = false;
+            const int target = partial.hash_table.find_or_insert(keys, created);
+            if (created) {
+                const auto values = other.first_values.begin() + static_cast<size_t>(group) * query_fields_.size();
+                partial.first_values.insert(partial.first_values.end(), values, values + query_fields_.size());
+            }
+
+            AggrState *states = partial.hash_table.states(target);
+            const AggrState *other_states = other.hash_table.states(group);
+            for (size_t i = 0; i < expressions_.size() && rc == RC::SUCCESS; i++) {
+                rc = aggr_expr(i)->merge_state(states[i], other_states[i]);
+            }
+        }
     }
-    for (Expression* expr: expressions_) {
+    partial.row_num += other.row_num;
+    return rc;
+}
+
+RC AggrPhysicalOperator::add_result(const Value *first_values, const AggrState *states)
+{
+    std::vector<Value> results(first_values, first_values + query_fields_.size());
+    for (size_t i = 0; i < expressions_.size(); i++) {
         Value value;
-        AggregationExpr *aggr_expr = static_cast<AggregationExpr *>(expr);
-        aggr_expr->get_result(value);
+        RC rc = aggr_expr(i)->get_result(states[i], value);
+        if (rc != RC::SUCCESS) {
+            return rc;
+        }
         results.push_back(value);
-        speces.push_back(aggr_expr->cell_spec());
     }
-    result.set_cells(results);
-    result.set_speces(speces);
+
+    aggred_tuples_.emplace_back();
+    aggred_tuples_.back().set_cells(results);
+    aggred_tuples_.back().set_speces(speces_);
     return RC::SUCCESS;
 }
 
@@ -148,15 +222,93 @@ RC AggrPhysicalOperator::next()
 { 
     RC rc = RC::SUCCESS;
 
-    if (index_ == aggred_tuples_.size() -1) {
+    if (!fetched_) {
+        fetched_ = true;
+        rc = fetch(false /*chunk*/);
+        if (rc != RC::SUCCESS) {
+            return rc;
+        }
+
+        AggrPartial &result = partials_.front();
+        if (groups_.empty()) {
+            // 没有数据时不输出结果
+            if (result.row_num > 0) {
+                rc = add_result(result.first_values.data(), result.states.data());
+            }
+        } else {
+            aggred_tuples_.reserve(result.hash_table.size());
+            for (int group = 0; group < result.hash_table.size() && rc == RC::SUCCESS; group++) {
+                rc = add_result(&result.first_values[static_cast<size_t>(group) * query_fields_.size()],
+                                result.hash_table.states(group));
+            }
+        }
+        if (rc != RC::SUCCESS) {
+            return rc;
+        }
+    }
+
+    if (index_ + 1 >= static_cast<int>(aggred_tuples_.size())) {
         return RC::RECORD_EOF;
     }
     index_++;
     return RC::SUCCESS;
 }
 
+RC AggrPhysicalOperator::next(Chunk &chunk)
+{
+    if (fetched_) {
+        return RC::RECORD_EOF;
+    }
+    fetched_ = true;
+
+    if (!support_chunk()) {
+        LOG_WARN("aggregation with group by can not run in batch mode");
+        return RC::UNIMPLENMENT;
+    }
+
+    RC rc = fetch(true /*chunk*/);
+    if (rc != RC::SUCCESS) {
+        return rc;
+    }
+    AggrPartial &result = partials_.front();
+    if (result.row_num == 0) {
+        return RC::RECORD_EOF;
+    }
+
+    chunk.reset();
+    for (size_t i = 0; i < query_fields_.size(); i++) {
+        const Value &value = result.first_values[i];
+        auto column = std::make_shared<Column>(value.attr_type(), 1);
+        column->append_value(value);
+        chunk.add_column(column, FieldExpr(query_fields_[i]).cell_spec());
+    }
+    for (size_t i = 0; i < expressions_.size(); i++) {
+        Value value;
+        rc = aggr_expr(i)->get_result(result.states[i], value);
+        if (rc != RC::SUCCESS) {
+            return rc;
+        }
+        auto column = std::make_shared<Column>(value.attr_type(), 1);
+        column->append_value(value);
+        chunk.add_column(column, aggr_expr(i)->cell_spec());
+    }
+    chunk.set_rows(1);
+    return RC::SUCCESS;
+}
+
 RC AggrPhysicalOperator::close() 
 { 
+    if (fetched_ && !partials_.empty()) {
+        if (!groups_.empty()) {
+            sql_debug("hash aggregation: %" PRId64 " rows, %d groups",
+                      partials_.front().row_num, partials_.front().hash_table.size());
+        }
+        if (children_.size() > 1) {
+            sql_debug("parallel aggregation: merged %d partial results", static_cast<int>(partials_.size()));
+        }
+    }
+    partials_.clear();
+
     RC rc = RC::SUCCESS;
     for (int i = 0; i < children_.size(); i++) {
         if (children_[i]->close() != RC::SUCCESS) {
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "sql/operator/physical_operator.h"
+#include "sql/operator/aggr_hash_table.h"
 #include "storage/record/record_manager.h"
 #include "common/rc.h"
 #include <memory>
@@ -16,13 +17,16 @@ class GroupUnit;
 /**
  * @brief 聚合物理算子
  * @ingroup LogicalOperator
+ * @details 没有分组时边读取边聚合，不保存读取的元组。有分组时只读取一遍数据，
+ * 每一行在哈希表中找到所在的分组，更新这个分组的聚合状态。分组按照出现的顺序输出
+ *
+ * 并行执行时有多个子算子，每个子算子是一个流水线，比如 过滤 <- 并行扫描，它们合起来是全部数据。
+ * 每个流水线在一个线程中聚合到自己的中间结果，最后把各个中间结果合并起来，这时分组的顺序是不确定的
  */
 class AggrPhysicalOperator : public PhysicalOperator
 {
 public:
-    AggrPhysicalOperator(std::vector<Expression*> expressions,std::vector<Field> query_fields,std::vector<GroupUnit*> groups)
-        :expressions_(expressions),query_fields_(query_fields),groups_(groups)
-    {}
+    AggrPhysicalOperator(std::vector<Expression*> expressions,std::vector<Field> query_fields,std::vector<GroupUnit*> groups);
 
     virtual ~AggrPhysicalOperator()
     {
@@ -41,13 +45,75 @@ public:
     RC next() override;
     RC close() override;
 
-    RC fetch_and_split();
-    RC aggr_tuples(std::vector<Tuple *> tuples,ValueListTuple & result);
+    /**
+     * @brief 批量聚合，按列累加子算子返回的每一批数据，只支持没有分组的聚合
+     * @details 与按行执行一样，没有数据时不输出结果
+     */
+    RC next(Chunk &chunk) override;
+
+    /**
+     * @brief 没有分组并且子算子可以批量执行时才批量聚合
+     */
+    bool support_chunk() const override { return groups_.empty() && children_[0]->support_chunk(); }
+
     Tuple *current_tuple() override;
+
+private:
+    /**
+     * @brief 一个流水线的聚合结果，只有一个子算子时也是一样
+     */
+    struct AggrPartial
+    {
+        explicit AggrPartial(int state_num) : hash_table(state_num) {}
+
+        int64_t row_num = 0;
+        std::vector<AggrState> states;    // 没有分组时的聚合状态
+        AggrHashTable hash_table;         // 有分组时每个分组的聚合状态
+        std::vector<Value> first_values;  // 非聚合字段取第一行的值，有分组时按照分组编号存放
+    };
+
+    AggregationExpr *aggr_expr(size_t i) const { return static_cast<AggregationExpr *>(expressions_[i]); }
+
+    /**
+     * @brief 读取所有子算子的数据并聚合，多个子算子时并行执行，合并后的结果在 partials_ 的第一个中
+     * @param chunk 是否批量读取子算子的数据
+     */
+    RC fetch(bool chunk);
+
+    /**
+     * @brief 没有分组时的聚合，每读取一行直接累加到聚合状态中
+     */
+    RC aggregate(PhysicalOperator &child, AggrPartial &partial);
+
+    /**
+     * @brief 没有分组时批量聚合，按列累加
+     */
+    RC aggregate_chunks(PhysicalOperator &child, AggrPartial &partial);
+
+    /**
+     * @brief 分组聚合
+     */
+    RC aggregate_groups(PhysicalOperator &child, AggrPartial &partial);
+
+    /**
+     * @brief 把另一个流水线的聚合结果合并到 partial 中
+     */
+    RC merge(AggrPartial &partial, AggrPartial &other);
+
+    /**
+     * @brief 生成一个分组的结果
+     * @param first_values 分组中第一行的非聚合字段的值
+     */
+    RC add_result(const Value *first_values, const AggrState *states);
+
 private:
     std::vector<Expression*> expressions_;//一系列聚合操作一起进行
     std::vector<GroupUnit*> groups_;
     std::vector<Field> query_fields_;
+    std::vector<std::unique_ptr<FieldExpr>> group_exprs_;
+    std::vector<TupleCellSpec> speces_; // 输出的字段，先是非聚合的字段，然后是聚合函数
+    std::vector<AggrPartial> partials_; // 每个子算子一个
     std::vector<ValueListTuple> aggred_tuples_;
     int index_ = 0;
+    bool fetched_ = false; // 第一次获取数据时才从子算子读取数据并聚合
 };
\ No newline at end of file
@@ -0,0 +1,49 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/chunk_to_row_physical_operator.h"
+#include "common/log/log.h"
+
+RC ChunkToRowPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 1) {
+    LOG_WARN("chunk to row operator must has one child");
+    return RC::INTERNAL;
+  }
+
+  chunk_.reset_data();
+  row_ = -1;
+  return children_[0]->open(trx);
+}
+
+RC ChunkToRowPhysicalOperator::next()
+{
+  row_++;
+  while (row_ >= chunk_.rows()) {
+    RC rc = children_[0]->next(chunk_);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    row_ = 0;
+  }
+
+  tuple_.set_row(&chunk_, row_);
+  return RC::SUCCESS;
+}
+
+RC ChunkToRowPhysicalOperator::close()
+{
+  return children_[0]->close();
+}
+
+Tuple *ChunkToRowPhysicalOperator::current_tuple()
+{
+  return &tuple_;
+}
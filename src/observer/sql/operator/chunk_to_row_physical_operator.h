@@ -0,0 +1,41 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief 把批量执行的子算子转换成按行执行
+ * @ingroup PhysicalOperator
+ * @details 从子算子批量获取数据，再一行一行地交给上层按行执行的算子。返回的元组直接访问 chunk 中的数据
+ */
+class ChunkToRowPhysicalOperator : public PhysicalOperator
+{
+public:
+  ChunkToRowPhysicalOperator() = default;
+  virtual ~ChunkToRowPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override
+  {
+    return PhysicalOperatorType::CHUNK_TO_ROW;
+  }
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+
+  Tuple *current_tuple() override;
+
+private:
+  Chunk      chunk_;
+  int        row_ = -1;  ///< 当前的行在 chunk_ 中的下标
+  ChunkTuple tuple_;
+};
@@ -61,6 +61,11 @@ RC DeletePhysicalOperator::next()
     }
   }
 
+  // 读取要删除的数据时也可能失败，比如等待行锁时被选为死锁的牺牲者，不能当作已经删除完
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to get record to delete: %s", strrc(rc));
+    return rc;
+  }
   return RC::RECORD_EOF;
 }
 
@@ -0,0 +1,251 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/gather_physical_operator.h"
+#include "common/log/log.h"
+#include "common/worker_pool.h"
+
+using namespace std;
+
+GatherPhysicalOperator::~GatherPhysicalOperator()
+{
+  // 没有调用 close 时也要等流水线都结束，它们还在访问子算子
+  stop();
+}
+
+string GatherPhysicalOperator::param() const
+{
+  string result = "DOP=" + to_string(children_.size());
+  if (limit_ >= 0) {
+    result += ", LIMIT=" + to_string(limit_);
+  }
+  return result;
+}
+
+RC GatherPhysicalOperator::open(Trx *trx)
+{
+  if (children_.empty()) {
+    LOG_WARN("gather operator must has at least one child");
+    return RC::INTERNAL;
+  }
+
+  for (unique_ptr<PhysicalOperator> &child : children_) {
+    RC rc = child->open(trx);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to open pipeline. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+
+  batches_.clear();
+  running_    = 0;
+  started_    = false;
+  stop_       = false;
+  rc_         = RC::SUCCESS;
+  output_num_ = 0;
+  batch_ = Batch();
+  row_   = -1;
+  return RC::SUCCESS;
+}
+
+void GatherPhysicalOperator::start()
+{
+  started_ = true;
+  running_ = static_cast<int>(children_.size());
+  for (int i = 0; i < static_cast<int>(children_.size()); i++) {
+    WorkerPool::instance().submit([this, i]() { run_pipeline(i); });
+  }
+}
+
+void GatherPhysicalOperator::stop()
+{
+  unique_lock<mutex> guard(lock_);
+  stop_ = true;
+  cond_.notify_all();
+  cond_.wait(guard, [this]() { return running_ == 0; });
+  batches_.clear();
+}
+
+void GatherPhysicalOperator::run_pipeline(int index)
+{
+  PhysicalOperator *child = children_[index].get();
+  const bool        chunk = child->support_chunk();
+
+  RC    rc = RC::SUCCESS;
+  Chunk child_chunk;
+  while (true) {
+    {
+      lock_guard<mutex> guard(lock_);
+      if (stop_) {
+        break;
+      }
+    }
+
+    Batch batch;
+    if (chunk) {
+      rc = child->next(child_chunk);
+      if (rc != RC::SUCCESS) {
+        break;
+      }
+
+      // 流水线中的算子会复用自己的列，交给上层的数据要复制出来
+      for (int i = 0; i < child_chunk.column_num(); i++) {
+        batch.chunk.add_column(make_shared<Column>(child_chunk.column(i)), child_chunk.spec(i));
+      }
+      batch.chunk.set_rows(child_chunk.rows());
+    } else {
+      rc = fetch_rows(*child, batch);
+      if (rc != RC::SUCCESS && rc != RC::RECORD_EOF) {
+        break;
+      }
+    }
+
+    if (batch.size() > 0 && !push(std::move(batch))) {
+      break;
+    }
+    if (rc != RC::SUCCESS) {
+      break;
+    }
+  }
+
+  lock_guard<mutex> guard(lock_);
+  if (rc != RC::SUCCESS && rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to run pipeline %d. rc=%s", index, strrc(rc));
+    if (rc_ == RC::SUCCESS) {
+      rc_ = rc;
+    }
+  }
+  running_--;
+  cond_.notify_all();
+}
+
+RC GatherPhysicalOperator::fetch_rows(PhysicalOperator &child, Batch &batch)
+{
+  RC rc = RC::SUCCESS;
+  while (static_cast<int>(batch.rows.size()) < Chunk::DEFAULT_CAPACITY) {
+    rc = child.next();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+
+    const Tuple  *tuple    = child.current_tuple();
+    const int     cell_num = tuple->cell_num();
+    vector<Value> values(cell_num);
+    for (int i = 0; i < cell_num && rc == RC::SUCCESS; i++) {
+      rc = tuple->cell_at(i, values[i]);
+    }
+    if (batch.speces == nullptr) {
+      auto speces = make_shared<vector<TupleCellSpec>>();
+      for (int i = 0; i < cell_num && rc == RC::SUCCESS; i++) {
+        TupleCellSpec spec("");
+        rc = tuple->spec_at(i, spec);
+        speces->push_back(std::move(spec));
+      }
+      batch.speces = std::move(speces);
+    }
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to copy row of pipeline. rc=%s", strrc(rc));
+      return rc;
+    }
+    batch.rows.push_back(std::move(values));
+  }
+  return rc;
+}
+
+bool GatherPhysicalOperator::push(Batch &&batch)
+{
+  const size_t max_count = BATCHES_PER_PIPELINE * children_.size();
+
+  unique_lock<mutex> guard(lock_);
+  cond_.wait(guard, [this, max_count]() { return stop_ || batches_.size() < max_count; });
+  if (stop_) {
+    return false;
+  }
+  batches_.push_back(std::move(batch));
+  cond_.notify_all();
+  return true;
+}
+
+RC GatherPhysicalOperator::pop(Batch &batch)
+{
+  if (limit_ >= 0 && output_num_ >= limit_) {
+    return RC::RECORD_EOF;
+  }
+  if (!started_) {
+    start();
+  }
+
+  unique_lock<mutex> guard(lock_);
+  cond_.wait(guard, [this]() { return !batches_.empty() || running_ == 0 || rc_ != RC::SUCCESS; });
+  if (rc_ != RC::SUCCESS) {
+    return rc_;
+  }
+  if (batches_.empty()) {
+    return RC::RECORD_EOF;
+  }
+
+  batch = std::move(batches_.front());
+  batches_.pop_front();
+  cond_.notify_all();
+
+  if (limit_ >= 0 && batch.size() >= limit_ - output_num_) {
+    const int rows = static_cast<int>(limit_ - output_num_);
+    if (batch.rows.empty()) {
+      batch.chunk.set_rows(rows);
+    } else {
+      batch.rows.resize(rows);
+    }
+    stop_ = true;  // 已经够了，流水线不用再继续执行
+  }
+  output_num_ += batch.size();
+  return RC::SUCCESS;
+}
+
+RC GatherPhysicalOperator::next(Chunk &chunk)
+{
+  Batch batch;
+  RC    rc = pop(batch);
+  if (rc == RC::SUCCESS) {
+    chunk = std::move(batch.chunk);
+  }
+  return rc;
+}
+
+RC GatherPhysicalOperator::next()
+{
+  row_++;
+  while (row_ >= batch_.size()) {
+    RC rc = pop(batch_);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    row_ = 0;
+  }
+
+  if (batch_.rows.empty()) {
+    tuple_.set_row(&batch_.chunk, row_);
+  } else {
+    tuple_.set_values(batch_.speces, std::move(batch_.rows[row_]));
+  }
+  return RC::SUCCESS;
+}
+
+RC GatherPhysicalOperator::close()
+{
+  stop();
+
+  RC rc = RC::SUCCESS;
+  for (unique_ptr<PhysicalOperator> &child : children_) {
+    if (child->close() != RC::SUCCESS) {
+      rc = RC::INTERNAL;
+    }
+  }
+  return rc;
+}
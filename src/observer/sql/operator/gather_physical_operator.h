@@ -0,0 +1,110 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "sql/operator/physical_operator.h"
+#include "sql/expr/chunk.h"
+#include "sql/expr/tuple.h"
+
+/**
+ * @brief 汇总并行执行的多个流水线的输出
+ * @ingroup PhysicalOperator
+ * @details 每个子算子是一个流水线，比如 投影 <- 过滤 <- 并行扫描。第一次获取数据时每个流水线交给一个线程执行，
+ * 得到的每批数据复制一份放到队列中，上层从队列中取。队列满了时流水线等待上层取走数据。
+ * 流水线可以批量执行时一批数据是一个 Chunk，不能批量执行时(比如有连接)，把每行的值复制出来，凑够一批再放到队列中。
+ * 输出的顺序与各个流水线产生数据的快慢有关，是不确定的。
+ */
+class GatherPhysicalOperator : public PhysicalOperator
+{
+public:
+  GatherPhysicalOperator() = default;
+  virtual ~GatherPhysicalOperator();
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::GATHER; }
+
+  std::string param() const override;
+
+  /**
+   * @brief 最多输出 limit 行，-1 表示没有限制。输出够了就让流水线停下来
+   */
+  void set_limit(int limit) { limit_ = limit; }
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC next(Chunk &chunk) override;
+  RC close() override;
+
+  /**
+   * @brief 流水线都是批量执行的时候才能批量输出
+   */
+  bool support_chunk() const override { return !children_.empty() && children_[0]->support_chunk(); }
+
+  Tuple *current_tuple() override { return &tuple_; }
+
+private:
+  /**
+   * @brief 流水线交给上层的一批数据，批量执行时放在 chunk 中，按行执行时放在 rows 中
+   */
+  struct Batch
+  {
+    Chunk                                             chunk;
+    std::shared_ptr<const std::vector<TupleCellSpec>> speces;  ///< rows 中每个值对应的字段
+    std::vector<std::vector<Value>>                   rows;
+
+    int size() const { return rows.empty() ? chunk.rows() : static_cast<int>(rows.size()); }
+  };
+
+  void start();
+  void stop();
+
+  /**
+   * @brief 在工作线程中执行第 index 个流水线
+   */
+  void run_pipeline(int index);
+
+  /**
+   * @brief 从按行执行的流水线中读取一批数据
+   */
+  static RC fetch_rows(PhysicalOperator &child, Batch &batch);
+
+  /**
+   * @brief 放到队列中，队列满了时等待。返回 false 表示上层不再需要数据了
+   */
+  bool push(Batch &&batch);
+
+  /**
+   * @brief 取出下一批数据，最多输出 limit 行
+   */
+  RC pop(Batch &batch);
+
+private:
+  static constexpr size_t BATCHES_PER_PIPELINE = 2;  ///< 队列中最多为每个流水线缓存几批数据
+
+  std::mutex              lock_;
+  std::condition_variable cond_;
+  std::deque<Batch>       batches_;
+  int                     running_ = 0;  ///< 还在执行的流水线个数
+  bool                    started_ = false;
+  bool                    stop_    = false;  ///< 上层不再需要数据，流水线尽快结束
+  RC                      rc_      = RC::SUCCESS;  ///< 第一个执行失败的流水线的结果
+
+  int        limit_      = -1;
+  int64_t    output_num_ = 0;
+  Batch      batch_;  ///< 按行输出时当前的一批数据
+  int        row_ = -1;
+  ChunkTuple tuple_;
+};
@@ -0,0 +1,441 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <inttypes.h>
+#include <algorithm>
+
+#include "sql/operator/hash_join_physical_operator.h"
+#include "common/log/log.h"
+#include "event/sql_debug.h"
+#include "sql/expr/chunk.h"
+
+using namespace std;
+
+static void init_side(vector<unique_ptr<Expression>> &&keys, const vector<Field> &fields,
+    vector<unique_ptr<Expression>> &side_keys, shared_ptr<const vector<TupleCellSpec>> &side_speces,
+    vector<int> &key_index)
+{
+  auto speces = make_shared<vector<TupleCellSpec>>();
+  speces->reserve(fields.size());
+  for (const Field &field : fields) {
+    speces->emplace_back(field.table_name(), field.field_name(), field.field_name());
+  }
+
+  for (const unique_ptr<Expression> &key : keys) {
+    int index = -1;
+    if (key->type() == ExprType::FIELD) {
+      const FieldExpr &field_expr = static_cast<const FieldExpr &>(*key);
+      index = Chunk::find_spec(*speces, TupleCellSpec(field_expr.table_name(), field_expr.field_name()));
+    }
+    key_index.push_back(index);
+  }
+
+  side_keys   = std::move(keys);
+  side_speces = std::move(speces);
+}
+
+HashJoinPhysicalOperator::HashJoinPhysicalOperator(vector<unique_ptr<Expression>> &&left_keys,
+    vector<unique_ptr<Expression>> &&right_keys, const vector<Field> &left_fields, const vector<Field> &right_fields,
+    bool build_left, int64_t memory_limit)
+    : build_left_(build_left), memory_limit_(memory_limit)
+{
+  init_side(std::move(left_keys), left_fields, left_.keys, left_.speces, left_.key_index);
+  init_side(std::move(right_keys), right_fields, right_.keys, right_.speces, right_.key_index);
+}
+
+static string key_name(const Expression &expr)
+{
+  if (expr.type() != ExprType::FIELD) {
+    return expr.name();
+  }
+  const FieldExpr &field_expr = static_cast<const FieldExpr &>(expr);
+  return string(field_expr.table_name()) + "." + field_expr.field_name();
+}
+
+string HashJoinPhysicalOperator::param() const
+{
+  string result;
+  for (size_t i = 0; i < left_.keys.size(); i++) {
+    if (i > 0) {
+      result += " AND ";
+    }
+    result += key_name(*left_.keys[i]) + "=" + key_name(*right_.keys[i]);
+  }
+  result += build_left_ ? " BUILD=LEFT" : " BUILD=RIGHT";
+  return result;
+}
+
+RC HashJoinPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 2) {
+    LOG_WARN("hash join operator should have 2 children");
+    return RC::INTERNAL;
+  }
+
+  for (const Side *side : {&left_, &right_}) {
+    if (std::find(side->key_index.begin(), side->key_index.end(), -1) != side->key_index.end()) {
+      LOG_WARN("join key of hash join is not in the fields");
+      return RC::INTERNAL;
+    }
+  }
+
+  build_oper_ = children_[build_left_ ? 0 : 1].get();
+  probe_oper_ = children_[build_left_ ? 1 : 0].get();
+
+  build_row_num_         = 0;
+  spilled_partition_num_ = 0;
+  max_level_             = 0;
+  spill_stats_           = SpillStats();
+  level_                 = 0;
+  task_                  = SpillTask();
+  pending_tasks_.clear();
+  reset_partitions();
+
+  RC rc = build_oper_->open(trx);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to open build side of hash join. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  rc = build();
+  build_oper_->close();
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  probe_pos_   = -1;
+  probe_tuple_ = nullptr;
+  return probe_oper_->open(trx);
+}
+
+void HashJoinPhysicalOperator::reset_partitions()
+{
+  hash_table_.clear();
+  partitions_.clear();
+  partitions_.resize(PARTITION_NUM);
+  memory_used_ = 0;
+}
+
+int HashJoinPhysicalOperator::partition_of(size_t hash, int level)
+{
+  // 哈希表的槽位用的是低位，分区从最高位开始取，每层用不同的位
+  return static_cast<int>((hash >> (64 - PARTITION_BITS * (level + 1))) & (PARTITION_NUM - 1));
+}
+
+RC HashJoinPhysicalOperator::build()
+{
+  Side &side = build_side();
+
+  RC            rc = RC::SUCCESS;
+  vector<Value> keys;
+  while (true) {
+    vector<Value> values;
+    if (level_ == 0) {
+      rc = build_oper_->next();
+      if (rc != RC::SUCCESS) {
+        break;
+      }
+
+      Tuple *tuple = build_oper_->current_tuple();
+      if (!eval_keys(side.keys, *tuple, keys, rc)) {
+        if (rc != RC::SUCCESS) {
+          return rc;
+        }
+        continue;
+      }
+
+      rc = materialize(*tuple, *side.speces, values);
+    } else {
+      rc = task_.build_file->read_values(values);
+      if (rc != RC::SUCCESS) {
+        break;
+      }
+      take_keys(side, values, keys);
+    }
+
+    if (rc == RC::SUCCESS) {
+      rc = add_build_row(JoinHashTable::hash(keys), values);
+    }
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to read build side of hash join. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // 没有溢出的分区放到哈希表中
+  for (Partition &partition : partitions_) {
+    for (BuildRow &row : partition.rows) {
+      take_keys(side, row.values, keys);
+      auto tuple = make_unique<ChunkTuple>();
+      tuple->set_values(side.speces, std::move(row.values));
+      hash_table_.add(std::move(tuple), keys, row.hash);
+    }
+    partition.rows.clear();
+    partition.rows.shrink_to_fit();
+  }
+
+  hash_table_.build();
+  LOG_TRACE("hash join built. level=%d, rows=%d", level_, hash_table_.size());
+  return RC::SUCCESS;
+}
+
+RC HashJoinPhysicalOperator::add_build_row(size_t hash, vector<Value> &values)
+{
+  build_row_num_++;
+
+  Partition &partition = partitions_[partition_of(hash, level_)];
+  if (partition.build_file != nullptr) {
+    return partition.build_file->write_values(values);
+  }
+
+  // 值、槽位和哈希表中的连接键，不需要很精确
+  int64_t memory = sizeof(BuildRow) + sizeof(ChunkTuple) + 2 * sizeof(uint64_t) * 2;
+  for (const Value &value : values) {
+    memory += sizeof(Value) + (value.attr_type() == CHARS ? value.length() : 0);
+  }
+  memory += build_side().keys.size() * sizeof(Value);
+
+  partition.rows.push_back(BuildRow{hash, std::move(values)});
+  partition.memory += memory;
+  memory_used_ += memory;
+  if (memory_used_ <= memory_limit_) {
+    return RC::SUCCESS;
+  }
+
+  if (level_ >= MAX_LEVEL) {
+    if (memory_used_ - memory <= memory_limit_) {
+      LOG_WARN("hash join exceeds memory limit at max level. memory used=%" PRId64 ", limit=%" PRId64,
+               memory_used_, memory_limit_);
+    }
+    return RC::SUCCESS;
+  }
+
+  auto victim = std::max_element(partitions_.begin(), partitions_.end(),
+      [](const Partition &left, const Partition &right) { return left.memory < right.memory; });
+  return spill_partition(*victim);
+}
+
+RC HashJoinPhysicalOperator::spill_partition(Partition &partition)
+{
+  partition.build_file = make_unique<SpillFile>(&spill_stats_);
+  RC rc                = partition.build_file->open();
+  for (size_t i = 0; rc == RC::SUCCESS && i < partition.rows.size(); i++) {
+    rc = partition.build_file->write_values(partition.rows[i].values);
+  }
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to spill partition of hash join. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  LOG_TRACE("hash join spilled a partition. level=%d, rows=%d, memory=%" PRId64,
+            level_, static_cast<int>(partition.rows.size()), partition.memory);
+  spilled_partition_num_++;
+  memory_used_ -= partition.memory;
+  partition.memory = 0;
+  partition.rows.clear();
+  partition.rows.shrink_to_fit();
+  return RC::SUCCESS;
+}
+
+RC HashJoinPhysicalOperator::next()
+{
+  RC rc = RC::SUCCESS;
+  while (true) {
+    if (probe_pos_ >= 0) {
+      int row    = -1;
+      probe_pos_ = hash_table_.probe(probe_pos_, probe_hash_, probe_keys_, row);
+      if (probe_pos_ >= 0) {
+        Tuple *build_tuple = hash_table_.tuple(row);
+        joined_tuple_.set_left(build_left_ ? build_tuple : probe_tuple_);
+        joined_tuple_.set_right(build_left_ ? probe_tuple_ : build_tuple);
+        return RC::SUCCESS;
+      }
+    }
+
+    rc = next_probe_row();
+    if (rc == RC::RECORD_EOF) {
+      rc = next_task();
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      continue;
+    }
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+
+    probe_pos_ = hash_table_.start_pos(probe_hash_);
+  }
+  return rc;
+}
+
+RC HashJoinPhysicalOperator::next_probe_row()
+{
+  Side &side = probe_side();
+
+  RC rc = RC::SUCCESS;
+  while (true) {
+    Tuple *tuple = nullptr;
+    if (level_ == 0) {
+      rc = probe_oper_->next();
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+
+      tuple = probe_oper_->current_tuple();
+      if (!eval_keys(side.keys, *tuple, probe_keys_, rc)) {
+        if (rc != RC::SUCCESS) {
+          return rc;
+        }
+        continue;
+      }
+    } else {
+      rc = task_.probe_file->read_values(probe_values_);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      take_keys(side, probe_values_, probe_keys_);
+    }
+
+    probe_hash_          = JoinHashTable::hash(probe_keys_);
+    Partition &partition = partitions_[partition_of(probe_hash_, level_)];
+    if (partition.build_file == nullptr) {
+      if (tuple == nullptr) {
+        spilled_probe_tuple_.set_values(side.speces, std::move(probe_values_));
+        tuple = &spilled_probe_tuple_;
+      }
+      probe_tuple_ = tuple;
+      return RC::SUCCESS;
+    }
+
+    if (tuple != nullptr) {
+      rc = materialize(*tuple, *side.speces, probe_values_);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+    }
+    if (partition.probe_file == nullptr) {
+      partition.probe_file = make_unique<SpillFile>(&spill_stats_);
+      rc                   = partition.probe_file->open();
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+    }
+    rc = partition.probe_file->write_values(probe_values_);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to spill probe row of hash join. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+  return rc;
+}
+
+RC HashJoinPhysicalOperator::next_task()
+{
+  // 任何一边没有数据的分区不会有连接结果
+  for (Partition &partition : partitions_) {
+    if (partition.build_file != nullptr && partition.probe_file != nullptr) {
+      pending_tasks_.push_back(SpillTask{std::move(partition.build_file), std::move(partition.probe_file), level_ + 1});
+    }
+  }
+  reset_partitions();
+  probe_pos_   = -1;
+  probe_tuple_ = nullptr;
+
+  if (pending_tasks_.empty()) {
+    task_ = SpillTask();
+    return RC::RECORD_EOF;
+  }
+
+  // 后进先出，同时存在的文件不会太多
+  task_ = std::move(pending_tasks_.back());
+  pending_tasks_.pop_back();
+  level_     = task_.level;
+  max_level_ = std::max(max_level_, level_);
+
+  RC rc = task_.build_file->rewind();
+  if (rc == RC::SUCCESS) {
+    rc = task_.probe_file->rewind();
+  }
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to rewind spill files of hash join. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  LOG_TRACE("hash join processes spilled partition. level=%d, build rows=%" PRId64 ", probe rows=%" PRId64,
+            level_, task_.build_file->row_num(), task_.probe_file->row_num());
+  return build();
+}
+
+RC HashJoinPhysicalOperator::close()
+{
+  if (spilled_partition_num_ > 0) {
+    sql_debug("hash join: build rows %" PRId64 ", spilled %d partitions to %d files, "
+              "written %" PRId64 " bytes, read %" PRId64 " bytes, max level %d",
+              build_row_num_, spilled_partition_num_, spill_stats_.file_num, spill_stats_.bytes_written,
+              spill_stats_.bytes_read, max_level_);
+  }
+
+  reset_partitions();
+  task_ = SpillTask();
+  pending_tasks_.clear();
+  probe_tuple_ = nullptr;
+  probe_pos_   = -1;
+  return probe_oper_ != nullptr ? probe_oper_->close() : RC::SUCCESS;
+}
+
+Tuple *HashJoinPhysicalOperator::current_tuple()
+{
+  return &joined_tuple_;
+}
+
+bool HashJoinPhysicalOperator::eval_keys(
+    const vector<unique_ptr<Expression>> &exprs, const Tuple &tuple, vector<Value> &keys, RC &rc)
+{
+  rc = RC::SUCCESS;
+  keys.resize(exprs.size());
+  for (size_t i = 0; i < exprs.size(); i++) {
+    rc = exprs[i]->get_value(tuple, keys[i]);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to get value of join key. rc=%s", strrc(rc));
+      return false;
+    }
+    if (keys[i].attr_type() == NULLS) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void HashJoinPhysicalOperator::take_keys(const Side &side, const vector<Value> &values, vector<Value> &keys)
+{
+  keys.resize(side.key_index.size());
+  for (size_t i = 0; i < side.key_index.size(); i++) {
+    keys[i] = values[side.key_index[i]];
+  }
+}
+
+RC HashJoinPhysicalOperator::materialize(const Tuple &tuple, const vector<TupleCellSpec> &speces, vector<Value> &values)
+{
+  values.resize(speces.size());
+  for (size_t i = 0; i < speces.size(); i++) {
+    RC rc = tuple.find_cell(speces[i], values[i]);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to find cell of hash join. field=%s.%s, rc=%s",
+               speces[i].table_name(), speces[i].field_name(), strrc(rc));
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
@@ -0,0 +1,165 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+#include "sql/expr/expression.h"
+#include "sql/operator/join_hash_table.h"
+#include "sql/operator/physical_operator.h"
+#include "sql/operator/spill_file.h"
+#include "storage/field/field.h"
+
+/**
+ * @brief 等值连接的哈希连接算子
+ * @ingroup PhysicalOperator
+ * @details 打开时读取构建端的全部数据放到哈希表中，之后每读取探测端的一行，就在哈希表中查找连接键相同的行。
+ * 构建端由物理计划根据估算的数据量决定，选择较小的一端。不管哪一端构建，输出的元组都是左表在前右表在后。
+ * 连接键是 NULL 的行和任何行都不匹配，与等值比较的语义一样。
+ *
+ * 构建端的行按照哈希值的高位分成 PARTITION_NUM 个分区。使用的内存超过限制时，把内存最多的分区写到临时文件中，
+ * 这个分区之后的行也直接写到文件中；探测端属于这些分区的行同样写到文件中，其它的行直接探测。
+ * 探测端读完之后，再依次处理溢出的分区，每对文件按照哈希值接下来的几位继续分区，直到可以放到内存中
+ * (hybrid hash join)。递归层数超过 MAX_LEVEL 时不再溢出，一般是大量的行连接键相同，再分区也没有用。
+ * 写到文件中的行只包含 left_fields/right_fields 中的字段
+ */
+class HashJoinPhysicalOperator : public PhysicalOperator
+{
+public:
+  /**
+   * @param left_keys    左表的连接键，与 right_keys 一一对应，都是 left_fields/right_fields 中的字段
+   * @param left_fields  左表中上层算子需要的字段，溢出到文件中时只保留这些字段
+   * @param build_left   是否用左表构建哈希表
+   * @param memory_limit 构建端最多使用的内存，单位是字节
+   */
+  HashJoinPhysicalOperator(std::vector<std::unique_ptr<Expression>> &&left_keys,
+      std::vector<std::unique_ptr<Expression>> &&right_keys, const std::vector<Field> &left_fields,
+      const std::vector<Field> &right_fields, bool build_left, int64_t memory_limit);
+  virtual ~HashJoinPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override
+  {
+    return PhysicalOperatorType::HASH_JOIN;
+  }
+
+  std::string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+  Tuple *current_tuple() override;
+
+  /**
+   * @brief 计算连接键的值，并行哈希连接也使用
+   * @return 有 NULL 时返回 false
+   */
+  static bool eval_keys(const std::vector<std::unique_ptr<Expression>> &exprs, const Tuple &tuple,
+      std::vector<Value> &keys, RC &rc);
+
+  /**
+   * @brief 取出元组中 speces 对应的值
+   */
+  static RC materialize(const Tuple &tuple, const std::vector<TupleCellSpec> &speces, std::vector<Value> &values);
+
+private:
+  static constexpr int PARTITION_BITS = 4;
+  static constexpr int PARTITION_NUM  = 1 << PARTITION_BITS;
+  static constexpr int MAX_LEVEL      = 8;
+
+  /**
+   * @brief 连接的一边
+   */
+  struct Side
+  {
+    std::vector<std::unique_ptr<Expression>>          keys;
+    std::shared_ptr<const std::vector<TupleCellSpec>> speces;     ///< 物化的行中每个值对应的字段
+    std::vector<int>                                  key_index;  ///< 连接键在物化的行中的位置
+  };
+
+  struct BuildRow
+  {
+    size_t             hash = 0;
+    std::vector<Value> values;
+  };
+
+  struct Partition
+  {
+    std::vector<BuildRow>      rows;
+    int64_t                    memory = 0;
+    std::unique_ptr<SpillFile> build_file;  ///< 不为空表示这个分区已经溢出
+    std::unique_ptr<SpillFile> probe_file;
+  };
+
+  /**
+   * @brief 一对溢出的分区，level 是处理时使用的分区层数
+   */
+  struct SpillTask
+  {
+    std::unique_ptr<SpillFile> build_file;
+    std::unique_ptr<SpillFile> probe_file;
+    int                        level = 0;
+  };
+
+  static void take_keys(const Side &side, const std::vector<Value> &values, std::vector<Value> &keys);
+
+  static int partition_of(size_t hash, int level);
+
+  Side &build_side() { return build_left_ ? left_ : right_; }
+  Side &probe_side() { return build_left_ ? right_ : left_; }
+
+  RC build();
+  RC add_build_row(size_t hash, std::vector<Value> &values);
+  RC spill_partition(Partition &partition);
+
+  /**
+   * @brief 取探测端下一个不属于溢出分区的行
+   */
+  RC next_probe_row();
+
+  /**
+   * @brief 当前这一层处理完了，开始处理下一对溢出的分区
+   * @return 没有溢出的分区时返回 RECORD_EOF
+   */
+  RC next_task();
+
+  void reset_partitions();
+
+private:
+  Side    left_;
+  Side    right_;
+  bool    build_left_   = false;
+  int64_t memory_limit_ = 0;
+
+  PhysicalOperator *build_oper_ = nullptr;
+  PhysicalOperator *probe_oper_ = nullptr;
+
+  JoinHashTable          hash_table_;
+  std::vector<Partition> partitions_;
+  int64_t                memory_used_ = 0;
+  int                    level_       = 0;  ///< 0 表示正在处理子算子的数据，大于0时处理的是 task_ 中的文件
+  SpillTask              task_;
+  std::vector<SpillTask> pending_tasks_;
+
+  std::vector<Value> probe_keys_;
+  std::vector<Value> probe_values_;
+  size_t             probe_hash_  = 0;
+  Tuple             *probe_tuple_ = nullptr;
+  ChunkTuple         spilled_probe_tuple_;  ///< 从文件中读出来的探测端的行
+  int64_t            probe_pos_   = -1;  ///< 当前探测行在哈希表中的位置，-1 表示要读取探测端的下一行
+  JoinedTuple        joined_tuple_;
+
+  SpillStats spill_stats_;
+  int64_t    build_row_num_         = 0;
+  int        spilled_partition_num_ = 0;
+  int        max_level_             = 0;
+};
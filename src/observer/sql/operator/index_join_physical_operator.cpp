@@ -0,0 +1,175 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <inttypes.h>
+
+#include "sql/operator/index_join_physical_operator.h"
+#include "common/log/log.h"
+#include "event/sql_debug.h"
+#include "storage/table/table.h"
+
+using namespace std;
+
+IndexNestedLoopJoinPhysicalOperator::IndexNestedLoopJoinPhysicalOperator(
+    unique_ptr<Expression> outer_key, unique_ptr<Expression> inner_key, bool inner_left)
+    : outer_key_(std::move(outer_key)), inner_key_(std::move(inner_key)), inner_left_(inner_left)
+{}
+
+static string key_name(const Expression &expr)
+{
+  if (expr.type() != ExprType::FIELD) {
+    return expr.name();
+  }
+  const FieldExpr &field_expr = static_cast<const FieldExpr &>(expr);
+  return string(field_expr.table_name()) + "." + field_expr.field_name();
+}
+
+string IndexNestedLoopJoinPhysicalOperator::param() const
+{
+  const Expression &left  = inner_left_ ? *inner_key_ : *outer_key_;
+  const Expression &right = inner_left_ ? *outer_key_ : *inner_key_;
+  return key_name(left) + "=" + key_name(right) + (inner_left_ ? " INNER=LEFT" : " INNER=RIGHT");
+}
+
+RC IndexNestedLoopJoinPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 2) {
+    LOG_WARN("index nested loop join operator should have 2 children");
+    return RC::INTERNAL;
+  }
+
+  PhysicalOperator *inner = children_[inner_left_ ? 0 : 1].get();
+  if (inner->type() != PhysicalOperatorType::INDEX_SCAN) {
+    LOG_WARN("inner side of index nested loop join should be an index scan");
+    return RC::INTERNAL;
+  }
+
+  inner_        = static_cast<IndexScanPhysicalOperator *>(inner);
+  outer_        = children_[inner_left_ ? 1 : 0].get();
+  inner_opened_ = false;
+  outer_tuple_  = nullptr;
+  outer_rows_   = 0;
+  output_rows_  = 0;
+  trx_          = trx;
+  return outer_->open(trx);
+}
+
+RC IndexNestedLoopJoinPhysicalOperator::next()
+{
+  RC rc = RC::SUCCESS;
+  while (true) {
+    if (inner_opened_) {
+      rc = inner_next();
+      if (rc != RC::RECORD_EOF) {
+        return rc;
+      }
+    }
+
+    rc = outer_next();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+  return rc;
+}
+
+RC IndexNestedLoopJoinPhysicalOperator::outer_next()
+{
+  if (inner_opened_) {
+    inner_opened_ = false;
+    RC rc         = inner_->close();
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to close inner oper. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+
+  RC rc = RC::SUCCESS;
+  while (RC::SUCCESS == (rc = outer_->next())) {
+    outer_tuple_ = outer_->current_tuple();
+    rc           = outer_key_->get_value(*outer_tuple_, key_);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to get value of join key. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    // NULL 与任何值都不相等
+    if (key_.attr_type() == NULLS) {
+      continue;
+    }
+
+    outer_rows_++;
+    inner_->set_key(key_);
+    rc = inner_->open(trx_);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to open inner oper. rc=%s", strrc(rc));
+      return rc;
+    }
+    inner_opened_ = true;
+    return RC::SUCCESS;
+  }
+  return rc;
+}
+
+RC IndexNestedLoopJoinPhysicalOperator::inner_next()
+{
+  RC    rc = RC::SUCCESS;
+  Value inner_value;
+  while (RC::SUCCESS == (rc = inner_->next())) {
+    Tuple *inner_tuple = inner_->current_tuple();
+
+    // 索引中也有字段是 NULL 的记录，字符串的键也可能只匹配了前缀，所以要再比较一次
+    rc = inner_key_->get_value(*inner_tuple, inner_value);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to get value of join key. rc=%s", strrc(rc));
+      return rc;
+    }
+    if (inner_value.attr_type() == NULLS || inner_value.compare(key_) != 0) {
+      continue;
+    }
+
+    output_rows_++;
+    joined_tuple_.set_left(inner_left_ ? inner_tuple : outer_tuple_);
+    joined_tuple_.set_right(inner_left_ ? outer_tuple_ : inner_tuple);
+    return RC::SUCCESS;
+  }
+  return rc;
+}
+
+RC IndexNestedLoopJoinPhysicalOperator::close()
+{
+  RC rc = RC::SUCCESS;
+  if (inner_opened_) {
+    inner_opened_ = false;
+    rc            = inner_->close();
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to close inner oper. rc=%s", strrc(rc));
+    }
+  }
+
+  if (outer_ != nullptr) {
+    RC outer_rc = outer_->close();
+    if (outer_rc != RC::SUCCESS) {
+      LOG_WARN("failed to close outer oper. rc=%s", strrc(outer_rc));
+      rc = outer_rc;
+    }
+  }
+
+  if (inner_ != nullptr) {
+    sql_debug("index nested loop join: %" PRId64 " index lookups on %s, output %" PRId64 " rows",
+              outer_rows_, inner_->table()->name(), output_rows_);
+  }
+  return rc;
+}
+
+Tuple *IndexNestedLoopJoinPhysicalOperator::current_tuple()
+{
+  return &joined_tuple_;
+}
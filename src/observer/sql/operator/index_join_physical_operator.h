@@ -0,0 +1,78 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+
+#include "sql/expr/expression.h"
+#include "sql/operator/index_scan_physical_operator.h"
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief 索引嵌套循环连接算子
+ * @ingroup PhysicalOperator
+ * @details 内表的连接字段上有索引时使用。每读取外表的一行，就用它的连接键在内表的索引中查找，
+ * 不需要像 NestedLoopJoinPhysicalOperator 那样每次都遍历整个内表。
+ * 两个子算子与其它的连接算子一样分别是左表和右表，其中内表一边是 IndexScanPhysicalOperator，
+ * 每一行外表重新设置它的查找键并打开一次。输出的元组左表在前右表在后
+ */
+class IndexNestedLoopJoinPhysicalOperator : public PhysicalOperator
+{
+public:
+  /**
+   * @param outer_key  外表的连接键
+   * @param inner_key  内表的连接键，就是索引的字段
+   * @param inner_left 左表是否是内表
+   */
+  IndexNestedLoopJoinPhysicalOperator(
+      std::unique_ptr<Expression> outer_key, std::unique_ptr<Expression> inner_key, bool inner_left);
+  virtual ~IndexNestedLoopJoinPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override
+  {
+    return PhysicalOperatorType::INDEX_NESTED_LOOP_JOIN;
+  }
+
+  std::string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+  Tuple *current_tuple() override;
+
+private:
+  /**
+   * @brief 读取外表的下一行，并打开内表的索引扫描
+   */
+  RC outer_next();
+
+  /**
+   * @brief 读取内表中与当前外表行匹配的下一行
+   */
+  RC inner_next();
+
+private:
+  std::unique_ptr<Expression> outer_key_;
+  std::unique_ptr<Expression> inner_key_;
+  bool                        inner_left_ = false;
+
+  Trx                       *trx_          = nullptr;
+  PhysicalOperator          *outer_        = nullptr;
+  IndexScanPhysicalOperator *inner_        = nullptr;
+  bool                       inner_opened_ = false;
+  Tuple                     *outer_tuple_  = nullptr;
+  Value                      key_;
+  JoinedTuple                joined_tuple_;
+
+  int64_t outer_rows_  = 0;  ///< 查找索引的次数
+  int64_t output_rows_ = 0;
+};
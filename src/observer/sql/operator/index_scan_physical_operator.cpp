@@ -40,10 +40,13 @@ RC IndexScanPhysicalOperator::open(Trx *trx)
     return RC::INTERNAL;
   }
 
-  IndexScanner *index_scanner = index_->create_scanner(left_value_.data(),
+  // 没有设置边界时从索引的一端开始扫描，按照键值的顺序输出全部记录
+  const char   *left_key      = left_value_.attr_type() == UNDEFINED ? nullptr : left_value_.data();
+  const char   *right_key     = right_value_.attr_type() == UNDEFINED ? nullptr : right_value_.data();
+  IndexScanner *index_scanner = index_->create_scanner(left_key,
       left_value_.length(),
       left_inclusive_,
-      right_value_.data(),
+      right_key,
       right_value_.length(),
       right_inclusive_);
   if (nullptr == index_scanner) {
@@ -59,7 +62,9 @@ RC IndexScanPhysicalOperator::open(Trx *trx)
   }
   index_scanner_ = index_scanner;
 
-  tuple_.set_schema(table_, table_->table_meta().field_metas());
+  if (tuple_.cell_num() == 0) {
+    tuple_.set_schema(table_, table_->table_meta().field_metas());
+  }
 
   trx_ = trx;
   return RC::SUCCESS;
@@ -70,30 +75,48 @@ RC IndexScanPhysicalOperator::next()
   RID rid;
   RC rc = RC::SUCCESS;
 
-  record_page_handler_.cleanup();
-
   bool filter_result = false;
   while (RC::SUCCESS == (rc = index_scanner_->next_entry(&rid))) {
+    // 上一条记录可能被过滤掉了，它的页面也要先释放
+    record_page_handler_.cleanup();
     rc = record_handler_->get_record(record_page_handler_, &rid, readonly_, &current_record_);
     if (rc != RC::SUCCESS) {
       return rc;
     }
 
+    // 事务可能会把记录替换成对自己可见的旧版本，所以要先访问再过滤
+    rc = trx_->visit_record(table_, current_record_, readonly_);
+    if (rc == RC::LOCKED_NEED_WAIT) {
+      // 等锁之前释放页面，等到锁之后重新读取这条记录
+      record_page_handler_.cleanup();
+      rc = trx_->wait_lock();
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+      rc = record_handler_->get_record(record_page_handler_, &rid, readonly_, &current_record_);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+      rc = trx_->visit_record(table_, current_record_, readonly_);
+    }
+    if (rc == RC::RECORD_INVISIBLE) {
+      continue;
+    } else if (rc != RC::SUCCESS) {
+      return rc;
+    }
+
     tuple_.set_record(&current_record_);
     rc = filter(tuple_, filter_result);
     if (rc != RC::SUCCESS) {
       return rc;
     }
 
-    if (!filter_result) {
-      continue;
+    if (filter_result) {
+      return rc;
     }
 
-    rc = trx_->visit_record(table_, current_record_, readonly_);
-    if (rc == RC::RECORD_INVISIBLE) {
-      continue;
-    } else {
-      return rc;
+    if (!readonly_) {
+      trx_->skip_record(table_, current_record_);
     }
   }
 
@@ -102,8 +125,11 @@ RC IndexScanPhysicalOperator::next()
 
 RC IndexScanPhysicalOperator::close()
 {
-  index_scanner_->destroy();
-  index_scanner_ = nullptr;
+  record_page_handler_.cleanup();
+  if (index_scanner_ != nullptr) {
+    index_scanner_->destroy();
+    index_scanner_ = nullptr;
+  }
   return RC::SUCCESS;
 }
 
@@ -113,6 +139,14 @@ Tuple *IndexScanPhysicalOperator::current_tuple()
   return &tuple_;
 }
 
+void IndexScanPhysicalOperator::set_key(const Value &key)
+{
+  left_value_      = key;
+  right_value_     = key;
+  left_inclusive_  = true;
+  right_inclusive_ = true;
+}
+
 void IndexScanPhysicalOperator::set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs)
 {
   predicates_ = std::move(exprs);
@@ -46,6 +46,14 @@ public:
 
   void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
 
+  /**
+   * @brief 设置等值查找的键，下次 open 时生效
+   * @details 索引嵌套循环连接对外表的每一行重新设置键，再打开扫描
+   */
+  void set_key(const Value &key);
+
+  Table *table() const { return table_; }
+
 private:
   // 与TableScanPhysicalOperator代码相同，可以优化
   RC filter(RowTuple &tuple, bool &result);
@@ -0,0 +1,96 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/join_hash_table.h"
+
+using namespace std;
+
+void JoinHashTable::add(unique_ptr<Tuple> tuple, vector<Value> &keys, size_t hash)
+{
+  key_num_ = static_cast<int>(keys.size());
+  for (Value &key : keys) {
+    keys_.emplace_back(std::move(key));
+  }
+  hashes_.push_back(hash);
+  tuples_.emplace_back(std::move(tuple));
+}
+
+void JoinHashTable::build()
+{
+  uint64_t capacity = 16;
+  while (capacity < hashes_.size() * 2) {
+    capacity <<= 1;
+  }
+  mask_ = capacity - 1;
+  slots_.assign(capacity, Slot());
+
+  const int32_t rows = static_cast<int32_t>(hashes_.size());
+  for (int32_t row = 0; row < rows; row++) {
+    uint64_t pos = hashes_[row] & mask_;
+    while (slots_[pos].row >= 0) {
+      pos = (pos + 1) & mask_;
+    }
+    slots_[pos].hash = hashes_[row];
+    slots_[pos].row  = row;
+  }
+}
+
+void JoinHashTable::clear()
+{
+  slots_.clear();
+  mask_ = 0;
+  hashes_.clear();
+  keys_.clear();
+  tuples_.clear();
+}
+
+int64_t JoinHashTable::probe(int64_t pos, size_t hash, const vector<Value> &keys, int &row) const
+{
+  if (pos < 0) {
+    return -1;
+  }
+
+  uint64_t slot_pos = static_cast<uint64_t>(pos);
+  while (true) {
+    const Slot &slot = slots_[slot_pos];
+    if (slot.row < 0) {
+      return -1;
+    }
+
+    slot_pos = (slot_pos + 1) & mask_;
+    if (slot.hash != hash) {
+      continue;
+    }
+
+    const Value *row_keys = &keys_[static_cast<size_t>(slot.row) * key_num_];
+    bool         equal    = true;
+    for (int i = 0; i < key_num_ && equal; i++) {
+      equal = (row_keys[i].compare(keys[i]) == 0);
+    }
+    if (equal) {
+      row = slot.row;
+      return static_cast<int64_t>(slot_pos);
+    }
+  }
+}
+
+size_t JoinHashTable::hash(const vector<Value> &keys)
+{
+  size_t result = 0;
+  for (const Value &key : keys) {
+    result ^= key.hash() + 0x9e3779b97f4a7c15ULL + (result << 6) + (result >> 2);
+  }
+
+  // 整数的 std::hash 就是它本身，再打散一次，避免有规律的值集中在一部分槽位上
+  result ^= result >> 33;
+  result *= 0xff51afd7ed558ccdULL;
+  result ^= result >> 33;
+  return result;
+}
@@ -0,0 +1,78 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+#include "sql/expr/tuple.h"
+#include "sql/parser/value.h"
+
+/**
+ * @brief 哈希连接构建端的哈希表
+ * @ingroup PhysicalOperator
+ * @details 开放寻址、线性探测。槽位中只放哈希值和行号，连续存放，探测时大多只访问一两个缓存行。
+ * 哈希值不同的直接跳过，相同时再比较连接键。连接键相同的多行各占一个槽位，探测时依次返回。
+ * 先用 add 放入所有的行，再调用 build 建立槽位，之后才能探测
+ */
+class JoinHashTable
+{
+public:
+  JoinHashTable() = default;
+
+  /**
+   * @brief 放入一行
+   * @param tuple 复制出来的元组，哈希表负责释放
+   * @param keys  连接键的值，都不是 NULL
+   */
+  void add(std::unique_ptr<Tuple> tuple, std::vector<Value> &keys, size_t hash);
+
+  /**
+   * @brief 建立槽位。槽位个数是行数的2倍以上
+   */
+  void build();
+
+  void clear();
+
+  int size() const { return static_cast<int>(tuples_.size()); }
+
+  /**
+   * @brief 查找下一个连接键相同的行
+   * @param pos 探测的位置，第一次查找时传入 start_pos 的结果，之后传入上次返回的值
+   * @param row 找到的行号
+   * @return 下次查找的位置。没有更多的行时返回-1
+   */
+  int64_t probe(int64_t pos, size_t hash, const std::vector<Value> &keys, int &row) const;
+
+  int64_t start_pos(size_t hash) const { return slots_.empty() ? -1 : static_cast<int64_t>(hash & mask_); }
+
+  Tuple *tuple(int row) const { return tuples_[row].get(); }
+
+  /**
+   * @brief 多个连接键的值合并成一个哈希值
+   */
+  static size_t hash(const std::vector<Value> &keys);
+
+private:
+  struct Slot
+  {
+    uint64_t hash = 0;
+    int32_t  row  = -1;  ///< -1 表示空的槽位
+  };
+
+  std::vector<Slot>                   slots_;
+  uint64_t                            mask_ = 0;
+  std::vector<uint64_t>               hashes_;
+  std::vector<Value>                  keys_;  ///< 每行 key_num_ 个连接键
+  int                                 key_num_ = 0;
+  std::vector<std::unique_ptr<Tuple>> tuples_;
+};
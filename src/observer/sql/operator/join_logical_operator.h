@@ -15,6 +15,7 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include "sql/operator/logical_operator.h"
+#include "storage/field/field.h"
 
 /**
  * @brief 连接算子
@@ -32,5 +33,21 @@ public:
     return LogicalOperatorType::JOIN;
   }
 
+  /**
+   * @brief 上层要求连接结果按照这个字段从小到大排列
+   * @details 生成物理计划时，如果这个字段是连接键，可以考虑使用输出有序的归并连接，省掉上层的排序
+   */
+  void set_order_field(const Field &field)
+  {
+    order_field_     = field;
+    has_order_field_ = true;
+  }
+  const Field *order_field() const
+  {
+    return has_order_field_ ? &order_field_ : nullptr;
+  }
+
 private:
+  Field order_field_;
+  bool  has_order_field_ = false;
 };
@@ -0,0 +1,326 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <inttypes.h>
+#include <string.h>
+#include <algorithm>
+
+#include "sql/operator/merge_join_physical_operator.h"
+#include "common/log/log.h"
+#include "event/sql_debug.h"
+
+using namespace std;
+
+MergeJoinPhysicalOperator::MergeJoinPhysicalOperator(unique_ptr<Expression> left_key, unique_ptr<Expression> right_key,
+    const vector<Field> &left_fields, const vector<Field> &right_fields, bool sort_left, bool sort_right)
+{
+  init_input(left_, std::move(left_key), left_fields, sort_left);
+  init_input(right_, std::move(right_key), right_fields, sort_right);
+}
+
+void MergeJoinPhysicalOperator::init_input(
+    Input &input, unique_ptr<Expression> key, const vector<Field> &fields, bool sort)
+{
+  auto speces = make_shared<vector<TupleCellSpec>>();
+  speces->reserve(fields.size());
+  for (const Field &field : fields) {
+    speces->emplace_back(field.table_name(), field.field_name(), field.field_name());
+  }
+
+  input.key    = std::move(key);
+  input.speces = std::move(speces);
+  input.sort   = sort;
+}
+
+static string key_name(const Expression &expr)
+{
+  if (expr.type() != ExprType::FIELD) {
+    return expr.name();
+  }
+  const FieldExpr &field_expr = static_cast<const FieldExpr &>(expr);
+  return string(field_expr.table_name()) + "." + field_expr.field_name();
+}
+
+string MergeJoinPhysicalOperator::param() const
+{
+  string result = key_name(*left_.key) + "=" + key_name(*right_.key);
+  if (left_.sort) {
+    result += " SORT=LEFT";
+  }
+  if (right_.sort) {
+    result += " SORT=RIGHT";
+  }
+  return result;
+}
+
+bool MergeJoinPhysicalOperator::ordered_by(const Field &field) const
+{
+  for (const Input *input : {&left_, &right_}) {
+    if (input->key->type() != ExprType::FIELD) {
+      continue;
+    }
+    const FieldExpr &field_expr = static_cast<const FieldExpr &>(*input->key);
+    if (0 == strcmp(field_expr.table_name(), field.table_name()) &&
+        0 == strcmp(field_expr.field_name(), field.field_name())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static RC materialize(const Tuple &tuple, const vector<TupleCellSpec> &speces, vector<Value> &values)
+{
+  values.resize(speces.size());
+  for (size_t i = 0; i < speces.size(); i++) {
+    RC rc = tuple.find_cell(speces[i], values[i]);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to find cell of merge join. field=%s.%s, rc=%s",
+               speces[i].table_name(), speces[i].field_name(), strrc(rc));
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC MergeJoinPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 2) {
+    LOG_WARN("merge join operator should have 2 children");
+    return RC::INTERNAL;
+  }
+
+  left_.oper  = children_[0].get();
+  right_.oper = children_[1].get();
+
+  RC rc = RC::SUCCESS;
+  for (Input *input : {&left_, &right_}) {
+    input->rows.clear();
+    input->pos     = 0;
+    input->tuple   = nullptr;
+    input->row_num = 0;
+
+    rc = input->oper->open(trx);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to open child of merge join. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    if (input->sort) {
+      // 数据都在内存中了，子算子不再需要
+      rc = sort_input(*input);
+      input->oper->close();
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+    }
+
+    rc = advance(*input);
+    if (rc != RC::SUCCESS && rc != RC::RECORD_EOF) {
+      return rc;
+    }
+  }
+
+  run_.clear();
+  run_pos_      = 0;
+  in_run_       = false;
+  output_num_   = 0;
+  max_run_size_ = 0;
+  return RC::SUCCESS;
+}
+
+RC MergeJoinPhysicalOperator::sort_input(Input &input)
+{
+  RC rc = RC::SUCCESS;
+  while (RC::SUCCESS == (rc = input.oper->next())) {
+    Tuple *tuple = input.oper->current_tuple();
+
+    SortedRow row;
+    rc = input.key->get_value(*tuple, row.key);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to get value of join key. rc=%s", strrc(rc));
+      return rc;
+    }
+    if (row.key.attr_type() == NULLS) {
+      continue;
+    }
+
+    vector<Value> values;
+    rc = materialize(*tuple, *input.speces, values);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    row.tuple = make_unique<ChunkTuple>();
+    row.tuple->set_values(input.speces, std::move(values));
+    input.rows.emplace_back(std::move(row));
+  }
+
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to read child of merge join. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  std::stable_sort(input.rows.begin(), input.rows.end(), [](const SortedRow &left, const SortedRow &right) {
+    return left.key.compare(right.key) < 0;
+  });
+  LOG_TRACE("merge join sorted %d rows", static_cast<int>(input.rows.size()));
+  return RC::SUCCESS;
+}
+
+RC MergeJoinPhysicalOperator::advance(Input &input)
+{
+  if (input.sort) {
+    if (input.pos >= input.rows.size()) {
+      input.tuple = nullptr;
+      return RC::RECORD_EOF;
+    }
+
+    SortedRow &row  = input.rows[input.pos++];
+    input.tuple     = row.tuple.get();
+    input.key_value = row.key;
+    input.row_num++;
+    return RC::SUCCESS;
+  }
+
+  RC rc = RC::SUCCESS;
+  while (RC::SUCCESS == (rc = input.oper->next())) {
+    Tuple *tuple = input.oper->current_tuple();
+    rc           = input.key->get_value(*tuple, next_key_);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to get value of join key. rc=%s", strrc(rc));
+      return rc;
+    }
+    if (next_key_.attr_type() == NULLS) {
+      continue;
+    }
+
+    if (input.tuple != nullptr && next_key_.compare(input.key_value) < 0) {
+      LOG_WARN("input of merge join is not ordered. key=%s, previous key=%s",
+               next_key_.to_string().c_str(), input.key_value.to_string().c_str());
+      return RC::INTERNAL;
+    }
+
+    input.tuple = tuple;
+    std::swap(input.key_value, next_key_);
+    input.row_num++;
+    return RC::SUCCESS;
+  }
+
+  input.tuple = nullptr;
+  return rc;
+}
+
+RC MergeJoinPhysicalOperator::fill_run()
+{
+  run_.clear();
+  run_key_ = right_.key_value;
+
+  RC rc = RC::SUCCESS;
+  while (right_.tuple != nullptr && right_.key_value.compare(run_key_) == 0) {
+    if (right_.sort) {
+      run_.push_back(right_.tuple);
+    } else {
+      // 右边继续读取时当前的元组会被覆盖，需要复制一份
+      vector<Value> values;
+      rc = materialize(*right_.tuple, *right_.speces, values);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      if (run_.size() == run_storage_.size()) {
+        run_storage_.push_back(make_unique<ChunkTuple>());
+      }
+      ChunkTuple *tuple = run_storage_[run_.size()].get();
+      tuple->set_values(right_.speces, std::move(values));
+      run_.push_back(tuple);
+    }
+
+    rc = advance(right_);
+    if (rc != RC::SUCCESS && rc != RC::RECORD_EOF) {
+      return rc;
+    }
+  }
+
+  max_run_size_ = std::max(max_run_size_, run_.size());
+  return RC::SUCCESS;
+}
+
+RC MergeJoinPhysicalOperator::next()
+{
+  RC rc = RC::SUCCESS;
+  while (true) {
+    if (in_run_) {
+      if (run_pos_ < run_.size()) {
+        joined_tuple_.set_left(left_.tuple);
+        joined_tuple_.set_right(run_[run_pos_++]);
+        output_num_++;
+        return RC::SUCCESS;
+      }
+
+      rc = advance(left_);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      if (left_.key_value.compare(run_key_) == 0) {
+        run_pos_ = 0;
+        continue;
+      }
+      in_run_ = false;
+    }
+
+    if (left_.tuple == nullptr || right_.tuple == nullptr) {
+      return RC::RECORD_EOF;
+    }
+
+    const int cmp = left_.key_value.compare(right_.key_value);
+    if (cmp == 0) {
+      rc = fill_run();
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      run_pos_ = 0;
+      in_run_  = true;
+      continue;
+    }
+
+    rc = advance(cmp < 0 ? left_ : right_);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+}
+
+RC MergeJoinPhysicalOperator::close()
+{
+  RC rc = RC::SUCCESS;
+  for (Input *input : {&left_, &right_}) {
+    input->rows.clear();
+    input->tuple = nullptr;
+    if (input->oper != nullptr && !input->sort) {
+      RC close_rc = input->oper->close();
+      if (close_rc != RC::SUCCESS) {
+        LOG_WARN("failed to close child of merge join. rc=%s", strrc(close_rc));
+        rc = close_rc;
+      }
+    }
+  }
+  run_.clear();
+  run_storage_.clear();
+
+  if (left_.oper != nullptr) {
+    sql_debug("merge join: left rows %" PRId64 ", right rows %" PRId64 ", max duplicate keys %d, output %" PRId64
+              " rows",
+              left_.row_num, right_.row_num, static_cast<int>(max_run_size_), output_num_);
+  }
+  return rc;
+}
+
+Tuple *MergeJoinPhysicalOperator::current_tuple()
+{
+  return &joined_tuple_;
+}
@@ -0,0 +1,119 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+#include "sql/expr/expression.h"
+#include "sql/operator/physical_operator.h"
+#include "storage/field/field.h"
+
+/**
+ * @brief 等值连接的归并连接算子
+ * @ingroup PhysicalOperator
+ * @details 两边的输入都按照连接键从小到大排列，同时向前读取，键值小的一边前进，相等时输出连接结果，
+ * 不需要哈希表。一般是按照索引顺序扫描的表，不是有序的一边可以要求算子自己排序，
+ * 这时会读取这一边的全部数据放到内存中排序。
+ *
+ * 右边连续的相同键值的行会放到缓存中，左边每一个相同键值的行都和它们连接一次。
+ * 连接键是 NULL 的行和任何行都不匹配，直接跳过。输出按照连接键有序，上层按照连接键排序时可以省掉排序。
+ * 缓存和排序的行只包含 left_fields/right_fields 中的字段
+ */
+class MergeJoinPhysicalOperator : public PhysicalOperator
+{
+public:
+  /**
+   * @param left_key    左边的连接键，是 left_fields 中的字段
+   * @param left_fields 左边上层算子需要的字段
+   * @param sort_left   左边的输入是否需要排序
+   */
+  MergeJoinPhysicalOperator(std::unique_ptr<Expression> left_key, std::unique_ptr<Expression> right_key,
+      const std::vector<Field> &left_fields, const std::vector<Field> &right_fields, bool sort_left, bool sort_right);
+  virtual ~MergeJoinPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override
+  {
+    return PhysicalOperatorType::MERGE_JOIN;
+  }
+
+  std::string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+  Tuple *current_tuple() override;
+
+  /**
+   * @brief 输出是否按照这个字段从小到大排列
+   */
+  bool ordered_by(const Field &field) const;
+
+private:
+  struct SortedRow
+  {
+    Value                       key;
+    std::unique_ptr<ChunkTuple> tuple;
+  };
+
+  /**
+   * @brief 连接的一边
+   */
+  struct Input
+  {
+    std::unique_ptr<Expression>                       key;
+    std::shared_ptr<const std::vector<TupleCellSpec>> speces;  ///< 物化的行中每个值对应的字段
+    bool                                              sort = false;
+
+    PhysicalOperator      *oper = nullptr;
+    std::vector<SortedRow> rows;  ///< 排序之后的行，sort 为 true 时使用
+    size_t                 pos  = 0;
+
+    Tuple  *tuple = nullptr;  ///< 当前行，nullptr 表示已经读完
+    Value   key_value;
+    int64_t row_num = 0;
+  };
+
+  static void init_input(Input &input, std::unique_ptr<Expression> key, const std::vector<Field> &fields, bool sort);
+
+  /**
+   * @brief 读取全部数据，按照连接键排序
+   */
+  static RC sort_input(Input &input);
+
+  /**
+   * @brief 前进到下一个连接键不是 NULL 的行
+   * @details 发现输入不是有序的时返回 INTERNAL，否则结果会出错
+   */
+  RC advance(Input &input);
+
+  /**
+   * @brief 缓存右边和当前连接键相同的所有行
+   */
+  RC fill_run();
+
+private:
+  Input left_;
+  Input right_;
+
+  std::vector<std::unique_ptr<ChunkTuple>> run_storage_;  ///< 右边直接读取时复制出来的行，可以重复使用
+  std::vector<Tuple *>                     run_;          ///< 右边连接键相同的行
+  Value                                    run_key_;
+  size_t                                   run_pos_ = 0;
+  bool                                     in_run_  = false;  ///< 左边当前行是否和 run_ 中的行连接
+  Value                                    next_key_;
+
+  JoinedTuple joined_tuple_;
+
+  int64_t output_num_   = 0;
+  size_t  max_run_size_ = 0;
+};
@@ -0,0 +1,59 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+
+#include "common/types.h"
+
+/**
+ * @brief 并行扫描时待扫描的页面
+ * @ingroup PhysicalOperator
+ * @details 把一个文件的页号范围切成固定大小的小段(morsel)，扫描线程每扫描完一段就来领取下一段，
+ * 快的线程多扫描一些，不会因为某个线程分到的数据多而等待它。
+ * 同一个查询的多个扫描算子共享一个 MorselQueue，每段页面只会被领取一次。
+ */
+class MorselQueue
+{
+public:
+  static constexpr int DEFAULT_MORSEL_PAGES = 16;
+
+  /**
+   * @param page_count  要扫描的页号范围是 [0, page_count)
+   * @param morsel_pages 每次领取的页面个数
+   */
+  explicit MorselQueue(PageNum page_count, int morsel_pages = DEFAULT_MORSEL_PAGES)
+      : page_count_(page_count), morsel_pages_(morsel_pages)
+  {}
+
+  /**
+   * @brief 领取下一段页面 [begin_page, end_page)
+   * @return 所有页面都领取完了返回 false
+   */
+  bool next(PageNum &begin_page, PageNum &end_page)
+  {
+    const PageNum begin = next_page_.fetch_add(morsel_pages_);
+    if (begin >= page_count_) {
+      return false;
+    }
+    begin_page = begin;
+    end_page   = std::min(begin + morsel_pages_, page_count_);
+    return true;
+  }
+
+  PageNum page_count() const { return page_count_; }
+
+private:
+  const PageNum        page_count_;
+  const int            morsel_pages_;
+  std::atomic<PageNum> next_page_{0};
+};
@@ -39,6 +39,19 @@ public:
     return orders_;
   }
 
+  /**
+   * @brief 上层只需要前 limit 行，-1 表示需要全部排序
+   */
+  void set_limit(int limit)
+  {
+    limit_ = limit;
+  }
+  int limit() const
+  {
+    return limit_;
+  }
+
 private:
   std::vector<OrderUnit*> orders_;
+  int limit_ = -1;
 };
@@ -2,14 +2,36 @@
 // Created by NieYang on 2023/10/20.
 //
 
+#include <inttypes.h>
+#include <algorithm>
+
 #include "sql/operator/order_physical_operator.h"
-#include "storage/table/table.h"
+#include "sql/operator/sort_key.h"
+#include "common/log/log.h"
 #include "event/sql_debug.h"
-#include "sql/stmt/order_stmt.h"
+#include "storage/table/table.h"
+
+using namespace std;
 
-std::vector<std::vector<Tuple *>> split_tuples(std::vector<Tuple *> tuples,const TupleCellSpec &tuple_schema);
+/**
+ * @brief 一次最多归并的文件个数，每个文件读取时都有一个缓冲区
+ */
+static constexpr size_t MAX_MERGE_WAY = 64;
+
+OrderPhysicalOperator::OrderPhysicalOperator(vector<OrderUnit *> orders, int limit, int64_t memory_limit)
+    : orders_(std::move(orders)), limit_(limit), memory_limit_(memory_limit)
+{}
+
+string OrderPhysicalOperator::param() const
+{
+  if (limit_ < 0) {
+    return "";
+  }
+  return "LIMIT=" + to_string(limit_);
+}
 
-RC OrderPhysicalOperator::open(Trx *trx) {
+RC OrderPhysicalOperator::open(Trx *trx)
+{
   if (children_.empty()) {
     return RC::SUCCESS;
   }
@@ -20,116 +42,437 @@ RC OrderPhysicalOperator::open(Trx *trx) {
     LOG_WARN("failed to open child operator: %s", strrc(rc));
     return rc;
   }
-  rc = fetch_and_sort_table();
 
-  return rc;
+  speces_.reset();
+  key_indexes_.clear();
+  top_n_       = limit_ >= 0;
+  run_num_     = 0;
+  spill_stats_ = SpillStats();
+  entry_pos_   = 0;
+  row_num_     = 0;
+  output_num_  = 0;
+  return fetch_and_sort();
 }
 
-RC OrderPhysicalOperator::fetch_and_sort_table() {
-  RC rc = RC::SUCCESS;
-  // 循环从孩子节点获取数据
+RC OrderPhysicalOperator::init_speces(const Tuple &tuple)
+{
+  auto      speces   = make_shared<vector<TupleCellSpec>>();
+  const int cell_num = tuple.cell_num();
+  speces->reserve(cell_num);
+  for (int i = 0; i < cell_num; i++) {
+    TupleCellSpec spec("");
+    RC            rc = tuple.spec_at(i, spec);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to get cell spec. index=%d, rc=%s", i, strrc(rc));
+      return rc;
+    }
+    speces->push_back(spec);
+  }
+
+  // 排序列的位置只需要查找一次，比较时不再按照名字查找
+  key_indexes_.clear();
+  for (OrderUnit *order : orders_) {
+    const Field        &field = order->field();
+    const TupleCellSpec spec(field.table_name(), field.field_name(), field.field_name());
+    const int           index = Chunk::find_spec(*speces, spec);
+    if (index < 0) {
+      LOG_WARN("no such column to order by. table=%s, field=%s", field.table_name(), field.field_name());
+      return RC::SCHEMA_FIELD_MISSING;
+    }
+    key_indexes_.push_back(index);
+  }
+
+  speces_ = speces;
+  return RC::SUCCESS;
+}
+
+RC OrderPhysicalOperator::read_row(const Tuple &tuple, vector<Value> &values, string &key)
+{
+  const int cell_num = static_cast<int>(speces_->size());
+  values.resize(cell_num);
+  for (int i = 0; i < cell_num; i++) {
+    RC rc = tuple.cell_at(i, values[i]);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to get cell. index=%d, rc=%s", i, strrc(rc));
+      return rc;
+    }
+  }
+
+  key.clear();
+  for (size_t i = 0; i < orders_.size(); i++) {
+    SortKey::append(values[key_indexes_[i]], orders_[i]->type() == DESC, key);
+  }
+  return RC::SUCCESS;
+}
+
+int64_t OrderPhysicalOperator::row_bytes(const string &key, const vector<Value> &values)
+{
+  int64_t bytes = sizeof(SortEntry) + key.size() + sizeof(values) + values.size() * sizeof(Value);
+  for (const Value &value : values) {
+    if (value.attr_type() == CHARS) {
+      bytes += value.length();
+    }
+  }
+  return bytes;
+}
+
+RC OrderPhysicalOperator::fetch_and_sort()
+{
+  RC                rc   = RC::SUCCESS;
   PhysicalOperator *oper = children_.front().get();
 
+  vector<Value> values;
+  string        key;
   while (RC::SUCCESS == (rc = oper->next())) {
-    Tuple* tuple = oper->current_tuple()->clone();
-    tuples_.push_back(tuple);
-  }
-  for (auto &t: tuples_) {
-    auto temp = t->to_string();
-    int i = 1;
-  }
-
-  std::vector<std::vector<Tuple *>> tuples_list;
-
-  tuples_list.push_back(tuples_);
-
-  // 排序
-  for (auto &order: orders_) {
-    auto table_name = order->field().table()->name();
-    auto field_name = order->field().field_name();
-    auto tuple_schema = TupleCellSpec(table_name, field_name);
-    auto order_type = order->type();
-
-    std::vector<std::vector<Tuple *>> tmp;
-
-    for(auto tuples:tuples_list){
-      std::sort(tuples.begin(), tuples.end(), [&](Tuple *left, Tuple *right) {
-        Value left_value;
-        left->find_cell(tuple_schema, left_value);
-        Value right_value;
-        right->find_cell(tuple_schema, right_value);
-        int res = left_value.compare(right_value);
-        if (order_type == ASC) {
-          return res < 0;
-        }
-        return res > 0;
-      });
-
-      auto splited_tuples=split_tuples(tuples,tuple_schema);
-      for(auto t : splited_tuples){
-        tmp.push_back(t);
+    const Tuple *tuple = oper->current_tuple();
+    if (!speces_) {
+      rc = init_speces(*tuple);
+      if (rc != RC::SUCCESS) {
+        return rc;
       }
     }
-    
-    tuples_list.swap(tmp);
+
+    rc = read_row(*tuple, values, key);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    row_num_++;
+
+    if (top_n_) {
+      rc = add_top_row(key, values);
+    } else {
+      add_row(key, std::move(values));
+      if (memory_used_ > memory_limit_) {
+        rc = spill_rows();
+      }
+    }
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to read child of order by. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  if (top_n_) {
+    flush_top_rows();
+  }
+
+  if (runs_.empty()) {
+    sort_rows();
+    return RC::SUCCESS;
+  }
+
+  // 内存中剩余的数据也写到文件中，然后逐层归并，直到剩下的文件可以一次归并完
+  if (!entries_.empty()) {
+    rc = spill_rows();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
   }
 
-  std::vector<Tuple *> tmp_tuples;
+  while (runs_.size() > MAX_MERGE_WAY) {
+    vector<unique_ptr<SpillFile>> merged_runs;
+    for (size_t begin = 0; begin < runs_.size(); begin += MAX_MERGE_WAY) {
+      const size_t end = std::min(begin + MAX_MERGE_WAY, runs_.size());
+      if (end - begin == 1) {
+        merged_runs.push_back(std::move(runs_[begin]));
+        continue;
+      }
 
-  for(auto tuples:tuples_list){
-    for(auto tuple:tuples){
-      tmp_tuples.push_back(tuple);
+      auto output = make_unique<SpillFile>(&spill_stats_);
+      rc          = output->open();
+      if (rc == RC::SUCCESS) {
+        rc = merge_runs(runs_, begin, end, *output);
+      }
+      if (rc == RC::SUCCESS) {
+        rc = output->rewind();
+      }
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to merge sorted runs. rc=%s", strrc(rc));
+        return rc;
+      }
+      merged_runs.push_back(std::move(output));
     }
+    runs_.swap(merged_runs);
   }
 
-  tuples_.swap(tmp_tuples);
+  return open_readers(runs_, 0, runs_.size());
+}
+
+void OrderPhysicalOperator::add_row(const string &key, vector<Value> &&values)
+{
+  SortEntry entry;
+  entry.prefix     = SortKey::prefix(key.data(), key.size());
+  entry.key_offset = keys_.size();
+  entry.key_len    = static_cast<uint32_t>(key.size());
+  entry.row        = static_cast<uint32_t>(rows_.size());
+  entries_.push_back(entry);
+  keys_.append(key);
+
+  memory_used_ += row_bytes(key, values);
+  rows_.emplace_back(std::move(values));
+}
 
-  index_ = -1;
+static bool top_row_less(const string &left_key, int64_t left_seq, const string &right_key, int64_t right_seq)
+{
+  const int result = SortKey::compare(left_key.data(), left_key.size(), right_key.data(), right_key.size());
+  return result < 0 || (result == 0 && left_seq < right_seq);
+}
+
+RC OrderPhysicalOperator::add_top_row(string &key, vector<Value> &values)
+{
+  auto less = [](const TopRow &left, const TopRow &right) {
+    return top_row_less(left.key, left.seq, right.key, right.seq);
+  };
+
+  // 堆顶是保留的行中最大的一行，新的一行比它小时才替换掉它
+  if (static_cast<int64_t>(top_rows_.size()) < limit_) {
+    TopRow row;
+    row.key.swap(key);
+    row.seq = row_num_;
+    row.values.swap(values);
+    top_memory_used_ += row_bytes(row.key, row.values);
+    top_rows_.emplace_back(std::move(row));
+    std::push_heap(top_rows_.begin(), top_rows_.end(), less);
+  } else if (!top_rows_.empty() && top_row_less(key, row_num_, top_rows_.front().key, top_rows_.front().seq)) {
+    std::pop_heap(top_rows_.begin(), top_rows_.end(), less);
+    TopRow &row = top_rows_.back();
+    top_memory_used_ -= row_bytes(row.key, row.values);
+    row.key.swap(key);
+    row.seq = row_num_;
+    row.values.swap(values);
+    top_memory_used_ += row_bytes(row.key, row.values);
+    std::push_heap(top_rows_.begin(), top_rows_.end(), less);
+  }
+
+  if (top_memory_used_ > memory_limit_) {
+    // limit 很大时与不带 limit 一样排序，只输出前 limit 行
+    LOG_TRACE("top rows exceed memory limit, fallback to full sort. limit=%d", limit_);
+    flush_top_rows();
+    top_n_ = false;
+    if (memory_used_ > memory_limit_) {
+      return spill_rows();
+    }
+  }
   return RC::SUCCESS;
 }
 
-std::vector<std::vector<Tuple *>> split_tuples(std::vector<Tuple *> tuples,const TupleCellSpec &tuple_schema){
-  Value last_value(NULLS);
-  Value cur_value(NULLS);
-  std::vector<Tuple*> cur_tuples;
-  std::vector<std::vector<Tuple *>> tuples_list;
-  for(auto tuple : tuples){
-    tuple->find_cell(tuple_schema,cur_value);
-    if(last_value.attr_type()==NULLS || last_value.compare(cur_value)==0){
-      cur_tuples.push_back(tuple);
-      last_value = cur_value;
-    }else if(last_value.compare(cur_value)!=0){
-      std::vector<Tuple*> tmp;
-      tmp.swap(cur_tuples);
-      tuples_list.push_back(tmp);
-      cur_tuples.push_back(tuple);
-      last_value = cur_value;
+void OrderPhysicalOperator::flush_top_rows()
+{
+  // 按照读取的顺序放到待排序的数据中，稳定排序之后排序键相同的行仍然保持读取的顺序
+  std::sort(top_rows_.begin(), top_rows_.end(), [](const TopRow &left, const TopRow &right) {
+    return left.seq < right.seq;
+  });
+  for (TopRow &row : top_rows_) {
+    add_row(row.key, std::move(row.values));
+  }
+  top_rows_.clear();
+  top_memory_used_ = 0;
+}
+
+void OrderPhysicalOperator::sort_rows()
+{
+  const char *keys = keys_.data();
+  std::stable_sort(entries_.begin(), entries_.end(), [keys](const SortEntry &left, const SortEntry &right) {
+    if (left.prefix != right.prefix) {
+      return left.prefix < right.prefix;
+    }
+    return SortKey::compare(keys + left.key_offset, left.key_len, keys + right.key_offset, right.key_len) < 0;
+  });
+  entry_pos_ = 0;
+}
+
+RC OrderPhysicalOperator::write_row(SpillFile &file, const string &key, const vector<Value> &values)
+{
+  const uint32_t key_len = static_cast<uint32_t>(key.size());
+  RC             rc      = file.write(&key_len, sizeof(key_len));
+  if (rc == RC::SUCCESS) {
+    rc = file.write(key.data(), key_len);
+  }
+  if (rc == RC::SUCCESS) {
+    rc = file.write_values(values);
+  }
+  return rc;
+}
+
+RC OrderPhysicalOperator::spill_rows()
+{
+  sort_rows();
+
+  auto file = make_unique<SpillFile>(&spill_stats_);
+  RC   rc   = file->open();
+  string key;
+  for (size_t i = 0; rc == RC::SUCCESS && i < entries_.size(); i++) {
+    const SortEntry &entry = entries_[i];
+    key.assign(keys_.data() + entry.key_offset, entry.key_len);
+    rc = write_row(*file, key, rows_[entry.row]);
+  }
+  if (rc == RC::SUCCESS) {
+    rc = file->rewind();
+  }
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to spill sorted rows. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  LOG_TRACE("spill sorted run. rows=%d, bytes=%" PRId64, static_cast<int>(entries_.size()), file->size());
+  runs_.push_back(std::move(file));
+  run_num_++;
+
+  rows_.clear();
+  keys_.clear();
+  entries_.clear();
+  memory_used_ = 0;
+  return RC::SUCCESS;
+}
+
+RC OrderPhysicalOperator::RunReader::next()
+{
+  uint32_t key_len = 0;
+  RC       rc      = file->read(&key_len, sizeof(key_len));
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  key.resize(key_len);
+  rc = file->read(key.data(), key_len);
+  if (rc == RC::SUCCESS) {
+    rc = file->read_values(values);
+  }
+  if (rc == RC::RECORD_EOF) {
+    LOG_ERROR("sorted run is truncated");
+    rc = RC::IOERR_READ;
+  }
+  return rc;
+}
+
+bool OrderPhysicalOperator::ReaderGreater::operator()(int left, int right) const
+{
+  const RunReader &left_reader  = (*readers)[left];
+  const RunReader &right_reader = (*readers)[right];
+
+  const int result = SortKey::compare(
+      left_reader.key.data(), left_reader.key.size(), right_reader.key.data(), right_reader.key.size());
+  return result > 0 || (result == 0 && left > right);
+}
+
+RC OrderPhysicalOperator::open_readers(vector<unique_ptr<SpillFile>> &runs, size_t begin, size_t end)
+{
+  readers_.clear();
+  reader_heap_.clear();
+  readers_.resize(end - begin);
+  for (size_t i = begin; i < end; i++) {
+    RunReader &reader = readers_[i - begin];
+    reader.file       = std::move(runs[i]);
+
+    RC rc = reader.next();
+    if (rc == RC::RECORD_EOF) {
+      continue;
+    }
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to read sorted run. rc=%s", strrc(rc));
+      return rc;
     }
+    reader_heap_.push_back(static_cast<int>(i - begin));
   }
-  if(cur_tuples.size()>0){
-    tuples_list.push_back(cur_tuples);
+
+  std::make_heap(reader_heap_.begin(), reader_heap_.end(), ReaderGreater{&readers_});
+  return RC::SUCCESS;
+}
+
+RC OrderPhysicalOperator::next_merged(string &key, vector<Value> &values)
+{
+  if (reader_heap_.empty()) {
+    return RC::RECORD_EOF;
+  }
+
+  std::pop_heap(reader_heap_.begin(), reader_heap_.end(), ReaderGreater{&readers_});
+  RunReader &reader = readers_[reader_heap_.back()];
+  key.swap(reader.key);
+  values.swap(reader.values);
+
+  RC rc = reader.next();
+  if (rc == RC::SUCCESS) {
+    std::push_heap(reader_heap_.begin(), reader_heap_.end(), ReaderGreater{&readers_});
+  } else if (rc == RC::RECORD_EOF) {
+    reader.file.reset();
+    reader_heap_.pop_back();
+  } else {
+    LOG_WARN("failed to read sorted run. rc=%s", strrc(rc));
+    return rc;
   }
-  return tuples_list;
+  return RC::SUCCESS;
 }
 
-RC OrderPhysicalOperator::next() {
-  RC rc = RC::SUCCESS;
+RC OrderPhysicalOperator::merge_runs(vector<unique_ptr<SpillFile>> &runs, size_t begin, size_t end, SpillFile &output)
+{
+  RC rc = open_readers(runs, begin, end);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  string        key;
+  vector<Value> values;
+  while (RC::SUCCESS == (rc = next_merged(key, values))) {
+    rc = write_row(output, key, values);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+  readers_.clear();
+  return rc == RC::RECORD_EOF ? RC::SUCCESS : rc;
+}
 
-  if (index_ == tuples_.size() -1) {
+RC OrderPhysicalOperator::next()
+{
+  if (limit_ >= 0 && output_num_ >= limit_) {
     return RC::RECORD_EOF;
   }
-  index_++;
+
+  if (readers_.empty()) {
+    if (entry_pos_ >= entries_.size()) {
+      return RC::RECORD_EOF;
+    }
+    // 每行只输出一次，直接把值移动到输出的元组中
+    tuple_.set_values(speces_, std::move(rows_[entries_[entry_pos_++].row]));
+  } else {
+    vector<Value> values;
+    RC            rc = next_merged(merge_key_, values);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    tuple_.set_values(speces_, std::move(values));
+  }
+
+  output_num_++;
   return RC::SUCCESS;
 }
 
-RC OrderPhysicalOperator::close() {
+RC OrderPhysicalOperator::close()
+{
   if (!children_.empty()) {
     children_[0]->close();
+    sql_debug("order by: read %" PRId64 " rows, spilled %d sorted runs, written %" PRId64 " bytes, read %" PRId64
+              " bytes",
+              row_num_, run_num_, spill_stats_.bytes_written, spill_stats_.bytes_read);
   }
+
+  rows_.clear();
+  keys_.clear();
+  entries_.clear();
+  memory_used_ = 0;
+  top_rows_.clear();
+  top_memory_used_ = 0;
+  runs_.clear();
+  readers_.clear();
+  reader_heap_.clear();
   return RC::SUCCESS;
 }
 
-Tuple * OrderPhysicalOperator::current_tuple() {
-  assert(0 <= index_ < tuples_.size());
-  return tuples_[index_];
-}
\ No newline at end of file
+Tuple *OrderPhysicalOperator::current_tuple()
+{
+  return &tuple_;
+}
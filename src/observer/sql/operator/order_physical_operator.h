@@ -4,47 +4,133 @@
 
 #pragma once
 
-#include "sql/operator/physical_operator.h"
-#include "storage/record/record_manager.h"
-#include "common/rc.h"
-#include "sql/stmt/order_stmt.h"
+#include <stdint.h>
 #include <memory>
+#include <string>
+#include <vector>
 
-using namespace std;
-class Table;
+#include "sql/operator/physical_operator.h"
+#include "sql/operator/spill_file.h"
+#include "sql/expr/tuple.h"
+#include "sql/stmt/order_stmt.h"
+#include "common/rc.h"
 
 /**
- * @brief 聚合物理算子
- * @ingroup LogicalOperator
+ * @brief 排序物理算子
+ * @ingroup PhysicalOperator
+ * @details 从子算子读取全部数据，把每行的值复制出来，多个排序列编码成一个可以用 memcmp 比较的排序键
+ * （见 SortKey），排序时只移动排序键和行号组成的数组。
+ * 数据超过内存限制时，把已经读取的数据排好序写到临时文件中，最后多路归并这些有序的文件。
+ * 上层只需要前 limit 行时，用一个大小为 limit 的堆保留最小的 limit 行，不需要对全部数据排序。
+ * 排序是稳定的，排序键相同的行按照读取的顺序输出。
  */
 class OrderPhysicalOperator : public PhysicalOperator
 {
 public:
-    OrderPhysicalOperator(std::vector<OrderUnit*> orders)
-        :orders_(orders)
-    {}
-
-    virtual ~OrderPhysicalOperator()
-    {
-    for (auto tuple : tuples_) {
-        if (tuple) {
-        delete tuple;
-        }
-    }
-    }
-
-    PhysicalOperatorType type() const override
-    {
-        return PhysicalOperatorType::ORDER_BY;
-    }
-    
-    RC open(Trx *trx) override;
-    RC next() override;
-    RC close() override;
-    RC fetch_and_sort_table();
-    Tuple *current_tuple() override;
+  /**
+   * @param limit        上层需要的行数，-1 表示需要全部数据
+   * @param memory_limit 排序最多使用的内存，单位是字节
+   */
+  OrderPhysicalOperator(std::vector<OrderUnit *> orders, int limit, int64_t memory_limit);
+  virtual ~OrderPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::ORDER_BY; }
+
+  std::string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+
+  Tuple *current_tuple() override;
+
 private:
-    std::vector<OrderUnit*> orders_;
-    std::vector<Tuple *>    tuples_;
-    int index_ = 0;
-};
\ No newline at end of file
+  struct SortEntry
+  {
+    uint64_t prefix;      ///< 排序键的前8个字节，见 SortKey::prefix
+    size_t   key_offset;  ///< 排序键在 keys_ 中的位置
+    uint32_t key_len;
+    uint32_t row;
+  };
+
+  /**
+   * @brief 只保留前 limit 行时堆中的一行
+   */
+  struct TopRow
+  {
+    std::string        key;
+    int64_t            seq = 0;  ///< 读取的顺序，排序键相同时先读取的排在前面
+    std::vector<Value> values;
+  };
+
+  /**
+   * @brief 归并时读取一个有序的临时文件
+   */
+  struct RunReader
+  {
+    std::unique_ptr<SpillFile> file;
+    std::string                key;
+    std::vector<Value>         values;
+
+    RC next();
+  };
+
+  /**
+   * @brief 归并时的堆比较，排序键相同时先写入的文件排在前面
+   */
+  struct ReaderGreater
+  {
+    const std::vector<RunReader> *readers;
+
+    bool operator()(int left, int right) const;
+  };
+
+  RC fetch_and_sort();
+  RC init_speces(const Tuple &tuple);
+  RC read_row(const Tuple &tuple, std::vector<Value> &values, std::string &key);
+
+  void add_row(const std::string &key, std::vector<Value> &&values);
+  RC   add_top_row(std::string &key, std::vector<Value> &values);
+  void flush_top_rows();
+  void sort_rows();
+
+  RC spill_rows();
+  RC write_row(SpillFile &file, const std::string &key, const std::vector<Value> &values);
+  RC merge_runs(std::vector<std::unique_ptr<SpillFile>> &runs, size_t begin, size_t end, SpillFile &output);
+  RC open_readers(std::vector<std::unique_ptr<SpillFile>> &runs, size_t begin, size_t end);
+  RC next_merged(std::string &key, std::vector<Value> &values);
+
+  static int64_t row_bytes(const std::string &key, const std::vector<Value> &values);
+
+private:
+  std::vector<OrderUnit *> orders_;
+  int                      limit_        = -1;
+  int64_t                  memory_limit_ = 0;
+
+  std::shared_ptr<const std::vector<TupleCellSpec>> speces_;       ///< 复制出来的每行数据的描述
+  std::vector<int>                                  key_indexes_;  ///< 排序列在每行数据中的位置
+
+  // 在内存中排序的数据
+  std::vector<std::vector<Value>> rows_;
+  std::string                     keys_;
+  std::vector<SortEntry>          entries_;
+  int64_t                         memory_used_ = 0;
+
+  // 只需要前 limit 行时使用的堆
+  bool                top_n_ = false;
+  std::vector<TopRow> top_rows_;
+  int64_t             top_memory_used_ = 0;
+
+  // 溢出到文件中的有序数据
+  std::vector<std::unique_ptr<SpillFile>> runs_;
+  std::vector<RunReader>                  readers_;
+  std::vector<int>                        reader_heap_;
+  std::string                             merge_key_;
+  SpillStats                              spill_stats_;
+  int                                     run_num_ = 0;
+
+  size_t     entry_pos_  = 0;
+  int64_t    row_num_    = 0;
+  int64_t    output_num_ = 0;
+  ChunkTuple tuple_;
+};
@@ -0,0 +1,278 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <inttypes.h>
+#include <algorithm>
+
+#include "sql/operator/parallel_hash_join_physical_operator.h"
+#include "common/log/log.h"
+#include "common/worker_pool.h"
+#include "event/sql_debug.h"
+#include "sql/expr/chunk.h"
+#include "sql/operator/hash_join_physical_operator.h"
+
+using namespace std;
+
+ParallelHashJoinBuild::ParallelHashJoinBuild(
+    vector<unique_ptr<Expression>> &&keys, const vector<Field> &fields, int64_t memory_limit)
+    : keys_(std::move(keys)), memory_limit_(memory_limit), hash_tables_(PARTITION_NUM)
+{
+  auto speces = make_shared<vector<TupleCellSpec>>();
+  speces->reserve(fields.size());
+  for (const Field &field : fields) {
+    speces->emplace_back(field.table_name(), field.field_name(), field.field_name());
+  }
+
+  for (const unique_ptr<Expression> &key : keys_) {
+    int index = -1;
+    if (key->type() == ExprType::FIELD) {
+      const FieldExpr &field_expr = static_cast<const FieldExpr &>(*key);
+      index = Chunk::find_spec(*speces, TupleCellSpec(field_expr.table_name(), field_expr.field_name()));
+    }
+    key_index_.push_back(index);
+  }
+  speces_ = std::move(speces);
+}
+
+void ParallelHashJoinBuild::set_pipelines(vector<PhysicalOperator *> pipelines)
+{
+  lock_guard<mutex> guard(lock_);
+  pipelines_ = std::move(pipelines);
+  built_     = false;
+  rc_        = RC::SUCCESS;
+  row_num_   = 0;
+  for (JoinHashTable &hash_table : hash_tables_) {
+    hash_table.clear();
+  }
+}
+
+RC ParallelHashJoinBuild::build()
+{
+  lock_guard<mutex> guard(lock_);
+  if (built_) {
+    return rc_;
+  }
+  built_ = true;
+
+  if (std::find(key_index_.begin(), key_index_.end(), -1) != key_index_.end()) {
+    LOG_WARN("join key of parallel hash join is not in the fields");
+    rc_ = RC::INTERNAL;
+    return rc_;
+  }
+
+  // 每个流水线各自分区
+  vector<PipelineRows> pipeline_rows(pipelines_.size());
+  rc_ = WorkerPool::instance().run(static_cast<int>(pipelines_.size()),
+      [this, &pipeline_rows](int index) { return partition(*pipelines_[index], pipeline_rows[index]); });
+  if (rc_ != RC::SUCCESS) {
+    LOG_WARN("failed to read build side of parallel hash join. rc=%s", strrc(rc_));
+    return rc_;
+  }
+
+  int64_t memory = 0;
+  for (const PipelineRows &rows : pipeline_rows) {
+    memory += rows.memory;
+  }
+  if (memory > memory_limit_) {
+    LOG_WARN("parallel hash join exceeds memory limit. memory used=%" PRId64 ", limit=%" PRId64,
+             memory, memory_limit_);
+  }
+
+  // 每个线程负责一部分分区，各自建立分区的哈希表
+  const int task_num = std::min(static_cast<int>(pipelines_.size()), PARTITION_NUM);
+  rc_ = WorkerPool::instance().run(task_num, [this, task_num, &pipeline_rows](int task) {
+    for (int partition = task; partition < PARTITION_NUM; partition += task_num) {
+      build_partition(partition, pipeline_rows);
+    }
+    return RC::SUCCESS;
+  });
+
+  for (const JoinHashTable &hash_table : hash_tables_) {
+    row_num_ += hash_table.size();
+  }
+  LOG_TRACE("parallel hash join built. pipelines=%d, rows=%" PRId64, pipeline_num(), row_num_);
+  return rc_;
+}
+
+RC ParallelHashJoinBuild::partition(PhysicalOperator &pipeline, PipelineRows &rows)
+{
+  RC            rc = RC::SUCCESS;
+  vector<Value> keys;
+  while (RC::SUCCESS == (rc = pipeline.next())) {
+    Tuple *tuple = pipeline.current_tuple();
+    if (!HashJoinPhysicalOperator::eval_keys(keys_, *tuple, keys, rc)) {
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      continue;
+    }
+
+    BuildRow row;
+    rc = HashJoinPhysicalOperator::materialize(*tuple, *speces_, row.values);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    row.hash = JoinHashTable::hash(keys);
+
+    // 与 HashJoinPhysicalOperator 一样粗略地估算
+    rows.memory += sizeof(BuildRow) + sizeof(ChunkTuple) + 2 * sizeof(uint64_t) * 2 + keys.size() * sizeof(Value);
+    for (const Value &value : row.values) {
+      rows.memory += sizeof(Value) + (value.attr_type() == CHARS ? value.length() : 0);
+    }
+    rows.partitions[partition_of(row.hash)].push_back(std::move(row));
+  }
+  return rc == RC::RECORD_EOF ? RC::SUCCESS : rc;
+}
+
+void ParallelHashJoinBuild::build_partition(int partition, vector<PipelineRows> &pipeline_rows)
+{
+  JoinHashTable &hash_table = hash_tables_[partition];
+  vector<Value>  keys(key_index_.size());
+  for (PipelineRows &rows : pipeline_rows) {
+    for (BuildRow &row : rows.partitions[partition]) {
+      for (size_t i = 0; i < key_index_.size(); i++) {
+        keys[i] = row.values[key_index_[i]];
+      }
+      auto tuple = make_unique<ChunkTuple>();
+      tuple->set_values(speces_, std::move(row.values));
+      hash_table.add(std::move(tuple), keys, row.hash);
+    }
+    rows.partitions[partition].clear();
+    rows.partitions[partition].shrink_to_fit();
+  }
+  hash_table.build();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ParallelHashJoinPhysicalOperator::ParallelHashJoinPhysicalOperator(
+    vector<unique_ptr<Expression>> &&probe_keys, shared_ptr<ParallelHashJoinBuild> build, bool build_left)
+    : probe_keys_(std::move(probe_keys)), build_(std::move(build)), build_left_(build_left)
+{}
+
+static string key_name(const Expression &expr)
+{
+  if (expr.type() != ExprType::FIELD) {
+    return expr.name();
+  }
+  const FieldExpr &field_expr = static_cast<const FieldExpr &>(expr);
+  return string(field_expr.table_name()) + "." + field_expr.field_name();
+}
+
+string ParallelHashJoinPhysicalOperator::param() const
+{
+  const vector<unique_ptr<Expression>> &left_keys  = build_left_ ? build_->keys() : probe_keys_;
+  const vector<unique_ptr<Expression>> &right_keys = build_left_ ? probe_keys_ : build_->keys();
+
+  string result;
+  for (size_t i = 0; i < left_keys.size(); i++) {
+    if (i > 0) {
+      result += " AND ";
+    }
+    result += key_name(*left_keys[i]) + "=" + key_name(*right_keys[i]);
+  }
+  result += build_left_ ? " BUILD=LEFT" : " BUILD=RIGHT";
+  if (own_build()) {
+    result += " PARTITIONS=" + to_string(ParallelHashJoinBuild::PARTITION_NUM);
+  }
+  return result;
+}
+
+RC ParallelHashJoinPhysicalOperator::open(Trx *trx)
+{
+  if (children_.empty()) {
+    LOG_WARN("parallel hash join operator should have a probe child");
+    return RC::INTERNAL;
+  }
+
+  RC rc = RC::SUCCESS;
+  if (own_build()) {
+    vector<PhysicalOperator *> pipelines;
+    for (size_t i = 1; i < children_.size(); i++) {
+      rc = children_[i]->open(trx);
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to open build side of parallel hash join. rc=%s", strrc(rc));
+        return rc;
+      }
+      pipelines.push_back(children_[i].get());
+    }
+    build_->set_pipelines(std::move(pipelines));
+  }
+
+  built_       = false;
+  hash_table_  = nullptr;
+  probe_tuple_ = nullptr;
+  probe_pos_   = -1;
+  return children_[0]->open(trx);
+}
+
+RC ParallelHashJoinPhysicalOperator::next()
+{
+  RC rc = RC::SUCCESS;
+  if (!built_) {
+    // 在执行流水线的线程中构建，这时所有的流水线都已经打开了
+    built_ = true;
+    rc     = build_->build();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+
+  PhysicalOperator *probe_oper = children_[0].get();
+  while (true) {
+    if (probe_pos_ >= 0) {
+      int row    = -1;
+      probe_pos_ = hash_table_->probe(probe_pos_, probe_hash_, probe_key_values_, row);
+      if (probe_pos_ >= 0) {
+        Tuple *build_tuple = hash_table_->tuple(row);
+        joined_tuple_.set_left(build_left_ ? build_tuple : probe_tuple_);
+        joined_tuple_.set_right(build_left_ ? probe_tuple_ : build_tuple);
+        return RC::SUCCESS;
+      }
+    }
+
+    rc = probe_oper->next();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+
+    probe_tuple_ = probe_oper->current_tuple();
+    if (!HashJoinPhysicalOperator::eval_keys(probe_keys_, *probe_tuple_, probe_key_values_, rc)) {
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      continue;
+    }
+
+    probe_hash_ = JoinHashTable::hash(probe_key_values_);
+    hash_table_ = &build_->hash_table(probe_hash_);
+    probe_pos_  = hash_table_->start_pos(probe_hash_);
+  }
+  return rc;
+}
+
+RC ParallelHashJoinPhysicalOperator::close()
+{
+  RC rc = children_[0]->close();
+  if (own_build()) {
+    sql_debug("parallel hash join: build rows %" PRId64 " from %d pipelines, %d partitions",
+              build_->row_num(), build_->pipeline_num(), ParallelHashJoinBuild::PARTITION_NUM);
+    for (size_t i = 1; i < children_.size(); i++) {
+      if (children_[i]->close() != RC::SUCCESS) {
+        rc = RC::INTERNAL;
+      }
+    }
+  }
+
+  hash_table_  = nullptr;
+  probe_tuple_ = nullptr;
+  probe_pos_   = -1;
+  return rc;
+}
@@ -0,0 +1,148 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "sql/expr/expression.h"
+#include "sql/operator/join_hash_table.h"
+#include "sql/operator/physical_operator.h"
+#include "storage/field/field.h"
+
+/**
+ * @brief 并行哈希连接的构建端，同一个连接的多个探测流水线共享
+ * @ingroup PhysicalOperator
+ * @details 构建分成两个阶段，都交给 WorkerPool 并行执行：
+ * 1. 每个构建流水线在一个线程中读取自己的数据，按照哈希值的高位分到 PARTITION_NUM 个分区中(radix partitioning)；
+ * 2. 每个线程负责一部分分区，把各个流水线中这个分区的行放到这个分区自己的哈希表中。
+ * 不同的分区之间没有共享的数据，不需要加锁。每个分区的哈希表比较小，建立槽位和探测时访问的内存更集中。
+ * 构建完成之后哈希表是只读的，所有的探测流水线同时访问。
+ * 不会溢出到磁盘，估算的数据量超过内存限制时物理计划使用串行的 HashJoinPhysicalOperator
+ */
+class ParallelHashJoinBuild
+{
+public:
+  static constexpr int PARTITION_BITS = 6;
+  static constexpr int PARTITION_NUM  = 1 << PARTITION_BITS;
+
+  /**
+   * @param keys         构建端的连接键，都是 fields 中的字段
+   * @param fields       构建端中上层算子需要的字段，哈希表中只保留这些字段
+   * @param memory_limit 超过时只打印日志
+   */
+  ParallelHashJoinBuild(
+      std::vector<std::unique_ptr<Expression>> &&keys, const std::vector<Field> &fields, int64_t memory_limit);
+
+  const std::vector<std::unique_ptr<Expression>> &keys() const { return keys_; }
+
+  /**
+   * @brief 设置构建端的流水线。流水线属于某个探测算子，由它负责打开和关闭
+   */
+  void set_pipelines(std::vector<PhysicalOperator *> pipelines);
+
+  /**
+   * @brief 构建哈希表。每个探测流水线都会调用，第一次调用时构建，同时调用的等待构建完成
+   */
+  RC build();
+
+  const JoinHashTable &hash_table(size_t hash) const { return hash_tables_[partition_of(hash)]; }
+
+  int64_t row_num() const { return row_num_; }
+  int     pipeline_num() const { return static_cast<int>(pipelines_.size()); }
+
+  /**
+   * @brief 哈希表的槽位用的是低位，分区用最高的 PARTITION_BITS 位
+   */
+  static int partition_of(size_t hash) { return static_cast<int>(hash >> (64 - PARTITION_BITS)); }
+
+private:
+  struct BuildRow
+  {
+    size_t             hash = 0;
+    std::vector<Value> values;
+  };
+
+  /**
+   * @brief 一个构建流水线读取的数据，按照分区存放
+   */
+  struct PipelineRows
+  {
+    std::vector<BuildRow> partitions[PARTITION_NUM];
+    int64_t               memory = 0;
+  };
+
+  RC   partition(PhysicalOperator &pipeline, PipelineRows &rows);
+  void build_partition(int partition, std::vector<PipelineRows> &pipeline_rows);
+
+private:
+  std::vector<std::unique_ptr<Expression>>          keys_;
+  std::shared_ptr<const std::vector<TupleCellSpec>> speces_;
+  std::vector<int>                                  key_index_;  ///< 连接键在物化的行中的位置
+  int64_t                                           memory_limit_ = 0;
+
+  std::vector<PhysicalOperator *> pipelines_;
+  std::mutex                      lock_;
+  bool                            built_ = false;
+  RC                              rc_    = RC::SUCCESS;
+  std::vector<JoinHashTable>      hash_tables_;
+  int64_t                         row_num_ = 0;
+};
+
+/**
+ * @brief 并行哈希连接的探测端
+ * @ingroup PhysicalOperator
+ * @details 探测端按照 morsel 并行执行，每个流水线有一个这样的算子，第一个子算子是这个流水线探测端的算子，
+ * 各个流水线的输出再由 Gather 或者聚合算子汇总。所有的流水线共享一个 ParallelHashJoinBuild，
+ * 第一次获取数据时构建哈希表。构建端的流水线放在第一个流水线的算子中，作为它后面的子算子，由它打开和关闭。
+ * 与 HashJoinPhysicalOperator 一样，输出的元组都是左表在前右表在后，连接键是 NULL 的行和任何行都不匹配
+ */
+class ParallelHashJoinPhysicalOperator : public PhysicalOperator
+{
+public:
+  /**
+   * @param probe_keys 探测端的连接键，与构建端的连接键一一对应
+   * @param build_left 构建端是否是左边
+   */
+  ParallelHashJoinPhysicalOperator(std::vector<std::unique_ptr<Expression>> &&probe_keys,
+      std::shared_ptr<ParallelHashJoinBuild> build, bool build_left);
+  virtual ~ParallelHashJoinPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::PARALLEL_HASH_JOIN; }
+
+  std::string param() const override;
+
+  RC     open(Trx *trx) override;
+  RC     next() override;
+  RC     close() override;
+  Tuple *current_tuple() override { return &joined_tuple_; }
+
+private:
+  /**
+   * @brief 构建端的流水线是否由这个算子负责
+   */
+  bool own_build() const { return children_.size() > 1; }
+
+private:
+  std::vector<std::unique_ptr<Expression>> probe_keys_;
+  std::shared_ptr<ParallelHashJoinBuild>   build_;
+  bool                                     build_left_ = false;
+  bool                                     built_      = false;
+
+  std::vector<Value>   probe_key_values_;
+  size_t               probe_hash_  = 0;
+  Tuple               *probe_tuple_ = nullptr;
+  const JoinHashTable *hash_table_  = nullptr;
+  int64_t              probe_pos_   = -1;  ///< 当前探测行在哈希表中的位置，-1 表示要读取探测端的下一行
+  JoinedTuple          joined_tuple_;
+};
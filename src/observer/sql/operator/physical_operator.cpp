@@ -23,6 +23,14 @@ std::string physical_operator_type_name(PhysicalOperatorType type)
       return "INDEX_SCAN";
     case PhysicalOperatorType::NESTED_LOOP_JOIN:
       return "NESTED_LOOP_JOIN";
+    case PhysicalOperatorType::INDEX_NESTED_LOOP_JOIN:
+      return "INDEX_NESTED_LOOP_JOIN";
+    case PhysicalOperatorType::HASH_JOIN:
+      return "HASH_JOIN";
+    case PhysicalOperatorType::PARALLEL_HASH_JOIN:
+      return "PARALLEL_HASH_JOIN";
+    case PhysicalOperatorType::MERGE_JOIN:
+      return "MERGE_JOIN";
     case PhysicalOperatorType::EXPLAIN:
       return "EXPLAIN";
     case PhysicalOperatorType::PREDICATE:
@@ -35,6 +43,12 @@ std::string physical_operator_type_name(PhysicalOperatorType type)
       return "PROJECT";
     case PhysicalOperatorType::STRING_LIST:
       return "STRING_LIST";
+    case PhysicalOperatorType::CHUNK_TO_ROW:
+      return "CHUNK_TO_ROW";
+    case PhysicalOperatorType::ORDER_BY:
+      return "ORDER_BY";
+    case PhysicalOperatorType::GATHER:
+      return "GATHER";
     default:
       return "UNKNOWN";
   }
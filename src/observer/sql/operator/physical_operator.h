@@ -24,6 +24,7 @@ See the Mulan PSL v2 for more details. */
 class Record;
 class TupleCellSpec;
 class Trx;
+class Chunk;
 
 /**
  * @brief 物理算子
@@ -40,6 +41,10 @@ enum class PhysicalOperatorType
   TABLE_SCAN,
   INDEX_SCAN,
   NESTED_LOOP_JOIN,
+  INDEX_NESTED_LOOP_JOIN,
+  HASH_JOIN,
+  PARALLEL_HASH_JOIN,
+  MERGE_JOIN,
   EXPLAIN,
   PREDICATE,
   PROJECT,
@@ -50,6 +55,8 @@ enum class PhysicalOperatorType
   UPDATE,
   AGGREGATION,
   ORDER_BY,
+  CHUNK_TO_ROW,
+  GATHER,
 };
 
 /**
@@ -77,6 +84,19 @@ public:
 
   virtual Tuple *current_tuple() = 0;
 
+  /**
+   * @brief 批量获取数据，每次返回一批
+   * @details 支持批量执行的算子实现这个接口，与 next() 二选一使用，由物理计划决定。
+   * 调用者每次传入同一个 chunk，算子可以在第一次调用时设置好 chunk 的列，之后重复使用。
+   * chunk 中的数据在下一次调用之前有效，返回的 chunk 至少有一行，没有数据时返回 RECORD_EOF
+   */
+  virtual RC next(Chunk &chunk) { return RC::UNIMPLENMENT; }
+
+  /**
+   * @brief 当前算子以及它下面的所有算子是否都可以批量执行
+   */
+  virtual bool support_chunk() const { return false; }
+
   void add_child(std::unique_ptr<PhysicalOperator> oper)
   {
     children_.emplace_back(std::move(oper));
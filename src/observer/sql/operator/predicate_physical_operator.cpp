@@ -59,6 +59,25 @@ RC PredicatePhysicalOperator::next()
   return rc;
 }
 
+RC PredicatePhysicalOperator::next(Chunk &chunk)
+{
+  RC rc = RC::SUCCESS;
+  PhysicalOperator *oper = children_.front().get();
+
+  while (RC::SUCCESS == (rc = oper->next(chunk))) {
+    rc = expression_->eval(chunk, select_);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+
+    chunk.filter(select_);
+    if (chunk.rows() > 0) {
+      return rc;
+    }
+  }
+  return rc;
+}
+
 RC PredicatePhysicalOperator::close()
 {
   children_[0]->close();
@@ -42,6 +42,13 @@ public:
 
   Tuple *current_tuple() override;
 
+  /**
+   * @brief 对子算子返回的整批数据计算过滤条件，只保留满足条件的行
+   */
+  RC next(Chunk &chunk) override;
+  bool support_chunk() const override { return children_[0]->support_chunk(); }
+
 private:
   std::unique_ptr<Expression> expression_;
+  std::vector<uint8_t>        select_;  ///< 批量计算过滤条件的结果
 };
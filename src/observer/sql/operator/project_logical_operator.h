@@ -53,10 +53,23 @@ public:
   {
     return select_exprs_;
   }
+
+  /**
+   * @brief 最多输出的行数，-1 表示没有限制
+   */
+  void set_limit(int limit)
+  {
+    limit_ = limit;
+  }
+  int limit() const
+  {
+    return limit_;
+  }
 private:
   //! 投影映射的字段名称
   //! 并不是所有的select都会查看表字段，也可能是常量数字、字符串，
   //! 或者是执行某个函数。所以这里应该是表达式Expression。
   //! 不过现在简单处理，就使用字段来描述
   std::vector<Expression*> select_exprs_;
+  int limit_ = -1;
 };
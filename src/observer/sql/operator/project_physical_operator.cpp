@@ -30,15 +30,50 @@ RC ProjectPhysicalOperator::open(Trx *trx)
     return rc;
   }
 
+  output_num_ = 0;
   return RC::SUCCESS;
 }
 
 RC ProjectPhysicalOperator::next()
 {
-  if (children_.empty()) {
+  if (children_.empty() || (limit_ >= 0 && output_num_ >= limit_)) {
+    return RC::RECORD_EOF;
+  }
+
+  RC rc = children_[0]->next();
+  if (rc == RC::SUCCESS) {
+    output_num_++;
+  }
+  return rc;
+}
+
+RC ProjectPhysicalOperator::next(Chunk &chunk)
+{
+  if (children_.empty() || (limit_ >= 0 && output_num_ >= limit_)) {
     return RC::RECORD_EOF;
   }
-  return children_[0]->next();
+
+  RC rc = children_[0]->next(child_chunk_);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+  if (limit_ >= 0 && child_chunk_.rows() > limit_ - output_num_) {
+    child_chunk_.set_rows(limit_ - output_num_);
+  }
+  output_num_ += child_chunk_.rows();
+
+  chunk.reset();
+  for (int i = 0; i < tuple_.cell_num(); i++) {
+    const TupleCellSpec &spec  = tuple_.cell_spec_at(i);
+    const int            index = child_chunk_.column_index(spec);
+    if (index < 0) {
+      LOG_WARN("no such column in chunk. table=%s, field=%s, alias=%s", spec.table_name(), spec.field_name(), spec.alias());
+      return RC::NOTFOUND;
+    }
+    chunk.add_column(child_chunk_.column_ptr(index), spec);
+  }
+  chunk.set_rows(child_chunk_.rows());
+  return rc;
 }
 
 RC ProjectPhysicalOperator::close()
@@ -34,6 +34,12 @@ public:
   }
   void add_projection(const Table *table, const FieldMeta *field);
   void add_projection(const AggregationExpr *&aggr_expr);
+
+  /**
+   * @brief 最多输出 limit 行，-1 表示没有限制
+   */
+  void set_limit(int limit) { limit_ = limit; }
+
   PhysicalOperatorType type() const override
   {
     return PhysicalOperatorType::PROJECT;
@@ -50,6 +56,15 @@ public:
 
   Tuple *current_tuple() override;
 
+  /**
+   * @brief 批量投影，直接引用子算子返回的列，不复制数据
+   */
+  RC next(Chunk &chunk) override;
+  bool support_chunk() const override { return !children_.empty() && children_[0]->support_chunk(); }
+
 private:
   ProjectTuple tuple_;
+  Chunk        child_chunk_;  ///< 批量执行时子算子返回的数据
+  int          limit_      = -1;
+  int          output_num_ = 0;  ///< 已经输出的行数
 };
@@ -0,0 +1,101 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <algorithm>
+
+#include "sql/operator/sort_key.h"
+
+using namespace std;
+
+static void append_uint32(uint32_t value, string &key)
+{
+  key.push_back(static_cast<char>(value >> 24));
+  key.push_back(static_cast<char>(value >> 16));
+  key.push_back(static_cast<char>(value >> 8));
+  key.push_back(static_cast<char>(value));
+}
+
+void SortKey::append(const Value &value, bool desc, string &key)
+{
+  const size_t begin = key.size();
+  if (value.attr_type() == NULLS) {
+    key.push_back(0);
+  } else {
+    key.push_back(1);
+    switch (value.attr_type()) {
+      case INTS: {
+        append_uint32(static_cast<uint32_t>(value.get_int()) ^ 0x80000000U, key);
+      } break;
+      case DATES: {
+        // 日期按照无符号整数比较
+        uint32_t date = 0;
+        memcpy(&date, value.data(), sizeof(date));
+        append_uint32(date, key);
+      } break;
+      case FLOATS: {
+        float data = value.get_float();
+        if (data == 0) {
+          data = 0;  // -0 和 0 相等
+        }
+        uint32_t bits = 0;
+        memcpy(&bits, &data, sizeof(bits));
+        append_uint32((bits & 0x80000000U) ? ~bits : (bits | 0x80000000U), key);
+      } break;
+      case BOOLEANS: {
+        key.push_back(value.get_boolean() ? 1 : 0);
+      } break;
+      case CHARS: {
+        const char *data = value.data();
+        const int   len  = value.length();
+        for (int i = 0; i < len; i++) {
+          key.push_back(data[i]);
+          if (data[i] == 0) {
+            key.push_back(static_cast<char>(0xFF));
+          }
+        }
+        key.push_back(0);
+        key.push_back(0);
+      } break;
+      default: {
+      } break;
+    }
+  }
+
+  if (desc) {
+    for (size_t i = begin; i < key.size(); i++) {
+      key[i] = static_cast<char>(~key[i]);
+    }
+  }
+}
+
+int SortKey::compare(const char *left, size_t left_len, const char *right, size_t right_len)
+{
+  const int result = memcmp(left, right, std::min(left_len, right_len));
+  if (result != 0) {
+    return result;
+  }
+  if (left_len == right_len) {
+    return 0;
+  }
+  return left_len < right_len ? -1 : 1;
+}
+
+uint64_t SortKey::prefix(const char *key, size_t len)
+{
+  uint64_t result = 0;
+  for (size_t i = 0; i < sizeof(result); i++) {
+    result <<= 8;
+    if (i < len) {
+      result |= static_cast<unsigned char>(key[i]);
+    }
+  }
+  return result;
+}
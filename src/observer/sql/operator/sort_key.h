@@ -0,0 +1,44 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#include "sql/parser/value.h"
+
+/**
+ * @brief 排序键的编码
+ * @ingroup PhysicalOperator
+ * @details 把多个排序列的值依次编码成一段字节，两行比较大小只需要 memcmp 比较编码后的字节，
+ * 结果与按照排序列逐个调用 Value::compare 一致。
+ * 每一列先写一个字节区分是否为 NULL，NULL 最小；整数、日期按照大端写入，有符号数翻转符号位；
+ * 浮点数按照 IEEE 754 的位模式转换成无符号数；字符串中的 0 转义成 0x00 0xFF，以 0x00 0x00 结尾，
+ * 这样短的字符串排在以它为前缀的字符串前面。降序的列把编码的每个字节取反。
+ */
+class SortKey
+{
+public:
+  /**
+   * @brief 把一列的值编码后追加到排序键的后面
+   * @param desc 是否降序
+   */
+  static void append(const Value &value, bool desc, std::string &key);
+
+  static int compare(const char *left, size_t left_len, const char *right, size_t right_len);
+
+  /**
+   * @brief 排序键的前8个字节按照大端组成的整数，不够8个字节时补0
+   * @details 比较两个前缀整数与比较这8个字节的结果一致，前缀不同时不需要再访问排序键
+   */
+  static uint64_t prefix(const char *key, size_t len);
+};
@@ -0,0 +1,261 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <filesystem>
+
+#include "sql/operator/spill_file.h"
+#include "common/io/io.h"
+#include "common/log/log.h"
+
+using namespace std;
+
+SpillFile::SpillFile(SpillStats *stats) : stats_(stats) {}
+
+SpillFile::~SpillFile()
+{
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+RC SpillFile::open()
+{
+  error_code ec;
+  string     path = filesystem::temp_directory_path(ec).string();
+  if (ec) {
+    path = "/tmp";
+  }
+  path += "/miniob_spill_XXXXXX";
+
+  fd_ = ::mkstemp(path.data());
+  if (fd_ < 0) {
+    LOG_ERROR("failed to create spill file. path=%s, errno=%s", path.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+  ::unlink(path.c_str());
+
+  buffer_.reset(new char[BUFFER_SIZE]);
+  buffer_pos_  = 0;
+  buffer_size_ = 0;
+  if (stats_ != nullptr) {
+    stats_->file_num++;
+  }
+  return RC::SUCCESS;
+}
+
+RC SpillFile::write(const void *data, int len)
+{
+  const char *src = static_cast<const char *>(data);
+  while (len > 0) {
+    if (buffer_pos_ == BUFFER_SIZE) {
+      RC rc = flush();
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+    }
+
+    const int n = min(len, BUFFER_SIZE - buffer_pos_);
+    memcpy(buffer_.get() + buffer_pos_, src, n);
+    buffer_pos_ += n;
+    src += n;
+    len -= n;
+  }
+  return RC::SUCCESS;
+}
+
+RC SpillFile::flush()
+{
+  if (buffer_pos_ == 0) {
+    return RC::SUCCESS;
+  }
+
+  int ret = common::writen(fd_, buffer_.get(), buffer_pos_);
+  if (ret != 0) {
+    LOG_ERROR("failed to write spill file. fd=%d, errno=%s", fd_, strerror(ret));
+    return RC::IOERR_WRITE;
+  }
+
+  size_ += buffer_pos_;
+  if (stats_ != nullptr) {
+    stats_->bytes_written += buffer_pos_;
+  }
+  buffer_pos_ = 0;
+  return RC::SUCCESS;
+}
+
+RC SpillFile::rewind()
+{
+  RC rc = flush();
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  if (::lseek(fd_, 0, SEEK_SET) < 0) {
+    LOG_ERROR("failed to seek spill file. fd=%d, errno=%s", fd_, strerror(errno));
+    return RC::IOERR_SEEK;
+  }
+  buffer_pos_  = 0;
+  buffer_size_ = 0;
+  return RC::SUCCESS;
+}
+
+RC SpillFile::fill()
+{
+  ssize_t n = 0;
+  do {
+    n = ::read(fd_, buffer_.get(), BUFFER_SIZE);
+  } while (n < 0 && errno == EINTR);
+
+  if (n < 0) {
+    LOG_ERROR("failed to read spill file. fd=%d, errno=%s", fd_, strerror(errno));
+    return RC::IOERR_READ;
+  }
+  if (n == 0) {
+    return RC::RECORD_EOF;
+  }
+
+  if (stats_ != nullptr) {
+    stats_->bytes_read += n;
+  }
+  buffer_pos_  = 0;
+  buffer_size_ = static_cast<int>(n);
+  return RC::SUCCESS;
+}
+
+RC SpillFile::read(void *data, int len)
+{
+  char *dst   = static_cast<char *>(data);
+  bool  first = true;
+  while (len > 0) {
+    if (buffer_pos_ == buffer_size_) {
+      RC rc = fill();
+      if (rc == RC::RECORD_EOF && !first) {
+        LOG_ERROR("spill file is truncated. fd=%d", fd_);
+        return RC::IOERR_READ;
+      }
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+    }
+
+    const int n = min(len, buffer_size_ - buffer_pos_);
+    memcpy(dst, buffer_.get() + buffer_pos_, n);
+    buffer_pos_ += n;
+    dst += n;
+    len -= n;
+    first = false;
+  }
+  return RC::SUCCESS;
+}
+
+RC SpillFile::write_values(const vector<Value> &values)
+{
+  const uint32_t value_num = static_cast<uint32_t>(values.size());
+  RC             rc        = write(&value_num, sizeof(value_num));
+  for (size_t i = 0; rc == RC::SUCCESS && i < values.size(); i++) {
+    const Value  &value = values[i];
+    const uint8_t type  = static_cast<uint8_t>(value.attr_type());
+    rc                  = write(&type, sizeof(type));
+    if (rc != RC::SUCCESS) {
+      break;
+    }
+
+    switch (value.attr_type()) {
+      case CHARS: {
+        const uint32_t len = static_cast<uint32_t>(value.length());
+        rc                 = write(&len, sizeof(len));
+        if (rc == RC::SUCCESS) {
+          rc = write(value.data(), len);
+        }
+      } break;
+      case INTS:
+      case FLOATS:
+      case DATES: {
+        rc = write(value.data(), 4);
+      } break;
+      case BOOLEANS: {
+        const int data = value.get_boolean() ? 1 : 0;
+        rc             = write(&data, sizeof(data));
+      } break;
+      case NULLS: {
+      } break;
+      default: {
+        LOG_WARN("unsupported value type in spill file. type=%d", value.attr_type());
+        rc = RC::INTERNAL;
+      } break;
+    }
+  }
+
+  if (rc == RC::SUCCESS) {
+    row_num_++;
+  }
+  return rc;
+}
+
+RC SpillFile::read_values(vector<Value> &values)
+{
+  uint32_t value_num = 0;
+  RC       rc        = read(&value_num, sizeof(value_num));
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  values.resize(value_num);
+  for (uint32_t i = 0; i < value_num; i++) {
+    uint8_t type = 0;
+    rc           = read(&type, sizeof(type));
+    if (rc != RC::SUCCESS) {
+      return rc == RC::RECORD_EOF ? RC::IOERR_READ : rc;
+    }
+
+    Value &value = values[i];
+    switch (static_cast<AttrType>(type)) {
+      case CHARS: {
+        uint32_t len = 0;
+        rc           = read(&len, sizeof(len));
+        if (rc == RC::SUCCESS) {
+          string_buffer_.resize(len);
+          rc = read(string_buffer_.data(), len);
+        }
+        if (rc == RC::SUCCESS) {
+          value.set_string(string_buffer_.c_str(), len);
+        }
+      } break;
+      case INTS:
+      case FLOATS:
+      case DATES:
+      case BOOLEANS: {
+        char data[4];
+        rc = read(data, sizeof(data));
+        if (rc == RC::SUCCESS) {
+          value.set_type(static_cast<AttrType>(type));
+          value.set_data(data, sizeof(data));
+        }
+      } break;
+      case NULLS: {
+        value = Value(NULLS);
+      } break;
+      default: {
+        LOG_ERROR("invalid value type in spill file. type=%d", type);
+        rc = RC::INTERNAL;
+      } break;
+    }
+
+    if (rc != RC::SUCCESS) {
+      return rc == RC::RECORD_EOF ? RC::IOERR_READ : rc;
+    }
+  }
+  return RC::SUCCESS;
+}
@@ -0,0 +1,102 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/rc.h"
+#include "sql/parser/value.h"
+
+/**
+ * @brief 溢出文件的读写统计
+ * @ingroup PhysicalOperator
+ * @details 一个算子的多个溢出文件共用一个统计，算子关闭时输出
+ */
+struct SpillStats
+{
+  int     file_num      = 0;
+  int64_t bytes_written = 0;
+  int64_t bytes_read    = 0;
+};
+
+/**
+ * @brief 算子内存不够时用来暂存数据的临时文件
+ * @ingroup PhysicalOperator
+ * @details 文件创建后立即删除目录项，关闭描述符之后空间自动回收，进程异常退出也不会留下垃圾文件。
+ * 先顺序写入，调用 rewind 之后再从头顺序读取，读写都经过缓冲区，每次系统调用读写一整块数据。
+ * 以行为单位读写时，一行是若干个 Value
+ */
+class SpillFile
+{
+public:
+  explicit SpillFile(SpillStats *stats = nullptr);
+  ~SpillFile();
+
+  SpillFile(const SpillFile &)            = delete;
+  SpillFile &operator=(const SpillFile &) = delete;
+
+  /**
+   * @brief 在临时目录中创建文件
+   */
+  RC open();
+
+  RC write(const void *data, int len);
+
+  /**
+   * @brief 读取指定长度的数据
+   * @return 已经读完时返回 RECORD_EOF，剩余的数据不够时返回 IOERR_READ
+   */
+  RC read(void *data, int len);
+
+  /**
+   * @brief 把缓冲区中的数据写到文件中
+   */
+  RC flush();
+
+  /**
+   * @brief 写入完成，之后从头开始读取
+   */
+  RC rewind();
+
+  /**
+   * @brief 写入一行
+   */
+  RC write_values(const std::vector<Value> &values);
+
+  /**
+   * @brief 读取一行
+   * @return 已经读完时返回 RECORD_EOF
+   */
+  RC read_values(std::vector<Value> &values);
+
+  int64_t row_num() const { return row_num_; }
+  int64_t size() const { return size_; }
+
+private:
+  RC fill();
+
+private:
+  static constexpr int BUFFER_SIZE = 64 * 1024;
+
+  int         fd_ = -1;
+  SpillStats *stats_ = nullptr;
+
+  std::unique_ptr<char[]> buffer_;
+  int                     buffer_pos_  = 0;  ///< 写入时是缓冲区中数据的长度，读取时是下一个要读的位置
+  int                     buffer_size_ = 0;  ///< 读取时缓冲区中数据的长度
+
+  int64_t     row_num_ = 0;
+  int64_t     size_    = 0;
+  std::string string_buffer_;
+};
@@ -12,31 +12,95 @@ See the Mulan PSL v2 for more details. */
 // Created by WangYunlai on 2021/6/9.
 //
 
+#include <string.h>
+#include <algorithm>
+
 #include "sql/operator/table_scan_physical_operator.h"
 #include "storage/table/table.h"
+#include "storage/trx/trx.h"
 #include "event/sql_debug.h"
 
 using namespace std;
 
+void TableScanPhysicalOperator::set_projection(const std::vector<Field> &fields)
+{
+  projected_ = true;
+  projection_.clear();
+  for (const Field &field : fields) {
+    projection_.push_back(field.meta());
+  }
+}
+
 RC TableScanPhysicalOperator::open(Trx *trx)
 {
-  RC rc = table_->get_record_scanner(record_scanner_, trx, readonly_);
+  trx_ = trx;
+  scanned_page_num_ = 0;
+  pruned_page_num_  = 0;
+  record_scanner_.set_zone_filters(zone_filters_);
+
+  if (morsel_queue_ != nullptr) {
+    // 领取到页面时再打开，先让扫描器是空的
+    record_scanner_.set_page_range(0, 0);
+  }
+  RC rc = open_scanner();
   if (rc == RC::SUCCESS) {
     tuple_.set_schema(table_, table_->table_meta().field_metas());
   }
-  trx_ = trx;
+
+  chunk_fields_.clear();
+  const TableMeta              &table_meta  = table_->table_meta();
+  const std::vector<FieldMeta> &field_metas = *table_meta.field_metas();
+  if (projected_) {
+    for (const FieldMeta *meta : projection_) {
+      // COUNT(*) 的字段不在表中
+      const FieldMeta *field = table_meta.field(meta->name());
+      if (field == nullptr) {
+        continue;
+      }
+      const int index = static_cast<int>(field - field_metas.data());
+      if (std::find(chunk_fields_.begin(), chunk_fields_.end(), index) == chunk_fields_.end()) {
+        chunk_fields_.push_back(index);
+      }
+    }
+  } else {
+    for (int i = table_meta.sys_field_num(); i < static_cast<int>(field_metas.size()); i++) {
+      chunk_fields_.push_back(i);
+    }
+  }
   return rc;
 }
 
-RC TableScanPhysicalOperator::next()
+RC TableScanPhysicalOperator::open_scanner()
+{
+  return projected_ ? table_->get_record_scanner(record_scanner_, trx_, readonly_, projection_)
+                    : table_->get_record_scanner(record_scanner_, trx_, readonly_);
+}
+
+RC TableScanPhysicalOperator::check_next()
 {
-  if (!record_scanner_.has_next()) {
-    return RC::RECORD_EOF;
+  while (!record_scanner_.has_next()) {
+    PageNum begin_page = 0;
+    PageNum end_page   = 0;
+    if (morsel_queue_ == nullptr || !morsel_queue_->next(begin_page, end_page)) {
+      return RC::RECORD_EOF;
+    }
+
+    scanned_page_num_ += record_scanner_.scanned_page_num();
+    pruned_page_num_ += record_scanner_.pruned_page_num();
+    record_scanner_.set_page_range(begin_page, end_page);
+    RC rc = open_scanner();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
   }
+  return RC::SUCCESS;
+}
 
-  RC rc = RC::SUCCESS;
+RC TableScanPhysicalOperator::next()
+{
+  RC   rc            = RC::SUCCESS;
   bool filter_result = false;
-  while (record_scanner_.has_next()) {
+  while (RC::SUCCESS == (rc = check_next())) {
     rc = record_scanner_.next(current_record_);
     if (rc != RC::SUCCESS) {
       return rc;
@@ -49,18 +113,119 @@ RC TableScanPhysicalOperator::next()
     }
 
     if (filter_result) {
-      sql_debug("get a tuple: %s", tuple_.to_string().c_str());
+      if (sql_debug_on()) {
+        sql_debug("get a tuple: %s", tuple_.to_string().c_str());
+      }
       break;
     } else {
-      sql_debug("a tuple is filtered: %s", tuple_.to_string().c_str());
+      if (sql_debug_on()) {
+        sql_debug("a tuple is filtered: %s", tuple_.to_string().c_str());
+      }
+      if (!readonly_ && trx_ != nullptr) {
+        // 修改数据时访问记录会加锁，被过滤掉的记录不需要再锁着
+        trx_->skip_record(table_, current_record_);
+      }
       rc = RC::RECORD_EOF;
     }
   }
   return rc;
 }
 
+RC TableScanPhysicalOperator::next(Chunk &chunk)
+{
+  if (!readonly_) {
+    LOG_WARN("table scan for update can not run in batch mode. table=%s", table_->name());
+    return RC::UNIMPLENMENT;
+  }
+
+  const std::vector<FieldMeta> &field_metas = *table_->table_meta().field_metas();
+  if (chunk.column_num() == 0) {
+    for (int index : chunk_fields_) {
+      const FieldMeta &field = field_metas[index];
+      chunk.add_column(std::make_shared<Column>(field.value_type(), chunk.capacity()),
+                       TupleCellSpec(table_->name(), field.name(), field.name()));
+    }
+  }
+
+  RC rc = RC::SUCCESS;
+  chunk.reset_data();
+  while (chunk.rows() == 0) {
+    rc = check_next();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+
+    int rows = 0;
+    while (rows < chunk.capacity() && record_scanner_.has_next()) {
+      rc = record_scanner_.next(current_record_);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      rc = append_record(chunk, current_record_);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+      rows++;
+    }
+    chunk.set_rows(rows);
+
+    rc = filter(chunk);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+  return rc;
+}
+
+RC TableScanPhysicalOperator::append_record(Chunk &chunk, const Record &record)
+{
+  const TableMeta              &table_meta  = table_->table_meta();
+  const std::vector<FieldMeta> &field_metas = *table_meta.field_metas();
+  const char                   *data        = record.data();
+  for (size_t i = 0; i < chunk_fields_.size(); i++) {
+    const int        index  = chunk_fields_[i];
+    const FieldMeta &field  = field_metas[index];
+    Column          &column = chunk.column(static_cast<int>(i));
+    if (table_meta.is_null(data, index)) {
+      column.append_null();
+      continue;
+    }
+
+    // 与 RowTuple::cell_at 读取字段的方式一致
+    switch (field.type()) {
+      case CHARS: {
+        const char *str = data + field.offset();
+        column.append_string(str, static_cast<int>(strnlen(str, field.len())));
+      } break;
+      case VARCHARS: {
+        VarcharRef ref;
+        memcpy(&ref, data + field.offset(), sizeof(ref));
+        column.append_string(data + ref.offset, ref.len);
+      } break;
+      case TEXTS: {
+        TextRef     ref;
+        std::string text;
+        memcpy(&ref, data + field.offset(), sizeof(ref));
+        RC rc = table_->read_text(ref, text);
+        if (rc != RC::SUCCESS) {
+          LOG_WARN("failed to read text. table=%s, field=%s, rc=%s", table_->name(), field.name(), strrc(rc));
+          return rc;
+        }
+        column.append_string(text.c_str(), static_cast<int>(text.size()));
+      } break;
+      default: {
+        column.append_fixed(data + field.offset());
+      } break;
+    }
+  }
+  return RC::SUCCESS;
+}
+
 RC TableScanPhysicalOperator::close()
 {
+  sql_debug("scan table %s: scanned %d pages, pruned %d pages by zone map",
+            table_->name(), scanned_page_num_ + record_scanner_.scanned_page_num(),
+            pruned_page_num_ + record_scanner_.pruned_page_num());
   return record_scanner_.close_scan();
 }
 
@@ -72,12 +237,96 @@ Tuple *TableScanPhysicalOperator::current_tuple()
 
 string TableScanPhysicalOperator::param() const
 {
-  return table_->name();
+  if (zone_filters_.empty()) {
+    return table_->name();
+  }
+
+  // 只根据内存中的区间信息估算，不读取页面
+  ZoneMap &zone_map = table_->record_handler()->zone_map();
+  return string(table_->name()) + " ZONE_MAP(pages=" +
+         to_string(table_->data_buffer_pool()->allocated_page_num() - 1) +
+         ", zoned=" + to_string(zone_map.zoned_page_num()) +
+         ", prunable=" + to_string(zone_map.prunable_page_num(zone_filters_)) + ")";
 }
 
 void TableScanPhysicalOperator::set_predicates(vector<unique_ptr<Expression>> &&exprs)
 {
   predicates_ = std::move(exprs);
+
+  zone_filters_.clear();
+  for (unique_ptr<Expression> &expr : predicates_) {
+    collect_zone_filters(expr.get());
+  }
+}
+
+void TableScanPhysicalOperator::collect_zone_filters(Expression *expr)
+{
+  if (expr->type() == ExprType::CONJUNCTION) {
+    ConjunctionExpr *conjunction_expr = static_cast<ConjunctionExpr *>(expr);
+    if (conjunction_expr->conjunction_type() == ConjunctionExpr::Type::AND) {
+      for (unique_ptr<Expression> &child : conjunction_expr->children()) {
+        collect_zone_filters(child.get());
+      }
+    }
+    return;
+  }
+
+  if (expr->type() != ExprType::COMPARISON) {
+    return;
+  }
+
+  ComparisonExpr *comparison_expr = static_cast<ComparisonExpr *>(expr);
+  Expression     *left            = comparison_expr->left().get();
+  Expression     *right           = comparison_expr->right().get();
+  CompOp          op              = comparison_expr->comp();
+  if (left->type() == ExprType::VALUE && right->type() == ExprType::FIELD) {
+    // 常量在左边时交换两边，比较方向也要反过来
+    switch (op) {
+      case EQUAL_TO:
+      case NOT_EQUAL: break;
+      case LESS_THAN: op = GREAT_THAN; break;
+      case LESS_EQUAL: op = GREAT_EQUAL; break;
+      case GREAT_THAN: op = LESS_THAN; break;
+      case GREAT_EQUAL: op = LESS_EQUAL; break;
+      default: return;
+    }
+    std::swap(left, right);
+  }
+  if (left->type() != ExprType::FIELD || right->type() != ExprType::VALUE) {
+    return;
+  }
+
+  const Field &field = static_cast<FieldExpr *>(left)->field();
+  if (field.table() != table_) {
+    return;
+  }
+
+  const std::vector<FieldMeta> &field_metas = *table_->table_meta().field_metas();
+  for (size_t i = 0; i < field_metas.size(); i++) {
+    if (0 == strcmp(field_metas[i].name(), field.field_name())) {
+      if (table_->record_handler()->zone_map().has_column(static_cast<int>(i))) {
+        zone_filters_.push_back(ZoneFilter{static_cast<int>(i), op, static_cast<ValueExpr *>(right)->get_value()});
+      }
+      break;
+    }
+  }
+}
+
+RC TableScanPhysicalOperator::filter(Chunk &chunk)
+{
+  // 每个条件过滤之后再计算下一个，后面的条件只需要处理剩下的行
+  for (unique_ptr<Expression> &expr : predicates_) {
+    if (chunk.rows() == 0) {
+      break;
+    }
+
+    RC rc = expr->eval(chunk, select_);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    chunk.filter(select_);
+  }
+  return RC::SUCCESS;
 }
 
 RC TableScanPhysicalOperator::filter(RowTuple &tuple, bool &result)
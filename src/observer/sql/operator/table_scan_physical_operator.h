@@ -14,7 +14,10 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <memory>
+
 #include "sql/operator/physical_operator.h"
+#include "sql/operator/morsel_queue.h"
 #include "storage/record/record_manager.h"
 #include "common/rc.h"
 
@@ -46,10 +49,48 @@ public:
 
   Tuple *current_tuple() override;
 
+  /**
+   * @brief 批量扫描，每次把一批记录的字段复制到 chunk 的各个列中，再对整批数据计算过滤条件
+   * @details 只支持只读的扫描。输出的列是 set_projection 设置的字段，没有设置时是所有的用户字段
+   */
+  RC next(Chunk &chunk) override;
+  bool support_chunk() const override { return readonly_; }
+
   void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
 
+  /**
+   * @brief 设置需要读取的字段，列存的表只读取这些字段
+   * @details 没有设置时读取所有的字段
+   */
+  void set_projection(const std::vector<Field> &fields);
+
+  /**
+   * @brief 并行扫描，不再扫描整个表，而是从 morsel_queue 中一段一段地领取页面扫描
+   * @details 并行执行的每个流水线各有一个扫描算子，共享同一个 MorselQueue，合起来正好扫描整个表一次
+   */
+  void set_morsel_queue(std::shared_ptr<MorselQueue> morsel_queue) { morsel_queue_ = std::move(morsel_queue); }
+
 private:
+  RC open_scanner();
+
+  /**
+   * @brief 还有没有记录，当前的页面扫描完了就领取下一段页面
+   * @return 有记录时返回 SUCCESS，扫描完了返回 RECORD_EOF
+   */
+  RC check_next();
+
   RC filter(RowTuple &tuple, bool &result);
+  RC filter(Chunk &chunk);
+
+  /**
+   * @brief 把一条记录中批量扫描需要的字段追加到 chunk 的列中
+   */
+  RC append_record(Chunk &chunk, const Record &record);
+
+  /**
+   * @brief 从过滤条件中找出可以用来跳过页面的比较条件: 字段 op 常量
+   */
+  void collect_zone_filters(Expression *expr);
 
 private:
   Table *                                  table_ = nullptr;
@@ -59,4 +100,12 @@ private:
   Record                                   current_record_;
   RowTuple                                 tuple_;
   std::vector<std::unique_ptr<Expression>> predicates_; // TODO chang predicate to table tuple filter
+  bool                                     projected_ = false;
+  std::vector<const FieldMeta *>           projection_;
+  std::vector<ZoneFilter>                  zone_filters_;
+  std::vector<int>                         chunk_fields_;  ///< 批量扫描输出的字段在 field_metas 中的下标
+  std::vector<uint8_t>                     select_;        ///< 批量计算过滤条件的结果
+  std::shared_ptr<MorselQueue>             morsel_queue_;
+  int                                      scanned_page_num_ = 0;  ///< 之前领取的各段页面的统计
+  int                                      pruned_page_num_  = 0;
 };
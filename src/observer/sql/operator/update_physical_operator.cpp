@@ -2,13 +2,15 @@
 // Created by NieYang on 2023/10/16.
 //
 
+#include <algorithm>
+#include <vector>
+
 #include "sql/operator/update_physical_operator.h"
 #include "common/log/log.h"
 #include "storage/record/record.h"
 #include "storage/table/table.h"
 #include "storage/trx/trx.h"
 #include "sql/stmt/update_stmt.h"
-#include "common/lang/mutex.h"
 
 RC UpdatePhysicalOperator::open(Trx *trx) 
 { 
@@ -45,22 +47,31 @@ RC UpdatePhysicalOperator::next()
         RowTuple *row_tuple = static_cast<RowTuple *>(tuple);
         // 更新
         Record &record = row_tuple->record();
-        char * data = record.data();
-        const TableMeta table_meta = table_->table_meta();
+        const TableMeta &table_meta = table_->table_meta();
         const FieldMeta * field_meta = table_meta.field(field_.c_str());
-        //上锁
-        common::Mutex lock_;
-        lock_.lock();
-        const char *value_data = value_->data();
-        // 根据待更新字段的偏移更新
-        memmove(data + field_meta->offset(), value_data, (size_t)value_->length());
-        lock_.unlock();
+        // 根据待更新的字段生成新的记录，旧版本的保存由事务来处理
+        std::vector<char> new_data;
+        rc = table_->make_record(record, field_meta, *value_, new_data);
+        if (rc != RC::SUCCESS) {
+            LOG_WARN("failed to make record: %s", strrc(rc));
+            return rc;
+        }
+        rc = trx_->update_record(table_, record, new_data.data());
         if (rc != RC::SUCCESS) {
             LOG_WARN("failed to update record: %s", strrc(rc));
+            // 新记录没有写入，make_record 为它写入的 TEXT 溢出页也要释放
+            std::vector<PageNum> texts;
+            table_->collect_texts(new_data.data(), record.data(), texts);
+            table_->remove_texts(texts);
             return rc;
         }
     }
 
+    // 读取要更新的数据时也可能失败，比如等待行锁时被选为死锁的牺牲者，不能当作已经更新完
+    if (rc != RC::RECORD_EOF) {
+        LOG_WARN("failed to get record to update: %s", strrc(rc));
+        return rc;
+    }
     return RC::RECORD_EOF;
 }
 
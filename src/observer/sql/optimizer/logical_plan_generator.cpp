@@ -126,6 +126,36 @@ RC LogicalPlanGenerator::create_plan(
       }
     }
 
+    // 过滤、连接、分组和排序用到的字段也需要从表中读取，列存的表只读取这些字段
+    auto add_field = [table, &fields](const Field &field) {
+      if (0 == strcmp(field.table_name(), table->name())) {
+        fields.push_back(field);
+      }
+    };
+    auto add_filter_fields = [&add_field](FilterStmt *filter) {
+      if (filter == nullptr) {
+        return;
+      }
+      for (const FilterUnit *filter_unit : filter->filter_units()) {
+        if (filter_unit->left().is_attr) {
+          add_field(filter_unit->left().field);
+        }
+        if (filter_unit->right().is_attr) {
+          add_field(filter_unit->right().field);
+        }
+      }
+    };
+    add_filter_fields(filter_stmt);
+    for (JoinStmt *join_stmt : join_stmts) {
+      add_filter_fields(join_stmt->join_condition());
+    }
+    for (GroupStmt *group_stmt : group_stmts) {
+      add_field(group_stmt->group_unit()->field());
+    }
+    for (OrderStmt *order_stmt : select_stmt->orders()) {
+      add_field(order_stmt->order_unit()->field());
+    }
+
     // 获取表数据的算子
     unique_ptr<LogicalOperator> table_get_oper(new TableGetLogicalOperator(table, fields, true/*readonly*/));
 
@@ -194,9 +224,13 @@ RC LogicalPlanGenerator::create_plan(
 
   // 排序算子
   unique_ptr<LogicalOperator> order_by_oper(!select_stmt->orders().empty()?new OrderLogicalOperator(select_stmt->orders()):nullptr);
+  if (order_by_oper) {
+    static_cast<OrderLogicalOperator *>(order_by_oper.get())->set_limit(select_stmt->limit());
+  }
 
   // 投影算子
   unique_ptr<LogicalOperator> project_oper(new ProjectLogicalOperator(query_exprs));
+  static_cast<ProjectLogicalOperator *>(project_oper.get())->set_limit(select_stmt->limit());
 
   // 连接所有算子，跳过为nullptr的算子
   std::vector<unique_ptr<LogicalOperator>> stack;
@@ -27,6 +27,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/stmt/stmt.h"
 #include "event/sql_event.h"
 #include "event/session_event.h"
+#include "session/session.h"
 
 using namespace std;
 using namespace common;
@@ -65,6 +66,10 @@ RC OptimizeStage::handle_request(SQLStageEvent *sql_event)
     return rc;
   }
 
+  if (sql_event->session_event()->session()->vectorized_execution()) {
+    physical_plan_generator_.vectorize(physical_operator);
+  }
+
   sql_event->set_operator(std::move(physical_operator));
 
   return rc;
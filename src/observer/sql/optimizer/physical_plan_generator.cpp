@@ -12,6 +12,7 @@ See the Mulan PSL v2 for more details. */
 // Created by Wangyunlai on 2022/12/14.
 //
 
+#include <unordered_set>
 #include <utility>
 
 #include "sql/optimizer/physical_plan_generator.h"
@@ -30,6 +31,11 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/explain_physical_operator.h"
 #include "sql/operator/join_logical_operator.h"
 #include "sql/operator/join_physical_operator.h"
+#include "sql/operator/hash_join_physical_operator.h"
+#include "sql/operator/index_join_physical_operator.h"
+#include "sql/operator/merge_join_physical_operator.h"
+#include "sql/operator/parallel_hash_join_physical_operator.h"
+#include "session/session.h"
 #include "sql/operator/calc_logical_operator.h"
 #include "sql/operator/calc_physical_operator.h"
 #include "sql/operator/update_logical_operator.h"
@@ -38,7 +44,12 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/aggr_physical_operator.h" 
 #include "sql/operator/order_logical_operator.h"
 #include "sql/operator/order_physical_operator.h" 
+#include "sql/operator/chunk_to_row_physical_operator.h"
+#include "sql/operator/gather_physical_operator.h"
+#include "sql/operator/morsel_queue.h"
 #include "sql/expr/expression.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/table/table.h"
 #include "common/log/log.h"
 
 using namespace std;
@@ -105,13 +116,14 @@ RC PhysicalPlanGenerator::create_plan(AggregationLogicalOperator &aggr_oper, uni
   vector<unique_ptr<LogicalOperator>> &child_opers = aggr_oper.children();
   ASSERT(child_opers.size() > 0, "聚合算子必须有子物理算子");
 
-  unique_ptr<PhysicalOperator> child_phy_oper;
+  // 可以并行执行时每个流水线分别聚合，最后合并
+  vector<unique_ptr<PhysicalOperator>> pipelines;
 
   RC rc = RC::SUCCESS;
   if (!child_opers.empty()) {
     // 为第一个子逻辑算子创建物理算子
     LogicalOperator *child_oper = child_opers.front().get();
-    rc = create(*child_oper, child_phy_oper);
+    rc = create_pipelines(*child_oper, pipelines);
     if (rc != RC::SUCCESS) {
       LOG_WARN("failed to create child operator. rc=%s", strrc(rc));
       return rc;
@@ -120,7 +132,9 @@ RC PhysicalPlanGenerator::create_plan(AggregationLogicalOperator &aggr_oper, uni
 
   vector<Expression*> &expressions = aggr_oper.select_exprs();
   oper = unique_ptr<PhysicalOperator>(new AggrPhysicalOperator(expressions,aggr_oper.query_fields(),aggr_oper.groups()));
-  oper->add_child(std::move(child_phy_oper));
+  for (unique_ptr<PhysicalOperator> &pipeline : pipelines) {
+    oper->add_child(std::move(pipeline));
+  }
   return rc;
 }
 
@@ -185,6 +199,7 @@ RC PhysicalPlanGenerator::create_plan(TableGetLogicalOperator &table_get_oper, u
   } else {
     auto table_scan_oper = new TableScanPhysicalOperator(table, table_get_oper.readonly());
     table_scan_oper->set_predicates(std::move(predicates));
+    table_scan_oper->set_projection(table_get_oper.fields());
     oper = unique_ptr<PhysicalOperator>(table_scan_oper);
     LOG_TRACE("use table scan");
   }
@@ -199,6 +214,22 @@ RC PhysicalPlanGenerator::create_plan(PredicateLogicalOperator &pred_oper, uniqu
 
   LogicalOperator &child_oper = *children_opers.front();
 
+  vector<unique_ptr<Expression>> &expressions = pred_oper.expressions();
+  ASSERT(expressions.size() == 1, "predicate logical operator's children should be 1");
+
+  if (child_oper.type() == LogicalOperatorType::JOIN) {
+    vector<unique_ptr<PhysicalOperator>> pipelines;
+    RC rc = create_join_pipelines(pred_oper, 1 /*dop*/, pipelines);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to create join operator of predicate operator. rc=%s", strrc(rc));
+      return rc;
+    }
+    oper = std::move(pipelines.front());
+    return rc;
+  }
+
+  unique_ptr<Expression> expression = std::move(expressions.front());
+
   unique_ptr<PhysicalOperator> child_phy_oper;
   RC rc = create(child_oper, child_phy_oper);
   if (rc != RC::SUCCESS) {
@@ -206,25 +237,43 @@ RC PhysicalPlanGenerator::create_plan(PredicateLogicalOperator &pred_oper, uniqu
     return rc;
   }
 
-  vector<unique_ptr<Expression>> &expressions = pred_oper.expressions();
-  ASSERT(expressions.size() == 1, "predicate logical operator's children should be 1");
-
-  unique_ptr<Expression> expression = std::move(expressions.front());
   oper = unique_ptr<PhysicalOperator>(new PredicatePhysicalOperator(std::move(expression)));
   oper->add_child(std::move(child_phy_oper));
   return rc;
 }
 
+static RC create_project_oper(vector<Expression *> &expressions, unique_ptr<ProjectPhysicalOperator> &oper)
+{
+  oper = make_unique<ProjectPhysicalOperator>();
+  for (Expression *&expr : expressions) {
+    switch (expr->type())
+    {
+    case ExprType::FIELD : {
+      const FieldExpr* field_expr = static_cast<FieldExpr*>(expr);
+      oper->add_projection(field_expr->field().table(), field_expr->field().meta());
+    } break;
+    case ExprType::AGGREGATION : {
+      const AggregationExpr* aggr_expr = static_cast<AggregationExpr*>(expr);
+      oper->add_projection(aggr_expr);
+    } break;
+    default: {
+      return RC::UNIMPLENMENT;
+    } break;
+    }
+  }
+  return RC::SUCCESS;
+}
+
 RC PhysicalPlanGenerator::create_plan(ProjectLogicalOperator &project_oper, unique_ptr<PhysicalOperator> &oper)
 {
   vector<unique_ptr<LogicalOperator>> &child_opers = project_oper.children();
 
-  unique_ptr<PhysicalOperator> child_phy_oper;
+  vector<unique_ptr<PhysicalOperator>> pipelines;
 
   RC rc = RC::SUCCESS;
   if (!child_opers.empty()) {
     LogicalOperator *child_oper = child_opers.front().get();
-    rc = create(*child_oper, child_phy_oper);
+    rc = create_pipelines(*child_oper, pipelines);
     if (rc != RC::SUCCESS) {
       LOG_WARN("failed to create project logical operator's child physical operator. rc=%s", strrc(rc));
       return rc;
@@ -232,50 +281,105 @@ RC PhysicalPlanGenerator::create_plan(ProjectLogicalOperator &project_oper, uniq
   }
 
   vector<Expression*> &expressions = project_oper.select_exprs();
-  ProjectPhysicalOperator *project_operator = new ProjectPhysicalOperator;
-  for (Expression *&expr : expressions) {
-    switch (expr->type())
-    {
-    case ExprType::FIELD : {
-      const FieldExpr* field_expr = static_cast<FieldExpr*>(expr);
-      project_operator->add_projection(field_expr->field().table(), field_expr->field().meta());
-    } break;
-    case ExprType::AGGREGATION : {
-      const AggregationExpr* aggr_expr = static_cast<AggregationExpr*>(expr);
-      project_operator->add_projection(aggr_expr);
-    } break;
-    default: {
-      return RC::UNIMPLENMENT;
-    } break;
+  unique_ptr<ProjectPhysicalOperator> project_operator;
+  rc = create_project_oper(expressions, project_operator);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  if (pipelines.size() > 1) {
+    // 每个流水线各自投影，由 Gather 汇总，最多输出 limit 行也由 Gather 控制
+    auto gather_oper = make_unique<GatherPhysicalOperator>();
+    gather_oper->set_limit(project_oper.limit());
+    for (unique_ptr<PhysicalOperator> &pipeline : pipelines) {
+      if (!project_operator) {
+        rc = create_project_oper(expressions, project_operator);
+        if (rc != RC::SUCCESS) {
+          return rc;
+        }
+      }
+      project_operator->add_child(std::move(pipeline));
+      gather_oper->add_child(std::move(project_operator));
     }
+    oper = std::move(gather_oper);
+    LOG_TRACE("create parallel project physical operators");
+    return rc;
   }
 
-  if (child_phy_oper) {
-    project_operator->add_child(std::move(child_phy_oper));
+  project_operator->set_limit(project_oper.limit());
+
+  if (!pipelines.empty()) {
+    project_operator->add_child(std::move(pipelines.front()));
   }
 
-  oper = unique_ptr<PhysicalOperator>(project_operator);
+  oper = std::move(project_operator);
 
   LOG_TRACE("create a project physical operator");
   return rc;
 }
 
+/**
+ * @brief 物理算子的输出是否已经按照这个字段从小到大排列
+ */
+static bool is_ordered_by(PhysicalOperator &oper, const Field &field)
+{
+  PhysicalOperator *current = &oper;
+  while (current->type() == PhysicalOperatorType::PREDICATE && current->children().size() == 1) {
+    current = current->children().front().get();
+  }
+  return current->type() == PhysicalOperatorType::MERGE_JOIN &&
+         static_cast<MergeJoinPhysicalOperator *>(current)->ordered_by(field);
+}
+
 RC PhysicalPlanGenerator::create_plan(OrderLogicalOperator &order_by_oper, std::unique_ptr<PhysicalOperator> &oper) {
   vector<unique_ptr<LogicalOperator>> &child_opers = order_by_oper.children();
+  vector<OrderUnit *>                 &orders      = order_by_oper.orders();
 
   unique_ptr<PhysicalOperator> child_physical_oper;
 
   RC rc = RC::SUCCESS;
   if (!child_opers.empty()) {
     LogicalOperator *child_oper = child_opers.front().get();
-    rc = create(*child_oper, child_physical_oper);
+
+    // 只按照一个字段升序排列时，下面的连接可以考虑直接输出有序的结果
+    LogicalOperator *join_oper = child_oper;
+    if (join_oper->type() == LogicalOperatorType::PREDICATE && join_oper->children().size() == 1) {
+      join_oper = join_oper->children().front().get();
+    }
+    if (orders.size() == 1 && orders.front()->type() == ASC && join_oper->type() == LogicalOperatorType::JOIN) {
+      static_cast<JoinLogicalOperator *>(join_oper)->set_order_field(orders.front()->field());
+    }
+
+    vector<unique_ptr<PhysicalOperator>> pipelines;
+    rc = create_pipelines(*child_oper, pipelines);
     if (rc != RC::SUCCESS) {
       LOG_WARN("failed to create physical operator. rc=%s", strrc(rc));
       return rc;
     }
+
+    if (pipelines.size() > 1) {
+      // 并行扫描的结果汇总之后再排序
+      child_physical_oper.reset(new GatherPhysicalOperator);
+      for (unique_ptr<PhysicalOperator> &pipeline : pipelines) {
+        child_physical_oper->add_child(std::move(pipeline));
+      }
+    } else {
+      child_physical_oper = std::move(pipelines.front());
+    }
+
+    if (orders.size() == 1 && orders.front()->type() == ASC &&
+        is_ordered_by(*child_physical_oper, orders.front()->field())) {
+      LOG_TRACE("order by is satisfied by merge join");
+      oper = std::move(child_physical_oper);
+      return rc;
+    }
   }
 
-  oper = unique_ptr<PhysicalOperator>(new OrderPhysicalOperator(order_by_oper.orders()));
+  Session      *session      = Session::current_session();
+  const int64_t memory_limit =
+      session != nullptr ? session->sort_memory_limit() : Session::DEFAULT_SORT_MEMORY_LIMIT;
+  oper = unique_ptr<PhysicalOperator>(
+      new OrderPhysicalOperator(order_by_oper.orders(), order_by_oper.limit(), memory_limit));
 
   if (child_physical_oper) {
     oper->add_child(std::move(child_physical_oper));
@@ -283,6 +387,139 @@ RC PhysicalPlanGenerator::create_plan(OrderLogicalOperator &order_by_oper, std::
   return rc;
 }
 
+/**
+ * @brief 并行扫描时表最少要有几段页面，太小的表并行执行得不偿失
+ */
+static constexpr int PARALLEL_MIN_MORSELS = 2;
+
+RC PhysicalPlanGenerator::create_pipelines(LogicalOperator &logical_oper, vector<unique_ptr<PhysicalOperator>> &pipelines)
+{
+  Session  *session = Session::current_session();
+  const int dop     = session != nullptr ? session->parallel_degree() : Session::DEFAULT_PARALLEL_DEGREE;
+
+  if (logical_oper.type() == LogicalOperatorType::PREDICATE && logical_oper.children().size() == 1 &&
+      logical_oper.children().front()->type() == LogicalOperatorType::JOIN) {
+    return create_join_pipelines(static_cast<PredicateLogicalOperator &>(logical_oper), dop, pipelines);
+  }
+  return create_scan_pipelines(logical_oper, dop, pipelines);
+}
+
+RC PhysicalPlanGenerator::create_scan_pipelines(
+    LogicalOperator &logical_oper, int dop, vector<unique_ptr<PhysicalOperator>> &pipelines)
+{
+  // 只并行执行 [过滤 <-] 表扫描
+  PredicateLogicalOperator *pred_oper      = nullptr;
+  TableGetLogicalOperator  *table_get_oper = nullptr;
+  if (logical_oper.type() == LogicalOperatorType::TABLE_GET) {
+    table_get_oper = static_cast<TableGetLogicalOperator *>(&logical_oper);
+  } else if (logical_oper.type() == LogicalOperatorType::PREDICATE && logical_oper.children().size() == 1 &&
+             logical_oper.children().front()->type() == LogicalOperatorType::TABLE_GET) {
+    pred_oper      = static_cast<PredicateLogicalOperator *>(&logical_oper);
+    table_get_oper = static_cast<TableGetLogicalOperator *>(logical_oper.children().front().get());
+  }
+
+  const bool parallel = dop > 1 && table_get_oper != nullptr && table_get_oper->readonly() &&
+                        table_get_oper->table()->data_buffer_pool()->page_count() >=
+                            PARALLEL_MIN_MORSELS * MorselQueue::DEFAULT_MORSEL_PAGES;
+
+  // create 会把表达式移动到创建的算子中，先为其它流水线复制一份
+  vector<vector<unique_ptr<Expression>>> scan_predicates;
+  vector<unique_ptr<Expression>>         filters;
+  for (int i = 1; parallel && i < dop; i++) {
+    scan_predicates.emplace_back();
+    for (unique_ptr<Expression> &expr : table_get_oper->predicates()) {
+      scan_predicates.back().push_back(expr->copy());
+    }
+    if (pred_oper != nullptr) {
+      filters.push_back(pred_oper->expressions().front()->copy());
+    }
+  }
+
+  unique_ptr<PhysicalOperator> first_oper;
+  RC rc = create(logical_oper, first_oper);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  // 使用索引时不并行执行
+  PhysicalOperator *scan_oper = first_oper.get();
+  if (pred_oper != nullptr && scan_oper->type() == PhysicalOperatorType::PREDICATE) {
+    scan_oper = scan_oper->children().front().get();
+  }
+  pipelines.push_back(std::move(first_oper));
+  if (!parallel || scan_oper->type() != PhysicalOperatorType::TABLE_SCAN) {
+    return RC::SUCCESS;
+  }
+
+  Table *table        = table_get_oper->table();
+  auto   morsel_queue = make_shared<MorselQueue>(table->data_buffer_pool()->page_count());
+  static_cast<TableScanPhysicalOperator *>(scan_oper)->set_morsel_queue(morsel_queue);
+  for (int i = 0; i < dop - 1; i++) {
+    auto table_scan_oper = make_unique<TableScanPhysicalOperator>(table, true /*readonly*/);
+    table_scan_oper->set_predicates(std::move(scan_predicates[i]));
+    table_scan_oper->set_projection(table_get_oper->fields());
+    table_scan_oper->set_morsel_queue(morsel_queue);
+
+    unique_ptr<PhysicalOperator> pipeline = std::move(table_scan_oper);
+    if (pred_oper != nullptr) {
+      unique_ptr<PhysicalOperator> predicate_oper(new PredicatePhysicalOperator(std::move(filters[i])));
+      predicate_oper->add_child(std::move(pipeline));
+      pipeline = std::move(predicate_oper);
+    }
+    pipelines.push_back(std::move(pipeline));
+  }
+  LOG_TRACE("use parallel table scan. table=%s, dop=%d", table->name(), dop);
+  return RC::SUCCESS;
+}
+
+RC PhysicalPlanGenerator::create_join_pipelines(
+    PredicateLogicalOperator &pred_oper, int dop, vector<unique_ptr<PhysicalOperator>> &pipelines)
+{
+  auto &join_oper = static_cast<JoinLogicalOperator &>(*pred_oper.children().front());
+
+  // 连接上面的等值条件可以作为哈希连接的连接键，剩下的条件还在这里过滤
+  unique_ptr<Expression>         expression = std::move(pred_oper.expressions().front());
+  vector<unique_ptr<Expression>> conditions;
+  if (expression->type() == ExprType::CONJUNCTION &&
+      static_cast<ConjunctionExpr *>(expression.get())->conjunction_type() == ConjunctionExpr::Type::AND) {
+    conditions = std::move(static_cast<ConjunctionExpr *>(expression.get())->children());
+  } else {
+    conditions.emplace_back(std::move(expression));
+  }
+
+  RC rc = create_join_plan(join_oper, conditions, dop, pipelines);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  if (conditions.empty()) {
+    return rc;
+  }
+  if (conditions.size() == 1) {
+    expression = std::move(conditions.front());
+  } else {
+    expression.reset(new ConjunctionExpr(ConjunctionExpr::Type::AND, conditions));
+  }
+
+  // 每个流水线分别过滤，第一个流水线使用原来的表达式
+  for (int i = static_cast<int>(pipelines.size()) - 1; i >= 0; i--) {
+    unique_ptr<Expression>       filter = i == 0 ? std::move(expression) : expression->copy();
+    unique_ptr<PhysicalOperator> predicate_oper(new PredicatePhysicalOperator(std::move(filter)));
+    predicate_oper->add_child(std::move(pipelines[i]));
+    pipelines[i] = std::move(predicate_oper);
+  }
+  return rc;
+}
+
+RC PhysicalPlanGenerator::create_child_pipelines(LogicalOperator &logical_oper,
+    vector<unique_ptr<Expression>> &conditions, int dop, vector<unique_ptr<PhysicalOperator>> &pipelines)
+{
+  if (logical_oper.type() == LogicalOperatorType::JOIN) {
+    return create_join_plan(static_cast<JoinLogicalOperator &>(logical_oper), conditions, dop, pipelines);
+  }
+  return create_scan_pipelines(logical_oper, dop, pipelines);
+}
+
 RC PhysicalPlanGenerator::create_plan(InsertLogicalOperator &insert_oper, unique_ptr<PhysicalOperator> &oper)
 {
   Table *table = insert_oper.table();
@@ -384,6 +621,452 @@ RC PhysicalPlanGenerator::create_plan(JoinLogicalOperator &join_oper, unique_ptr
   return rc;
 }
 
+static void add_field(vector<Field> &fields, const Field &field)
+{
+  auto iter = std::find_if(fields.begin(), fields.end(), [&field](const Field &other) {
+    return 0 == strcmp(field.table_name(), other.table_name()) && 0 == strcmp(field.field_name(), other.field_name());
+  });
+  if (iter == fields.end()) {
+    fields.push_back(field);
+  }
+}
+
+static void collect_tables(LogicalOperator &oper, unordered_set<string> &tables)
+{
+  if (oper.type() == LogicalOperatorType::TABLE_GET) {
+    tables.insert(static_cast<TableGetLogicalOperator &>(oper).table()->name());
+  }
+  for (unique_ptr<LogicalOperator> &child : oper.children()) {
+    collect_tables(*child, tables);
+  }
+}
+
+/**
+ * @brief 收集上层算子可能用到的字段，就是各个表读取的字段
+ */
+static void collect_fields(LogicalOperator &oper, vector<Field> &fields)
+{
+  if (oper.type() == LogicalOperatorType::TABLE_GET) {
+    for (const Field &field : static_cast<TableGetLogicalOperator &>(oper).fields()) {
+      add_field(fields, field);
+    }
+  }
+  for (unique_ptr<LogicalOperator> &child : oper.children()) {
+    collect_fields(*child, fields);
+  }
+}
+
+/**
+ * @brief 估算数据量，用表的页面数表示。连接按照较大的一边估算
+ */
+static int64_t estimate_pages(LogicalOperator &oper)
+{
+  if (oper.type() == LogicalOperatorType::TABLE_GET) {
+    return static_cast<TableGetLogicalOperator &>(oper).table()->data_buffer_pool()->allocated_page_num();
+  }
+
+  int64_t pages = 0;
+  for (unique_ptr<LogicalOperator> &child : oper.children()) {
+    pages = std::max(pages, estimate_pages(*child));
+  }
+  return pages;
+}
+
+/**
+ * @brief 估算输出的行数
+ * @details 表的行数按照页面数和记录长度估算，每个过滤条件按照固定的比例减少。连接按照较大的一边估算
+ */
+static double estimate_rows(LogicalOperator &oper)
+{
+  if (oper.type() == LogicalOperatorType::TABLE_GET) {
+    auto  &table_get_oper = static_cast<TableGetLogicalOperator &>(oper);
+    Table *table          = table_get_oper.table();
+    double rows           = static_cast<double>(table->data_buffer_pool()->allocated_page_num()) * BP_PAGE_DATA_SIZE /
+                  table->table_meta().record_size();
+    for (unique_ptr<Expression> &predicate : table_get_oper.predicates()) {
+      const bool equal = predicate->type() == ExprType::COMPARISON &&
+                         static_cast<ComparisonExpr &>(*predicate).comp() == EQUAL_TO;
+      rows *= equal ? 0.1 : 0.3;
+    }
+    return rows;
+  }
+
+  double rows = 0;
+  for (unique_ptr<LogicalOperator> &child : oper.children()) {
+    rows = std::max(rows, estimate_rows(*child));
+  }
+  return rows;
+}
+
+/**
+ * @brief 是否是只涉及这个表的字段的比较条件
+ */
+static bool is_table_filter(Expression &expr, const char *table_name)
+{
+  if (expr.type() != ExprType::COMPARISON) {
+    return false;
+  }
+
+  auto &comparison_expr = static_cast<ComparisonExpr &>(expr);
+  if (comparison_expr.comp() == NO_OP) {
+    return false;
+  }
+
+  bool has_field = false;
+  for (const Expression *child : {comparison_expr.left().get(), comparison_expr.right().get()}) {
+    if (child->type() == ExprType::FIELD) {
+      if (0 != strcmp(static_cast<const FieldExpr *>(child)->table_name(), table_name)) {
+        return false;
+      }
+      has_field = true;
+    } else if (child->type() != ExprType::VALUE) {
+      return false;
+    }
+  }
+  return has_field;
+}
+
+/**
+ * @brief 连接上面只涉及一个表的过滤条件放到读取这个表的算子中，连接之前就过滤掉
+ * @details 谓词下推只处理直接在表上面的过滤算子，连接上面的在这里处理。
+ * 选择连接算法时估算的行数也会更准确
+ */
+static void push_down_filters(LogicalOperator &oper, vector<unique_ptr<Expression>> &conditions)
+{
+  if (oper.type() != LogicalOperatorType::TABLE_GET) {
+    return;
+  }
+
+  auto                          &table_get_oper = static_cast<TableGetLogicalOperator &>(oper);
+  vector<unique_ptr<Expression>> predicates     = std::move(table_get_oper.predicates());
+  for (auto iter = conditions.begin(); iter != conditions.end();) {
+    if (is_table_filter(**iter, table_get_oper.table()->name())) {
+      predicates.emplace_back(std::move(*iter));
+      iter = conditions.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  table_get_oper.set_predicates(std::move(predicates));
+}
+
+/**
+ * @brief 估算输出的数据量，单位是字节。连接按照较大的一边估算
+ */
+static double estimate_bytes(LogicalOperator &oper)
+{
+  if (oper.type() == LogicalOperatorType::TABLE_GET) {
+    return estimate_rows(oper) * static_cast<TableGetLogicalOperator &>(oper).table()->table_meta().record_size();
+  }
+
+  double bytes = 0;
+  for (unique_ptr<LogicalOperator> &child : oper.children()) {
+    bytes = std::max(bytes, estimate_bytes(*child));
+  }
+  return bytes;
+}
+
+/**
+ * @brief 找到可以按照连接键查找或者按照连接键顺序读取的索引
+ * @details 需要直接读取表，并且连接键上有索引
+ */
+static Index *find_key_index(LogicalOperator &oper, const Field &field)
+{
+  if (oper.type() != LogicalOperatorType::TABLE_GET) {
+    return nullptr;
+  }
+
+  // 变长字段在索引中存放的不是字符串本身
+  if (field.meta()->type() != field.attr_type()) {
+    return nullptr;
+  }
+  return static_cast<TableGetLogicalOperator &>(oper).table()->find_index_by_field(field.field_name());
+}
+
+/**
+ * @brief 看看能不能用索引嵌套循环连接
+ * @details 内表需要直接读取表，并且某个连接键上有索引。查找一次索引只访问几个页面，
+ * 外表的行数比内表的页面数少很多时，比读取整个内表建哈希表要快
+ * @param inner_side 内表是左边(0)还是右边(1)
+ * @param key_index  使用的是第几个连接键
+ */
+static bool choose_index_join(vector<unique_ptr<LogicalOperator>> &child_opers,
+    vector<unique_ptr<Expression>> &left_keys, vector<unique_ptr<Expression>> &right_keys, int &inner_side,
+    size_t &key_index, Index *&index)
+{
+  static constexpr double INDEX_LOOKUPS_PER_PAGE = 8;
+
+  for (int side : {1, 0}) {
+    LogicalOperator &inner_oper = *child_opers[side];
+    if (inner_oper.type() != LogicalOperatorType::TABLE_GET) {
+      continue;
+    }
+
+    const double outer_rows = estimate_rows(*child_opers[1 - side]);
+    if (outer_rows > estimate_pages(inner_oper) * INDEX_LOOKUPS_PER_PAGE) {
+      continue;
+    }
+
+    vector<unique_ptr<Expression>> &keys = side == 0 ? left_keys : right_keys;
+    for (size_t i = 0; i < keys.size(); i++) {
+      index = find_key_index(inner_oper, static_cast<FieldExpr &>(*keys[i]).field());
+      if (index != nullptr) {
+        inner_side = side;
+        key_index  = i;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief 看看能不能用归并连接
+ * @details 两边的连接键上都有索引时，都可以按照索引的顺序读取，归并连接几乎不用内存。
+ * 数据量超过哈希连接的内存限制时，比哈希连接溢出到磁盘要好。
+ * 上层要求按照连接键排序时，只要一边有索引就可以，另一边在连接算子中排序，省掉的是对连接结果的排序
+ * @param order_field 上层要求的顺序，可以是 nullptr
+ * @param indexes     两边按照顺序读取时使用的索引，nullptr 表示这一边需要排序
+ */
+static bool choose_merge_join(vector<unique_ptr<LogicalOperator>> &child_opers,
+    vector<unique_ptr<Expression>> &left_keys, vector<unique_ptr<Expression>> &right_keys, const Field *order_field,
+    int64_t memory_limit, size_t &key_index, Index *indexes[2])
+{
+  for (size_t i = 0; i < left_keys.size(); i++) {
+    bool ordered_by_query = false;
+    for (int side : {0, 1}) {
+      const Field &field = static_cast<FieldExpr &>(*(side == 0 ? left_keys : right_keys)[i]).field();
+      indexes[side]      = find_key_index(*child_opers[side], field);
+      if (order_field != nullptr && 0 == strcmp(order_field->table_name(), field.table_name()) &&
+          0 == strcmp(order_field->field_name(), field.field_name())) {
+        ordered_by_query = true;
+      }
+    }
+
+    bool use_merge = false;
+    if (indexes[0] != nullptr && indexes[1] != nullptr) {
+      const double build_bytes = std::min(estimate_bytes(*child_opers[0]), estimate_bytes(*child_opers[1]));
+      use_merge                = ordered_by_query || build_bytes > memory_limit;
+    } else if (indexes[0] != nullptr || indexes[1] != nullptr) {
+      use_merge = ordered_by_query;
+    }
+
+    if (use_merge) {
+      key_index = i;
+      return true;
+    }
+  }
+
+  indexes[0] = indexes[1] = nullptr;
+  return false;
+}
+
+/**
+ * @brief 条件是左右两边字段的等值比较时，取出两边的字段作为连接键
+ * @details 浮点数比较时有误差，不能按照哈希值比较
+ */
+static bool take_join_key(Expression &condition, const unordered_set<string> &left_tables,
+    const unordered_set<string> &right_tables, vector<unique_ptr<Expression>> &left_keys,
+    vector<unique_ptr<Expression>> &right_keys)
+{
+  if (condition.type() != ExprType::COMPARISON) {
+    return false;
+  }
+
+  auto &comparison_expr = static_cast<ComparisonExpr &>(condition);
+  if (comparison_expr.comp() != EQUAL_TO || comparison_expr.left()->type() != ExprType::FIELD ||
+      comparison_expr.right()->type() != ExprType::FIELD) {
+    return false;
+  }
+
+  auto *left_field  = static_cast<const FieldExpr *>(comparison_expr.left().get());
+  auto *right_field = static_cast<const FieldExpr *>(comparison_expr.right().get());
+  if (left_tables.count(left_field->table_name()) == 0) {
+    std::swap(left_field, right_field);
+  }
+  if (left_tables.count(left_field->table_name()) == 0 || right_tables.count(right_field->table_name()) == 0) {
+    return false;
+  }
+
+  const AttrType type = left_field->value_type();
+  if (type != right_field->value_type() || (type != INTS && type != DATES && type != CHARS && type != BOOLEANS)) {
+    return false;
+  }
+
+  left_keys.emplace_back(new FieldExpr(left_field->field()));
+  right_keys.emplace_back(new FieldExpr(right_field->field()));
+  return true;
+}
+
+RC PhysicalPlanGenerator::create_join_plan(JoinLogicalOperator &join_oper, vector<unique_ptr<Expression>> &conditions,
+    int dop, vector<unique_ptr<PhysicalOperator>> &pipelines)
+{
+  vector<unique_ptr<LogicalOperator>> &child_opers = join_oper.children();
+  if (child_opers.size() != 2) {
+    LOG_WARN("join operator should have 2 children, but have %d", child_opers.size());
+    return RC::INTERNAL;
+  }
+
+  unordered_set<string> left_tables;
+  unordered_set<string> right_tables;
+  collect_tables(*child_opers[0], left_tables);
+  collect_tables(*child_opers[1], right_tables);
+
+  vector<unique_ptr<Expression>> left_keys;
+  vector<unique_ptr<Expression>> right_keys;
+  for (auto iter = conditions.begin(); iter != conditions.end();) {
+    if (take_join_key(**iter, left_tables, right_tables, left_keys, right_keys)) {
+      iter = conditions.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
+  for (unique_ptr<LogicalOperator> &child_oper : child_opers) {
+    push_down_filters(*child_oper, conditions);
+  }
+
+  Session      *session      = Session::current_session();
+  const int64_t memory_limit =
+      session != nullptr ? session->hash_join_memory_limit() : Session::DEFAULT_HASH_JOIN_MEMORY_LIMIT;
+
+  vector<Field> left_fields;
+  vector<Field> right_fields;
+  collect_fields(*child_opers[0], left_fields);
+  collect_fields(*child_opers[1], right_fields);
+  for (size_t i = 0; i < left_keys.size(); i++) {
+    add_field(left_fields, static_cast<FieldExpr &>(*left_keys[i]).field());
+    add_field(right_fields, static_cast<FieldExpr &>(*right_keys[i]).field());
+  }
+
+  unique_ptr<PhysicalOperator> join_physical_oper;
+  int                          inner_side     = -1;
+  size_t                       key_index      = 0;
+  Index                       *index          = nullptr;
+  Index                       *scan_indexes[] = {nullptr, nullptr};  // 按照索引顺序读取的一边，不设置扫描范围
+  if (left_keys.empty()) {
+    join_physical_oper.reset(new NestedLoopJoinPhysicalOperator);
+  } else if (choose_index_join(child_opers, left_keys, right_keys, inner_side, key_index, index)) {
+    vector<unique_ptr<Expression>> &inner_keys = inner_side == 0 ? left_keys : right_keys;
+    vector<unique_ptr<Expression>> &outer_keys = inner_side == 0 ? right_keys : left_keys;
+    join_physical_oper.reset(new IndexNestedLoopJoinPhysicalOperator(
+        std::move(outer_keys[key_index]), std::move(inner_keys[key_index]), inner_side == 0));
+    scan_indexes[inner_side] = index;
+    LOG_TRACE("use index nested loop join");
+  } else if (choose_merge_join(
+                 child_opers, left_keys, right_keys, join_oper.order_field(), memory_limit, key_index, scan_indexes)) {
+    join_physical_oper.reset(new MergeJoinPhysicalOperator(std::move(left_keys[key_index]),
+        std::move(right_keys[key_index]), left_fields, right_fields, scan_indexes[0] == nullptr,
+        scan_indexes[1] == nullptr));
+    LOG_TRACE("use merge join");
+  } else {
+    // 用数据少的一边构建哈希表
+    const bool build_left = estimate_pages(*child_opers[0]) < estimate_pages(*child_opers[1]);
+    if (dop > 1 && estimate_bytes(*child_opers[build_left ? 0 : 1]) <= memory_limit) {
+      return create_hash_join_pipelines(join_oper, conditions, dop, build_left, std::move(left_keys),
+          std::move(right_keys), left_fields, right_fields, memory_limit, pipelines);
+    }
+    join_physical_oper.reset(new HashJoinPhysicalOperator(
+        std::move(left_keys), std::move(right_keys), left_fields, right_fields, build_left, memory_limit));
+    LOG_TRACE("use hash join");
+  }
+
+  // 索引连接和归并连接只用了一个连接键，其它的连接键放回去，在上层的过滤算子中比较
+  for (size_t i = 0; i < left_keys.size(); i++) {
+    if (left_keys[i] != nullptr) {
+      conditions.emplace_back(new ComparisonExpr(EQUAL_TO, std::move(left_keys[i]), std::move(right_keys[i])));
+    }
+  }
+
+  for (int i = 0; i < static_cast<int>(child_opers.size()); i++) {
+    unique_ptr<LogicalOperator> &child_oper = child_opers[i];
+    unique_ptr<PhysicalOperator> child_physical_oper;
+    RC rc = RC::SUCCESS;
+    if (scan_indexes[i] != nullptr) {
+      auto &table_get_oper  = static_cast<TableGetLogicalOperator &>(*child_oper);
+      auto  index_scan_oper = new IndexScanPhysicalOperator(table_get_oper.table(), scan_indexes[i],
+          table_get_oper.readonly(),
+          nullptr /*left_value*/, true /*left_inclusive*/, nullptr /*right_value*/, true /*right_inclusive*/);
+      index_scan_oper->set_predicates(std::move(table_get_oper.predicates()));
+      child_physical_oper.reset(index_scan_oper);
+    } else if (child_oper->type() == LogicalOperatorType::JOIN) {
+      vector<unique_ptr<PhysicalOperator>> child_pipelines;
+      rc = create_join_plan(static_cast<JoinLogicalOperator &>(*child_oper), conditions, 1 /*dop*/, child_pipelines);
+      if (rc == RC::SUCCESS) {
+        child_physical_oper = std::move(child_pipelines.front());
+      }
+    } else {
+      rc = create(*child_oper, child_physical_oper);
+    }
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to create physical child oper. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    join_physical_oper->add_child(std::move(child_physical_oper));
+  }
+
+  pipelines.push_back(std::move(join_physical_oper));
+  return RC::SUCCESS;
+}
+
+RC PhysicalPlanGenerator::create_hash_join_pipelines(JoinLogicalOperator &join_oper,
+    vector<unique_ptr<Expression>> &conditions, int dop, bool build_left, vector<unique_ptr<Expression>> &&left_keys,
+    vector<unique_ptr<Expression>> &&right_keys, const vector<Field> &left_fields, const vector<Field> &right_fields,
+    int64_t memory_limit, vector<unique_ptr<PhysicalOperator>> &pipelines)
+{
+  vector<unique_ptr<LogicalOperator>> &child_opers = join_oper.children();
+  LogicalOperator &build_child = *child_opers[build_left ? 0 : 1];
+  LogicalOperator &probe_child = *child_opers[build_left ? 1 : 0];
+
+  vector<unique_ptr<PhysicalOperator>> probe_pipelines;
+  RC rc = create_child_pipelines(probe_child, conditions, dop, probe_pipelines);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to create probe side of hash join. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // 探测端不能并行执行时使用普通的哈希连接
+  const bool parallel = probe_pipelines.size() > 1;
+  vector<unique_ptr<PhysicalOperator>> build_pipelines;
+  rc = create_child_pipelines(build_child, conditions, parallel ? dop : 1, build_pipelines);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to create build side of hash join. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  if (!parallel) {
+    unique_ptr<PhysicalOperator> join_physical_oper(new HashJoinPhysicalOperator(
+        std::move(left_keys), std::move(right_keys), left_fields, right_fields, build_left, memory_limit));
+    join_physical_oper->add_child(std::move(build_left ? build_pipelines.front() : probe_pipelines.front()));
+    join_physical_oper->add_child(std::move(build_left ? probe_pipelines.front() : build_pipelines.front()));
+    pipelines.push_back(std::move(join_physical_oper));
+    LOG_TRACE("use hash join");
+    return RC::SUCCESS;
+  }
+
+  vector<unique_ptr<Expression>> &probe_keys = build_left ? right_keys : left_keys;
+  auto build = make_shared<ParallelHashJoinBuild>(
+      std::move(build_left ? left_keys : right_keys), build_left ? left_fields : right_fields, memory_limit);
+  for (size_t i = 0; i < probe_pipelines.size(); i++) {
+    vector<unique_ptr<Expression>> keys;
+    for (unique_ptr<Expression> &key : probe_keys) {
+      keys.push_back(key->copy());
+    }
+
+    unique_ptr<PhysicalOperator> join_physical_oper(
+        new ParallelHashJoinPhysicalOperator(std::move(keys), build, build_left));
+    join_physical_oper->add_child(std::move(probe_pipelines[i]));
+    for (size_t j = 0; i == 0 && j < build_pipelines.size(); j++) {
+      join_physical_oper->add_child(std::move(build_pipelines[j]));
+    }
+    pipelines.push_back(std::move(join_physical_oper));
+  }
+  LOG_TRACE("use parallel hash join. probe pipelines=%d, build pipelines=%d",
+            static_cast<int>(probe_pipelines.size()), static_cast<int>(build_pipelines.size()));
+  return RC::SUCCESS;
+}
+
 RC PhysicalPlanGenerator::create_plan(CalcLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper)
 {
   RC rc = RC::SUCCESS;
@@ -392,3 +1075,17 @@ RC PhysicalPlanGenerator::create_plan(CalcLogicalOperator &logical_oper, std::un
   return rc;
 }
 
+void PhysicalPlanGenerator::vectorize(unique_ptr<PhysicalOperator> &oper)
+{
+  if (oper->support_chunk()) {
+    unique_ptr<PhysicalOperator> chunk_to_row_oper(new ChunkToRowPhysicalOperator);
+    chunk_to_row_oper->add_child(std::move(oper));
+    oper = std::move(chunk_to_row_oper);
+    LOG_TRACE("use vectorized execution");
+    return;
+  }
+
+  for (unique_ptr<PhysicalOperator> &child : oper->children()) {
+    vectorize(child);
+  }
+}
@@ -15,10 +15,12 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "common/rc.h"
 #include "sql/operator/physical_operator.h"
 #include "sql/operator/logical_operator.h"
+#include "storage/field/field.h"
 
 class TableGetLogicalOperator;
 class PredicateLogicalOperator;
@@ -46,6 +48,13 @@ public:
 
   RC create(LogicalOperator &logical_operator, std::unique_ptr<PhysicalOperator> &oper);
 
+  /**
+   * @brief 把物理计划中可以批量执行的部分改成批量执行
+   * @details 从上往下找，某个算子和它下面的算子都支持批量执行时，在它上面加一个 ChunkToRow 算子，
+   * 上层的算子仍然按行获取数据
+   */
+  void vectorize(std::unique_ptr<PhysicalOperator> &oper);
+
 private:
   RC create_plan(TableGetLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
   RC create_plan(PredicateLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
@@ -58,4 +67,42 @@ private:
   RC create_plan(UpdateLogicalOperator &update_oper, std::unique_ptr<PhysicalOperator> &oper);
   RC create_plan(AggregationLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
   RC create_plan(OrderLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper);
+
+  /**
+   * @brief 创建可以并行执行的多个流水线
+   * @details 只读的单表扫描(上面可以有一个过滤算子)，会话的并行度大于1并且表足够大时，按照并行度创建多个相同的流水线，
+   * 它们的扫描算子共享一个 MorselQueue，分段领取要扫描的页面，合起来是全部数据。
+   * 连接使用并行哈希连接时每个探测端的流水线也是一个流水线。
+   * 不能并行执行时与 create 一样只创建一个
+   */
+  RC create_pipelines(LogicalOperator &logical_oper, std::vector<std::unique_ptr<PhysicalOperator>> &pipelines);
+  RC create_scan_pipelines(
+      LogicalOperator &logical_oper, int dop, std::vector<std::unique_ptr<PhysicalOperator>> &pipelines);
+
+  /**
+   * @brief 创建过滤算子下面连接的流水线，剩下的过滤条件放到每个流水线中
+   */
+  RC create_join_pipelines(
+      PredicateLogicalOperator &pred_oper, int dop, std::vector<std::unique_ptr<PhysicalOperator>> &pipelines);
+  RC create_child_pipelines(LogicalOperator &logical_oper, std::vector<std::unique_ptr<Expression>> &conditions,
+      int dop, std::vector<std::unique_ptr<PhysicalOperator>> &pipelines);
+
+  /**
+   * @brief 创建连接的物理计划。条件中有左右两边字段的等值比较时，根据索引和估算的数据量
+   * 选择索引嵌套循环连接、归并连接或者哈希连接，否则使用 NestedLoopJoin
+   * @param conditions 连接上面的过滤条件，按照 AND 拆开。用作连接键的条件会从中删除，剩下的由调用者过滤。
+   * 左边还是连接时，剩下的条件继续用于左边的连接
+   * @param dop 大于1时可以使用并行哈希连接，这时每个探测端的流水线创建一个连接算子，否则只创建一个
+   */
+  RC create_join_plan(JoinLogicalOperator &join_oper, std::vector<std::unique_ptr<Expression>> &conditions, int dop,
+      std::vector<std::unique_ptr<PhysicalOperator>> &pipelines);
+
+  /**
+   * @brief 创建哈希连接。探测端可以并行执行时构建端也并行读取，使用 ParallelHashJoinPhysicalOperator
+   */
+  RC create_hash_join_pipelines(JoinLogicalOperator &join_oper, std::vector<std::unique_ptr<Expression>> &conditions,
+      int dop, bool build_left, std::vector<std::unique_ptr<Expression>> &&left_keys,
+      std::vector<std::unique_ptr<Expression>> &&right_keys, const std::vector<Field> &left_fields,
+      const std::vector<Field> &right_fields, int64_t memory_limit,
+      std::vector<std::unique_ptr<PhysicalOperator>> &pipelines);
 };
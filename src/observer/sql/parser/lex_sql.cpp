@@ -385,8 +385,8 @@ static void yynoreturn yy_fatal_error ( const char* msg , yyscan_t yyscanner );
 	yyg->yy_hold_char = *yy_cp; \
 	*yy_cp = '\0'; \
 	yyg->yy_c_buf_p = yy_cp;
-#define YY_NUM_RULES 75
-#define YY_END_OF_BUFFER 76
+#define YY_NUM_RULES 81
+#define YY_END_OF_BUFFER 82
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info
@@ -394,34 +394,38 @@ struct yy_trans_info
 	flex_int32_t yy_verify;
 	flex_int32_t yy_nxt;
 	};
-static const flex_int16_t yy_accept[238] =
+static const flex_int16_t yy_accept[281] =
     {   0,
-        0,    0,    0,    0,   76,   74,    1,    2,   74,   74,
-       74,   57,   58,   69,   67,   59,   68,    6,   70,    3,
-        5,   64,   60,   66,   56,   56,   56,   56,   56,   56,
-       56,   56,   56,   56,   56,   56,   56,   56,   56,   56,
-       56,   56,   56,   56,   56,   75,   63,    0,   72,    0,
-        0,   73,    0,    3,    0,   61,   62,   65,   56,   56,
-       56,   56,   56,   56,   52,   56,   56,   56,   56,   56,
-       56,   56,   56,   56,   56,   56,   56,   56,   45,   56,
-       56,   56,   56,   56,   56,   14,   56,   56,   56,   56,
-       56,   56,   56,   56,   56,   56,   56,    0,    0,    0,
-
-        0,    4,   21,   54,   42,   56,   56,   56,   56,   56,
-       56,   56,   56,   56,   56,   56,   56,   56,   56,   56,
-       56,   56,   56,   56,   56,   31,   56,   56,   39,   40,
-       46,   56,   56,   56,   56,   27,   56,   43,   56,   56,
-       56,   56,   56,   56,    0,    0,    0,    0,   56,   18,
-       32,   56,   56,   56,   36,   34,   56,   55,   10,    7,
-       56,   56,   19,   56,    8,   56,   56,   56,   56,   23,
-       50,   35,   47,   56,   56,   56,   15,   16,   56,   56,
-       56,   56,   56,    0,    0,    0,    0,    0,    0,   28,
-       56,   41,   56,   56,   56,   33,   53,   13,   56,   49,
-
-       56,   56,   51,   56,   56,   11,   56,   56,   56,   20,
-        0,    0,   29,    9,   25,   56,   37,   22,   56,   56,
-       17,   12,   44,   26,   24,   71,   71,    0,   71,   71,
-        0,   38,   56,   56,   48,   30,    0
+        0,    0,    0,    0,   82,   80,    1,    2,   80,   80,
+       80,   63,   64,   75,   73,   65,   74,    6,   76,    3,
+        5,   70,   66,   72,   62,   62,   62,   62,   62,   62,
+       62,   62,   62,   62,   62,   62,   62,   62,   62,   62,
+       62,   62,   62,   62,   62,   81,   69,    0,   78,    0,
+        0,   79,    0,    3,    0,   67,   68,   71,   62,   62,
+       62,   62,   62,   62,   55,   62,   62,   62,   62,   62,
+       62,   62,   62,   62,   62,   62,   62,   62,   48,   62,
+       62,   62,   62,   62,   62,   14,   62,   62,   62,   62,
+       62,   62,   62,   62,   62,   62,   62,    0,    0,    0,
+
+        0,    4,   21,   57,   45,   62,   62,   62,   62,   62,
+       62,   62,   62,   62,   62,   62,   62,   62,   62,   62,
+       62,   62,   62,   62,   62,   31,   62,   62,   42,   43,
+       49,   62,   62,   62,   62,   27,   62,   46,   62,   62,
+       62,   62,   62,   62,    0,    0,    0,    0,   62,   18,
+       32,   62,   62,   62,   39,   34,   62,   58,   10,    7,
+       62,   62,   19,   62,    8,   62,   62,   62,   62,   23,
+       53,   38,   50,   62,   62,   62,   15,   16,   62,   62,
+       62,   62,   62,    0,    0,    0,    0,    0,    0,   28,
+       62,   44,   62,   62,   62,   33,   56,   13,   62,   52,
+
+       62,   62,   54,   62,   62,   11,   62,   62,   62,   20,
+        0,    0,   29,    9,   25,   62,   40,   22,   62,   62,
+       17,   12,   47,   26,   24,   77,   77,    0,   77,   77,
+        0,   41,   62,   62,   51,   30,    0,    0,    0,    0,
+        0,    0,   62,   62,   62,   62,   59,   62,   62,   62,
+       62,   62,   62,   35,   62,   62,   62,   62,   62,   62,
+       37,   36,   62,   62,   62,   62,   62,   62,   62,   62,
+       62,   62,   62,   62,   62,   60,   62,   62,   62,   61
     } ;
 
 static const YY_CHAR yy_ec[256] =
@@ -467,9 +471,9 @@ static const YY_CHAR yy_meta[71] =
         2,    2,    2,    2,    2,    2,    2,    2,    2,    2
     } ;
 
-static const flex_int16_t yy_base[243] =
+static const flex_int16_t yy_base[281] =
     {   0,
-        0,    0,    0,    0,  629,  630,  630,  630,  610,   66,
+        0,  701,    0,    0,  629,  630,  630,  630,  610,   66,
        67,  630,  630,  630,  630,  630,  612,  630,  630,   59,
       630,   57,  630,  608,   62,   63,   64,   65,   71,   68,
        75,   73,  101,  103,  610,  107,  115,  117,  121,  130,
@@ -495,10 +499,13 @@ static const flex_int16_t yy_base[243] =
       551,  563,  523,  477,  469,  516,  467,  448,  548,  522,
       444,  398,  269,  267,  264,  630,  218,  147,  207,  630,
       242,  159,  547,  537,  156,  127,  630,  605,  607,  609,
-      102,   91
+      102,   91,  744,  767,  798,  814,  880,  931,  941,  983,
+     1005, 1039, 1049, 1113, 1153, 1187, 1204, 1222, 1271, 1280,
+     1346, 1346, 1383, 1405, 1439, 1464, 1490, 1515, 1542, 1586,
+     1609, 1634, 1649, 1690, 1703, 1768, 1740, 1761, 1789, 1849
     } ;
 
-static const flex_int16_t yy_def[243] =
+static const flex_int16_t yy_def[281] =
     {   0,
       237,    1,  238,  238,  237,  237,  237,  237,  237,  239,
       240,  237,  237,  237,  237,  237,  237,  237,  237,  237,
@@ -526,18 +533,21 @@ static const flex_int16_t yy_def[243] =
       239,  240,  241,  241,  241,  241,  241,  241,  241,  241,
       241,  241,  241,  241,  241,  237,  239,  239,  240,  237,
       240,  241,  241,  241,  241,  241,    0,  237,  237,  237,
-      237,  237
+      237,  237,   36,   60,   60,   60,   60,   44,   96,   60,
+       60,   60,   60,   60,   26,   42,   60,   60,   60,   60,
+       60,   60,   27,   41,   68,   60,  109,   60,   60,   60,
+       60,   60,   60,   60,   60,   60,   60,   60,   60,   60
     } ;
 
-static const flex_int16_t yy_nxt[701] =
+static const flex_int16_t yy_nxt[1920] =
     {   0,
         6,    7,    8,    9,   10,   11,   12,   13,   14,   15,
        16,   17,   18,   19,   20,   21,   22,   23,   24,   25,
-       26,   27,   28,   29,   30,   31,   32,   33,   34,   35,
-       36,   37,   38,   39,   35,   35,   40,   41,   42,   43,
-       44,   45,   35,   35,   35,   25,   26,   27,   28,   29,
-       30,   31,   32,   33,   34,   35,   36,   37,   38,   39,
-       35,   35,   40,   41,   42,   43,   44,   45,   35,   35,
+      255,  263,   28,   29,   30,   31,   32,   33,   34,   35,
+      243,   37,   38,   39,   35,   35,   40,  264,  256,   43,
+      248,   45,   35,   35,   35,   25,  255,  263,   28,   29,
+       30,   31,   32,   33,   34,   35,  243,   37,   38,   39,
+       35,   35,   40,  264,  256,   43,  248,   45,   35,   35,
        49,   55,   52,   54,   56,   57,   59,   59,   59,   59,
        50,   53,   59,   66,   70,   59,   64,   59,   71,   59,
        67,   55,   59,   54,   61,   49,   77,   68,   74,   62,
@@ -606,11 +616,145 @@ static const flex_int16_t yy_nxt[701] =
       237,  237,  237,  237,  237,  237,  237,  237,  237,  237,
       237,  237,  237,  237,  237,  237,  237,  237,  237,  237,
       237,  237,  237,  237,  237,  237,  237,  237,  237,  237,
-      237,  237,  237,  237,  237,  237,  237,  237,  237,  237
+      237,  237,  237,  237,  237,  237,  237,  237,  237,  237,
 
+        5,    6,    7,    8,    9,   10,   11,   12,   13,   14,
+       15,   16,   17,   18,   19,   20,   21,   22,   23,   24,
+       25,  255,  263,   28,   29,   30,   31,   32,   33,   34,
+       35,  243,   37,   38,   39,   35,   35,   40,  264,  256,
+       43,  248,   45,   35,   35,   35,   25,  255,  263,   28,
+       29,   30,   31,   32,   33,   34,   35,  243,   37,   38,
+       39,   35,   35,   40,  264,  256,   43,  248,   45,   35,
+       35,  244,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,  244,  245,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,  245,  246,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,  246,  247,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,  247,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+      249,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,  249,  250,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,  250,  251,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+      251,  252,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,  252,  253,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,  253,  254,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,  254,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,  257,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,  257,
+      258,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,  258,  259,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,  259,  260,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+      260,  261,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,  261,  262,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,  262,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,  265,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,  265,  266,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,  266,
+      267,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,  267,  268,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,  268,  269,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+      269,  270,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,  270,  271,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,  271,  272,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,  272,  273,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,  273,  274,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,  274,  275,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,  275,  276,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,  276,
+      277,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,  277,  278,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,  278,  279,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+      279,  280,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,  280,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0
     } ;
 
-static const flex_int16_t yy_chk[701] =
+static const flex_int16_t yy_chk[1920] =
     {   0,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
         1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
@@ -687,8 +831,142 @@ static const flex_int16_t yy_chk[701] =
       237,  237,  237,  237,  237,  237,  237,  237,  237,  237,
       237,  237,  237,  237,  237,  237,  237,  237,  237,  237,
       237,  237,  237,  237,  237,  237,  237,  237,  237,  237,
-      237,  237,  237,  237,  237,  237,  237,  237,  237,  237
+      237,  237,  237,  237,  237,  237,  237,  237,  237,  237,
 
+        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
+        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
+        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
+        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
+        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
+        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
+        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
+        2,  243,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,  243,  244,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,  244,  245,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,  245,  246,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,  246,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+      248,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,  248,  249,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,  249,  250,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+      250,  251,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,  251,  252,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,  252,  253,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,  253,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,  255,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,  255,
+      256,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,  256,  257,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,  257,  258,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+      258,  259,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,  259,  260,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,  260,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,  263,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,  263,  264,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,  264,
+      265,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,  265,  266,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,  266,  267,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+      267,  268,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,  268,  269,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,  269,  270,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,  270,  271,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,  271,  272,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,  272,  273,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,  273,  274,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,  274,
+      275,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,  275,  277,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,  277,  278,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+      278,  279,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,  279,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+
+        0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+        0,    0,    0,    0,    0,    0,    0,    0,    0
     } ;
 
 /* The intent behind this definition is that it'll catch
@@ -726,7 +1004,7 @@ date str_to_date(char * s);
 bool is_leap_year(unsigned year);
 
 #define RETURN_TOKEN(token) LOG_DEBUG("%s", #token);return token
-#line 730 "lex_sql.cpp"
+#line 1008 "lex_sql.cpp"
 /* Prevent the need for linking with -lfl */
 #define YY_NO_INPUT 1
 /* 不区分大小写 */
@@ -735,7 +1013,7 @@ bool is_leap_year(unsigned year);
 /* 1. 匹配的规则长的优先 */
 /* 2. 写在最前面的优先 */
 /* yylval 就可以认为是 yacc 中 %union 定义的结构体(union 结构) */
-#line 739 "lex_sql.cpp"
+#line 1017 "lex_sql.cpp"
 
 #define INITIAL 0
 #define STR 1
@@ -1021,7 +1299,7 @@ YY_DECL
 #line 78 "lex_sql.l"
 
 
-#line 1025 "lex_sql.cpp"
+#line 1303 "lex_sql.cpp"
 
 	while ( /*CONSTCOND*/1 )		/* loops until end-of-file is reached */
 		{
@@ -1252,202 +1530,232 @@ RETURN_TOKEN(DATE_T);
 case 35:
 YY_RULE_SETUP
 #line 116 "lex_sql.l"
-RETURN_TOKEN(LOAD);
+RETURN_TOKEN(VARCHAR_T);
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
 #line 117 "lex_sql.l"
-RETURN_TOKEN(DATA);
+RETURN_TOKEN(TEXT_T);
 	YY_BREAK
 case 37:
 YY_RULE_SETUP
 #line 118 "lex_sql.l"
-RETURN_TOKEN(INFILE);
+RETURN_TOKEN(TEXT_T);
 	YY_BREAK
 case 38:
 YY_RULE_SETUP
 #line 119 "lex_sql.l"
-RETURN_TOKEN(EXPLAIN);
+RETURN_TOKEN(LOAD);
 	YY_BREAK
 case 39:
 YY_RULE_SETUP
 #line 120 "lex_sql.l"
-RETURN_TOKEN(MAX);
+RETURN_TOKEN(DATA);
 	YY_BREAK
 case 40:
 YY_RULE_SETUP
 #line 121 "lex_sql.l"
-RETURN_TOKEN(MIN);
+RETURN_TOKEN(INFILE);
 	YY_BREAK
 case 41:
 YY_RULE_SETUP
 #line 122 "lex_sql.l"
-RETURN_TOKEN(COUNT);
+RETURN_TOKEN(EXPLAIN);
 	YY_BREAK
 case 42:
 YY_RULE_SETUP
 #line 123 "lex_sql.l"
-RETURN_TOKEN(AVG);
+RETURN_TOKEN(MAX);
 	YY_BREAK
 case 43:
 YY_RULE_SETUP
 #line 124 "lex_sql.l"
-RETURN_TOKEN(SUM);
+RETURN_TOKEN(MIN);
 	YY_BREAK
 case 44:
 YY_RULE_SETUP
 #line 125 "lex_sql.l"
-RETURN_TOKEN(UNIQUE);
+RETURN_TOKEN(COUNT);
 	YY_BREAK
 case 45:
 YY_RULE_SETUP
 #line 126 "lex_sql.l"
-RETURN_TOKEN(IS_T);
+RETURN_TOKEN(AVG);
 	YY_BREAK
 case 46:
 YY_RULE_SETUP
 #line 127 "lex_sql.l"
-RETURN_TOKEN(NOT);
+RETURN_TOKEN(SUM);
 	YY_BREAK
 case 47:
 YY_RULE_SETUP
 #line 128 "lex_sql.l"
-RETURN_TOKEN(NULL_T);
+RETURN_TOKEN(UNIQUE);
 	YY_BREAK
 case 48:
 YY_RULE_SETUP
 #line 129 "lex_sql.l"
-RETURN_TOKEN(NULLABLE);
+RETURN_TOKEN(IS_T);
 	YY_BREAK
 case 49:
 YY_RULE_SETUP
 #line 130 "lex_sql.l"
-RETURN_TOKEN(INNER);
+RETURN_TOKEN(NOT);
 	YY_BREAK
 case 50:
 YY_RULE_SETUP
 #line 131 "lex_sql.l"
-RETURN_TOKEN(JOIN);
+RETURN_TOKEN(NULL_T);
 	YY_BREAK
 case 51:
 YY_RULE_SETUP
 #line 132 "lex_sql.l"
-RETURN_TOKEN(ORDER);
+RETURN_TOKEN(NULLABLE);
 	YY_BREAK
 case 52:
 YY_RULE_SETUP
 #line 133 "lex_sql.l"
-RETURN_TOKEN(BY);
+RETURN_TOKEN(INNER);
 	YY_BREAK
 case 53:
 YY_RULE_SETUP
 #line 134 "lex_sql.l"
-RETURN_TOKEN(GROUP);
+RETURN_TOKEN(JOIN);
 	YY_BREAK
 case 54:
 YY_RULE_SETUP
 #line 135 "lex_sql.l"
-RETURN_TOKEN(ASC_T);
+RETURN_TOKEN(ORDER);
 	YY_BREAK
 case 55:
 YY_RULE_SETUP
 #line 136 "lex_sql.l"
-RETURN_TOKEN(DESC_T);
+RETURN_TOKEN(BY);
 	YY_BREAK
 case 56:
 YY_RULE_SETUP
 #line 137 "lex_sql.l"
-yylval->string=strdup(yytext); RETURN_TOKEN(ID);
+RETURN_TOKEN(GROUP);
 	YY_BREAK
 case 57:
 YY_RULE_SETUP
 #line 138 "lex_sql.l"
-RETURN_TOKEN(LBRACE);
+RETURN_TOKEN(ASC_T);
 	YY_BREAK
 case 58:
 YY_RULE_SETUP
 #line 139 "lex_sql.l"
-RETURN_TOKEN(RBRACE);
+RETURN_TOKEN(DESC_T);
 	YY_BREAK
 case 59:
 YY_RULE_SETUP
-#line 141 "lex_sql.l"
-RETURN_TOKEN(COMMA);
+#line 140 "lex_sql.l"
+RETURN_TOKEN(LIMIT);
 	YY_BREAK
 case 60:
 YY_RULE_SETUP
-#line 142 "lex_sql.l"
-RETURN_TOKEN(EQ);
+#line 141 "lex_sql.l"
+RETURN_TOKEN(STORAGE);
 	YY_BREAK
 case 61:
 YY_RULE_SETUP
-#line 143 "lex_sql.l"
-RETURN_TOKEN(LE);
+#line 142 "lex_sql.l"
+RETURN_TOKEN(COMPRESSION);
 	YY_BREAK
 case 62:
 YY_RULE_SETUP
-#line 144 "lex_sql.l"
-RETURN_TOKEN(NE);
+#line 143 "lex_sql.l"
+yylval->string=strdup(yytext); RETURN_TOKEN(ID);
 	YY_BREAK
 case 63:
 YY_RULE_SETUP
-#line 145 "lex_sql.l"
-RETURN_TOKEN(NE);
+#line 144 "lex_sql.l"
+RETURN_TOKEN(LBRACE);
 	YY_BREAK
 case 64:
 YY_RULE_SETUP
-#line 146 "lex_sql.l"
-RETURN_TOKEN(LT);
+#line 145 "lex_sql.l"
+RETURN_TOKEN(RBRACE);
 	YY_BREAK
 case 65:
 YY_RULE_SETUP
 #line 147 "lex_sql.l"
-RETURN_TOKEN(GE);
+RETURN_TOKEN(COMMA);
 	YY_BREAK
 case 66:
 YY_RULE_SETUP
 #line 148 "lex_sql.l"
-RETURN_TOKEN(GT);
+RETURN_TOKEN(EQ);
 	YY_BREAK
 case 67:
-#line 151 "lex_sql.l"
+YY_RULE_SETUP
+#line 149 "lex_sql.l"
+RETURN_TOKEN(LE);
+	YY_BREAK
 case 68:
-#line 152 "lex_sql.l"
+YY_RULE_SETUP
+#line 150 "lex_sql.l"
+RETURN_TOKEN(NE);
+	YY_BREAK
 case 69:
-#line 153 "lex_sql.l"
+YY_RULE_SETUP
+#line 151 "lex_sql.l"
+RETURN_TOKEN(NE);
+	YY_BREAK
 case 70:
 YY_RULE_SETUP
-#line 153 "lex_sql.l"
-{ return yytext[0]; }
+#line 152 "lex_sql.l"
+RETURN_TOKEN(LT);
 	YY_BREAK
 case 71:
 YY_RULE_SETUP
-#line 155 "lex_sql.l"
-yylval->dates = str_to_date(yytext); RETURN_TOKEN(DATE);
+#line 153 "lex_sql.l"
+RETURN_TOKEN(GE);
 	YY_BREAK
 case 72:
-/* rule 72 can match eol */
 YY_RULE_SETUP
+#line 154 "lex_sql.l"
+RETURN_TOKEN(GT);
+	YY_BREAK
+case 73:
 #line 157 "lex_sql.l"
+case 74:
+#line 158 "lex_sql.l"
+case 75:
+#line 159 "lex_sql.l"
+case 76:
+YY_RULE_SETUP
+#line 159 "lex_sql.l"
+{ return yytext[0]; }
+	YY_BREAK
+case 77:
+YY_RULE_SETUP
+#line 161 "lex_sql.l"
+yylval->dates = str_to_date(yytext); RETURN_TOKEN(DATE);
+	YY_BREAK
+case 78:
+/* rule 78 can match eol */
+YY_RULE_SETUP
+#line 163 "lex_sql.l"
 yylval->string = strdup(yytext); RETURN_TOKEN(SSS);
 	YY_BREAK
-case 73:
-/* rule 73 can match eol */
+case 79:
+/* rule 79 can match eol */
 YY_RULE_SETUP
-#line 158 "lex_sql.l"
+#line 164 "lex_sql.l"
 yylval->string = strdup(yytext); RETURN_TOKEN(SSS);
 	YY_BREAK
-case 74:
+case 80:
 YY_RULE_SETUP
-#line 160 "lex_sql.l"
+#line 166 "lex_sql.l"
 LOG_DEBUG("Unknown character [%c]",yytext[0]); return yytext[0];
 	YY_BREAK
-case 75:
+case 81:
 YY_RULE_SETUP
-#line 161 "lex_sql.l"
+#line 167 "lex_sql.l"
 ECHO;
 	YY_BREAK
-#line 1451 "lex_sql.cpp"
+#line 1759 "lex_sql.cpp"
 case YY_STATE_EOF(INITIAL):
 case YY_STATE_EOF(STR):
 	yyterminate();
@@ -2603,7 +2911,7 @@ void yyfree (void * ptr , yyscan_t yyscanner)
 
 #define YYTABLES_NAME "yytables"
 
-#line 161 "lex_sql.l"
+#line 167 "lex_sql.l"
 
 
 void scan_string(const char *str, yyscan_t scanner) {
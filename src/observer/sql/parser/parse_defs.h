@@ -141,6 +141,7 @@ struct SelectSqlNode
   std::vector<JoinSqlNode>        joins;         ///< join列表
   std::vector<OrderSqlNode>       orders;        ///< order by
   std::vector<GroupSqlNode>       groups;        ///< group by
+  int                             limit = -1;    ///< limit，-1 表示没有限制
 };
 
 /**
@@ -205,15 +206,60 @@ struct AttrInfoSqlNode
   bool nullable;
 };
 
+/**
+ * @brief 表数据在页面上的存放方式
+ * @ingroup SQLParser
+ */
+enum class StorageFormat
+{
+  ROW,       ///< 行存，一条记录的所有字段连续存放
+  COLUMNAR,  ///< 列存(PAX)，页面内同一个字段的值连续存放，适合只读取少数字段的分析查询
+};
+
+/**
+ * @brief 表数据页面写到磁盘时的压缩方式
+ * @ingroup SQLParser
+ */
+enum class PageCompression
+{
+  NONE,  ///< 不压缩
+  LZ4,   ///< 使用 LZ4 压缩，页面在内存中仍然是不压缩的
+};
+
+/**
+ * @brief 建表语句支持的表选项
+ * @ingroup SQLParser
+ */
+enum class TableOptionType
+{
+  STORAGE,      ///< 表数据的存放方式，见 StorageFormat
+  COMPRESSION,  ///< 数据页面的压缩方式，见 PageCompression
+};
+
+/**
+ * @brief 建表语句最后的一个选项，比如 STORAGE = COLUMNAR
+ * @ingroup SQLParser
+ * @details 选项名称是关键字，不认识的选项在语法分析时就会报错。选项的值在 CreateTableStmt 中检查
+ */
+struct TableOptionSqlNode
+{
+  TableOptionType type;   ///< 选项名称
+  std::string     value;  ///< 选项的值
+};
+
 /**
  * @brief 描述一个create table语句
  * @ingroup SQLParser
  * @details 这里也做了很多简化。
+ * 语句最后可以加上若干个表选项，目前支持:
+ * STORAGE = COLUMNAR | ROW 指定表的存放方式，默认是行存；
+ * COMPRESSION = LZ4 | NONE 指定数据页面的压缩方式，默认不压缩。
  */
 struct CreateTableSqlNode
 {
-  std::string                  relation_name;         ///< Relation name
-  std::vector<AttrInfoSqlNode> attr_infos;            ///< attributes
+  std::string                     relation_name;  ///< Relation name
+  std::vector<AttrInfoSqlNode>    attr_infos;     ///< attributes
+  std::vector<TableOptionSqlNode> options;        ///< 表选项，在 CreateTableStmt 中检查
 };
 
 /**
@@ -14,13 +14,14 @@ See the Mulan PSL v2 for more details. */
 
 #include <sstream>
 #include <iomanip>
+#include <functional>
 #include "sql/parser/value.h"
 #include "storage/field/field.h"
 #include "common/log/log.h"
 #include "common/lang/comparator.h"
 #include "common/lang/string.h"
 
-const char *ATTR_TYPE_NAME[] = {"undefined", "chars", "ints", "floats","dates", "booleans","nulls"};
+const char *ATTR_TYPE_NAME[] = {"undefined", "chars", "ints", "floats","dates", "booleans", "varchars", "texts", "nulls"};
 
 std::string NULL_STRING="null";
 
@@ -258,6 +259,18 @@ int Value::compare(const Value &other) const
   return -1;  // TODO return rc?
 }
 
+size_t Value::hash() const
+{
+  switch (attr_type_) {
+    case INTS: return std::hash<int>()(num_value_.int_value_);
+    case FLOATS: return std::hash<float>()(num_value_.float_value_);
+    case DATES: return std::hash<date>()(num_value_.date_value_);
+    case BOOLEANS: return std::hash<bool>()(num_value_.bool_value_);
+    case CHARS: return std::hash<std::string>()(str_value_);
+    default: return 0;
+  }
+}
+
 int Value::get_int() const
 {
   switch (attr_type_) {
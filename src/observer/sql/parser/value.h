@@ -30,6 +30,8 @@ enum AttrType
   FLOATS,         ///< 浮点数类型(4字节)
   DATES,          ///< DATE类型(4字节)
   BOOLEANS,       ///< boolean类型，当前不是由parser解析出来的，是程序内部使用的
+  VARCHARS,       ///< 变长字符串，只用于存储。读取出来的值是 CHARS 类型
+  TEXTS,          ///< 长文本，数据放在溢出页中，只用于存储。读取出来的值是 CHARS 类型
   NULLS,          ///< null类型
 };
 
@@ -80,6 +82,12 @@ public:
 
   int compare(const Value &other) const;
 
+  /**
+   * @brief 哈希值，同一类型的两个值 compare 相等时哈希值也相等
+   * @details 浮点数比较时有误差，相等的两个值哈希值可能不同，不能用来做哈希比较
+   */
+  size_t hash() const;
+
   const char *data() const;
   int length() const
   {
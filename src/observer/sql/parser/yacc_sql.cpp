@@ -165,109 +165,117 @@ enum yysymbol_kind_t
   YYSYMBOL_STRING_T = 23,                  /* STRING_T  */
   YYSYMBOL_FLOAT_T = 24,                   /* FLOAT_T  */
   YYSYMBOL_DATE_T = 25,                    /* DATE_T  */
-  YYSYMBOL_HELP = 26,                      /* HELP  */
-  YYSYMBOL_EXIT = 27,                      /* EXIT  */
-  YYSYMBOL_DOT = 28,                       /* DOT  */
-  YYSYMBOL_INTO = 29,                      /* INTO  */
-  YYSYMBOL_VALUES = 30,                    /* VALUES  */
-  YYSYMBOL_FROM = 31,                      /* FROM  */
-  YYSYMBOL_WHERE = 32,                     /* WHERE  */
-  YYSYMBOL_AND = 33,                       /* AND  */
-  YYSYMBOL_SET = 34,                       /* SET  */
-  YYSYMBOL_ON = 35,                        /* ON  */
-  YYSYMBOL_LOAD = 36,                      /* LOAD  */
-  YYSYMBOL_DATA = 37,                      /* DATA  */
-  YYSYMBOL_INFILE = 38,                    /* INFILE  */
-  YYSYMBOL_EXPLAIN = 39,                   /* EXPLAIN  */
-  YYSYMBOL_EQ = 40,                        /* EQ  */
-  YYSYMBOL_LT = 41,                        /* LT  */
-  YYSYMBOL_GT = 42,                        /* GT  */
-  YYSYMBOL_LE = 43,                        /* LE  */
-  YYSYMBOL_GE = 44,                        /* GE  */
-  YYSYMBOL_NE = 45,                        /* NE  */
-  YYSYMBOL_MAX = 46,                       /* MAX  */
-  YYSYMBOL_MIN = 47,                       /* MIN  */
-  YYSYMBOL_COUNT = 48,                     /* COUNT  */
-  YYSYMBOL_AVG = 49,                       /* AVG  */
-  YYSYMBOL_SUM = 50,                       /* SUM  */
-  YYSYMBOL_UNIQUE = 51,                    /* UNIQUE  */
-  YYSYMBOL_IS_T = 52,                      /* IS_T  */
-  YYSYMBOL_NOT = 53,                       /* NOT  */
-  YYSYMBOL_NULL_T = 54,                    /* NULL_T  */
-  YYSYMBOL_NULLABLE = 55,                  /* NULLABLE  */
-  YYSYMBOL_INNER = 56,                     /* INNER  */
-  YYSYMBOL_JOIN = 57,                      /* JOIN  */
-  YYSYMBOL_ORDER = 58,                     /* ORDER  */
-  YYSYMBOL_BY = 59,                        /* BY  */
-  YYSYMBOL_ASC_T = 60,                     /* ASC_T  */
-  YYSYMBOL_DESC_T = 61,                    /* DESC_T  */
-  YYSYMBOL_GROUP = 62,                     /* GROUP  */
-  YYSYMBOL_NUMBER = 63,                    /* NUMBER  */
-  YYSYMBOL_FLOAT = 64,                     /* FLOAT  */
-  YYSYMBOL_DATE = 65,                      /* DATE  */
-  YYSYMBOL_ID = 66,                        /* ID  */
-  YYSYMBOL_SSS = 67,                       /* SSS  */
-  YYSYMBOL_68_ = 68,                       /* '+'  */
-  YYSYMBOL_69_ = 69,                       /* '-'  */
-  YYSYMBOL_70_ = 70,                       /* '*'  */
-  YYSYMBOL_71_ = 71,                       /* '/'  */
-  YYSYMBOL_UMINUS = 72,                    /* UMINUS  */
-  YYSYMBOL_YYACCEPT = 73,                  /* $accept  */
-  YYSYMBOL_commands = 74,                  /* commands  */
-  YYSYMBOL_command_wrapper = 75,           /* command_wrapper  */
-  YYSYMBOL_exit_stmt = 76,                 /* exit_stmt  */
-  YYSYMBOL_help_stmt = 77,                 /* help_stmt  */
-  YYSYMBOL_sync_stmt = 78,                 /* sync_stmt  */
-  YYSYMBOL_begin_stmt = 79,                /* begin_stmt  */
-  YYSYMBOL_commit_stmt = 80,               /* commit_stmt  */
-  YYSYMBOL_rollback_stmt = 81,             /* rollback_stmt  */
-  YYSYMBOL_drop_table_stmt = 82,           /* drop_table_stmt  */
-  YYSYMBOL_show_tables_stmt = 83,          /* show_tables_stmt  */
-  YYSYMBOL_desc_table_stmt = 84,           /* desc_table_stmt  */
-  YYSYMBOL_create_index_stmt = 85,         /* create_index_stmt  */
-  YYSYMBOL_drop_index_stmt = 86,           /* drop_index_stmt  */
-  YYSYMBOL_create_table_stmt = 87,         /* create_table_stmt  */
-  YYSYMBOL_attr_def_list = 88,             /* attr_def_list  */
-  YYSYMBOL_attr_def = 89,                  /* attr_def  */
-  YYSYMBOL_number = 90,                    /* number  */
-  YYSYMBOL_type = 91,                      /* type  */
-  YYSYMBOL_insert_stmt = 92,               /* insert_stmt  */
-  YYSYMBOL_raw_tuple_list = 93,            /* raw_tuple_list  */
-  YYSYMBOL_raw_tuple = 94,                 /* raw_tuple  */
-  YYSYMBOL_value_list = 95,                /* value_list  */
-  YYSYMBOL_value = 96,                     /* value  */
-  YYSYMBOL_delete_stmt = 97,               /* delete_stmt  */
-  YYSYMBOL_update_stmt = 98,               /* update_stmt  */
-  YYSYMBOL_select_stmt = 99,               /* select_stmt  */
-  YYSYMBOL_order = 100,                    /* order  */
-  YYSYMBOL_order_node_list = 101,          /* order_node_list  */
-  YYSYMBOL_order_node = 102,               /* order_node  */
-  YYSYMBOL_group = 103,                    /* group  */
-  YYSYMBOL_group_node_list = 104,          /* group_node_list  */
-  YYSYMBOL_group_node = 105,               /* group_node  */
-  YYSYMBOL_order_type = 106,               /* order_type  */
-  YYSYMBOL_join_list = 107,                /* join_list  */
-  YYSYMBOL_join_node = 108,                /* join_node  */
-  YYSYMBOL_calc_stmt = 109,                /* calc_stmt  */
-  YYSYMBOL_expression_list = 110,          /* expression_list  */
-  YYSYMBOL_expression = 111,               /* expression  */
-  YYSYMBOL_select_exprs = 112,             /* select_exprs  */
-  YYSYMBOL_select_expr = 113,              /* select_expr  */
-  YYSYMBOL_select_expr_list = 114,         /* select_expr_list  */
-  YYSYMBOL_aggr_func = 115,                /* aggr_func  */
-  YYSYMBOL_aggr_func_type = 116,           /* aggr_func_type  */
-  YYSYMBOL_select_attr = 117,              /* select_attr  */
-  YYSYMBOL_rel_attr = 118,                 /* rel_attr  */
-  YYSYMBOL_attr_list = 119,                /* attr_list  */
-  YYSYMBOL_rel_list = 120,                 /* rel_list  */
-  YYSYMBOL_where = 121,                    /* where  */
-  YYSYMBOL_condition_list = 122,           /* condition_list  */
-  YYSYMBOL_condition = 123,                /* condition  */
-  YYSYMBOL_comp_op = 124,                  /* comp_op  */
-  YYSYMBOL_load_data_stmt = 125,           /* load_data_stmt  */
-  YYSYMBOL_explain_stmt = 126,             /* explain_stmt  */
-  YYSYMBOL_set_variable_stmt = 127,        /* set_variable_stmt  */
-  YYSYMBOL_opt_semicolon = 128             /* opt_semicolon  */
+  YYSYMBOL_VARCHAR_T = 26,                 /* VARCHAR_T  */
+  YYSYMBOL_TEXT_T = 27,                    /* TEXT_T  */
+  YYSYMBOL_HELP = 28,                      /* HELP  */
+  YYSYMBOL_EXIT = 29,                      /* EXIT  */
+  YYSYMBOL_DOT = 30,                       /* DOT  */
+  YYSYMBOL_INTO = 31,                      /* INTO  */
+  YYSYMBOL_VALUES = 32,                    /* VALUES  */
+  YYSYMBOL_FROM = 33,                      /* FROM  */
+  YYSYMBOL_WHERE = 34,                     /* WHERE  */
+  YYSYMBOL_AND = 35,                       /* AND  */
+  YYSYMBOL_SET = 36,                       /* SET  */
+  YYSYMBOL_ON = 37,                        /* ON  */
+  YYSYMBOL_LOAD = 38,                      /* LOAD  */
+  YYSYMBOL_DATA = 39,                      /* DATA  */
+  YYSYMBOL_INFILE = 40,                    /* INFILE  */
+  YYSYMBOL_EXPLAIN = 41,                   /* EXPLAIN  */
+  YYSYMBOL_EQ = 42,                        /* EQ  */
+  YYSYMBOL_LT = 43,                        /* LT  */
+  YYSYMBOL_GT = 44,                        /* GT  */
+  YYSYMBOL_LE = 45,                        /* LE  */
+  YYSYMBOL_GE = 46,                        /* GE  */
+  YYSYMBOL_NE = 47,                        /* NE  */
+  YYSYMBOL_MAX = 48,                       /* MAX  */
+  YYSYMBOL_MIN = 49,                       /* MIN  */
+  YYSYMBOL_COUNT = 50,                     /* COUNT  */
+  YYSYMBOL_AVG = 51,                       /* AVG  */
+  YYSYMBOL_SUM = 52,                       /* SUM  */
+  YYSYMBOL_UNIQUE = 53,                    /* UNIQUE  */
+  YYSYMBOL_IS_T = 54,                      /* IS_T  */
+  YYSYMBOL_NOT = 55,                       /* NOT  */
+  YYSYMBOL_NULL_T = 56,                    /* NULL_T  */
+  YYSYMBOL_NULLABLE = 57,                  /* NULLABLE  */
+  YYSYMBOL_INNER = 58,                     /* INNER  */
+  YYSYMBOL_JOIN = 59,                      /* JOIN  */
+  YYSYMBOL_ORDER = 60,                     /* ORDER  */
+  YYSYMBOL_BY = 61,                        /* BY  */
+  YYSYMBOL_ASC_T = 62,                     /* ASC_T  */
+  YYSYMBOL_DESC_T = 63,                    /* DESC_T  */
+  YYSYMBOL_GROUP = 64,                     /* GROUP  */
+  YYSYMBOL_LIMIT = 65,                     /* LIMIT  */
+  YYSYMBOL_STORAGE = 66,                   /* STORAGE  */
+  YYSYMBOL_COMPRESSION = 67,               /* COMPRESSION  */
+  YYSYMBOL_NUMBER = 68,                    /* NUMBER  */
+  YYSYMBOL_FLOAT = 69,                     /* FLOAT  */
+  YYSYMBOL_DATE = 70,                      /* DATE  */
+  YYSYMBOL_ID = 71,                        /* ID  */
+  YYSYMBOL_SSS = 72,                       /* SSS  */
+  YYSYMBOL_73_ = 73,                       /* '+'  */
+  YYSYMBOL_74_ = 74,                       /* '-'  */
+  YYSYMBOL_75_ = 75,                       /* '*'  */
+  YYSYMBOL_76_ = 76,                       /* '/'  */
+  YYSYMBOL_UMINUS = 77,                    /* UMINUS  */
+  YYSYMBOL_YYACCEPT = 78,                  /* $accept  */
+  YYSYMBOL_commands = 79,                  /* commands  */
+  YYSYMBOL_command_wrapper = 80,           /* command_wrapper  */
+  YYSYMBOL_exit_stmt = 81,                 /* exit_stmt  */
+  YYSYMBOL_help_stmt = 82,                 /* help_stmt  */
+  YYSYMBOL_sync_stmt = 83,                 /* sync_stmt  */
+  YYSYMBOL_begin_stmt = 84,                /* begin_stmt  */
+  YYSYMBOL_commit_stmt = 85,               /* commit_stmt  */
+  YYSYMBOL_rollback_stmt = 86,             /* rollback_stmt  */
+  YYSYMBOL_drop_table_stmt = 87,           /* drop_table_stmt  */
+  YYSYMBOL_show_tables_stmt = 88,          /* show_tables_stmt  */
+  YYSYMBOL_desc_table_stmt = 89,           /* desc_table_stmt  */
+  YYSYMBOL_create_index_stmt = 90,         /* create_index_stmt  */
+  YYSYMBOL_drop_index_stmt = 91,           /* drop_index_stmt  */
+  YYSYMBOL_create_table_stmt = 92,         /* create_table_stmt  */
+  YYSYMBOL_table_option_list = 93,         /* table_option_list  */
+  YYSYMBOL_table_option = 94,              /* table_option  */
+  YYSYMBOL_attr_def_list = 95,             /* attr_def_list  */
+  YYSYMBOL_attr_def = 96,                  /* attr_def  */
+  YYSYMBOL_number = 97,                    /* number  */
+  YYSYMBOL_type = 98,                      /* type  */
+  YYSYMBOL_insert_stmt = 99,               /* insert_stmt  */
+  YYSYMBOL_raw_tuple_list = 100,           /* raw_tuple_list  */
+  YYSYMBOL_raw_tuple = 101,                /* raw_tuple  */
+  YYSYMBOL_value_list = 102,               /* value_list  */
+  YYSYMBOL_value = 103,                    /* value  */
+  YYSYMBOL_delete_stmt = 104,              /* delete_stmt  */
+  YYSYMBOL_update_stmt = 105,              /* update_stmt  */
+  YYSYMBOL_select_stmt = 106,              /* select_stmt  */
+  YYSYMBOL_order = 107,                    /* order  */
+  YYSYMBOL_order_node_list = 108,          /* order_node_list  */
+  YYSYMBOL_order_node = 109,               /* order_node  */
+  YYSYMBOL_limit = 110,                    /* limit  */
+  YYSYMBOL_group = 111,                    /* group  */
+  YYSYMBOL_group_node_list = 112,          /* group_node_list  */
+  YYSYMBOL_group_node = 113,               /* group_node  */
+  YYSYMBOL_order_type = 114,               /* order_type  */
+  YYSYMBOL_join_list = 115,                /* join_list  */
+  YYSYMBOL_join_node = 116,                /* join_node  */
+  YYSYMBOL_calc_stmt = 117,                /* calc_stmt  */
+  YYSYMBOL_expression_list = 118,          /* expression_list  */
+  YYSYMBOL_expression = 119,               /* expression  */
+  YYSYMBOL_select_exprs = 120,             /* select_exprs  */
+  YYSYMBOL_select_expr = 121,              /* select_expr  */
+  YYSYMBOL_select_expr_list = 122,         /* select_expr_list  */
+  YYSYMBOL_aggr_func = 123,                /* aggr_func  */
+  YYSYMBOL_aggr_func_type = 124,           /* aggr_func_type  */
+  YYSYMBOL_select_attr = 125,              /* select_attr  */
+  YYSYMBOL_rel_attr = 126,                 /* rel_attr  */
+  YYSYMBOL_attr_list = 127,                /* attr_list  */
+  YYSYMBOL_rel_list = 128,                 /* rel_list  */
+  YYSYMBOL_where = 129,                    /* where  */
+  YYSYMBOL_condition_list = 130,           /* condition_list  */
+  YYSYMBOL_condition = 131,                /* condition  */
+  YYSYMBOL_comp_op = 132,                  /* comp_op  */
+  YYSYMBOL_load_data_stmt = 133,           /* load_data_stmt  */
+  YYSYMBOL_explain_stmt = 134,             /* explain_stmt  */
+  YYSYMBOL_set_variable_stmt = 135,        /* set_variable_stmt  */
+  YYSYMBOL_opt_semicolon = 136             /* opt_semicolon  */
 };
 typedef enum yysymbol_kind_t yysymbol_kind_t;
 
@@ -598,19 +606,19 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  76
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   229
+#define YYLAST   852
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  73
+#define YYNTOKENS  78
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  56
+#define YYNNTS  59
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  135
+#define YYNRULES  143
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  238
+#define YYNSTATES  253
 
 /* YYMAXUTOK -- Last valid token kind.  */
-#define YYMAXUTOK   323
+#define YYMAXUTOK   328
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
@@ -628,7 +636,7 @@ static const yytype_int8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,    70,    68,     2,    69,     2,    71,     2,     2,
+       2,     2,    75,    73,     2,    74,     2,    76,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -656,27 +664,28 @@ static const yytype_int8 yytranslate[] =
       35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
       45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
       55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
-      65,    66,    67,    72
+      65,    66,    67,    68,    69,    70,    71,    72,    77
 };
 
 #if YYDEBUG
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,   221,   221,   229,   230,   231,   232,   233,   234,   235,
-     236,   237,   238,   239,   240,   241,   242,   243,   244,   245,
-     246,   247,   248,   252,   258,   263,   269,   275,   281,   287,
-     294,   300,   308,   320,   335,   345,   364,   367,   380,   389,
-     398,   407,   416,   425,   437,   440,   441,   442,   443,   446,
-     460,   463,   474,   486,   489,   500,   504,   508,   511,   514,
-     522,   534,   549,   577,   608,   611,   618,   621,   626,   632,
-     641,   644,   651,   654,   659,   665,   671,   674,   677,   683,
-     686,   697,   708,   718,   723,   734,   737,   740,   743,   746,
-     750,   753,   761,   770,   782,   787,   796,   799,   812,   824,
-     827,   830,   833,   836,   842,   849,   861,   870,   880,   885,
-     896,   899,   913,   916,   929,   932,   938,   941,   946,   953,
-     965,   977,   989,  1004,  1005,  1006,  1007,  1008,  1009,  1010,
-    1011,  1015,  1028,  1036,  1046,  1047
+       0,   233,   233,   241,   242,   243,   244,   245,   246,   247,
+     248,   249,   250,   251,   252,   253,   254,   255,   256,   257,
+     258,   259,   260,   264,   270,   275,   281,   287,   293,   299,
+     306,   312,   320,   332,   347,   357,   382,   385,   397,   404,
+     414,   417,   430,   439,   448,   457,   466,   475,   487,   490,
+     491,   492,   493,   494,   495,   498,   512,   515,   526,   538,
+     541,   552,   556,   560,   563,   566,   574,   586,   601,   630,
+     662,   665,   672,   675,   680,   686,   695,   698,   705,   708,
+     715,   718,   723,   729,   735,   738,   741,   747,   750,   761,
+     772,   782,   787,   798,   801,   804,   807,   810,   814,   817,
+     825,   834,   846,   851,   860,   863,   876,   888,   891,   894,
+     897,   900,   906,   913,   925,   934,   944,   949,   960,   963,
+     977,   980,   993,   996,  1002,  1005,  1010,  1017,  1029,  1041,
+    1053,  1068,  1069,  1070,  1071,  1072,  1073,  1074,  1075,  1079,
+    1092,  1100,  1110,  1111
 };
 #endif
 
@@ -696,23 +705,25 @@ static const char *const yytname[] =
   "DROP", "TABLE", "TABLES", "INDEX", "CALC", "SELECT", "SHOW", "SYNC",
   "INSERT", "DELETE", "UPDATE", "LBRACE", "RBRACE", "COMMA", "TRX_BEGIN",
   "TRX_COMMIT", "TRX_ROLLBACK", "INT_T", "STRING_T", "FLOAT_T", "DATE_T",
-  "HELP", "EXIT", "DOT", "INTO", "VALUES", "FROM", "WHERE", "AND", "SET",
-  "ON", "LOAD", "DATA", "INFILE", "EXPLAIN", "EQ", "LT", "GT", "LE", "GE",
-  "NE", "MAX", "MIN", "COUNT", "AVG", "SUM", "UNIQUE", "IS_T", "NOT",
-  "NULL_T", "NULLABLE", "INNER", "JOIN", "ORDER", "BY", "ASC_T", "DESC_T",
-  "GROUP", "NUMBER", "FLOAT", "DATE", "ID", "SSS", "'+'", "'-'", "'*'",
-  "'/'", "UMINUS", "$accept", "commands", "command_wrapper", "exit_stmt",
+  "VARCHAR_T", "TEXT_T", "HELP", "EXIT", "DOT", "INTO", "VALUES", "FROM",
+  "WHERE", "AND", "SET", "ON", "LOAD", "DATA", "INFILE", "EXPLAIN", "EQ",
+  "LT", "GT", "LE", "GE", "NE", "MAX", "MIN", "COUNT", "AVG", "SUM",
+  "UNIQUE", "IS_T", "NOT", "NULL_T", "NULLABLE", "INNER", "JOIN", "ORDER",
+  "BY", "ASC_T", "DESC_T", "GROUP", "LIMIT", "STORAGE", "COMPRESSION",
+  "NUMBER", "FLOAT", "DATE", "ID", "SSS", "'+'", "'-'", "'*'", "'/'",
+  "UMINUS", "$accept", "commands", "command_wrapper", "exit_stmt",
   "help_stmt", "sync_stmt", "begin_stmt", "commit_stmt", "rollback_stmt",
   "drop_table_stmt", "show_tables_stmt", "desc_table_stmt",
   "create_index_stmt", "drop_index_stmt", "create_table_stmt",
-  "attr_def_list", "attr_def", "number", "type", "insert_stmt",
-  "raw_tuple_list", "raw_tuple", "value_list", "value", "delete_stmt",
-  "update_stmt", "select_stmt", "order", "order_node_list", "order_node",
-  "group", "group_node_list", "group_node", "order_type", "join_list",
-  "join_node", "calc_stmt", "expression_list", "expression",
-  "select_exprs", "select_expr", "select_expr_list", "aggr_func",
-  "aggr_func_type", "select_attr", "rel_attr", "attr_list", "rel_list",
-  "where", "condition_list", "condition", "comp_op", "load_data_stmt",
+  "table_option_list", "table_option", "attr_def_list", "attr_def",
+  "number", "type", "insert_stmt", "raw_tuple_list", "raw_tuple",
+  "value_list", "value", "delete_stmt", "update_stmt", "select_stmt",
+  "order", "order_node_list", "order_node", "limit", "group",
+  "group_node_list", "group_node", "order_type", "join_list", "join_node",
+  "calc_stmt", "expression_list", "expression", "select_exprs",
+  "select_expr", "select_expr_list", "aggr_func", "aggr_func_type",
+  "select_attr", "rel_attr", "attr_list", "rel_list", "where",
+  "condition_list", "condition", "comp_op", "load_data_stmt",
   "explain_stmt", "set_variable_stmt", "opt_semicolon", YY_NULLPTR
 };
 
@@ -723,12 +734,12 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 }
 #endif
 
-#define YYPACT_NINF (-160)
+#define YYPACT_NINF (-173)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF (-1)
+#define YYTABLE_NINF (-144)
 
 #define yytable_value_is_error(Yyn) \
   0
@@ -737,140 +748,270 @@ yysymbol_name (yysymbol_kind_t yysymbol)
    STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-      -2,    21,    15,    -1,    48,     9,  -160,    -7,     2,   -23,
-    -160,  -160,  -160,  -160,  -160,   -19,    17,    -2,   -14,    69,
-      67,  -160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,
-    -160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,  -160,
-    -160,     5,    14,    77,    20,    22,    -1,  -160,  -160,  -160,
-    -160,  -160,    -1,  -160,  -160,     8,  -160,  -160,  -160,  -160,
-    -160,    59,  -160,    61,    72,  -160,    96,  -160,  -160,    47,
-      49,    91,    97,    98,  -160,  -160,  -160,  -160,  -160,   122,
-     104,    74,  -160,   106,   -13,  -160,    -1,    -1,    -1,    -1,
-      -1,    76,    78,    53,  -160,   -35,   113,   114,    79,    63,
-      80,    82,    83,   115,    85,  -160,  -160,   -29,   -29,  -160,
-    -160,  -160,   -12,    72,   134,   136,   137,   138,    57,  -160,
-     116,  -160,   128,   110,   140,   143,    94,  -160,    95,   105,
-     107,   114,  -160,    99,  -160,    99,  -160,    63,   146,    64,
-      64,  -160,   133,    63,   163,  -160,  -160,  -160,  -160,    12,
-      82,   153,   108,   155,   154,   109,   114,   107,   111,   137,
-     137,   158,   138,  -160,  -160,  -160,  -160,  -160,  -160,  -160,
-     124,    57,    57,    57,   114,   112,   117,   125,  -160,   140,
-    -160,   164,   118,  -160,   147,   111,  -160,   126,   129,  -160,
-    -160,    63,   166,   146,  -160,  -160,  -160,  -160,  -160,  -160,
-    -160,  -160,  -160,   169,  -160,  -160,  -160,   171,    57,   129,
-      99,   130,  -160,   158,  -160,  -160,   -17,  -160,  -160,  -160,
-    -160,   172,  -160,    99,  -160,   139,  -160,    99,  -160,   173,
-     -10,  -160,  -160,    99,  -160,  -160,  -160,  -160
+     625,     8,   139,   602,   649,     1,    18,   -20,   -14,   -46,
+      35,   112,   168,   188,   222,   -41,    -2,   625,   -13,   105,
+     226,   227,   320,   326,   327,   370,   420,   469,   470,   481,
+     505,   517,   592,   604,   610,   690,   692,   702,   704,   711,
+     811,    39,    47,   120,    68,    75,   602,     6,    90,   140,
+     189,   238,   602,    10,   812,   287,   135,   137,   143,   174,
+     179,   394,   164,   219,    -1,    45,   185,    93,   813,   186,
+     208,   234,   244,   253,   817,   818,  -173,   295,   297,   288,
+     269,   237,   819,   298,   145,    26,   602,   602,   602,   602,
+     602,   257,   266,   548,   310,    38,   316,    12,   279,   617,
+     280,   293,   303,   331,   305,   103,   823,   193,   242,   258,
+     271,   432,   291,    -1,    70,   361,   155,   364,   336,   824,
+     351,   825,   372,   782,   233,   405,   344,   829,   374,   404,
+     509,   382,   418,   427,   109,   427,   436,   617,   149,   756,
+     756,   354,   307,   617,   483,   283,   546,   607,   639,   651,
+     661,   664,   293,   476,   428,   490,   516,   440,   382,   509,
+     366,   155,   155,   260,   364,   830,   666,   674,   683,   691,
+     700,   708,   657,   717,   717,   319,    12,   454,   439,   473,
+     341,   233,    56,   513,   460,   557,   500,   366,   568,   478,
+     321,   532,   538,   617,   539,   149,   725,   468,   480,   488,
+     501,   524,   831,   835,   555,   562,   392,   569,   499,   535,
+     836,    56,   837,   576,   319,   321,     2,   533,    31,   260,
+     199,   841,   191,   537,   543,   842,   843,   551,    31,   510,
+     395,   482,    33,   552,   847,   609,   571,   416,    94,   114,
+     848,     2,    65,     4,   399,   849,   426,   518,    33,    54,
+     138,   587,   422
 };
 
 /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
    Performed when YYTABLE does not specify something else to do.  Zero
    means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+static const yytype_int8 yydefact[] =
 {
-       0,     0,     0,     0,     0,     0,    25,     0,     0,     0,
-      26,    27,    28,    24,    23,     0,     0,     0,     0,     0,
-     134,    22,    21,    14,    15,    16,    17,     9,    10,    11,
-      12,    13,     8,     5,     7,     6,     4,     3,    18,    19,
-      20,     0,     0,     0,     0,     0,     0,    58,    55,    56,
-      57,    59,     0,    91,    82,    83,    99,   100,   101,   102,
-     103,   108,    92,     0,    96,    95,     0,    94,    30,     0,
-       0,     0,     0,     0,   132,    31,     1,   135,     2,     0,
-       0,     0,    29,     0,     0,    90,     0,     0,     0,     0,
-       0,     0,     0,     0,    93,   107,     0,   114,     0,     0,
-       0,     0,     0,     0,     0,    89,    84,    85,    86,    87,
-      88,   109,   112,    96,   104,     0,   110,     0,   116,    60,
-       0,   133,     0,     0,    36,     0,     0,    34,     0,     0,
-      79,   114,    97,     0,    98,     0,   106,     0,    50,     0,
-       0,   115,   117,     0,     0,    45,    46,    47,    48,    39,
-       0,     0,     0,     0,   112,     0,   114,    79,    70,   110,
-     110,    53,     0,    49,   123,   124,   125,   126,   127,   128,
-     129,     0,     0,   116,   114,     0,     0,     0,    43,    36,
-      35,     0,     0,   113,     0,    70,    80,     0,    64,   105,
-     111,     0,     0,    50,   130,   120,   122,   119,   121,   118,
-      61,   131,    44,     0,    41,    37,    32,     0,   116,    64,
-      72,     0,    62,    53,    52,    51,    38,    33,    81,    63,
-      71,    73,    75,    66,    54,     0,    42,    72,    65,    67,
-      76,    40,    74,    66,    77,    78,    69,    68
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     1,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0
 };
 
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -160,  -160,   175,  -160,  -160,  -160,  -160,  -160,  -160,  -160,
-    -160,  -160,  -160,  -160,  -160,    16,    44,  -160,  -160,  -160,
-       3,    35,   -15,   -98,  -160,  -160,  -160,    -9,   -34,  -160,
-      18,   -26,  -160,  -160,    45,    92,  -160,   119,    -6,  -160,
-     120,   101,  -160,  -160,  -160,    -4,   -99,    54,  -126,  -159,
-    -160,    70,  -160,  -160,  -160,  -160
+    -173,  -173,   614,  -173,  -173,  -173,  -173,  -173,  -173,  -173,
+    -173,  -173,  -173,  -173,  -173,   430,  -173,   461,   491,  -173,
+    -173,  -173,   456,   495,   441,   -98,  -173,  -173,  -173,   450,
+     435,  -173,   447,   497,   462,  -173,  -173,   550,   579,  -173,
+     624,   560,  -173,   622,   618,  -173,  -173,  -173,    -4,    78,
+     561,   -84,  -172,  -173,   583,  -173,  -173,  -173,  -173
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_uint8 yydefgoto[] =
 {
        0,    19,    20,    21,    22,    23,    24,    25,    26,    27,
-      28,    29,    30,    31,    32,   151,   124,   203,   149,    33,
-     163,   138,   192,    53,    34,    35,    36,   212,   228,   229,
-     188,   220,   221,   236,   156,   157,    37,    54,    55,    63,
-      64,    94,    65,    66,   115,   140,   136,   131,   119,   141,
-     142,   171,    38,    39,    40,    78
+      28,    29,    30,    31,    32,   210,   211,   153,   124,   205,
+     151,    33,   165,   138,   194,    53,    34,    35,    36,   218,
+     242,   243,   234,   190,   229,   230,   251,   158,   159,    37,
+      54,    55,    63,    64,    94,    65,    66,   115,   140,   136,
+     131,   119,   141,   142,   173,    38,    39,    40,    78
 };
 
 /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
    positive, shift that token.  If negative, reduce the rule whose
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
-static const yytype_uint8 yytable[] =
+static const yytype_int16 yytable[] =
 {
-      67,   121,     1,     2,   105,   158,   128,     3,     4,     5,
-       6,     7,     8,     9,   199,    46,    68,    10,    11,    12,
-     139,    44,    69,    45,    13,    14,    86,    41,   176,    42,
-     185,    61,    15,    70,    16,   114,   225,    17,   226,   161,
-      84,    89,    90,    71,   129,   174,    85,    72,   200,   218,
-     234,   235,    75,    47,    73,    87,    88,    89,    90,    18,
-     189,   190,    48,    49,    50,   177,    51,   178,    52,    76,
-      77,    79,    43,   195,   197,   139,    87,    88,    89,    90,
-      80,   107,   108,   109,   110,    81,    82,    91,    83,    67,
-      93,   116,    92,   213,    56,    57,    58,    59,    60,    56,
-      57,    58,    59,    60,   164,   165,   166,   167,   168,   169,
-     139,    47,    95,    96,    61,    97,   170,    47,    62,    61,
-      48,    49,    50,    61,    51,    98,    48,    49,    50,   159,
-      51,   160,   145,   146,   147,   148,   100,    99,   101,   102,
-     103,   104,   111,   117,   112,   120,   118,   122,   123,   125,
-     126,   127,   133,   134,   137,   135,   143,   144,   150,   152,
-     153,   154,   155,   129,   162,    61,   173,   196,   198,   175,
-     180,   182,   128,   187,   181,   184,   191,   194,   201,   204,
-     202,   206,   208,   214,   207,   210,   216,   211,   217,   223,
-     227,   233,    74,   231,   179,   205,   215,   193,   224,   237,
-     219,   232,   186,   209,   130,   106,   222,     0,   183,     0,
-     172,     0,     0,   113,   132,     0,     0,     0,     0,   230,
-       0,     0,     0,   222,     0,     0,     0,     0,     0,   230
+      67,   121,   -80,   201,   -73,   -80,   -64,   -73,    68,   -64,
+     -99,    69,  -122,   -99,    41,  -122,    42,    93,   -25,    70,
+     139,   -25,   248,   -64,   -64,    71,   -98,   -99,   -99,   -98,
+      72,   -76,  -104,   -72,   -76,   -26,   -72,    73,   -26,   163,
+     -64,   -64,   227,   -98,   -98,   176,   118,   160,   -64,   -64,
+     -64,   -64,   -64,   -64,   -85,  -115,   -36,   -85,    75,   -36,
+     -64,    43,   -80,  -103,   -64,   -71,   -64,   -80,   -71,   -73,
+     -64,   -64,   -85,    61,   187,   197,   199,   139,  -103,   -64,
+     -64,   -64,   -64,   -99,   -99,   -99,   -99,  -112,   133,    67,
+     -61,   116,   202,   -61,   -38,   219,   233,   -38,   -72,   -98,
+     -98,   -98,   -98,   -97,    61,    76,   -97,   -61,   -61,    61,
+      79,  -102,   -27,   114,   -39,   -27,   139,   -39,    80,   -85,
+     -97,   -97,   208,   209,   -61,   -61,  -102,  -106,    81,   161,
+     -71,   162,   -61,   -61,   -61,   -61,   -61,   -61,   -86,    82,
+     -62,   -86,  -106,   -62,   -61,    44,    83,    45,   -61,   -56,
+     -61,  -107,   -56,  -108,   -61,   -61,   -86,   -62,   -62,  -109,
+     -38,   -38,   105,   -61,   -61,   -61,   -61,   164,   -28,   198,
+     200,   -28,  -118,   135,   -62,   -62,   -97,   -97,   -97,   -97,
+     -39,   -39,   -62,   -62,   -62,   -62,   -62,   -62,   -24,   -63,
+    -110,   -24,   -63,   -93,   -62,  -111,   -93,  -100,   -62,   -58,
+     -62,    95,   -58,   -86,   -62,   -62,   -63,   -63,   -42,   -42,
+     -93,   -93,   231,   -62,   -62,   -62,   -62,   -58,    87,    88,
+      89,    90,   -23,   -63,   -63,   -23,  -142,   -22,   244,    77,
+     -22,   -63,   -63,   -63,   -63,   -63,   -63,   231,   -65,   191,
+     192,   -65,   -94,   -63,   244,   -94,   236,   -63,   237,   -63,
+     -40,   152,    92,   -63,   -63,   -65,   -65,    96,   -95,   -94,
+     -94,   -95,   -63,   -63,   -63,   -63,   -93,   -93,    89,    90,
+      98,   -96,   -65,   -65,   -96,   -95,   -95,   -59,   193,    97,
+     -65,   -65,   -65,   -65,   -65,   -65,    99,   -91,   -96,   -96,
+     -91,  -120,   -65,   100,  -120,  -143,   -65,    -2,   -65,   -49,
+     -49,   -49,   -65,   -65,   101,    86,   102,  -125,   103,   128,
+    -125,   -65,   -65,   -65,   -65,   -94,   -94,    89,    90,  -124,
+     -21,   -70,  -124,   -21,   -70,  -120,   -14,   -15,   111,   -14,
+     -15,   -95,   -95,   -95,   -95,   104,  -124,   112,   -49,  -124,
+     -49,  -125,   175,  -101,   -96,   -96,   -96,   -96,   117,   129,
+     120,  -120,   122,  -124,  -123,  -120,  -120,  -123,   -47,   -47,
+      87,    88,    89,    90,   123,  -125,   -78,  -125,   126,   -78,
+     -16,  -125,  -125,   -16,   125,    47,   127,  -124,   134,  -124,
+     137,   217,  -122,  -124,  -124,  -122,   -70,    48,    49,    50,
+      61,    51,    47,   143,  -116,   -81,  -124,  -116,   -81,   -84,
+    -124,  -124,   -84,   144,    48,    49,    50,    61,    51,   -45,
+     -45,  -116,  -116,   241,  -123,   155,   118,   -84,  -123,  -123,
+     -17,   154,   -74,   -17,    91,   -74,   -78,  -116,  -116,  -116,
+     189,   -78,  -117,   -46,   -46,  -117,  -116,  -116,  -116,  -116,
+    -116,  -116,  -122,   -44,   -44,   156,  -122,  -122,  -116,  -117,
+    -117,  -105,  -116,  -114,  -116,   -81,  -116,  -116,  -116,  -116,
+     -81,   249,   250,   157,   -84,  -117,  -117,  -117,  -128,    -9,
+     -10,  -128,    -9,   -10,  -117,  -117,  -117,  -117,  -117,  -117,
+    -130,   -11,   -83,  -130,   -11,   -83,  -117,   -74,  -127,   177,
+    -117,  -127,  -117,   182,  -117,  -117,  -117,  -117,    61,   183,
+     -83,  -129,  -128,  -128,  -129,   -12,   184,   204,   -12,   -87,
+     -79,   186,   -87,   -79,  -130,  -130,  -120,   -13,   -82,  -120,
+     -13,   -82,  -127,  -127,  -126,   203,  -128,  -126,  -128,   206,
+     212,   213,  -128,  -128,   128,  -129,  -129,   214,  -130,   216,
+    -130,   223,   -83,   -87,  -130,  -130,  -127,   -83,  -127,  -113,
+    -120,   -89,  -127,  -127,   -89,  -119,   220,  -121,  -126,  -129,
+    -121,  -129,   -50,   -50,   -50,  -129,  -129,   129,   -88,   -87,
+     -79,   -88,   -48,   -87,   -87,   -79,  -120,   224,   -82,   222,
+    -120,  -120,  -126,   -82,  -126,   -89,   -41,   -75,  -126,  -126,
+     -75,  -121,    -8,   226,   232,    -8,    56,    57,    58,    59,
+      60,   -50,   -88,   -50,    -5,   -75,    84,    -5,   238,   -89,
+      -7,   -89,    85,    -7,   239,   -89,   -89,  -121,    46,    61,
+     245,  -121,  -121,   -51,   -51,   -51,   -60,   246,   -88,     1,
+       2,    74,   -88,   -88,     3,     4,     5,     6,     7,     8,
+       9,   225,   207,   181,    10,    11,    12,   107,   108,   109,
+     110,   221,   -75,    13,    14,   -52,   -52,   -52,    47,   195,
+     235,    15,   -51,    16,   -51,   228,    17,   -53,   -53,   -53,
+      48,    49,    50,    47,    51,   240,    52,   -54,   -54,   -54,
+     178,   -43,   -43,   252,   215,    48,    49,    50,    18,    51,
+      -6,   130,    -4,    -6,   -52,    -4,   -52,    56,    57,    58,
+      59,    60,    -3,   247,   -18,    -3,   -53,   -18,   -53,   188,
+     106,   -19,   196,  -137,   -19,   113,   -54,   185,   -54,   179,
+      61,   180,  -131,   174,    62,  -137,  -137,  -137,  -137,  -137,
+    -132,   132,     0,     0,  -131,  -131,  -131,  -131,  -131,  -133,
+       0,     0,  -132,  -132,  -132,  -132,  -132,  -134,     0,     0,
+       0,  -133,  -133,  -133,  -133,  -133,  -135,     0,     0,  -134,
+    -134,  -134,  -134,  -134,  -136,     0,     0,     0,  -135,  -135,
+    -135,  -135,  -135,    47,     0,     0,  -136,  -136,  -136,  -136,
+    -136,  -138,     0,     0,     0,    48,    49,    50,    61,    51,
+       0,     0,     0,  -138,  -138,  -138,  -138,  -138,   166,   167,
+     168,   169,   170,   171,   145,   146,   147,   148,   149,   150,
+     172,   -20,   -90,   -30,   -20,   -90,   -30,  -140,   -31,   -29,
+    -140,   -31,   -29,   -92,   -66,  -141,   -92,   -66,  -141,   -34,
+     -55,   -67,   -34,   -55,   -67,  -139,   -35,   -32,  -139,   -35,
+     -32,   -57,   -37,   -33,   -57,   -37,   -33,   -68,   -69,   -77,
+     -68,   -69,   -77
 };
 
 static const yytype_int16 yycheck[] =
 {
-       4,    99,     4,     5,    17,   131,    18,     9,    10,    11,
-      12,    13,    14,    15,   173,    16,     7,    19,    20,    21,
-     118,     6,    29,     8,    26,    27,    18,     6,    16,     8,
-     156,    66,    34,    31,    36,    70,    53,    39,    55,   137,
-      46,    70,    71,    66,    56,   143,    52,    66,   174,   208,
-      60,    61,    66,    54,    37,    68,    69,    70,    71,    61,
-     159,   160,    63,    64,    65,    53,    67,    55,    69,     0,
-       3,    66,    51,   171,   172,   173,    68,    69,    70,    71,
-      66,    87,    88,    89,    90,     8,    66,    28,    66,    93,
-      18,    95,    31,   191,    46,    47,    48,    49,    50,    46,
-      47,    48,    49,    50,    40,    41,    42,    43,    44,    45,
-     208,    54,    16,    66,    66,    66,    52,    54,    70,    66,
-      63,    64,    65,    66,    67,    34,    63,    64,    65,   133,
-      67,   135,    22,    23,    24,    25,    38,    40,    16,    35,
-      66,    35,    66,    30,    66,    66,    32,    67,    66,    66,
-      35,    66,    18,    17,    16,    18,    40,    29,    18,    16,
-      66,    66,    57,    56,    18,    66,    33,   171,   172,     6,
-      17,    16,    18,    62,    66,    66,    18,    53,    66,    54,
-      63,    17,    35,    17,    66,    59,    17,    58,    17,    59,
-      18,    18,    17,    54,   150,   179,   193,   162,   213,   233,
-     209,   227,   157,   185,   112,    86,   210,    -1,   154,    -1,
-     140,    -1,    -1,    93,   113,    -1,    -1,    -1,    -1,   223,
-      -1,    -1,    -1,   227,    -1,    -1,    -1,    -1,    -1,   233
+       4,    99,     0,   175,     0,     3,     0,     3,     7,     3,
+       0,    31,     0,     3,     6,     3,     8,    18,     0,    33,
+     118,     3,    18,    17,    18,    71,     0,    17,    18,     3,
+      71,     0,    33,     0,     3,     0,     3,    39,     3,   137,
+      34,    35,   214,    17,    18,   143,    34,   131,    42,    43,
+      44,    45,    46,    47,     0,    17,     0,     3,    71,     3,
+      54,    53,    60,    18,    58,     0,    60,    65,     3,    65,
+      64,    65,    18,    71,   158,   173,   174,   175,    33,    73,
+      74,    75,    76,    73,    74,    75,    76,    17,    18,    93,
+       0,    95,   176,     3,     0,   193,    65,     3,    65,    73,
+      74,    75,    76,     0,    71,     0,     3,    17,    18,    71,
+      71,    18,     0,    75,     0,     3,   214,     3,    71,    65,
+      17,    18,    66,    67,    34,    35,    33,    18,     8,   133,
+      65,   135,    42,    43,    44,    45,    46,    47,     0,    71,
+       0,     3,    33,     3,    54,     6,    71,     8,    58,     0,
+      60,    16,     3,    16,    64,    65,    18,    17,    18,    16,
+      66,    67,    17,    73,    74,    75,    76,    18,     0,   173,
+     174,     3,    17,    18,    34,    35,    73,    74,    75,    76,
+      66,    67,    42,    43,    44,    45,    46,    47,     0,     0,
+      16,     3,     3,     0,    54,    16,     3,    33,    58,     0,
+      60,    16,     3,    65,    64,    65,    17,    18,    17,    18,
+      17,    18,   216,    73,    74,    75,    76,    18,    73,    74,
+      75,    76,     0,    34,    35,     3,     0,     0,   232,     3,
+       3,    42,    43,    44,    45,    46,    47,   241,     0,   161,
+     162,     3,     0,    54,   248,     3,    55,    58,    57,    60,
+      17,    18,    33,    64,    65,    17,    18,    71,     0,    17,
+      18,     3,    73,    74,    75,    76,    73,    74,    75,    76,
+      36,     0,    34,    35,     3,    17,    18,    17,    18,    71,
+      42,    43,    44,    45,    46,    47,    42,     0,    17,    18,
+       3,     0,    54,    40,     3,     0,    58,     0,    60,    16,
+      17,    18,    64,    65,    16,    18,    37,     0,    71,    18,
+       3,    73,    74,    75,    76,    73,    74,    75,    76,     0,
+       0,     0,     3,     3,     3,    34,     0,     0,    71,     3,
+       3,    73,    74,    75,    76,    37,     0,    71,    55,     3,
+      57,    34,    35,    33,    73,    74,    75,    76,    32,    58,
+      71,    60,    72,    34,     0,    64,    65,     3,    17,    18,
+      73,    74,    75,    76,    71,    58,     0,    60,    37,     3,
+       0,    64,    65,     3,    71,    56,    71,    58,    17,    60,
+      16,    60,     0,    64,    65,     3,    65,    68,    69,    70,
+      71,    72,    56,    42,     0,     0,    60,     3,     3,     0,
+      64,    65,     3,    31,    68,    69,    70,    71,    72,    17,
+      18,    17,    18,    18,    60,    71,    34,    18,    64,    65,
+       0,    16,     0,     3,    30,     3,    60,    33,    34,    35,
+      64,    65,     0,    17,    18,     3,    42,    43,    44,    45,
+      46,    47,    60,    17,    18,    71,    64,    65,    54,    17,
+      18,    33,    58,    17,    60,    60,    62,    63,    64,    65,
+      65,    62,    63,    59,    65,    33,    34,    35,     0,     0,
+       0,     3,     3,     3,    42,    43,    44,    45,    46,    47,
+       0,     0,     0,     3,     3,     3,    54,    65,     0,     6,
+      58,     3,    60,    17,    62,    63,    64,    65,    71,    71,
+      18,     0,    34,    35,     3,     0,    16,    68,     3,     0,
+       0,    71,     3,     3,    34,    35,     0,     0,     0,     3,
+       3,     3,    34,    35,     0,    71,    58,     3,    60,    56,
+      17,    71,    64,    65,    18,    34,    35,    37,    58,    61,
+      60,    42,    60,    34,    64,    65,    58,    65,    60,    17,
+      34,     0,    64,    65,     3,    17,    17,     0,    34,    58,
+       3,    60,    16,    17,    18,    64,    65,    58,     0,    60,
+      60,     3,    17,    64,    65,    65,    60,    42,    60,    17,
+      64,    65,    58,    65,    60,    34,    17,     0,    64,    65,
+       3,    34,     0,    17,    61,     3,    48,    49,    50,    51,
+      52,    55,    34,    57,     0,    18,    46,     3,    71,    58,
+       0,    60,    52,     3,    71,    64,    65,    60,    16,    71,
+      68,    64,    65,    16,    17,    18,    17,    56,    60,     4,
+       5,    17,    64,    65,     9,    10,    11,    12,    13,    14,
+      15,   211,   181,   152,    19,    20,    21,    87,    88,    89,
+      90,   195,    65,    28,    29,    16,    17,    18,    56,   164,
+     219,    36,    55,    38,    57,   215,    41,    16,    17,    18,
+      68,    69,    70,    56,    72,   228,    74,    16,    17,    18,
+      16,    17,    18,   248,   187,    68,    69,    70,    63,    72,
+       0,   112,     0,     3,    55,     3,    57,    48,    49,    50,
+      51,    52,     0,   241,     0,     3,    55,     3,    57,   159,
+      86,     0,    55,    56,     3,    93,    55,   156,    57,    55,
+      71,    57,    56,   140,    75,    68,    69,    70,    71,    72,
+      56,   113,    -1,    -1,    68,    69,    70,    71,    72,    56,
+      -1,    -1,    68,    69,    70,    71,    72,    56,    -1,    -1,
+      -1,    68,    69,    70,    71,    72,    56,    -1,    -1,    68,
+      69,    70,    71,    72,    56,    -1,    -1,    -1,    68,    69,
+      70,    71,    72,    56,    -1,    -1,    68,    69,    70,    71,
+      72,    56,    -1,    -1,    -1,    68,    69,    70,    71,    72,
+      -1,    -1,    -1,    68,    69,    70,    71,    72,    42,    43,
+      44,    45,    46,    47,    22,    23,    24,    25,    26,    27,
+      54,     0,     0,     0,     3,     3,     3,     0,     0,     0,
+       3,     3,     3,     0,     0,     0,     3,     3,     3,     0,
+       0,     0,     3,     3,     3,     0,     0,     0,     3,     3,
+       3,     0,     0,     0,     3,     3,     3,     0,     0,     0,
+       3,     3,     3
 };
 
 /* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
@@ -878,48 +1019,51 @@ static const yytype_int16 yycheck[] =
 static const yytype_uint8 yystos[] =
 {
        0,     4,     5,     9,    10,    11,    12,    13,    14,    15,
-      19,    20,    21,    26,    27,    34,    36,    39,    61,    74,
-      75,    76,    77,    78,    79,    80,    81,    82,    83,    84,
-      85,    86,    87,    92,    97,    98,    99,   109,   125,   126,
-     127,     6,     8,    51,     6,     8,    16,    54,    63,    64,
-      65,    67,    69,    96,   110,   111,    46,    47,    48,    49,
-      50,    66,    70,   112,   113,   115,   116,   118,     7,    29,
-      31,    66,    66,    37,    75,    66,     0,     3,   128,    66,
-      66,     8,    66,    66,   111,   111,    18,    68,    69,    70,
-      71,    28,    31,    18,   114,    16,    66,    66,    34,    40,
-      38,    16,    35,    66,    35,    17,   110,   111,   111,   111,
-     111,    66,    66,   113,    70,   117,   118,    30,    32,   121,
-      66,    96,    67,    66,    89,    66,    35,    66,    18,    56,
-     108,   120,   114,    18,    17,    18,   119,    16,    94,    96,
-     118,   122,   123,    40,    29,    22,    23,    24,    25,    91,
-      18,    88,    16,    66,    66,    57,   107,   108,   121,   118,
-     118,    96,    18,    93,    40,    41,    42,    43,    44,    45,
-      52,   124,   124,    33,    96,     6,    16,    53,    55,    89,
-      17,    66,    16,   120,    66,   121,   107,    62,   103,   119,
-     119,    18,    95,    94,    53,    96,   118,    96,   118,   122,
-     121,    66,    63,    90,    54,    88,    17,    66,    35,   103,
-      59,    58,   100,    96,    17,    93,    17,    17,   122,   100,
-     104,   105,   118,    59,    95,    53,    55,    18,   101,   102,
-     118,    54,   104,    18,    60,    61,   106,   101
+      19,    20,    21,    28,    29,    36,    38,    41,    63,    79,
+      80,    81,    82,    83,    84,    85,    86,    87,    88,    89,
+      90,    91,    92,    99,   104,   105,   106,   117,   133,   134,
+     135,     6,     8,    53,     6,     8,    16,    56,    68,    69,
+      70,    72,    74,   103,   118,   119,    48,    49,    50,    51,
+      52,    71,    75,   120,   121,   123,   124,   126,     7,    31,
+      33,    71,    71,    39,    80,    71,     0,     3,   136,    71,
+      71,     8,    71,    71,   119,   119,    18,    73,    74,    75,
+      76,    30,    33,    18,   122,    16,    71,    71,    36,    42,
+      40,    16,    37,    71,    37,    17,   118,   119,   119,   119,
+     119,    71,    71,   121,    75,   125,   126,    32,    34,   129,
+      71,   103,    72,    71,    96,    71,    37,    71,    18,    58,
+     116,   128,   122,    18,    17,    18,   127,    16,   101,   103,
+     126,   130,   131,    42,    31,    22,    23,    24,    25,    26,
+      27,    98,    18,    95,    16,    71,    71,    59,   115,   116,
+     129,   126,   126,   103,    18,   100,    42,    43,    44,    45,
+      46,    47,    54,   132,   132,    35,   103,     6,    16,    55,
+      57,    96,    17,    71,    16,   128,    71,   129,   115,    64,
+     111,   127,   127,    18,   102,   101,    55,   103,   126,   103,
+     126,   130,   129,    71,    68,    97,    56,    95,    66,    67,
+      93,    94,    17,    71,    37,   111,    61,    60,   107,   103,
+      17,   100,    17,    42,    42,    93,    17,   130,   107,   112,
+     113,   126,    61,    65,   110,   102,    55,    57,    71,    71,
+     110,    18,   108,   109,   126,    68,    56,   112,    18,    62,
+      63,   114,   108
 };
 
 /* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_uint8 yyr1[] =
 {
-       0,    73,    74,    75,    75,    75,    75,    75,    75,    75,
-      75,    75,    75,    75,    75,    75,    75,    75,    75,    75,
-      75,    75,    75,    76,    77,    78,    79,    80,    81,    82,
-      83,    84,    85,    85,    86,    87,    88,    88,    89,    89,
-      89,    89,    89,    89,    90,    91,    91,    91,    91,    92,
-      93,    93,    94,    95,    95,    96,    96,    96,    96,    96,
-      97,    98,    99,    99,   100,   100,   101,   101,   101,   102,
-     103,   103,   104,   104,   104,   105,   106,   106,   106,   107,
-     107,   108,   109,   110,   110,   111,   111,   111,   111,   111,
-     111,   111,   112,   112,   113,   113,   114,   114,   115,   116,
-     116,   116,   116,   116,   117,   117,   117,   117,   118,   118,
-     119,   119,   120,   120,   121,   121,   122,   122,   122,   123,
-     123,   123,   123,   124,   124,   124,   124,   124,   124,   124,
-     124,   125,   126,   127,   128,   128
+       0,    78,    79,    80,    80,    80,    80,    80,    80,    80,
+      80,    80,    80,    80,    80,    80,    80,    80,    80,    80,
+      80,    80,    80,    81,    82,    83,    84,    85,    86,    87,
+      88,    89,    90,    90,    91,    92,    93,    93,    94,    94,
+      95,    95,    96,    96,    96,    96,    96,    96,    97,    98,
+      98,    98,    98,    98,    98,    99,   100,   100,   101,   102,
+     102,   103,   103,   103,   103,   103,   104,   105,   106,   106,
+     107,   107,   108,   108,   108,   109,   110,   110,   111,   111,
+     112,   112,   112,   113,   114,   114,   114,   115,   115,   116,
+     117,   118,   118,   119,   119,   119,   119,   119,   119,   119,
+     120,   120,   121,   121,   122,   122,   123,   124,   124,   124,
+     124,   124,   125,   125,   125,   125,   126,   126,   127,   127,
+     128,   128,   129,   129,   130,   130,   130,   131,   131,   131,
+     131,   132,   132,   132,   132,   132,   132,   132,   132,   133,
+     134,   135,   136,   136
 };
 
 /* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
@@ -928,17 +1072,18 @@ static const yytype_int8 yyr2[] =
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     3,
-       2,     2,     8,     9,     5,     7,     0,     3,     5,     2,
-       7,     4,     6,     3,     1,     1,     1,     1,     1,     6,
-       0,     3,     4,     0,     3,     1,     1,     1,     1,     1,
-       4,     7,     8,     9,     0,     3,     0,     1,     3,     2,
-       0,     3,     0,     1,     3,     1,     0,     1,     1,     0,
-       2,     5,     2,     1,     3,     3,     3,     3,     3,     3,
-       2,     1,     1,     2,     1,     1,     0,     3,     4,     1,
-       1,     1,     1,     1,     1,     4,     2,     0,     1,     3,
-       0,     3,     0,     3,     0,     2,     0,     1,     3,     3,
-       3,     3,     3,     1,     1,     1,     1,     1,     1,     1,
-       2,     7,     2,     4,     0,     1
+       2,     2,     8,     9,     5,     8,     0,     2,     3,     3,
+       0,     3,     5,     2,     7,     4,     6,     3,     1,     1,
+       1,     1,     1,     1,     1,     6,     0,     3,     4,     0,
+       3,     1,     1,     1,     1,     1,     4,     7,     9,    10,
+       0,     3,     0,     1,     3,     2,     0,     2,     0,     3,
+       0,     1,     3,     1,     0,     1,     1,     0,     2,     5,
+       2,     1,     3,     3,     3,     3,     3,     3,     2,     1,
+       1,     2,     1,     1,     0,     3,     4,     1,     1,     1,
+       1,     1,     1,     4,     2,     0,     1,     3,     0,     3,
+       0,     3,     0,     2,     0,     1,     3,     3,     3,     3,
+       3,     1,     1,     1,     1,     1,     1,     1,     2,     7,
+       2,     4,     0,     1
 };
 
 
@@ -1800,93 +1945,93 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* commands: command_wrapper opt_semicolon  */
-#line 222 "yacc_sql.y"
+#line 234 "yacc_sql.y"
   {
     std::unique_ptr<ParsedSqlNode> sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[-1].sql_node));
     sql_result->add_sql_node(std::move(sql_node));
   }
-#line 1809 "yacc_sql.cpp"
+#line 1954 "yacc_sql.cpp"
     break;
 
   case 23: /* exit_stmt: EXIT  */
-#line 252 "yacc_sql.y"
+#line 264 "yacc_sql.y"
          {
       (void)yynerrs;  // 这么写为了消除yynerrs未使用的告警。如果你有更好的方法欢迎提PR
       (yyval.sql_node) = new ParsedSqlNode(SCF_EXIT);
     }
-#line 1818 "yacc_sql.cpp"
+#line 1963 "yacc_sql.cpp"
     break;
 
   case 24: /* help_stmt: HELP  */
-#line 258 "yacc_sql.y"
+#line 270 "yacc_sql.y"
          {
       (yyval.sql_node) = new ParsedSqlNode(SCF_HELP);
     }
-#line 1826 "yacc_sql.cpp"
+#line 1971 "yacc_sql.cpp"
     break;
 
   case 25: /* sync_stmt: SYNC  */
-#line 263 "yacc_sql.y"
+#line 275 "yacc_sql.y"
          {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SYNC);
     }
-#line 1834 "yacc_sql.cpp"
+#line 1979 "yacc_sql.cpp"
     break;
 
   case 26: /* begin_stmt: TRX_BEGIN  */
-#line 269 "yacc_sql.y"
+#line 281 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_BEGIN);
     }
-#line 1842 "yacc_sql.cpp"
+#line 1987 "yacc_sql.cpp"
     break;
 
   case 27: /* commit_stmt: TRX_COMMIT  */
-#line 275 "yacc_sql.y"
+#line 287 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_COMMIT);
     }
-#line 1850 "yacc_sql.cpp"
+#line 1995 "yacc_sql.cpp"
     break;
 
   case 28: /* rollback_stmt: TRX_ROLLBACK  */
-#line 281 "yacc_sql.y"
+#line 293 "yacc_sql.y"
                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_ROLLBACK);
     }
-#line 1858 "yacc_sql.cpp"
+#line 2003 "yacc_sql.cpp"
     break;
 
   case 29: /* drop_table_stmt: DROP TABLE ID  */
-#line 287 "yacc_sql.y"
+#line 299 "yacc_sql.y"
                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_TABLE);
       (yyval.sql_node)->drop_table.relation_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 1868 "yacc_sql.cpp"
+#line 2013 "yacc_sql.cpp"
     break;
 
   case 30: /* show_tables_stmt: SHOW TABLES  */
-#line 294 "yacc_sql.y"
+#line 306 "yacc_sql.y"
                 {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_TABLES);
     }
-#line 1876 "yacc_sql.cpp"
+#line 2021 "yacc_sql.cpp"
     break;
 
   case 31: /* desc_table_stmt: DESC_T ID  */
-#line 300 "yacc_sql.y"
+#line 312 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DESC_TABLE);
       (yyval.sql_node)->desc_table.relation_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 1886 "yacc_sql.cpp"
+#line 2031 "yacc_sql.cpp"
     break;
 
   case 32: /* create_index_stmt: CREATE INDEX ID ON ID LBRACE ID RBRACE  */
-#line 309 "yacc_sql.y"
+#line 321 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
       CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
@@ -1898,11 +2043,11 @@ yyreduce:
       free((yyvsp[-3].string));
       free((yyvsp[-1].string));
     }
-#line 1902 "yacc_sql.cpp"
+#line 2047 "yacc_sql.cpp"
     break;
 
   case 33: /* create_index_stmt: CREATE UNIQUE INDEX ID ON ID LBRACE ID RBRACE  */
-#line 321 "yacc_sql.y"
+#line 333 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
       CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
@@ -1914,11 +2059,11 @@ yyreduce:
       free((yyvsp[-3].string));
       free((yyvsp[-1].string));
     }
-#line 1918 "yacc_sql.cpp"
+#line 2063 "yacc_sql.cpp"
     break;
 
   case 34: /* drop_index_stmt: DROP INDEX ID ON ID  */
-#line 336 "yacc_sql.y"
+#line 348 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_INDEX);
       (yyval.sql_node)->drop_index.index_name = (yyvsp[-2].string);
@@ -1926,39 +2071,89 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].string));
     }
-#line 1930 "yacc_sql.cpp"
+#line 2075 "yacc_sql.cpp"
     break;
 
-  case 35: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE  */
-#line 346 "yacc_sql.y"
+  case 35: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE table_option_list  */
+#line 358 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_TABLE);
       CreateTableSqlNode &create_table = (yyval.sql_node)->create_table;
-      create_table.relation_name = (yyvsp[-4].string);
-      free((yyvsp[-4].string));
+      create_table.relation_name = (yyvsp[-5].string);
+      free((yyvsp[-5].string));
+
+      if ((yyvsp[0].table_option_list) != nullptr) {
+        create_table.options.swap(*(yyvsp[0].table_option_list));
+        std::reverse(create_table.options.begin(), create_table.options.end());
+        delete (yyvsp[0].table_option_list);
+      }
 
-      std::vector<AttrInfoSqlNode> *src_attrs = (yyvsp[-1].attr_infos);
+      std::vector<AttrInfoSqlNode> *src_attrs = (yyvsp[-2].attr_infos);
 
       if (src_attrs != nullptr) {
         create_table.attr_infos.swap(*src_attrs);
       }
-      create_table.attr_infos.emplace_back(*(yyvsp[-2].attr_info));
+      create_table.attr_infos.emplace_back(*(yyvsp[-3].attr_info));
       std::reverse(create_table.attr_infos.begin(), create_table.attr_infos.end());
-      delete (yyvsp[-2].attr_info);
+      delete (yyvsp[-3].attr_info);
+    }
+#line 2101 "yacc_sql.cpp"
+    break;
+
+  case 36: /* table_option_list: %empty  */
+#line 382 "yacc_sql.y"
+    {
+      (yyval.table_option_list) = nullptr;
+    }
+#line 2109 "yacc_sql.cpp"
+    break;
+
+  case 37: /* table_option_list: table_option table_option_list  */
+#line 386 "yacc_sql.y"
+    {
+      if ((yyvsp[0].table_option_list) != nullptr) {
+        (yyval.table_option_list) = (yyvsp[0].table_option_list);
+      } else {
+        (yyval.table_option_list) = new std::vector<TableOptionSqlNode>;
+      }
+      (yyval.table_option_list)->emplace_back(*(yyvsp[-1].table_option));
+      delete (yyvsp[-1].table_option);
     }
-#line 1950 "yacc_sql.cpp"
+#line 2123 "yacc_sql.cpp"
     break;
 
-  case 36: /* attr_def_list: %empty  */
-#line 364 "yacc_sql.y"
+  case 38: /* table_option: STORAGE EQ ID  */
+#line 398 "yacc_sql.y"
+    {
+      (yyval.table_option) = new TableOptionSqlNode;
+      (yyval.table_option)->type = TableOptionType::STORAGE;
+      (yyval.table_option)->value = (yyvsp[0].string);
+      free((yyvsp[0].string));
+    }
+#line 2134 "yacc_sql.cpp"
+    break;
+
+  case 39: /* table_option: COMPRESSION EQ ID  */
+#line 405 "yacc_sql.y"
+    {
+      (yyval.table_option) = new TableOptionSqlNode;
+      (yyval.table_option)->type = TableOptionType::COMPRESSION;
+      (yyval.table_option)->value = (yyvsp[0].string);
+      free((yyvsp[0].string));
+    }
+#line 2145 "yacc_sql.cpp"
+    break;
+
+  case 40: /* attr_def_list: %empty  */
+#line 414 "yacc_sql.y"
     {
       (yyval.attr_infos) = nullptr;
     }
-#line 1958 "yacc_sql.cpp"
+#line 2153 "yacc_sql.cpp"
     break;
 
-  case 37: /* attr_def_list: COMMA attr_def attr_def_list  */
-#line 368 "yacc_sql.y"
+  case 41: /* attr_def_list: COMMA attr_def attr_def_list  */
+#line 418 "yacc_sql.y"
     {
       if ((yyvsp[0].attr_infos) != nullptr) {
         (yyval.attr_infos) = (yyvsp[0].attr_infos);
@@ -1968,11 +2163,11 @@ yyreduce:
       (yyval.attr_infos)->emplace_back(*(yyvsp[-1].attr_info));
       delete (yyvsp[-1].attr_info);
     }
-#line 1972 "yacc_sql.cpp"
+#line 2167 "yacc_sql.cpp"
     break;
 
-  case 38: /* attr_def: ID type LBRACE number RBRACE  */
-#line 381 "yacc_sql.y"
+  case 42: /* attr_def: ID type LBRACE number RBRACE  */
+#line 431 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-3].number);
@@ -1981,11 +2176,11 @@ yyreduce:
       (yyval.attr_info)->nullable=false;
       free((yyvsp[-4].string));
     }
-#line 1985 "yacc_sql.cpp"
+#line 2180 "yacc_sql.cpp"
     break;
 
-  case 39: /* attr_def: ID type  */
-#line 390 "yacc_sql.y"
+  case 43: /* attr_def: ID type  */
+#line 440 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[0].number);
@@ -1994,11 +2189,11 @@ yyreduce:
       (yyval.attr_info)->nullable=false;
       free((yyvsp[-1].string));
     }
-#line 1998 "yacc_sql.cpp"
+#line 2193 "yacc_sql.cpp"
     break;
 
-  case 40: /* attr_def: ID type LBRACE number RBRACE NOT NULL_T  */
-#line 399 "yacc_sql.y"
+  case 44: /* attr_def: ID type LBRACE number RBRACE NOT NULL_T  */
+#line 449 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-5].number);
@@ -2007,11 +2202,11 @@ yyreduce:
       (yyval.attr_info)->nullable=false;
       free((yyvsp[-6].string));
     }
-#line 2011 "yacc_sql.cpp"
+#line 2206 "yacc_sql.cpp"
     break;
 
-  case 41: /* attr_def: ID type NOT NULL_T  */
-#line 408 "yacc_sql.y"
+  case 45: /* attr_def: ID type NOT NULL_T  */
+#line 458 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-2].number);
@@ -2020,11 +2215,11 @@ yyreduce:
       (yyval.attr_info)->nullable=false;
       free((yyvsp[-3].string));
     }
-#line 2024 "yacc_sql.cpp"
+#line 2219 "yacc_sql.cpp"
     break;
 
-  case 42: /* attr_def: ID type LBRACE number RBRACE NULLABLE  */
-#line 417 "yacc_sql.y"
+  case 46: /* attr_def: ID type LBRACE number RBRACE NULLABLE  */
+#line 467 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-4].number);
@@ -2033,11 +2228,11 @@ yyreduce:
       (yyval.attr_info)->nullable=true;
       free((yyvsp[-5].string));
     }
-#line 2037 "yacc_sql.cpp"
+#line 2232 "yacc_sql.cpp"
     break;
 
-  case 43: /* attr_def: ID type NULLABLE  */
-#line 426 "yacc_sql.y"
+  case 47: /* attr_def: ID type NULLABLE  */
+#line 476 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-1].number);
@@ -2046,41 +2241,53 @@ yyreduce:
       (yyval.attr_info)->nullable=true;
       free((yyvsp[-2].string));
     }
-#line 2050 "yacc_sql.cpp"
+#line 2245 "yacc_sql.cpp"
     break;
 
-  case 44: /* number: NUMBER  */
-#line 437 "yacc_sql.y"
+  case 48: /* number: NUMBER  */
+#line 487 "yacc_sql.y"
            {(yyval.number) = (yyvsp[0].number);}
-#line 2056 "yacc_sql.cpp"
+#line 2251 "yacc_sql.cpp"
     break;
 
-  case 45: /* type: INT_T  */
-#line 440 "yacc_sql.y"
+  case 49: /* type: INT_T  */
+#line 490 "yacc_sql.y"
                { (yyval.number)=INTS; }
-#line 2062 "yacc_sql.cpp"
+#line 2257 "yacc_sql.cpp"
     break;
 
-  case 46: /* type: STRING_T  */
-#line 441 "yacc_sql.y"
+  case 50: /* type: STRING_T  */
+#line 491 "yacc_sql.y"
                { (yyval.number)=CHARS; }
-#line 2068 "yacc_sql.cpp"
+#line 2263 "yacc_sql.cpp"
     break;
 
-  case 47: /* type: FLOAT_T  */
-#line 442 "yacc_sql.y"
+  case 51: /* type: FLOAT_T  */
+#line 492 "yacc_sql.y"
                { (yyval.number)=FLOATS; }
-#line 2074 "yacc_sql.cpp"
+#line 2269 "yacc_sql.cpp"
     break;
 
-  case 48: /* type: DATE_T  */
-#line 443 "yacc_sql.y"
+  case 52: /* type: DATE_T  */
+#line 493 "yacc_sql.y"
                { (yyval.number)=DATES; }
-#line 2080 "yacc_sql.cpp"
+#line 2275 "yacc_sql.cpp"
+    break;
+
+  case 53: /* type: VARCHAR_T  */
+#line 494 "yacc_sql.y"
+                { (yyval.number)=VARCHARS; }
+#line 2281 "yacc_sql.cpp"
+    break;
+
+  case 54: /* type: TEXT_T  */
+#line 495 "yacc_sql.y"
+               { (yyval.number)=TEXTS; }
+#line 2287 "yacc_sql.cpp"
     break;
 
-  case 49: /* insert_stmt: INSERT INTO ID VALUES raw_tuple raw_tuple_list  */
-#line 447 "yacc_sql.y"
+  case 55: /* insert_stmt: INSERT INTO ID VALUES raw_tuple raw_tuple_list  */
+#line 499 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_INSERT);
       (yyval.sql_node)->insertion.relation_name = (yyvsp[-3].string);
@@ -2091,19 +2298,19 @@ yyreduce:
       std::reverse((yyval.sql_node)->insertion.tuples.begin(), (yyval.sql_node)->insertion.tuples.end());
       free((yyvsp[-3].string));
     }
-#line 2095 "yacc_sql.cpp"
+#line 2302 "yacc_sql.cpp"
     break;
 
-  case 50: /* raw_tuple_list: %empty  */
-#line 460 "yacc_sql.y"
+  case 56: /* raw_tuple_list: %empty  */
+#line 512 "yacc_sql.y"
     {
       (yyval.raw_tuple_list) = nullptr;
     }
-#line 2103 "yacc_sql.cpp"
+#line 2310 "yacc_sql.cpp"
     break;
 
-  case 51: /* raw_tuple_list: COMMA raw_tuple raw_tuple_list  */
-#line 463 "yacc_sql.y"
+  case 57: /* raw_tuple_list: COMMA raw_tuple raw_tuple_list  */
+#line 515 "yacc_sql.y"
                                       { 
       if ((yyvsp[0].raw_tuple_list) != nullptr) {
         (yyval.raw_tuple_list) = (yyvsp[0].raw_tuple_list);
@@ -2113,11 +2320,11 @@ yyreduce:
       (yyval.raw_tuple_list)->emplace_back(*(yyvsp[-1].raw_tuple));
       delete (yyvsp[-1].raw_tuple);
     }
-#line 2117 "yacc_sql.cpp"
+#line 2324 "yacc_sql.cpp"
     break;
 
-  case 52: /* raw_tuple: LBRACE value value_list RBRACE  */
-#line 474 "yacc_sql.y"
+  case 58: /* raw_tuple: LBRACE value value_list RBRACE  */
+#line 526 "yacc_sql.y"
                                    {
       if ((yyvsp[-1].value_list) != nullptr) {
         (yyval.raw_tuple) = (yyvsp[-1].value_list);
@@ -2128,19 +2335,19 @@ yyreduce:
       std::reverse((yyval.raw_tuple)->begin(), (yyval.raw_tuple)->end());
       delete (yyvsp[-2].value);
     }
-#line 2132 "yacc_sql.cpp"
+#line 2339 "yacc_sql.cpp"
     break;
 
-  case 53: /* value_list: %empty  */
-#line 486 "yacc_sql.y"
+  case 59: /* value_list: %empty  */
+#line 538 "yacc_sql.y"
     {
       (yyval.value_list) = nullptr;
     }
-#line 2140 "yacc_sql.cpp"
+#line 2347 "yacc_sql.cpp"
     break;
 
-  case 54: /* value_list: COMMA value value_list  */
-#line 489 "yacc_sql.y"
+  case 60: /* value_list: COMMA value value_list  */
+#line 541 "yacc_sql.y"
                               { 
       if ((yyvsp[0].value_list) != nullptr) {
         (yyval.value_list) = (yyvsp[0].value_list);
@@ -2150,55 +2357,55 @@ yyreduce:
       (yyval.value_list)->emplace_back(*(yyvsp[-1].value));
       delete (yyvsp[-1].value);
     }
-#line 2154 "yacc_sql.cpp"
+#line 2361 "yacc_sql.cpp"
     break;
 
-  case 55: /* value: NUMBER  */
-#line 500 "yacc_sql.y"
+  case 61: /* value: NUMBER  */
+#line 552 "yacc_sql.y"
            {
       (yyval.value) = new Value((int)(yyvsp[0].number));
       (yyloc) = (yylsp[0]);
     }
-#line 2163 "yacc_sql.cpp"
+#line 2370 "yacc_sql.cpp"
     break;
 
-  case 56: /* value: FLOAT  */
-#line 504 "yacc_sql.y"
+  case 62: /* value: FLOAT  */
+#line 556 "yacc_sql.y"
            {
       (yyval.value) = new Value((float)(yyvsp[0].floats));
       (yyloc) = (yylsp[0]);
     }
-#line 2172 "yacc_sql.cpp"
+#line 2379 "yacc_sql.cpp"
     break;
 
-  case 57: /* value: DATE  */
-#line 508 "yacc_sql.y"
+  case 63: /* value: DATE  */
+#line 560 "yacc_sql.y"
           {
       (yyval.value) = new Value((date)(yyvsp[0].dates));
     }
-#line 2180 "yacc_sql.cpp"
+#line 2387 "yacc_sql.cpp"
     break;
 
-  case 58: /* value: NULL_T  */
-#line 511 "yacc_sql.y"
+  case 64: /* value: NULL_T  */
+#line 563 "yacc_sql.y"
             {
       (yyval.value) = new Value(NULLS);
     }
-#line 2188 "yacc_sql.cpp"
+#line 2395 "yacc_sql.cpp"
     break;
 
-  case 59: /* value: SSS  */
-#line 514 "yacc_sql.y"
+  case 65: /* value: SSS  */
+#line 566 "yacc_sql.y"
          {
       char *tmp = common::substr((yyvsp[0].string),1,strlen((yyvsp[0].string))-2);
       (yyval.value) = new Value(tmp);
       free(tmp);
     }
-#line 2198 "yacc_sql.cpp"
+#line 2405 "yacc_sql.cpp"
     break;
 
-  case 60: /* delete_stmt: DELETE FROM ID where  */
-#line 523 "yacc_sql.y"
+  case 66: /* delete_stmt: DELETE FROM ID where  */
+#line 575 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DELETE);
       (yyval.sql_node)->deletion.relation_name = (yyvsp[-1].string);
@@ -2208,11 +2415,11 @@ yyreduce:
       }
       free((yyvsp[-1].string));
     }
-#line 2212 "yacc_sql.cpp"
+#line 2419 "yacc_sql.cpp"
     break;
 
-  case 61: /* update_stmt: UPDATE ID SET ID EQ value where  */
-#line 535 "yacc_sql.y"
+  case 67: /* update_stmt: UPDATE ID SET ID EQ value where  */
+#line 587 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_UPDATE);
       (yyval.sql_node)->update.relation_name = (yyvsp[-5].string);
@@ -2225,216 +2432,234 @@ yyreduce:
       free((yyvsp[-5].string));
       free((yyvsp[-3].string));
     }
-#line 2229 "yacc_sql.cpp"
+#line 2436 "yacc_sql.cpp"
     break;
 
-  case 62: /* select_stmt: SELECT select_exprs FROM ID rel_list where group order  */
-#line 550 "yacc_sql.y"
+  case 68: /* select_stmt: SELECT select_exprs FROM ID rel_list where group order limit  */
+#line 602 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SELECT);
-      if ((yyvsp[-6].s_expr_node_list) != nullptr) {
-        (yyval.sql_node)->selection.select_exprs.swap(*(yyvsp[-6].s_expr_node_list));
-        delete (yyvsp[-6].s_expr_node_list);
+      if ((yyvsp[-7].s_expr_node_list) != nullptr) {
+        (yyval.sql_node)->selection.select_exprs.swap(*(yyvsp[-7].s_expr_node_list));
+        delete (yyvsp[-7].s_expr_node_list);
       }
-      if ((yyvsp[-3].relation_list) != nullptr) {
-        (yyval.sql_node)->selection.relations.swap(*(yyvsp[-3].relation_list));
-        delete (yyvsp[-3].relation_list);
+      if ((yyvsp[-4].relation_list) != nullptr) {
+        (yyval.sql_node)->selection.relations.swap(*(yyvsp[-4].relation_list));
+        delete (yyvsp[-4].relation_list);
       }
-      (yyval.sql_node)->selection.relations.push_back((yyvsp[-4].string));
+      (yyval.sql_node)->selection.relations.push_back((yyvsp[-5].string));
       std::reverse((yyval.sql_node)->selection.relations.begin(), (yyval.sql_node)->selection.relations.end());
       
-      if ((yyvsp[-2].condition_list) != nullptr) {
-        (yyval.sql_node)->selection.conditions.swap(*(yyvsp[-2].condition_list));
-        delete (yyvsp[-2].condition_list);
+      if ((yyvsp[-3].condition_list) != nullptr) {
+        (yyval.sql_node)->selection.conditions.swap(*(yyvsp[-3].condition_list));
+        delete (yyvsp[-3].condition_list);
       }
-      if ((yyvsp[-1].group_node_list) != nullptr) {
-        (yyval.sql_node)->selection.groups.swap(*(yyvsp[-1].group_node_list));
-        delete (yyvsp[-1].group_node_list);
+      if ((yyvsp[-2].group_node_list) != nullptr) {
+        (yyval.sql_node)->selection.groups.swap(*(yyvsp[-2].group_node_list));
+        delete (yyvsp[-2].group_node_list);
       }
-      if ((yyvsp[0].order_node_list) != nullptr) {
-        (yyval.sql_node)->selection.orders.swap(*(yyvsp[0].order_node_list));
-        delete (yyvsp[0].order_node_list);
+      if ((yyvsp[-1].order_node_list) != nullptr) {
+        (yyval.sql_node)->selection.orders.swap(*(yyvsp[-1].order_node_list));
+        delete (yyvsp[-1].order_node_list);
       }
-      free((yyvsp[-4].string));
+      (yyval.sql_node)->selection.limit = (yyvsp[0].number);
+      free((yyvsp[-5].string));
     }
-#line 2261 "yacc_sql.cpp"
+#line 2469 "yacc_sql.cpp"
     break;
 
-  case 63: /* select_stmt: SELECT select_exprs FROM ID join_node join_list where group order  */
-#line 578 "yacc_sql.y"
+  case 69: /* select_stmt: SELECT select_exprs FROM ID join_node join_list where group order limit  */
+#line 631 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SELECT);
-      if ((yyvsp[-7].s_expr_node_list) != nullptr) {
-        (yyval.sql_node)->selection.select_exprs.swap(*(yyvsp[-7].s_expr_node_list));
-        delete (yyvsp[-7].s_expr_node_list);
+      if ((yyvsp[-8].s_expr_node_list) != nullptr) {
+        (yyval.sql_node)->selection.select_exprs.swap(*(yyvsp[-8].s_expr_node_list));
+        delete (yyvsp[-8].s_expr_node_list);
       }
-      if ((yyvsp[-3].join_list) != nullptr) {
-        (yyval.sql_node)->selection.joins.swap(*(yyvsp[-3].join_list));
-        delete (yyvsp[-3].join_list);
+      if ((yyvsp[-4].join_list) != nullptr) {
+        (yyval.sql_node)->selection.joins.swap(*(yyvsp[-4].join_list));
+        delete (yyvsp[-4].join_list);
       }
-      (yyval.sql_node)->selection.joins.emplace_back(*(yyvsp[-4].join_node));
+      (yyval.sql_node)->selection.joins.emplace_back(*(yyvsp[-5].join_node));
       std::reverse((yyval.sql_node)->selection.joins.begin(), (yyval.sql_node)->selection.joins.end());
-      (yyval.sql_node)->selection.relations.push_back((yyvsp[-5].string));
-      if ((yyvsp[-2].condition_list) != nullptr) {
-        (yyval.sql_node)->selection.conditions.swap(*(yyvsp[-2].condition_list));
-        delete (yyvsp[-2].condition_list);
+      (yyval.sql_node)->selection.relations.push_back((yyvsp[-6].string));
+      if ((yyvsp[-3].condition_list) != nullptr) {
+        (yyval.sql_node)->selection.conditions.swap(*(yyvsp[-3].condition_list));
+        delete (yyvsp[-3].condition_list);
       }
-      if ((yyvsp[-1].group_node_list) != nullptr) {
-        (yyval.sql_node)->selection.groups.swap(*(yyvsp[-1].group_node_list));
-        delete (yyvsp[-1].group_node_list);
+      if ((yyvsp[-2].group_node_list) != nullptr) {
+        (yyval.sql_node)->selection.groups.swap(*(yyvsp[-2].group_node_list));
+        delete (yyvsp[-2].group_node_list);
       }
-      if ((yyvsp[0].order_node_list) != nullptr) {
-        (yyval.sql_node)->selection.orders.swap(*(yyvsp[0].order_node_list));
-        delete (yyvsp[0].order_node_list);
+      if ((yyvsp[-1].order_node_list) != nullptr) {
+        (yyval.sql_node)->selection.orders.swap(*(yyvsp[-1].order_node_list));
+        delete (yyvsp[-1].order_node_list);
       }
-      free((yyvsp[-5].string));
+      (yyval.sql_node)->selection.limit = (yyvsp[0].number);
+      free((yyvsp[-6].string));
     }
-#line 2293 "yacc_sql.cpp"
+#line 2502 "yacc_sql.cpp"
     break;
 
-  case 64: /* order: %empty  */
-#line 608 "yacc_sql.y"
+  case 70: /* order: %empty  */
+#line 662 "yacc_sql.y"
     {
       (yyval.order_node_list) = nullptr;
     }
-#line 2301 "yacc_sql.cpp"
+#line 2510 "yacc_sql.cpp"
     break;
 
-  case 65: /* order: ORDER BY order_node_list  */
-#line 612 "yacc_sql.y"
+  case 71: /* order: ORDER BY order_node_list  */
+#line 666 "yacc_sql.y"
     {
       (yyval.order_node_list) = (yyvsp[0].order_node_list);
       std::reverse((yyval.order_node_list)->begin(), (yyval.order_node_list)->end());
     }
-#line 2310 "yacc_sql.cpp"
+#line 2519 "yacc_sql.cpp"
     break;
 
-  case 66: /* order_node_list: %empty  */
-#line 618 "yacc_sql.y"
+  case 72: /* order_node_list: %empty  */
+#line 672 "yacc_sql.y"
     {
       (yyval.order_node_list) = nullptr;
     }
-#line 2318 "yacc_sql.cpp"
+#line 2527 "yacc_sql.cpp"
     break;
 
-  case 67: /* order_node_list: order_node  */
-#line 621 "yacc_sql.y"
+  case 73: /* order_node_list: order_node  */
+#line 675 "yacc_sql.y"
                  {
       (yyval.order_node_list) = new std::vector<OrderSqlNode>;
       (yyval.order_node_list)->emplace_back(*(yyvsp[0].order_node));
       delete (yyvsp[0].order_node);
     }
-#line 2328 "yacc_sql.cpp"
+#line 2537 "yacc_sql.cpp"
     break;
 
-  case 68: /* order_node_list: order_node COMMA order_node_list  */
-#line 626 "yacc_sql.y"
+  case 74: /* order_node_list: order_node COMMA order_node_list  */
+#line 680 "yacc_sql.y"
                                        {
       (yyval.order_node_list) = (yyvsp[0].order_node_list);
       (yyval.order_node_list)->emplace_back(*(yyvsp[-2].order_node));
       delete (yyvsp[-2].order_node);
     }
-#line 2338 "yacc_sql.cpp"
+#line 2547 "yacc_sql.cpp"
     break;
 
-  case 69: /* order_node: rel_attr order_type  */
-#line 633 "yacc_sql.y"
+  case 75: /* order_node: rel_attr order_type  */
+#line 687 "yacc_sql.y"
     {
       (yyval.order_node) = new OrderSqlNode;
       (yyval.order_node)->type=(yyvsp[0].order_type);
       (yyval.order_node)->attribute=*(yyvsp[-1].rel_attr);
       free((yyvsp[-1].rel_attr));
     }
-#line 2349 "yacc_sql.cpp"
+#line 2558 "yacc_sql.cpp"
+    break;
+
+  case 76: /* limit: %empty  */
+#line 695 "yacc_sql.y"
+    {
+      (yyval.number) = -1;
+    }
+#line 2566 "yacc_sql.cpp"
     break;
 
-  case 70: /* group: %empty  */
-#line 641 "yacc_sql.y"
+  case 77: /* limit: LIMIT NUMBER  */
+#line 699 "yacc_sql.y"
+    {
+      (yyval.number) = (yyvsp[0].number);
+    }
+#line 2574 "yacc_sql.cpp"
+    break;
+
+  case 78: /* group: %empty  */
+#line 705 "yacc_sql.y"
     {
       (yyval.group_node_list) = nullptr;
     }
-#line 2357 "yacc_sql.cpp"
+#line 2582 "yacc_sql.cpp"
     break;
 
-  case 71: /* group: GROUP BY group_node_list  */
-#line 645 "yacc_sql.y"
+  case 79: /* group: GROUP BY group_node_list  */
+#line 709 "yacc_sql.y"
     {
       (yyval.group_node_list) = (yyvsp[0].group_node_list);
       std::reverse((yyval.group_node_list)->begin(), (yyval.group_node_list)->end());
     }
-#line 2366 "yacc_sql.cpp"
+#line 2591 "yacc_sql.cpp"
     break;
 
-  case 72: /* group_node_list: %empty  */
-#line 651 "yacc_sql.y"
+  case 80: /* group_node_list: %empty  */
+#line 715 "yacc_sql.y"
     {
       (yyval.group_node_list) = nullptr;
     }
-#line 2374 "yacc_sql.cpp"
+#line 2599 "yacc_sql.cpp"
     break;
 
-  case 73: /* group_node_list: group_node  */
-#line 654 "yacc_sql.y"
+  case 81: /* group_node_list: group_node  */
+#line 718 "yacc_sql.y"
                  {
       (yyval.group_node_list) = new std::vector<GroupSqlNode>;
       (yyval.group_node_list)->emplace_back(*(yyvsp[0].group_node));
       delete (yyvsp[0].group_node);
     }
-#line 2384 "yacc_sql.cpp"
+#line 2609 "yacc_sql.cpp"
     break;
 
-  case 74: /* group_node_list: group_node COMMA group_node_list  */
-#line 659 "yacc_sql.y"
+  case 82: /* group_node_list: group_node COMMA group_node_list  */
+#line 723 "yacc_sql.y"
                                        {
       (yyval.group_node_list) = (yyvsp[0].group_node_list);
       (yyval.group_node_list)->emplace_back(*(yyvsp[-2].group_node));
       delete (yyvsp[-2].group_node);
     }
-#line 2394 "yacc_sql.cpp"
+#line 2619 "yacc_sql.cpp"
     break;
 
-  case 75: /* group_node: rel_attr  */
-#line 666 "yacc_sql.y"
+  case 83: /* group_node: rel_attr  */
+#line 730 "yacc_sql.y"
     {
       (yyval.group_node) = (yyvsp[0].rel_attr);
     }
-#line 2402 "yacc_sql.cpp"
+#line 2627 "yacc_sql.cpp"
     break;
 
-  case 76: /* order_type: %empty  */
-#line 671 "yacc_sql.y"
+  case 84: /* order_type: %empty  */
+#line 735 "yacc_sql.y"
     {
       (yyval.order_type) = ASC;
     }
-#line 2410 "yacc_sql.cpp"
+#line 2635 "yacc_sql.cpp"
     break;
 
-  case 77: /* order_type: ASC_T  */
-#line 674 "yacc_sql.y"
+  case 85: /* order_type: ASC_T  */
+#line 738 "yacc_sql.y"
             {
       (yyval.order_type) = ASC;
     }
-#line 2418 "yacc_sql.cpp"
+#line 2643 "yacc_sql.cpp"
     break;
 
-  case 78: /* order_type: DESC_T  */
-#line 677 "yacc_sql.y"
+  case 86: /* order_type: DESC_T  */
+#line 741 "yacc_sql.y"
              {
       (yyval.order_type) = DESC;
     }
-#line 2426 "yacc_sql.cpp"
+#line 2651 "yacc_sql.cpp"
     break;
 
-  case 79: /* join_list: %empty  */
-#line 683 "yacc_sql.y"
+  case 87: /* join_list: %empty  */
+#line 747 "yacc_sql.y"
     {
       (yyval.join_list) = nullptr;
     }
-#line 2434 "yacc_sql.cpp"
+#line 2659 "yacc_sql.cpp"
     break;
 
-  case 80: /* join_list: join_node join_list  */
-#line 686 "yacc_sql.y"
+  case 88: /* join_list: join_node join_list  */
+#line 750 "yacc_sql.y"
                            { 
       if ((yyvsp[0].join_list) != nullptr) {
         (yyval.join_list) = (yyvsp[0].join_list);
@@ -2444,11 +2669,11 @@ yyreduce:
       (yyval.join_list)->emplace_back(*(yyvsp[-1].join_node));
       delete (yyvsp[-1].join_node);
     }
-#line 2448 "yacc_sql.cpp"
+#line 2673 "yacc_sql.cpp"
     break;
 
-  case 81: /* join_node: INNER JOIN ID ON condition_list  */
-#line 698 "yacc_sql.y"
+  case 89: /* join_node: INNER JOIN ID ON condition_list  */
+#line 762 "yacc_sql.y"
     {
       (yyval.join_node) = new JoinSqlNode;
       if ((yyvsp[0].condition_list) != nullptr) {
@@ -2458,31 +2683,31 @@ yyreduce:
       free((yyvsp[-2].string));
       delete (yyvsp[0].condition_list);
     }
-#line 2462 "yacc_sql.cpp"
+#line 2687 "yacc_sql.cpp"
     break;
 
-  case 82: /* calc_stmt: CALC expression_list  */
-#line 709 "yacc_sql.y"
+  case 90: /* calc_stmt: CALC expression_list  */
+#line 773 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CALC);
       std::reverse((yyvsp[0].expression_list)->begin(), (yyvsp[0].expression_list)->end());
       (yyval.sql_node)->calc.expressions.swap(*(yyvsp[0].expression_list));
       delete (yyvsp[0].expression_list);
     }
-#line 2473 "yacc_sql.cpp"
+#line 2698 "yacc_sql.cpp"
     break;
 
-  case 83: /* expression_list: expression  */
-#line 719 "yacc_sql.y"
+  case 91: /* expression_list: expression  */
+#line 783 "yacc_sql.y"
     {
       (yyval.expression_list) = new std::vector<Expression*>;
       (yyval.expression_list)->emplace_back((yyvsp[0].expression));
     }
-#line 2482 "yacc_sql.cpp"
+#line 2707 "yacc_sql.cpp"
     break;
 
-  case 84: /* expression_list: expression COMMA expression_list  */
-#line 724 "yacc_sql.y"
+  case 92: /* expression_list: expression COMMA expression_list  */
+#line 788 "yacc_sql.y"
     {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2491,70 +2716,70 @@ yyreduce:
       }
       (yyval.expression_list)->emplace_back((yyvsp[-2].expression));
     }
-#line 2495 "yacc_sql.cpp"
+#line 2720 "yacc_sql.cpp"
     break;
 
-  case 85: /* expression: expression '+' expression  */
-#line 734 "yacc_sql.y"
+  case 93: /* expression: expression '+' expression  */
+#line 798 "yacc_sql.y"
                               {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::ADD, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2503 "yacc_sql.cpp"
+#line 2728 "yacc_sql.cpp"
     break;
 
-  case 86: /* expression: expression '-' expression  */
-#line 737 "yacc_sql.y"
+  case 94: /* expression: expression '-' expression  */
+#line 801 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::SUB, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2511 "yacc_sql.cpp"
+#line 2736 "yacc_sql.cpp"
     break;
 
-  case 87: /* expression: expression '*' expression  */
-#line 740 "yacc_sql.y"
+  case 95: /* expression: expression '*' expression  */
+#line 804 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::MUL, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2519 "yacc_sql.cpp"
+#line 2744 "yacc_sql.cpp"
     break;
 
-  case 88: /* expression: expression '/' expression  */
-#line 743 "yacc_sql.y"
+  case 96: /* expression: expression '/' expression  */
+#line 807 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::DIV, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2527 "yacc_sql.cpp"
+#line 2752 "yacc_sql.cpp"
     break;
 
-  case 89: /* expression: LBRACE expression RBRACE  */
-#line 746 "yacc_sql.y"
+  case 97: /* expression: LBRACE expression RBRACE  */
+#line 810 "yacc_sql.y"
                                {
       (yyval.expression) = (yyvsp[-1].expression);
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
     }
-#line 2536 "yacc_sql.cpp"
+#line 2761 "yacc_sql.cpp"
     break;
 
-  case 90: /* expression: '-' expression  */
-#line 750 "yacc_sql.y"
+  case 98: /* expression: '-' expression  */
+#line 814 "yacc_sql.y"
                                   {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::NEGATIVE, (yyvsp[0].expression), nullptr, sql_string, &(yyloc));
     }
-#line 2544 "yacc_sql.cpp"
+#line 2769 "yacc_sql.cpp"
     break;
 
-  case 91: /* expression: value  */
-#line 753 "yacc_sql.y"
+  case 99: /* expression: value  */
+#line 817 "yacc_sql.y"
             {
       (yyval.expression) = new ValueExpr(*(yyvsp[0].value));
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
       delete (yyvsp[0].value);
     }
-#line 2554 "yacc_sql.cpp"
+#line 2779 "yacc_sql.cpp"
     break;
 
-  case 92: /* select_exprs: '*'  */
-#line 761 "yacc_sql.y"
+  case 100: /* select_exprs: '*'  */
+#line 825 "yacc_sql.y"
         {
       (yyval.s_expr_node_list) = new std::vector<SelectExprSqlNode>;
       SelectExprSqlNode expr;
@@ -2564,11 +2789,11 @@ yyreduce:
       expr.attribute->attribute_name = "*";
       (yyval.s_expr_node_list)->emplace_back(expr);
     }
-#line 2568 "yacc_sql.cpp"
+#line 2793 "yacc_sql.cpp"
     break;
 
-  case 93: /* select_exprs: select_expr select_expr_list  */
-#line 770 "yacc_sql.y"
+  case 101: /* select_exprs: select_expr select_expr_list  */
+#line 834 "yacc_sql.y"
                                    {
       if ((yyvsp[0].s_expr_node_list) != nullptr) {
         (yyval.s_expr_node_list) = (yyvsp[0].s_expr_node_list);
@@ -2578,39 +2803,39 @@ yyreduce:
       (yyval.s_expr_node_list)->emplace_back(*(yyvsp[-1].select_expr_node));
       delete (yyvsp[-1].select_expr_node);
     }
-#line 2582 "yacc_sql.cpp"
+#line 2807 "yacc_sql.cpp"
     break;
 
-  case 94: /* select_expr: rel_attr  */
-#line 782 "yacc_sql.y"
+  case 102: /* select_expr: rel_attr  */
+#line 846 "yacc_sql.y"
              {
       (yyval.select_expr_node) = new SelectExprSqlNode;
       (yyval.select_expr_node)->type = REL_ATTR_SELECT_T;
       (yyval.select_expr_node)->attribute = (yyvsp[0].rel_attr);
     }
-#line 2592 "yacc_sql.cpp"
+#line 2817 "yacc_sql.cpp"
     break;
 
-  case 95: /* select_expr: aggr_func  */
-#line 787 "yacc_sql.y"
+  case 103: /* select_expr: aggr_func  */
+#line 851 "yacc_sql.y"
                 {
       (yyval.select_expr_node) = new SelectExprSqlNode;
       (yyval.select_expr_node)->type = AGGR_FUNC_SELECT_T;
       (yyval.select_expr_node)->aggrfunc = (yyvsp[0].aggr_func_node);
     }
-#line 2602 "yacc_sql.cpp"
+#line 2827 "yacc_sql.cpp"
     break;
 
-  case 96: /* select_expr_list: %empty  */
-#line 796 "yacc_sql.y"
+  case 104: /* select_expr_list: %empty  */
+#line 860 "yacc_sql.y"
     {
       (yyval.s_expr_node_list) = nullptr;
     }
-#line 2610 "yacc_sql.cpp"
+#line 2835 "yacc_sql.cpp"
     break;
 
-  case 97: /* select_expr_list: COMMA select_expr select_expr_list  */
-#line 799 "yacc_sql.y"
+  case 105: /* select_expr_list: COMMA select_expr select_expr_list  */
+#line 863 "yacc_sql.y"
                                          {
       if ((yyvsp[0].s_expr_node_list) != nullptr) {
         (yyval.s_expr_node_list) = (yyvsp[0].s_expr_node_list);
@@ -2621,11 +2846,11 @@ yyreduce:
       (yyval.s_expr_node_list)->emplace_back(*(yyvsp[-1].select_expr_node));
       delete (yyvsp[-1].select_expr_node);
     }
-#line 2625 "yacc_sql.cpp"
+#line 2850 "yacc_sql.cpp"
     break;
 
-  case 98: /* aggr_func: aggr_func_type LBRACE select_attr RBRACE  */
-#line 812 "yacc_sql.y"
+  case 106: /* aggr_func: aggr_func_type LBRACE select_attr RBRACE  */
+#line 876 "yacc_sql.y"
                                              {
       (yyval.aggr_func_node) = new AggrFuncSqlNode;
       (yyval.aggr_func_node)->type = (yyvsp[-3].aggr_func_type);
@@ -2635,51 +2860,51 @@ yyreduce:
         delete (yyvsp[-1].rel_attr_list);
       }
     }
-#line 2639 "yacc_sql.cpp"
+#line 2864 "yacc_sql.cpp"
     break;
 
-  case 99: /* aggr_func_type: MAX  */
-#line 824 "yacc_sql.y"
+  case 107: /* aggr_func_type: MAX  */
+#line 888 "yacc_sql.y"
         {
       (yyval.aggr_func_type) = MAX_AGGR_T;
     }
-#line 2647 "yacc_sql.cpp"
+#line 2872 "yacc_sql.cpp"
     break;
 
-  case 100: /* aggr_func_type: MIN  */
-#line 827 "yacc_sql.y"
+  case 108: /* aggr_func_type: MIN  */
+#line 891 "yacc_sql.y"
           {
       (yyval.aggr_func_type) = MIN_AGGR_T;
     }
-#line 2655 "yacc_sql.cpp"
+#line 2880 "yacc_sql.cpp"
     break;
 
-  case 101: /* aggr_func_type: COUNT  */
-#line 830 "yacc_sql.y"
+  case 109: /* aggr_func_type: COUNT  */
+#line 894 "yacc_sql.y"
             {
       (yyval.aggr_func_type) = COUNT_AGGR_T;
     }
-#line 2663 "yacc_sql.cpp"
+#line 2888 "yacc_sql.cpp"
     break;
 
-  case 102: /* aggr_func_type: AVG  */
-#line 833 "yacc_sql.y"
+  case 110: /* aggr_func_type: AVG  */
+#line 897 "yacc_sql.y"
           {
       (yyval.aggr_func_type) = AVG_AGGR_T;
     }
-#line 2671 "yacc_sql.cpp"
+#line 2896 "yacc_sql.cpp"
     break;
 
-  case 103: /* aggr_func_type: SUM  */
-#line 836 "yacc_sql.y"
+  case 111: /* aggr_func_type: SUM  */
+#line 900 "yacc_sql.y"
           {
       (yyval.aggr_func_type) = SUM_AGGR_T;
     }
-#line 2679 "yacc_sql.cpp"
+#line 2904 "yacc_sql.cpp"
     break;
 
-  case 104: /* select_attr: '*'  */
-#line 842 "yacc_sql.y"
+  case 112: /* select_attr: '*'  */
+#line 906 "yacc_sql.y"
         {
       (yyval.rel_attr_list) = new std::vector<RelAttrSqlNode>;
       RelAttrSqlNode attr;
@@ -2687,11 +2912,11 @@ yyreduce:
       attr.attribute_name = "*";
       (yyval.rel_attr_list)->emplace_back(attr);
     }
-#line 2691 "yacc_sql.cpp"
+#line 2916 "yacc_sql.cpp"
     break;
 
-  case 105: /* select_attr: '*' COMMA rel_attr attr_list  */
-#line 849 "yacc_sql.y"
+  case 113: /* select_attr: '*' COMMA rel_attr attr_list  */
+#line 913 "yacc_sql.y"
                                    {
       if ((yyvsp[0].rel_attr_list) != nullptr) {
         (yyval.rel_attr_list) = (yyvsp[0].rel_attr_list);
@@ -2704,11 +2929,11 @@ yyreduce:
       attr.attribute_name = "*";
       (yyval.rel_attr_list)->emplace_back(attr);
     }
-#line 2708 "yacc_sql.cpp"
+#line 2933 "yacc_sql.cpp"
     break;
 
-  case 106: /* select_attr: rel_attr attr_list  */
-#line 861 "yacc_sql.y"
+  case 114: /* select_attr: rel_attr attr_list  */
+#line 925 "yacc_sql.y"
                          {
       if ((yyvsp[0].rel_attr_list) != nullptr) {
         (yyval.rel_attr_list) = (yyvsp[0].rel_attr_list);
@@ -2718,11 +2943,11 @@ yyreduce:
       (yyval.rel_attr_list)->emplace_back(*(yyvsp[-1].rel_attr));
       delete (yyvsp[-1].rel_attr);
     }
-#line 2722 "yacc_sql.cpp"
+#line 2947 "yacc_sql.cpp"
     break;
 
-  case 107: /* select_attr: %empty  */
-#line 870 "yacc_sql.y"
+  case 115: /* select_attr: %empty  */
+#line 934 "yacc_sql.y"
                   {
       (yyval.rel_attr_list) = new std::vector<RelAttrSqlNode>;
       RelAttrSqlNode attr;
@@ -2730,21 +2955,21 @@ yyreduce:
       attr.attribute_name = "";
       (yyval.rel_attr_list)->emplace_back(attr);
     }
-#line 2734 "yacc_sql.cpp"
+#line 2959 "yacc_sql.cpp"
     break;
 
-  case 108: /* rel_attr: ID  */
-#line 880 "yacc_sql.y"
+  case 116: /* rel_attr: ID  */
+#line 944 "yacc_sql.y"
        {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr)->attribute_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 2744 "yacc_sql.cpp"
+#line 2969 "yacc_sql.cpp"
     break;
 
-  case 109: /* rel_attr: ID DOT ID  */
-#line 885 "yacc_sql.y"
+  case 117: /* rel_attr: ID DOT ID  */
+#line 949 "yacc_sql.y"
                 {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr)->relation_name  = (yyvsp[-2].string);
@@ -2752,19 +2977,19 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].string));
     }
-#line 2756 "yacc_sql.cpp"
+#line 2981 "yacc_sql.cpp"
     break;
 
-  case 110: /* attr_list: %empty  */
-#line 896 "yacc_sql.y"
+  case 118: /* attr_list: %empty  */
+#line 960 "yacc_sql.y"
     {
       (yyval.rel_attr_list) = nullptr;
     }
-#line 2764 "yacc_sql.cpp"
+#line 2989 "yacc_sql.cpp"
     break;
 
-  case 111: /* attr_list: COMMA rel_attr attr_list  */
-#line 899 "yacc_sql.y"
+  case 119: /* attr_list: COMMA rel_attr attr_list  */
+#line 963 "yacc_sql.y"
                                {
       if ((yyvsp[0].rel_attr_list) != nullptr) {
         (yyval.rel_attr_list) = (yyvsp[0].rel_attr_list);
@@ -2775,19 +3000,19 @@ yyreduce:
       (yyval.rel_attr_list)->emplace_back(*(yyvsp[-1].rel_attr));
       delete (yyvsp[-1].rel_attr);
     }
-#line 2779 "yacc_sql.cpp"
+#line 3004 "yacc_sql.cpp"
     break;
 
-  case 112: /* rel_list: %empty  */
-#line 913 "yacc_sql.y"
+  case 120: /* rel_list: %empty  */
+#line 977 "yacc_sql.y"
     {
       (yyval.relation_list) = nullptr;
     }
-#line 2787 "yacc_sql.cpp"
+#line 3012 "yacc_sql.cpp"
     break;
 
-  case 113: /* rel_list: COMMA ID rel_list  */
-#line 916 "yacc_sql.y"
+  case 121: /* rel_list: COMMA ID rel_list  */
+#line 980 "yacc_sql.y"
                         {
       if ((yyvsp[0].relation_list) != nullptr) {
         (yyval.relation_list) = (yyvsp[0].relation_list);
@@ -2798,55 +3023,55 @@ yyreduce:
       (yyval.relation_list)->push_back((yyvsp[-1].string));
       free((yyvsp[-1].string));
     }
-#line 2802 "yacc_sql.cpp"
+#line 3027 "yacc_sql.cpp"
     break;
 
-  case 114: /* where: %empty  */
-#line 929 "yacc_sql.y"
+  case 122: /* where: %empty  */
+#line 993 "yacc_sql.y"
     {
       (yyval.condition_list) = nullptr;
     }
-#line 2810 "yacc_sql.cpp"
+#line 3035 "yacc_sql.cpp"
     break;
 
-  case 115: /* where: WHERE condition_list  */
-#line 932 "yacc_sql.y"
+  case 123: /* where: WHERE condition_list  */
+#line 996 "yacc_sql.y"
                            {
       (yyval.condition_list) = (yyvsp[0].condition_list);  
     }
-#line 2818 "yacc_sql.cpp"
+#line 3043 "yacc_sql.cpp"
     break;
 
-  case 116: /* condition_list: %empty  */
-#line 938 "yacc_sql.y"
+  case 124: /* condition_list: %empty  */
+#line 1002 "yacc_sql.y"
     {
       (yyval.condition_list) = nullptr;
     }
-#line 2826 "yacc_sql.cpp"
+#line 3051 "yacc_sql.cpp"
     break;
 
-  case 117: /* condition_list: condition  */
-#line 941 "yacc_sql.y"
+  case 125: /* condition_list: condition  */
+#line 1005 "yacc_sql.y"
                 {
       (yyval.condition_list) = new std::vector<ConditionSqlNode>;
       (yyval.condition_list)->emplace_back(*(yyvsp[0].condition));
       delete (yyvsp[0].condition);
     }
-#line 2836 "yacc_sql.cpp"
+#line 3061 "yacc_sql.cpp"
     break;
 
-  case 118: /* condition_list: condition AND condition_list  */
-#line 946 "yacc_sql.y"
+  case 126: /* condition_list: condition AND condition_list  */
+#line 1010 "yacc_sql.y"
                                    {
       (yyval.condition_list) = (yyvsp[0].condition_list);
       (yyval.condition_list)->emplace_back(*(yyvsp[-2].condition));
       delete (yyvsp[-2].condition);
     }
-#line 2846 "yacc_sql.cpp"
+#line 3071 "yacc_sql.cpp"
     break;
 
-  case 119: /* condition: rel_attr comp_op value  */
-#line 954 "yacc_sql.y"
+  case 127: /* condition: rel_attr comp_op value  */
+#line 1018 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 1;
@@ -2858,11 +3083,11 @@ yyreduce:
       delete (yyvsp[-2].rel_attr);
       delete (yyvsp[0].value);
     }
-#line 2862 "yacc_sql.cpp"
+#line 3087 "yacc_sql.cpp"
     break;
 
-  case 120: /* condition: value comp_op value  */
-#line 966 "yacc_sql.y"
+  case 128: /* condition: value comp_op value  */
+#line 1030 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 0;
@@ -2874,11 +3099,11 @@ yyreduce:
       delete (yyvsp[-2].value);
       delete (yyvsp[0].value);
     }
-#line 2878 "yacc_sql.cpp"
+#line 3103 "yacc_sql.cpp"
     break;
 
-  case 121: /* condition: rel_attr comp_op rel_attr  */
-#line 978 "yacc_sql.y"
+  case 129: /* condition: rel_attr comp_op rel_attr  */
+#line 1042 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 1;
@@ -2890,11 +3115,11 @@ yyreduce:
       delete (yyvsp[-2].rel_attr);
       delete (yyvsp[0].rel_attr);
     }
-#line 2894 "yacc_sql.cpp"
+#line 3119 "yacc_sql.cpp"
     break;
 
-  case 122: /* condition: value comp_op rel_attr  */
-#line 990 "yacc_sql.y"
+  case 130: /* condition: value comp_op rel_attr  */
+#line 1054 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 0;
@@ -2906,59 +3131,59 @@ yyreduce:
       delete (yyvsp[-2].value);
       delete (yyvsp[0].rel_attr);
     }
-#line 2910 "yacc_sql.cpp"
+#line 3135 "yacc_sql.cpp"
     break;
 
-  case 123: /* comp_op: EQ  */
-#line 1004 "yacc_sql.y"
+  case 131: /* comp_op: EQ  */
+#line 1068 "yacc_sql.y"
          { (yyval.comp) = EQUAL_TO; }
-#line 2916 "yacc_sql.cpp"
+#line 3141 "yacc_sql.cpp"
     break;
 
-  case 124: /* comp_op: LT  */
-#line 1005 "yacc_sql.y"
+  case 132: /* comp_op: LT  */
+#line 1069 "yacc_sql.y"
          { (yyval.comp) = LESS_THAN; }
-#line 2922 "yacc_sql.cpp"
+#line 3147 "yacc_sql.cpp"
     break;
 
-  case 125: /* comp_op: GT  */
-#line 1006 "yacc_sql.y"
+  case 133: /* comp_op: GT  */
+#line 1070 "yacc_sql.y"
          { (yyval.comp) = GREAT_THAN; }
-#line 2928 "yacc_sql.cpp"
+#line 3153 "yacc_sql.cpp"
     break;
 
-  case 126: /* comp_op: LE  */
-#line 1007 "yacc_sql.y"
+  case 134: /* comp_op: LE  */
+#line 1071 "yacc_sql.y"
          { (yyval.comp) = LESS_EQUAL; }
-#line 2934 "yacc_sql.cpp"
+#line 3159 "yacc_sql.cpp"
     break;
 
-  case 127: /* comp_op: GE  */
-#line 1008 "yacc_sql.y"
+  case 135: /* comp_op: GE  */
+#line 1072 "yacc_sql.y"
          { (yyval.comp) = GREAT_EQUAL; }
-#line 2940 "yacc_sql.cpp"
+#line 3165 "yacc_sql.cpp"
     break;
 
-  case 128: /* comp_op: NE  */
-#line 1009 "yacc_sql.y"
+  case 136: /* comp_op: NE  */
+#line 1073 "yacc_sql.y"
          { (yyval.comp) = NOT_EQUAL; }
-#line 2946 "yacc_sql.cpp"
+#line 3171 "yacc_sql.cpp"
     break;
 
-  case 129: /* comp_op: IS_T  */
-#line 1010 "yacc_sql.y"
+  case 137: /* comp_op: IS_T  */
+#line 1074 "yacc_sql.y"
            { (yyval.comp) = IS; }
-#line 2952 "yacc_sql.cpp"
+#line 3177 "yacc_sql.cpp"
     break;
 
-  case 130: /* comp_op: IS_T NOT  */
-#line 1011 "yacc_sql.y"
+  case 138: /* comp_op: IS_T NOT  */
+#line 1075 "yacc_sql.y"
                { (yyval.comp) = IS_NOT; }
-#line 2958 "yacc_sql.cpp"
+#line 3183 "yacc_sql.cpp"
     break;
 
-  case 131: /* load_data_stmt: LOAD DATA INFILE SSS INTO TABLE ID  */
-#line 1016 "yacc_sql.y"
+  case 139: /* load_data_stmt: LOAD DATA INFILE SSS INTO TABLE ID  */
+#line 1080 "yacc_sql.y"
     {
       char *tmp_file_name = common::substr((yyvsp[-3].string), 1, strlen((yyvsp[-3].string)) - 2);
       
@@ -2968,20 +3193,20 @@ yyreduce:
       free((yyvsp[0].string));
       free(tmp_file_name);
     }
-#line 2972 "yacc_sql.cpp"
+#line 3197 "yacc_sql.cpp"
     break;
 
-  case 132: /* explain_stmt: EXPLAIN command_wrapper  */
-#line 1029 "yacc_sql.y"
+  case 140: /* explain_stmt: EXPLAIN command_wrapper  */
+#line 1093 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_EXPLAIN);
       (yyval.sql_node)->explain.sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[0].sql_node));
     }
-#line 2981 "yacc_sql.cpp"
+#line 3206 "yacc_sql.cpp"
     break;
 
-  case 133: /* set_variable_stmt: SET ID EQ value  */
-#line 1037 "yacc_sql.y"
+  case 141: /* set_variable_stmt: SET ID EQ value  */
+#line 1101 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SET_VARIABLE);
       (yyval.sql_node)->set_variable.name  = (yyvsp[-2].string);
@@ -2989,11 +3214,11 @@ yyreduce:
       free((yyvsp[-2].string));
       delete (yyvsp[0].value);
     }
-#line 2993 "yacc_sql.cpp"
+#line 3218 "yacc_sql.cpp"
     break;
 
 
-#line 2997 "yacc_sql.cpp"
+#line 3222 "yacc_sql.cpp"
 
       default: break;
     }
@@ -3222,7 +3447,7 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 1049 "yacc_sql.y"
+#line 1113 "yacc_sql.y"
 
 //_____________________________________________________________________
 extern void scan_string(const char *str, yyscan_t scanner);
@@ -77,49 +77,54 @@ extern int yydebug;
     STRING_T = 278,                /* STRING_T  */
     FLOAT_T = 279,                 /* FLOAT_T  */
     DATE_T = 280,                  /* DATE_T  */
-    HELP = 281,                    /* HELP  */
-    EXIT = 282,                    /* EXIT  */
-    DOT = 283,                     /* DOT  */
-    INTO = 284,                    /* INTO  */
-    VALUES = 285,                  /* VALUES  */
-    FROM = 286,                    /* FROM  */
-    WHERE = 287,                   /* WHERE  */
-    AND = 288,                     /* AND  */
-    SET = 289,                     /* SET  */
-    ON = 290,                      /* ON  */
-    LOAD = 291,                    /* LOAD  */
-    DATA = 292,                    /* DATA  */
-    INFILE = 293,                  /* INFILE  */
-    EXPLAIN = 294,                 /* EXPLAIN  */
-    EQ = 295,                      /* EQ  */
-    LT = 296,                      /* LT  */
-    GT = 297,                      /* GT  */
-    LE = 298,                      /* LE  */
-    GE = 299,                      /* GE  */
-    NE = 300,                      /* NE  */
-    MAX = 301,                     /* MAX  */
-    MIN = 302,                     /* MIN  */
-    COUNT = 303,                   /* COUNT  */
-    AVG = 304,                     /* AVG  */
-    SUM = 305,                     /* SUM  */
-    UNIQUE = 306,                  /* UNIQUE  */
-    IS_T = 307,                    /* IS_T  */
-    NOT = 308,                     /* NOT  */
-    NULL_T = 309,                  /* NULL_T  */
-    NULLABLE = 310,                /* NULLABLE  */
-    INNER = 311,                   /* INNER  */
-    JOIN = 312,                    /* JOIN  */
-    ORDER = 313,                   /* ORDER  */
-    BY = 314,                      /* BY  */
-    ASC_T = 315,                   /* ASC_T  */
-    DESC_T = 316,                  /* DESC_T  */
-    GROUP = 317,                   /* GROUP  */
-    NUMBER = 318,                  /* NUMBER  */
-    FLOAT = 319,                   /* FLOAT  */
-    DATE = 320,                    /* DATE  */
-    ID = 321,                      /* ID  */
-    SSS = 322,                     /* SSS  */
-    UMINUS = 323                   /* UMINUS  */
+    VARCHAR_T = 281,               /* VARCHAR_T  */
+    TEXT_T = 282,                  /* TEXT_T  */
+    HELP = 283,                    /* HELP  */
+    EXIT = 284,                    /* EXIT  */
+    DOT = 285,                     /* DOT  */
+    INTO = 286,                    /* INTO  */
+    VALUES = 287,                  /* VALUES  */
+    FROM = 288,                    /* FROM  */
+    WHERE = 289,                   /* WHERE  */
+    AND = 290,                     /* AND  */
+    SET = 291,                     /* SET  */
+    ON = 292,                      /* ON  */
+    LOAD = 293,                    /* LOAD  */
+    DATA = 294,                    /* DATA  */
+    INFILE = 295,                  /* INFILE  */
+    EXPLAIN = 296,                 /* EXPLAIN  */
+    EQ = 297,                      /* EQ  */
+    LT = 298,                      /* LT  */
+    GT = 299,                      /* GT  */
+    LE = 300,                      /* LE  */
+    GE = 301,                      /* GE  */
+    NE = 302,                      /* NE  */
+    MAX = 303,                     /* MAX  */
+    MIN = 304,                     /* MIN  */
+    COUNT = 305,                   /* COUNT  */
+    AVG = 306,                     /* AVG  */
+    SUM = 307,                     /* SUM  */
+    UNIQUE = 308,                  /* UNIQUE  */
+    IS_T = 309,                    /* IS_T  */
+    NOT = 310,                     /* NOT  */
+    NULL_T = 311,                  /* NULL_T  */
+    NULLABLE = 312,                /* NULLABLE  */
+    INNER = 313,                   /* INNER  */
+    JOIN = 314,                    /* JOIN  */
+    ORDER = 315,                   /* ORDER  */
+    BY = 316,                      /* BY  */
+    ASC_T = 317,                   /* ASC_T  */
+    DESC_T = 318,                  /* DESC_T  */
+    GROUP = 319,                   /* GROUP  */
+    LIMIT = 320,                   /* LIMIT  */
+    STORAGE = 321,                 /* STORAGE  */
+    COMPRESSION = 322,             /* COMPRESSION  */
+    NUMBER = 323,                  /* NUMBER  */
+    FLOAT = 324,                   /* FLOAT  */
+    DATE = 325,                    /* DATE  */
+    ID = 326,                      /* ID  */
+    SSS = 327,                     /* SSS  */
+    UMINUS = 328                   /* UMINUS  */
   };
   typedef enum yytokentype yytoken_kind_t;
 #endif
@@ -128,7 +133,7 @@ extern int yydebug;
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 union YYSTYPE
 {
-#line 119 "yacc_sql.y"
+#line 126 "yacc_sql.y"
 
   ParsedSqlNode *                   sql_node;
   ConditionSqlNode *                condition;
@@ -160,8 +165,10 @@ union YYSTYPE
   std::vector<OrderSqlNode> *       order_node_list;
   GroupSqlNode *                    group_node;
   std::vector<GroupSqlNode> *       group_node_list;
+  TableOptionSqlNode *              table_option;
+  std::vector<TableOptionSqlNode> * table_option_list;
 
-#line 165 "yacc_sql.hpp"
+#line 172 "yacc_sql.hpp"
 
 };
 typedef union YYSTYPE YYSTYPE;
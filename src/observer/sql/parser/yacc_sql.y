@@ -45,6 +45,8 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
 
 %define api.pure full
 %define parse.error verbose
+/** 只在向前看符号合法时归约，语句后面多余的符号会在整条语句归约之前报错 */
+%define lr.default-reduction accepting
 /** 启用位置标识 **/
 %locations
 %lex-param { yyscan_t scanner }
@@ -77,6 +79,8 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
         STRING_T
         FLOAT_T
         DATE_T
+        VARCHAR_T
+        TEXT_T
         HELP
         EXIT
         DOT //QUOTE
@@ -114,6 +118,9 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
         ASC_T
         DESC_T
         GROUP
+        LIMIT
+        STORAGE
+        COMPRESSION
 
 /** union 中定义各种数据类型，真实生成的代码也是union类型，所以不能有非POD类型的数据 **/
 %union {
@@ -147,6 +154,8 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
   std::vector<OrderSqlNode> *       order_node_list;
   GroupSqlNode *                    group_node;
   std::vector<GroupSqlNode> *       group_node_list;
+  TableOptionSqlNode *              table_option;
+  std::vector<TableOptionSqlNode> * table_option_list;
 }
 
 %token <number> NUMBER
@@ -179,6 +188,8 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
 %type <sql_node>            update_stmt
 %type <sql_node>            delete_stmt
 %type <sql_node>            create_table_stmt
+%type <table_option>        table_option
+%type <table_option_list>   table_option_list
 %type <sql_node>            drop_table_stmt
 %type <sql_node>            show_tables_stmt
 %type <sql_node>            desc_table_stmt
@@ -212,6 +223,7 @@ ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
 %type <group_node>          group_node
 %type <group_node_list>     group_node_list
 %type <group_node_list>     group
+%type <number>              limit
 
 %left '+' '-'
 %left '*' '/'
@@ -342,13 +354,19 @@ drop_index_stmt:      /*drop index 语句的语法解析树*/
     }
     ;
 create_table_stmt:    /*create table 语句的语法解析树*/
-    CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE
+    CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE table_option_list
     {
       $$ = new ParsedSqlNode(SCF_CREATE_TABLE);
       CreateTableSqlNode &create_table = $$->create_table;
       create_table.relation_name = $3;
       free($3);
 
+      if ($8 != nullptr) {
+        create_table.options.swap(*$8);
+        std::reverse(create_table.options.begin(), create_table.options.end());
+        delete $8;
+      }
+
       std::vector<AttrInfoSqlNode> *src_attrs = $6;
 
       if (src_attrs != nullptr) {
@@ -359,6 +377,38 @@ create_table_stmt:    /*create table 语句的语法解析树*/
       delete $5;
     }
     ;
+table_option_list:
+    /* empty */
+    {
+      $$ = nullptr;
+    }
+    | table_option table_option_list
+    {
+      if ($2 != nullptr) {
+        $$ = $2;
+      } else {
+        $$ = new std::vector<TableOptionSqlNode>;
+      }
+      $$->emplace_back(*$1);
+      delete $1;
+    }
+    ;
+table_option:
+    STORAGE EQ ID
+    {
+      $$ = new TableOptionSqlNode;
+      $$->type = TableOptionType::STORAGE;
+      $$->value = $3;
+      free($3);
+    }
+    | COMPRESSION EQ ID
+    {
+      $$ = new TableOptionSqlNode;
+      $$->type = TableOptionType::COMPRESSION;
+      $$->value = $3;
+      free($3);
+    }
+    ;
 attr_def_list:
     /* empty */
     {
@@ -441,6 +491,8 @@ type:
     | STRING_T { $$=CHARS; }
     | FLOAT_T  { $$=FLOATS; }
     | DATE_T   { $$=DATES; }
+    | VARCHAR_T { $$=VARCHARS; }
+    | TEXT_T   { $$=TEXTS; }
     ;
 insert_stmt:        /*insert   语句的语法解析树*/
     INSERT INTO ID VALUES raw_tuple raw_tuple_list
@@ -546,7 +598,7 @@ update_stmt:      /*  update 语句的语法解析树*/
     }
     ;
 select_stmt:        /*  select 语句的语法解析树*/
-    SELECT select_exprs FROM ID rel_list where group order
+    SELECT select_exprs FROM ID rel_list where group order limit
     {
       $$ = new ParsedSqlNode(SCF_SELECT);
       if ($2 != nullptr) {
@@ -572,9 +624,10 @@ select_stmt:        /*  select 语句的语法解析树*/
         $$->selection.orders.swap(*$8);
         delete $8;
       }
+      $$->selection.limit = $9;
       free($4);
     }
-    | SELECT select_exprs FROM ID join_node join_list where group order
+    | SELECT select_exprs FROM ID join_node join_list where group order limit
     {
       $$ = new ParsedSqlNode(SCF_SELECT);
       if ($2 != nullptr) {
@@ -600,6 +653,7 @@ select_stmt:        /*  select 语句的语法解析树*/
         $$->selection.orders.swap(*$9);
         delete $9;
       }
+      $$->selection.limit = $10;
       free($4);
     }
     ;
@@ -636,6 +690,16 @@ order_node:
       $$->attribute=*$1;
       free($1);
     }
+limit:
+    /* empty */
+    {
+      $$ = -1;
+    }
+    | LIMIT NUMBER
+    {
+      $$ = $2;
+    }
+    ;
 group:
     /* empty */
     {
@@ -12,8 +12,46 @@ See the Mulan PSL v2 for more details. */
 // Created by Wangyunlai on 2023/6/13.
 //
 
+#include <strings.h>
+
 #include "sql/stmt/create_table_stmt.h"
 #include "event/sql_debug.h"
+#include "common/log/log.h"
+
+/**
+ * @brief 检查建表语句中的表选项，得到表的存放方式和页面压缩方式
+ */
+static RC resolve_table_options(const std::vector<TableOptionSqlNode> &options, StorageFormat &storage_format,
+                                PageCompression &page_compression)
+{
+  for (const TableOptionSqlNode &option : options) {
+    const char *value = option.value.c_str();
+    switch (option.type) {
+      case TableOptionType::STORAGE: {
+        if (0 == strcasecmp(value, "columnar")) {
+          storage_format = StorageFormat::COLUMNAR;
+        } else if (0 == strcasecmp(value, "row")) {
+          storage_format = StorageFormat::ROW;
+        } else {
+          LOG_WARN("unknown storage format: %s, expect COLUMNAR or ROW", value);
+          return RC::INVALID_ARGUMENT;
+        }
+      } break;
+
+      case TableOptionType::COMPRESSION: {
+        if (0 == strcasecmp(value, "lz4")) {
+          page_compression = PageCompression::LZ4;
+        } else if (0 == strcasecmp(value, "none")) {
+          page_compression = PageCompression::NONE;
+        } else {
+          LOG_WARN("unknown page compression: %s, expect LZ4 or NONE", value);
+          return RC::INVALID_ARGUMENT;
+        }
+      } break;
+    }
+  }
+  return RC::SUCCESS;
+}
 
 RC CreateTableStmt::create(Db *db, const CreateTableSqlNode &create_table, Stmt *&stmt)
 {
@@ -29,7 +67,14 @@ RC CreateTableStmt::create(Db *db, const CreateTableSqlNode &create_table, Stmt
       node.length=10;
     tmp.attr_infos.emplace_back(node);
   }
-  stmt = new CreateTableStmt(tmp.relation_name, tmp.attr_infos);
+  StorageFormat   storage_format   = StorageFormat::ROW;
+  PageCompression page_compression = PageCompression::NONE;
+  RC rc = resolve_table_options(create_table.options, storage_format, page_compression);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  stmt = new CreateTableStmt(tmp.relation_name, tmp.attr_infos, storage_format, page_compression);
   sql_debug("create table statement: table name %s", tmp.relation_name.c_str());
   return RC::SUCCESS;
 }
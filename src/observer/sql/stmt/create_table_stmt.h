@@ -29,9 +29,13 @@ class Db;
 class CreateTableStmt : public Stmt
 {
 public:
-  CreateTableStmt(const std::string &table_name, const std::vector<AttrInfoSqlNode> &attr_infos)
+  CreateTableStmt(const std::string &table_name, const std::vector<AttrInfoSqlNode> &attr_infos,
+                  StorageFormat storage_format = StorageFormat::ROW,
+                  PageCompression page_compression = PageCompression::NONE)
         : table_name_(table_name),
-          attr_infos_(attr_infos)
+          attr_infos_(attr_infos),
+          storage_format_(storage_format),
+          page_compression_(page_compression)
   {}
   virtual ~CreateTableStmt() = default;
 
@@ -39,10 +43,14 @@ public:
 
   const std::string &table_name() const { return table_name_; }
   const std::vector<AttrInfoSqlNode> &attr_infos() const { return attr_infos_; }
+  StorageFormat storage_format() const { return storage_format_; }
+  PageCompression page_compression() const { return page_compression_; }
 
   static RC create(Db *db, const CreateTableSqlNode &create_table, Stmt *&stmt);
 
 private:
   std::string table_name_;
   std::vector<AttrInfoSqlNode> attr_infos_;
+  StorageFormat storage_format_ = StorageFormat::ROW;
+  PageCompression page_compression_ = PageCompression::NONE;
 };
\ No newline at end of file
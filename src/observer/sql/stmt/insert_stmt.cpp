@@ -51,7 +51,7 @@ RC InsertStmt::create(Db *db, const InsertSqlNode &inserts, Stmt *&stmt)
     for (int i = 0; i < value_num; i++) {
       // 每个值是否合法
       const FieldMeta *field_meta = table_meta.field(i + sys_field_num);
-      const AttrType field_type = field_meta->type();
+      const AttrType field_type = field_meta->value_type();
       const AttrType value_type = values[i].attr_type();
       // 值与字段类型是否匹配
       // 检查NULL合法性
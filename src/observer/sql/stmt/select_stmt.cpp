@@ -232,6 +232,7 @@ RC SelectStmt::create(Db *db, const SelectSqlNode &select_sql, Stmt *&stmt)
   select_stmt->join_stmts_.swap(join_stmts);
   select_stmt->orders_.swap(orders);
   select_stmt->groups_.swap(groups);
+  select_stmt->limit_ = select_sql.limit;
   stmt = select_stmt;
   return RC::SUCCESS;
 }
\ No newline at end of file
@@ -68,6 +68,12 @@ public:
   std::vector<GroupStmt*> &groups() {
     return groups_;
   }
+  /**
+   * @brief 最多返回的行数，-1 表示没有限制
+   */
+  int limit() const {
+    return limit_;
+  }
 private:
   std::vector<Expression *> query_exprs_; // Select的表达式列表，可以是字段或聚合函数
   std::vector<Table *> tables_; // Select的表列表
@@ -75,4 +81,5 @@ private:
   std::vector<JoinStmt*> join_stmts_;
   std::vector<OrderStmt*> orders_;
   std::vector<GroupStmt*> groups_;
+  int limit_ = -1;
 };
@@ -45,7 +45,7 @@ RC UpdateStmt::create(Db *db, const UpdateSqlNode &update, Stmt *&stmt)
     return RC::SCHEMA_FIELD_NOT_EXIST;
   }
   // 检查属性是否相等
-  if (field_meta->type() != update.value.attr_type()) {
+  if (field_meta->value_type() != update.value.attr_type() && !(update.value.attr_type() == NULLS && field_meta->nullable())) {
     // TODO try to convert the value type to field type
     LOG_WARN("field type mismatch. table=%s, field=%s, field type=%d, value_type=%d",
           table_name, field_meta->name(), field_meta->type(), update.value.attr_type());
@@ -13,12 +13,16 @@ See the Mulan PSL v2 for more details. */
 //
 #include <errno.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <algorithm>
 
 #include "storage/buffer/disk_buffer_pool.h"
 #include "common/lang/mutex.h"
 #include "common/log/log.h"
 #include "common/os/os.h"
 #include "common/io/io.h"
+#include "common/io/lz4.h"
+#include "storage/clog/clog.h"
 
 using namespace common;
 using namespace std;
@@ -184,7 +188,8 @@ BufferPoolIterator::~BufferPoolIterator()
 {}
 RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */)
 {
-  bitmap_.init(bp.file_header_->bitmap, bp.file_header_->page_count);
+  bp_ = &bp;
+  end_page_num_ = bp.file_header_->page_count;
   if (start_page <= 0) {
     current_page_num_ = 0;
   } else {
@@ -193,15 +198,24 @@ RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */)
   return RC::SUCCESS;
 }
 
+RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum begin_page, PageNum end_page)
+{
+  bp_ = &bp;
+  end_page_num_ = std::min(end_page, bp.file_header_->page_count);
+  // 第0页是文件头，不是数据页面
+  current_page_num_ = std::max(begin_page, 1) - 1;
+  return RC::SUCCESS;
+}
+
 bool BufferPoolIterator::has_next()
 {
-  return bitmap_.next_setted_bit(current_page_num_ + 1) != -1;
+  return bp_->next_allocated_page(current_page_num_ + 1, end_page_num_) != BP_INVALID_PAGE_NUM;
 }
 
 PageNum BufferPoolIterator::next()
 {
-  PageNum next_page = bitmap_.next_setted_bit(current_page_num_ + 1);
-  if (next_page != -1) {
+  PageNum next_page = bp_->next_allocated_page(current_page_num_ + 1, end_page_num_);
+  if (next_page != BP_INVALID_PAGE_NUM) {
     current_page_num_ = next_page;
   }
   return next_page;
@@ -258,6 +272,29 @@ RC DiskBufferPool::open_file(const char *file_name)
 
   file_header_ = (BPFileHeader *)hdr_frame_->data();
 
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    LOG_ERROR("Failed to stat file %s, due to %s.", file_name, strerror(errno));
+    purge_frame(BP_HEADER_PAGE, hdr_frame_);
+    close(fd);
+    file_desc_ = -1;
+    return RC::IOERR_ACCESS;
+  }
+  file_size_ = st.st_size;
+
+  if ((rc = load_groups()) != RC::SUCCESS) {
+    LOG_ERROR("Failed to load page groups of %s. rc=%s", file_name, strrc(rc));
+    for (size_t i = 1; i < group_frames_.size(); i++) {
+      purge_frame(group_frames_[i]->page_num(), group_frames_[i]);
+    }
+    group_frames_.clear();
+    group_allocated_.clear();
+    purge_frame(BP_HEADER_PAGE, hdr_frame_);
+    close(fd);
+    file_desc_ = -1;
+    return rc;
+  }
+
   LOG_INFO("Successfully open %s. file_desc=%d, hdr_frame=%p, file header=%s",
            file_name, file_desc_, hdr_frame_, file_header_->to_string().c_str());
   return RC::SUCCESS;
@@ -270,7 +307,11 @@ RC DiskBufferPool::close_file()
     return rc;
   }
 
-  hdr_frame_->unpin();
+  for (Frame *frame : group_frames_) {
+    frame->unpin();
+  }
+  group_frames_.clear();
+  group_allocated_.clear();
 
   // TODO: 理论上是在回放时回滚未提交事务，但目前没有undo log，因此不下刷数据page，只通过redo log回放
   rc = purge_all_pages();
@@ -297,6 +338,10 @@ RC DiskBufferPool::get_this_page(PageNum page_num, Frame **frame)
   RC rc = RC::SUCCESS;
   *frame = nullptr;
 
+  // 查找也要加锁：页帧在加载之前就放到了 frame manager 中，不加锁可能拿到别的线程还没有加载完的页面，
+  // 或者两个线程同时缺页，重复加载同一个页面
+  std::scoped_lock lock_guard(lock_); // 直接加了一把大锁，其实可以根据访问的页面来细化提高并行度
+
   Frame *used_match_frame = frame_manager_.get(file_desc_, page_num);
   if (used_match_frame != nullptr) {
     used_match_frame->access();
@@ -304,8 +349,6 @@ RC DiskBufferPool::get_this_page(PageNum page_num, Frame **frame)
     return RC::SUCCESS;
   }
 
-  std::scoped_lock lock_guard(lock_); // 直接加了一把大锁，其实可以根据访问的页面来细化提高并行度
-
   // Allocate one page and load the data into this page
   Frame *allocated_frame = nullptr;
   rc = allocate_frame(page_num, &allocated_frame);
@@ -333,21 +376,23 @@ RC DiskBufferPool::allocate_page(Frame **frame)
   RC rc = RC::SUCCESS;
 
   lock_.lock();
-  
-  int byte = 0, bit = 0;
+
   if ((file_header_->allocated_pages) < (file_header_->page_count)) {
-    // There is one free page
-    for (int i = 0; i < file_header_->page_count; i++) {
-      byte = i / 8;
-      bit = i % 8;
-      if (((file_header_->bitmap[byte]) & (1 << bit)) == 0) {
-        (file_header_->allocated_pages)++;
-        file_header_->bitmap[byte] |= (1 << bit);
-        // TODO,  do we need clean the loaded page's data?
-        hdr_frame_->mark_dirty();
+    // There is one free page. 跳过已经分满的组
+    for (int group = 0; group < static_cast<int>(group_frames_.size()); group++) {
+      const PageNum group_start = group * BPFileHeader::GROUP_PAGE_NUM;
+      const int group_page_num = std::min(file_header_->page_count - group_start, BPFileHeader::GROUP_PAGE_NUM);
+      if (group_allocated_[group] >= group_page_num) {
+        continue;
+      }
 
+      Bitmap bitmap(group_bitmap(group), group_page_num);
+      const int index = bitmap.next_unsetted_bit(0);
+      if (index >= 0 && index < group_page_num) {
+        set_page_allocated(group_start + index, true);
+        // TODO,  do we need clean the loaded page's data?
         lock_.unlock();
-        return get_this_page(i, frame);
+        return get_this_page(group_start + index, frame);
       }
     }
   }
@@ -360,6 +405,22 @@ RC DiskBufferPool::allocate_page(Frame **frame)
   }
 
   PageNum page_num = file_header_->page_count;
+  if (is_group_page(page_num)) {
+    // 新的一组页面，第一个页面是这一组的位图
+    if ((rc = extend_file(page_num)) != RC::SUCCESS || (rc = load_group(page_num / BPFileHeader::GROUP_PAGE_NUM)) != RC::SUCCESS) {
+      LOG_ERROR("Failed to allocate page group %s:%d. rc=%s", file_name_.c_str(), page_num, strrc(rc));
+      lock_.unlock();
+      return rc;
+    }
+    page_num++;
+  }
+
+  if ((rc = extend_file(page_num)) != RC::SUCCESS) {
+    LOG_ERROR("Failed to extend file %s to page %d. rc=%s", file_name_.c_str(), page_num, strrc(rc));
+    lock_.unlock();
+    return rc;
+  }
+
   Frame *allocated_frame = nullptr;
   if ((rc = allocate_frame(page_num, &allocated_frame)) != RC::SUCCESS) {
     LOG_ERROR("Failed to allocate frame %s, due to no free page.", file_name_.c_str());
@@ -367,28 +428,18 @@ RC DiskBufferPool::allocate_page(Frame **frame)
     return rc;
   }
 
-  LOG_INFO("allocate new page. file=%s, pageNum=%d, pin=%d",
+  LOG_DEBUG("allocate new page. file=%s, pageNum=%d, pin=%d",
            file_name_.c_str(), page_num, allocated_frame->pin_count());
 
-  file_header_->allocated_pages++;
   file_header_->page_count++;
-
-  byte = page_num / 8;
-  bit = page_num % 8;
-  file_header_->bitmap[byte] |= (1 << bit);
-  hdr_frame_->mark_dirty();
+  set_page_allocated(page_num, true);
 
   allocated_frame->set_file_desc(file_desc_);
   allocated_frame->access();
   allocated_frame->clear_page();
-  allocated_frame->set_page_num(file_header_->page_count - 1);
-
-  // Use flush operation to extension file
-  if ((rc = flush_page_internal(*allocated_frame)) != RC::SUCCESS) {
-    LOG_WARN("Failed to alloc page %s , due to failed to extend one page.", file_name_.c_str());
-    // skip return false, delay flush the extended page
-    // return tmp;
-  }
+  allocated_frame->set_page_num(page_num);
+  // 文件已经预分配过，不需要立即写入页面来扩展文件，淘汰时再写到磁盘上
+  allocated_frame->mark_dirty();
 
   lock_.unlock();
 
@@ -408,10 +459,7 @@ RC DiskBufferPool::dispose_page(PageNum page_num)
     return RC::NOTFOUND;
   }
 
-  hdr_frame_->mark_dirty();
-  file_header_->allocated_pages--;
-  char tmp = 1 << (page_num % 8);
-  file_header_->bitmap[page_num / 8] &= ~tmp;
+  set_page_allocated(page_num, false);
   return RC::SUCCESS;
 }
 
@@ -491,36 +539,136 @@ RC DiskBufferPool::flush_page(Frame &frame)
   return flush_page_internal(frame);
 }
 
+RC DiskBufferPool::try_flush_page(Frame &frame)
+{
+  std::unique_lock lock_guard(lock_, std::try_to_lock);
+  if (!lock_guard.owns_lock()) {
+    return RC::LOCKED_CONCURRENCY_CONFLICT;
+  }
+  return flush_page_internal(frame);
+}
+
 RC DiskBufferPool::flush_page_internal(Frame &frame)
 {
   // The better way is use mmap the block into memory,
   // so it is easier to flush data to file.
 
   Page &page = frame.page();
+  if (log_manager_ != nullptr && page.lsn > log_manager_->flushed_lsn()) {
+    // 页面上的修改对应的日志需要先落盘
+    RC rc = log_manager_->sync();
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to sync log before flush page. page num=%d, lsn=%d, rc=%s", page.page_num, page.lsn, strrc(rc));
+      return rc;
+    }
+  }
+
+  const char *data = reinterpret_cast<const char *>(&page);
+  int write_size = sizeof(Page);
+  if (page_compression_ && !is_group_page(page.page_num)) {
+    const int compressed_size = compress_page(page);
+    if (compressed_size > 0) {
+      data = compress_buffer_;
+      write_size = compressed_size;
+    }
+  }
+
   int64_t offset = ((int64_t)page.page_num) * sizeof(Page);
   if (lseek(file_desc_, offset, SEEK_SET) == offset - 1) {
     LOG_ERROR("Failed to flush page %lld of %d due to failed to seek %s.", offset, file_desc_, strerror(errno));
     return RC::IOERR_SEEK;
   }
 
-  if (writen(file_desc_, &page, sizeof(Page)) != 0) {
+  if (writen(file_desc_, data, write_size) != 0) {
     LOG_ERROR("Failed to flush page %lld of %d due to %s.", offset, file_desc_, strerror(errno));
     return RC::IOERR_WRITE;
   }
+
+  io_stats_.write_count++;
+  io_stats_.write_bytes += write_size;
+  if (write_size < static_cast<int>(sizeof(Page))) {
+    io_stats_.compressed_write_count++;
+    RC rc = release_page_tail(offset, write_size);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
   frame.clear_dirty();
   LOG_DEBUG("Flush block. file desc=%d, pageNum=%d, pin count=%d", file_desc_, page.page_num, frame.pin_count());
 
   return RC::SUCCESS;
 }
 
+int DiskBufferPool::compress_page(const Page &page)
+{
+  // 至少要省下一个块才写压缩后的数据，否则读取时还要多解压一次
+  const int capacity = BP_PAGE_SIZE - BP_IO_BLOCK_SIZE - sizeof(CompressedPageHeader);
+  const int compressed_size = lz4_compress(reinterpret_cast<const char *>(&page),
+                                           BP_PAGE_SIZE,
+                                           compress_buffer_ + sizeof(CompressedPageHeader),
+                                           capacity);
+  if (compressed_size <= 0) {
+    return 0;
+  }
+
+  CompressedPageHeader *header = reinterpret_cast<CompressedPageHeader *>(compress_buffer_);
+  header->magic = CompressedPageHeader::MAGIC;
+  header->compressed_size = compressed_size;
+  return sizeof(CompressedPageHeader) + compressed_size;
+}
+
+RC DiskBufferPool::release_page_tail(int64_t offset, int stored_size)
+{
+  const int used_size = (stored_size + BP_IO_BLOCK_SIZE - 1) / BP_IO_BLOCK_SIZE * BP_IO_BLOCK_SIZE;
+  if (used_size < BP_PAGE_SIZE &&
+      fallocate(file_desc_, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset + used_size, BP_PAGE_SIZE - used_size) != 0) {
+    // 文件系统不支持打洞时，只是不能节省磁盘空间，页面后面残留的旧数据不会被读取
+    LOG_DEBUG("failed to punch hole in %s at %lld. error=%s", file_name_.c_str(), offset + used_size, strerror(errno));
+  }
+
+  // 页面在文件末尾时，文件长度需要覆盖整个页面，否则以后会当作文件中不存在这个页面
+  const int64_t page_end = offset + BP_PAGE_SIZE;
+  if (file_size_ < page_end) {
+    struct stat st;
+    if (fstat(file_desc_, &st) != 0) {
+      LOG_ERROR("Failed to stat file %s, due to %s.", file_name_.c_str(), strerror(errno));
+      return RC::IOERR_ACCESS;
+    }
+    if (st.st_size < page_end && ftruncate(file_desc_, page_end) != 0) {
+      LOG_ERROR("Failed to extend file %s to %lld, due to %s.", file_name_.c_str(), page_end, strerror(errno));
+      return RC::IOERR_WRITE;
+    }
+    file_size_ = std::max(static_cast<int64_t>(st.st_size), page_end);
+  }
+  return RC::SUCCESS;
+}
+
 RC DiskBufferPool::flush_all_pages()
 {
+  // find_list 会 pin 住所有的页面，刷完之后需要 unpin，否则关闭文件时这些页面无法释放
   std::list<Frame *> used = frame_manager_.find_list(file_desc_);
+  RC rc = RC::SUCCESS;
   for (Frame *frame : used) {
-    RC rc = flush_page(*frame);
-    if (rc != RC::SUCCESS) {
-      LOG_WARN("failed to flush all pages");
-      return rc;
+    if (rc == RC::SUCCESS) {
+      rc = flush_page(*frame);
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to flush all pages");
+      }
+    }
+    frame->unpin();
+  }
+  return rc;
+}
+
+RC DiskBufferPool::flush_header()
+{
+  std::scoped_lock lock_guard(lock_);
+  for (Frame *frame : group_frames_) {
+    if (frame->dirty()) {
+      RC rc = flush_page_internal(*frame);
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
     }
   }
   return RC::SUCCESS;
@@ -528,20 +676,191 @@ RC DiskBufferPool::flush_all_pages()
 
 RC DiskBufferPool::recover_page(PageNum page_num)
 {
-  int byte = 0, bit = 0;
-  byte = page_num / 8;
-  bit = page_num % 8;
+  if (page_num <= 0 || page_num >= BPFileHeader::MAX_PAGE_NUM || is_group_page(page_num)) {
+    LOG_ERROR("Invalid page to recover. file=%s, page num=%d", file_name_.c_str(), page_num);
+    return RC::BUFFERPOOL_INVALID_PAGE_NUM;
+  }
+
+  std::scoped_lock lock_guard(lock_);
+
+  // 分配页面时扩展文件可能失败了(参考allocate_page)，这里保证页面在文件中是存在的，否则后面无法加载这个页面
+  RC rc = extend_file(page_num);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  // 文件头没有落盘时，页面所在的组可能还没有位图页面
+  const int group = page_num / BPFileHeader::GROUP_PAGE_NUM;
+  for (int i = static_cast<int>(group_frames_.size()); i <= group; i++) {
+    if ((rc = load_group(i)) != RC::SUCCESS) {
+      return rc;
+    }
+  }
+
+  if (!page_allocated(page_num)) {
+    set_page_allocated(page_num, true);
+  }
+  file_header_->page_count = std::max(file_header_->page_count, page_num + 1);
+  hdr_frame_->mark_dirty();
+  return RC::SUCCESS;
+}
 
+RC DiskBufferPool::recover_dispose_page(PageNum page_num)
+{
   std::scoped_lock lock_guard(lock_);
-  if (!(file_header_->bitmap[byte] & (1 << bit))) {
-    file_header_->bitmap[byte] |= (1 << bit);
+  if (page_num < file_header_->page_count && page_allocated(page_num)) {
+    set_page_allocated(page_num, false);
+  }
+  return RC::SUCCESS;
+}
+
+char *DiskBufferPool::group_bitmap(int group)
+{
+  if (group == 0) {
+    return file_header_->bitmap;
+  }
+  return reinterpret_cast<BPGroupHeader *>(group_frames_[group]->data())->bitmap;
+}
+
+bool DiskBufferPool::page_allocated(PageNum page_num)
+{
+  const int group = page_num / BPFileHeader::GROUP_PAGE_NUM;
+  const int index = page_num % BPFileHeader::GROUP_PAGE_NUM;
+  return (group_bitmap(group)[index / 8] & (1 << (index % 8))) != 0;
+}
+
+void DiskBufferPool::set_page_allocated(PageNum page_num, bool allocated)
+{
+  const int group = page_num / BPFileHeader::GROUP_PAGE_NUM;
+  const int index = page_num % BPFileHeader::GROUP_PAGE_NUM;
+  char *bitmap = group_bitmap(group);
+  if (allocated) {
+    bitmap[index / 8] |= (1 << (index % 8));
     file_header_->allocated_pages++;
-    file_header_->page_count++;
+    group_allocated_[group]++;
+  } else {
+    bitmap[index / 8] &= ~(1 << (index % 8));
+    file_header_->allocated_pages--;
+    group_allocated_[group]--;
+  }
+  group_frames_[group]->mark_dirty();
+  hdr_frame_->mark_dirty();
+}
+
+PageNum DiskBufferPool::next_allocated_page(PageNum start, PageNum end)
+{
+  std::scoped_lock lock_guard(lock_);
+  end = std::min(end, file_header_->page_count);
+  while (start < end) {
+    if (is_group_page(start)) {
+      start++;  // 分组的位图页面不算
+      continue;
+    }
+
+    const int group = start / BPFileHeader::GROUP_PAGE_NUM;
+    const PageNum group_start = group * BPFileHeader::GROUP_PAGE_NUM;
+    const int group_end = std::min(end - group_start, BPFileHeader::GROUP_PAGE_NUM);
+
+    Bitmap bitmap(group_bitmap(group), group_end);
+    const int index = bitmap.next_setted_bit(start - group_start);
+    if (index >= 0 && index < group_end) {
+      return group_start + index;
+    }
+    start = group_start + BPFileHeader::GROUP_PAGE_NUM;
+  }
+  return BP_INVALID_PAGE_NUM;
+}
+
+RC DiskBufferPool::load_groups()
+{
+  group_frames_.push_back(hdr_frame_);
+  group_allocated_.push_back(0);
+
+  const int group_num = (file_header_->page_count + BPFileHeader::GROUP_PAGE_NUM - 1) / BPFileHeader::GROUP_PAGE_NUM;
+  for (int group = 1; group < group_num; group++) {
+    RC rc = load_group(group);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+
+  // 文件头中只记录了整个文件分配的页面个数
+  int32_t allocated = file_header_->allocated_pages;
+  for (int group = 1; group < group_num; group++) {
+    allocated -= group_allocated_[group];
+  }
+  group_allocated_[0] = allocated;
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::load_group(int group)
+{
+  ASSERT(group == static_cast<int>(group_frames_.size()), "groups must be loaded in order. group=%d, loaded=%d",
+         group, static_cast<int>(group_frames_.size()));
+
+  const PageNum page_num = group * BPFileHeader::GROUP_PAGE_NUM;
+  Frame *frame = nullptr;
+  RC rc = allocate_frame(page_num, &frame);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to allocate frame for page group. file=%s, group=%d", file_name_.c_str(), group);
+    return rc;
+  }
+  frame->set_file_desc(file_desc_);
+  frame->access();
+
+  const bool exists = static_cast<int64_t>(page_num + 1) * BP_PAGE_SIZE <= file_size_;
+  if (exists && (rc = load_page(page_num, frame)) != RC::SUCCESS) {
+    LOG_ERROR("Failed to load page group. file=%s, group=%d", file_name_.c_str(), group);
+    purge_frame(page_num, frame);
+    return rc;
+  }
+
+  // 预分配的页面还没有写入过，或者文件头落盘了但位图页面没有。有效的位图页面第0位总是1
+  BPGroupHeader *header = reinterpret_cast<BPGroupHeader *>(frame->data());
+  if (!exists || (header->bitmap[0] & 0x01) == 0) {
+    frame->clear_page();
+    frame->set_page_num(page_num);
+    header->bitmap[0] |= 0x01;
+    frame->mark_dirty();
+  }
+
+  int32_t allocated = 0;
+  for (int i = 0; i < BPFileHeader::GROUP_PAGE_NUM / 8; i++) {
+    allocated += __builtin_popcount(static_cast<unsigned char>(header->bitmap[i]));
+  }
+  group_frames_.push_back(frame);
+  group_allocated_.push_back(allocated);
+
+  // 新的一组，或者恢复时文件头中还没有记录这一组
+  if (page_num >= file_header_->page_count) {
+    file_header_->page_count = page_num + 1;
+    file_header_->allocated_pages += allocated;
     hdr_frame_->mark_dirty();
   }
   return RC::SUCCESS;
 }
 
+RC DiskBufferPool::extend_file(PageNum page_num)
+{
+  const int64_t page_end = static_cast<int64_t>(page_num + 1) * BP_PAGE_SIZE;
+  if (page_end <= file_size_) {
+    return RC::SUCCESS;
+  }
+
+  const int extent_pages = std::clamp(file_header_->page_count, 1, BP_EXTENT_PAGE_NUM);
+  const int64_t new_size = std::max(page_end, file_size_ + static_cast<int64_t>(extent_pages) * BP_PAGE_SIZE);
+  if (fallocate(file_desc_, 0, file_size_, new_size - file_size_) != 0) {
+    // 文件系统不支持预分配时，只是扩展文件的长度
+    LOG_DEBUG("failed to fallocate %s to %lld. error=%s", file_name_.c_str(), new_size, strerror(errno));
+    if (ftruncate(file_desc_, new_size) != 0) {
+      LOG_ERROR("Failed to extend file %s to %lld, due to %s.", file_name_.c_str(), new_size, strerror(errno));
+      return RC::IOERR_WRITE;
+    }
+  }
+  file_size_ = new_size;
+  return RC::SUCCESS;
+}
+
 RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
 {
   auto purger = [this](Frame *frame) {
@@ -556,12 +875,15 @@ RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
       rc = bp_manager_.flush_page(*frame);
     }
 
-    if (rc != RC::SUCCESS) {
+    if (rc == RC::LOCKED_CONCURRENCY_CONFLICT) {
+      LOG_TRACE("the file of the frame is locked, try another one. frame=%s", to_string(*frame).c_str());
+    } else if (rc != RC::SUCCESS) {
       LOG_ERROR("Failed to aclloc block due to failed to flush old block. rc=%s", strrc(rc));
     }
     return rc;
   };
 
+  int purge_count = 1;
   while (true) {
     Frame *frame = frame_manager_.alloc(file_desc_, page_num);
     if (frame != nullptr) {
@@ -570,18 +892,21 @@ RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
     }
 
     LOG_TRACE("frames are all allocated, so we should purge some frames to get one free frame");
-    (void)frame_manager_.purge_frames(1/*count*/, purger);
+    // 淘汰失败的页面下次还会最先被选中，比如其它文件的锁正被占用，所以每次多找一些页面
+    if (frame_manager_.purge_frames(purge_count, purger) == 0) {
+      purge_count = std::min(purge_count * 2, std::numeric_limits<int>::max() / 2);
+    }
   }
   return RC::BUFFERPOOL_NOBUF;
 }
 
 RC DiskBufferPool::check_page_num(PageNum page_num)
 {
-  if (page_num >= file_header_->page_count) {
+  if (page_num < 0 || page_num >= file_header_->page_count) {
     LOG_ERROR("Invalid pageNum:%d, file's name:%s", page_num, file_name_.c_str());
     return RC::BUFFERPOOL_INVALID_PAGE_NUM;
   }
-  if ((file_header_->bitmap[page_num / 8] & (1 << (page_num % 8))) == 0) {
+  if (!page_allocated(page_num)) {
     LOG_ERROR("Invalid pageNum:%d, file's name:%s", page_num, file_name_.c_str());
     return RC::BUFFERPOOL_INVALID_PAGE_NUM;
   }
@@ -597,13 +922,68 @@ RC DiskBufferPool::load_page(PageNum page_num, Frame *frame)
     return RC::IOERR_SEEK;
   }
 
+  // 开启压缩时先只读一个块，压缩后的页面通常一个块就能放下
   Page &page = frame->page();
-  int ret = readn(file_desc_, &page, BP_PAGE_SIZE);
+  char *data = reinterpret_cast<char *>(&page);
+  const int read_size = page_compression_ ? BP_IO_BLOCK_SIZE : BP_PAGE_SIZE;
+  int ret = readn(file_desc_, data, read_size);
   if (ret != 0) {
     LOG_ERROR("Failed to load page %s, file_desc:%d, page num:%d, due to failed to read data:%s, ret=%d, page count=%d",
               file_name_.c_str(), file_desc_, page_num, strerror(errno), ret, file_header_->allocated_pages);
     return RC::IOERR_READ;
   }
+  io_stats_.read_count++;
+  io_stats_.read_bytes += read_size;
+
+  if (reinterpret_cast<const CompressedPageHeader *>(data)->magic == CompressedPageHeader::MAGIC) {
+    return decompress_page(page_num, page, read_size);
+  }
+
+  if (read_size < BP_PAGE_SIZE) {
+    ret = readn(file_desc_, data + read_size, BP_PAGE_SIZE - read_size);
+    if (ret != 0) {
+      LOG_ERROR("Failed to load page %s, page num:%d, due to failed to read data:%s, ret=%d",
+                file_name_.c_str(), page_num, strerror(errno), ret);
+      return RC::IOERR_READ;
+    }
+    io_stats_.read_bytes += BP_PAGE_SIZE - read_size;
+  }
+
+  // 预分配之后还没有写入过的页面全是0
+  if (page.page_num == 0 && page_num != 0) {
+    page.page_num = page_num;
+  }
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::decompress_page(PageNum page_num, Page &page, int read_size)
+{
+  char *data = reinterpret_cast<char *>(&page);
+  const CompressedPageHeader *header = reinterpret_cast<const CompressedPageHeader *>(data);
+  const int compressed_size = header->compressed_size;
+  const int stored_size = sizeof(CompressedPageHeader) + compressed_size;
+  if (compressed_size <= 0 || stored_size > BP_PAGE_SIZE) {
+    LOG_ERROR("Invalid compressed page %s:%d. compressed size=%d", file_name_.c_str(), page_num, compressed_size);
+    return RC::IOERR_READ;
+  }
+
+  memcpy(compress_buffer_, data, std::min(read_size, stored_size));
+  if (stored_size > read_size) {
+    int ret = readn(file_desc_, compress_buffer_ + read_size, stored_size - read_size);
+    if (ret != 0) {
+      LOG_ERROR("Failed to load compressed page %s:%d, due to failed to read data:%s, ret=%d",
+                file_name_.c_str(), page_num, strerror(errno), ret);
+      return RC::IOERR_READ;
+    }
+    io_stats_.read_bytes += stored_size - read_size;
+  }
+
+  const int size = lz4_decompress(compress_buffer_ + sizeof(CompressedPageHeader), compressed_size, data, BP_PAGE_SIZE);
+  if (size != BP_PAGE_SIZE) {
+    LOG_ERROR("Failed to decompress page %s:%d. compressed size=%d, decompressed size=%d",
+              file_name_.c_str(), page_num, compressed_size, size);
+    return RC::IOERR_READ;
+  }
   return RC::SUCCESS;
 }
 
@@ -682,21 +1062,28 @@ RC BufferPoolManager::open_file(const char *_file_name, DiskBufferPool *&_bp)
 {
   std::string file_name(_file_name);
 
-  std::scoped_lock lock_guard(lock_);
-  if (buffer_pools_.find(file_name) != buffer_pools_.end()) {
-    LOG_WARN("file already opened. file name=%s", _file_name);
-    return RC::BUFFERPOOL_OPEN;
+  {
+    // 先占住文件名，打开文件时不持有锁
+    std::scoped_lock lock_guard(lock_);
+    if (!buffer_pools_.emplace(file_name, nullptr).second) {
+      LOG_WARN("file already opened. file name=%s", _file_name);
+      return RC::BUFFERPOOL_OPEN;
+    }
   }
 
+  // 打开文件时加载页面可能要淘汰其它文件的页面，会调用 flush_page 加锁
   DiskBufferPool *bp = new DiskBufferPool(*this, frame_manager_);
   RC rc = bp->open_file(_file_name);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to open file name");
     delete bp;
+    std::scoped_lock lock_guard(lock_);
+    buffer_pools_.erase(file_name);
     return rc;
   }
 
-  buffer_pools_.insert(std::pair<std::string, DiskBufferPool *>(file_name, bp));
+  std::scoped_lock lock_guard(lock_);
+  buffer_pools_[file_name] = bp;
   fd_buffer_pools_.insert(std::pair<int, DiskBufferPool *>(bp->file_desc(), bp));
   LOG_DEBUG("insert buffer pool into fd buffer pools. fd=%d, bp=%p, lbt=%s", bp->file_desc(), bp, lbt());
   _bp = bp;
@@ -710,7 +1097,7 @@ RC BufferPoolManager::close_file(const char *_file_name)
   lock_.lock();
 
   auto iter = buffer_pools_.find(file_name);
-  if (iter == buffer_pools_.end()) {
+  if (iter == buffer_pools_.end() || iter->second == nullptr) {
     LOG_TRACE("file has not opened: %s", _file_name);
     lock_.unlock();
     return RC::INTERNAL;
@@ -749,7 +1136,7 @@ RC BufferPoolManager::flush_page(Frame &frame)
   }
 
   DiskBufferPool *bp = iter->second;
-  return bp->flush_page(frame);
+  return bp->try_flush_page(frame);
 }
 
 static BufferPoolManager *default_bpm = nullptr;
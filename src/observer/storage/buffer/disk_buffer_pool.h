@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 //
 #pragma once
 
+#include <stddef.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
@@ -24,6 +25,8 @@ See the Mulan PSL v2 for more details. */
 #include <mutex>
 #include <unordered_map>
 #include <functional>
+#include <limits>
+#include <vector>
 
 #include "common/rc.h"
 #include "common/types.h"
@@ -36,6 +39,7 @@ See the Mulan PSL v2 for more details. */
 
 class BufferPoolManager;
 class DiskBufferPool;
+class CLogManager;
 
 /**
  * @brief BufferPool 的实现
@@ -45,30 +49,86 @@ class DiskBufferPool;
 #define BP_FILE_SUB_HDR_SIZE (sizeof(BPFileSubHeader))
 
 /**
- * @brief BufferPool的文件第一个页面，存放一些元数据信息，包括了后面每页的分配信息。
+ * @brief BufferPool的文件第一个页面，存放一些元数据信息，以及第0组页面的分配位图。
  * @ingroup BufferPool
- * @details
- * @code
- * TODO 1. 当前的做法，只能分配比较少的页面，你可以扩展一下，支持更多的页面或无限多的页面吗？
- *         可以参考Linux ext(n)和Windows NTFS等文件系统
- *      2. 当前使用bitmap存放页面分配情况，但是这种方法在页面非常多的时候，查找空闲页面的
- *         效率非常低，你有办法优化吗？
- * @endcode
+ * @details 文件中的页面按照 GROUP_PAGE_NUM 个一组划分，每一组的第一个页面存放这一组页面的分配位图，
+ * 第0组的位图就在文件头页面中，其它组的位图页面参考 BPGroupHeader。这样文件头和分组位图组成了两级的分配信息，
+ * 文件的大小不再受一个页面能放下的位图大小的限制。只有一组页面的文件与原来的格式相同。
  */
 struct BPFileHeader 
 {
-  int32_t page_count;       //! 当前文件一共有多少个页面
+  int32_t page_count;       //! 当前文件一共有多少个页面，包括分组的位图页面，不包括预分配还没有使用的页面
   int32_t allocated_pages;  //! 已经分配了多少个页面
-  char bitmap[0];           //! 页面分配位图, 第0个页面(就是当前页面)，总是1
+  char bitmap[0];           //! 第0组页面的分配位图, 第0个页面(就是当前页面)，总是1
 
   /**
-   * 能够分配的最大的页面个数，即bitmap的字节数 乘以8
+   * 一组页面的个数，即bitmap的字节数 乘以8
    */
-  static const int MAX_PAGE_NUM = (BP_PAGE_DATA_SIZE - sizeof(page_count) - sizeof(allocated_pages)) * 8;
+  static constexpr int GROUP_PAGE_NUM = (BP_PAGE_DATA_SIZE - sizeof(page_count) - sizeof(allocated_pages)) * 8;
+
+  /**
+   * 能够分配的最大的页面个数，受限于页号的范围
+   */
+  static constexpr int MAX_GROUP_NUM = std::numeric_limits<PageNum>::max() / GROUP_PAGE_NUM;
+  static constexpr int MAX_PAGE_NUM  = MAX_GROUP_NUM * GROUP_PAGE_NUM;
 
   std::string to_string() const;
 };
 
+/**
+ * @brief 除第0组以外，每组页面第一个页面的内容
+ * @ingroup BufferPool
+ * @details 位图的位置和大小与文件头页面中的相同，第0位是位图页面自己，总是1
+ */
+struct BPGroupHeader
+{
+  int32_t reserved[2];
+  char    bitmap[0];
+};
+
+static_assert(offsetof(BPGroupHeader, bitmap) == offsetof(BPFileHeader, bitmap),
+              "group bitmap must have the same size as the bitmap in file header");
+
+/**
+ * @brief 文件一次最多预分配多少个页面(extent)
+ * @details 文件不大时每次按照当前的页面个数预分配，文件大小翻倍，小表不会占用太多的磁盘空间
+ */
+static constexpr int BP_EXTENT_PAGE_NUM = 128;
+
+/**
+ * @brief 压缩后写到磁盘上的页面的头部
+ * @ingroup BufferPool
+ * @details 开启页面压缩后，页面写到磁盘时使用 LZ4 压缩，仍然放在页面原来的位置，后面省下来的块通过
+ * fallocate(PUNCH_HOLE) 还给文件系统，数据文件变成稀疏文件，不需要额外的页面映射表。
+ * magic 和普通页面的 page_num 在同一个位置，页号不会是负数，读取时据此判断页面是否压缩过。
+ * 页面在内存中始终是不压缩的。
+ */
+struct CompressedPageHeader
+{
+  static constexpr int32_t MAGIC = static_cast<int32_t>(0xC0DEC0DE);
+
+  int32_t magic;
+  int32_t compressed_size;  ///< 压缩后的数据长度，不包括头部
+};
+
+/**
+ * @brief 文件系统分配空间的单位。压缩后的页面至少要省下一个块，否则按照原样写入
+ */
+static constexpr int BP_IO_BLOCK_SIZE = 4096;
+
+/**
+ * @brief 一个BufferPool文件的磁盘IO统计
+ * @ingroup BufferPool
+ */
+struct BPIoStats
+{
+  int64_t read_count  = 0;  ///< 从磁盘加载页面的次数
+  int64_t read_bytes  = 0;  ///< 从磁盘读取的字节数
+  int64_t write_count = 0;  ///< 页面写到磁盘的次数
+  int64_t write_bytes = 0;  ///< 写到磁盘的字节数
+  int64_t compressed_write_count = 0;  ///< 压缩之后写到磁盘的次数
+};
+
 /**
  * @brief 管理页面Frame
  * @ingroup BufferPool
@@ -170,13 +230,22 @@ public:
   BufferPoolIterator();
   ~BufferPoolIterator();
 
+  /**
+   * @brief 遍历已经分配的页面，不包括之后新扩展的页面
+   */
   RC init(DiskBufferPool &bp, PageNum start_page = 0);
+
+  /**
+   * @brief 只遍历 [begin_page, end_page) 中已经分配的页面，同样不包括之后新扩展的页面
+   */
+  RC init(DiskBufferPool &bp, PageNum begin_page, PageNum end_page);
   bool has_next();
   PageNum next();
   RC reset();
 
 private:
-  common::Bitmap bitmap_;
+  DiskBufferPool *bp_ = nullptr;
+  PageNum end_page_num_ = 0;
   PageNum current_page_num_ = -1;
 };
 
@@ -213,7 +282,8 @@ public:
   /**
    * 在指定文件中分配一个新的页面，并将其放入缓冲区，返回页面句柄指针。
    * 分配页面时，如果文件中有空闲页，就直接分配一个空闲页；
-   * 如果文件中没有空闲页，则扩展文件规模来增加新的空闲页。
+   * 如果文件中没有空闲页，则使用文件末尾预分配的页面，预分配的页面用完时再一次扩展一批(参考 BP_EXTENT_PAGE_NUM)。
+   * 新页面不会立即写到磁盘上。
    */
   RC allocate_page(Frame **frame);
 
@@ -248,21 +318,65 @@ public:
 
   int file_desc() const;
 
+  /**
+   * @brief 已经分配的页面个数，包括文件头页面
+   */
+  int allocated_page_num() const { return file_header_->allocated_pages; }
+
+  /**
+   * @brief 文件中页面的编号范围是 [0, page_count)，其中有释放掉的页面和分组的位图页面
+   */
+  int page_count() const { return file_header_->page_count; }
+
   /**
    * 如果页面是脏的，就将数据刷新到磁盘
    */
   RC flush_page(Frame &frame);
 
+  /**
+   * @brief 淘汰页面时刷新其它文件的页面
+   * @details 淘汰页面的线程持有自己文件的锁，等待其它文件的锁可能与反方向淘汰的线程死锁，
+   * 所以拿不到锁时返回 LOCKED_CONCURRENCY_CONFLICT，由调用者换一个页面淘汰
+   */
+  RC try_flush_page(Frame &frame);
+
   /**
    * 刷新所有页面到磁盘，即使pin count不是0
    */
   RC flush_all_pages();
 
+  /**
+   * @brief 把文件头页面和所有分组的位图页面刷到磁盘，它们记录了页面的分配状态
+   */
+  RC flush_header();
+
   /**
    * 回放日志时处理page0中已被认定为不存在的page
    */
   RC recover_page(PageNum page_num);
 
+  /**
+   * 回放日志时释放页面，仅修改page0中的页面分配位图
+   */
+  RC recover_dispose_page(PageNum page_num);
+
+  /**
+   * @brief 设置日志管理器
+   * @details 设置之后，刷新页面之前会保证页面LSN之前的日志都已经写入磁盘(WAL)
+   */
+  void set_log_manager(CLogManager *log_manager) { log_manager_ = log_manager; }
+
+  /**
+   * @brief 设置页面写到磁盘时是否压缩
+   * @details 只影响之后写入的页面，读取时根据页面头部判断是否需要解压，所以文件中可以同时有压缩和没有压缩的页面。
+   * 文件头页面不压缩。
+   */
+  void set_page_compression(bool enable) { page_compression_ = enable; }
+  bool page_compression() const { return page_compression_; }
+
+  const BPIoStats &io_stats() const { return io_stats_; }
+  void reset_io_stats() { io_stats_ = BPIoStats(); }
+
 protected:
   RC allocate_frame(PageNum page_num, Frame **buf);
 
@@ -282,6 +396,55 @@ protected:
    */
   RC flush_page_internal(Frame &frame);
 
+  /**
+   * @brief 把页面压缩到 compress_buffer_ 中
+   * @return 压缩后包括头部的长度，压缩后省不下一个块时返回0
+   */
+  int compress_page(const Page &page);
+
+  /**
+   * @brief 解压从磁盘读取的压缩页面
+   * @param read_size 已经读到 page 中的字节数，不够时从文件中继续读取剩下的压缩数据
+   */
+  RC decompress_page(PageNum page_num, Page &page, int read_size);
+
+  /**
+   * @brief 压缩的页面写入之后，把页面中没有用到的块还给文件系统
+   */
+  RC release_page_tail(int64_t offset, int stored_size);
+
+  /**
+   * @brief 页面是否是分组的位图页面(包括文件头页面)
+   */
+  static bool is_group_page(PageNum page_num) { return page_num % BPFileHeader::GROUP_PAGE_NUM == 0; }
+
+  char *group_bitmap(int group);
+  bool  page_allocated(PageNum page_num);
+  void  set_page_allocated(PageNum page_num, bool allocated);
+
+  /**
+   * @brief 下一个已经分配的页面，不包括文件头和分组的位图页面
+   * @param start 从哪个页面开始查找，包括这个页面
+   * @param end   查找到哪个页面为止，不包括这个页面
+   * @return 没有找到时返回 BP_INVALID_PAGE_NUM
+   */
+  PageNum next_allocated_page(PageNum start, PageNum end);
+
+  /**
+   * @brief 打开文件时加载所有分组的位图页面，统计每组分配的页面个数
+   */
+  RC load_groups();
+
+  /**
+   * @brief 加载一个分组的位图页面，磁盘上还没有这个页面时初始化一个新的位图页面
+   */
+  RC load_group(int group);
+
+  /**
+   * @brief 保证文件中有这个页面，文件不够长时预分配一批页面
+   */
+  RC extend_file(PageNum page_num);
+
 private:
   BufferPoolManager &  bp_manager_;
   BPFrameManager &     frame_manager_;
@@ -291,8 +454,18 @@ private:
   Frame *              hdr_frame_ = nullptr;
   BPFileHeader *       file_header_ = nullptr;
   std::set<PageNum>    disposed_pages_;
+  CLogManager *        log_manager_ = nullptr;
+
+  std::vector<Frame *> group_frames_;     ///< 每一组的位图页面，第0个是文件头页面。与文件头一样一直留在内存中
+  std::vector<int32_t> group_allocated_;  ///< 每一组已经分配的页面个数，分配页面时可以跳过已经分满的组
+
+  bool                 page_compression_ = false;
+  int64_t              file_size_ = 0;  ///< 文件长度，包括预分配的还没有使用的页面
+  char                 compress_buffer_[BP_PAGE_SIZE];
+  BPIoStats            io_stats_;
 
-  common::Mutex        lock_;
+  /// 并行扫描时多个线程会同时加载页面，即使不是并发编译也要真正加锁
+  std::mutex           lock_;
 private:
   friend class BufferPoolIterator;
 };
@@ -311,6 +484,9 @@ public:
   RC open_file(const char *file_name, DiskBufferPool *&bp);
   RC close_file(const char *file_name);
 
+  /**
+   * @brief 淘汰页面时刷新页面所属的文件，参考 DiskBufferPool::try_flush_page
+   */
   RC flush_page(Frame &frame);
 
 public:
@@ -320,7 +496,7 @@ public:
 private:
   BPFrameManager frame_manager_{"BufPool"};
 
-  common::Mutex  lock_;
+  std::mutex     lock_;
   std::unordered_map<std::string, DiskBufferPool *> buffer_pools_;
   std::unordered_map<int, DiskBufferPool *> fd_buffer_pools_;
 };
@@ -12,6 +12,9 @@ See the Mulan PSL v2 for more details. */
 // Created by huhaosheng.hhs on 2022
 //
 
+#include <inttypes.h>
+#include <sys/stat.h>
+#include <limits>
 #include <sstream>
 #include <vector>
 
@@ -20,6 +23,8 @@ See the Mulan PSL v2 for more details. */
 #include "common/global_context.h"
 #include "storage/trx/trx.h"
 #include "common/io/io.h"
+#include "storage/db/db.h"
+#include "storage/table/table.h"
 
 using namespace std;
 using namespace common;
@@ -48,6 +53,17 @@ CLogType clog_type_from_integer(int32_t value)
   return static_cast<CLogType>(value);
 }
 
+bool clog_type_is_index(CLogType type)
+{
+  switch (type) {
+    case CLogType::BTREE_LEAF_INSERT:
+    case CLogType::BTREE_LEAF_DELETE:
+    case CLogType::BTREE_SPLIT:
+    case CLogType::BTREE_MERGE: return true;
+    default: return false;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 string CLogRecordHeader::to_string() const
@@ -204,7 +220,7 @@ CLogBuffer::CLogBuffer()
 CLogBuffer::~CLogBuffer()
 {}
 
-RC CLogBuffer::append_log_record(CLogRecord *log_record)
+RC CLogBuffer::append_log_record(CLogRecord *log_record, LSN &lsn)
 {
   if (nullptr == log_record) {
     return RC::INVALID_ARGUMENT;
@@ -216,6 +232,10 @@ RC CLogBuffer::append_log_record(CLogRecord *log_record)
   }
 
   lock_guard<Mutex> lock_guard(lock_);
+  // 日志是按照追加的顺序写入文件的，所以在这里就可以确定日志在文件中的位置
+  current_lsn_ += static_cast<LSN>(sizeof(CLogRecordHeader)) + log_record->logrec_len();
+  log_record->header().lsn_ = current_lsn_;
+  lsn = current_lsn_;
   log_records_.emplace_back(log_record);
   total_size_ += log_record->logrec_len();
   LOG_DEBUG("append log. log_record={%s}", log_record->to_string().c_str());
@@ -226,11 +246,12 @@ RC CLogBuffer::flush_buffer(CLogFile &log_file)
 {
   RC rc = RC::SUCCESS;
   int count = 0;
+  LSN last_lsn = flushed_lsn_.load();
   while (!log_records_.empty()) {
     lock_.lock();
     if (log_records_.empty()) {
       lock_.unlock();
-      return RC::SUCCESS;
+      break;
     }
 
     // log buffer 需要支持并发，所以要考虑加锁
@@ -243,13 +264,18 @@ RC CLogBuffer::flush_buffer(CLogFile &log_file)
     ASSERT(rc == RC::SUCCESS, "failed to write log record. log_record=%s, rc=%s",
            log_record->to_string().c_str(), strrc(rc));
 
+    last_lsn = log_record->header().lsn_;
     lock_.unlock();
     total_size_ -= log_record->logrec_len();
     count++;
   }
 
-  LOG_WARN("flush log buffer done. write log record number=%d", count);
-  return log_file.sync();
+  LOG_TRACE("flush log buffer done. write log record number=%d", count);
+  rc = log_file.sync();
+  if (OB_SUCC(rc) && last_lsn > flushed_lsn_.load()) {
+    flushed_lsn_.store(last_lsn);
+  }
+  return rc;
 }
 
 RC CLogBuffer::write_log_record(CLogFile &log_file, CLogRecord *log_record)
@@ -355,6 +381,18 @@ RC CLogFile::sync()
   return RC::SUCCESS;
 }
 
+RC CLogFile::size(int64_t &size) const
+{
+  struct stat st;
+  if (fstat(fd_, &st) != 0) {
+    LOG_WARN("failed to stat file. file=%s, error=%s", filename_.c_str(), strerror(errno));
+    return RC::IOERR_ACCESS;
+  }
+
+  size = static_cast<int64_t>(st.st_size);
+  return RC::SUCCESS;
+}
+
 RC CLogFile::offset(int64_t &off) const
 {
   off_t pos = lseek(fd_, 0, SEEK_CUR);
@@ -428,7 +466,25 @@ RC CLogManager::init(const char *path)
 {
   log_buffer_ = new CLogBuffer();
   log_file_   = new CLogFile();
-  return log_file_->init(path);
+  RC rc = log_file_->init(path);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // LSN 就是日志在文件中的偏移量，文件中已有的日志都已经落盘了
+  int64_t file_size = 0;
+  rc = log_file_->size(file_size);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get clog file size. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  if (file_size > numeric_limits<LSN>::max()) {
+    LOG_ERROR("clog file is too large. size=%" PRId64, file_size);
+    return RC::INTERNAL;
+  }
+  log_buffer_->set_current_lsn(static_cast<LSN>(file_size));
+  return RC::SUCCESS;
 }
 
 CLogManager::~CLogManager()
@@ -483,11 +539,31 @@ RC CLogManager::rollback_trx(int32_t trx_id)
 }
 
 RC CLogManager::append_log(CLogRecord *log_record)
+{
+  LSN lsn = 0;
+  return append_log(log_record, lsn);
+}
+
+RC CLogManager::append_log(CLogRecord *log_record, LSN &lsn)
 {
   if (nullptr == log_record) {
     return RC::INVALID_ARGUMENT;
   }
-  return log_buffer_->append_log_record(log_record);
+
+  RC rc = log_buffer_->append_log_record(log_record, lsn);
+  if (rc == RC::LOGBUF_FULL) {
+    // 缓存满了就先刷一次盘再重试
+    rc = sync();
+    if (OB_SUCC(rc)) {
+      rc = log_buffer_->append_log_record(log_record, lsn);
+    }
+  }
+
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to append log record. log_record={%s}, rc=%s", log_record->to_string().c_str(), strrc(rc));
+    delete log_record;
+  }
+  return rc;
 }
 
 RC CLogManager::sync()
@@ -495,6 +571,11 @@ RC CLogManager::sync()
   return log_buffer_->flush_buffer(*log_file_);
 }
 
+LSN CLogManager::flushed_lsn() const
+{
+  return log_buffer_->flushed_lsn();
+}
+
 RC CLogManager::recover(Db *db)
 {
   CLogRecordIterator log_record_iterator;
@@ -512,6 +593,16 @@ RC CLogManager::recover(Db *db)
   for (rc = log_record_iterator.next(); OB_SUCC(rc) && log_record_iterator.valid(); rc = log_record_iterator.next()) {
     const CLogRecord &log_record = log_record_iterator.log_record();
     LOG_TRACE("begin to redo log={%s}", log_record.to_string().c_str());
+    if (clog_type_is_index(log_record.log_type())) {
+      // 索引日志不属于任何事务，直接重做到索引页面上
+      rc = redo_index(db, log_record);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to redo index log. log_record={%s}, rc=%s", log_record.to_string().c_str(), strrc(rc));
+        return rc;
+      }
+      continue;
+    }
+
     switch (log_record.log_type()) {
       case CLogType::MTR_BEGIN: {
         Trx *trx = trx_manager->create_trx(log_record.trx_id());
@@ -574,3 +665,17 @@ RC CLogManager::recover(Db *db)
 
   return RC::SUCCESS;
 }
+
+RC CLogManager::redo_index(Db *db, const CLogRecord &log_record)
+{
+  const CLogRecordData &data_record = log_record.data_record();
+  Table *table = db->find_table(data_record.table_id_);
+  if (nullptr == table) {
+    // 表可能已经被删除了
+    LOG_WARN("no such table to redo index log. table id=%d, log_record={%s}",
+             data_record.table_id_, log_record.to_string().c_str());
+    return RC::SUCCESS;
+  }
+
+  return table->redo_index(log_record.header().lsn_, data_record.data_, data_record.data_len_);
+}
@@ -26,6 +26,7 @@ See the Mulan PSL v2 for more details. */
 #include "storage/record/record.h"
 #include "storage/persist/persist.h"
 #include "common/lang/mutex.h"
+#include "common/types.h"
 
 class CLogManager;
 class CLogBuffer;
@@ -48,6 +49,10 @@ class Db;
  * @details 除了事务操作相关的类型，比如MTR_BEGIN/MTR_COMMIT等，都是需要事务自己去处理的。
  * 也就是说，像INSERT、DELETE等是事务自己处理的，其实这种类型的日志不需要在这里定义，而是在各个
  * 事务模型中定义，由各个事务模型自行处理。
+ * UPDATE 日志的数据是更新前的记录紧跟着更新后的记录，回滚时需要用到更新前的记录。
+ * UPDATE_PARTIAL 日志只记录更新时修改过的几段数据，用在更新前后记录长度不变的时候，格式参考 MvccTrx。
+ * BTREE_开头的是B+树索引的物理逻辑日志(physiological log)，与事务无关，恢复时直接按照页面LSN
+ * 判断是否需要重做到索引页面上。日志数据的格式参考 BplusTreeLogger。
  */
 #define DEFINE_CLOG_TYPE_ENUM         \
   DEFINE_CLOG_TYPE(ERROR)             \
@@ -55,7 +60,13 @@ class Db;
   DEFINE_CLOG_TYPE(MTR_COMMIT)        \
   DEFINE_CLOG_TYPE(MTR_ROLLBACK)      \
   DEFINE_CLOG_TYPE(INSERT)            \
-  DEFINE_CLOG_TYPE(DELETE)
+  DEFINE_CLOG_TYPE(DELETE)            \
+  DEFINE_CLOG_TYPE(BTREE_LEAF_INSERT) \
+  DEFINE_CLOG_TYPE(BTREE_LEAF_DELETE) \
+  DEFINE_CLOG_TYPE(BTREE_SPLIT)       \
+  DEFINE_CLOG_TYPE(BTREE_MERGE)       \
+  DEFINE_CLOG_TYPE(UPDATE)             \
+  DEFINE_CLOG_TYPE(UPDATE_PARTIAL)
 
 enum class CLogType 
 { 
@@ -81,13 +92,19 @@ int32_t clog_type_to_integer(CLogType type);
  */
 CLogType clog_type_from_integer(int32_t value);
 
+/**
+ * @brief 是否是B+树索引的日志
+ * @ingroup CLog
+ */
+bool clog_type_is_index(CLogType type);
+
 /**
  * @brief CLog的记录头。每个日志都带有这个信息
  * @ingroup CLog
  */
 struct CLogRecordHeader 
 {
-  int32_t lsn_ = -1;     ///< log sequence number。当前没有使用
+  int32_t lsn_ = -1;     ///< log sequence number。日志记录写入文件后，结尾在文件中的偏移量
   int32_t trx_id_ = -1;  ///< 日志所属事务的编号
   int32_t type_ = clog_type_to_integer(CLogType::ERROR); ///< 日志类型
   int32_t logrec_len_ = 0;  ///< record的长度，不包含header长度
@@ -243,8 +260,9 @@ public:
   /**
    * @brief 增加一条日志
    * @details 如果当前的日志达到一定量，就会刷新数据
+   * @param[out] lsn 分配给这条日志的LSN
    */
-  RC append_log_record(CLogRecord *log_record);
+  RC append_log_record(CLogRecord *log_record, LSN &lsn);
 
   /**
    * @brief 将当前的日志都刷新到日志文件中
@@ -253,6 +271,19 @@ public:
    */
   RC flush_buffer(CLogFile &log_file);
 
+  /**
+   * @brief 设置起始的LSN
+   * @details LSN就是日志在文件中的偏移量，所以初始化时需要从日志文件的大小开始
+   */
+  void set_current_lsn(LSN lsn)
+  {
+    current_lsn_ = lsn;
+    flushed_lsn_.store(lsn);
+  }
+
+  LSN current_lsn() const { return current_lsn_; }
+  LSN flushed_lsn() const { return flushed_lsn_.load(); }
+
 private:
   /**
    * @brief 将日志记录写入到日志文件中
@@ -266,6 +297,8 @@ private:
   common::Mutex lock_;  ///< 加锁支持多线程并发写入
   std::deque<std::unique_ptr<CLogRecord>> log_records_;  ///< 当前等待刷数据的日志记录
   std::atomic_int32_t total_size_;  ///< 当前缓存中的日志记录的总大小
+  LSN current_lsn_ = 0;             ///< 最后一条追加到缓存中的日志的LSN
+  std::atomic<LSN> flushed_lsn_{0}; ///< 已经刷新到磁盘的日志的最大LSN
 };
 
 /**
@@ -314,6 +347,11 @@ public:
    */
   RC offset(int64_t &off) const;
 
+  /**
+   * @brief 获取日志文件的大小
+   */
+  RC size(int64_t &size) const;
+
   /**
    * @brief 当前是否已经读取到文件尾
    */
@@ -404,11 +442,23 @@ public:
    */
   RC append_log(CLogRecord *log_record);
 
+  /**
+   * @brief 增加一条日志，并返回这条日志的LSN
+   * @details 修改页面的日志，需要在页面上记录LSN，恢复时根据页面LSN判断是否需要重做
+   */
+  RC append_log(CLogRecord *log_record, LSN &lsn);
+
   /**
    * @brief 刷新日志到磁盘
    */
   RC sync();
 
+  /**
+   * @brief 已经刷新到磁盘的日志LSN
+   * @details 页面刷盘前需要保证对应的日志已经落盘(WAL)
+   */
+  LSN flushed_lsn() const;
+
   /**
    * @brief 重做
    * @details 当前会重做所有日志。也就是说，所有buffer pool页面都不会写入到磁盘中，
@@ -416,6 +466,12 @@ public:
    */
   RC recover(Db *db);
 
+private:
+  /**
+   * @brief 重做一条B+树索引日志
+   */
+  RC redo_index(Db *db, const CLogRecord &log_record);
+
 private:
   CLogBuffer *log_buffer_ = nullptr;   ///< 日志缓存。新增日志时先放到内存，也就是这个buffer中
   CLogFile *  log_file_   = nullptr;   ///< 管理日志，比如读写日志
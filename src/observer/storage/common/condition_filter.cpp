@@ -73,6 +73,10 @@ RC DefaultConditionFilter::init(Table &table, const ConditionSqlNode &condition)
       LOG_WARN("No such field in condition. %s.%s", table.name(), condition.left_attr.attribute_name.c_str());
       return RC::SCHEMA_FIELD_MISSING;
     }
+    if (field_left->type() == VARCHARS || field_left->type() == TEXTS) {
+      LOG_WARN("variable length field is not supported in condition filter. %s.%s", table.name(), field_left->name());
+      return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+    }
     left.attr_length = field_left->len();
     left.attr_offset = field_left->offset();
 
@@ -93,6 +97,10 @@ RC DefaultConditionFilter::init(Table &table, const ConditionSqlNode &condition)
       LOG_WARN("No such field in condition. %s.%s", table.name(), condition.right_attr.attribute_name.c_str());
       return RC::SCHEMA_FIELD_MISSING;
     }
+    if (field_right->type() == VARCHARS || field_right->type() == TEXTS) {
+      LOG_WARN("variable length field is not supported in condition filter. %s.%s", table.name(), field_right->name());
+      return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+    }
     right.attr_length = field_right->len();
     right.attr_offset = field_right->offset();
     type_right = field_right->type();
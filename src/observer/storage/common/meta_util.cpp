@@ -22,6 +22,10 @@ std::string table_data_file(const char *base_dir, const char *table_name)
 {
   return std::string(base_dir) + common::FILE_PATH_SPLIT_STR + table_name + TABLE_DATA_SUFFIX;
 }
+std::string table_text_data_file(const char *base_dir, const char *table_name)
+{
+  return std::string(base_dir) + common::FILE_PATH_SPLIT_STR + table_name + TABLE_TEXT_DATA_SUFFIX;
+}
 
 std::string table_index_file(const char *base_dir, const char *table_name, const char *index_name)
 {
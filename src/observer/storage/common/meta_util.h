@@ -23,4 +23,5 @@ static constexpr const char *TABLE_TEXT_DATA_SUFFIX = ".text";
 
 std::string table_meta_file(const char *base_dir, const char *table_name);
 std::string table_data_file(const char *base_dir, const char *table_name);
+std::string table_text_data_file(const char *base_dir, const char *table_name);
 std::string table_index_file(const char *base_dir, const char *table_name, const char *index_name);
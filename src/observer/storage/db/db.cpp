@@ -23,12 +23,16 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/string.h"
 #include "storage/table/table_meta.h"
 #include "storage/table/table.h"
+#include "storage/record/record_manager.h"
 #include "storage/common/meta_util.h"
 #include "storage/trx/trx.h"
 #include "storage/clog/clog.h"
+#include "common/global_context.h"
 
 Db::~Db()
 {
+  stop_vacuum_thread();
+
   for (auto &iter : opened_tables_) {
     delete iter.second;
   }
@@ -73,10 +77,18 @@ RC Db::init(const char *name, const char *dbpath)
     LOG_WARN("failed to recover db. dbpath=%s, rc=%s", dbpath, strrc(rc));
     return rc;
   }
+
+  // 恢复时修改过的页面不会再构建区间信息。恢复之后没有旧版本，所有页面都可以在扫描时重新构建
+  for (auto &iter : opened_tables_) {
+    iter.second->record_handler()->zone_map().clear();
+  }
+
+  start_vacuum_thread();
   return rc;
 }
 
-RC Db::create_table(const char *table_name, int attribute_count, const AttrInfoSqlNode *attributes)
+RC Db::create_table(const char *table_name, int attribute_count, const AttrInfoSqlNode *attributes,
+    StorageFormat storage_format, PageCompression page_compression)
 {
   RC rc = RC::SUCCESS;
   // check table_name
@@ -85,17 +97,27 @@ RC Db::create_table(const char *table_name, int attribute_count, const AttrInfoS
     return RC::SCHEMA_TABLE_EXIST;
   }
 
+  std::lock_guard<std::mutex> tables_guard(tables_lock_);
+
   // 文件路径可以移到Table模块
   std::string table_file_path = table_meta_file(path_.c_str(), table_name);
   Table *table = new Table();
   int32_t table_id = next_table_id_++;
-  rc = table->create(table_id, table_file_path.c_str(), table_name, path_.c_str(), attribute_count, attributes);
+  rc = table->create(table_id,
+      table_file_path.c_str(),
+      table_name,
+      path_.c_str(),
+      attribute_count,
+      attributes,
+      storage_format,
+      page_compression);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Failed to create table %s.", table_name);
     delete table;
     return rc;
   }
 
+  table->set_log_manager(clog_manager_.get());
   opened_tables_[table_name] = table;
   LOG_INFO("Create table success. table name=%s, table_id:%d", table_name, table_id);
   return RC::SUCCESS;
@@ -107,6 +129,7 @@ RC Db::drop_table(const char* table_name)
     if (table == nullptr) {
       return RC::SCHEMA_TABLE_NOT_EXIST;
     }
+    std::lock_guard<std::mutex> tables_guard(tables_lock_);
     RC rc = table->destroy(path_.c_str());
     if(rc != RC::SUCCESS) return rc;
     opened_tables_.erase(table_name);
@@ -162,6 +185,7 @@ RC Db::open_all_tables()
     if (table->table_id() >= next_table_id_) {
       next_table_id_ = table->table_id() + 1;
     }
+    table->set_log_manager(clog_manager_.get());
     opened_tables_[table->name()] = table;
     LOG_INFO("Open table: %s, file: %s", table->name(), filename.c_str());
   }
@@ -206,4 +230,55 @@ RC Db::recover()
 CLogManager *Db::clog_manager()
 {
   return clog_manager_.get();
-}
\ No newline at end of file
+}
+RC Db::vacuum()
+{
+  std::lock_guard<std::mutex> tables_guard(tables_lock_);
+
+  std::vector<Table *> tables;
+  tables.reserve(opened_tables_.size());
+  for (auto &iter : opened_tables_) {
+    tables.push_back(iter.second);
+  }
+  return GCTX.trx_kit_->vacuum(tables);
+}
+
+void Db::start_vacuum_thread()
+{
+  vacuum_stopped_ = false;
+  vacuum_thread_ = std::thread(&Db::vacuum_thread_func, this);
+}
+
+void Db::stop_vacuum_thread()
+{
+  if (!vacuum_thread_.joinable()) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(vacuum_lock_);
+    vacuum_stopped_ = true;
+  }
+  vacuum_cv_.notify_all();
+  vacuum_thread_.join();
+}
+
+void Db::vacuum_thread_func()
+{
+  LOG_INFO("vacuum thread started. db=%s", name_.c_str());
+  std::unique_lock<std::mutex> lock(vacuum_lock_);
+  while (!vacuum_stopped_) {
+    vacuum_cv_.wait_for(lock, std::chrono::milliseconds(VACUUM_INTERVAL_MS));
+    if (vacuum_stopped_) {
+      break;
+    }
+
+    lock.unlock();
+    RC rc = vacuum();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to vacuum db. db=%s, rc=%s", name_.c_str(), strrc(rc));
+    }
+    lock.lock();
+  }
+  LOG_INFO("vacuum thread stopped. db=%s", name_.c_str());
+}
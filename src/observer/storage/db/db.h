@@ -18,6 +18,9 @@ See the Mulan PSL v2 for more details. */
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 
 #include "common/rc.h"
 #include "sql/parser/parse_defs.h"
@@ -45,7 +48,14 @@ public:
    */
   RC init(const char *name, const char *dbpath);
 
-  RC create_table(const char *table_name, int attribute_count, const AttrInfoSqlNode *attributes);
+  /**
+   * @brief 创建一张表
+   * @param storage_format 表数据的存放方式，参考 StorageFormat
+   * @param page_compression 数据页面写到磁盘时的压缩方式
+   */
+  RC create_table(const char *table_name, int attribute_count, const AttrInfoSqlNode *attributes,
+                  StorageFormat storage_format = StorageFormat::ROW,
+                  PageCompression page_compression = PageCompression::NONE);
 
   RC drop_table(const char *table_name);
 
@@ -62,9 +72,19 @@ public:
 
   CLogManager *clog_manager();
 
+  /**
+   * @brief 对所有的表做一次垃圾回收
+   * @details 具体回收什么由事务模型决定，参考 TrxKit::vacuum
+   */
+  RC vacuum();
+
 private:
   RC open_all_tables();
 
+  void start_vacuum_thread();
+  void stop_vacuum_thread();
+  void vacuum_thread_func();
+
 private:
   std::string name_;
   std::string path_;
@@ -73,4 +93,14 @@ private:
 
   /// 给每个table都分配一个ID，用来记录日志。这里假设所有的DDL都不会并发操作，所以相关的数据都不上锁
   int32_t next_table_id_ = 0;
+
+  /// DDL之间不会并发，但是会与后台的垃圾回收并发，创建和删除表时需要加锁
+  std::mutex tables_lock_;
+
+  static constexpr int VACUUM_INTERVAL_MS = 1000;  ///< 后台垃圾回收的间隔
+
+  std::thread             vacuum_thread_;
+  std::mutex              vacuum_lock_;
+  std::condition_variable vacuum_cv_;
+  bool                    vacuum_stopped_ = false;
 };
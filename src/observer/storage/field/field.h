@@ -40,7 +40,7 @@ public:
 
   AttrType attr_type() const
   {
-    return field_->type();
+    return field_->value_type();
   }
 
   const char *table_name() const
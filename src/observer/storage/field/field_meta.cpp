@@ -79,6 +79,20 @@ int FieldMeta::len() const
   return attr_len_;
 }
 
+int FieldMeta::inline_len() const
+{
+  switch (attr_type_) {
+    case VARCHARS: return static_cast<int>(sizeof(VarcharRef));
+    case TEXTS: return static_cast<int>(sizeof(TextRef));
+    default: return attr_len_;
+  }
+}
+
+AttrType FieldMeta::value_type() const
+{
+  return (attr_type_ == VARCHARS || attr_type_ == TEXTS) ? CHARS : attr_type_;
+}
+
 bool FieldMeta::visible() const
 {
   return visible_;
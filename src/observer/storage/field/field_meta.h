@@ -23,6 +23,28 @@ namespace Json {
 class Value;
 }  // namespace Json
 
+/**
+ * @brief VARCHAR 字段在记录定长部分保存的内容
+ * @details 字段的数据放在记录定长部分的后面，这里记录数据相对记录起始位置的偏移和长度
+ */
+struct VarcharRef
+{
+  uint16_t offset;
+  uint16_t len;
+};
+
+/**
+ * @brief TEXT 字段在记录中保存的内容
+ * @details 字段的数据放在溢出页中，参考 OverflowFileHandler
+ */
+struct TextRef
+{
+  static constexpr int MAX_LEN = 16 * 1024 * 1024;  ///< TEXT 字段的最大长度
+
+  int32_t first_page;  ///< 第一个溢出页，长度为0时没有溢出页
+  int32_t len;
+};
+
 /**
  * @brief 字段元数据
  * 
@@ -41,6 +63,17 @@ public:
   AttrType type() const;
   int offset() const;
   int len() const;
+
+  /**
+   * @brief 字段在记录定长部分占用的空间
+   * @details VARCHAR 字段的 len 是声明的最大长度，在定长部分只占用一个 VarcharRef。TEXT 字段只占用一个 TextRef
+   */
+  int inline_len() const;
+
+  /**
+   * @brief 读取出来的值的类型
+   */
+  AttrType value_type() const;
   bool visible() const;
   bool nullable() const;
 
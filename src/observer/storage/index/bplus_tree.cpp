@@ -12,6 +12,8 @@ See the Mulan PSL v2 for more details. */
 // Created by Xie Meiyi
 // Rewritten by Longda & Wangyunlai
 //
+#include <algorithm>
+
 #include "storage/index/bplus_tree.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "common/log/log.h"
@@ -39,10 +41,18 @@ int calc_leaf_page_capacity(int attr_length)
 }
 
 /////////////////////////////////////////////////////////////////////////////////
-IndexNodeHandler::IndexNodeHandler(const IndexFileHeader &header, Frame *frame)
-    : header_(header), page_num_(frame->page_num()), node_((IndexNode *)frame->data())
+IndexNodeHandler::IndexNodeHandler(const IndexFileHeader &header, Frame *frame, BplusTreeMiniTransaction *mtr)
+    : header_(header), frame_(frame), mtr_(mtr), page_num_(frame->page_num()), node_((IndexNode *)frame->data())
 {}
 
+BplusTreeLogger *IndexNodeHandler::logger() const
+{
+  if (nullptr == mtr_ || !mtr_->logger().enabled()) {
+    return nullptr;
+  }
+  return &mtr_->logger();
+}
+
 bool IndexNodeHandler::is_leaf() const
 {
   return node_->is_leaf;
@@ -52,6 +62,10 @@ void IndexNodeHandler::init_empty(bool leaf)
   node_->is_leaf = leaf;
   node_->key_num = 0;
   node_->parent = BP_INVALID_PAGE_NUM;
+
+  if (BplusTreeLogger *logger = this->logger()) {
+    logger->init_node(frame_, leaf);
+  }
 }
 PageNum IndexNodeHandler::page_num() const
 {
@@ -103,6 +117,10 @@ PageNum IndexNodeHandler::parent_page_num() const
 void IndexNodeHandler::set_parent_page_num(PageNum page_num)
 {
   this->node_->parent = page_num;
+
+  if (BplusTreeLogger *logger = this->logger()) {
+    logger->set_parent_page(frame_, page_num);
+  }
 }
 
 /**
@@ -167,8 +185,8 @@ bool IndexNodeHandler::validate() const
 }
 
 /////////////////////////////////////////////////////////////////////////////////
-LeafIndexNodeHandler::LeafIndexNodeHandler(const IndexFileHeader &header, Frame *frame)
-    : IndexNodeHandler(header, frame), leaf_node_((LeafIndexNode *)frame->data())
+LeafIndexNodeHandler::LeafIndexNodeHandler(const IndexFileHeader &header, Frame *frame, BplusTreeMiniTransaction *mtr)
+    : IndexNodeHandler(header, frame, mtr), leaf_node_((LeafIndexNode *)frame->data())
 {}
 
 void LeafIndexNodeHandler::init_empty()
@@ -180,6 +198,10 @@ void LeafIndexNodeHandler::init_empty()
 void LeafIndexNodeHandler::set_next_page(PageNum page_num)
 {
   leaf_node_->next_brother = page_num;
+
+  if (BplusTreeLogger *logger = this->logger()) {
+    logger->set_next_page(frame_, page_num);
+  }
 }
 
 PageNum LeafIndexNodeHandler::next_page() const
@@ -216,14 +238,41 @@ void LeafIndexNodeHandler::insert(int index, const char *key, const char *value)
   memcpy(__item_at(index), key, key_size());
   memcpy(__item_at(index) + key_size(), value, value_size());
   increase_size(1);
+
+  if (BplusTreeLogger *logger = this->logger()) {
+    logger->insert_items(frame_, index, __item_at(index), 1, item_size());
+  }
 }
 void LeafIndexNodeHandler::remove(int index)
 {
-  assert(index >= 0 && index < size());
-  if (index < size() - 1) {
-    memmove(__item_at(index), __item_at(index + 1), (static_cast<size_t>(size()) - index - 1) * item_size());
+  remove_items(index, 1);
+}
+
+void LeafIndexNodeHandler::insert_items(int index, const char *items, int num)
+{
+  assert(index >= 0 && index <= size() && num >= 0);
+  if (index < size()) {
+    memmove(__item_at(index + num), __item_at(index), (static_cast<size_t>(size()) - index) * item_size());
+  }
+  memcpy(__item_at(index), items, static_cast<size_t>(num) * item_size());
+  increase_size(num);
+
+  if (BplusTreeLogger *logger = this->logger()) {
+    logger->insert_items(frame_, index, __item_at(index), num, item_size());
+  }
+}
+
+void LeafIndexNodeHandler::remove_items(int index, int num)
+{
+  assert(index >= 0 && num >= 0 && index + num <= size());
+  if (index + num < size()) {
+    memmove(__item_at(index), __item_at(index + num), (static_cast<size_t>(size()) - index - num) * item_size());
+  }
+  increase_size(-num);
+
+  if (BplusTreeLogger *logger = this->logger()) {
+    logger->remove_items(frame_, index, num);
   }
-  increase_size(-1);
 }
 
 int LeafIndexNodeHandler::remove(const char *key, const KeyComparator &comparator)
@@ -242,27 +291,21 @@ RC LeafIndexNodeHandler::move_half_to(LeafIndexNodeHandler &other, DiskBufferPoo
   const int size = this->size();
   const int move_index = size / 2;
 
-  memcpy(other.__item_at(0), this->__item_at(move_index), static_cast<size_t>(item_size()) * (size - move_index));
-  other.increase_size(size - move_index);
-  this->increase_size(-(size - move_index));
+  other.insert_items(other.size(), this->__item_at(move_index), size - move_index);
+  this->remove_items(move_index, size - move_index);
   return RC::SUCCESS;
 }
 RC LeafIndexNodeHandler::move_first_to_end(LeafIndexNodeHandler &other, DiskBufferPool *disk_buffer_pool)
 {
-  other.append(__item_at(0));
-
-  if (size() >= 1) {
-    memmove(__item_at(0), __item_at(1), (static_cast<size_t>(size()) - 1) * item_size());
-  }
-  increase_size(-1);
+  other.insert_items(other.size(), __item_at(0), 1);
+  remove_items(0, 1);
   return RC::SUCCESS;
 }
 
 RC LeafIndexNodeHandler::move_last_to_front(LeafIndexNodeHandler &other, DiskBufferPool *bp)
 {
-  other.preappend(__item_at(size() - 1));
-
-  increase_size(-1);
+  other.insert_items(0, __item_at(size() - 1), 1);
+  remove_items(size() - 1, 1);
   return RC::SUCCESS;
 }
 /**
@@ -270,29 +313,13 @@ RC LeafIndexNodeHandler::move_last_to_front(LeafIndexNodeHandler &other, DiskBuf
  */
 RC LeafIndexNodeHandler::move_to(LeafIndexNodeHandler &other, DiskBufferPool *bp)
 {
-  memcpy(other.__item_at(other.size()), this->__item_at(0), static_cast<size_t>(this->size()) * item_size());
-  other.increase_size(this->size());
-  this->increase_size(-this->size());
+  other.insert_items(other.size(), this->__item_at(0), this->size());
+  this->remove_items(0, this->size());
 
   other.set_next_page(this->next_page());
   return RC::SUCCESS;
 }
 
-void LeafIndexNodeHandler::append(const char *item)
-{
-  memcpy(__item_at(size()), item, item_size());
-  increase_size(1);
-}
-
-void LeafIndexNodeHandler::preappend(const char *item)
-{
-  if (size() > 0) {
-    memmove(__item_at(1), __item_at(0), static_cast<size_t>(size()) * item_size());
-  }
-  memcpy(__item_at(0), item, item_size());
-  increase_size(1);
-}
-
 char *LeafIndexNodeHandler::__item_at(int index) const
 {
   return leaf_node_->array + (index * item_size());
@@ -382,8 +409,9 @@ bool LeafIndexNodeHandler::validate(const KeyComparator &comparator, DiskBufferP
 }
 
 /////////////////////////////////////////////////////////////////////////////////
-InternalIndexNodeHandler::InternalIndexNodeHandler(const IndexFileHeader &header, Frame *frame)
-    : IndexNodeHandler(header, frame), internal_node_((InternalIndexNode *)frame->data())
+InternalIndexNodeHandler::InternalIndexNodeHandler(
+    const IndexFileHeader &header, Frame *frame, BplusTreeMiniTransaction *mtr)
+    : IndexNodeHandler(header, frame, mtr), internal_node_((InternalIndexNode *)frame->data())
 {}
 
 std::string to_string(const InternalIndexNodeHandler &node, const KeyPrinter &printer)
@@ -412,6 +440,10 @@ void InternalIndexNodeHandler::create_new_root(PageNum first_page_num, const cha
   memcpy(__item_at(1), key, key_size());
   memcpy(__value_at(1), &page_num, value_size());
   increase_size(2);
+
+  if (BplusTreeLogger *logger = this->logger()) {
+    logger->insert_items(frame_, 0, __item_at(0), 2, item_size());
+  }
 }
 
 /**
@@ -429,6 +461,10 @@ void InternalIndexNodeHandler::insert(const char *key, PageNum page_num, const K
   memcpy(__item_at(insert_position), key, key_size());
   memcpy(__value_at(insert_position), &page_num, value_size());
   increase_size(1);
+
+  if (BplusTreeLogger *logger = this->logger()) {
+    logger->insert_items(frame_, insert_position, __item_at(insert_position), 1, item_size());
+  }
 }
 
 RC InternalIndexNodeHandler::move_half_to(InternalIndexNodeHandler &other, DiskBufferPool *bp)
@@ -441,7 +477,7 @@ RC InternalIndexNodeHandler::move_half_to(InternalIndexNodeHandler &other, DiskB
     return rc;
   }
 
-  increase_size(-(size - move_index));
+  remove_items(move_index, size - move_index);
   return rc;
 }
 
@@ -488,6 +524,10 @@ void InternalIndexNodeHandler::set_key_at(int index, const char *key)
 {
   assert(index >= 0 && index < size());
   memcpy(__key_at(index), key, key_size());
+
+  if (BplusTreeLogger *logger = this->logger()) {
+    logger->update_key(frame_, index, __key_at(index), key_size());
+  }
 }
 
 PageNum InternalIndexNodeHandler::value_at(int index)
@@ -508,11 +548,34 @@ int InternalIndexNodeHandler::value_index(PageNum page_num)
 
 void InternalIndexNodeHandler::remove(int index)
 {
-  assert(index >= 0 && index < size());
-  if (index < size() - 1) {
-    memmove(__item_at(index), __item_at(index + 1), (static_cast<size_t>(size()) - index - 1) * item_size());
+  remove_items(index, 1);
+}
+
+void InternalIndexNodeHandler::insert_items(int index, const char *items, int num)
+{
+  assert(index >= 0 && index <= size() && num >= 0);
+  if (index < size()) {
+    memmove(__item_at(index + num), __item_at(index), (static_cast<size_t>(size()) - index) * item_size());
+  }
+  memcpy(__item_at(index), items, static_cast<size_t>(num) * item_size());
+  increase_size(num);
+
+  if (BplusTreeLogger *logger = this->logger()) {
+    logger->insert_items(frame_, index, __item_at(index), num, item_size());
+  }
+}
+
+void InternalIndexNodeHandler::remove_items(int index, int num)
+{
+  assert(index >= 0 && num >= 0 && index + num <= size());
+  if (index + num < size()) {
+    memmove(__item_at(index), __item_at(index + num), (static_cast<size_t>(size()) - index - num) * item_size());
+  }
+  increase_size(-num);
+
+  if (BplusTreeLogger *logger = this->logger()) {
+    logger->remove_items(frame_, index, num);
   }
-  increase_size(-1);
 }
 
 RC InternalIndexNodeHandler::move_to(InternalIndexNodeHandler &other, DiskBufferPool *disk_buffer_pool)
@@ -523,7 +586,7 @@ RC InternalIndexNodeHandler::move_to(InternalIndexNodeHandler &other, DiskBuffer
     return rc;
   }
 
-  increase_size(-this->size());
+  remove_items(0, this->size());
   return RC::SUCCESS;
 }
 
@@ -535,10 +598,7 @@ RC InternalIndexNodeHandler::move_first_to_end(InternalIndexNodeHandler &other,
     return rc;
   }
 
-  if (size() >= 1) {
-    memmove(__item_at(0), __item_at(1), (static_cast<size_t>(size()) - 1) * item_size());
-  }
-  increase_size(-1);
+  remove_items(0, 1);
   return rc;
 }
 
@@ -550,7 +610,7 @@ RC InternalIndexNodeHandler::move_last_to_front(InternalIndexNodeHandler &other,
     return rc;
   }
 
-  increase_size(-1);
+  remove_items(size() - 1, 1);
   return rc;
 }
 /**
@@ -558,25 +618,16 @@ RC InternalIndexNodeHandler::move_last_to_front(InternalIndexNodeHandler &other,
  */
 RC InternalIndexNodeHandler::copy_from(const char *items, int num, DiskBufferPool *disk_buffer_pool)
 {
-  memcpy(__item_at(this->size()), items, static_cast<size_t>(num) * item_size());
+  insert_items(this->size(), items, num);
 
   RC rc = RC::SUCCESS;
-  PageNum this_page_num = this->page_num();
-  Frame *frame = nullptr;
   for (int i = 0; i < num; i++) {
     const PageNum page_num = *(const PageNum *)((items + i * item_size()) + key_size());
-    rc = disk_buffer_pool->get_this_page(page_num, &frame);
+    rc = set_child_parent(page_num, disk_buffer_pool);
     if (rc != RC::SUCCESS) {
-      LOG_WARN("failed to set child's page num. child page num:%d, this page num=%d, rc=%d:%s",
-               page_num, this_page_num, rc, strrc(rc));
       return rc;
     }
-    IndexNodeHandler child_node(header_, frame);
-    child_node.set_parent_page_num(this_page_num);
-    frame->mark_dirty();
-    disk_buffer_pool->unpin_page(frame);
   }
-  increase_size(num);
   return rc;
 }
 
@@ -588,25 +639,37 @@ RC InternalIndexNodeHandler::append(const char *item, DiskBufferPool *bp)
 RC InternalIndexNodeHandler::preappend(const char *item, DiskBufferPool *bp)
 {
   PageNum child_page_num = *(PageNum *)(item + key_size());
+  RC rc = set_child_parent(child_page_num, bp);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
+
+  insert_items(0, item, 1);
+  return RC::SUCCESS;
+}
+
+RC InternalIndexNodeHandler::set_child_parent(PageNum child_page_num, DiskBufferPool *bp)
+{
   Frame *frame = nullptr;
-  RC rc = bp->get_this_page(child_page_num, &frame);
+  RC rc = RC::SUCCESS;
+  if (mtr_ != nullptr) {
+    rc = mtr_->latch_memo().get_page(child_page_num, frame);
+  } else {
+    rc = bp->get_this_page(child_page_num, &frame);
+  }
   if (rc != RC::SUCCESS) {
-    LOG_WARN("failed to fetch child page. rc=%d:%s", rc, strrc(rc));
+    LOG_WARN("failed to fetch child page. child page num:%d, this page num=%d, rc=%d:%s",
+             child_page_num, this->page_num(), rc, strrc(rc));
     return rc;
   }
 
-  IndexNodeHandler child_node(header_, frame);
+  IndexNodeHandler child_node(header_, frame, mtr_);
   child_node.set_parent_page_num(this->page_num());
-
   frame->mark_dirty();
-  bp->unpin_page(frame);
 
-  if (this->size() > 0) {
-    memmove(__item_at(1), __item_at(0), static_cast<size_t>(this->size()) * item_size());
+  if (nullptr == mtr_) {
+    bp->unpin_page(frame);
   }
-
-  memcpy(__item_at(0), item, item_size());
-  increase_size(1);
   return RC::SUCCESS;
 }
 
@@ -1077,6 +1140,162 @@ bool BplusTreeHandler::is_empty() const
   return file_header_.root_page == BP_INVALID_PAGE_NUM;
 }
 
+void BplusTreeHandler::set_log_manager(CLogManager *log_manager, int32_t table_id, int32_t index_id)
+{
+  log_manager_  = log_manager;
+  log_table_id_ = table_id;
+  log_index_id_ = index_id;
+  if (disk_buffer_pool_ != nullptr) {
+    disk_buffer_pool_->set_log_manager(log_manager);
+  }
+}
+
+RC BplusTreeHandler::redo(LSN lsn, const char *data, int len)
+{
+  // 同一条日志中对同一个页面的修改，要么都重做，要么都不重做，所以在第一次访问页面时就确定下来
+  struct RedoPage
+  {
+    Frame *frame;
+    bool   need_redo;
+  };
+  std::vector<RedoPage> pages;
+
+  RC rc = RC::SUCCESS;
+  int offset = 0;
+  while (OB_SUCC(rc) && offset < len) {
+    BplusTreeLogEntryHeader entry;
+    if (len - offset < static_cast<int>(sizeof(entry))) {
+      LOG_WARN("invalid bplus tree log. lsn=%d, len=%d, offset=%d", lsn, len, offset);
+      rc = RC::INTERNAL;
+      break;
+    }
+
+    memcpy(&entry, data + offset, sizeof(entry));
+    const char *entry_data = data + offset + sizeof(entry);
+    offset += static_cast<int>(sizeof(entry)) + entry.data_len_;
+    if (entry.data_len_ < 0 || offset > len) {
+      LOG_WARN("invalid bplus tree log entry. lsn=%d, entry={%s}", lsn, entry.to_string().c_str());
+      rc = RC::INTERNAL;
+      break;
+    }
+
+    LOG_TRACE("redo bplus tree log entry. lsn=%d, entry={%s}", lsn, entry.to_string().c_str());
+    const BplusTreeLogOperation operation = static_cast<BplusTreeLogOperation>(entry.operation_);
+    if (operation == BplusTreeLogOperation::ALLOCATE_PAGE) {
+      rc = disk_buffer_pool_->recover_page(entry.page_num_);
+      continue;
+    }
+    if (operation == BplusTreeLogOperation::DISPOSE_PAGE) {
+      rc = disk_buffer_pool_->recover_dispose_page(entry.page_num_);
+      continue;
+    }
+
+    auto iter = std::find_if(pages.begin(), pages.end(),
+        [&entry](const RedoPage &page) { return page.frame->page_num() == entry.page_num_; });
+    if (iter == pages.end()) {
+      Frame *frame = nullptr;
+      rc = disk_buffer_pool_->get_this_page(entry.page_num_, &frame);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to fetch page while redo bplus tree log. page num=%d, rc=%s", entry.page_num_, strrc(rc));
+        break;
+      }
+      pages.push_back(RedoPage{frame, frame->lsn() < lsn});
+      iter = pages.end() - 1;
+    }
+
+    if (iter->need_redo) {
+      rc = redo_entry(entry, entry_data, iter->frame);
+    }
+  }
+
+  for (RedoPage &page : pages) {
+    if (page.need_redo) {
+      page.frame->set_lsn(lsn);
+      page.frame->mark_dirty();
+    }
+    disk_buffer_pool_->unpin_page(page.frame);
+  }
+  return rc;
+}
+
+RC BplusTreeHandler::redo_entry(const BplusTreeLogEntryHeader &entry, const char *entry_data, Frame *frame)
+{
+  IndexNodeHandler node(file_header_, frame);
+  switch (static_cast<BplusTreeLogOperation>(entry.operation_)) {
+    case BplusTreeLogOperation::UPDATE_ROOT_PAGE: {
+      file_header_.root_page = entry.value_;
+      memcpy(frame->data(), &file_header_, sizeof(file_header_));
+    } break;
+
+    case BplusTreeLogOperation::INIT_NODE: {
+      if (entry.value_ != 0) {
+        LeafIndexNodeHandler(file_header_, frame).init_empty();
+      } else {
+        InternalIndexNodeHandler(file_header_, frame).init_empty();
+      }
+    } break;
+
+    case BplusTreeLogOperation::SET_PARENT_PAGE: {
+      node.set_parent_page_num(entry.value_);
+    } break;
+
+    case BplusTreeLogOperation::SET_NEXT_PAGE: {
+      if (!node.is_leaf()) {
+        LOG_WARN("cannot set next page of an internal node. entry={%s}", entry.to_string().c_str());
+        return RC::INTERNAL;
+      }
+      LeafIndexNodeHandler(file_header_, frame).set_next_page(entry.value_);
+    } break;
+
+    case BplusTreeLogOperation::INSERT_ITEMS: {
+      const int item_size = node.is_leaf() ? file_header_.key_length + static_cast<int>(sizeof(RID))
+                                           : file_header_.key_length + static_cast<int>(sizeof(PageNum));
+      if (entry.position_ < 0 || entry.position_ > node.size() || entry.count_ < 0 ||
+          entry.count_ * item_size != entry.data_len_ || node.size() + entry.count_ > node.max_size()) {
+        LOG_WARN("invalid insert items log entry. node={%s}, entry={%s}",
+                 to_string(node).c_str(), entry.to_string().c_str());
+        return RC::INTERNAL;
+      }
+
+      if (node.is_leaf()) {
+        LeafIndexNodeHandler(file_header_, frame).insert_items(entry.position_, entry_data, entry.count_);
+      } else {
+        InternalIndexNodeHandler(file_header_, frame).insert_items(entry.position_, entry_data, entry.count_);
+      }
+    } break;
+
+    case BplusTreeLogOperation::REMOVE_ITEMS: {
+      if (entry.position_ < 0 || entry.count_ < 0 || entry.position_ + entry.count_ > node.size()) {
+        LOG_WARN("invalid remove items log entry. node={%s}, entry={%s}",
+                 to_string(node).c_str(), entry.to_string().c_str());
+        return RC::INTERNAL;
+      }
+
+      if (node.is_leaf()) {
+        LeafIndexNodeHandler(file_header_, frame).remove_items(entry.position_, entry.count_);
+      } else {
+        InternalIndexNodeHandler(file_header_, frame).remove_items(entry.position_, entry.count_);
+      }
+    } break;
+
+    case BplusTreeLogOperation::UPDATE_KEY: {
+      if (node.is_leaf() || entry.position_ < 0 || entry.position_ >= node.size() ||
+          entry.data_len_ != file_header_.key_length) {
+        LOG_WARN("invalid update key log entry. node={%s}, entry={%s}",
+                 to_string(node).c_str(), entry.to_string().c_str());
+        return RC::INTERNAL;
+      }
+      InternalIndexNodeHandler(file_header_, frame).set_key_at(entry.position_, entry_data);
+    } break;
+
+    default: {
+      LOG_WARN("unknown bplus tree log entry. entry={%s}", entry.to_string().c_str());
+      return RC::INTERNAL;
+    } break;
+  }
+  return RC::SUCCESS;
+}
+
 RC BplusTreeHandler::find_leaf(LatchMemo &latch_memo, BplusTreeOperationType op, const char *key, Frame *&frame)
 {
   auto child_page_getter = [this, key](InternalIndexNodeHandler &internal_node) {
@@ -1152,9 +1371,9 @@ RC BplusTreeHandler::crabing_protocal_fetch_page(LatchMemo &latch_memo,
   return rc;
 }
 
-RC BplusTreeHandler::insert_entry_into_leaf_node(LatchMemo &latch_memo, Frame *frame, const char *key, const RID *rid)
+RC BplusTreeHandler::insert_entry_into_leaf_node(BplusTreeMiniTransaction &mtr, Frame *frame, const char *key, const RID *rid)
 {
-  LeafIndexNodeHandler leaf_node(file_header_, frame);
+  LeafIndexNodeHandler leaf_node(file_header_, frame, &mtr);
   bool exists = false; // 该数据是否已经存在指定的叶子节点中了
   int insert_position = leaf_node.lookup(key_comparator_, key, &exists);
   if (exists) {
@@ -1169,14 +1388,16 @@ RC BplusTreeHandler::insert_entry_into_leaf_node(LatchMemo &latch_memo, Frame *f
     return RC::SUCCESS;
   }
 
+  mtr.set_log_type(CLogType::BTREE_SPLIT);
+
   Frame *new_frame = nullptr;
-  RC rc = split<LeafIndexNodeHandler>(latch_memo, frame, new_frame);
+  RC rc = split<LeafIndexNodeHandler>(mtr, frame, new_frame);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to split leaf node. rc=%d:%s", rc, strrc(rc));
     return rc;
   }
 
-  LeafIndexNodeHandler new_index_node(file_header_, new_frame);
+  LeafIndexNodeHandler new_index_node(file_header_, new_frame, &mtr);
   new_index_node.set_next_page(leaf_node.next_page());
   new_index_node.set_parent_page_num(leaf_node.parent_page_num());
   leaf_node.set_next_page(new_frame->page_num());
@@ -1187,28 +1408,33 @@ RC BplusTreeHandler::insert_entry_into_leaf_node(LatchMemo &latch_memo, Frame *f
     new_index_node.insert(insert_position - leaf_node.size(), key, (const char *)rid);
   }
 
-  return insert_entry_into_parent(latch_memo, frame, new_frame, new_index_node.key_at(0));
+  return insert_entry_into_parent(mtr, frame, new_frame, new_index_node.key_at(0));
 }
 
-RC BplusTreeHandler::insert_entry_into_parent(LatchMemo &latch_memo, Frame *frame, Frame *new_frame, const char *key)
+RC BplusTreeHandler::insert_entry_into_parent(BplusTreeMiniTransaction &mtr, Frame *frame, Frame *new_frame, const char *key)
 {
   RC rc = RC::SUCCESS;
 
-  IndexNodeHandler node_handler(file_header_, frame);
-  IndexNodeHandler new_node_handler(file_header_, new_frame);
+  IndexNodeHandler node_handler(file_header_, frame, &mtr);
+  IndexNodeHandler new_node_handler(file_header_, new_frame, &mtr);
   PageNum parent_page_num = node_handler.parent_page_num();
 
   if (parent_page_num == BP_INVALID_PAGE_NUM) {
 
     // create new root page
+    // 新的根页面也由latch memo来持有，等日志提交之后再释放
     Frame *root_frame;
-    rc = disk_buffer_pool_->allocate_page(&root_frame);
+    rc = mtr.latch_memo().allocate_page(root_frame);
     if (rc != RC::SUCCESS) {
       LOG_WARN("failed to allocate new root page. rc=%d:%s", rc, strrc(rc));
       return rc;
     }
+    mtr.logger().allocate_page(root_frame->page_num());
+
+    // 在root页面更新之后，别人就可以访问到了，这时候就要加上锁
+    mtr.latch_memo().xlatch(root_frame);
 
-    InternalIndexNodeHandler root_node(file_header_, root_frame);
+    InternalIndexNodeHandler root_node(file_header_, root_frame, &mtr);
     root_node.init_empty();
     root_node.create_new_root(frame->page_num(), key, new_frame->page_num());
     node_handler.set_parent_page_num(root_frame->page_num());
@@ -1216,21 +1442,14 @@ RC BplusTreeHandler::insert_entry_into_parent(LatchMemo &latch_memo, Frame *fram
 
     frame->mark_dirty();
     new_frame->mark_dirty();
-    // disk_buffer_pool_->unpin_page(frame);
-    // disk_buffer_pool_->unpin_page(new_frame);
-
-    root_frame->write_latch(); // 在root页面更新之后，别人就可以访问到了，这时候就要加上锁
-    update_root_page_num_locked(root_frame->page_num());
     root_frame->mark_dirty();
-    root_frame->write_unlatch();
-    disk_buffer_pool_->unpin_page(root_frame);
 
-    return RC::SUCCESS;
+    return update_root_page_num_locked(mtr, root_frame->page_num());
 
   } else {
 
     Frame *parent_frame = nullptr;
-    rc = latch_memo.get_page(parent_page_num, parent_frame);
+    rc = mtr.latch_memo().get_page(parent_page_num, parent_frame);
     if (rc != RC::SUCCESS) {
       LOG_WARN("failed to insert entry into leaf. rc=%d:%s", rc, strrc(rc));
       // we should do some things to recover
@@ -1238,7 +1457,7 @@ RC BplusTreeHandler::insert_entry_into_parent(LatchMemo &latch_memo, Frame *fram
     }
 
     // 在第一次遍历这个页面时，我们已经拿到parent frame的write latch，所以这里不再去加锁
-    InternalIndexNodeHandler parent_node(file_header_, parent_frame);
+    InternalIndexNodeHandler parent_node(file_header_, parent_frame, &mtr);
 
     /// 当前这个父节点还没有满，直接将新节点数据插进入就行了
     if (parent_node.size() < parent_node.max_size()) {
@@ -1256,7 +1475,7 @@ RC BplusTreeHandler::insert_entry_into_parent(LatchMemo &latch_memo, Frame *fram
 
       // 当前父节点即将装满了，那只能再将父节点执行分裂操作
       Frame *new_parent_frame = nullptr;
-      rc = split<InternalIndexNodeHandler>(latch_memo, parent_frame, new_parent_frame);
+      rc = split<InternalIndexNodeHandler>(mtr, parent_frame, new_parent_frame);
       if (rc != RC::SUCCESS) {
         LOG_WARN("failed to split internal node. rc=%d:%s", rc, strrc(rc));
         // disk_buffer_pool_->unpin_page(frame);
@@ -1264,7 +1483,7 @@ RC BplusTreeHandler::insert_entry_into_parent(LatchMemo &latch_memo, Frame *fram
         // disk_buffer_pool_->unpin_page(parent_frame);
       } else {
         // insert into left or right ? decide by key compare result
-        InternalIndexNodeHandler new_node(file_header_, new_parent_frame);
+        InternalIndexNodeHandler new_node(file_header_, new_parent_frame, &mtr);
         if (key_comparator_(key, new_node.key_at(0)) > 0) {
           new_node.insert(key, new_frame->page_num(), key_comparator_);
           new_node_handler.set_parent_page_num(new_node.page_num());
@@ -1279,7 +1498,7 @@ RC BplusTreeHandler::insert_entry_into_parent(LatchMemo &latch_memo, Frame *fram
         // 虽然这里是递归调用，但是通常B+ Tree 的层高比较低（3层已经可以容纳很多数据），所以没有栈溢出风险。
         // Q: 在查找叶子节点时，我们都会尝试将没必要的锁提前释放掉，在这里插入数据时，是在向上遍历节点，
         //    理论上来说，我们可以释放更低层级节点的锁，但是并没有这么做，为什么？
-        rc = insert_entry_into_parent(latch_memo, parent_frame, new_parent_frame, new_node.key_at(0));
+        rc = insert_entry_into_parent(mtr, parent_frame, new_parent_frame, new_node.key_at(0));
       }
     }
   }
@@ -1290,20 +1509,21 @@ RC BplusTreeHandler::insert_entry_into_parent(LatchMemo &latch_memo, Frame *fram
  * split one full node into two
  */
 template <typename IndexNodeHandlerType>
-RC BplusTreeHandler::split(LatchMemo &latch_memo, Frame *frame, Frame *&new_frame)
+RC BplusTreeHandler::split(BplusTreeMiniTransaction &mtr, Frame *frame, Frame *&new_frame)
 {
-  IndexNodeHandlerType old_node(file_header_, frame);
+  IndexNodeHandlerType old_node(file_header_, frame, &mtr);
 
   // add a new node
-  RC rc = latch_memo.allocate_page(new_frame);
+  RC rc = mtr.latch_memo().allocate_page(new_frame);
   if (rc != RC::SUCCESS) {
     LOG_WARN("Failed to split index page due to failed to allocate page, rc=%d:%s", rc, strrc(rc));
     return rc;
   }
+  mtr.logger().allocate_page(new_frame->page_num());
 
-  latch_memo.xlatch(new_frame);
+  mtr.latch_memo().xlatch(new_frame);
 
-  IndexNodeHandlerType new_node(file_header_, new_frame);
+  IndexNodeHandlerType new_node(file_header_, new_frame, &mtr);
   new_node.init_empty();
   new_node.set_parent_page_num(old_node.parent_page_num());
 
@@ -1314,14 +1534,27 @@ RC BplusTreeHandler::split(LatchMemo &latch_memo, Frame *frame, Frame *&new_fram
   return RC::SUCCESS;
 }
 
-void BplusTreeHandler::update_root_page_num_locked(PageNum root_page_num)
+RC BplusTreeHandler::update_root_page_num_locked(BplusTreeMiniTransaction &mtr, PageNum root_page_num)
 {
   file_header_.root_page = root_page_num;
-  header_dirty_ = true;
   LOG_DEBUG("set root page to %d", root_page_num);
+
+  // 根节点的修改也需要记录日志，所以直接修改第一个页面，而不是等到sync时再写
+  Frame *header_frame = nullptr;
+  RC rc = mtr.latch_memo().get_page(FIRST_INDEX_PAGE, header_frame);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to fetch index header page. rc=%s", strrc(rc));
+    header_dirty_ = true;
+    return rc;
+  }
+
+  memcpy(header_frame->data(), &file_header_, sizeof(file_header_));
+  header_frame->mark_dirty();
+  mtr.logger().update_root_page(header_frame, root_page_num);
+  return RC::SUCCESS;
 }
 
-RC BplusTreeHandler::create_new_tree(const char *key, const RID *rid)
+RC BplusTreeHandler::create_new_tree(BplusTreeMiniTransaction &mtr, const char *key, const RID *rid)
 {
   RC rc = RC::SUCCESS;
   if (file_header_.root_page != BP_INVALID_PAGE_NUM) {
@@ -1331,21 +1564,18 @@ RC BplusTreeHandler::create_new_tree(const char *key, const RID *rid)
   }
 
   Frame *frame = nullptr;
-  rc = disk_buffer_pool_->allocate_page(&frame);
+  rc = mtr.latch_memo().allocate_page(frame);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to allocate root page. rc=%d:%s", rc, strrc(rc));
     return rc;
   }
+  mtr.logger().allocate_page(frame->page_num());
 
-  LeafIndexNodeHandler leaf_node(file_header_, frame);
+  LeafIndexNodeHandler leaf_node(file_header_, frame, &mtr);
   leaf_node.init_empty();
   leaf_node.insert(0, key, (const char *)rid);
-  update_root_page_num_locked(frame->page_num());
   frame->mark_dirty();
-  disk_buffer_pool_->unpin_page(frame);
-
-  // disk_buffer_pool_->check_all_pages_unpinned(file_id_);
-  return rc;
+  return update_root_page_num_locked(mtr, frame->page_num());
 }
 
 MemPoolItem::unique_ptr BplusTreeHandler::make_key(const char *user_key, const RID &rid)
@@ -1375,30 +1605,36 @@ RC BplusTreeHandler::insert_entry(const char *user_key, const RID *rid)
 
   char *key = static_cast<char *>(pkey.get());
 
+  BplusTreeMiniTransaction mtr(disk_buffer_pool_, log_manager_, log_table_id_, log_index_id_,
+                               CLogType::BTREE_LEAF_INSERT);
   if (is_empty()) {
-    root_lock_.lock();
+    mtr.latch_memo().xlatch(&root_lock_);
     if (is_empty()) {
-      RC rc = create_new_tree(key, rid);
-      root_lock_.unlock();
-      return rc;
+      RC rc = create_new_tree(mtr, key, rid);
+      RC rc2 = mtr.commit();
+      return OB_SUCC(rc) ? rc2 : rc;
     }
-    root_lock_.unlock();
+    mtr.latch_memo().release();
   }
 
-  LatchMemo latch_memo(disk_buffer_pool_);
-
   Frame *frame = nullptr;
-  RC rc = find_leaf(latch_memo, BplusTreeOperationType::INSERT, key, frame);
+  RC rc = find_leaf(mtr.latch_memo(), BplusTreeOperationType::INSERT, key, frame);
   if (rc != RC::SUCCESS) {
     LOG_WARN("Failed to find leaf %s. rc=%d:%s", rid->to_string().c_str(), rc, strrc(rc));
     return rc;
   }
 
-  rc = insert_entry_into_leaf_node(latch_memo, frame, key, rid);
+  rc = insert_entry_into_leaf_node(mtr, frame, key, rid);
+  // 失败时页面也可能已经被修改了，同样需要提交日志
+  RC rc2 = mtr.commit();
   if (rc != RC::SUCCESS) {
     LOG_TRACE("Failed to insert into leaf of index, rid:%s. rc=%s", rid->to_string().c_str(), strrc(rc));
     return rc;
   }
+  if (rc2 != RC::SUCCESS) {
+    LOG_WARN("failed to commit bplus tree log. rc=%s", strrc(rc2));
+    return rc2;
+  }
 
   LOG_TRACE("insert entry success");
   return RC::SUCCESS;
@@ -1427,9 +1663,9 @@ RC BplusTreeHandler::get_entry(const char *user_key, int key_len, std::list<RID>
   return rc;
 }
 
-RC BplusTreeHandler::adjust_root(LatchMemo &latch_memo, Frame *root_frame)
+RC BplusTreeHandler::adjust_root(BplusTreeMiniTransaction &mtr, Frame *root_frame)
 {
-  IndexNodeHandler root_node(file_header_, root_frame);
+  IndexNodeHandler root_node(file_header_, root_frame, &mtr);
   if (root_node.is_leaf() && root_node.size() > 0) {
     root_frame->mark_dirty();
     return RC::SUCCESS;
@@ -1446,30 +1682,36 @@ RC BplusTreeHandler::adjust_root(LatchMemo &latch_memo, Frame *root_frame)
 
     const PageNum child_page_num = internal_node.value_at(0);
     Frame *child_frame = nullptr;
-    RC rc = latch_memo.get_page(child_page_num, child_frame);
+    RC rc = mtr.latch_memo().get_page(child_page_num, child_frame);
     if (rc != RC::SUCCESS) {
       LOG_WARN("failed to fetch child page. page num=%d, rc=%d:%s", child_page_num, rc, strrc(rc));
       return rc;
     }
 
-    IndexNodeHandler child_node(file_header_, child_frame);
+    IndexNodeHandler child_node(file_header_, child_frame, &mtr);
     child_node.set_parent_page_num(BP_INVALID_PAGE_NUM);
+    child_frame->mark_dirty();
 
     // file_header_.root_page = child_page_num;
     new_root_page_num = child_page_num;
   }
 
-  update_root_page_num_locked(new_root_page_num);
+  mtr.set_log_type(CLogType::BTREE_MERGE);
+  RC rc = update_root_page_num_locked(mtr, new_root_page_num);
+  if (rc != RC::SUCCESS) {
+    return rc;
+  }
 
   PageNum old_root_page_num = root_frame->page_num();
-  latch_memo.dispose_page(old_root_page_num);
+  mtr.latch_memo().dispose_page(old_root_page_num);
+  mtr.logger().dispose_page(old_root_page_num);
   return RC::SUCCESS;
 }
 
 template <typename IndexNodeHandlerType>
-RC BplusTreeHandler::coalesce_or_redistribute(LatchMemo &latch_memo, Frame *frame)
+RC BplusTreeHandler::coalesce_or_redistribute(BplusTreeMiniTransaction &mtr, Frame *frame)
 {
-  IndexNodeHandlerType index_node(file_header_, frame);
+  IndexNodeHandlerType index_node(file_header_, frame, &mtr);
   if (index_node.size() >= index_node.min_size()) {
     return RC::SUCCESS;
   }
@@ -1480,19 +1722,19 @@ RC BplusTreeHandler::coalesce_or_redistribute(LatchMemo &latch_memo, Frame *fram
     if (index_node.size() > 1) {
     } else {
       // adjust the root node
-      adjust_root(latch_memo, frame);
+      return adjust_root(mtr, frame);
     }
     return RC::SUCCESS;
   }
 
   Frame *parent_frame = nullptr;
-  RC rc = latch_memo.get_page(parent_page_num, parent_frame);
+  RC rc = mtr.latch_memo().get_page(parent_page_num, parent_frame);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to fetch parent page. page id=%d, rc=%d:%s", parent_page_num, rc, strrc(rc));
     return rc;
   }
 
-  InternalIndexNodeHandler parent_index_node(file_header_, parent_frame);
+  InternalIndexNodeHandler parent_index_node(file_header_, parent_frame, &mtr);
   int index = parent_index_node.lookup(key_comparator_, index_node.key_at(index_node.size() - 1));
   ASSERT(parent_index_node.value_at(index) == frame->page_num(),
          "lookup return an invalid value. index=%d, this page num=%d, but got %d",
@@ -1506,29 +1748,32 @@ RC BplusTreeHandler::coalesce_or_redistribute(LatchMemo &latch_memo, Frame *fram
   }
 
   Frame *neighbor_frame = nullptr;
-  rc = latch_memo.get_page(neighbor_page_num, neighbor_frame); // 当前已经拥有了父节点的写锁，所以直接尝试获取此页面然后加锁
+  rc = mtr.latch_memo().get_page(neighbor_page_num, neighbor_frame); // 当前已经拥有了父节点的写锁，所以直接尝试获取此页面然后加锁
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to fetch neighbor page. page id=%d, rc=%d:%s", neighbor_page_num, rc, strrc(rc));
     // do something to release resource
     return rc;
   }
 
-  latch_memo.xlatch(neighbor_frame);
+  mtr.latch_memo().xlatch(neighbor_frame);
+
+  mtr.set_log_type(CLogType::BTREE_MERGE);
 
-  IndexNodeHandlerType neighbor_node(file_header_, neighbor_frame);
+  IndexNodeHandlerType neighbor_node(file_header_, neighbor_frame, &mtr);
   if (index_node.size() + neighbor_node.size() > index_node.max_size()) {
-    rc = redistribute<IndexNodeHandlerType>(neighbor_frame, frame, parent_frame, index);
+    rc = redistribute<IndexNodeHandlerType>(mtr, neighbor_frame, frame, parent_frame, index);
   } else {
-    rc = coalesce<IndexNodeHandlerType>(latch_memo, neighbor_frame, frame, parent_frame, index);
+    rc = coalesce<IndexNodeHandlerType>(mtr, neighbor_frame, frame, parent_frame, index);
   }
 
   return rc;
 }
 
 template <typename IndexNodeHandlerType>
-RC BplusTreeHandler::coalesce(LatchMemo &latch_memo, Frame *neighbor_frame, Frame *frame, Frame *parent_frame, int index)
+RC BplusTreeHandler::coalesce(
+    BplusTreeMiniTransaction &mtr, Frame *neighbor_frame, Frame *frame, Frame *parent_frame, int index)
 {
-  InternalIndexNodeHandler parent_node(file_header_, parent_frame);
+  InternalIndexNodeHandler parent_node(file_header_, parent_frame, &mtr);
 
   Frame *left_frame = nullptr;
   Frame *right_frame = nullptr;
@@ -1543,8 +1788,8 @@ RC BplusTreeHandler::coalesce(LatchMemo &latch_memo, Frame *neighbor_frame, Fram
     // neighbor is at left
   }
 
-  IndexNodeHandlerType left_node(file_header_, left_frame);
-  IndexNodeHandlerType right_node(file_header_, right_frame);
+  IndexNodeHandlerType left_node(file_header_, left_frame, &mtr);
+  IndexNodeHandlerType right_node(file_header_, right_frame, &mtr);
 
   parent_node.remove(index);
   // parent_node.validate(key_comparator_, disk_buffer_pool_, file_id_);
@@ -1556,21 +1801,26 @@ RC BplusTreeHandler::coalesce(LatchMemo &latch_memo, Frame *neighbor_frame, Fram
   // left_node.validate(key_comparator_);
 
   if (left_node.is_leaf()) {
-    LeafIndexNodeHandler left_leaf_node(file_header_, left_frame);
-    LeafIndexNodeHandler right_leaf_node(file_header_, right_frame);
+    LeafIndexNodeHandler left_leaf_node(file_header_, left_frame, &mtr);
+    LeafIndexNodeHandler right_leaf_node(file_header_, right_frame, &mtr);
     left_leaf_node.set_next_page(right_leaf_node.next_page());
   }
 
-  latch_memo.dispose_page(right_frame->page_num());
-  return coalesce_or_redistribute<InternalIndexNodeHandler>(latch_memo, parent_frame);
+  left_frame->mark_dirty();
+  parent_frame->mark_dirty();
+
+  mtr.latch_memo().dispose_page(right_frame->page_num());
+  mtr.logger().dispose_page(right_frame->page_num());
+  return coalesce_or_redistribute<InternalIndexNodeHandler>(mtr, parent_frame);
 }
 
 template <typename IndexNodeHandlerType>
-RC BplusTreeHandler::redistribute(Frame *neighbor_frame, Frame *frame, Frame *parent_frame, int index)
+RC BplusTreeHandler::redistribute(
+    BplusTreeMiniTransaction &mtr, Frame *neighbor_frame, Frame *frame, Frame *parent_frame, int index)
 {
-  InternalIndexNodeHandler parent_node(file_header_, parent_frame);
-  IndexNodeHandlerType neighbor_node(file_header_, neighbor_frame);
-  IndexNodeHandlerType node(file_header_, frame);
+  InternalIndexNodeHandler parent_node(file_header_, parent_frame, &mtr);
+  IndexNodeHandlerType neighbor_node(file_header_, neighbor_frame, &mtr);
+  IndexNodeHandlerType node(file_header_, frame, &mtr);
   if (neighbor_node.size() < node.size()) {
     LOG_ERROR("got invalid nodes. neighbor node size %d, this node size %d", neighbor_node.size(), node.size());
   }
@@ -1597,9 +1847,9 @@ RC BplusTreeHandler::redistribute(Frame *neighbor_frame, Frame *frame, Frame *pa
   return RC::SUCCESS;
 }
 
-RC BplusTreeHandler::delete_entry_internal(LatchMemo &latch_memo, Frame *leaf_frame, const char *key)
+RC BplusTreeHandler::delete_entry_internal(BplusTreeMiniTransaction &mtr, Frame *leaf_frame, const char *key)
 {
-  LeafIndexNodeHandler leaf_index_node(file_header_, leaf_frame);
+  LeafIndexNodeHandler leaf_index_node(file_header_, leaf_frame, &mtr);
 
   const int remove_count = leaf_index_node.remove(key, key_comparator_);
   if (remove_count == 0) {
@@ -1615,7 +1865,7 @@ RC BplusTreeHandler::delete_entry_internal(LatchMemo &latch_memo, Frame *leaf_fr
     return RC::SUCCESS;
   }
 
-  return coalesce_or_redistribute<LeafIndexNodeHandler>(latch_memo, leaf_frame);
+  return coalesce_or_redistribute<LeafIndexNodeHandler>(mtr, leaf_frame);
 }
 
 RC BplusTreeHandler::delete_entry(const char *user_key, const RID *rid)
@@ -1631,10 +1881,11 @@ RC BplusTreeHandler::delete_entry(const char *user_key, const RID *rid)
   memcpy(key + file_header_.attr_length, rid, sizeof(*rid));
 
   BplusTreeOperationType op = BplusTreeOperationType::DELETE;
-  LatchMemo latch_memo(disk_buffer_pool_);
+  BplusTreeMiniTransaction mtr(disk_buffer_pool_, log_manager_, log_table_id_, log_index_id_,
+                               CLogType::BTREE_LEAF_DELETE);
 
   Frame *leaf_frame = nullptr;
-  RC rc = find_leaf(latch_memo, op, key, leaf_frame);
+  RC rc = find_leaf(mtr.latch_memo(), op, key, leaf_frame);
   if (rc == RC::EMPTY) {
     rc = RC::RECORD_NOT_EXIST;
     return rc;
@@ -1645,7 +1896,13 @@ RC BplusTreeHandler::delete_entry(const char *user_key, const RID *rid)
     return rc;
   }
 
-  return delete_entry_internal(latch_memo, leaf_frame, key);
+  rc = delete_entry_internal(mtr, leaf_frame, key);
+  RC rc2 = mtr.commit();
+  if (OB_SUCC(rc) && OB_FAIL(rc2)) {
+    LOG_WARN("failed to commit bplus tree log. rc=%s", strrc(rc2));
+    rc = rc2;
+  }
+  return rc;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
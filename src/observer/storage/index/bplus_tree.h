@@ -25,6 +25,7 @@ See the Mulan PSL v2 for more details. */
 #include "storage/record/record_manager.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/trx/latch_memo.h"
+#include "storage/index/bplus_tree_log.h"
 #include "sql/parser/parse_defs.h"
 #include "common/lang/comparator.h"
 #include "common/log/log.h"
@@ -310,7 +311,10 @@ struct InternalIndexNode : public IndexNode
 class IndexNodeHandler 
 {
 public:
-  IndexNodeHandler(const IndexFileHeader &header, Frame *frame);
+  /**
+   * @param mtr 如果不是空，对节点的修改都会记录到mtr的日志中
+   */
+  IndexNodeHandler(const IndexFileHeader &header, Frame *frame, BplusTreeMiniTransaction *mtr = nullptr);
   virtual ~IndexNodeHandler() = default;
 
   void init_empty(bool leaf);
@@ -334,8 +338,16 @@ public:
 
   friend std::string to_string(const IndexNodeHandler &handler);
 
+protected:
+  /**
+   * @brief 当前修改需要记录日志时返回日志收集器，否则返回空
+   */
+  BplusTreeLogger *logger() const;
+
 protected:
   const IndexFileHeader &header_;
+  Frame *frame_ = nullptr;
+  BplusTreeMiniTransaction *mtr_ = nullptr;
   PageNum page_num_;
   IndexNode *node_;
 };
@@ -347,7 +359,7 @@ protected:
 class LeafIndexNodeHandler : public IndexNodeHandler 
 {
 public:
-  LeafIndexNodeHandler(const IndexFileHeader &header, Frame *frame);
+  LeafIndexNodeHandler(const IndexFileHeader &header, Frame *frame, BplusTreeMiniTransaction *mtr = nullptr);
   virtual ~LeafIndexNodeHandler() = default;
 
   void init_empty();
@@ -366,6 +378,17 @@ public:
   void insert(int index, const char *key, const char *value);
   void remove(int index);
   int  remove(const char *key, const KeyComparator &comparator);
+
+  /**
+   * @brief 在index位置插入num个键值对
+   * @details 叶子节点上所有增加数据的操作都通过这个函数完成，重做日志时也是调用这个函数
+   */
+  void insert_items(int index, const char *items, int num);
+  /**
+   * @brief 从index位置开始删除num个键值对
+   */
+  void remove_items(int index, int num);
+
   RC move_half_to(LeafIndexNodeHandler &other, DiskBufferPool *bp);
   RC move_first_to_end(LeafIndexNodeHandler &other, DiskBufferPool *disk_buffer_pool);
   RC move_last_to_front(LeafIndexNodeHandler &other, DiskBufferPool *bp);
@@ -383,9 +406,6 @@ private:
   char *__key_at(int index) const;
   char *__value_at(int index) const;
 
-  void append(const char *item);
-  void preappend(const char *item);
-
 private:
   LeafIndexNode *leaf_node_;
 };
@@ -397,7 +417,7 @@ private:
 class InternalIndexNodeHandler : public IndexNodeHandler 
 {
 public:
-  InternalIndexNodeHandler(const IndexFileHeader &header, Frame *frame);
+  InternalIndexNodeHandler(const IndexFileHeader &header, Frame *frame, BplusTreeMiniTransaction *mtr = nullptr);
   virtual ~InternalIndexNodeHandler() = default;
 
   void init_empty();
@@ -415,6 +435,13 @@ public:
   void set_key_at(int index, const char *key);
   void remove(int index);
 
+  /**
+   * @brief 在index位置插入num个键值对
+   * @details 与copy_from不同，不会修改子节点的父节点指针
+   */
+  void insert_items(int index, const char *items, int num);
+  void remove_items(int index, int num);
+
   /**
    * 与Leaf节点不同，lookup返回指定key应该属于哪个子节点，返回这个子节点在当前节点中的索引
    * 如果想要返回插入位置，就提供 `insert_position` 参数
@@ -442,6 +469,12 @@ private:
   RC append(const char *item, DiskBufferPool *bp);
   RC preappend(const char *item, DiskBufferPool *bp);
 
+  /**
+   * @brief 修改子节点的父节点指针
+   * @details 在mini transaction中时，子节点页面由latch memo持有，直到日志提交
+   */
+  RC set_child_parent(PageNum child_page_num, DiskBufferPool *bp);
+
 private:
   char *__item_at(int index) const;
   char *__key_at(int index) const;
@@ -516,6 +549,22 @@ public:
    */
   bool validate_tree();
 
+  /**
+   * @brief 设置日志管理器，设置之后对B+树的修改都会记录日志
+   * @param table_id 索引所属的表
+   * @param index_id 索引在表中的编号，重做日志时使用
+   */
+  void set_log_manager(CLogManager *log_manager, int32_t table_id, int32_t index_id);
+
+  /**
+   * @brief 重做一条B+树日志
+   * @details 只有页面的LSN小于日志的LSN时，才会在这个页面上重放日志
+   * @param lsn  日志的LSN
+   * @param data 日志项，不包含 BplusTreeLogHeader
+   * @param len  日志项的长度
+   */
+  RC redo(LSN lsn, const char *data, int len);
+
 public:
   /**
    * 这些函数都是线程不安全的，不要在多线程的环境下调用
@@ -542,28 +591,33 @@ protected:
   RC crabing_protocal_fetch_page(LatchMemo &latch_memo, BplusTreeOperationType op, PageNum page_num, bool is_root_page,
                                  Frame *&frame);
 
-  RC insert_into_parent(LatchMemo &latch_memo, PageNum parent_page, Frame *left_frame, const char *pkey, 
-                        Frame &right_frame);
-
-  RC delete_entry_internal(LatchMemo &latch_memo, Frame *leaf_frame, const char *key);
+  RC delete_entry_internal(BplusTreeMiniTransaction &mtr, Frame *leaf_frame, const char *key);
 
   template <typename IndexNodeHandlerType>
-  RC split(LatchMemo &latch_memo, Frame *frame, Frame *&new_frame);
+  RC split(BplusTreeMiniTransaction &mtr, Frame *frame, Frame *&new_frame);
   template <typename IndexNodeHandlerType>
-  RC coalesce_or_redistribute(LatchMemo &latch_memo, Frame *frame);
+  RC coalesce_or_redistribute(BplusTreeMiniTransaction &mtr, Frame *frame);
   template <typename IndexNodeHandlerType>
-  RC coalesce(LatchMemo &latch_memo, Frame *neighbor_frame, Frame *frame, Frame *parent_frame, int index);
+  RC coalesce(BplusTreeMiniTransaction &mtr, Frame *neighbor_frame, Frame *frame, Frame *parent_frame, int index);
   template <typename IndexNodeHandlerType>
-  RC redistribute(Frame *neighbor_frame, Frame *frame, Frame *parent_frame, int index);
+  RC redistribute(BplusTreeMiniTransaction &mtr, Frame *neighbor_frame, Frame *frame, Frame *parent_frame, int index);
 
-  RC insert_entry_into_parent(LatchMemo &latch_memo, Frame *frame, Frame *new_frame, const char *key);
-  RC insert_entry_into_leaf_node(LatchMemo &latch_memo, Frame *frame, const char *pkey, const RID *rid);
-  RC create_new_tree(const char *key, const RID *rid);
+  RC insert_entry_into_parent(BplusTreeMiniTransaction &mtr, Frame *frame, Frame *new_frame, const char *key);
+  RC insert_entry_into_leaf_node(BplusTreeMiniTransaction &mtr, Frame *frame, const char *pkey, const RID *rid);
+  RC create_new_tree(BplusTreeMiniTransaction &mtr, const char *key, const RID *rid);
+
+  /**
+   * @brief 修改根节点，同时修改索引文件的第一个页面
+   * @details 调用者需要持有root_lock_
+   */
+  RC update_root_page_num_locked(BplusTreeMiniTransaction &mtr, PageNum root_page_num);
 
-  void update_root_page_num(PageNum root_page_num);
-  void update_root_page_num_locked(PageNum root_page_num);
+  RC adjust_root(BplusTreeMiniTransaction &mtr, Frame *root_frame);
 
-  RC adjust_root(LatchMemo &latch_memo, Frame *root_frame);
+  /**
+   * @brief 在页面上重放一个日志项
+   */
+  RC redo_entry(const BplusTreeLogEntryHeader &entry, const char *entry_data, Frame *frame);
 
 private:
   common::MemPoolItem::unique_ptr make_key(const char *user_key, const RID &rid);
@@ -583,6 +637,10 @@ protected:
 
   std::unique_ptr<common::MemPoolItem> mem_pool_item_;
 
+  CLogManager *log_manager_ = nullptr;  ///< 为空时不记录日志，比如单测
+  int32_t      log_table_id_ = -1;
+  int32_t      log_index_id_ = -1;
+
 private:
   friend class BplusTreeScanner;
   friend class BplusTreeTester;
@@ -115,10 +115,14 @@ RC BplusTreeIndex::find(IndexScanner *scanner , const char* key)
   }
   RC rc;
   RID rid;
-  Record record;
   while((rc=scanner->next_entry(&rid))!=RC::RECORD_EOF){
-    table_->get_record(rid,record);
-    if(common::compare_string((void *)(record.data() + field_meta_.offset()) ,field_meta_.len(), (void *)key,field_meta_.len())==0){
+    // 只需要比较一下字段，直接访问页面上的记录，不用复制
+    bool found = false;
+    table_->visit_record(rid, true /*readonly*/, [this, key, &found](Record &record) {
+      found = common::compare_string((void *)(record.data() + field_meta_.offset()), field_meta_.len(),
+                                     (void *)key, field_meta_.len()) == 0;
+    });
+    if (found) {
       return RC::SUCCESS;
     }
   }
@@ -147,6 +151,16 @@ RC BplusTreeIndex::sync()
   return index_handler_.sync();
 }
 
+void BplusTreeIndex::set_log_manager(CLogManager *log_manager, int32_t index_id)
+{
+  index_handler_.set_log_manager(log_manager, table_->table_id(), index_id);
+}
+
+RC BplusTreeIndex::redo(LSN lsn, const char *data, int len)
+{
+  return index_handler_.redo(lsn, data, len);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 BplusTreeIndexScanner::BplusTreeIndexScanner(BplusTreeHandler &tree_handler) : tree_scanner_(tree_handler)
 {}
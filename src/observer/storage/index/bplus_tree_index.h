@@ -47,6 +47,9 @@ public:
 
   RC sync() override;
 
+  void set_log_manager(CLogManager *log_manager, int32_t index_id) override;
+  RC   redo(LSN lsn, const char *data, int len) override;
+
 private:
   bool inited_ = false;
   BplusTreeHandler index_handler_;
@@ -0,0 +1,176 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <algorithm>
+#include <sstream>
+
+#include "storage/index/bplus_tree_log.h"
+#include "storage/buffer/frame.h"
+#include "common/log/log.h"
+
+using namespace std;
+
+const char *bplus_tree_log_operation_name(BplusTreeLogOperation operation)
+{
+  switch (operation) {
+    case BplusTreeLogOperation::ALLOCATE_PAGE: return "ALLOCATE_PAGE";
+    case BplusTreeLogOperation::DISPOSE_PAGE: return "DISPOSE_PAGE";
+    case BplusTreeLogOperation::UPDATE_ROOT_PAGE: return "UPDATE_ROOT_PAGE";
+    case BplusTreeLogOperation::INIT_NODE: return "INIT_NODE";
+    case BplusTreeLogOperation::SET_PARENT_PAGE: return "SET_PARENT_PAGE";
+    case BplusTreeLogOperation::SET_NEXT_PAGE: return "SET_NEXT_PAGE";
+    case BplusTreeLogOperation::INSERT_ITEMS: return "INSERT_ITEMS";
+    case BplusTreeLogOperation::REMOVE_ITEMS: return "REMOVE_ITEMS";
+    case BplusTreeLogOperation::UPDATE_KEY: return "UPDATE_KEY";
+    default: return "unknown";
+  }
+}
+
+string BplusTreeLogEntryHeader::to_string() const
+{
+  stringstream ss;
+  ss << "operation:" << bplus_tree_log_operation_name(static_cast<BplusTreeLogOperation>(operation_))
+     << ",page_num:" << page_num_
+     << ",position:" << position_
+     << ",count:" << count_
+     << ",value:" << value_
+     << ",data_len:" << data_len_;
+  return ss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void BplusTreeLogger::allocate_page(PageNum page_num)
+{
+  append(BplusTreeLogOperation::ALLOCATE_PAGE, nullptr, page_num, 0, 0, 0, nullptr, 0);
+}
+
+void BplusTreeLogger::dispose_page(PageNum page_num)
+{
+  append(BplusTreeLogOperation::DISPOSE_PAGE, nullptr, page_num, 0, 0, 0, nullptr, 0);
+}
+
+void BplusTreeLogger::update_root_page(Frame *header_frame, PageNum root_page_num)
+{
+  append(BplusTreeLogOperation::UPDATE_ROOT_PAGE, header_frame, header_frame->page_num(), 0, 0, root_page_num,
+      nullptr, 0);
+}
+
+void BplusTreeLogger::init_node(Frame *frame, bool is_leaf)
+{
+  append(BplusTreeLogOperation::INIT_NODE, frame, frame->page_num(), 0, 0, is_leaf ? 1 : 0, nullptr, 0);
+}
+
+void BplusTreeLogger::set_parent_page(Frame *frame, PageNum parent_page_num)
+{
+  append(BplusTreeLogOperation::SET_PARENT_PAGE, frame, frame->page_num(), 0, 0, parent_page_num, nullptr, 0);
+}
+
+void BplusTreeLogger::set_next_page(Frame *frame, PageNum next_page_num)
+{
+  append(BplusTreeLogOperation::SET_NEXT_PAGE, frame, frame->page_num(), 0, 0, next_page_num, nullptr, 0);
+}
+
+void BplusTreeLogger::insert_items(Frame *frame, int position, const char *items, int count, int item_size)
+{
+  append(BplusTreeLogOperation::INSERT_ITEMS, frame, frame->page_num(), position, count, item_size, items,
+      count * item_size);
+}
+
+void BplusTreeLogger::remove_items(Frame *frame, int position, int count)
+{
+  append(BplusTreeLogOperation::REMOVE_ITEMS, frame, frame->page_num(), position, count, 0, nullptr, 0);
+}
+
+void BplusTreeLogger::update_key(Frame *frame, int position, const char *key, int key_size)
+{
+  append(BplusTreeLogOperation::UPDATE_KEY, frame, frame->page_num(), position, 1, 0, key, key_size);
+}
+
+void BplusTreeLogger::append(BplusTreeLogOperation operation, Frame *frame, PageNum page_num, int position, int count,
+    int value, const char *data, int data_len)
+{
+  if (!enabled_) {
+    return;
+  }
+
+  BplusTreeLogEntryHeader entry_header;
+  entry_header.operation_ = static_cast<int32_t>(operation);
+  entry_header.page_num_  = page_num;
+  entry_header.position_  = position;
+  entry_header.count_     = count;
+  entry_header.value_     = value;
+  entry_header.data_len_  = data_len;
+
+  const size_t offset = buffer_.size();
+  buffer_.resize(offset + sizeof(entry_header) + data_len);
+  memcpy(buffer_.data() + offset, &entry_header, sizeof(entry_header));
+  if (data_len > 0) {
+    memcpy(buffer_.data() + offset + sizeof(entry_header), data, data_len);
+  }
+  entry_count_++;
+
+  if (frame != nullptr && find(frames_.begin(), frames_.end(), frame) == frames_.end()) {
+    frames_.push_back(frame);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BplusTreeMiniTransaction::BplusTreeMiniTransaction(DiskBufferPool *buffer_pool, CLogManager *log_manager,
+    int32_t table_id, int32_t index_id, CLogType log_type)
+    : log_manager_(log_manager),
+      table_id_(table_id),
+      index_id_(index_id),
+      log_type_(log_type),
+      latch_memo_(buffer_pool),
+      logger_(log_manager != nullptr)
+{}
+
+RC BplusTreeMiniTransaction::commit()
+{
+  if (!logger_.enabled() || logger_.empty()) {
+    return RC::SUCCESS;
+  }
+
+  const vector<char> &entries = logger_.buffer();
+  BplusTreeLogHeader log_header;
+  log_header.index_id_ = index_id_;
+
+  const int data_len = static_cast<int>(sizeof(log_header) + entries.size());
+  vector<char> data(data_len);
+  memcpy(data.data(), &log_header, sizeof(log_header));
+  memcpy(data.data() + sizeof(log_header), entries.data(), entries.size());
+
+  // 索引日志与事务无关，trx id 记录为 -1
+  CLogRecord *log_record = CLogRecord::build_data_record(log_type_, -1 /*trx_id*/, table_id_, RID(), data_len,
+      0 /*data_offset*/, data.data());
+  if (nullptr == log_record) {
+    LOG_WARN("failed to create bplus tree log record");
+    return RC::NOMEM;
+  }
+
+  LSN lsn = 0;
+  RC rc = log_manager_->append_log(log_record, lsn);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to append bplus tree log. table id=%d, index id=%d, rc=%s", table_id_, index_id_, strrc(rc));
+    return rc;
+  }
+
+  // 子节点的父节点指针修改时没有加页面锁，可能与其它的修改并发，所以LSN只能变大
+  for (Frame *frame : logger_.frames()) {
+    if (frame->lsn() < lsn) {
+      frame->set_lsn(lsn);
+    }
+    frame->mark_dirty();
+  }
+  return rc;
+}
@@ -0,0 +1,157 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "common/rc.h"
+#include "common/types.h"
+#include "storage/clog/clog.h"
+#include "storage/trx/latch_memo.h"
+
+class Frame;
+class DiskBufferPool;
+
+/**
+ * @brief B+树的日志
+ * @defgroup BplusTreeLog
+ * @details B+树的修改使用物理逻辑日志(physiological log)记录：每条日志项定位到具体的页面，
+ * 页面内部的修改则使用逻辑的方式描述，比如在某个位置插入几个键值对。
+ * 一次完整的B+树修改(比如插入一个键值，可能会引起分裂)称为一个mini transaction，
+ * 它修改的所有页面的日志项会打包成一条CLog日志，并在页面的锁释放之前写入日志缓存。
+ * 重做时，只有页面上记录的LSN小于日志的LSN时，才会在页面上重放这条日志。
+ * 索引日志与事务无关，不会回滚。
+ */
+
+/**
+ * @brief B+树日志项的操作类型
+ * @ingroup BplusTreeLog
+ */
+enum class BplusTreeLogOperation : int32_t
+{
+  ALLOCATE_PAGE,    ///< 分配页面。修改的是buffer pool的页面分配位图，重复执行没有影响
+  DISPOSE_PAGE,     ///< 释放页面
+  UPDATE_ROOT_PAGE, ///< 修改根节点页面，value是新的根节点页面
+  INIT_NODE,        ///< 初始化一个空节点，value表示是否叶子节点
+  SET_PARENT_PAGE,  ///< 设置父节点页面，value是父节点页面
+  SET_NEXT_PAGE,    ///< 设置叶子节点的下一个页面，value是下一个页面
+  INSERT_ITEMS,     ///< 在position位置插入count个键值对，数据就是键值对
+  REMOVE_ITEMS,     ///< 从position位置开始删除count个键值对
+  UPDATE_KEY,       ///< 修改position位置的键值，数据就是新的键值
+};
+
+const char *bplus_tree_log_operation_name(BplusTreeLogOperation operation);
+
+/**
+ * @brief B+树日志的头部
+ * @ingroup BplusTreeLog
+ * @details 放在CLogRecordData的数据部分的最前面，后面跟着多个日志项
+ */
+struct BplusTreeLogHeader
+{
+  int32_t index_id_ = -1; ///< 索引在表中的编号
+};
+
+/**
+ * @brief B+树日志项的头部
+ * @ingroup BplusTreeLog
+ * @details 日志项的数据紧跟在头部后面，长度是data_len_
+ */
+struct BplusTreeLogEntryHeader
+{
+  int32_t operation_ = 0;   ///< 操作类型，参考 BplusTreeLogOperation
+  PageNum page_num_  = -1;  ///< 修改的页面
+  int32_t position_  = 0;   ///< 修改的键值对位置
+  int32_t count_     = 0;   ///< 修改的键值对个数
+  int32_t value_     = 0;   ///< 页面编号或标识
+  int32_t data_len_  = 0;   ///< 日志项数据的长度
+
+  std::string to_string() const;
+};
+
+/**
+ * @brief 收集一次B+树修改的日志项
+ * @ingroup BplusTreeLog
+ * @details 在修改页面之后调用对应的接口记录日志项，同时会记住修改过的页面，提交时需要更新这些页面的LSN
+ */
+class BplusTreeLogger
+{
+public:
+  BplusTreeLogger(bool enabled) : enabled_(enabled)
+  {}
+  ~BplusTreeLogger() = default;
+
+  bool enabled() const { return enabled_; }
+  bool empty() const { return entry_count_ == 0; }
+
+  void allocate_page(PageNum page_num);
+  void dispose_page(PageNum page_num);
+  void update_root_page(Frame *header_frame, PageNum root_page_num);
+  void init_node(Frame *frame, bool is_leaf);
+  void set_parent_page(Frame *frame, PageNum parent_page_num);
+  void set_next_page(Frame *frame, PageNum next_page_num);
+  void insert_items(Frame *frame, int position, const char *items, int count, int item_size);
+  void remove_items(Frame *frame, int position, int count);
+  void update_key(Frame *frame, int position, const char *key, int key_size);
+
+  const std::vector<char>   &buffer() const { return buffer_; }
+  const std::vector<Frame *> &frames() const { return frames_; }
+
+private:
+  void append(BplusTreeLogOperation operation, Frame *frame, PageNum page_num, int position, int count, int value,
+      const char *data, int data_len);
+
+private:
+  bool                 enabled_     = false;
+  int                  entry_count_ = 0;
+  std::vector<char>    buffer_;  ///< 日志项的数据，每个日志项都是 BplusTreeLogEntryHeader + 数据
+  std::vector<Frame *> frames_;  ///< 修改过的页面
+};
+
+/**
+ * @brief B+树的一次修改操作
+ * @ingroup BplusTreeLog
+ * @details 管理修改过程中访问的页面(latch memo)和日志。
+ * 需要在 latch memo 释放页面之前提交，这样页面在写入日志并更新LSN之前不会被其它线程修改或刷盘。
+ */
+class BplusTreeMiniTransaction
+{
+public:
+  /**
+   * @param log_manager 日志管理器，如果是空，就不记录日志
+   * @param table_id    索引所属的表
+   * @param index_id    索引在表中的编号
+   * @param log_type    日志类型，在分裂或合并时可以调整
+   */
+  BplusTreeMiniTransaction(DiskBufferPool *buffer_pool, CLogManager *log_manager, int32_t table_id, int32_t index_id,
+      CLogType log_type);
+  ~BplusTreeMiniTransaction() = default;
+
+  LatchMemo       &latch_memo() { return latch_memo_; }
+  BplusTreeLogger &logger() { return logger_; }
+
+  void set_log_type(CLogType log_type) { log_type_ = log_type; }
+
+  /**
+   * @brief 将日志写入日志缓存并更新修改过的页面的LSN
+   * @details 即使修改过程中出现了错误，已经发生的页面修改也要提交
+   */
+  RC commit();
+
+private:
+  CLogManager    *log_manager_ = nullptr;
+  int32_t         table_id_    = -1;
+  int32_t         index_id_    = -1;
+  CLogType        log_type_;
+  LatchMemo       latch_memo_;
+  BplusTreeLogger logger_;
+};
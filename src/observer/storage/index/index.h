@@ -15,14 +15,17 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include <stddef.h>
+#include <string.h>
 #include <vector>
 
 #include "common/rc.h"
+#include "common/types.h"
 #include "storage/index/index_meta.h"
 #include "storage/field/field_meta.h"
 #include "storage/record/record_manager.h"
 
 class IndexScanner;
+class CLogManager;
 
 /**
  * @brief 索引
@@ -61,6 +64,14 @@ public:
    */
   virtual RC delete_entry(const char *record, const RID *rid) = 0;
 
+  /**
+   * @brief 更新记录时索引的键是否发生了变化，没有变化时不需要修改索引
+   */
+  bool key_changed(const char *old_record, const char *new_record) const
+  {
+    return 0 != memcmp(old_record + field_meta_.offset(), new_record + field_meta_.offset(), field_meta_.len());
+  }
+
   /**
    * @brief 创建一个索引数据的扫描器
    * 
@@ -80,6 +91,22 @@ public:
    */
   virtual RC sync() = 0;
 
+  /**
+   * @brief 设置日志管理器，设置之后索引的修改会记录到日志中
+   * @param index_id 索引在表中的编号，重做日志时根据编号找到索引
+   */
+  virtual void set_log_manager(CLogManager *log_manager, int32_t index_id)
+  {}
+
+  /**
+   * @brief 重做索引日志
+   * @details 不记录日志的索引也不需要重做
+   */
+  virtual RC redo(LSN lsn, const char *data, int len)
+  {
+    return RC::UNIMPLENMENT;
+  }
+
 protected:
   RC init(const IndexMeta &index_meta, const FieldMeta &field_meta);
 
@@ -0,0 +1,123 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "storage/record/free_space_map.h"
+
+using namespace std;
+using namespace common;
+
+void FreeSpaceMap::init(DiskBufferPool &buffer_pool)
+{
+  clear();
+
+  lock_guard<Mutex> guard(unchecked_lock_);
+  unchecked_pages_.init(buffer_pool);
+  all_checked_.store(!unchecked_pages_.has_next());
+}
+
+void FreeSpaceMap::clear()
+{
+  for (Shard &shard : shards_) {
+    lock_guard<Mutex> guard(shard.lock);
+    shard.free_pages.clear();
+    shard.claimed_pages.clear();
+  }
+  all_checked_.store(true);
+}
+
+int FreeSpaceMap::home_shard()
+{
+  static thread_local const int shard = static_cast<int>(hash<thread::id>()(this_thread::get_id()) % SHARD_NUM);
+  return shard;
+}
+
+PageNum FreeSpaceMap::claim()
+{
+  const int home = home_shard();
+  for (int i = 0; i < SHARD_NUM; i++) {
+    Shard &shard = shards_[(home + i) % SHARD_NUM];
+    lock_guard<Mutex> guard(shard.lock);
+    if (shard.free_pages.empty()) {
+      continue;
+    }
+
+    auto          iter     = shard.free_pages.begin();
+    const PageNum page_num = *iter;
+    shard.free_pages.erase(iter);
+    shard.claimed_pages.emplace(page_num, false);
+    return page_num;
+  }
+
+  return claim_unchecked();
+}
+
+PageNum FreeSpaceMap::claim_unchecked()
+{
+  if (all_checked_.load()) {
+    return BP_INVALID_PAGE_NUM;
+  }
+
+  lock_guard<Mutex> unchecked_guard(unchecked_lock_);
+  while (unchecked_pages_.has_next()) {
+    const PageNum page_num = unchecked_pages_.next();
+
+    // 删除记录时可能已经把这个页面登记过了
+    Shard &shard = shard_of(page_num);
+    lock_guard<Mutex> guard(shard.lock);
+    if (shard.free_pages.count(page_num) == 0 && shard.claimed_pages.count(page_num) == 0) {
+      shard.claimed_pages.emplace(page_num, false);
+      return page_num;
+    }
+  }
+
+  all_checked_.store(true);
+  return BP_INVALID_PAGE_NUM;
+}
+
+void FreeSpaceMap::release(PageNum page_num, bool has_free_space)
+{
+  Shard &shard = shard_of(page_num);
+  lock_guard<Mutex> guard(shard.lock);
+  auto iter = shard.claimed_pages.find(page_num);
+  if (iter != shard.claimed_pages.end()) {
+    has_free_space = has_free_space || iter->second;
+    shard.claimed_pages.erase(iter);
+  }
+
+  if (has_free_space) {
+    shard.free_pages.insert(page_num);
+  }
+}
+
+void FreeSpaceMap::add_free(PageNum page_num)
+{
+  Shard &shard = shard_of(page_num);
+  lock_guard<Mutex> guard(shard.lock);
+  auto iter = shard.claimed_pages.find(page_num);
+  if (iter != shard.claimed_pages.end()) {
+    iter->second = true;
+  } else {
+    shard.free_pages.insert(page_num);
+  }
+}
+
+int FreeSpaceMap::free_page_num()
+{
+  int num = 0;
+  for (Shard &shard : shards_) {
+    lock_guard<Mutex> guard(shard.lock);
+    num += static_cast<int>(shard.free_pages.size());
+  }
+  return num;
+}
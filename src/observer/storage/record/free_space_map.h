@@ -0,0 +1,92 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <atomic>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "common/types.h"
+#include "common/lang/mutex.h"
+#include "storage/buffer/disk_buffer_pool.h"
+
+/**
+ * @brief 记录文件的空闲空间表
+ * @ingroup RecordManager
+ * @details 记录哪些页面还有空闲空间，插入记录时从这里领取目标页面。
+ * 页面按照页号分到多个分片中，每个分片有自己的锁，锁内只操作内存中的集合，不访问页面。
+ * 插入的线程从自己对应的分片开始查找，领取之后页面就不会再分给其它线程，直到归还，
+ * 所以并发插入的线程会写不同的页面，不会在同一个页面锁上排队。
+ * 空闲空间表不持久化，打开文件时也不遍历所有页面，已经存在的页面在没有其它空闲页面时才逐个检查。
+ */
+class FreeSpaceMap
+{
+public:
+  static constexpr int SHARD_NUM = 16;
+
+public:
+  FreeSpaceMap() = default;
+  ~FreeSpaceMap() = default;
+
+  /**
+   * @brief 初始化。文件中现在已有的页面都作为没有检查过的页面，需要时再检查
+   */
+  void init(DiskBufferPool &buffer_pool);
+  void clear();
+
+  /**
+   * @brief 领取一个有空闲空间的页面
+   * @details 没有已知的空闲页面时，领取一个还没有检查过的页面
+   * @return BP_INVALID_PAGE_NUM 没有可以领取的页面，需要分配新页面
+   */
+  PageNum claim();
+
+  /**
+   * @brief 归还领取的页面，或者登记一个新分配的页面
+   * @param has_free_space 页面是否还有空闲空间，没有时不再分配给插入的线程
+   */
+  void release(PageNum page_num, bool has_free_space);
+
+  /**
+   * @brief 页面上删除了记录或者记录变短了，有了新的空闲空间
+   * @details 页面正在被其它线程领取时，等它归还时再放回空闲页面中
+   */
+  void add_free(PageNum page_num);
+
+  /**
+   * @brief 当前已知的空闲页面个数，不包括被领取的页面和没有检查过的页面
+   */
+  int free_page_num();
+
+private:
+  struct Shard
+  {
+    common::Mutex                     lock;
+    std::unordered_set<PageNum>       free_pages;
+    std::unordered_map<PageNum, bool> claimed_pages;  ///< 领取的页面，以及领取期间是否又有了新的空闲空间
+  };
+
+  Shard &shard_of(PageNum page_num) { return shards_[page_num % SHARD_NUM]; }
+
+  /**
+   * @brief 当前线程开始查找的分片，不同的线程尽量从不同的分片开始
+   */
+  static int home_shard();
+
+  PageNum claim_unchecked();
+
+private:
+  Shard shards_[SHARD_NUM];
+
+  common::Mutex      unchecked_lock_;
+  BufferPoolIterator unchecked_pages_;  ///< 初始化时已经存在，还没有检查过的页面
+  std::atomic<bool>  all_checked_{true};
+};
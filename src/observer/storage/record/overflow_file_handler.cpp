@@ -0,0 +1,137 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <algorithm>
+
+#include "storage/record/overflow_file_handler.h"
+#include "common/log/log.h"
+
+OverflowFileHandler::~OverflowFileHandler() { close(); }
+
+RC OverflowFileHandler::init(DiskBufferPool *buffer_pool)
+{
+  if (disk_buffer_pool_ != nullptr) {
+    LOG_ERROR("overflow file handler has been openned.");
+    return RC::RECORD_OPENNED;
+  }
+
+  disk_buffer_pool_ = buffer_pool;
+  return RC::SUCCESS;
+}
+
+void OverflowFileHandler::close() { disk_buffer_pool_ = nullptr; }
+
+RC OverflowFileHandler::insert(const char *data, int len, PageNum &first_page)
+{
+  RC rc = RC::SUCCESS;
+
+  // 从最后一段数据开始写，这样写每个页面时都已经知道下一个页面的页号
+  PageNum next_page = BP_INVALID_PAGE_NUM;
+  const int page_num = (len + PAGE_DATA_CAPACITY - 1) / PAGE_DATA_CAPACITY;
+  for (int i = page_num - 1; i >= 0; i--) {
+    Frame *frame = nullptr;
+    rc = disk_buffer_pool_->allocate_page(&frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to allocate overflow page. rc=%s", strrc(rc));
+      break;
+    }
+
+    const int offset   = i * PAGE_DATA_CAPACITY;
+    const int data_len = std::min(len - offset, PAGE_DATA_CAPACITY);
+
+    frame->write_latch();
+    OverflowPageHeader *header = reinterpret_cast<OverflowPageHeader *>(frame->data());
+    header->next_page          = next_page;
+    header->data_len           = data_len;
+    memcpy(frame->data() + sizeof(OverflowPageHeader), data + offset, data_len);
+    frame->mark_dirty();
+    frame->write_unlatch();
+
+    next_page = frame->page_num();
+    rc = disk_buffer_pool_->flush_page(*frame);
+    disk_buffer_pool_->unpin_page(frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to flush overflow page. page num=%d, rc=%s", next_page, strrc(rc));
+      break;
+    }
+  }
+
+  if (OB_SUCC(rc)) {
+    rc = disk_buffer_pool_->flush_header();
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to flush overflow pages. rc=%s", strrc(rc));
+    remove(next_page);
+    return rc;
+  }
+
+  first_page = next_page;
+  return RC::SUCCESS;
+}
+
+RC OverflowFileHandler::read(PageNum first_page, int len, std::string &data)
+{
+  data.clear();
+  data.reserve(len);
+
+  PageNum page_num = first_page;
+  while (page_num != BP_INVALID_PAGE_NUM && static_cast<int>(data.size()) < len) {
+    Frame *frame = nullptr;
+    RC     rc    = disk_buffer_pool_->get_this_page(page_num, &frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get overflow page. page num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+
+    frame->read_latch();
+    const OverflowPageHeader *header = reinterpret_cast<const OverflowPageHeader *>(frame->data());
+    data.append(frame->data() + sizeof(OverflowPageHeader), header->data_len);
+    page_num = header->next_page;
+    frame->read_unlatch();
+    disk_buffer_pool_->unpin_page(frame);
+  }
+
+  if (static_cast<int>(data.size()) != len) {
+    LOG_WARN("overflow data is corrupted. first page=%d, expect len=%d, actual len=%d",
+             first_page, len, static_cast<int>(data.size()));
+    return RC::INTERNAL;
+  }
+  return RC::SUCCESS;
+}
+
+RC OverflowFileHandler::remove(PageNum first_page)
+{
+  if (first_page == BP_INVALID_PAGE_NUM) {
+    return RC::SUCCESS;
+  }
+
+  PageNum page_num = first_page;
+  while (page_num != BP_INVALID_PAGE_NUM) {
+    Frame *frame = nullptr;
+    RC     rc    = disk_buffer_pool_->get_this_page(page_num, &frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get overflow page. page num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+
+    const PageNum next_page = reinterpret_cast<const OverflowPageHeader *>(frame->data())->next_page;
+    // 释放页面时页面不能被 pin 住，没有其它人会访问已经没有引用的溢出页
+    disk_buffer_pool_->unpin_page(frame);
+    rc = disk_buffer_pool_->dispose_page(page_num);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to dispose overflow page. page num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+    page_num = next_page;
+  }
+
+  return disk_buffer_pool_->flush_header();
+}
@@ -0,0 +1,67 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <string>
+
+#include "common/rc.h"
+#include "storage/buffer/disk_buffer_pool.h"
+
+/**
+ * @brief 溢出页的页头
+ * @ingroup RecordManager
+ * @details 一个长数据按照顺序切分到多个溢出页中，每个页面记录下一个页面的页号，组成一个链表
+ */
+struct OverflowPageHeader
+{
+  PageNum next_page;  ///< 下一个溢出页，BP_INVALID_PAGE_NUM 表示最后一页
+  int32_t data_len;   ///< 当前页面中数据的长度
+};
+
+/**
+ * @brief 管理存放长数据(TEXT)的溢出页
+ * @ingroup RecordManager
+ * @details 溢出页放在表的一个单独的文件中，不会影响记录文件的扫描。每个长数据占用一串溢出页，
+ * 记录中只保存第一个页面的页号和数据的长度，访问这个字段时再读取溢出页。
+ * 长数据写入后不会再修改，修改字段时写入一个新的链表，旧的链表在没有版本引用它之后删除。
+ * 溢出页的修改不记录日志，写入和删除后会立即刷盘，记录日志中引用的溢出页在重启后一定存在。
+ */
+class OverflowFileHandler
+{
+public:
+  static constexpr int PAGE_DATA_CAPACITY = BP_PAGE_DATA_SIZE - static_cast<int>(sizeof(OverflowPageHeader));
+
+public:
+  OverflowFileHandler() = default;
+  ~OverflowFileHandler();
+
+  RC   init(DiskBufferPool *buffer_pool);
+  void close();
+
+  /**
+   * @brief 把数据写入一串新的溢出页
+   * @param first_page 返回第一个页面的页号。长度为0时不会分配页面，返回 BP_INVALID_PAGE_NUM
+   */
+  RC insert(const char *data, int len, PageNum &first_page);
+
+  /**
+   * @brief 读取一串溢出页中的数据
+   */
+  RC read(PageNum first_page, int len, std::string &data);
+
+  /**
+   * @brief 释放一串溢出页
+   */
+  RC remove(PageNum first_page);
+
+private:
+  DiskBufferPool *disk_buffer_pool_ = nullptr;
+};
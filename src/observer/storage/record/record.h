@@ -126,8 +126,33 @@ public:
     return *this;
   }
 
+  /**
+   * @brief 移动时不复制数据，自己管理的内存交给新的 record
+   */
+  Record(Record &&other) noexcept : rid_(other.rid_), data_(other.data_), len_(other.len_), owner_(other.owner_)
+  {
+    other.data_  = nullptr;
+    other.len_   = 0;
+    other.owner_ = false;
+  }
+
+  Record &operator=(Record &&other) noexcept
+  {
+    if (this == &other) {
+      return *this;
+    }
+
+    this->~Record();
+    new (this) Record(std::move(other));
+    return *this;
+  }
+
   void set_data(char *data, int len = 0)
   {
+    if (owner_) {
+      this->~Record();
+      this->owner_ = false;
+    }
     this->data_ = data;
     this->len_  = len;
   }
@@ -11,6 +11,9 @@ See the Mulan PSL v2 for more details. */
 //
 // Created by Meiyi & Longda on 2021/4/13.
 //
+#include <algorithm>
+#include <limits>
+
 #include "storage/record/record_manager.h"
 #include "common/log/log.h"
 #include "common/lang/bitmap.h"
@@ -19,7 +22,13 @@ See the Mulan PSL v2 for more details. */
 
 using namespace common;
 
-static constexpr int PAGE_HEADER_SIZE = (sizeof(PageHeader));
+static constexpr int PAGE_HEADER_SIZE         = (sizeof(PageHeader));
+static constexpr int SLOTTED_PAGE_HEADER_SIZE = (sizeof(PageHeader) + sizeof(SlottedPageHeader));
+static constexpr int RECORD_SLOT_SIZE         = (sizeof(RecordSlot));
+static constexpr int PAX_PAGE_HEADER_SIZE     = (sizeof(PageHeader) + sizeof(PaxPageHeader));
+static constexpr int PAX_COLUMN_SIZE          = (sizeof(PaxColumn));
+
+static_assert(BP_PAGE_DATA_SIZE <= std::numeric_limits<uint16_t>::max(), "record slot offset overflow");
 
 /**
  * @brief 8字节对齐
@@ -50,6 +59,24 @@ int page_record_capacity(int page_size, int record_size)
  */
 int page_bitmap_size(int record_capacity) { return (record_capacity + 7) / 8; }
 
+/**
+ * @brief 按照指定的记录个数，计算 PAX 页面上每一列 minipage 的位置
+ *
+ * @param record_capacity 想要存放多少记录
+ * @param column_num      列的个数
+ * @param columns         计算出来的位置保存在 minipage_offset 中
+ * @return 最后一个 minipage 结束的位置，不能超过页面大小
+ */
+int pax_page_layout(int record_capacity, int column_num, PaxColumn columns[])
+{
+  int offset = align8(PAX_PAGE_HEADER_SIZE + column_num * PAX_COLUMN_SIZE + page_bitmap_size(record_capacity));
+  for (int i = 0; i < column_num; i++) {
+    columns[i].minipage_offset = offset;
+    offset                     = align8(offset + record_capacity * columns[i].len);
+  }
+  return offset;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 RecordPageIterator::RecordPageIterator() {}
 RecordPageIterator::~RecordPageIterator() {}
@@ -58,8 +85,18 @@ void RecordPageIterator::init(RecordPageHandler &record_page_handler, SlotNum st
 {
   record_page_handler_ = &record_page_handler;
   page_num_            = record_page_handler.get_page_num();
-  bitmap_.init(record_page_handler.bitmap_, record_page_handler.page_header_->record_capacity);
-  next_slot_num_ = bitmap_.next_setted_bit(start_slot_num);
+  if (!record_page_handler.is_slotted()) {
+    bitmap_.init(record_page_handler.bitmap_, record_page_handler.page_header_->record_capacity);
+  }
+  next_slot_num_ = next_used_slot(start_slot_num);
+}
+
+void RecordPageIterator::set_projection(const std::vector<int> &columns)
+{
+  projection_ = columns;
+  // 缓存中不需要的列不会再被覆盖，清理掉之前扫描留下的数据
+  row_buffers_[0].clear();
+  row_buffers_[1].clear();
 }
 
 bool RecordPageIterator::has_next() { return -1 != next_slot_num_; }
@@ -67,12 +104,44 @@ bool RecordPageIterator::has_next() { return -1 != next_slot_num_; }
 RC RecordPageIterator::next(Record &record)
 {
   record.set_rid(page_num_, next_slot_num_);
-  record.set_data(record_page_handler_->get_record_data(record.rid().slot_num));
+  if (next_slot_num_ < 0) {
+    return RC::RECORD_EOF;
+  }
+
+  if (record_page_handler_->is_slotted()) {
+    const RecordSlot &slot = record_page_handler_->slots()[next_slot_num_];
+    record.set_data(record_page_handler_->frame_->data() + slot.offset, slot.len);
+  } else if (record_page_handler_->is_pax()) {
+    std::vector<char> &buffer = row_buffers_[row_buffer_index_];
+    const int len = record_page_handler_->page_header_->record_real_size;
+    if (static_cast<int>(buffer.size()) != len) {
+      buffer.assign(len, 0);
+    }
+    record_page_handler_->pax_gather(next_slot_num_, buffer.data(), projection_);
+    record.set_data(buffer.data(), len);
+  } else {
+    record.set_data(record_page_handler_->get_record_data(next_slot_num_),
+                    record_page_handler_->page_header_->record_real_size);
+  }
+
+  next_slot_num_ = next_used_slot(next_slot_num_ + 1);
+  return RC::SUCCESS;
+}
+
+SlotNum RecordPageIterator::next_used_slot(SlotNum start)
+{
+  if (!record_page_handler_->is_slotted()) {
+    return bitmap_.next_setted_bit(start);
+  }
 
-  if (next_slot_num_ >= 0) {
-    next_slot_num_ = bitmap_.next_setted_bit(next_slot_num_ + 1);
+  const RecordSlot *slots    = record_page_handler_->slots();
+  const int         slot_num = record_page_handler_->slotted_header()->slot_num;
+  for (SlotNum i = start; i < slot_num; i++) {
+    if (slots[i].offset != 0) {
+      return i;
+    }
   }
-  return record.rid().slot_num != -1 ? RC::SUCCESS : RC::RECORD_EOF;
+  return -1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -102,7 +171,7 @@ RC RecordPageHandler::init(DiskBufferPool &buffer_pool, PageNum page_num, bool r
   disk_buffer_pool_ = &buffer_pool;
   readonly_         = readonly;
   page_header_      = (PageHeader *)(data);
-  bitmap_           = data + PAGE_HEADER_SIZE;
+  bitmap_           = page_bitmap();
   
   LOG_TRACE("Successfully init page_num %d.", page_num);
   return ret;
@@ -127,7 +196,7 @@ RC RecordPageHandler::recover_init(DiskBufferPool &buffer_pool, PageNum page_num
   disk_buffer_pool_ = &buffer_pool;
   readonly_         = false;
   page_header_      = (PageHeader *)(data);
-  bitmap_           = data + PAGE_HEADER_SIZE;
+  bitmap_           = page_bitmap();
 
   buffer_pool.recover_page(page_num);
 
@@ -135,14 +204,71 @@ RC RecordPageHandler::recover_init(DiskBufferPool &buffer_pool, PageNum page_num
   return ret;
 }
 
-RC RecordPageHandler::init_empty_page(DiskBufferPool &buffer_pool, PageNum page_num, int record_size)
+RC RecordPageHandler::init_empty_page(DiskBufferPool &buffer_pool, PageNum page_num, int record_size,
+                                      RecordPageFormat format /*=FIXED*/, const std::vector<PaxColumn> &columns /*={}*/)
 {
+  if (format == RecordPageFormat::PAX && columns.empty()) {
+    LOG_ERROR("PAX page requires columns. page_num=%d", page_num);
+    return RC::INVALID_ARGUMENT;
+  }
+
   RC ret = init(buffer_pool, page_num, false /*readonly*/);
   if (ret != RC::SUCCESS) {
     LOG_ERROR("Failed to init empty page page_num:record_size %d:%d.", page_num, record_size);
     return ret;
   }
 
+  if (format == RecordPageFormat::SLOTTED) {
+    page_header_->record_num          = 0;
+    page_header_->record_real_size    = PageHeader::VARIABLE_RECORD_SIZE;
+    page_header_->record_size         = 0;
+    page_header_->record_capacity     = 0;
+    page_header_->first_record_offset = SLOTTED_PAGE_HEADER_SIZE;
+
+    SlottedPageHeader *header = slotted_header();
+    header->slot_num          = 0;
+    header->data_offset       = BP_PAGE_DATA_SIZE;
+    header->free_space        = BP_PAGE_DATA_SIZE - SLOTTED_PAGE_HEADER_SIZE;
+    bitmap_                   = nullptr;
+
+    if ((ret = buffer_pool.flush_page(*frame_)) != RC::SUCCESS) {
+      LOG_ERROR("Failed to flush page header %d:%d.", buffer_pool.file_desc(), page_num);
+      return ret;
+    }
+    return RC::SUCCESS;
+  }
+
+  if (format == RecordPageFormat::PAX) {
+    const int column_num = static_cast<int>(columns.size());
+    page_header_->record_num       = 0;
+    page_header_->record_real_size = record_size;
+    page_header_->record_size      = PageHeader::PAX_RECORD_SIZE;
+    pax_header()->column_num       = column_num;
+
+    PaxColumn *page_columns = pax_columns();
+    memcpy(page_columns, columns.data(), column_num * PAX_COLUMN_SIZE);
+
+    // 先不考虑 minipage 的对齐估算记录个数，再按照实际的布局修正
+    const int fixed_size = PAX_PAGE_HEADER_SIZE + column_num * PAX_COLUMN_SIZE;
+    int capacity = (int)((BP_PAGE_DATA_SIZE - fixed_size - 1) / (record_size + 0.125));
+    while (capacity > 0 && pax_page_layout(capacity, column_num, page_columns) > BP_PAGE_DATA_SIZE) {
+      capacity--;
+    }
+    ASSERT(capacity > 0, "Record overflow the page size. record size=%d, column num=%d", record_size, column_num);
+
+    page_header_->record_capacity     = capacity;
+    page_header_->first_record_offset = page_columns[0].minipage_offset;
+
+    bitmap_ = page_bitmap();
+    memset(bitmap_, 0, page_bitmap_size(capacity));
+
+    if ((ret = buffer_pool.flush_page(*frame_)) != RC::SUCCESS) {
+      LOG_ERROR("Failed to flush page header %d:%d.", buffer_pool.file_desc(), page_num);
+      return ret;
+    }
+    return RC::SUCCESS;
+  }
+
   page_header_->record_num          = 0;
   page_header_->record_real_size    = record_size;
   page_header_->record_size         = align8(record_size);
@@ -178,10 +304,91 @@ RC RecordPageHandler::cleanup()
   return RC::SUCCESS;
 }
 
+void RecordPageHandler::swap(RecordPageHandler &other)
+{
+  std::swap(disk_buffer_pool_, other.disk_buffer_pool_);
+  std::swap(frame_, other.frame_);
+  std::swap(readonly_, other.readonly_);
+  std::swap(page_header_, other.page_header_);
+  std::swap(bitmap_, other.bitmap_);
+  row_buffer_.swap(other.row_buffer_);
+}
+
+int RecordPageHandler::max_record_size(RecordPageFormat format, int column_num /*=1*/)
+{
+  switch (format) {
+    case RecordPageFormat::FIXED: {
+      // 至少要能放下一条记录，记录的大小会按照8字节对齐
+      return (BP_PAGE_DATA_SIZE - align8(PAGE_HEADER_SIZE + page_bitmap_size(1))) / 8 * 8;
+    }
+    case RecordPageFormat::SLOTTED: {
+      return BP_PAGE_DATA_SIZE - SLOTTED_PAGE_HEADER_SIZE - RECORD_SLOT_SIZE - SLOTTED_PAGE_RESERVED_SPACE;
+    }
+    case RecordPageFormat::PAX: {
+      // 至少要能放下一条记录，每一列的 minipage 对齐时最多浪费7个字节
+      return BP_PAGE_DATA_SIZE - align8(PAX_PAGE_HEADER_SIZE + column_num * PAX_COLUMN_SIZE + page_bitmap_size(1)) -
+             7 * column_num;
+    }
+  }
+  return 0;
+}
+
+char *RecordPageHandler::page_bitmap()
+{
+  if (is_pax()) {
+    return reinterpret_cast<char *>(pax_columns() + pax_header()->column_num);
+  }
+  return frame_->data() + PAGE_HEADER_SIZE;
+}
+
+void RecordPageHandler::pax_gather(SlotNum slot_num, char *data, const std::vector<int> &columns)
+{
+  const PaxColumn *page_columns = pax_columns();
+  const char      *page_data    = frame_->data();
+  const int        column_num   = pax_header()->column_num;
+  if (columns.empty()) {
+    for (int i = 0; i < column_num; i++) {
+      const PaxColumn &column = page_columns[i];
+      memcpy(data + column.record_offset, page_data + column.minipage_offset + slot_num * column.len, column.len);
+    }
+    return;
+  }
+
+  for (int i : columns) {
+    ASSERT(i >= 0 && i < column_num, "invalid column. column=%d, column num=%d", i, column_num);
+    const PaxColumn &column = page_columns[i];
+    memcpy(data + column.record_offset, page_data + column.minipage_offset + slot_num * column.len, column.len);
+  }
+}
+
+void RecordPageHandler::pax_scatter(SlotNum slot_num, const char *data)
+{
+  const PaxColumn *page_columns = pax_columns();
+  char            *page_data    = frame_->data();
+  for (int i = 0; i < pax_header()->column_num; i++) {
+    const PaxColumn &column = page_columns[i];
+    memcpy(page_data + column.minipage_offset + slot_num * column.len, data + column.record_offset, column.len);
+  }
+}
+
 RC RecordPageHandler::insert_record(const char *data, RID *rid)
+{
+  return insert_record(data, page_header_->record_real_size, rid);
+}
+
+RC RecordPageHandler::insert_record(const char *data, int len, RID *rid)
 {
   ASSERT(readonly_ == false, "cannot insert record into page while the page is readonly");
 
+  if (is_slotted()) {
+    return slotted_insert_record(data, len, rid);
+  }
+
+  if (len != page_header_->record_real_size) {
+    LOG_WARN("invalid record length. len=%d, record size=%d", len, page_header_->record_real_size);
+    return RC::INVALID_ARGUMENT;
+  }
+
   if (page_header_->record_num == page_header_->record_capacity) {
     LOG_WARN("Page is full, page_num %d:%d.", disk_buffer_pool_->file_desc(), frame_->page_num());
     return RC::RECORD_NOMEM;
@@ -194,8 +401,12 @@ RC RecordPageHandler::insert_record(const char *data, RID *rid)
   page_header_->record_num++;
 
   // assert index < page_header_->record_capacity
-  char *record_data = get_record_data(index);
-  memcpy(record_data, data, page_header_->record_real_size);
+  if (is_pax()) {
+    pax_scatter(index, data);
+  } else {
+    char *record_data = get_record_data(index);
+    memcpy(record_data, data, page_header_->record_real_size);
+  }
 
   frame_->mark_dirty();
 
@@ -208,8 +419,12 @@ RC RecordPageHandler::insert_record(const char *data, RID *rid)
   return RC::SUCCESS;
 }
 
-RC RecordPageHandler::recover_insert_record(const char *data, const RID &rid)
+RC RecordPageHandler::recover_insert_record(const char *data, int len, const RID &rid)
 {
+  if (is_slotted()) {
+    return slotted_recover_insert_record(data, len, rid);
+  }
+
   if (rid.slot_num >= page_header_->record_capacity) {
     LOG_WARN("slot_num illegal, slot_num(%d) > record_capacity(%d).", rid.slot_num, page_header_->record_capacity);
     return RC::RECORD_INVALID_RID;
@@ -223,8 +438,12 @@ RC RecordPageHandler::recover_insert_record(const char *data, const RID &rid)
   }
 
   // 恢复数据
-  char *record_data = get_record_data(rid.slot_num);
-  memcpy(record_data, data, page_header_->record_real_size);
+  if (is_pax()) {
+    pax_scatter(rid.slot_num, data);
+  } else {
+    char *record_data = get_record_data(rid.slot_num);
+    memcpy(record_data, data, page_header_->record_real_size);
+  }
 
   frame_->mark_dirty();
 
@@ -235,6 +454,10 @@ RC RecordPageHandler::delete_record(const RID *rid)
 {
   ASSERT(readonly_ == false, "cannot delete record from page while the page is readonly");
 
+  if (is_slotted()) {
+    return slotted_delete_record(rid);
+  }
+
   if (rid->slot_num >= page_header_->record_capacity) {
     LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, page_num %d.", rid->slot_num, frame_->page_num());
     return RC::INVALID_ARGUMENT;
@@ -259,6 +482,10 @@ RC RecordPageHandler::delete_record(const RID *rid)
 
 RC RecordPageHandler::get_record(const RID *rid, Record *rec)
 {
+  if (is_slotted()) {
+    return slotted_get_record(rid, rec);
+  }
+
   if (rid->slot_num >= page_header_->record_capacity) {
     LOG_ERROR("Invalid slot_num:%d, exceed page's record capacity, page_num %d.", rid->slot_num, frame_->page_num());
     return RC::RECORD_INVALID_RID;
@@ -271,10 +498,22 @@ RC RecordPageHandler::get_record(const RID *rid, Record *rec)
   }
 
   rec->set_rid(*rid);
+  if (is_pax()) {
+    row_buffer_.resize(page_header_->record_real_size);
+    pax_gather(rid->slot_num, row_buffer_.data(), {} /*all columns*/);
+    rec->set_data(row_buffer_.data(), page_header_->record_real_size);
+    return RC::SUCCESS;
+  }
+
   rec->set_data(get_record_data(rid->slot_num), page_header_->record_real_size);
   return RC::SUCCESS;
 }
 
+void RecordPageHandler::mark_dirty()
+{
+  frame_->mark_dirty();
+}
+
 PageNum RecordPageHandler::get_page_num() const
 {
   if (nullptr == page_header_) {
@@ -283,64 +522,291 @@ PageNum RecordPageHandler::get_page_num() const
   return frame_->page_num();
 }
 
-bool RecordPageHandler::is_full() const { return page_header_->record_num >= page_header_->record_capacity; }
+RC RecordPageHandler::update_record(const RID &rid, const char *data, int len)
+{
+  ASSERT(readonly_ == false, "cannot update record in page while the page is readonly");
 
-////////////////////////////////////////////////////////////////////////////////
+  if (is_slotted()) {
+    return slotted_update_record(rid, data, len);
+  }
 
-RecordFileHandler::~RecordFileHandler() { this->close(); }
+  if (len != page_header_->record_real_size) {
+    LOG_WARN("invalid record length. len=%d, record size=%d", len, page_header_->record_real_size);
+    return RC::INVALID_ARGUMENT;
+  }
 
-RC RecordFileHandler::init(DiskBufferPool *buffer_pool)
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num:%d, exceed page's record capacity, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_INVALID_RID;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    LOG_ERROR("Invalid slot_num:%d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  if (is_pax()) {
+    pax_scatter(rid.slot_num, data);
+  } else {
+    char *record_data = get_record_data(rid.slot_num);
+    if (record_data != data) {
+      memcpy(record_data, data, len);
+    }
+  }
+  frame_->mark_dirty();
+  return RC::SUCCESS;
+}
+
+bool RecordPageHandler::is_full() const
 {
-  if (disk_buffer_pool_ != nullptr) {
-    LOG_ERROR("record file handler has been openned.");
-    return RC::RECORD_OPENNED;
+  if (is_slotted()) {
+    return !slotted_has_space(1);
+  }
+  return page_header_->record_num >= page_header_->record_capacity;
+}
+
+bool RecordPageHandler::has_space(int len) const
+{
+  if (is_slotted()) {
+    return slotted_has_space(len);
   }
+  return !is_full();
+}
 
-  disk_buffer_pool_ = buffer_pool;
+bool RecordPageHandler::slotted_has_space(int len) const
+{
+  const SlottedPageHeader *header = slotted_header();
+
+  int need = len;
+  if (header->slot_num == page_header_->record_num) {
+    // 没有空闲的槽位，需要扩展槽位目录
+    need += RECORD_SLOT_SIZE;
+  }
+  return header->free_space - need >= SLOTTED_PAGE_RESERVED_SPACE;
+}
+
+int RecordPageHandler::slotted_allocate(int len, int extra_slot_size)
+{
+  SlottedPageHeader *header = slotted_header();
+  ASSERT(header->free_space >= len + extra_slot_size, "no enough space in page. free space=%d, need=%d",
+         header->free_space, len + extra_slot_size);
 
-  RC rc = init_free_pages();
+  if (header->data_offset - slot_dir_end() < len + extra_slot_size) {
+    slotted_compact();
+  }
+
+  header->data_offset -= len;
+  return header->data_offset;
+}
+
+void RecordPageHandler::slotted_compact()
+{
+  SlottedPageHeader *header = slotted_header();
+  RecordSlot        *slots  = this->slots();
+  char              *data   = frame_->data();
 
-  LOG_INFO("open record file handle done. rc=%s", strrc(rc));
+  char buffer[BP_PAGE_DATA_SIZE];
+  memcpy(buffer, data, BP_PAGE_DATA_SIZE);
+
+  int data_offset = BP_PAGE_DATA_SIZE;
+  for (int i = 0; i < header->slot_num; i++) {
+    RecordSlot &slot = slots[i];
+    if (slot.offset == 0) {
+      continue;
+    }
+
+    data_offset -= slot.capacity;
+    memcpy(data + data_offset, buffer + slot.offset, slot.len);
+    slot.offset = data_offset;
+  }
+
+  header->data_offset = data_offset;
+  ASSERT(header->data_offset - slot_dir_end() == header->free_space,
+         "slotted page corrupted after compaction. data offset=%d, slot dir end=%d, free space=%d",
+         header->data_offset, slot_dir_end(), header->free_space);
+  LOG_TRACE("compact slotted page. page_num=%d, free space=%d", frame_->page_num(), header->free_space);
+}
+
+RC RecordPageHandler::slotted_insert_record(const char *data, int len, RID *rid)
+{
+  if (!slotted_has_space(len)) {
+    LOG_TRACE("Page has no space for record, page_num %d:%d, len=%d.",
+              disk_buffer_pool_->file_desc(), frame_->page_num(), len);
+    return RC::RECORD_NOMEM;
+  }
+
+  SlottedPageHeader *header = slotted_header();
+  RecordSlot        *slots  = this->slots();
+
+  SlotNum slot_num = 0;
+  while (slot_num < header->slot_num && slots[slot_num].offset != 0) {
+    slot_num++;
+  }
+
+  const int extra_slot_size = (slot_num == header->slot_num) ? RECORD_SLOT_SIZE : 0;
+  const int offset          = slotted_allocate(len, extra_slot_size);
+  if (extra_slot_size > 0) {
+    header->slot_num++;
+  }
+  header->free_space -= len + extra_slot_size;
+
+  slots[slot_num] = RecordSlot{static_cast<uint16_t>(offset), static_cast<uint16_t>(len), static_cast<uint16_t>(len)};
+  memcpy(frame_->data() + offset, data, len);
+  page_header_->record_num++;
+  frame_->mark_dirty();
+
+  if (rid) {
+    rid->page_num = get_page_num();
+    rid->slot_num = slot_num;
+  }
   return RC::SUCCESS;
 }
 
-void RecordFileHandler::close()
+RC RecordPageHandler::slotted_recover_insert_record(const char *data, int len, const RID &rid)
 {
-  if (disk_buffer_pool_ != nullptr) {
-    free_pages_.clear();
-    disk_buffer_pool_ = nullptr;
+  SlottedPageHeader *header = slotted_header();
+  RecordSlot        *slots  = this->slots();
+  if (rid.slot_num < header->slot_num && slots[rid.slot_num].offset != 0) {
+    return slotted_update_record(rid, data, len);
+  }
+
+  const int extra_slot_size = std::max(0, rid.slot_num + 1 - header->slot_num) * RECORD_SLOT_SIZE;
+  if (header->free_space < len + extra_slot_size) {
+    LOG_WARN("Page has no space for record. page_num=%d, slot_num=%d, len=%d, free space=%d",
+             frame_->page_num(), rid.slot_num, len, header->free_space);
+    return RC::RECORD_NOMEM;
+  }
+
+  const int offset = slotted_allocate(len, extra_slot_size);
+  for (int i = header->slot_num; i <= rid.slot_num; i++) {
+    slots[i] = RecordSlot{0, 0, 0};
   }
+  header->slot_num = std::max(header->slot_num, rid.slot_num + 1);
+  header->free_space -= len + extra_slot_size;
+
+  slots[rid.slot_num] = RecordSlot{static_cast<uint16_t>(offset), static_cast<uint16_t>(len), static_cast<uint16_t>(len)};
+  memcpy(frame_->data() + offset, data, len);
+  page_header_->record_num++;
+  frame_->mark_dirty();
+  return RC::SUCCESS;
 }
 
-RC RecordFileHandler::init_free_pages()
+RC RecordPageHandler::slotted_delete_record(const RID *rid)
 {
-  // 遍历当前文件上所有页面，找到没有满的页面
-  // 这个效率很低，会降低启动速度
-  // NOTE: 由于是初始化时的动作，所以不需要加锁控制并发
+  SlottedPageHeader *header = slotted_header();
+  RecordSlot        *slots  = this->slots();
+  if (rid->slot_num >= header->slot_num || slots[rid->slot_num].offset == 0) {
+    LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid->slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
 
-  RC rc = RC::SUCCESS;
+  RecordSlot &slot = slots[rid->slot_num];
+  header->free_space += slot.capacity;
+  slot = RecordSlot{0, 0, 0};
+  page_header_->record_num--;
 
-  BufferPoolIterator bp_iterator;
-  bp_iterator.init(*disk_buffer_pool_);
-  RecordPageHandler record_page_handler;
-  PageNum           current_page_num = 0;
+  // 回收末尾空闲的槽位
+  while (header->slot_num > 0 && slots[header->slot_num - 1].offset == 0) {
+    header->slot_num--;
+    header->free_space += RECORD_SLOT_SIZE;
+  }
+  if (page_header_->record_num == 0) {
+    header->data_offset = BP_PAGE_DATA_SIZE;
+  }
+  frame_->mark_dirty();
 
-  while (bp_iterator.has_next()) {
-    current_page_num = bp_iterator.next();
+  if (page_header_->record_num == 0) {
+    cleanup();
+  }
+  return RC::SUCCESS;
+}
 
-    rc = record_page_handler.init(*disk_buffer_pool_, current_page_num, true /*readonly*/);
-    if (rc != RC::SUCCESS) {
-      LOG_WARN("failed to init record page handler. page num=%d, rc=%d:%s", current_page_num, rc, strrc(rc));
-      return rc;
-    }
+RC RecordPageHandler::slotted_get_record(const RID *rid, Record *rec)
+{
+  const SlottedPageHeader *header = slotted_header();
+  const RecordSlot        *slots  = this->slots();
+  if (rid->slot_num >= header->slot_num || slots[rid->slot_num].offset == 0) {
+    LOG_ERROR("Invalid slot_num:%d, slot is empty, page_num %d.", rid->slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
 
-    if (!record_page_handler.is_full()) {
-      free_pages_.insert(current_page_num);
-    }
-    record_page_handler.cleanup();
+  const RecordSlot &slot = slots[rid->slot_num];
+  rec->set_rid(*rid);
+  rec->set_data(frame_->data() + slot.offset, slot.len);
+  return RC::SUCCESS;
+}
+
+RC RecordPageHandler::slotted_update_record(const RID &rid, const char *data, int len)
+{
+  SlottedPageHeader *header = slotted_header();
+  RecordSlot        *slots  = this->slots();
+  if (rid.slot_num >= header->slot_num || slots[rid.slot_num].offset == 0) {
+    LOG_ERROR("Invalid slot_num:%d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  RecordSlot &slot = slots[rid.slot_num];
+  if (len <= slot.capacity) {
+    memmove(frame_->data() + slot.offset, data, len);
+    slot.len = len;
+    frame_->mark_dirty();
+    return RC::SUCCESS;
+  }
+
+  // 原来的位置放不下，在页面内重新分配空间。可以使用插入时预留的空间
+  if (header->free_space + slot.capacity < len) {
+    LOG_WARN("Page has no space for updated record. page_num=%d, slot_num=%d, len=%d, free space=%d",
+             frame_->page_num(), rid.slot_num, len, header->free_space);
+    return RC::RECORD_NOMEM;
+  }
+
+  header->free_space += slot.capacity;
+  slot.offset = 0;  // 整理页面时不需要保留旧的数据
+
+  const int offset = slotted_allocate(len, 0);
+  header->free_space -= len;
+  slot = RecordSlot{static_cast<uint16_t>(offset), static_cast<uint16_t>(len), static_cast<uint16_t>(len)};
+  memcpy(frame_->data() + offset, data, len);
+  frame_->mark_dirty();
+  return RC::SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+RecordFileHandler::~RecordFileHandler() { this->close(); }
+
+RC RecordFileHandler::init(
+    DiskBufferPool *buffer_pool, RecordPageFormat format /*=FIXED*/, const std::vector<PaxColumn> &columns /*={}*/)
+{
+  if (disk_buffer_pool_ != nullptr) {
+    LOG_ERROR("record file handler has been openned.");
+    return RC::RECORD_OPENNED;
+  }
+
+  if (format == RecordPageFormat::PAX && columns.empty()) {
+    LOG_ERROR("PAX record file requires columns.");
+    return RC::INVALID_ARGUMENT;
+  }
+
+  disk_buffer_pool_ = buffer_pool;
+  format_           = format;
+  columns_          = columns;
+
+  // 不遍历文件，已有的页面在插入时按需检查
+  free_space_map_.init(*disk_buffer_pool_);
+
+  LOG_INFO("open record file handle done.");
+  return RC::SUCCESS;
+}
+
+void RecordFileHandler::close()
+{
+  if (disk_buffer_pool_ != nullptr) {
+    free_space_map_.clear();
+    zone_map_.clear();
+    disk_buffer_pool_ = nullptr;
   }
-  LOG_INFO("record file handler init free pages done. free page num=%d, rc=%s", free_pages_.size(), strrc(rc));
-  return rc;
 }
 
 RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
@@ -348,64 +814,82 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
   RC ret = RC::SUCCESS;
 
   RecordPageHandler record_page_handler;
-  bool              page_found       = false;
-  PageNum           current_page_num = 0;
 
-  // 当前要访问free_pages对象，所以需要加锁。在非并发编译模式下，不需要考虑这个锁
-  lock_.lock();
+  // 领取的页面在归还之前不会分给其它线程，这里访问页面时不用持有任何全局的锁
+  // 变长记录在领取的页面上可能放不下，放不下的页面先留在手里，保证每次尝试的都是不同的页面
+  PageNum probed_pages[MAX_PROBE_PAGES];
+  int     probed_num = 0;
+  auto release_probed_pages = [this, &probed_pages, &probed_num]() {
+    for (int i = 0; i < probed_num; i++) {
+      free_space_map_.release(probed_pages[i], true /*has_free_space*/);
+    }
+  };
 
-  // 找到没有填满的页面
-  while (!free_pages_.empty()) {
-    current_page_num = *free_pages_.begin();
+  while (probed_num < MAX_PROBE_PAGES) {
+    const PageNum page_num = free_space_map_.claim();
+    if (page_num == BP_INVALID_PAGE_NUM) {
+      break;
+    }
 
-    ret = record_page_handler.init(*disk_buffer_pool_, current_page_num, false /*readonly*/);
+    ret = record_page_handler.init(*disk_buffer_pool_, page_num, false /*readonly*/);
     if (ret != RC::SUCCESS) {
-      lock_.unlock();
-      LOG_WARN("failed to init record page handler. page num=%d, rc=%d:%s", current_page_num, ret, strrc(ret));
+      free_space_map_.release(page_num, false /*has_free_space*/);
+      release_probed_pages();
+      LOG_WARN("failed to init record page handler. page num=%d, rc=%d:%s", page_num, ret, strrc(ret));
       return ret;
     }
 
-    if (!record_page_handler.is_full()) {
-      page_found = true;
-      break;
+    if (record_page_handler.has_space(record_size)) {
+      ret = record_page_handler.insert_record(data, record_size, rid);
+      if (OB_SUCC(ret)) {
+        zone_map_.update(page_num, data);
+      }
+      const bool full = record_page_handler.is_full();
+      record_page_handler.cleanup();
+      free_space_map_.release(page_num, !full);
+      release_probed_pages();
+      return ret;
     }
+
+    const bool full = record_page_handler.is_full();
     record_page_handler.cleanup();
-    free_pages_.erase(free_pages_.begin());
+    if (full) {
+      free_space_map_.release(page_num, false /*has_free_space*/);
+    } else {
+      probed_pages[probed_num++] = page_num;
+    }
   }
-  lock_.unlock();  // 如果找到了一个有效的页面，那么此时已经拿到了页面的写锁
+  release_probed_pages();
 
   // 找不到就分配一个新的页面
-  if (!page_found) {
-    Frame *frame = nullptr;
-    if ((ret = disk_buffer_pool_->allocate_page(&frame)) != RC::SUCCESS) {
-      LOG_ERROR("Failed to allocate page while inserting record. ret:%d", ret);
-      return ret;
-    }
-
-    current_page_num = frame->page_num();
-
-    ret = record_page_handler.init_empty_page(*disk_buffer_pool_, current_page_num, record_size);
-    if (ret != RC::SUCCESS) {
-      frame->unpin();
-      LOG_ERROR("Failed to init empty page. ret:%d", ret);
-      // this is for allocate_page
-      return ret;
-    }
+  Frame *frame = nullptr;
+  if ((ret = disk_buffer_pool_->allocate_page(&frame)) != RC::SUCCESS) {
+    LOG_ERROR("Failed to allocate page while inserting record. ret:%d", ret);
+    return ret;
+  }
 
-    // frame 在allocate_page的时候，是有一个pin的，在init_empty_page时又会增加一个，所以这里手动释放一个
+  const PageNum page_num = frame->page_num();
+  ret = record_page_handler.init_empty_page(*disk_buffer_pool_, page_num, record_size, format_, columns_);
+  if (ret != RC::SUCCESS) {
     frame->unpin();
-
-    // 这里的加锁顺序看起来与上面是相反的，但是不会出现死锁
-    // 上面的逻辑是先加lock锁，然后加页面写锁，这里是先加上
-    // 了页面写锁，然后加lock的锁，但是不会引起死锁。
-    // 为什么？
-    lock_.lock();
-    free_pages_.insert(current_page_num);
-    lock_.unlock();
+    LOG_ERROR("Failed to init empty page. ret:%d", ret);
+    // this is for allocate_page
+    return ret;
   }
 
-  // 找到空闲位置
-  return record_page_handler.insert_record(data, rid);
+  // frame 在allocate_page的时候，是有一个pin的，在init_empty_page时又会增加一个，所以这里手动释放一个
+  frame->unpin();
+
+  // 新页面还没有登记到空闲空间表中，其它线程拿不到，插入之后再登记
+  zone_map_.init_page(page_num);
+  ret = record_page_handler.insert_record(data, record_size, rid);
+  if (OB_SUCC(ret)) {
+    zone_map_.update(page_num, data);
+  }
+  const bool full = record_page_handler.is_full();
+  record_page_handler.cleanup();
+  free_space_map_.release(page_num, !full);
+  return ret;
 }
 
 RC RecordFileHandler::recover_insert_record(const char *data, int record_size, const RID &rid)
@@ -420,7 +904,18 @@ RC RecordFileHandler::recover_insert_record(const char *data, int record_size, c
     return ret;
   }
 
-  return record_page_handler.recover_insert_record(data, rid);
+  ret = record_page_handler.recover_insert_record(data, record_size, rid);
+  if (OB_SUCC(ret)) {
+    zone_map_.update(rid.page_num, data);
+  }
+  const bool full = record_page_handler.is_full();
+  record_page_handler.cleanup();
+
+  // 恢复时可能会创建打开文件之后才出现的页面，空闲空间表中没有检查过它们
+  if (OB_SUCC(ret) && !full) {
+    free_space_map_.add_free(rid.page_num);
+  }
+  return ret;
 }
 
 RC RecordFileHandler::delete_record(const RID *rid)
@@ -434,17 +929,40 @@ RC RecordFileHandler::delete_record(const RID *rid)
   }
 
   rc = page_handler.delete_record(rid);
-  // 📢 这里注意要清理掉资源，否则会与insert_record中的加锁顺序冲突而可能出现死锁
-  // delete record的加锁逻辑是拿到页面锁，删除指定记录，然后加上和释放record manager锁
-  // insert record是加上 record manager锁，然后拿到指定页面锁再释放record manager锁
+  if (OB_SUCC(rc)) {
+    zone_map_.touch(rid->page_num);
+  }
+  // 📢 这里注意要先清理掉资源，释放页面锁之后再访问空闲空间表
+  // 空闲空间表的锁和页面锁从来不会同时持有，就不用考虑两种锁的加锁顺序
   page_handler.cleanup();
   if (OB_SUCC(rc)) {
-    // 因为这里已经释放了页面锁，并发时，其它线程可能又把该页面填满了，那就不应该再放入 free_pages_
-    // 中。但是这里可以不关心，因为在查找空闲页面时，会自动过滤掉已经满的页面
-    lock_.lock();
-    free_pages_.insert(rid->page_num);
-    LOG_TRACE("add free page %d to free page list", rid->page_num);
-    lock_.unlock();
+    // 因为这里已经释放了页面锁，并发时，其它线程可能又把该页面填满了，那就不应该再放入空闲空间表
+    // 中。但是这里可以不关心，因为领取页面后插入之前，会检查页面是否还能放下
+    free_space_map_.add_free(rid->page_num);
+    LOG_TRACE("add free page %d to free space map", rid->page_num);
+  }
+  return rc;
+}
+
+RC RecordFileHandler::update_record(const RID &rid, const char *data, int len)
+{
+  RecordPageHandler page_handler;
+
+  RC rc = page_handler.init(*disk_buffer_pool_, rid.page_num, false /*readonly*/);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init record page handler.page number=%d. rc=%s", rid.page_num, strrc(rc));
+    return rc;
+  }
+
+  rc = page_handler.update_record(rid, data, len);
+  if (OB_SUCC(rc)) {
+    zone_map_.update(rid.page_num, data);
+  }
+  const bool full = page_handler.is_full();
+  // 与 delete_record 一样，先释放页面锁再访问空闲空间表
+  page_handler.cleanup();
+  if (OB_SUCC(rc) && !full) {
+    free_space_map_.add_free(rid.page_num);
   }
   return rc;
 }
@@ -483,6 +1001,20 @@ RC RecordFileHandler::visit_record(const RID &rid, bool readonly, std::function<
   }
 
   visitor(record);
+
+  if (!readonly && page_handler.is_pax()) {
+    // PAX 页面上拿到的是记录的副本，修改后需要写回页面
+    rc = page_handler.update_record(rid, record.data(), record.len());
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to write back record. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
+    }
+  } else if (!readonly) {
+    // 其它页面上直接修改了页面中的数据，页面之前可能已经刷过盘，不标记的话淘汰时修改会丢失
+    page_handler.mark_dirty();
+  }
+  if (!readonly && OB_SUCC(rc)) {
+    zone_map_.update(rid.page_num, record.data());
+  }
   return rc;
 }
 
@@ -500,13 +1032,19 @@ RC RecordFileScanner::open_scan(
   trx_              = trx;
   readonly_         = readonly;
 
-  RC rc = bp_iterator_.init(buffer_pool);
+  RC rc = end_page_ == BP_INVALID_PAGE_NUM ? bp_iterator_.init(buffer_pool)
+                                           : bp_iterator_.init(buffer_pool, begin_page_, end_page_);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to init bp iterator. rc=%d:%s", rc, strrc(rc));
     return rc;
   }
   condition_filter_ = condition_filter;
 
+  // 修改数据时需要完整的记录，比如更新时要复制旧版本
+  record_page_iterator_.set_projection(readonly ? projection_ : std::vector<int>());
+  scanned_page_num_ = 0;
+  pruned_page_num_  = 0;
+
   rc = fetch_next_record();
   if (rc == RC::RECORD_EOF) {
     rc = RC::SUCCESS;
@@ -535,14 +1073,30 @@ RC RecordFileScanner::fetch_next_record()
   }
 
   // 上个页面遍历完了，或者还没有开始遍历某个页面，那么就从一个新的页面开始遍历查找
+  // 调用者拿着的上一条记录指向当前页面，这个页面交给 pinned_page_handler_，等调用者往后走时再释放
+  pinned_page_handler_.cleanup();
+  record_page_handler_.swap(pinned_page_handler_);
   while (bp_iterator_.has_next()) {
     PageNum page_num = bp_iterator_.next();
     record_page_handler_.cleanup();
+    if (zone_map_ != nullptr && zone_map_->can_skip(page_num, zone_filters_)) {
+      pruned_page_num_++;
+      continue;
+    }
+
     rc = record_page_handler_.init(*disk_buffer_pool_, page_num, readonly_);
     if (OB_FAIL(rc)) {
       LOG_WARN("failed to init record page handler. page_num=%d, rc=%s", page_num, strrc(rc));
       return rc;
     }
+    scanned_page_num_++;
+
+    if (zone_map_ != nullptr && zone_map_->need_build(page_num)) {
+      rc = build_page_zone();
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
 
     record_page_iterator_.init(record_page_handler_);
     rc = fetch_next_record_in_page();
@@ -574,28 +1128,78 @@ RC RecordFileScanner::fetch_next_record_in_page()
       return rc;
     }
 
+    // 如果是某个事务上遍历数据，还要看看事务访问是否有冲突
+      if (trx_ != nullptr) {
+      // 让当前事务探测一下是否访问冲突，或者需要加锁、等锁等操作，由事务自己决定
+      // 只读访问时，事务可能会把记录替换成对自己可见的旧版本，所以过滤要放在后面
+      rc = trx_->visit_record(table_, next_record_, readonly_);
+      if (rc == RC::LOCKED_NEED_WAIT) {
+        // 调用者可能还在使用上一条记录，等到下次获取记录时再释放页面等锁
+        lock_waiting_ = true;
+        return RC::SUCCESS;
+      }
+      if (rc == RC::RECORD_INVISIBLE) {
+        // 可以参考MvccTrx，表示当前记录不可见
+        // 这种模式仅在 readonly 事务下是有效的
+        continue;
+      }
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+    }
+
     // 如果有过滤条件，就用过滤条件过滤一下
     if (condition_filter_ != nullptr && !condition_filter_->filter(next_record_)) {
+      if (trx_ != nullptr && !readonly_) {
+        trx_->skip_record(table_, next_record_);
+      }
       continue;
     }
+    return rc;
+  }
 
-    // 如果是某个事务上遍历数据，还要看看事务访问是否有冲突
-    if (trx_ == nullptr) {
+  next_record_.rid().slot_num = -1;
+  return RC::RECORD_EOF;
+}
+
+RC RecordFileScanner::build_page_zone()
+{
+  // 需要所有的记录和所有的字段，不能使用扫描自己的迭代器，它可能只读取部分列
+  RecordPageIterator iterator;
+  iterator.init(record_page_handler_);
+
+  ZoneMap::PageZone zone = zone_map_->new_zone();
+  Record            record;
+  while (iterator.has_next()) {
+    RC rc = iterator.next(record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get record while building page zone. page_num=%d, rc=%s",
+               record_page_handler_.get_page_num(), strrc(rc));
       return rc;
     }
+    zone_map_->add_record(zone, record.data());
+  }
+  zone_map_->build(record_page_handler_.get_page_num(), std::move(zone));
+  return RC::SUCCESS;
+}
 
-    // 让当前事务探测一下是否访问冲突，或者需要加锁、等锁等操作，由事务自己决定
-    rc = trx_->visit_record(table_, next_record_, readonly_);
-    if (rc == RC::RECORD_INVISIBLE) {
-      // 可以参考MvccTrx，表示当前记录不可见
-      // 这种模式仅在 readonly 事务下是有效的
-      continue;
-    }
+RC RecordFileScanner::wait_record_lock(const RID &rid)
+{
+  // 等锁之前释放页面，持有锁的事务结束时需要修改这个页面
+  record_page_handler_.cleanup();
+  RC rc = trx_->wait_lock();
+  if (OB_FAIL(rc)) {
+    LOG_TRACE("failed to wait record lock. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
     return rc;
   }
 
-  next_record_.rid().slot_num = -1;
-  return RC::RECORD_EOF;
+  rc = record_page_handler_.init(*disk_buffer_pool_, rid.page_num, readonly_);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to init record page handler. page_num=%d, rc=%s", rid.page_num, strrc(rc));
+    return rc;
+  }
+  record_page_iterator_.init(record_page_handler_, rid.slot_num);
+  return RC::SUCCESS;
 }
 
 RC RecordFileScanner::close_scan()
@@ -609,6 +1213,8 @@ RC RecordFileScanner::close_scan()
   }
 
   record_page_handler_.cleanup();
+  pinned_page_handler_.cleanup();
+  lock_waiting_ = false;
 
   return RC::SUCCESS;
 }
@@ -617,7 +1223,34 @@ bool RecordFileScanner::has_next() { return next_record_.rid().slot_num != -1; }
 
 RC RecordFileScanner::next(Record &record)
 {
-  record = next_record_;
+  // 调用者已经不再使用上一条记录了
+  pinned_page_handler_.cleanup();
+
+  while (lock_waiting_) {
+    // 上一条记录已经处理完了，可以释放页面等锁，等到锁之后重新访问这条记录
+    lock_waiting_ = false;
+    RC rc = wait_record_lock(next_record_.rid());
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    rc = fetch_next_record();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  if (!readonly_ && next_record_.rid().slot_num != -1) {
+    // 修改上一条记录时可能整理了页面，下一条记录的位置会变化，RID 是不变的
+    RC rc = record_page_handler_.get_record(&next_record_.rid(), &next_record_);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  // 只读扫描时 next_record_ 可能是事务复制出来的旧版本，直接把数据交给调用者，不再复制一次
+  record = std::move(next_record_);
+  record_page_iterator_.keep_last_record();
 
   RC rc = fetch_next_record();
   if (rc == RC::RECORD_EOF) {
@@ -19,6 +19,8 @@ See the Mulan PSL v2 for more details. */
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/trx/latch_memo.h"
 #include "storage/record/record.h"
+#include "storage/record/free_space_map.h"
+#include "storage/record/zone_map.h"
 #include "common/lang/bitmap.h"
 
 class ConditionFilter;
@@ -45,6 +47,12 @@ class Table;
  * 问题2：如何更有效地存放不定长数据呢？
  * 问题3：如果一个页面不能存放一个记录，那么怎么组织记录存放效果更好呢？
  *
+ * 变长记录使用另一种页面格式(slotted page)，页面中有一个槽位目录，每个槽位记录一条记录在页面中的位置和长度，
+ * RID 中的 slot num 就是槽位的编号。记录在页面内移动时只需要修改槽位，RID 保持不变。可以参考 RecordPageFormat。
+ *
+ * 列存的表使用 PAX 格式的页面，记录的每一列在页面中连续存放(minipage)，读取记录时再把各列拼成一行。
+ * 只需要部分字段的扫描可以只读取对应的 minipage。可以参考 PaxPageHeader。
+ *
  * 按照上面的描述，这里提供了几个类，分别是：
  * - RecordFileHandler：管理整个文件/表的记录增删改查
  * - RecordPageHandler：管理单个页面上记录的增删改查
@@ -53,15 +61,31 @@ class Table;
  * - PageHeader：每个页面上都会记录的页面头信息
  */
 
+/**
+ * @brief 记录页面的格式
+ * @ingroup RecordManager
+ */
+enum class RecordPageFormat
+{
+  FIXED,    ///< 定长记录，按照槽位号直接计算记录的位置，使用位图记录槽位是否被占用
+  SLOTTED,  ///< 变长记录，使用槽位目录记录每条记录的位置和长度
+  PAX,      ///< 定长记录按列存放，每一列在页面中有一个 minipage，槽位的分配与 FIXED 相同
+};
+
 /**
  * @brief 数据文件，按照页面来组织，每一页都存放一些记录/数据行
  * @ingroup RecordManager
  * @details 每一页都有一个这样的页头，虽然看起来浪费，但是现在就简单的这么做
- * 从这个页头描述的信息来看，当前仅支持定长行/记录。如果要支持变长记录，
- * 或者超长（超出一页）的记录，这么做是不合适的。
+ * 从这个页头描述的信息来看，当前仅支持定长行/记录。变长记录的页面只使用 record_num，
+ * record_real_size 设置为 VARIABLE_RECORD_SIZE，页头后面是 SlottedPageHeader。
+ * PAX 页面的 record_size 设置为 PAX_RECORD_SIZE，页头后面是 PaxPageHeader。
+ * 超长（超出一页）的记录还不支持。
  */
 struct PageHeader
 {
+  static constexpr int32_t VARIABLE_RECORD_SIZE = -1;
+  static constexpr int32_t PAX_RECORD_SIZE      = -2;
+
   int32_t record_num;           ///< 当前页面记录的个数
   int32_t record_real_size;     ///< 每条记录的实际大小
   int32_t record_size;          ///< 每条记录占用实际空间大小(可能对齐)
@@ -69,6 +93,60 @@ struct PageHeader
   int32_t first_record_offset;  ///< 第一条记录的偏移量
 };
 
+/**
+ * @brief 变长记录页面的页头，紧跟在 PageHeader 的后面
+ * @ingroup RecordManager
+ * @details 页面的组织如下，槽位目录从前向后增长，记录数据从页尾向前增长：
+ * @code
+ * | PageHeader | SlottedPageHeader | slot0 | slot1 | ... | free space | ... | record1 | record0 |
+ * @endcode
+ * 删除记录或者记录变短后，留下的空洞会在空间不连续时通过整理页面(compact)回收。
+ */
+struct SlottedPageHeader
+{
+  int32_t slot_num;     ///< 槽位目录的项数，包括空闲的槽位
+  int32_t data_offset;  ///< 记录数据区的起始位置
+  int32_t free_space;   ///< 页面中所有的空闲空间，包括记录之间的空洞
+};
+
+/**
+ * @brief 变长记录页面的槽位
+ * @ingroup RecordManager
+ * @details 记录变短时不会释放多出来的空间，capacity 保持不变。这样回滚时恢复旧版本一定不会因为空间不足失败
+ */
+struct RecordSlot
+{
+  uint16_t offset;    ///< 记录数据在页面中的偏移，0 表示空闲的槽位
+  uint16_t len;       ///< 记录的长度
+  uint16_t capacity;  ///< 给这条记录分配的空间
+};
+
+/**
+ * @brief PAX 页面的页头，紧跟在 PageHeader 的后面
+ * @ingroup RecordManager
+ * @details 页面的组织如下，每一列的 minipage 按照8字节对齐：
+ * @code
+ * | PageHeader | PaxPageHeader | column0 | column1 | ... | bitmap | minipage0 | minipage1 | ... |
+ * @endcode
+ * 槽位 i 上的记录在第 j 列的值存放在 minipage j 的第 i 个位置，记录的分配情况与定长页面一样使用位图记录。
+ */
+struct PaxPageHeader
+{
+  int32_t column_num;  ///< 列的个数，后面紧跟着这么多个 PaxColumn
+};
+
+/**
+ * @brief PAX 页面中的一列
+ * @ingroup RecordManager
+ * @details 列是记录中的一段连续数据，可以是一个字段，也可以是 NULL 位图。所有列覆盖整条记录
+ */
+struct PaxColumn
+{
+  int32_t record_offset;    ///< 在记录中的偏移
+  int32_t len;              ///< 在记录中的长度
+  int32_t minipage_offset;  ///< minipage 在页面中的偏移，初始化页面时计算
+};
+
 /**
  * @brief 遍历一个页面中每条记录的iterator
  * @ingroup RecordManager
@@ -104,11 +182,34 @@ public:
    */
   bool is_valid() const { return record_page_handler_ != nullptr; }
 
+  /**
+   * @brief 设置读取 PAX 页面时需要的列，为空时读取所有列
+   * @details 读出来的记录中，其它列的数据是无效的。对其它格式的页面没有影响
+   * @param columns PaxColumn 的下标
+   */
+  void set_projection(const std::vector<int> &columns);
+
+  /**
+   * @brief 调用者还要继续使用上一次返回的记录，之后从 PAX 页面读取的记录放到另一个缓存中
+   */
+  void keep_last_record() { row_buffer_index_ ^= 1; }
+
+private:
+  /**
+   * @brief 从 start 开始查找第一个有记录的槽位，没有时返回 -1
+   */
+  SlotNum next_used_slot(SlotNum start);
+
 private:
   RecordPageHandler *record_page_handler_ = nullptr;
   PageNum            page_num_            = BP_INVALID_PAGE_NUM;
   common::Bitmap     bitmap_;             ///< bitmap 的相关信息可以参考 RecordPageHandler 的说明
   SlotNum            next_slot_num_ = 0;  ///< 当前遍历到了哪一个slot
+
+  std::vector<int>   projection_;         ///< 读取 PAX 页面时需要的列
+  /// PAX 页面上的记录需要拼起来放到缓存中。有两个缓存，调用者拿着上一条记录时，可以继续读取下一条记录
+  std::vector<char>  row_buffers_[2];
+  int                row_buffer_index_ = 0;
 };
 
 /**
@@ -120,9 +221,16 @@ private:
  * |------------|------------------------|
  * | record1 | record2 | ..... | recordN |
  * @endcode
+ * 变长记录页面的组织参考 SlottedPageHeader。页面的格式记录在页头中，初始化时根据页头判断。
+ * 变长记录页面插入记录时会保留 SLOTTED_PAGE_RESERVED_SPACE 的空闲空间，留给页面上的记录变长时使用。
+ * PAX 页面的组织参考 PaxPageHeader。页面中没有连续的记录数据，获取记录时会复制到 RecordPageHandler
+ * 的缓存中，修改拿到的记录数据不会改变页面，需要再调用 update_record。
  */
 class RecordPageHandler
 {
+public:
+  static constexpr int SLOTTED_PAGE_RESERVED_SPACE = BP_PAGE_DATA_SIZE / 10;
+
 public:
   RecordPageHandler() = default;
   ~RecordPageHandler();
@@ -149,15 +257,29 @@ public:
    *
    * @param buffer_pool 关联某个文件时，都通过buffer pool来做读写文件
    * @param page_num    当前处理哪个页面
-   * @param record_size 每个记录的大小
+   * @param record_size 每个记录的大小，变长记录页面忽略这个参数
+   * @param format      页面的格式
+   * @param columns     PAX 页面上记录的各列，其它格式的页面忽略这个参数
    */
-  RC init_empty_page(DiskBufferPool &buffer_pool, PageNum page_num, int record_size);
+  RC init_empty_page(DiskBufferPool &buffer_pool, PageNum page_num, int record_size,
+                     RecordPageFormat format = RecordPageFormat::FIXED, const std::vector<PaxColumn> &columns = {});
+
+  /**
+   * @brief 某种格式的页面上能存放的最长的记录
+   * @param column_num PAX 页面上记录的列数，其它格式的页面忽略这个参数
+   */
+  static int max_record_size(RecordPageFormat format, int column_num = 1);
 
   /**
    * @brief 操作结束后做的清理工作，比如释放页面、解锁
    */
   RC cleanup();
 
+  /**
+   * @brief 与另一个 handler 交换正在处理的页面，页面的 pin 和锁也一起交换
+   */
+  void swap(RecordPageHandler &other);
+
   /**
    * @brief 插入一条记录
    *
@@ -166,13 +288,32 @@ public:
    */
   RC insert_record(const char *data, RID *rid);
 
+  /**
+   * @brief 插入一条记录
+   *
+   * @param data 要插入的记录
+   * @param len  记录的长度。定长记录页面上必须与页面的记录大小一致
+   * @param rid  如果插入成功，通过这个参数返回插入的位置
+   * @return RC::RECORD_NOMEM 页面上没有足够的空间
+   */
+  RC insert_record(const char *data, int len, RID *rid);
+
   /**
    * @brief 数据库恢复时，在指定位置插入数据
    * 
    * @param data 要插入的数据行
+   * @param len  数据的长度
    * @param rid  插入的位置
    */
-  RC recover_insert_record(const char *data, const RID &rid);
+  RC recover_insert_record(const char *data, int len, const RID &rid);
+
+  /**
+   * @brief 修改指定的记录，RID 保持不变
+   * @details 变长记录变长时，可能会整理页面，页面上其它记录的位置也会改变，之前获取的记录数据指针都会失效。
+   * data 不能指向当前页面中的数据
+   * @return RC::RECORD_NOMEM 页面上没有足够的空间
+   */
+  RC update_record(const RID &rid, const char *data, int len);
 
   /**
    * @brief 删除指定的记录
@@ -189,6 +330,11 @@ public:
    */
   RC get_record(const RID *rid, Record *rec);
 
+  /**
+   * @brief 直接修改了 get_record 返回的记录数据之后调用，页面被淘汰时要写回磁盘
+   */
+  void mark_dirty();
+
   /**
    * @brief 返回该记录页的页号
    */
@@ -199,6 +345,21 @@ public:
    */
   bool is_full() const;
 
+  /**
+   * @brief 当前页面能否插入一条长度为 len 的记录
+   */
+  bool has_space(int len) const;
+
+  /**
+   * @brief 是否变长记录页面
+   */
+  bool is_slotted() const { return page_header_->record_real_size == PageHeader::VARIABLE_RECORD_SIZE; }
+
+  /**
+   * @brief 是否 PAX 页面
+   */
+  bool is_pax() const { return page_header_->record_size == PageHeader::PAX_RECORD_SIZE; }
+
 protected:
   /**
    * @details 
@@ -225,12 +386,72 @@ protected:
     return frame_->data() + page_header_->first_record_offset + (page_header_->record_size * slot_num);
   }
 
+  SlottedPageHeader *slotted_header() { return reinterpret_cast<SlottedPageHeader *>(frame_->data() + sizeof(PageHeader)); }
+  const SlottedPageHeader *slotted_header() const
+  {
+    return reinterpret_cast<const SlottedPageHeader *>(frame_->data() + sizeof(PageHeader));
+  }
+  RecordSlot *slots() { return reinterpret_cast<RecordSlot *>(frame_->data() + sizeof(PageHeader) + sizeof(SlottedPageHeader)); }
+
+  /**
+   * @brief 槽位目录结束的位置，也就是空闲空间的开始
+   */
+  int slot_dir_end() const
+  {
+    return static_cast<int>(sizeof(PageHeader) + sizeof(SlottedPageHeader) + slotted_header()->slot_num * sizeof(RecordSlot));
+  }
+
+  PaxPageHeader *pax_header() { return reinterpret_cast<PaxPageHeader *>(frame_->data() + sizeof(PageHeader)); }
+  PaxColumn     *pax_columns()
+  {
+    return reinterpret_cast<PaxColumn *>(frame_->data() + sizeof(PageHeader) + sizeof(PaxPageHeader));
+  }
+
+  /**
+   * @brief 页面上记录分配位图的位置，PAX 页面的位图在列目录的后面
+   */
+  char *page_bitmap();
+
+  /**
+   * @brief 把 PAX 页面上一条记录的各列拼到 data 中
+   * @param columns 只读取这些列，为空时读取所有列
+   */
+  void pax_gather(SlotNum slot_num, char *data, const std::vector<int> &columns);
+
+  /**
+   * @brief 把一条记录拆成各列写到 PAX 页面上
+   */
+  void pax_scatter(SlotNum slot_num, const char *data);
+
+  /**
+   * @brief 变长记录页面的各种操作
+   */
+  RC   slotted_insert_record(const char *data, int len, RID *rid);
+  RC   slotted_recover_insert_record(const char *data, int len, const RID &rid);
+  RC   slotted_delete_record(const RID *rid);
+  RC   slotted_get_record(const RID *rid, Record *rec);
+  RC   slotted_update_record(const RID &rid, const char *data, int len);
+  bool slotted_has_space(int len) const;
+
+  /**
+   * @brief 从数据区分配一块连续的空间。调用者需要保证 free_space 足够
+   * @param extra_slot_size 需要同时扩展的槽位目录大小
+   * @return 分配的空间在页面中的偏移
+   */
+  int slotted_allocate(int len, int extra_slot_size);
+
+  /**
+   * @brief 整理页面，把所有记录移动到页尾，消除记录之间的空洞
+   */
+  void slotted_compact();
+
 protected:
   DiskBufferPool *disk_buffer_pool_ = nullptr;  ///< 当前操作的buffer pool(文件)
   Frame          *frame_            = nullptr;  ///< 当前操作页面关联的frame(frame的更多概念可以参考buffer pool和frame)
   bool            readonly_         = false;    ///< 当前的操作是否都是只读的
   PageHeader     *page_header_      = nullptr;  ///< 当前页面上页面头
   char           *bitmap_           = nullptr;  ///< 当前页面上record分配状态信息bitmap内存起始位置
+  std::vector<char> row_buffer_;               ///< 从 PAX 页面上获取的记录放在这里
 
 private:
   friend class RecordPageIterator;
@@ -251,8 +472,11 @@ public:
    * @brief 初始化
    *
    * @param buffer_pool 当前操作的是哪个文件
+   * @param format      新分配的页面使用的格式
+   * @param columns     PAX 页面上记录的各列
    */
-  RC init(DiskBufferPool *buffer_pool);
+  RC init(DiskBufferPool *buffer_pool, RecordPageFormat format = RecordPageFormat::FIXED,
+          const std::vector<PaxColumn> &columns = {});
 
   /**
    * @brief 关闭，做一些资源清理的工作
@@ -284,6 +508,14 @@ public:
    */
   RC recover_insert_record(const char *data, int record_size, const RID &rid);
 
+  /**
+   * @brief 修改指定的记录，RID 保持不变
+   * @details 可以在已经拿着页面写锁时调用，比如在 visit_record 的回调函数中。
+   * 变长的记录变长时可能整理页面，之前获取的这个页面上的记录数据指针都会失效
+   * @return RC::RECORD_NOMEM 记录变长后页面上放不下了
+   */
+  RC update_record(const RID &rid, const char *data, int len);
+
   /**
    * @brief 获取指定文件中标识符为rid的记录内容到rec指向的记录结构中
    * @param page_handler[in]
@@ -298,6 +530,7 @@ public:
 
   /**
    * @brief 与get_record类似，访问某个记录，并提供回调函数来操作相应的记录
+   * @details 不是只读访问时，PAX 页面上的记录在回调之后会写回页面
    *
    * @param rid 想要访问的记录ID
    * @param readonly 是否会修改记录
@@ -305,16 +538,25 @@ public:
    */
   RC visit_record(const RID &rid, bool readonly, std::function<void(Record &)> visitor);
 
+  FreeSpaceMap &free_space_map() { return free_space_map_; }
+
+  /**
+   * @brief 每个页面上各字段的区间信息，由表在打开文件之后设置需要维护的字段
+   */
+  ZoneMap &zone_map() { return zone_map_; }
+
 private:
   /**
-   * @brief 初始化当前没有填满记录的页面，初始化free_pages_成员
+   * @brief 变长记录可能放不下时，插入一条记录最多尝试的空闲页面个数，都放不下就分配新页面
    */
-  RC init_free_pages();
+  static constexpr int MAX_PROBE_PAGES = 8;
 
 private:
-  DiskBufferPool             *disk_buffer_pool_ = nullptr;
-  std::unordered_set<PageNum> free_pages_;  ///< 没有填充满的页面集合
-  common::Mutex               lock_;        ///< 当编译时增加-DCONCURRENCY=ON 选项时，才会真正的支持并发
+  DiskBufferPool  *disk_buffer_pool_ = nullptr;
+  RecordPageFormat format_           = RecordPageFormat::FIXED;  ///< 新分配的页面使用的格式
+  std::vector<PaxColumn> columns_;                                ///< PAX 页面上记录的各列
+  FreeSpaceMap     free_space_map_;                             ///< 还有空闲空间的页面
+  ZoneMap          zone_map_;                                   ///< 页面上各字段的区间信息
 };
 
 /**
@@ -339,6 +581,38 @@ public:
    */
   RC open_scan(Table *table, DiskBufferPool &buffer_pool, Trx *trx, bool readonly, ConditionFilter *condition_filter);
 
+  /**
+   * @brief 设置扫描需要的列，在 open_scan 之前调用
+   * @details 只对 PAX 页面和只读的扫描有效，只会读取这些列的 minipage，记录中其它列的数据是无效的。
+   * 修改数据的扫描需要完整的记录，总是读取所有的列
+   * @param columns PaxColumn 的下标，为空时读取所有列
+   */
+  void set_projection(const std::vector<int> &columns) { projection_ = columns; }
+
+  /**
+   * @brief 设置文件的区间信息和可以用来跳过页面的过滤条件，在 open_scan 之前调用
+   * @details 扫描时跳过区间不满足条件的页面，还会为没有区间信息的页面构建区间。
+   * 过滤条件只用来跳过整个页面，页面上的记录仍然需要调用者自己过滤
+   */
+  void set_zone_map(ZoneMap *zone_map) { zone_map_ = zone_map; }
+  void set_zone_filters(const std::vector<ZoneFilter> &filters) { zone_filters_ = filters; }
+
+  /**
+   * @brief 只扫描页号在 [begin_page, end_page) 中的页面，在 open_scan 之前调用
+   * @details 并行扫描时每个线程每次领取一段页面，用同一个扫描器依次扫描。没有设置时扫描整个文件
+   */
+  void set_page_range(PageNum begin_page, PageNum end_page)
+  {
+    begin_page_ = begin_page;
+    end_page_   = end_page;
+  }
+
+  /**
+   * @brief 本次扫描访问的页面个数和根据区间信息跳过的页面个数
+   */
+  int scanned_page_num() const { return scanned_page_num_; }
+  int pruned_page_num() const { return pruned_page_num_; }
+
   /**
    * @brief 关闭一个文件扫描，释放相应的资源
    */
@@ -355,7 +629,9 @@ public:
    * 
    * @param record 返回的下一条记录
    * 
-   * @details 获取下一条记录之前先调用has_next()判断是否还有数据
+   * @details 获取下一条记录之前先调用has_next()判断是否还有数据。
+   * 返回的记录不复制数据，直接指向页面上的内存，记录所在的页面会一直 pin 住(并持有页面锁)，
+   * 直到下一次调用 next 或者关闭扫描。调用者需要在这之后继续使用记录时，要自己复制一份
    */
   RC   next(Record &record);
 
@@ -370,6 +646,17 @@ private:
    */
   RC fetch_next_record_in_page();
 
+  /**
+   * @brief 释放当前页面，等待事务申请的行锁，然后从 rid 开始继续遍历
+   * @details 等锁时不能持有页面锁，否则持有行锁的事务可能因为拿不到页面锁而无法结束
+   */
+  RC wait_record_lock(const RID &rid);
+
+  /**
+   * @brief 根据当前页面上的所有记录构建页面的区间信息
+   */
+  RC build_page_zone();
+
 private:
   // TODO 对于一个纯粹的record遍历器来说，不应该关心表和事务
   Table             *table_            = nullptr;  ///< 当前遍历的是哪张表。这个字段仅供事务函数使用，如果设计合适，可以去掉
@@ -380,6 +667,15 @@ private:
   BufferPoolIterator bp_iterator_;                 ///< 遍历buffer pool的所有页面
   ConditionFilter   *condition_filter_ = nullptr;  ///< 过滤record
   RecordPageHandler  record_page_handler_;         ///< 处理文件某页面的记录
+  RecordPageHandler  pinned_page_handler_;         ///< 调用者拿着的上一条记录所在的页面，下次调用 next 时释放
   RecordPageIterator record_page_iterator_;        ///< 遍历某个页面上的所有record
   Record             next_record_;                 ///< 获取的记录放在这里缓存起来
+  bool               lock_waiting_     = false;    ///< next_record_ 的行锁还没有拿到，需要等待
+  std::vector<int>   projection_;                  ///< 需要读取的列
+  ZoneMap           *zone_map_         = nullptr;  ///< 文件的区间信息，为空时不跳过页面
+  std::vector<ZoneFilter> zone_filters_;           ///< 用来跳过页面的过滤条件
+  PageNum            begin_page_       = 0;
+  PageNum            end_page_         = BP_INVALID_PAGE_NUM;  ///< BP_INVALID_PAGE_NUM 表示扫描到文件末尾
+  int                scanned_page_num_ = 0;
+  int                pruned_page_num_  = 0;
 };
\ No newline at end of file
@@ -0,0 +1,217 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <mutex>
+
+#include "storage/record/zone_map.h"
+
+using namespace std;
+
+/**
+ * @brief 字段的值和常量能否用 Value::compare 比较，比较结果与执行时过滤条件的结果一致
+ */
+static bool comparable(AttrType column_type, AttrType value_type)
+{
+  if (column_type == value_type) {
+    return true;
+  }
+  return (column_type == INTS && value_type == FLOATS) || (column_type == FLOATS && value_type == INTS);
+}
+
+void ZoneMap::init(const vector<ZoneColumn> &columns, int null_bitmap_offset)
+{
+  clear();
+
+  lock_guard<mutex> guard(lock_);
+  columns_            = columns;
+  null_bitmap_offset_ = null_bitmap_offset;
+}
+
+void ZoneMap::clear()
+{
+  lock_guard<mutex> guard(lock_);
+  zones_.clear();
+  modified_pages_.clear();
+}
+
+int ZoneMap::column_of(int field_index) const
+{
+  for (size_t i = 0; i < columns_.size(); i++) {
+    if (columns_[i].field_index == field_index) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+bool ZoneMap::has_column(int field_index) const { return column_of(field_index) >= 0; }
+
+void ZoneMap::init_page(PageNum page_num)
+{
+  if (columns_.empty()) {
+    return;
+  }
+
+  lock_guard<mutex> guard(lock_);
+  zones_[page_num] = PageZone(columns_.size());
+  modified_pages_.erase(page_num);
+}
+
+void ZoneMap::update(PageNum page_num, const char *record)
+{
+  if (columns_.empty()) {
+    return;
+  }
+
+  lock_guard<mutex> guard(lock_);
+  auto iter = zones_.find(page_num);
+  if (iter == zones_.end()) {
+    modified_pages_.insert(page_num);
+    return;
+  }
+  add_record(iter->second, record);
+}
+
+void ZoneMap::touch(PageNum page_num)
+{
+  if (columns_.empty()) {
+    return;
+  }
+
+  lock_guard<mutex> guard(lock_);
+  if (zones_.count(page_num) == 0) {
+    modified_pages_.insert(page_num);
+  }
+}
+
+bool ZoneMap::need_build(PageNum page_num)
+{
+  if (columns_.empty()) {
+    return false;
+  }
+
+  lock_guard<mutex> guard(lock_);
+  return zones_.count(page_num) == 0 && modified_pages_.count(page_num) == 0;
+}
+
+void ZoneMap::build(PageNum page_num, PageZone &&zone)
+{
+  lock_guard<mutex> guard(lock_);
+  if (zones_.count(page_num) == 0 && modified_pages_.count(page_num) == 0) {
+    zones_.emplace(page_num, std::move(zone));
+  }
+}
+
+void ZoneMap::add_record(PageZone &zone, const char *record) const
+{
+  for (size_t i = 0; i < columns_.size(); i++) {
+    const ZoneColumn &column = columns_[i];
+    ColumnZone       &cz     = zone[i];
+    if (null_bitmap_offset_ >= 0 &&
+        (record[null_bitmap_offset_ + column.field_index / 8] & (1 << (column.field_index % 8))) != 0) {
+      cz.null_count++;
+      continue;
+    }
+
+    Value value(column.type, const_cast<char *>(record + column.offset));
+    if (!cz.has_value) {
+      cz.has_value = true;
+      cz.min       = value;
+      cz.max       = value;
+    } else if (value.compare(cz.min) < 0) {
+      cz.min = value;
+    } else if (value.compare(cz.max) > 0) {
+      cz.max = value;
+    }
+  }
+}
+
+bool ZoneMap::can_skip(PageNum page_num, const vector<ZoneFilter> &filters)
+{
+  if (columns_.empty() || filters.empty()) {
+    return false;
+  }
+
+  lock_guard<mutex> guard(lock_);
+  auto iter = zones_.find(page_num);
+  if (iter == zones_.end()) {
+    return false;
+  }
+
+  for (const ZoneFilter &filter : filters) {
+    if (can_skip(iter->second, filter)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ZoneMap::can_skip(const PageZone &zone, const ZoneFilter &filter) const
+{
+  const int column = column_of(filter.field_index);
+  if (column < 0) {
+    return false;
+  }
+
+  const ColumnZone &cz = zone[column];
+  if (filter.value.attr_type() == NULLS) {
+    switch (filter.op) {
+      case IS: return cz.null_count == 0;
+      case IS_NOT: return !cz.has_value;
+      default: return false;
+    }
+  }
+
+  if (!comparable(columns_[column].type, filter.value.attr_type())) {
+    return false;
+  }
+
+  if (!cz.has_value) {
+    // 这个字段在页面上都是 NULL 或者页面上没有记录，和非 NULL 值的比较都不成立
+    return filter.op != IS && filter.op != IS_NOT;
+  }
+
+  const int cmp_min = cz.min.compare(filter.value);
+  const int cmp_max = cz.max.compare(filter.value);
+  switch (filter.op) {
+    case EQUAL_TO: return cmp_min > 0 || cmp_max < 0;
+    case NOT_EQUAL: return cmp_min == 0 && cmp_max == 0;
+    case LESS_THAN: return cmp_min >= 0;
+    case LESS_EQUAL: return cmp_min > 0;
+    case GREAT_THAN: return cmp_max <= 0;
+    case GREAT_EQUAL: return cmp_max < 0;
+    default: return false;
+  }
+}
+
+int ZoneMap::zoned_page_num()
+{
+  lock_guard<mutex> guard(lock_);
+  return static_cast<int>(zones_.size());
+}
+
+int ZoneMap::prunable_page_num(const vector<ZoneFilter> &filters)
+{
+  if (columns_.empty() || filters.empty()) {
+    return 0;
+  }
+
+  lock_guard<mutex> guard(lock_);
+  int count = 0;
+  for (const auto &[page_num, zone] : zones_) {
+    for (const ZoneFilter &filter : filters) {
+      if (can_skip(zone, filter)) {
+        count++;
+        break;
+      }
+    }
+  }
+  return count;
+}
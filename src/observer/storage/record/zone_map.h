@@ -0,0 +1,142 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/types.h"
+#include "sql/parser/parse_defs.h"
+#include "sql/parser/value.h"
+
+/**
+ * @brief 区间信息中记录的一个字段
+ * @ingroup RecordManager
+ */
+struct ZoneColumn
+{
+  int      field_index;  ///< 字段在表中的下标，也是它在 NULL 位图中的位置
+  AttrType type;         ///< 只支持定长的 INTS、FLOATS 和 DATES
+  int      offset;       ///< 字段在记录中的偏移
+};
+
+/**
+ * @brief 可以用区间信息判断的过滤条件: 字段 op 常量
+ * @ingroup RecordManager
+ */
+struct ZoneFilter
+{
+  int    field_index;
+  CompOp op;
+  Value  value;  ///< 只有 IS 和 IS NOT 的常量是 NULL
+};
+
+/**
+ * @brief 一个页面上某个字段的区间信息
+ * @ingroup RecordManager
+ */
+struct ColumnZone
+{
+  bool  has_value  = false;  ///< 是否有不是 NULL 的值，没有时 min/max 无效
+  Value min;
+  Value max;
+  int   null_count = 0;
+};
+
+/**
+ * @brief 记录文件每个页面上各个字段的最小值、最大值和 NULL 的个数(zone map)
+ * @ingroup RecordManager
+ * @details 扫描时根据下推的比较条件跳过不可能有满足条件的记录的页面。
+ * 区间信息只放在内存中，不持久化，页面的区间只会扩大不会缩小：
+ * 插入和修改记录时扩大对应页面的区间，删除记录时不修改。这样页面上出现过的值都在区间里，
+ * 也包括了被更新之后保存在版本链中的旧版本，跳过页面时不会漏掉对某个事务可见的旧版本。
+ *
+ * 新分配的页面从空的区间开始维护。打开文件时已经存在的页面没有区间信息，第一次被扫描时根据页面上的记录构建，
+ * 但如果页面在此之前已经被修改过，版本链中可能有页面上已经看不到的旧值，这种页面不再构建区间，扫描时不跳过。
+ */
+class ZoneMap
+{
+public:
+  using PageZone = std::vector<ColumnZone>;
+
+public:
+  ZoneMap() = default;
+  ~ZoneMap() = default;
+
+  /**
+   * @brief 初始化需要维护区间的字段
+   * @param null_bitmap_offset 记录中 NULL 位图的位置，没有位图时为 -1
+   */
+  void init(const std::vector<ZoneColumn> &columns, int null_bitmap_offset);
+  void clear();
+
+  bool empty() const { return columns_.empty(); }
+
+  /**
+   * @brief 字段是否维护了区间信息
+   */
+  bool has_column(int field_index) const;
+
+  /**
+   * @brief 新分配了一个页面，从空的区间开始维护
+   */
+  void init_page(PageNum page_num);
+
+  /**
+   * @brief 页面上插入或修改了一条记录，扩大页面的区间
+   * @details 需要持有页面的写锁。页面还没有区间信息时，记录页面被修改过，以后不再构建区间
+   */
+  void update(PageNum page_num, const char *record);
+
+  /**
+   * @brief 页面被修改了，但是没有新的值，比如删除记录
+   */
+  void touch(PageNum page_num);
+
+  /**
+   * @brief 页面是否需要构建区间信息
+   * @details 需要持有页面的锁，然后用 add_record 把页面上所有的记录都加到 new_zone 返回的区间中，再调用 build
+   */
+  bool need_build(PageNum page_num);
+
+  PageZone new_zone() const { return PageZone(columns_.size()); }
+  void     add_record(PageZone &zone, const char *record) const;
+
+  /**
+   * @brief 设置根据页面上所有记录构建的区间
+   */
+  void build(PageNum page_num, PageZone &&zone);
+
+  /**
+   * @brief 根据过滤条件判断能否跳过这个页面
+   * @return 页面上一定没有满足所有条件的记录时返回 true，没有区间信息时返回 false
+   */
+  bool can_skip(PageNum page_num, const std::vector<ZoneFilter> &filters);
+
+  /**
+   * @brief 有区间信息的页面个数，以及其中根据过滤条件可以跳过的页面个数
+   */
+  int zoned_page_num();
+  int prunable_page_num(const std::vector<ZoneFilter> &filters);
+
+private:
+  bool can_skip(const PageZone &zone, const ZoneFilter &filter) const;
+  int  column_of(int field_index) const;
+
+private:
+  std::mutex                            lock_;  ///< 并行扫描的多个线程会同时构建区间，所以总是真正加锁
+  std::vector<ZoneColumn>               columns_;
+  int                                   null_bitmap_offset_ = -1;
+  std::unordered_map<PageNum, PageZone> zones_;
+  std::unordered_set<PageNum>           modified_pages_;  ///< 没有区间信息时被修改过的页面，不能再构建区间
+};
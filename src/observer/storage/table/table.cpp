@@ -23,10 +23,12 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/string.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/record/record_manager.h"
+#include "storage/record/overflow_file_handler.h"
 #include "storage/common/condition_filter.h"
 #include "storage/common/meta_util.h"
 #include "storage/index/index.h"
 #include "storage/index/bplus_tree_index.h"
+#include "storage/index/bplus_tree_log.h"
 #include "storage/trx/trx.h"
 #include "storage/persist/persist.h"
 
@@ -42,6 +44,16 @@ Table::~Table()
     data_buffer_pool_ = nullptr;
   }
 
+  if (text_handler_ != nullptr) {
+    delete text_handler_;
+    text_handler_ = nullptr;
+  }
+
+  if (text_buffer_pool_ != nullptr) {
+    text_buffer_pool_->close_file();
+    text_buffer_pool_ = nullptr;
+  }
+
   for (std::vector<Index *>::iterator it = indexes_.begin(); it != indexes_.end(); ++it) {
     Index *index = *it;
     delete index;
@@ -56,7 +68,9 @@ RC Table::create(int32_t table_id,
                  const char *name, 
                  const char *base_dir, 
                  int attribute_count, 
-                 const AttrInfoSqlNode attributes[])
+                 const AttrInfoSqlNode attributes[],
+                 StorageFormat storage_format /*=ROW*/,
+                 PageCompression page_compression /*=NONE*/)
 {
   if (table_id < 0) {
     LOG_WARN("invalid table id. table_id=%d, table_name=%s", table_id, name);
@@ -91,7 +105,7 @@ RC Table::create(int32_t table_id,
   close(fd);
 
   // 创建文件
-  if ((rc = table_meta_.init(table_id, name, attribute_count, attributes)) != RC::SUCCESS) {
+  if ((rc = table_meta_.init(table_id, name, attribute_count, attributes, storage_format, page_compression)) != RC::SUCCESS) {
     LOG_ERROR("Failed to init table meta. name:%s, ret:%d", name, rc);
     return rc;  // delete table file
   }
@@ -115,6 +129,15 @@ RC Table::create(int32_t table_id,
     return rc;
   }
 
+  if (table_meta_.has_text_field()) {
+    std::string text_file = table_text_data_file(base_dir, name);
+    rc = bpm.create_file(text_file.c_str());
+    if (rc != RC::SUCCESS) {
+      LOG_ERROR("Failed to create disk buffer pool of text data file. file name=%s", text_file.c_str());
+      return rc;
+    }
+  }
+
   rc = init_record_handler(base_dir);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Failed to create table %s due to init record handler failed.", data_file.c_str());
@@ -207,6 +230,15 @@ RC Table::destroy(const char* dir) {
       return rc;
     }
 
+    //删除TEXT溢出页
+    if (text_buffer_pool_ != nullptr) {
+      std::string text_file = table_text_data_file(dir, name());
+      rc = persistHandler.remove_file(text_file.c_str());
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+    }
+
     //删除Index
     for (auto index : indexes_) {
       std::string index_file = table_index_file(dir, name(), index->index_meta().name());
@@ -223,6 +255,15 @@ RC Table::destroy(const char* dir) {
 
     record_handler_->close();
 
+    if (text_buffer_pool_ != nullptr) {
+      text_handler_->close();
+      rc = text_buffer_pool_->close_file();
+      text_buffer_pool_ = nullptr;
+      if (rc != RC::SUCCESS) {
+        return rc;
+      }
+    }
+
     return RC::SUCCESS;
 }
 
@@ -230,14 +271,20 @@ RC Table::destroy(const char* dir) {
 RC Table::insert_record(Record &record)
 {
   RC rc = RC::SUCCESS;
-  rc = record_handler_->insert_record(record.data(), table_meta_.record_size(), &record.rid());
+  rc = record_handler_->insert_record(record.data(), record.len(), &record.rid());
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Insert record failed. table name=%s, rc=%s", table_meta_.name(), strrc(rc));
+    std::vector<PageNum> texts;
+    collect_texts(record.data(), nullptr, texts);
+    remove_texts(texts);
     return rc;
   }
 
-  rc = insert_entry_of_indexes(record.data(), record.rid());
+  rc = insert_entry_of_indexes(indexes_, record.data(), record.rid());
   if (rc != RC::SUCCESS) {
+    std::vector<PageNum> texts;
+    collect_texts(record.data(), nullptr, texts);
+    remove_texts(texts);
     if (rc == RC::RECORD_DUPLICATE_KEY) {
       RC rc2 = record_handler_->delete_record(&record.rid());
       if (rc2 != RC::SUCCESS) {
@@ -246,7 +293,7 @@ RC Table::insert_record(Record &record)
       }
       return rc;
     } else {
-      RC rc2 = delete_entry_of_indexes(record.data(), record.rid(), false/*error_on_not_exists*/);
+      RC rc2 = delete_entry_of_indexes(indexes_, record.data(), record.rid(), false/*error_on_not_exists*/);
       if (rc2 != RC::SUCCESS) {
         LOG_ERROR("Failed to rollback index data when insert index entries failed. table name=%s, rc=%d:%s",
                   name(), rc2, strrc(rc2));
@@ -268,12 +315,14 @@ RC Table::visit_record(const RID &rid, bool readonly, std::function<void(Record
 
 RC Table::get_record(const RID &rid, Record &record)
 {
-  const int record_size = table_meta_.record_size();
-  char *record_data = (char *)malloc(record_size);
-  ASSERT(nullptr != record_data, "failed to malloc memory. record data size=%d", record_size);
-
-  auto copier = [&record, record_data, record_size](Record &record_src) {
-    memcpy(record_data, record_src.data(), record_size);
+  char *record_data = nullptr;
+  int   record_len  = 0;
+
+  auto copier = [&record, &record_data, &record_len](Record &record_src) {
+    record_len  = record_src.len();
+    record_data = (char *)malloc(record_len);
+    ASSERT(nullptr != record_data, "failed to malloc memory. record data size=%d", record_len);
+    memcpy(record_data, record_src.data(), record_len);
     record.set_rid(record_src.rid());
   };
   RC rc = record_handler_->visit_record(rid, true/*readonly*/, copier);
@@ -283,33 +332,85 @@ RC Table::get_record(const RID &rid, Record &record)
     return rc;
   }
 
-  record.set_data_owner(record_data, record_size);
+  record.set_data_owner(record_data, record_len);
   return rc;
 }
 
 RC Table::recover_insert_record(Record &record)
 {
   RC rc = RC::SUCCESS;
-  rc = record_handler_->recover_insert_record(record.data(), table_meta_.record_size(), record.rid());
+  rc = record_handler_->recover_insert_record(record.data(), record.len(), record.rid());
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Insert record failed. table name=%s, rc=%s", table_meta_.name(), strrc(rc));
     return rc;
   }
 
-  rc = insert_entry_of_indexes(record.data(), record.rid());
-  if (rc != RC::SUCCESS) { // 可能出现了键值重复
-    RC rc2 = delete_entry_of_indexes(record.data(), record.rid(), false/*error_on_not_exists*/);
-    if (rc2 != RC::SUCCESS) {
-      LOG_ERROR("Failed to rollback index data when insert index entries failed. table name=%s, rc=%d:%s",
-                name(), rc2, strrc(rc2));
+  // 索引的修改在插入记录日志之前就已经写入日志了，由索引日志自己重做，这里不需要再插入索引
+  return rc;
+}
+
+RC Table::recover_delete_record(const Record &record)
+{
+  RC rc = RC::SUCCESS;
+  for (Index *index : indexes_) {
+    rc = index->delete_entry(record.data(), &record.rid());
+    if (rc != RC::SUCCESS && rc != RC::RECORD_NOT_EXIST) {
+      LOG_WARN("failed to delete entry from index while recovering. table name=%s, index name=%s, rid=%s, rc=%s",
+               name(), index->index_meta().name(), record.rid().to_string().c_str(), strrc(rc));
+      return rc;
     }
-    rc2 = record_handler_->delete_record(&record.rid());
-    if (rc2 != RC::SUCCESS) {
-      LOG_PANIC("Failed to rollback record data when insert index entries failed. table name=%s, rc=%d:%s",
-                name(), rc2, strrc(rc2));
+  }
+
+  // 溢出页不记录日志，恢复时不知道崩溃前是否已经释放过，这里不释放
+  return record_handler_->delete_record(&record.rid());
+}
+
+RC Table::recover_update_record(Record &record, const char *new_data)
+{
+  RC rc = RC::SUCCESS;
+  for (Index *index : indexes_) {
+    rc = index->delete_entry(record.data(), &record.rid());
+    if (rc != RC::SUCCESS && rc != RC::RECORD_NOT_EXIST) {
+      LOG_WARN("failed to delete entry from index while recovering. table name=%s, index name=%s, rid=%s, rc=%s",
+               name(), index->index_meta().name(), record.rid().to_string().c_str(), strrc(rc));
+      return rc;
+    }
+
+    rc = index->insert_entry(new_data, &record.rid());
+    if (rc != RC::SUCCESS && rc != RC::RECORD_DUPLICATE_KEY) {
+      LOG_WARN("failed to insert entry into index while recovering. table name=%s, index name=%s, rid=%s, rc=%s",
+               name(), index->index_meta().name(), record.rid().to_string().c_str(), strrc(rc));
+      return rc;
     }
   }
-  return rc;
+
+  return record_handler_->update_record(record.rid(), new_data, table_meta_.record_len(new_data));
+}
+
+void Table::set_log_manager(CLogManager *log_manager)
+{
+  log_manager_ = log_manager;
+  for (size_t i = 0; i < indexes_.size(); i++) {
+    indexes_[i]->set_log_manager(log_manager, static_cast<int32_t>(i));
+  }
+}
+
+RC Table::redo_index(LSN lsn, const char *data, int len)
+{
+  BplusTreeLogHeader log_header;
+  if (len < static_cast<int>(sizeof(log_header))) {
+    LOG_WARN("invalid index log. table=%s, len=%d", name(), len);
+    return RC::INTERNAL;
+  }
+
+  memcpy(&log_header, data, sizeof(log_header));
+  if (log_header.index_id_ < 0 || log_header.index_id_ >= static_cast<int32_t>(indexes_.size())) {
+    // 创建索引的过程中出现了异常，索引没有保存下来
+    LOG_WARN("no such index to redo. table=%s, index id=%d", name(), log_header.index_id_);
+    return RC::SUCCESS;
+  }
+
+  return indexes_[log_header.index_id_]->redo(lsn, data + sizeof(log_header), len - static_cast<int>(sizeof(log_header)));
 }
 
 const char *Table::name() const
@@ -334,20 +435,59 @@ RC Table::make_record(int value_num, const Value *values, Record &record)
   for (int i = 0; i < value_num; i++) {
     const FieldMeta *field = table_meta_.field(i + normal_field_start_index);
     const Value &value = values[i];
-    if (field->type() != value.attr_type() && !(value.attr_type()==NULLS && field->nullable())) {
+    if (field->value_type() != value.attr_type() && !(value.attr_type()==NULLS && field->nullable())) {
       LOG_ERROR("Invalid value type. table name =%s, field name=%s, type=%d, but given=%d",
       table_meta_.name(), field->name(), field->type(), value.attr_type());
       return RC::SCHEMA_FIELD_TYPE_MISMATCH;
     }
+    if (value.attr_type() == NULLS && table_meta_.null_bitmap_len() <= 0) {
+      LOG_WARN("table has no null bitmap, it may be created by an old version. table name=%s, field name=%s",
+               table_meta_.name(), field->name());
+      return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+    }
   }
 
-  // 复制所有字段的值
+  // 复制所有字段的值，VARCHAR 字段的数据依次放在定长部分的后面，TEXT 字段的数据写入溢出页
   int record_size = table_meta_.record_size();
+  for (int i = 0; i < value_num; i++) {
+    const FieldMeta *field = table_meta_.field(i + normal_field_start_index);
+    if (field->type() == VARCHARS && values[i].attr_type() != NULLS) {
+      record_size += std::min(values[i].length(), field->len());
+    }
+  }
+
   char *record_data = (char *)malloc(record_size);
+  memset(record_data, 0, record_size);
 
+  int varchar_offset = table_meta_.record_size();
   for (int i = 0; i < value_num; i++) {
     const FieldMeta *field = table_meta_.field(i + normal_field_start_index);
     const Value &value = values[i];
+    if (value.attr_type() == NULLS) {
+      // NULL 只记录在位图中，字段本身保持全0
+      table_meta_.set_null(record_data, i + normal_field_start_index, true);
+      continue;
+    }
+    if (field->type() == VARCHARS) {
+      const VarcharRef ref{static_cast<uint16_t>(varchar_offset), static_cast<uint16_t>(std::min(value.length(), field->len()))};
+      memcpy(record_data + field->offset(), &ref, sizeof(ref));
+      memcpy(record_data + ref.offset, value.data(), ref.len);
+      varchar_offset += ref.len;
+      continue;
+    }
+    if (field->type() == TEXTS) {
+      TextRef ref;
+      RC rc = write_text(value, ref);
+      if (rc != RC::SUCCESS) {
+        std::vector<PageNum> texts;
+        collect_texts(record_data, nullptr, texts);
+        remove_texts(texts);
+        free(record_data);
+        return rc;
+      }
+      memcpy(record_data + field->offset(), &ref, sizeof(ref));
+      continue;
+    }
     size_t copy_len = field->len();
     if (field->type() == CHARS) {
       const size_t data_len = value.length();
@@ -362,6 +502,124 @@ RC Table::make_record(int value_num, const Value *values, Record &record)
   return RC::SUCCESS;
 }
 
+RC Table::make_record(const Record &old_record, const FieldMeta *field, const Value &value, std::vector<char> &new_data)
+{
+  new_data.assign(old_record.data(), old_record.data() + table_meta_.record_size());
+  memset(new_data.data() + field->offset(), 0, field->inline_len());
+  if (field->type() == TEXTS && value.attr_type() != NULLS) {
+    // 写入新的溢出页链表，旧的链表在没有版本引用之后再释放
+    TextRef ref;
+    RC rc = write_text(value, ref);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    memcpy(new_data.data() + field->offset(), &ref, sizeof(ref));
+  } else if (field->type() != VARCHARS && value.attr_type() != NULLS) {
+    const int copy_len = std::min(value.length(), field->len());
+    memcpy(new_data.data() + field->offset(), value.data(), copy_len);
+  }
+
+  if (table_meta_.variable_length()) {
+    // 重新排列所有 VARCHAR 字段的数据，旧数据留下的空洞就不会保留下来
+    for (const FieldMeta &field_meta : *table_meta_.field_metas()) {
+      if (field_meta.type() != VARCHARS) {
+        continue;
+      }
+
+      const char *data = nullptr;
+      int         len  = 0;
+      if (&field_meta == field) {
+        if (value.attr_type() == NULLS) {
+          continue;
+        }
+        data = value.data();
+        len  = std::min(value.length(), field->len());
+      } else {
+        VarcharRef old_ref;
+        memcpy(&old_ref, old_record.data() + field_meta.offset(), sizeof(old_ref));
+        data = old_record.data() + old_ref.offset;
+        len  = old_ref.len;
+      }
+
+      const VarcharRef ref{static_cast<uint16_t>(new_data.size()), static_cast<uint16_t>(len)};
+      memcpy(new_data.data() + field_meta.offset(), &ref, sizeof(ref));
+      new_data.insert(new_data.end(), data, data + len);
+    }
+  }
+
+  if (table_meta_.null_bitmap_len() > 0) {
+    const int field_index = static_cast<int>(field - table_meta_.field(0));
+    table_meta_.set_null(new_data.data(), field_index, value.attr_type() == NULLS);
+  }
+  return RC::SUCCESS;
+}
+
+RC Table::write_text(const Value &value, TextRef &ref)
+{
+  if (value.length() > TextRef::MAX_LEN) {
+    LOG_WARN("text is too long. table=%s, len=%d, max=%d", name(), value.length(), TextRef::MAX_LEN);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  ref.len = value.length();
+  RC rc = text_handler_->insert(value.data(), ref.len, ref.first_page);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to write text into overflow pages. table=%s, len=%d, rc=%s", name(), ref.len, strrc(rc));
+  }
+  return rc;
+}
+
+RC Table::read_text(const TextRef &ref, std::string &text) const
+{
+  if (ref.len <= 0) {
+    text.clear();
+    return RC::SUCCESS;
+  }
+  return text_handler_->read(ref.first_page, ref.len, text);
+}
+
+void Table::collect_texts(const char *old_record, const char *new_record, std::vector<PageNum> &first_pages) const
+{
+  if (!table_meta_.has_text_field()) {
+    return;
+  }
+
+  for (const FieldMeta &field : *table_meta_.field_metas()) {
+    if (field.type() != TEXTS) {
+      continue;
+    }
+
+    // NULL 和空字符串的 TextRef 中 len 为0，没有溢出页
+    TextRef old_ref;
+    memcpy(&old_ref, old_record + field.offset(), sizeof(old_ref));
+    if (old_ref.len <= 0) {
+      continue;
+    }
+    if (new_record != nullptr) {
+      TextRef new_ref;
+      memcpy(&new_ref, new_record + field.offset(), sizeof(new_ref));
+      if (new_ref.len > 0 && new_ref.first_page == old_ref.first_page) {
+        continue;
+      }
+    }
+    first_pages.push_back(old_ref.first_page);
+  }
+}
+
+void Table::remove_texts(std::vector<PageNum> &first_pages)
+{
+  std::sort(first_pages.begin(), first_pages.end());
+  first_pages.erase(std::unique(first_pages.begin(), first_pages.end()), first_pages.end());
+  for (PageNum first_page : first_pages) {
+    RC rc = text_handler_->remove(first_page);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to remove overflow pages of text. table=%s, first page=%d, rc=%s",
+               name(), first_page, strrc(rc));
+    }
+  }
+  first_pages.clear();
+}
+
 RC Table::init_record_handler(const char *base_dir)
 {
   std::string data_file = table_data_file(base_dir, table_meta_.name());
@@ -371,9 +629,23 @@ RC Table::init_record_handler(const char *base_dir)
     LOG_ERROR("Failed to open disk buffer pool for file:%s. rc=%d:%s", data_file.c_str(), rc, strrc(rc));
     return rc;
   }
+  data_buffer_pool_->set_page_compression(table_meta_.page_compression() != PageCompression::NONE);
 
   record_handler_ = new RecordFileHandler();
-  rc = record_handler_->init(data_buffer_pool_);
+  if (table_meta_.storage_format() == StorageFormat::COLUMNAR) {
+    // 每个字段是一列，NULL 位图也作为单独的一列，下标与 get_record_scanner 中的投影一致
+    std::vector<PaxColumn> columns;
+    for (const FieldMeta &field : *table_meta_.field_metas()) {
+      columns.push_back(PaxColumn{field.offset(), field.inline_len(), 0});
+    }
+    if (table_meta_.null_bitmap_len() > 0) {
+      columns.push_back(PaxColumn{table_meta_.null_bitmap_offset(), table_meta_.null_bitmap_len(), 0});
+    }
+    rc = record_handler_->init(data_buffer_pool_, RecordPageFormat::PAX, columns);
+  } else {
+    rc = record_handler_->init(data_buffer_pool_,
+                               table_meta_.variable_length() ? RecordPageFormat::SLOTTED : RecordPageFormat::FIXED);
+  }
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Failed to init record handler. rc=%s", strrc(rc));
     data_buffer_pool_->close_file();
@@ -383,11 +655,78 @@ RC Table::init_record_handler(const char *base_dir)
     return rc;
   }
 
+  // 定长的数值字段维护页面的区间信息，扫描时用来跳过页面
+  std::vector<ZoneColumn>       zone_columns;
+  const std::vector<FieldMeta> &field_metas = *table_meta_.field_metas();
+  for (int i = table_meta_.sys_field_num(); i < static_cast<int>(field_metas.size()); i++) {
+    const AttrType type = field_metas[i].type();
+    if (type == INTS || type == FLOATS || type == DATES) {
+      zone_columns.push_back(ZoneColumn{i, type, field_metas[i].offset()});
+    }
+  }
+  record_handler_->zone_map().init(
+      zone_columns, table_meta_.null_bitmap_len() > 0 ? table_meta_.null_bitmap_offset() : -1);
+
+  if (!table_meta_.has_text_field()) {
+    return rc;
+  }
+
+  std::string text_file = table_text_data_file(base_dir, table_meta_.name());
+  rc = BufferPoolManager::instance().open_file(text_file.c_str(), text_buffer_pool_);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to open disk buffer pool for file:%s. rc=%d:%s", text_file.c_str(), rc, strrc(rc));
+    return rc;
+  }
+  text_buffer_pool_->set_page_compression(table_meta_.page_compression() != PageCompression::NONE);
+
+  text_handler_ = new OverflowFileHandler();
+  rc = text_handler_->init(text_buffer_pool_);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to init overflow file handler. rc=%s", strrc(rc));
+  }
   return rc;
 }
 
 RC Table::get_record_scanner(RecordFileScanner &scanner, Trx *trx, bool readonly)
 {
+  scanner.set_projection(std::vector<int>());
+  scanner.set_zone_map(&record_handler_->zone_map());
+  RC rc = scanner.open_scan(this, *data_buffer_pool_, trx, readonly, nullptr);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("failed to open scanner. rc=%s", strrc(rc));
+  }
+  return rc;
+}
+
+RC Table::get_record_scanner(
+    RecordFileScanner &scanner, Trx *trx, bool readonly, const std::vector<const FieldMeta *> &fields)
+{
+  if (table_meta_.storage_format() != StorageFormat::COLUMNAR) {
+    return get_record_scanner(scanner, trx, readonly);
+  }
+
+  // 事务需要系统字段判断可见性，读取字段时需要 NULL 位图
+  const std::vector<FieldMeta> &field_metas = *table_meta_.field_metas();
+  std::vector<int> columns;
+  for (int i = 0; i < table_meta_.sys_field_num(); i++) {
+    columns.push_back(i);
+  }
+  for (const FieldMeta *field : fields) {
+    for (size_t i = 0; i < field_metas.size(); i++) {
+      if (0 == strcmp(field_metas[i].name(), field->name())) {
+        columns.push_back(static_cast<int>(i));
+        break;
+      }
+    }
+  }
+  if (table_meta_.null_bitmap_len() > 0) {
+    columns.push_back(static_cast<int>(field_metas.size()));
+  }
+  std::sort(columns.begin(), columns.end());
+  columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+
+  scanner.set_projection(columns);
+  scanner.set_zone_map(&record_handler_->zone_map());
   RC rc = scanner.open_scan(this, *data_buffer_pool_, trx, readonly, nullptr);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("failed to open scanner. rc=%s", strrc(rc));
@@ -402,6 +741,11 @@ RC Table::create_index(Trx *trx, const FieldMeta *field_meta, const char *index_
     return RC::INVALID_ARGUMENT;
   }
 
+  if (field_meta->type() == VARCHARS || field_meta->type() == TEXTS) {
+    LOG_WARN("cannot create index on variable length field. table=%s, field=%s", name(), field_meta->name());
+    return RC::INVALID_ARGUMENT;
+  }
+
   IndexMeta new_index_meta;
   RC rc = new_index_meta.init(index_name, *field_meta,unique);
   if (rc != RC::SUCCESS) {
@@ -425,9 +769,15 @@ RC Table::create_index(Trx *trx, const FieldMeta *field_meta, const char *index_
     return rc;
   }
 
+  // 插入已有数据之前就要开始记录日志，新的索引放在最后
+  if (log_manager_ != nullptr) {
+    index->set_log_manager(log_manager_, static_cast<int32_t>(indexes_.size()));
+  }
+
   // 遍历当前的所有数据，插入这个索引
+  // 索引要包含页面上所有的记录，其它事务可能还会访问已经删除或者没有提交的记录，所以不按照事务的可见性过滤
   RecordFileScanner scanner;
-  rc = get_record_scanner(scanner, trx, true/*readonly*/);
+  rc = get_record_scanner(scanner, nullptr /*trx*/, true/*readonly*/);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to create scanner while creating index. table=%s, index=%s, rc=%s", 
              name(), index_name, strrc(rc));
@@ -439,7 +789,7 @@ RC Table::create_index(Trx *trx, const FieldMeta *field_meta, const char *index_
   Record record;
   while (scanner.has_next()) {
     rc = scanner.next(record);
-    if (rc != RC::SUCCESS) {
+      if (rc != RC::SUCCESS) {
       LOG_WARN("failed to scan records while creating index. table=%s, index=%s, rc=%s",
                name(), index_name, strrc(rc));
       index->close();
@@ -511,14 +861,77 @@ RC Table::delete_record(const Record &record)
            "failed to delete entry from index. table name=%s, index name=%s, rid=%s, rc=%s",
            name(), index->index_meta().name(), record.rid().to_string().c_str(), strrc(rc));
   }
+
+  // record 可能直接引用了页面中的数据，删除之前先收集溢出页
+  std::vector<PageNum> texts;
+  collect_texts(record.data(), nullptr, texts);
   rc = record_handler_->delete_record(&record.rid());
+  if (rc == RC::SUCCESS) {
+    remove_texts(texts);
+  }
   return rc;
 }
 
-RC Table::insert_entry_of_indexes(const char *record, const RID &rid)
+RC Table::update_record(Record &record, const char *new_data)
 {
-  RC rc = RC::SUCCESS;
+  // 只修改了不在索引中的字段时，索引不需要任何修改
+  std::vector<Index *> changed_indexes;
   for (Index *index : indexes_) {
+    if (index->key_changed(record.data(), new_data)) {
+      changed_indexes.push_back(index);
+    }
+  }
+
+  RC rc = delete_entry_of_indexes(changed_indexes, record.data(), record.rid(), true/*error_on_not_exists*/);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to delete old index entries while updating. table name=%s, rid=%s, rc=%s",
+             name(), record.rid().to_string().c_str(), strrc(rc));
+    return rc;
+  }
+
+  rc = insert_entry_of_indexes(changed_indexes, new_data, record.rid());
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to insert new index entries while updating. table name=%s, rid=%s, rc=%s",
+             name(), record.rid().to_string().c_str(), strrc(rc));
+    RC rc2 = delete_entry_of_indexes(changed_indexes, new_data, record.rid(), false/*error_on_not_exists*/);
+    if (rc2 != RC::SUCCESS) {
+      LOG_ERROR("Failed to rollback index data when update index entries failed. table name=%s, rc=%d:%s",
+                name(), rc2, strrc(rc2));
+    }
+    rc2 = insert_entry_of_indexes(changed_indexes, record.data(), record.rid());
+    if (rc2 != RC::SUCCESS) {
+      LOG_PANIC("Failed to restore index data when update index entries failed. table name=%s, rc=%d:%s",
+                name(), rc2, strrc(rc2));
+    }
+    return rc;
+  }
+
+  // 变长的记录可能会在页面内移动，这里要先保存旧数据，失败时恢复索引
+  std::vector<char> old_data;
+  if (!changed_indexes.empty()) {
+    old_data.assign(record.data(), record.data() + table_meta_.record_len(record.data()));
+  }
+  rc = record_handler_->update_record(record.rid(), new_data, table_meta_.record_len(new_data));
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to update record data. table name=%s, rid=%s, rc=%s",
+             name(), record.rid().to_string().c_str(), strrc(rc));
+    RC rc2 = delete_entry_of_indexes(changed_indexes, new_data, record.rid(), false/*error_on_not_exists*/);
+    if (rc2 == RC::SUCCESS) {
+      rc2 = insert_entry_of_indexes(changed_indexes, old_data.data(), record.rid());
+    }
+    if (rc2 != RC::SUCCESS) {
+      LOG_PANIC("Failed to restore index data when update record failed. table name=%s, rc=%d:%s",
+                name(), rc2, strrc(rc2));
+    }
+    return rc;
+  }
+  return RC::SUCCESS;
+}
+
+RC Table::insert_entry_of_indexes(const std::vector<Index *> &indexes, const char *record, const RID &rid)
+{
+  RC rc = RC::SUCCESS;
+  for (Index *index : indexes) {
     rc = index->insert_entry(record, &rid);
     if (rc != RC::SUCCESS) {
       break;
@@ -527,10 +940,11 @@ RC Table::insert_entry_of_indexes(const char *record, const RID &rid)
   return rc;
 }
 
-RC Table::delete_entry_of_indexes(const char *record, const RID &rid, bool error_on_not_exists)
+RC Table::delete_entry_of_indexes(
+    const std::vector<Index *> &indexes, const char *record, const RID &rid, bool error_on_not_exists)
 {
   RC rc = RC::SUCCESS;
-  for (Index *index : indexes_) {
+  for (Index *index : indexes) {
     rc = index->delete_entry(record, &rid);
     if (rc != RC::SUCCESS) {
       if (rc != RC::RECORD_INVALID_KEY || !error_on_not_exists) {
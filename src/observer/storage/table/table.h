@@ -15,12 +15,16 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include <functional>
+#include <string>
+#include <vector>
+#include "common/types.h"
 #include "storage/table/table_meta.h"
 
 struct RID;
 class Record;
 class DiskBufferPool;
 class RecordFileHandler;
+class OverflowFileHandler;
 class RecordFileScanner;
 class ConditionFilter;
 class DefaultConditionFilter;
@@ -28,6 +32,7 @@ class Index;
 class IndexScanner;
 class RecordDeleter;
 class Trx;
+class CLogManager;
 
 /**
  * @brief 表
@@ -46,13 +51,17 @@ public:
    * @param base_dir 表数据存放的路径
    * @param attribute_count 字段个数
    * @param attributes 字段
+   * @param storage_format 数据的存放方式，列存的表使用 PAX 格式的页面
+   * @param page_compression 数据页面写到磁盘时的压缩方式
    */
   RC create(int32_t table_id, 
             const char *path, 
             const char *name, 
             const char *base_dir, 
             int attribute_count, 
-            const AttrInfoSqlNode attributes[]);
+            const AttrInfoSqlNode attributes[],
+            StorageFormat storage_format = StorageFormat::ROW,
+            PageCompression page_compression = PageCompression::NONE);
 
   /**
    * 打开一个表
@@ -76,6 +85,16 @@ public:
    */
   RC make_record(int value_num, const Value *values, Record &record);
 
+  /**
+   * @brief 修改记录中的一个字段，生成新的记录数据
+   * @details 变长记录中 VARCHAR 字段的数据位置会变化，需要重新组装整个记录
+   * @param old_record 原来的记录
+   * @param field      要修改的字段
+   * @param value      字段的新值
+   * @param new_data   生成的记录数据
+   */
+  RC make_record(const Record &old_record, const FieldMeta *field, const Value &value, std::vector<char> &new_data);
+
   /**
    * @brief 在当前的表中插入一条记录
    * @details 在表文件和索引中插入关联数据。这里只管在表中插入数据，不关心事务相关操作。
@@ -83,20 +102,88 @@ public:
    */
   RC insert_record(Record &record);
   RC delete_record(const Record &record);
+
+  /**
+   * @brief 原地更新一条记录，RID 不变
+   * @details 先修改索引，再把新的数据写入记录，只修改键发生了变化的索引。这里不关心事务相关操作。
+   * 调用者需要持有记录所在页面的写锁，record的数据直接指向页面上的内存。
+   * 变长记录变长时，记录可能在页面内移动，更新之后 record 的数据指针就失效了。
+   * @param record   要更新的记录
+   * @param new_data 新的记录数据，长度由 TableMeta::record_len 计算。不能指向页面上的内存
+   */
+  RC update_record(Record &record, const char *new_data);
   RC visit_record(const RID &rid, bool readonly, std::function<void(Record &)> visitor);
+
+  /**
+   * @brief 获取一条记录，记录数据会复制一份，由 record 管理
+   * @details 只是读取一下记录的话，可以用 visit_record 直接访问页面上的数据，不需要复制
+   */
   RC get_record(const RID &rid, Record &record);
 
+  /**
+   * @brief 重做日志时插入一条记录
+   * @details 只恢复记录数据，索引的修改有自己的日志，由 redo_index 来恢复
+   */
   RC recover_insert_record(Record &record);
 
+  /**
+   * @brief 恢复时回滚插入的记录
+   * @details 与 delete_record 不同，索引中可能没有这条记录对应的数据(索引日志没有落盘)
+   */
+  RC recover_delete_record(const Record &record);
+
+  /**
+   * @brief 恢复时回滚更新的记录
+   * @details 与 update_record 不同，索引可能已经通过索引日志恢复到了任意一个中间状态
+   */
+  RC recover_update_record(Record &record, const char *new_data);
+
+  /**
+   * @brief 设置日志管理器，表上所有索引的修改都会记录日志
+   */
+  void set_log_manager(CLogManager *log_manager);
+
+  /**
+   * @brief 重做一条索引日志
+   * @param data 日志数据，以 BplusTreeLogHeader 开头
+   */
+  RC redo_index(LSN lsn, const char *data, int len);
+
   RC create_index(Trx *trx, const FieldMeta *field_meta, const char *index_name,bool unique);
 
   RC get_record_scanner(RecordFileScanner &scanner, Trx *trx, bool readonly);
 
+  /**
+   * @brief 打开一个只需要部分字段的扫描
+   * @details 列存的表只读取这些字段，扫描出来的记录中其它字段的数据是无效的。行存的表与上面的接口相同
+   * @param fields 需要读取的字段，系统字段总是会读取
+   */
+  RC get_record_scanner(
+      RecordFileScanner &scanner, Trx *trx, bool readonly, const std::vector<const FieldMeta *> &fields);
+
   RecordFileHandler *record_handler() const
   {
     return record_handler_;
   }
 
+  DiskBufferPool *data_buffer_pool() const { return data_buffer_pool_; }
+
+  /**
+   * @brief 读取 TEXT 字段保存在溢出页中的数据
+   */
+  RC read_text(const TextRef &ref, std::string &text) const;
+
+  /**
+   * @brief 收集 old_record 中引用了，但是 new_record 中没有引用的 TEXT 溢出页链表
+   * @details new_record 为空时收集 old_record 引用的所有链表。用来在记录或者版本不再需要时释放溢出页
+   */
+  void collect_texts(const char *old_record, const char *new_record, std::vector<PageNum> &first_pages) const;
+
+  /**
+   * @brief 释放 collect_texts 收集的溢出页链表，重复的链表只释放一次
+   */
+  void remove_texts(std::vector<PageNum> &first_pages);
+
 public:
   int32_t table_id() const { return table_meta_.table_id(); }
   const char *name() const;
@@ -106,11 +193,13 @@ public:
   RC sync();
 
 private:
-  RC insert_entry_of_indexes(const char *record, const RID &rid);
-  RC delete_entry_of_indexes(const char *record, const RID &rid, bool error_on_not_exists);
+  RC insert_entry_of_indexes(const std::vector<Index *> &indexes, const char *record, const RID &rid);
+  RC delete_entry_of_indexes(
+      const std::vector<Index *> &indexes, const char *record, const RID &rid, bool error_on_not_exists);
 
 private:
   RC init_record_handler(const char *base_dir);
+  RC write_text(const Value &value, TextRef &ref);
 
 public:
   Index *find_index(const char *index_name) const;
@@ -121,5 +210,8 @@ private:
   TableMeta   table_meta_;
   DiskBufferPool *data_buffer_pool_ = nullptr;   /// 数据文件关联的buffer pool
   RecordFileHandler *record_handler_ = nullptr;  /// 记录操作
+  DiskBufferPool *text_buffer_pool_ = nullptr;   /// TEXT 溢出页文件关联的buffer pool，没有 TEXT 字段时为空
+  OverflowFileHandler *text_handler_ = nullptr;  /// TEXT 溢出页操作
   std::vector<Index *> indexes_;
+  CLogManager *log_manager_ = nullptr;
 };
@@ -18,6 +18,7 @@ See the Mulan PSL v2 for more details. */
 #include "storage/table/table_meta.h"
 #include "json/json.h"
 #include "common/log/log.h"
+#include "storage/record/record_manager.h"
 #include "storage/trx/trx.h"
 
 using namespace std;
@@ -26,13 +27,22 @@ static const Json::StaticString FIELD_TABLE_ID("table_id");
 static const Json::StaticString FIELD_TABLE_NAME("table_name");
 static const Json::StaticString FIELD_FIELDS("fields");
 static const Json::StaticString FIELD_INDEXES("indexes");
+static const Json::StaticString FIELD_NULL_BITMAP_LEN("null_bitmap_len");
+static const Json::StaticString FIELD_STORAGE_FORMAT("storage_format");
+static const Json::StaticString FIELD_PAGE_COMPRESSION("page_compression");
 
 TableMeta::TableMeta(const TableMeta &other)
     : table_id_(other.table_id_),
     name_(other.name_),
     fields_(other.fields_),
     indexes_(other.indexes_),
-    record_size_(other.record_size_)
+    record_size_(other.record_size_),
+    null_bitmap_offset_(other.null_bitmap_offset_),
+    null_bitmap_len_(other.null_bitmap_len_),
+    variable_length_(other.variable_length_),
+    has_text_field_(other.has_text_field_),
+    storage_format_(other.storage_format_),
+    page_compression_(other.page_compression_)
 {}
 
 void TableMeta::swap(TableMeta &other) noexcept
@@ -41,9 +51,16 @@ void TableMeta::swap(TableMeta &other) noexcept
   fields_.swap(other.fields_);
   indexes_.swap(other.indexes_);
   std::swap(record_size_, other.record_size_);
+  std::swap(null_bitmap_offset_, other.null_bitmap_offset_);
+  std::swap(null_bitmap_len_, other.null_bitmap_len_);
+  std::swap(variable_length_, other.variable_length_);
+  std::swap(has_text_field_, other.has_text_field_);
+  std::swap(storage_format_, other.storage_format_);
+  std::swap(page_compression_, other.page_compression_);
 }
 
-RC TableMeta::init(int32_t table_id, const char *name, int field_num, const AttrInfoSqlNode attributes[])
+RC TableMeta::init(int32_t table_id, const char *name, int field_num, const AttrInfoSqlNode attributes[],
+                   StorageFormat storage_format /*=ROW*/, PageCompression page_compression /*=NONE*/)
 {
   if (common::is_blank(name)) {
     LOG_ERROR("Name cannot be empty");
@@ -83,13 +100,47 @@ RC TableMeta::init(int32_t table_id, const char *name, int field_num, const Attr
       return rc;
     }
 
-    field_offset += attr_info.length;
+    field_offset += fields_[i + trx_field_num].inline_len();
   }
 
-  record_size_ = field_offset;
+  null_bitmap_offset_ = field_offset;
+  null_bitmap_len_    = 0;
+  for (int i = 0; i < field_num; i++) {
+    if (attributes[i].nullable) {
+      null_bitmap_len_ = (static_cast<int>(fields_.size()) + 7) / 8;
+      break;
+    }
+  }
+  record_size_ = field_offset + null_bitmap_len_;
+
+  variable_length_ = std::any_of(fields_.begin(), fields_.end(),
+                                 [](const FieldMeta &field) { return field.type() == VARCHARS; });
+  has_text_field_  = std::any_of(fields_.begin(), fields_.end(),
+                                [](const FieldMeta &field) { return field.type() == TEXTS; });
+  if (storage_format == StorageFormat::COLUMNAR && variable_length_) {
+    LOG_WARN("columnar table does not support varchar fields. table name=%s", name);
+    return RC::INVALID_ARGUMENT;
+  }
 
-  table_id_ = table_id;
-  name_     = name;
+  const int max_record_len = this->max_record_len();
+  int page_record_len = 0;
+  if (storage_format == StorageFormat::COLUMNAR) {
+    const int column_num = static_cast<int>(fields_.size()) + (null_bitmap_len_ > 0 ? 1 : 0);
+    page_record_len = RecordPageHandler::max_record_size(RecordPageFormat::PAX, column_num);
+  } else {
+    page_record_len = RecordPageHandler::max_record_size(
+        variable_length_ ? RecordPageFormat::SLOTTED : RecordPageFormat::FIXED);
+  }
+  if (max_record_len > page_record_len) {
+    LOG_WARN("record is too long to fit in a page. table name=%s, max record len=%d, page limit=%d",
+             name, max_record_len, page_record_len);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  table_id_       = table_id;
+  name_           = name;
+  storage_format_ = storage_format;
+  page_compression_ = page_compression;
   LOG_INFO("Sussessfully initialized table meta. table id=%d, name=%s", table_id, name);
   return RC::SUCCESS;
 }
@@ -190,6 +241,44 @@ int TableMeta::record_size() const
   return record_size_;
 }
 
+int TableMeta::record_len(const char *record) const
+{
+  if (!variable_length_) {
+    return record_size_;
+  }
+
+  int len = record_size_;
+  for (const FieldMeta &field : fields_) {
+    if (field.type() == VARCHARS) {
+      const VarcharRef *ref = reinterpret_cast<const VarcharRef *>(record + field.offset());
+      len = std::max(len, ref->offset + ref->len);
+    }
+  }
+  return len;
+}
+
+int TableMeta::max_record_len() const
+{
+  int len = record_size_;
+  for (const FieldMeta &field : fields_) {
+    if (field.type() == VARCHARS) {
+      len += field.len();
+    }
+  }
+  return len;
+}
+
+void TableMeta::set_null(char *record, int field_index, bool null) const
+{
+  ASSERT(null_bitmap_len_ > 0, "table has no null bitmap. table=%s", name_.c_str());
+  char &bits = record[null_bitmap_offset_ + field_index / 8];
+  if (null) {
+    bits |= (1 << (field_index % 8));
+  } else {
+    bits &= ~(1 << (field_index % 8));
+  }
+}
+
 int TableMeta::serialize(std::ostream &ss) const
 {
 
@@ -213,6 +302,9 @@ int TableMeta::serialize(std::ostream &ss) const
     indexes_value.append(std::move(index_value));
   }
   table_value[FIELD_INDEXES] = std::move(indexes_value);
+  table_value[FIELD_NULL_BITMAP_LEN] = null_bitmap_len_;
+  table_value[FIELD_STORAGE_FORMAT] = static_cast<int>(storage_format_);
+  table_value[FIELD_PAGE_COMPRESSION] = static_cast<int>(page_compression_);
 
   Json::StreamWriterBuilder builder;
   Json::StreamWriter *writer = builder.newStreamWriter();
@@ -279,7 +371,48 @@ int TableMeta::deserialize(std::istream &is)
   table_id_ = table_id;
   name_.swap(table_name);
   fields_.swap(fields);
-  record_size_ = fields_.back().offset() + fields_.back().len() - fields_.begin()->offset();
+  null_bitmap_offset_ = fields_.back().offset() + fields_.back().inline_len();
+  null_bitmap_len_    = 0;
+  record_size_        = null_bitmap_offset_ - fields_.begin()->offset();
+
+  // 旧版本的元数据没有 NULL 位图
+  const Json::Value &null_bitmap_len_value = table_value[FIELD_NULL_BITMAP_LEN];
+  if (!null_bitmap_len_value.isNull()) {
+    if (!null_bitmap_len_value.isInt()) {
+      LOG_ERROR("Invalid null bitmap len. json value=%s", null_bitmap_len_value.toStyledString().c_str());
+      return -1;
+    }
+    null_bitmap_len_ = null_bitmap_len_value.asInt();
+    record_size_ += null_bitmap_len_;
+  }
+
+  variable_length_ = std::any_of(fields_.begin(), fields_.end(),
+                                 [](const FieldMeta &field) { return field.type() == VARCHARS; });
+  has_text_field_  = std::any_of(fields_.begin(), fields_.end(),
+                                [](const FieldMeta &field) { return field.type() == TEXTS; });
+
+  // 旧版本的元数据没有存放方式，都是行存
+  storage_format_ = StorageFormat::ROW;
+  const Json::Value &storage_format_value = table_value[FIELD_STORAGE_FORMAT];
+  if (!storage_format_value.isNull()) {
+    if (!storage_format_value.isInt() || storage_format_value.asInt() < static_cast<int>(StorageFormat::ROW) ||
+        storage_format_value.asInt() > static_cast<int>(StorageFormat::COLUMNAR)) {
+      LOG_ERROR("Invalid storage format. json value=%s", storage_format_value.toStyledString().c_str());
+      return -1;
+    }
+    storage_format_ = static_cast<StorageFormat>(storage_format_value.asInt());
+  }
+
+  page_compression_ = PageCompression::NONE;
+  const Json::Value &page_compression_value = table_value[FIELD_PAGE_COMPRESSION];
+  if (!page_compression_value.isNull()) {
+    if (!page_compression_value.isInt() || page_compression_value.asInt() < static_cast<int>(PageCompression::NONE) ||
+        page_compression_value.asInt() > static_cast<int>(PageCompression::LZ4)) {
+      LOG_ERROR("Invalid page compression. json value=%s", page_compression_value.toStyledString().c_str());
+      return -1;
+    }
+    page_compression_ = static_cast<PageCompression>(page_compression_value.asInt());
+  }
 
   const Json::Value &indexes_value = table_value[FIELD_INDEXES];
   if (!indexes_value.empty()) {
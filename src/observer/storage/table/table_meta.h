@@ -36,7 +36,9 @@ public:
 
   void swap(TableMeta &other) noexcept;
 
-  RC init(int32_t table_id, const char *name, int field_num, const AttrInfoSqlNode attributes[]);
+  RC init(int32_t table_id, const char *name, int field_num, const AttrInfoSqlNode attributes[],
+          StorageFormat storage_format = StorageFormat::ROW,
+          PageCompression page_compression = PageCompression::NONE);
 
   RC add_index(const IndexMeta &index);
 
@@ -61,8 +63,64 @@ public:
   const IndexMeta *index(int i) const;
   int index_num() const;
 
+  /**
+   * @brief 记录定长部分的大小
+   * @details 没有 VARCHAR 字段时，所有记录都是这个大小
+   */
   int record_size() const;
 
+  /**
+   * @brief 是否有 VARCHAR 字段，记录是变长的
+   * @details 变长记录的格式是：定长部分(所有字段和 NULL 位图) + 各个 VARCHAR 字段的数据。
+   * VARCHAR 字段在定长部分保存一个 VarcharRef，指向后面的数据
+   */
+  bool variable_length() const { return variable_length_; }
+
+  /**
+   * @brief 是否有 TEXT 字段，TEXT 字段的数据放在单独的溢出页文件中
+   */
+  bool has_text_field() const { return has_text_field_; }
+
+  /**
+   * @brief 表数据的存放方式
+   * @details 列存的表使用 PAX 格式的页面，每个字段和 NULL 位图各自是页面中的一列。列存的表不支持 VARCHAR 字段
+   */
+  StorageFormat storage_format() const { return storage_format_; }
+
+  /**
+   * @brief 数据页面写到磁盘时的压缩方式，只影响数据文件和 TEXT 的溢出页面文件，索引文件不压缩
+   */
+  PageCompression page_compression() const { return page_compression_; }
+
+  /**
+   * @brief 一条记录的实际长度
+   */
+  int record_len(const char *record) const;
+
+  /**
+   * @brief 一条记录可能的最大长度
+   */
+  int max_record_len() const;
+
+  /**
+   * @brief 记录中 NULL 位图的位置
+   * @details 位图放在所有字段的后面，第 i 位表示第 i 个字段(包括系统字段)是否为 NULL。
+   * 没有可以为 NULL 的字段时，不分配位图，长度为0
+   */
+  int null_bitmap_offset() const { return null_bitmap_offset_; }
+  int null_bitmap_len() const { return null_bitmap_len_; }
+
+  /**
+   * @brief 记录中某个字段是否为 NULL
+   * @param field_index 字段在 field_metas 中的下标
+   */
+  bool is_null(const char *record, int field_index) const
+  {
+    return null_bitmap_len_ > 0 &&
+           (record[null_bitmap_offset_ + field_index / 8] & (1 << (field_index % 8))) != 0;
+  }
+  void set_null(char *record, int field_index, bool null) const;
+
 public:
   int serialize(std::ostream &os) const override;
   int deserialize(std::istream &is) override;
@@ -76,5 +134,12 @@ protected:
   std::vector<FieldMeta> fields_;  // 包含sys_fields
   std::vector<IndexMeta> indexes_;
 
-  int record_size_ = 0;
+  int record_size_        = 0;
+  int null_bitmap_offset_ = 0;
+  int null_bitmap_len_    = 0;
+  bool variable_length_   = false;
+  bool has_text_field_    = false;
+
+  StorageFormat storage_format_ = StorageFormat::ROW;
+  PageCompression page_compression_ = PageCompression::NONE;
 };
@@ -0,0 +1,434 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <unordered_set>
+
+#include "storage/trx/lock_manager.h"
+#include "common/log/log.h"
+#include "common/metrics/metrics.h"
+#include "common/metrics/metrics_registry.h"
+
+using namespace std;
+using namespace common;
+
+namespace {
+
+bool compatible(LockMode mode1, LockMode mode2)
+{
+  return mode1 == LockMode::SHARED && mode2 == LockMode::SHARED;
+}
+
+}  // namespace
+
+LockManager::LockManager()
+{
+  register_metrics();
+}
+
+LockManager::~LockManager()
+{
+  stop();
+  unregister_metrics();
+}
+
+RC LockManager::init(int wait_timeout_ms, int detect_interval_ms)
+{
+  wait_timeout_ms_    = wait_timeout_ms;
+  detect_interval_ms_ = detect_interval_ms;
+
+  if (detect_interval_ms_ > 0 && !detect_thread_) {
+    detect_stopped_ = false;
+    detect_thread_.reset(new thread(&LockManager::detect_loop, this));
+  }
+
+  LOG_INFO("lock manager init done. wait timeout=%dms, deadlock detect interval=%dms", wait_timeout_ms, detect_interval_ms);
+  return RC::SUCCESS;
+}
+
+void LockManager::stop()
+{
+  if (!detect_thread_) {
+    return;
+  }
+
+  {
+    lock_guard<mutex> guard(detect_mutex_);
+    detect_stopped_ = true;
+  }
+  detect_cond_.notify_all();
+  detect_thread_->join();
+  detect_thread_.reset();
+}
+
+void LockManager::register_metrics()
+{
+  const pair<const char *, const atomic<long> *> items[] = {
+      {"lock.acquires", &stat_.acquires},
+      {"lock.waits", &stat_.waits},
+      {"lock.timeouts", &stat_.timeouts},
+      {"lock.deadlocks", &stat_.deadlocks},
+  };
+
+  MetricsRegistry &registry = get_metrics_registry();
+  for (const auto &item : items) {
+    unique_ptr<Metric> metric(new AtomicGauge(*item.second));
+    registry.register_metric(item.first, metric.get());
+    metrics_.emplace_back(item.first, std::move(metric));
+  }
+
+  wait_time_histogram_ = new Histogram(random_);
+  registry.register_metric("lock.wait_time_ms", wait_time_histogram_);
+  metrics_.emplace_back("lock.wait_time_ms", unique_ptr<Metric>(wait_time_histogram_));
+
+  failed_wait_time_histogram_ = new Histogram(random_);
+  registry.register_metric("lock.failed_wait_time_ms", failed_wait_time_histogram_);
+  metrics_.emplace_back("lock.failed_wait_time_ms", unique_ptr<Metric>(failed_wait_time_histogram_));
+}
+
+void LockManager::unregister_metrics()
+{
+  MetricsRegistry &registry = get_metrics_registry();
+  for (const auto &metric : metrics_) {
+    registry.unregister(metric.first);
+  }
+  metrics_.clear();
+  wait_time_histogram_        = nullptr;
+  failed_wait_time_histogram_ = nullptr;
+}
+
+LockManager::LockShard &LockManager::shard_of(const RowLockKey &key)
+{
+  return shards_[RowLockKeyHasher()(key) % LOCK_SHARD_NUM];
+}
+
+bool LockManager::grantable(const LockQueue &queue, const LockRequest &request)
+{
+  for (const LockRequest &other : queue) {
+    if (&other == &request) {
+      continue;
+    }
+    if (other.granted && other.trx_id != request.trx_id && !compatible(other.mode, request.mode)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LockManager::grant_waiters(LockQueue &queue)
+{
+  bool granted = false;
+  for (auto iter = queue.begin(); iter != queue.end(); ++iter) {
+    LockRequest &request = *iter;
+    if (request.granted) {
+      continue;
+    }
+
+    // 先来先服务，前面的请求拿不到锁，后面的也要继续等
+    if (!grantable(queue, request)) {
+      break;
+    }
+
+    request.granted = true;
+    granted         = true;
+    if (request.upgrade) {
+      // 升级成功后，原来持有的共享锁就不需要了
+      queue.remove_if([&request](const LockRequest &other) {
+        return &other != &request && other.trx_id == request.trx_id && other.granted;
+      });
+    }
+  }
+  return granted;
+}
+
+RC LockManager::try_lock(LockOwner &owner, const RowLockKey &key, LockMode mode)
+{
+  LockShard &shard = shard_of(key);
+  lock_guard<mutex> guard(shard.mutex);
+
+  LockQueue &queue = shard.queues[key];
+
+  LockRequest *held = nullptr;
+  bool has_waiter = false;
+  for (LockRequest &request : queue) {
+    if (request.trx_id == owner.trx_id) {
+      if (!request.granted || request.pending) {
+        // 上次的等待还没有结束
+        return RC::LOCKED_NEED_WAIT;
+      }
+      held = &request;
+    } else if (!request.granted) {
+      has_waiter = true;
+    }
+  }
+
+  if (held != nullptr) {
+    if (held->mode == LockMode::EXCLUSIVE || mode == LockMode::SHARED) {
+      return RC::SUCCESS;
+    }
+
+    // 持有共享锁，申请排它锁。没有其它事务持有锁时可以直接升级，否则排在所有等待的请求前面
+    LockRequest upgrade_request;
+    upgrade_request.trx_id  = owner.trx_id;
+    upgrade_request.mode    = mode;
+    upgrade_request.upgrade = true;
+    upgrade_request.pending = true;
+    if (grantable(queue, upgrade_request)) {
+      held->mode = mode;
+      return RC::SUCCESS;
+    }
+
+    auto position = find_if(queue.begin(), queue.end(), [](const LockRequest &request) { return !request.granted; });
+    queue.insert(position, upgrade_request);
+    stat_.waits++;
+    return RC::LOCKED_NEED_WAIT;
+  }
+
+  LockRequest request;
+  request.trx_id = owner.trx_id;
+  request.mode   = mode;
+  if (!has_waiter && grantable(queue, request)) {
+    request.granted = true;
+    queue.push_back(request);
+    owner.keys.push_back(key);
+    stat_.acquires++;
+    return RC::SUCCESS;
+  }
+
+  request.pending = true;
+  queue.push_back(request);
+  stat_.waits++;
+  return RC::LOCKED_NEED_WAIT;
+}
+
+RC LockManager::wait(LockOwner &owner, const RowLockKey &key)
+{
+  const auto begin_time = chrono::steady_clock::now();
+  const auto deadline   = begin_time + chrono::milliseconds(wait_timeout_ms_);
+
+  LockShard &shard = shard_of(key);
+  unique_lock<mutex> lock(shard.mutex);
+
+  auto queue_iter = shard.queues.find(key);
+  if (queue_iter == shard.queues.end()) {
+    LOG_WARN("no lock request to wait. trx id=%d, table id=%d, rid=%s",
+             owner.trx_id, key.table_id, key.rid.to_string().c_str());
+    return RC::INTERNAL;
+  }
+
+  LockQueue &queue = queue_iter->second;
+  auto request_iter = find_if(queue.begin(), queue.end(), [&owner](const LockRequest &request) {
+    return request.trx_id == owner.trx_id && request.pending;
+  });
+  if (request_iter == queue.end()) {
+    LOG_WARN("no lock request to wait. trx id=%d, table id=%d, rid=%s",
+             owner.trx_id, key.table_id, key.rid.to_string().c_str());
+    return RC::INTERNAL;
+  }
+
+  LockRequest &request = *request_iter;
+  bool timeout = false;
+  while (!request.granted && !request.deadlock && !timeout) {
+    timeout = (shard.cond.wait_until(lock, deadline) == cv_status::timeout);
+  }
+
+  const double wait_ms = chrono::duration<double, milli>(chrono::steady_clock::now() - begin_time).count();
+  if (request.granted) {
+    if (!request.upgrade) {
+      owner.keys.push_back(key);
+    }
+    request.upgrade = false;
+    request.pending = false;
+    stat_.acquires++;
+    wait_time_histogram_->update(wait_ms);
+    return RC::SUCCESS;
+  }
+
+  RC rc = RC::LOCKED_WAIT_TIMEOUT;
+  if (request.deadlock) {
+    rc = RC::LOCKED_DEADLOCK;
+    stat_.deadlocks++;
+  } else {
+    stat_.timeouts++;
+  }
+  failed_wait_time_histogram_->update(wait_ms);
+  LOG_INFO("failed to wait lock. trx id=%d, table id=%d, rid=%s, wait=%.1fms, rc=%s",
+           owner.trx_id, key.table_id, key.rid.to_string().c_str(), wait_ms, strrc(rc));
+
+  // 等待的请求可能挡住了后面的请求
+  queue.erase(request_iter);
+  if (grant_waiters(queue)) {
+    shard.cond.notify_all();
+  }
+  if (queue.empty()) {
+    shard.queues.erase(queue_iter);
+  }
+  return rc;
+}
+
+RC LockManager::lock(LockOwner &owner, const RowLockKey &key, LockMode mode)
+{
+  RC rc = try_lock(owner, key, mode);
+  if (rc == RC::LOCKED_NEED_WAIT) {
+    rc = wait(owner, key);
+  }
+  return rc;
+}
+
+void LockManager::unlock(LockOwner &owner, const RowLockKey &key)
+{
+  auto iter = find(owner.keys.rbegin(), owner.keys.rend(), key);
+  if (iter == owner.keys.rend()) {
+    return;
+  }
+  owner.keys.erase(std::next(iter).base());
+
+  release(owner.trx_id, key);
+}
+
+void LockManager::unlock_all(LockOwner &owner)
+{
+  for (const RowLockKey &key : owner.keys) {
+    release(owner.trx_id, key);
+  }
+  owner.keys.clear();
+}
+
+void LockManager::release(int32_t trx_id, const RowLockKey &key)
+{
+  LockShard &shard = shard_of(key);
+  lock_guard<mutex> guard(shard.mutex);
+
+  auto queue_iter = shard.queues.find(key);
+  if (queue_iter == shard.queues.end()) {
+    return;
+  }
+
+  LockQueue &queue = queue_iter->second;
+  queue.remove_if([trx_id](const LockRequest &request) { return request.trx_id == trx_id && request.granted; });
+  if (grant_waiters(queue)) {
+    shard.cond.notify_all();
+  }
+  if (queue.empty()) {
+    shard.queues.erase(queue_iter);
+  }
+}
+
+int LockManager::detect_deadlocks()
+{
+  // 构造 wait-for 图：等待的事务指向挡住它的事务，包括持有冲突锁的事务和排在它前面等待的事务
+  unordered_map<int32_t, vector<int32_t>> wait_for;
+  unordered_map<int32_t, RowLockKey>      waiting_keys;
+  for (LockShard &shard : shards_) {
+    lock_guard<mutex> guard(shard.mutex);
+    for (const auto &item : shard.queues) {
+      const LockQueue &queue = item.second;
+      for (auto iter = queue.begin(); iter != queue.end(); ++iter) {
+        if (iter->granted || iter->deadlock) {
+          continue;
+        }
+
+        vector<int32_t> &blockers = wait_for[iter->trx_id];
+        waiting_keys[iter->trx_id] = item.first;
+        for (auto other = queue.begin(); other != queue.end(); ++other) {
+          if (other->trx_id == iter->trx_id) {
+            continue;
+          }
+          const bool ahead = distance(queue.begin(), other) < distance(queue.begin(), iter);
+          if ((other->granted && !compatible(other->mode, iter->mode)) || (!other->granted && ahead)) {
+            blockers.push_back(other->trx_id);
+          }
+        }
+      }
+    }
+  }
+
+  int victims = 0;
+  unordered_set<int32_t> removed;
+  while (true) {
+    // 深度优先遍历找环
+    unordered_map<int32_t, int> colors;  // 0: 没有访问，1: 正在访问，2: 访问结束
+    vector<int32_t> path;
+    vector<int32_t> cycle;
+
+    function<bool(int32_t)> dfs = [&](int32_t trx_id) -> bool {
+      colors[trx_id] = 1;
+      path.push_back(trx_id);
+      auto edges = wait_for.find(trx_id);
+      if (edges != wait_for.end()) {
+        for (int32_t next : edges->second) {
+          if (removed.count(next) > 0) {
+            continue;
+          }
+          if (colors[next] == 1) {
+            cycle.assign(find(path.begin(), path.end(), next), path.end());
+            return true;
+          }
+          if (colors[next] == 0 && dfs(next)) {
+            return true;
+          }
+        }
+      }
+      path.pop_back();
+      colors[trx_id] = 2;
+      return false;
+    };
+
+    bool found = false;
+    for (const auto &item : wait_for) {
+      if (removed.count(item.first) == 0 && colors[item.first] == 0 && dfs(item.first)) {
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      break;
+    }
+
+    // 选择最年轻的事务作为牺牲者，它做的工作可能最少
+    const int32_t victim = *max_element(cycle.begin(), cycle.end());
+    removed.insert(victim);
+
+    const RowLockKey &key   = waiting_keys[victim];
+    LockShard        &shard = shard_of(key);
+    lock_guard<mutex> guard(shard.mutex);
+    auto queue_iter = shard.queues.find(key);
+    if (queue_iter == shard.queues.end()) {
+      continue;
+    }
+    for (LockRequest &request : queue_iter->second) {
+      if (request.trx_id == victim && !request.granted) {
+        LOG_INFO("found deadlock. victim trx id=%d, cycle size=%d", victim, static_cast<int>(cycle.size()));
+        request.deadlock = true;
+        victims++;
+        shard.cond.notify_all();
+        break;
+      }
+    }
+  }
+  return victims;
+}
+
+void LockManager::detect_loop()
+{
+  unique_lock<mutex> lock(detect_mutex_);
+  while (!detect_stopped_) {
+    detect_cond_.wait_for(lock, chrono::milliseconds(detect_interval_ms_));
+    if (detect_stopped_) {
+      break;
+    }
+
+    lock.unlock();
+    detect_deadlocks();
+    lock.lock();
+  }
+}
@@ -0,0 +1,220 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common/rc.h"
+#include "common/math/random_generator.h"
+#include "storage/record/record.h"
+
+namespace common {
+class Metric;
+class Histogram;
+}  // namespace common
+
+/**
+ * @brief 行锁的模式
+ * @ingroup Transaction
+ */
+enum class LockMode
+{
+  SHARED,
+  EXCLUSIVE,
+};
+
+/**
+ * @brief 行锁锁住的对象，某张表上的某条记录
+ * @ingroup Transaction
+ */
+struct RowLockKey
+{
+  int32_t table_id = -1;
+  RID     rid;
+
+  bool operator==(const RowLockKey &other) const { return table_id == other.table_id && rid == other.rid; }
+};
+
+/**
+ * @brief 持有行锁的事务
+ * @ingroup Transaction
+ * @details 记录事务持有的所有行锁，事务结束时一起释放。只会被事务自己的线程访问
+ */
+struct LockOwner
+{
+  int32_t                 trx_id = 0;
+  std::vector<RowLockKey> keys;  ///< 已经拿到的锁
+};
+
+/**
+ * @brief 行锁的统计信息
+ * @ingroup Transaction
+ * @details 会注册到 common::MetricsRegistry 中，名字以 lock. 开头。等锁的时间使用直方图统计
+ */
+struct LockStat
+{
+  std::atomic<long> acquires{0};   ///< 加锁次数，不包括已经持有的锁
+  std::atomic<long> waits{0};      ///< 需要等待的次数
+  std::atomic<long> timeouts{0};   ///< 等待超时的次数
+  std::atomic<long> deadlocks{0};  ///< 因为死锁被选为牺牲者的次数
+};
+
+/**
+ * @brief 行锁管理器
+ * @ingroup Transaction
+ * @details 按照(表，RID)加锁，支持共享锁和排它锁。每个加锁对象有一个请求队列，
+ * 与已经持有的锁冲突，或者前面还有等待的请求时，按照先来先服务排队等待，等待有超时时间。
+ * 后台线程定期根据等待关系构造 wait-for 图，发现环时选择最年轻(事务号最大)的事务作为牺牲者，让它的等待失败。
+ * 加锁分成 try_lock 和 wait 两步，调用者可以在两步之间释放页面锁，避免持有行锁的事务因为拿不到页面锁而无法结束。
+ */
+class LockManager
+{
+public:
+  static constexpr int DEFAULT_WAIT_TIMEOUT_MS    = 10000;
+  static constexpr int DEFAULT_DETECT_INTERVAL_MS = 100;
+
+public:
+  LockManager();
+  ~LockManager();
+
+  /**
+   * @brief 启动死锁检测线程
+   * @param detect_interval_ms 死锁检测的间隔，不大于0时不启动后台线程
+   */
+  RC init(int wait_timeout_ms = DEFAULT_WAIT_TIMEOUT_MS, int detect_interval_ms = DEFAULT_DETECT_INTERVAL_MS);
+
+  /**
+   * @brief 停止死锁检测线程
+   */
+  void stop();
+
+  /**
+   * @brief 申请锁，不等待
+   * @return RC::SUCCESS 拿到了锁，或者已经持有足够的锁；
+   *         RC::LOCKED_NEED_WAIT 请求已经放入等待队列，需要调用 wait 等待
+   */
+  RC try_lock(LockOwner &owner, const RowLockKey &key, LockMode mode);
+
+  /**
+   * @brief 等待 try_lock 放入队列的请求
+   * @return RC::SUCCESS 拿到了锁；
+   *         RC::LOCKED_WAIT_TIMEOUT 等待超时；RC::LOCKED_DEADLOCK 被选为死锁的牺牲者。
+   *         失败时请求已经从队列中移除
+   */
+  RC wait(LockOwner &owner, const RowLockKey &key);
+
+  /**
+   * @brief 申请锁，需要时等待
+   */
+  RC lock(LockOwner &owner, const RowLockKey &key, LockMode mode);
+
+  /**
+   * @brief 提前释放一个锁。没有持有这个锁时什么都不做
+   */
+  void unlock(LockOwner &owner, const RowLockKey &key);
+
+  /**
+   * @brief 释放事务持有的所有锁
+   */
+  void unlock_all(LockOwner &owner);
+
+  /**
+   * @brief 检测一次死锁
+   * @details 后台线程定期调用
+   * @return 选中的牺牲者个数
+   */
+  int detect_deadlocks();
+
+  const LockStat &stat() const { return stat_; }
+
+private:
+  struct RowLockKeyHasher
+  {
+    size_t operator()(const RowLockKey &key) const
+    {
+      return ((static_cast<size_t>(key.table_id) << 48) ^ (static_cast<size_t>(key.rid.page_num) << 16)) +
+             static_cast<size_t>(key.rid.slot_num);
+    }
+  };
+
+  struct LockRequest
+  {
+    int32_t  trx_id   = 0;
+    LockMode mode     = LockMode::SHARED;
+    bool     granted  = false;
+    bool     upgrade  = false;  ///< 持有共享锁的事务申请排它锁
+    bool     pending  = false;  ///< try_lock 没有拿到锁，还没有调用 wait
+    bool     deadlock = false;  ///< 被选为死锁的牺牲者
+  };
+
+  using LockQueue = std::list<LockRequest>;
+
+  /**
+   * @brief 锁表按照加锁对象分片，每个分片有自己的互斥量
+   */
+  struct LockShard
+  {
+    std::mutex                                                  mutex;
+    std::condition_variable                                     cond;
+    std::unordered_map<RowLockKey, LockQueue, RowLockKeyHasher> queues;
+  };
+
+  static constexpr int LOCK_SHARD_NUM = 16;
+
+private:
+  LockShard &shard_of(const RowLockKey &key);
+
+  /**
+   * @brief 队列中某个请求是否可以拿到锁
+   */
+  static bool grantable(const LockQueue &queue, const LockRequest &request);
+
+  /**
+   * @brief 按照先后顺序，把队列中能拿到锁的请求设置为持有状态
+   * @return 是否有请求拿到了锁
+   */
+  static bool grant_waiters(LockQueue &queue);
+
+  /**
+   * @brief 删除某个事务持有的锁，并唤醒后面的请求
+   */
+  void release(int32_t trx_id, const RowLockKey &key);
+
+  void detect_loop();
+
+  void register_metrics();
+  void unregister_metrics();
+
+private:
+  int       wait_timeout_ms_    = DEFAULT_WAIT_TIMEOUT_MS;
+  int       detect_interval_ms_ = DEFAULT_DETECT_INTERVAL_MS;
+  LockShard shards_[LOCK_SHARD_NUM];
+
+  std::unique_ptr<std::thread> detect_thread_;
+  std::mutex                   detect_mutex_;
+  std::condition_variable      detect_cond_;
+  bool                         detect_stopped_ = false;
+
+  LockStat                stat_;
+  common::RandomGenerator random_;
+  common::Histogram      *wait_time_histogram_        = nullptr;  ///< 拿到锁的等待时间，毫秒。由 metrics_ 管理
+  common::Histogram      *failed_wait_time_histogram_ = nullptr;  ///< 超时或者死锁的等待时间，毫秒
+
+  std::vector<std::pair<std::string, std::unique_ptr<common::Metric>>> metrics_;
+};
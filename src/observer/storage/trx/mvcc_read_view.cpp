@@ -0,0 +1,142 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/trx/mvcc_read_view.h"
+
+using namespace std;
+using namespace common;
+
+MvccReadView::MvccReadView(int32_t high, vector<int32_t> active_xids)
+    : low_(active_xids.empty() ? high : active_xids.front()), high_(high), active_xids_(std::move(active_xids))
+{}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int32_t MvccActiveTrxSet::add_next(size_t hint)
+{
+  Shard &shard = shard_of(hint);
+  lock_guard<Mutex> guard(shard.lock);
+  const int32_t xid = ++current_xid_;
+  shard.entries.push_back(Entry{xid, xid});
+  ++version_;
+  return xid;
+}
+
+void MvccActiveTrxSet::remove(initializer_list<int32_t> xids, size_t hint)
+{
+  Shard &shard = shard_of(hint);
+  lock_guard<Mutex> guard(shard.lock);
+  for (int32_t xid : xids) {
+    auto iter = lower_bound(shard.entries.begin(), shard.entries.end(), xid,
+        [](const Entry &entry, int32_t value) { return entry.xid < value; });
+    if (iter != shard.entries.end() && iter->xid == xid) {
+      shard.entries.erase(iter);
+    }
+  }
+  ++version_;
+}
+
+void MvccActiveTrxSet::advance_to(int32_t xid)
+{
+  // 与分配事务号互斥，生成视图时看到的版本号和事务号是一致的
+  Shard &shard = shard_of(0);
+  lock_guard<Mutex> guard(shard.lock);
+  int32_t current = current_xid_.load();
+  while (current < xid && !current_xid_.compare_exchange_weak(current, xid)) {
+  }
+  ++version_;
+}
+
+shared_ptr<const MvccReadView> MvccActiveTrxSet::read_view()
+{
+  shared_ptr<const CachedView> cached = cached_view_.load();
+  if (cached && cached->version == version_.load()) {
+    return cached->view;
+  }
+  return build_read_view(0 /*xid*/, 0 /*hint*/);
+}
+
+shared_ptr<const MvccReadView> MvccActiveTrxSet::read_view(int32_t xid, size_t hint)
+{
+  {
+    // 在自己的分片锁内检查并记下 low：计算 horizon 要锁住所有分片，不会看到视图已经拿到但 low 还没有记下的状态
+    Shard &shard = shard_of(hint);
+    lock_guard<Mutex> guard(shard.lock);
+    shared_ptr<const CachedView> cached = cached_view_.load();
+    if (cached && cached->version == version_.load()) {
+      set_view_low(shard, xid, cached->view->low());
+      return cached->view;
+    }
+  }
+  return build_read_view(xid, hint);
+}
+
+shared_ptr<const MvccReadView> MvccActiveTrxSet::build_read_view(int32_t xid, size_t hint)
+{
+  lock_guard<Mutex> build_guard(build_lock_);
+  for (Shard &shard : shards_) {
+    shard.lock.lock();
+  }
+
+  // 等锁的时候可能已经有别的线程生成了
+  const uint64_t                 version = version_.load();
+  shared_ptr<const CachedView>   cached  = cached_view_.load();
+  shared_ptr<const MvccReadView> view;
+  if (cached && cached->version == version) {
+    view = cached->view;
+  } else {
+    vector<int32_t> active_xids;
+    for (const Shard &shard : shards_) {
+      for (const Entry &entry : shard.entries) {
+        active_xids.push_back(entry.xid);
+      }
+    }
+    sort(active_xids.begin(), active_xids.end());
+    view = make_shared<const MvccReadView>(current_xid_.load() + 1, std::move(active_xids));
+    cached_view_.store(make_shared<const CachedView>(CachedView{version, view}));
+  }
+
+  if (xid > 0) {
+    set_view_low(shard_of(hint), xid, view->low());
+  }
+
+  for (Shard &shard : shards_) {
+    shard.lock.unlock();
+  }
+  return view;
+}
+
+void MvccActiveTrxSet::set_view_low(Shard &shard, int32_t xid, int32_t low)
+{
+  auto iter = lower_bound(shard.entries.begin(), shard.entries.end(), xid,
+      [](const Entry &entry, int32_t value) { return entry.xid < value; });
+  if (iter != shard.entries.end() && iter->xid == xid) {
+    iter->low = std::min(iter->low, low);
+  }
+}
+
+int32_t MvccActiveTrxSet::horizon() const
+{
+  for (const Shard &shard : shards_) {
+    shard.lock.lock();
+  }
+
+  int32_t horizon = current_xid_.load() + 1;
+  for (const Shard &shard : shards_) {
+    for (const Entry &entry : shard.entries) {
+      horizon = std::min(horizon, entry.low);
+    }
+  }
+
+  for (const Shard &shard : shards_) {
+    shard.lock.unlock();
+  }
+  return horizon;
+}
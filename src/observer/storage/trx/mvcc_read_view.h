@@ -0,0 +1,170 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include "common/lang/mutex.h"
+
+/**
+ * @brief 多版本事务的读视图
+ * @ingroup Transaction
+ * @details 是某个时刻活跃事务集合的快照。事务号和提交事务号使用同一个序列，
+ * 视图记录了当时最小的活跃事务号 low 和下一个要分配的事务号 high，以及当时活跃的事务号。
+ * 一个提交事务号对视图可见，当且仅当它比 high 小，并且在视图创建时已经不再活跃。
+ * 正在提交的事务，提交事务号也是活跃的，所以其它事务要么看到它全部的修改，要么全都看不到。
+ * 活跃事务号保存成有序数组，大小只与活跃事务的个数有关，与 [low, high) 的跨度无关。
+ * 视图创建后不再修改，可以被多个事务共享。
+ */
+class MvccReadView
+{
+public:
+  MvccReadView() = default;
+  MvccReadView(int32_t high, std::vector<int32_t> active_xids);
+
+  /**
+   * @brief 提交事务号为 commit_xid 的修改对这个视图是否可见
+   */
+  bool visible(int32_t commit_xid) const
+  {
+    if (commit_xid < low_) {
+      return true;
+    }
+    if (commit_xid >= high_) {
+      return false;
+    }
+    return !active(commit_xid);
+  }
+
+  /**
+   * @brief 视图创建时这个事务号是否活跃
+   */
+  bool active(int32_t xid) const
+  {
+    if (xid < low_ || xid >= high_) {
+      return false;
+    }
+    return std::binary_search(active_xids_.begin(), active_xids_.end(), xid);
+  }
+
+  int32_t low() const { return low_; }
+  int32_t high() const { return high_; }
+
+private:
+  int32_t              low_  = 1;
+  int32_t              high_ = 1;
+  std::vector<int32_t> active_xids_;  ///< 活跃的事务号，从小到大排列
+};
+
+/**
+ * @brief 活跃事务集合
+ * @ingroup Transaction
+ * @details 负责分配事务号，并维护活跃的事务号，包括已经开始的事务和正在提交的提交事务号。
+ * 活跃事务号按照调用者给的 hint 分片保存，开始和结束事务只锁一个分片，并且只修改集合、增加版本号，不生成读视图。
+ * 分配事务号和加入分片在同一个分片锁内完成，生成读视图时锁住所有分片，不会漏掉分配出去但还没有加入集合的事务号。
+ * 读视图在有人请求时才生成，集合没有变化时复用上次生成的视图，同时开始的事务可以共享一个视图。
+ */
+class MvccActiveTrxSet
+{
+public:
+  MvccActiveTrxSet() = default;
+  ~MvccActiveTrxSet() = default;
+
+  /**
+   * @brief 分配一个新的事务号并加入活跃集合
+   * @param hint 决定放在哪个分片，同一个事务的事务号和提交事务号要使用相同的 hint
+   */
+  int32_t add_next(size_t hint = 0);
+
+  /**
+   * @brief 把事务号从活跃集合中移除
+   * @param hint 与 add_next 时相同
+   */
+  void remove(std::initializer_list<int32_t> xids, size_t hint = 0);
+
+  /**
+   * @brief 保证之后分配的事务号都比 xid 大。恢复时使用
+   */
+  void advance_to(int32_t xid);
+
+  /**
+   * @brief 最新的读视图
+   * @details 集合没有变化时直接返回上次生成的视图，否则锁住所有分片重新生成
+   */
+  std::shared_ptr<const MvccReadView> read_view();
+
+  /**
+   * @brief 活跃事务 xid 获取自己要使用的读视图
+   * @details 同时记下这个视图的 low，在事务结束前 horizon 不会超过它
+   * @param hint 与 add_next 时相同
+   */
+  std::shared_ptr<const MvccReadView> read_view(int32_t xid, size_t hint);
+
+  /**
+   * @brief 所有活跃事务的读视图中最小的 low
+   * @details 结束事务号比它小的数据对所有活跃事务和之后开始的事务都不可见，可以回收。
+   * 还没有获取读视图的事务，以后获取的视图的 low 不会比当前最小的活跃事务号小。
+   * 需要锁住所有分片，只在回收时使用
+   */
+  int32_t horizon() const;
+
+  /**
+   * @brief 当前已经分配的最大事务号
+   */
+  int32_t current_xid() const { return current_xid_.load(); }
+
+private:
+  struct Entry
+  {
+    int32_t xid;
+    int32_t low;  ///< 这个事务的读视图的 low，还没有获取视图时是 xid
+  };
+
+  struct alignas(64) Shard
+  {
+    mutable common::Mutex lock;
+    std::vector<Entry>    entries;  ///< 在分片锁内分配事务号，所以按照事务号从小到大排列
+  };
+
+  struct CachedView
+  {
+    uint64_t                            version = 0;  ///< 生成视图时集合的版本号
+    std::shared_ptr<const MvccReadView> view;
+  };
+
+  static constexpr int SHARD_NUM = 16;
+
+  Shard &shard_of(size_t hint) { return shards_[hint % SHARD_NUM]; }
+
+  /**
+   * @brief 锁住所有分片生成新的读视图，如果 xid 是活跃事务，记下视图的 low
+   */
+  std::shared_ptr<const MvccReadView> build_read_view(int32_t xid, size_t hint);
+
+  /**
+   * @brief 记下活跃事务 xid 的读视图的 low，调用者持有分片锁
+   */
+  static void set_view_low(Shard &shard, int32_t xid, int32_t low);
+
+private:
+  std::atomic<int32_t>  current_xid_{0};
+  std::atomic<uint64_t> version_{0};  ///< 集合每次变化都增加，在分片锁内修改
+  Shard                 shards_[SHARD_NUM];
+
+  common::Mutex                                   build_lock_;  ///< 同时只有一个线程生成视图，其它线程等着复用
+  std::atomic<std::shared_ptr<const CachedView>> cached_view_;
+};
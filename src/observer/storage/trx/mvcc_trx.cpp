@@ -20,14 +20,18 @@ See the Mulan PSL v2 for more details. */
 #include "storage/clog/clog.h"
 
 using namespace std;
+using namespace common;
+
+MvccTrxKit::MvccTrxKit() : vacuum_(version_store_)
+{}
 
 MvccTrxKit::~MvccTrxKit()
 {
-  vector<Trx *> tmp_trxes;
-  tmp_trxes.swap(trxes_);
-  
-  for (Trx *trx : tmp_trxes) {
-    delete trx;
+  for (TrxShard &shard : shards_) {
+    for (Trx *trx : shard.trxes) {
+      delete trx;
+    }
+    shard.trxes.clear();
   }
 }
 
@@ -38,6 +42,12 @@ RC MvccTrxKit::init()
     FieldMeta("__trx_xid_end",   AttrType::INTS, 0/*attr_offset*/, 4/*attr_len*/, false/*visible*/)
   };
 
+  RC rc = lock_manager_.init();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to init lock manager. rc=%s", strrc(rc));
+    return rc;
+  }
+
   LOG_INFO("init mvcc trx kit done.");
   return RC::SUCCESS;
 }
@@ -47,23 +57,90 @@ const vector<FieldMeta> *MvccTrxKit::trx_fields() const
   return &fields_;
 }
 
-int32_t MvccTrxKit::next_trx_id()
+int32_t MvccTrxKit::max_trx_id() const
 {
-  return ++current_trx_id_;
+  return numeric_limits<int32_t>::max();
 }
 
-int32_t MvccTrxKit::max_trx_id() const
+MvccTrxKit::TrxShard &MvccTrxKit::shard_of(const Trx *trx)
 {
-  return numeric_limits<int32_t>::max();
+  // 事务对象的地址低位总是0，先移掉
+  const uintptr_t address = reinterpret_cast<uintptr_t>(trx);
+  return shards_[(address >> 6) % TRX_SHARD_NUM];
+}
+
+size_t MvccTrxKit::active_hint(const Trx *trx)
+{
+  return reinterpret_cast<uintptr_t>(trx) >> 6;
+}
+
+void MvccTrxKit::start_trx(MvccTrx &trx)
+{
+  trx.trx_id_ = active_trxes_.add_next(active_hint(&trx));
+  trx.lock_owner_.trx_id = trx.trx_id_;
+  trx.started_ = true;
+}
+
+int32_t MvccTrxKit::start_commit(MvccTrx &trx)
+{
+  return active_trxes_.add_next(active_hint(&trx));
+}
+
+shared_ptr<const MvccReadView> MvccTrxKit::read_view(const MvccTrx &trx)
+{
+  return active_trxes_.read_view(trx.trx_id_, active_hint(&trx));
+}
+
+void MvccTrxKit::finish_trx(MvccTrx &trx, int32_t commit_xid)
+{
+  if (commit_xid > 0) {
+    active_trxes_.remove({trx.trx_id_, commit_xid}, active_hint(&trx));
+  } else {
+    active_trxes_.remove({trx.trx_id_}, active_hint(&trx));
+  }
+  trx.read_view_ptr_ = nullptr;
+  trx.read_view_.reset();
+  trx.started_ = false;
+
+  // 修改都已经提交或回滚，等锁的事务可以看到最新的数据了
+  lock_manager_.unlock_all(trx.lock_owner_);
+}
+
+RC MvccTrxKit::vacuum(const vector<Table *> &tables)
+{
+  const long garbage_count = garbage_count_.exchange(0);
+  if (garbage_count <= 0) {
+    return RC::SUCCESS;
+  }
+
+  const int32_t oldest = oldest_active_trx_id();
+  long reclaimed = 0;
+  RC rc = RC::SUCCESS;
+  for (Table *table : tables) {
+    long table_reclaimed = 0;
+    rc = vacuum_.vacuum_table(table, oldest, table_reclaimed);
+    reclaimed += table_reclaimed;
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to vacuum table. table=%s, rc=%s", table->name(), strrc(rc));
+      break;
+    }
+  }
+  vacuum_.finish_pass(oldest);
+
+  // 还有活跃事务能访问的数据这次回收不了，留到下一次
+  if (reclaimed < garbage_count) {
+    garbage_count_ += garbage_count - reclaimed;
+  }
+  return rc;
 }
 
 Trx *MvccTrxKit::create_trx(CLogManager *log_manager)
 {
   Trx *trx = new MvccTrx(*this, log_manager);
   if (trx != nullptr) {
-    lock_.lock();
-    trxes_.push_back(trx);
-    lock_.unlock();
+    TrxShard &shard = shard_of(trx);
+    lock_guard<Mutex> guard(shard.lock);
+    shard.trxes.insert(trx);
   }
   return trx;
 }
@@ -72,49 +149,50 @@ Trx *MvccTrxKit::create_trx(int32_t trx_id)
 {
   Trx *trx = new MvccTrx(*this, trx_id);
   if (trx != nullptr) {
-    lock_.lock();
-    trxes_.push_back(trx);
-    if (current_trx_id_ < trx_id) {
-      current_trx_id_ = trx_id;
-    }
-    lock_.unlock();
+    TrxShard &shard = shard_of(trx);
+    lock_guard<Mutex> guard(shard.lock);
+    shard.trxes.insert(trx);
   }
+  recover_trx_id(trx_id);
   return trx;
 }
 
 void MvccTrxKit::destroy_trx(Trx *trx)
 {
-  lock_.lock();
-  for (auto iter = trxes_.begin(), itend = trxes_.end(); iter != itend; ++iter) {
-    if (*iter == trx) {
-      trxes_.erase(iter);
-      break;
-    }
+  MvccTrx *mvcc_trx = static_cast<MvccTrx *>(trx);
+  if (mvcc_trx->started_ && !mvcc_trx->recovering_) {
+    // 没有提交或回滚就结束的事务，比如客户端断开连接
+    finish_trx(*mvcc_trx, 0);
   }
-  lock_.unlock();
+
+  TrxShard &shard = shard_of(trx);
+  shard.lock.lock();
+  shard.trxes.erase(trx);
+  shard.lock.unlock();
 
   delete trx;
 }
 
 Trx *MvccTrxKit::find_trx(int32_t trx_id)
 {
-  lock_.lock();
-  for (Trx *trx : trxes_) {
-    if (trx->id() == trx_id) {
-      lock_.unlock();
-      return trx;
+  for (TrxShard &shard : shards_) {
+    lock_guard<Mutex> guard(shard.lock);
+    for (Trx *trx : shard.trxes) {
+      if (trx->id() == trx_id) {
+        return trx;
+      }
     }
   }
-  lock_.unlock();
-
   return nullptr;
 }
 
 void MvccTrxKit::all_trxes(std::vector<Trx *> &trxes)
 {
-  lock_.lock();
-  trxes = trxes_;
-  lock_.unlock();
+  trxes.clear();
+  for (TrxShard &shard : shards_) {
+    lock_guard<Mutex> guard(shard.lock);
+    trxes.insert(trxes.end(), shard.trxes.begin(), shard.trxes.end());
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -147,6 +225,15 @@ RC MvccTrx::insert_record(Table *table, Record &record)
     return rc;
   }
 
+  // 新插入的记录也要加锁，其它事务要修改它时需要等当前事务结束
+  rc = trx_kit_.lock_manager().lock(lock_owner_, RowLockKey{table->table_id(), record.rid()}, LockMode::EXCLUSIVE);
+  rc = abort_if_lock_failed(rc);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to lock inserted record. table=%s, rid=%s, rc=%s",
+             table->name(), record.rid().to_string().c_str(), strrc(rc));
+    return rc;
+  }
+
   rc = log_manager_->append_log(CLogType::INSERT, trx_id_, table->table_id(), record.rid(), record.len(), 0/*offset*/, record.data());
   ASSERT(rc == RC::SUCCESS, "failed to append insert record log. trx id=%d, table id=%d, rid=%s, record len=%d, rc=%s",
       trx_id_, table->table_id(), record.rid().to_string().c_str(), record.len(), strrc(rc));
@@ -176,6 +263,18 @@ RC MvccTrx::delete_record(Table * table, Record &record)
   }
   
   end_field.set_int(record, -trx_id_);
+  if (table->table_meta().storage_format() == StorageFormat::COLUMNAR) {
+    // 列存页面上读出来的是记录的副本，要把修改写回页面。遍历时已经拿着页面的写锁
+    RC rc = table->visit_record(record.rid(), false /*readonly*/, [this, &end_field](Record &page_record) {
+      end_field.set_int(page_record, -trx_id_);
+    });
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to mark record deleted. table=%s, rid=%s, rc=%s",
+               table->name(), record.rid().to_string().c_str(), strrc(rc));
+      return rc;
+    }
+  }
+
   RC rc = log_manager_->append_log(CLogType::DELETE, trx_id_, table->table_id(), record.rid(), 0, 0, nullptr);
   ASSERT(rc == RC::SUCCESS, "failed to append delete record log. trx id=%d, table id=%d, rid=%s, record len=%d, rc=%s",
       trx_id_, table->table_id(), record.rid().to_string().c_str(), record.len(), strrc(rc));
@@ -185,6 +284,193 @@ RC MvccTrx::delete_record(Table * table, Record &record)
   return RC::SUCCESS;
 }
 
+/**
+ * @brief UPDATE_PARTIAL 日志中修改过的一段数据
+ * @details 日志数据的格式是:
+ * | range_num(int32) | range_num 个 PartialUpdateRange | 每一段更新前的数据 | 每一段更新后的数据 |
+ * 与 UPDATE 日志一样保存了更新前的数据，回滚时可以不依赖页面上的内容。
+ * CLogRecordData::data_offset_ 是第一段数据的偏移，只是方便查看日志。
+ */
+struct PartialUpdateRange
+{
+  int32_t offset;
+  int32_t len;
+};
+
+/**
+ * @brief 比较更新前后的记录，生成只包含修改过的数据的日志
+ * @details 两段修改之间相同的数据比较少时合并成一段，省掉一个 PartialUpdateRange
+ * @return 日志比完整记录前后两个版本小时返回 true
+ */
+static bool make_partial_update_log(
+    const char *old_data, const char *new_data, int len, vector<char> &log_data, int32_t &first_offset)
+{
+  const int max_gap = static_cast<int>(sizeof(PartialUpdateRange)) / 2;
+
+  vector<PartialUpdateRange> ranges;
+  int changed_len = 0;
+  for (int i = 0; i < len; i++) {
+    if (old_data[i] == new_data[i]) {
+      continue;
+    }
+
+    int end = i + 1;
+    while (end < len && old_data[end] != new_data[end]) {
+      end++;
+    }
+
+    if (!ranges.empty() && i - (ranges.back().offset + ranges.back().len) <= max_gap) {
+      PartialUpdateRange &last = ranges.back();
+      changed_len += end - (last.offset + last.len);
+      last.len = end - last.offset;
+    } else {
+      ranges.push_back(PartialUpdateRange{i, end - i});
+      changed_len += end - i;
+    }
+    i = end;
+  }
+
+  const int32_t range_num = static_cast<int32_t>(ranges.size());
+  const size_t  log_len   = sizeof(range_num) + sizeof(PartialUpdateRange) * range_num + changed_len * 2;
+  if (log_len >= static_cast<size_t>(len) * 2) {
+    return false;
+  }
+
+  log_data.resize(log_len);
+  char *buf = log_data.data();
+  memcpy(buf, &range_num, sizeof(range_num));
+  buf += sizeof(range_num);
+  if (range_num > 0) {
+    memcpy(buf, ranges.data(), sizeof(PartialUpdateRange) * range_num);
+    buf += sizeof(PartialUpdateRange) * range_num;
+  }
+  for (const PartialUpdateRange &range : ranges) {
+    memcpy(buf, old_data + range.offset, range.len);
+    buf += range.len;
+  }
+  for (const PartialUpdateRange &range : ranges) {
+    memcpy(buf, new_data + range.offset, range.len);
+    buf += range.len;
+  }
+
+  first_offset = ranges.empty() ? 0 : ranges.front().offset;
+  return true;
+}
+
+/**
+ * @brief 把 UPDATE_PARTIAL 日志中更新前后的数据分别写到 old_data 和 new_data 上
+ * @details old_data 和 new_data 开始时都是页面上当前的记录
+ */
+static RC apply_partial_update_log(const char *log_data, int log_len, int record_len, char *old_data, char *new_data)
+{
+  int32_t range_num = 0;
+  if (log_len < static_cast<int>(sizeof(range_num))) {
+    return RC::INTERNAL;
+  }
+  memcpy(&range_num, log_data, sizeof(range_num));
+
+  const int64_t ranges_len = static_cast<int64_t>(sizeof(PartialUpdateRange)) * range_num;
+  if (range_num < 0 || static_cast<int64_t>(sizeof(range_num)) + ranges_len > log_len) {
+    return RC::INTERNAL;
+  }
+
+  vector<PartialUpdateRange> ranges(range_num);
+  if (range_num > 0) {
+    memcpy(ranges.data(), log_data + sizeof(range_num), ranges_len);
+  }
+
+  int64_t changed_len = 0;
+  for (const PartialUpdateRange &range : ranges) {
+    if (range.offset < 0 || range.len <= 0 || range.offset + range.len > record_len) {
+      return RC::INTERNAL;
+    }
+    changed_len += range.len;
+  }
+  if (static_cast<int64_t>(sizeof(range_num)) + ranges_len + changed_len * 2 != log_len) {
+    return RC::INTERNAL;
+  }
+
+  const char *old_part = log_data + sizeof(range_num) + ranges_len;
+  const char *new_part = old_part + changed_len;
+  for (const PartialUpdateRange &range : ranges) {
+    memcpy(old_data + range.offset, old_part, range.len);
+    memcpy(new_data + range.offset, new_part, range.len);
+    old_part += range.len;
+    new_part += range.len;
+  }
+  return RC::SUCCESS;
+}
+
+RC MvccTrx::update_record(Table *table, Record &record, const char *new_data)
+{
+  Field begin_field;
+  Field end_field;
+  trx_fields(table, begin_field, end_field);
+
+  /// 与删除一样，获取record时已经做过检查，这里一定是当前事务可以修改的最新版本
+  [[maybe_unused]] int32_t end_xid = end_field.get_int(record);
+  ASSERT(end_xid == trx_kit_.max_trx_id(),
+         "concurrency conflit: other transaction is updating this record. end_xid=%d, current trx id=%d, rid=%s",
+         end_xid, trx_id_, record.rid().to_string().c_str());
+
+  // 日志数据是更新前的记录加上更新后的记录，变长记录的两部分长度可能不同
+  const TableMeta &table_meta = table->table_meta();
+  const int old_len = table_meta.record_len(record.data());
+  const int new_len = table_meta.record_len(new_data);
+  vector<char> log_data(old_len + new_len);
+  Record old_version;
+  old_version.set_rid(record.rid());
+  old_version.set_data(log_data.data(), old_len);
+  memcpy(old_version.data(), record.data(), old_len);
+  end_field.set_int(old_version, -trx_id_);
+
+  Record new_version;
+  new_version.set_rid(record.rid());
+  new_version.set_data(log_data.data() + old_len, new_len);
+  memcpy(new_version.data(), new_data, new_len);
+  begin_field.set_int(new_version, -trx_id_);
+  end_field.set_int(new_version, trx_kit_.max_trx_id());
+
+  // 当前事务已经插入或更新过这条记录时，覆盖的是自己没有提交的数据，不需要保存旧版本
+  const Operation operation(Operation::Type::UPDATE, table, record.rid());
+  const bool first_modify = operations_.find(operation) == operations_.end();
+
+  // 记录长度不变时只记录修改过的几段数据，需要在页面上的数据被覆盖之前比较
+  vector<char> partial_log;
+  int32_t      partial_offset = 0;
+  const bool   partial        = old_len == new_len &&
+      make_partial_update_log(record.data(), new_version.data(), new_len, partial_log, partial_offset);
+
+  RC rc = table->update_record(record, new_version.data());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to update record. table=%s, rid=%s, rc=%s", table->name(), record.rid().to_string().c_str(), strrc(rc));
+    return rc;
+  }
+
+  if (first_modify) {
+    // 旧版本要在其它事务访问新版本之前放到版本链上，当前事务还持有页面的写锁
+    rc = trx_kit_.version_store().push(table->table_id(), record.rid(), old_version.data(), old_len);
+    ASSERT(rc == RC::SUCCESS, "failed to save old version. rid=%s, rc=%s", record.rid().to_string().c_str(), strrc(rc));
+    operations_.insert(operation);
+  } else {
+    // 被覆盖的是当前事务自己写入的版本，其它事务看不到，它独有的 TEXT 溢出页可以直接释放
+    vector<PageNum> texts;
+    table->collect_texts(old_version.data(), new_version.data(), texts);
+    table->remove_texts(texts);
+  }
+
+  if (partial) {
+    rc = log_manager_->append_log(CLogType::UPDATE_PARTIAL, trx_id_, table->table_id(), record.rid(),
+                                  static_cast<int32_t>(partial_log.size()), partial_offset, partial_log.data());
+  } else {
+    rc = log_manager_->append_log(CLogType::UPDATE, trx_id_, table->table_id(), record.rid(), 
+                                  static_cast<int32_t>(log_data.size()), 0/*offset*/, log_data.data());
+  }
+  ASSERT(rc == RC::SUCCESS, "failed to append update record log. trx id=%d, table id=%d, rid=%s, record len=%d, rc=%s",
+      trx_id_, table->table_id(), record.rid().to_string().c_str(), new_len, strrc(rc));
+  return rc;
+}
+
 RC MvccTrx::visit_record(Table *table, Record &record, bool readonly)
 {
   Field begin_field;
@@ -194,31 +480,116 @@ RC MvccTrx::visit_record(Table *table, Record &record, bool readonly)
   int32_t begin_xid = begin_field.get_int(record);
   int32_t end_xid = end_field.get_int(record);
 
-  RC rc = RC::SUCCESS;
-  if (begin_xid > 0 && end_xid > 0) {
-    if (trx_id_ >= begin_xid && trx_id_ <= end_xid) {
-      rc = RC::SUCCESS;
+  if (readonly) {
+    if (version_visible(begin_xid, end_xid)) {
+      return RC::SUCCESS;
+    }
+
+    // 最新版本不可见，可能是被其它事务更新了，沿着版本链找对当前事务可见的旧版本
+    auto visible = [this, &begin_field, &end_field](Record &version) {
+      return version_visible(begin_field.get_int(version), end_field.get_int(version));
+    };
+    return trx_kit_.version_store().find_visible(table->table_id(), record.rid(), visible, record);
+  }
+
+  // 修改数据时只能修改最新版本，要先拿到这条记录的排它锁
+  // 与其它事务的修改冲突时，由调用者释放页面锁之后调用 wait_lock 排队等待
+  const RowLockKey lock_key{table->table_id(), record.rid()};
+  RC rc = trx_kit_.lock_manager().try_lock(lock_owner_, lock_key, LockMode::EXCLUSIVE);
+  if (rc == RC::LOCKED_NEED_WAIT) {
+    pending_lock_ = lock_key;
+    return rc;
+  } else if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 拿到锁之后，其它事务对这条记录的修改都已经结束了，修改的是最新提交的版本
+  if (begin_xid < 0) {
+    if (-begin_xid == trx_id_) {
+      // 当前事务插入或更新的数据，也可能又被当前事务删除了
+      rc = (end_xid < 0) ? RC::RECORD_INVISIBLE : RC::SUCCESS;
     } else {
-      rc = RC::RECORD_INVISIBLE;
+      // 持有锁时不应该看到其它事务没有提交的数据
+      LOG_WARN("got uncommitted record while holding its lock. begin xid=%d, trx id=%d, rid=%s",
+               begin_xid, trx_id_, record.rid().to_string().c_str());
+      rc = RC::LOCKED_CONCURRENCY_CONFLICT;
     }
-  } else if (begin_xid < 0) {
-    // begin xid 小于0说明是刚插入而且没有提交的数据
-    rc = (-begin_xid == trx_id_) ? RC::SUCCESS : RC::RECORD_INVISIBLE;
   } else if (end_xid < 0) {
     // end xid 小于0 说明是正在删除但是还没有提交的数据
-    if (readonly) {
-      // 如果 -end_xid 就是当前事务的事务号，说明是当前事务删除的
-      rc = (-end_xid != trx_id_) ? RC::SUCCESS : RC::RECORD_INVISIBLE;
-    } else {
-      // 如果当前想要修改此条数据，并且不是当前事务删除的，简单的报错
-      // 这是事务并发处理的一种方式，非常简单粗暴。其它的并发处理方法，可以等待，或者让客户端重试
-      // 或者等事务结束后，再检测修改的数据是否有冲突
-      rc = (-end_xid != trx_id_) ? RC::LOCKED_CONCURRENCY_CONFLICT : RC::RECORD_INVISIBLE;
-    }
+    rc = (-end_xid != trx_id_) ? RC::LOCKED_CONCURRENCY_CONFLICT : RC::RECORD_INVISIBLE;
+  } else {
+    // 删除已经提交的数据不能再修改
+    rc = (end_xid == trx_kit_.max_trx_id()) ? RC::SUCCESS : RC::RECORD_INVISIBLE;
+  }
+
+  if (rc == RC::RECORD_INVISIBLE) {
+    skip_record(table, record);
+  }
+  return rc;
+}
+
+RC MvccTrx::wait_lock()
+{
+  return abort_if_lock_failed(trx_kit_.lock_manager().wait(lock_owner_, pending_lock_));
+}
+
+RC MvccTrx::abort_if_lock_failed(RC rc)
+{
+  if (rc == RC::LOCKED_DEADLOCK || rc == RC::LOCKED_WAIT_TIMEOUT) {
+    LOG_WARN("trx aborted because of lock failure. trx id=%d, rc=%s", trx_id_, strrc(rc));
+    abort_rc_ = rc;
   }
   return rc;
 }
 
+void MvccTrx::skip_record(Table *table, const Record &record)
+{
+  Field begin_field;
+  Field end_field;
+  trx_fields(table, begin_field, end_field);
+
+  // 当前事务修改过的记录，锁要保持到事务结束
+  if (begin_field.get_int(record) == -trx_id_ || end_field.get_int(record) == -trx_id_) {
+    return;
+  }
+  trx_kit_.lock_manager().unlock(lock_owner_, RowLockKey{table->table_id(), record.rid()});
+}
+
+const MvccReadView &MvccTrx::read_view() const
+{
+  const MvccReadView *view = read_view_ptr_.load(memory_order_acquire);
+  if (view == nullptr) {
+    lock_guard<mutex> guard(read_view_lock_);
+    view = read_view_ptr_.load(memory_order_relaxed);
+    if (view == nullptr) {
+      read_view_ = trx_kit_.read_view(*this);
+      view       = read_view_.get();
+      read_view_ptr_.store(view, memory_order_release);
+    }
+  }
+  return *view;
+}
+
+bool MvccTrx::version_visible(int32_t begin_xid, int32_t end_xid) const
+{
+  // begin xid 小于0说明是刚插入或更新而且没有提交的数据
+  if (begin_xid < 0) {
+    if (-begin_xid != trx_id_) {
+      return false;
+    }
+  } else if (!read_view().visible(begin_xid)) {
+    return false;
+  }
+
+  // end xid 小于0 说明是正在删除(或者被更新)但是还没有提交的数据
+  // 如果 -end_xid 就是当前事务的事务号，说明是当前事务删除的
+  if (end_xid < 0) {
+    return -end_xid != trx_id_;
+  }
+  // 删除(或更新)的提交对当前事务不可见时，这个版本就还是可见的。没有删除的数据结束事务号是最大值，总是不可见
+  return !read_view().visible(end_xid);
+}
+
 /**
  * @brief 获取指定表上的事务使用的字段
  * 
@@ -240,28 +611,39 @@ void MvccTrx::trx_fields(Table *table, Field &begin_xid_field, Field &end_xid_fi
 
 RC MvccTrx::start_if_need()
 {
+  if (aborted()) {
+    return abort_rc_;
+  }
   if (!started_) {
     ASSERT(operations_.empty(), "try to start a new trx while operations is not empty");
-    trx_id_ = trx_kit_.next_trx_id();
+    trx_kit_.start_trx(*this);
     LOG_DEBUG("current thread change to new trx with %d", trx_id_);
     RC rc = log_manager_->begin_trx(trx_id_);
     ASSERT(rc == RC::SUCCESS, "failed to append log to clog. rc=%s", strrc(rc));
-    started_ = true;
   }
   return RC::SUCCESS;
 }
 
 RC MvccTrx::commit()
 {
-  int32_t commit_id = trx_kit_.next_trx_id();
+  if (aborted()) {
+    // 中止的事务不能提交，回滚已经做的修改，并且告诉调用者提交失败的原因
+    RC rc = abort_rc_;
+    rollback();
+    return rc;
+  }
+
+  int32_t commit_id = trx_kit_.start_commit(*this);
   return commit_with_trx_id(commit_id);
 }
 
 RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
 {
-  // TODO 这里存在一个很大的问题，不能让其他事务一次性看到当前事务更新到的数据或同时看不到
+  // 提交事务号在 finish_trx 之前都是活跃的，在这之前开始的事务看不到当前事务修改的任何数据
   RC rc = RC::SUCCESS;
   started_ = false;
+
+  long garbage_count = 0;
   
   for (const Operation &operation : operations_) {
     switch (operation.type()) {
@@ -271,7 +653,7 @@ RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
         Field begin_xid_field, end_xid_field;
         trx_fields(table, begin_xid_field, end_xid_field);
 
-        auto record_updater = [ this, &begin_xid_field, commit_xid](Record &record) {
+        auto record_updater = [ this, &begin_xid_field, &end_xid_field, commit_xid](Record &record) {
           LOG_DEBUG("before commit insert record. trx id=%d, begin xid=%d, commit xid=%d, lbt=%s",
                     trx_id_, begin_xid_field.get_int(record), commit_xid, lbt());
           ASSERT(begin_xid_field.get_int(record) == -this->trx_id_, 
@@ -279,6 +661,10 @@ RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
                  begin_xid_field.get_int(record), trx_id_);
 
           begin_xid_field.set_int(record, commit_xid);
+          if (end_xid_field.get_int(record) == -trx_id_) {
+            // 同一个事务中又删除了这条记录
+            end_xid_field.set_int(record, commit_xid);
+          }
         };
 
         rc = operation.table()->visit_record(rid, false/*readonly*/, record_updater);
@@ -286,7 +672,43 @@ RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
                rid.to_string().c_str(), strrc(rc));
       } break;
 
+      case Operation::Type::UPDATE: {
+        garbage_count++;  // 被替换掉的旧版本
+        RID rid(operation.page_num(), operation.slot_num());
+        Table *table = operation.table();
+        Field begin_xid_field, end_xid_field;
+        trx_fields(table, begin_xid_field, end_xid_field);
+
+        auto record_updater = [this, &begin_xid_field, &end_xid_field, commit_xid](Record &record) {
+          ASSERT(begin_xid_field.get_int(record) == -trx_id_, 
+                 "got an invalid record while committing. begin xid=%d, this trx id=%d", 
+                 begin_xid_field.get_int(record), trx_id_);
+
+          begin_xid_field.set_int(record, commit_xid);
+          if (end_xid_field.get_int(record) == -trx_id_) {
+            end_xid_field.set_int(record, commit_xid);
+          }
+        };
+
+        // 先提交新版本再修改旧版本的结束事务号，其它事务在这两步之间也能看到正确的版本
+        rc = table->visit_record(rid, false/*readonly*/, record_updater);
+        ASSERT(rc == RC::SUCCESS, "failed to get record while committing. rid=%s, rc=%s",
+               rid.to_string().c_str(), strrc(rc));
+
+        auto version_updater = [this, &end_xid_field, commit_xid](Record &version) {
+          (void)this;
+          ASSERT(end_xid_field.get_int(version) == -trx_id_, 
+                 "got an invalid version while committing. end xid=%d, this trx id=%d", 
+                 end_xid_field.get_int(version), trx_id_);
+          end_xid_field.set_int(version, commit_xid);
+        };
+        rc = trx_kit_.version_store().update_latest(table->table_id(), rid, version_updater);
+        ASSERT(rc == RC::SUCCESS, "failed to get old version while committing. rid=%s, rc=%s",
+               rid.to_string().c_str(), strrc(rc));
+      } break;
+
       case Operation::Type::DELETE: {
+        garbage_count++;
         Table *table = operation.table();
         RID rid(operation.page_num(), operation.slot_num());
         
@@ -314,9 +736,11 @@ RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
   }
 
   operations_.clear();
+  trx_kit_.add_garbage(garbage_count);
 
   if (!recovering_) {
     rc = log_manager_->commit_trx(trx_id_, commit_xid);
+    trx_kit_.finish_trx(*this, commit_xid);
   }
   LOG_TRACE("append trx commit log. trx id=%d, commit_xid=%d, rc=%s", trx_id_, commit_xid, strrc(rc));
   return rc;
@@ -340,11 +764,44 @@ RC MvccTrx::rollback()
         rc = table->get_record(rid, record); 
         ASSERT(rc == RC::SUCCESS, "failed to get record while rollback. rid=%s, rc=%s", 
                rid.to_string().c_str(), strrc(rc));
-        rc = table->delete_record(record);
+        if (recovering_) {
+          // 恢复时索引的数据来自于索引日志，可能没有这条记录对应的索引项
+          rc = table->recover_delete_record(record);
+        } else {
+          rc = table->delete_record(record);
+        }
         ASSERT(rc == RC::SUCCESS, "failed to delete record while rollback. rid=%s, rc=%s",
               rid.to_string().c_str(), strrc(rc));
       } break;
 
+      case Operation::Type::UPDATE: {
+        Table *table = operation.table();
+        RID rid(operation.page_num(), operation.slot_num());
+        Field begin_xid_field, end_xid_field;
+        trx_fields(table, begin_xid_field, end_xid_field);
+
+        Record old_version;
+        rc = trx_kit_.version_store().pop(table->table_id(), rid, old_version);
+        ASSERT(rc == RC::SUCCESS, "failed to get old version while rollback. rid=%s, rc=%s",
+               rid.to_string().c_str(), strrc(rc));
+        end_xid_field.set_int(old_version, trx_kit_.max_trx_id());
+
+        vector<PageNum> texts;
+        auto record_updater = [this, table, &old_version, &texts, &rc](Record &record) {
+          if (recovering_) {
+            rc = table->recover_update_record(record, old_version.data());
+          } else {
+            table->collect_texts(record.data(), old_version.data(), texts);
+            rc = table->update_record(record, old_version.data());
+          }
+        };
+        RC rc2 = table->visit_record(rid, false/*readonly*/, record_updater);
+        ASSERT(rc2 == RC::SUCCESS && rc == RC::SUCCESS, "failed to restore record while rollback. rid=%s, rc=%s",
+               rid.to_string().c_str(), strrc(OB_FAIL(rc2) ? rc2 : rc));
+        // 恢复时不知道崩溃前是否已经释放过，只在正常回滚时释放新版本的 TEXT 溢出页
+        table->remove_texts(texts);
+      } break;
+
       case Operation::Type::DELETE: {
         Table *table = operation.table();
         RID rid(operation.page_num(), operation.slot_num());
@@ -374,9 +831,11 @@ RC MvccTrx::rollback()
   }
 
   operations_.clear();
+  abort_rc_ = RC::SUCCESS;
 
   if (!recovering_) {
     rc = log_manager_->rollback_trx(trx_id_);
+    trx_kit_.finish_trx(*this, 0);
   }
   LOG_TRACE("append trx rollback log. trx id=%d, rc=%s", trx_id_, strrc(rc));
   return rc;
@@ -386,7 +845,9 @@ RC find_table(Db *db, const CLogRecord &log_record, Table *&table)
 {
   switch (clog_type_from_integer(log_record.header().type_)) {
     case CLogType::INSERT:
-    case CLogType::DELETE: {
+    case CLogType::DELETE:
+    case CLogType::UPDATE:
+    case CLogType::UPDATE_PARTIAL: {
       const CLogRecordData &data_record = log_record.data_record();
       table = db->find_table(data_record.table_id_);
       if (nullptr == table) {
@@ -402,6 +863,31 @@ RC find_table(Db *db, const CLogRecord &log_record, Table *&table)
   return RC::SUCCESS;
 }
 
+RC MvccTrx::redo_update(
+    Table *table, const RID &rid, const char *old_data, int old_len, const char *new_data, int new_len)
+{
+  const Operation operation(Operation::Type::UPDATE, table, rid);
+  const bool first_modify = operations_.find(operation) == operations_.end();
+  if (first_modify) {
+    // 回滚时需要旧版本
+    RC rc = trx_kit_.version_store().push(table->table_id(), rid, old_data, old_len);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to save old version. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
+      return rc;
+    }
+  }
+
+  // 索引有自己的日志，这里只恢复记录数据
+  RC rc = table->record_handler()->update_record(rid, new_data, new_len);
+  ASSERT(rc == RC::SUCCESS, "failed to get record while redo update. rid=%s, rc=%s",
+         rid.to_string().c_str(), strrc(rc));
+
+  if (first_modify) {
+    operations_.insert(operation);
+  }
+  return rc;
+}
+
 RC MvccTrx::redo(Db *db, const CLogRecord &log_record)
 {
   Table *table = nullptr;
@@ -447,8 +933,56 @@ RC MvccTrx::redo(Db *db, const CLogRecord &log_record)
       operations_.insert(Operation(Operation::Type::DELETE, table, data_record.rid_));
     } break;
 
+    case CLogType::UPDATE: {
+      const CLogRecordData &data_record = log_record.data_record();
+      const int old_len = table->table_meta().record_len(data_record.data_);
+      const char *old_data = data_record.data_;
+      const char *new_data = data_record.data_ + old_len;
+      const int new_len = data_record.data_len_ - old_len;
+
+      RC rc = redo_update(table, data_record.rid_, old_data, old_len, new_data, new_len);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to redo update. log record=%s, rc=%s", log_record.to_string().c_str(), strrc(rc));
+        return rc;
+      }
+    } break;
+
+    case CLogType::UPDATE_PARTIAL: {
+      const CLogRecordData &data_record = log_record.data_record();
+      Record current;
+      RC rc = table->get_record(data_record.rid_, current);
+      ASSERT(rc == RC::SUCCESS, "failed to get record while redo update. rid=%s, rc=%s",
+             data_record.rid_.to_string().c_str(), strrc(rc));
+
+      // 前后两个版本都从页面上的记录开始，再写入日志中的数据
+      const int len = current.len();
+      vector<char> data(len * 2);
+      Record old_version;
+      old_version.set_data(data.data(), len);
+      memcpy(data.data(), current.data(), len);
+      memcpy(data.data() + len, current.data(), len);
+      rc = apply_partial_update_log(data_record.data_, data_record.data_len_, len, data.data(), data.data() + len);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("invalid partial update log. log record=%s, rc=%s", log_record.to_string().c_str(), strrc(rc));
+        return rc;
+      }
+
+      // 与 UPDATE 日志中的旧版本一样，由当前事务删除
+      Field begin_field;
+      Field end_field;
+      trx_fields(table, begin_field, end_field);
+      end_field.set_int(old_version, -trx_id_);
+
+      rc = redo_update(table, data_record.rid_, data.data(), len, data.data() + len, len);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to redo update. log record=%s, rc=%s", log_record.to_string().c_str(), strrc(rc));
+        return rc;
+      }
+    } break;
+
     case CLogType::MTR_COMMIT: {
       const CLogRecordCommitData &commit_record = log_record.commit_record();
+      trx_kit_.recover_trx_id(commit_record.commit_xid_);
       commit_with_trx_id(commit_record.commit_xid_);
     } break;
 
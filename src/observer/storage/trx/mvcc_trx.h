@@ -14,16 +14,23 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <mutex>
+#include <unordered_set>
 #include <vector>
 
 #include "storage/trx/trx.h"
+#include "storage/trx/mvcc_version_store.h"
+#include "storage/trx/mvcc_vacuum.h"
+#include "storage/trx/mvcc_read_view.h"
+#include "storage/trx/lock_manager.h"
 
 class CLogManager;
+class MvccTrx;
 
 class MvccTrxKit : public TrxKit
 {
 public:
-  MvccTrxKit() = default;
+  MvccTrxKit();
   virtual ~MvccTrxKit();
 
   RC init() override;
@@ -34,30 +41,111 @@ public:
 
   /**
    * @brief 找到对应事务号的事务
-   * @details 当前仅在recover场景下使用
+   * @details 当前仅在recover场景下使用，需要遍历所有的分片
    */
   Trx *find_trx(int32_t trx_id) override;
   void all_trxes(std::vector<Trx *> &trxes) override;
 
+  /**
+   * @brief 回收删除提交后没有事务能看到的记录，以及没有事务能访问的旧版本
+   * @details 只有上次回收之后有事务提交了删除或更新时才会扫描表
+   */
+  RC vacuum(const std::vector<Table *> &tables) override;
+
 public:
-  int32_t next_trx_id();
+  /**
+   * @brief 开始一个事务，分配事务号
+   * @details 读视图在事务第一次判断可见性时才获取，只做修改的事务不需要生成读视图
+   */
+  void start_trx(MvccTrx &trx);
+
+  /**
+   * @brief 事务开始提交，分配提交事务号
+   * @details 提交事务号在 finish_trx 之前都是活跃的，这期间开始的事务看不到当前事务的修改
+   */
+  int32_t start_commit(MvccTrx &trx);
+
+  /**
+   * @brief 事务提交或回滚结束，从活跃事务集合中移除
+   * @param commit_xid 提交事务号，回滚时是0
+   */
+  void finish_trx(MvccTrx &trx, int32_t commit_xid);
+
+  /**
+   * @brief 最老的活跃事务号
+   * @details 结束事务号比它小的数据，已经没有事务能访问了。没有活跃事务时返回下一个事务号
+   */
+  int32_t oldest_active_trx_id() const { return active_trxes_.horizon(); }
+
+  /**
+   * @brief 获取活跃事务要使用的读视图
+   * @details 活跃事务集合没有变化时复用上次生成的视图
+   */
+  std::shared_ptr<const MvccReadView> read_view(const MvccTrx &trx);
+
+  /**
+   * @brief 当前最新的读视图，活跃事务集合没有变化时复用上次生成的视图
+   */
+  std::shared_ptr<const MvccReadView> read_view() { return active_trxes_.read_view(); }
+
+  /**
+   * @brief 恢复时遇到的事务号或提交事务号，之后分配的事务号都要比它大
+   */
+  void recover_trx_id(int32_t trx_id) { active_trxes_.advance_to(trx_id); }
+
+  /**
+   * @brief 有事务提交了删除或更新，产生了需要回收的数据
+   */
+  void add_garbage(long count) { garbage_count_ += count; }
+
+  const MvccVacuumStat &vacuum_stat() const { return vacuum_.stat(); }
 
 public:
   int32_t max_trx_id() const;
 
+  MvccVersionStore &version_store() { return version_store_; }
+  LockManager      &lock_manager() { return lock_manager_; }
+
+private:
+  /**
+   * @brief 事务对象按照地址分片保存，创建和销毁事务时只锁一个分片
+   */
+  struct alignas(64) TrxShard
+  {
+    common::Mutex             lock;
+    std::unordered_set<Trx *> trxes;
+  };
+
+  static constexpr int TRX_SHARD_NUM = 16;
+
+  TrxShard &shard_of(const Trx *trx);
+
+  /**
+   * @brief 事务在活跃事务集合中使用的分片
+   */
+  static size_t active_hint(const Trx *trx);
+
 private:
   std::vector<FieldMeta> fields_; // 存储事务数据需要用到的字段元数据，所有表结构都需要带的
 
-  std::atomic<int32_t> current_trx_id_{0};
+  MvccActiveTrxSet active_trxes_;  ///< 分配事务号，维护活跃事务和读视图
+  TrxShard         shards_[TRX_SHARD_NUM];
+
+  MvccVersionStore version_store_;  ///< 被更新的记录的旧版本
+  LockManager      lock_manager_;   ///< 修改数据时加的行锁
 
-  common::Mutex      lock_;
-  std::vector<Trx *> trxes_;
+  MvccVacuum        vacuum_;
+  std::atomic<long> garbage_count_{1};  ///< 还没有回收的删除或更新。启动前留下的垃圾数据不知道有多少，所以第一次总会回收
 };
 
 /**
  * @brief 多版本并发事务
  * @ingroup Transaction
- * TODO 没有垃圾回收
+ * @details 表中存放的是记录的最新版本，更新前的版本保存在 MvccVersionStore 中。
+ * 只读访问时如果最新版本不可见，就沿着版本链找可见的旧版本，所以读不会因为写而失败。
+ * 修改只能针对最新版本，修改前要对记录加排它锁，与其它事务的修改冲突时排队等待，
+ * 拿到锁之后修改的是最新提交的版本。锁在事务结束时释放。
+ * 可见性由事务第一次读数据时获取的读视图判断，正在提交的事务的修改要么全部可见，要么全部不可见。
  */
 class MvccTrx : public Trx
 {
@@ -68,6 +156,7 @@ public:
 
   RC insert_record(Table *table, Record &record) override;
   RC delete_record(Table *table, Record &record) override;
+  RC update_record(Table *table, Record &record, const char *new_data) override;
 
   /**
    * @brief 当访问到某条数据时，使用此函数来判断是否可见，或者是否有访问冲突
@@ -75,24 +164,52 @@ public:
    * @param table    要访问的数据属于哪张表
    * @param record   要访问哪条数据
    * @param readonly 是否只读访问
-   * @return RC      - SUCCESS 成功
+   * @return RC      - SUCCESS 成功。只读访问时，record 可能被替换成对当前事务可见的旧版本
    *                 - RECORD_INVISIBLE 此数据对当前事务不可见，应该跳过
-   *                 - LOCKED_CONCURRENCY_CONFLICT 与其它事务有冲突
+   *                 - LOCKED_NEED_WAIT 其它事务持有这条记录的锁，需要调用 wait_lock 等待。只读访问不会出现
    */
   RC visit_record(Table *table, Record &record, bool readonly) override;
+  RC wait_lock() override;
+  void skip_record(Table *table, const Record &record) override;
 
   RC start_if_need() override;
   RC commit() override;
   RC rollback() override;
+  bool aborted() const override { return abort_rc_ != RC::SUCCESS; }
 
   RC redo(Db *db, const CLogRecord &log_record) override;
 
   int32_t id() const override { return trx_id_; }
 
 private:
+  friend class MvccTrxKit;  // 开始和结束事务时由 MvccTrxKit 设置事务号和读视图
+
   RC commit_with_trx_id(int32_t commit_id);
   void trx_fields(Table *table, Field &begin_xid_field, Field &end_xid_field) const;
 
+  /**
+   * @brief 重做更新日志，第一次修改这条记录时把旧版本放到版本链上
+   */
+  RC redo_update(Table *table, const RID &rid, const char *old_data, int old_len, const char *new_data, int new_len);
+
+  /**
+   * @brief 当前事务的读视图，第一次调用时获取
+   * @details 并行扫描时多个线程会同时判断可见性，所以获取视图要加锁，之后只读一个原子指针
+   */
+  const MvccReadView &read_view() const;
+
+  /**
+   * @brief 某个版本的数据对当前事务是否可见
+   */
+  bool version_visible(int32_t begin_xid, int32_t end_xid) const;
+
+  /**
+   * @brief 加锁失败时中止事务
+   * @details 没有语句级的回滚，当前语句已经做的修改无法单独撤销，所以整个事务只能回滚。
+   * 持有的锁保留到回滚时释放
+   */
+  RC abort_if_lock_failed(RC rc);
+
 private:
   static const int32_t MAX_TRX_ID = std::numeric_limits<int32_t>::max();
 
@@ -101,7 +218,13 @@ private:
   MvccTrxKit & trx_kit_;
   CLogManager *log_manager_ = nullptr;
   int32_t      trx_id_ = -1;
-  bool         started_ = false;
+  std::atomic<bool> started_{false};
+  mutable std::mutex                          read_view_lock_;
+  mutable std::shared_ptr<const MvccReadView> read_view_;  ///< 第一次判断可见性时获取的读视图，恢复时不需要
+  mutable std::atomic<const MvccReadView *>   read_view_ptr_{nullptr};
+  LockOwner    lock_owner_;    ///< 当前事务持有的行锁
+  RowLockKey   pending_lock_;  ///< 正在等待的行锁
+  RC           abort_rc_ = RC::SUCCESS;  ///< 事务被中止的原因，SUCCESS 表示没有中止
   bool         recovering_ = false;
   OperationSet operations_;
 };
@@ -0,0 +1,203 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <limits>
+
+#include "storage/trx/mvcc_vacuum.h"
+#include "storage/trx/mvcc_version_store.h"
+#include "storage/table/table.h"
+#include "storage/field/field.h"
+#include "storage/record/record_manager.h"
+#include "common/log/log.h"
+#include "common/metrics/metrics.h"
+#include "common/metrics/metrics_registry.h"
+
+using namespace std;
+using namespace common;
+
+namespace {
+
+/**
+ * @brief 某个版本是否已经没有事务能访问
+ * @details 结束事务号是已经提交的事务号，并且比所有活跃事务都小。未提交的删除或更新，结束事务号是负数
+ */
+bool version_dead(Field &end_xid_field, const Record &record, int32_t oldest_active_trx_id)
+{
+  const int32_t end_xid = end_xid_field.get_int(record);
+  return end_xid > 0 && end_xid != numeric_limits<int32_t>::max() && end_xid < oldest_active_trx_id;
+}
+
+}  // namespace
+
+MvccVacuum::MvccVacuum(MvccVersionStore &version_store) : version_store_(version_store)
+{
+  register_metrics();
+}
+
+MvccVacuum::~MvccVacuum()
+{
+  unregister_metrics();
+}
+
+void MvccVacuum::register_metrics()
+{
+  const pair<const char *, const atomic<long> *> items[] = {
+      {"mvcc.vacuum.passes", &stat_.passes},
+      {"mvcc.vacuum.tables_vacuumed", &stat_.tables_vacuumed},
+      {"mvcc.vacuum.records_scanned", &stat_.records_scanned},
+      {"mvcc.vacuum.records_removed", &stat_.records_removed},
+      {"mvcc.vacuum.versions_removed", &stat_.versions_removed},
+      {"mvcc.vacuum.bytes_reclaimed", &stat_.bytes_reclaimed},
+      {"mvcc.vacuum.oldest_active_trx_id", &stat_.oldest_active_trx_id},
+  };
+
+  MetricsRegistry &registry = get_metrics_registry();
+  for (const auto &item : items) {
+    unique_ptr<Metric> metric(new AtomicGauge(*item.second));
+    registry.register_metric(item.first, metric.get());
+    metrics_.emplace_back(item.first, std::move(metric));
+  }
+}
+
+void MvccVacuum::unregister_metrics()
+{
+  MetricsRegistry &registry = get_metrics_registry();
+  for (const auto &metric : metrics_) {
+    registry.unregister(metric.first);
+  }
+  metrics_.clear();
+}
+
+RC MvccVacuum::vacuum_table(Table *table, int32_t oldest_active_trx_id, long &reclaimed)
+{
+  reclaimed = 0;
+
+  const TableMeta &table_meta = table->table_meta();
+  const pair<const FieldMeta *, int> trx_fields = table_meta.trx_fields();
+  if (trx_fields.second < 2) {
+    return RC::SUCCESS;
+  }
+
+  Field end_xid_field(table, &trx_fields.first[1]);
+
+  // 回收的版本中有 TEXT 字段时，和比它新的版本引用的溢出页不同，就说明这个溢出页只被它引用，可以一起释放
+  const bool has_text = table_meta.has_text_field();
+  vector<PageNum> dead_texts;
+  vector<Record>  newest_dead_versions;  // 整条版本链都被回收时，最新的旧版本要和表中的记录比较
+  auto version_removed = [table, has_text, &dead_texts, &newest_dead_versions](Record &version, Record *newer) {
+    if (!has_text) {
+      return;
+    }
+    if (newer != nullptr) {
+      table->collect_texts(version.data(), newer->data(), dead_texts);
+      return;
+    }
+    char *data = (char *)malloc(version.len());
+    ASSERT(nullptr != data, "failed to allocate memory. size=%d", version.len());
+    memcpy(data, version.data(), version.len());
+    Record copy;
+    copy.set_rid(version.rid());
+    copy.set_data_owner(data, version.len());
+    newest_dead_versions.push_back(copy);
+  };
+
+  // 先回收版本链上的旧版本
+  long version_bytes = 0;
+  const int versions = version_store_.purge(table->table_id(),
+      [&end_xid_field, oldest_active_trx_id](Record &version) {
+        return version_dead(end_xid_field, version, oldest_active_trx_id);
+      },
+      version_bytes, version_removed);
+  for (Record &version : newest_dead_versions) {
+    // 拿着页面锁比较，回收之后记录又被更新过时，新的旧版本可能也引用了这个溢出页，这里保守地不释放
+    const RID rid = version.rid();
+    table->visit_record(rid, true /*readonly*/, [this, table, &version, &rid, &dead_texts](Record &record) {
+      if (!version_store_.has_versions(table->table_id(), rid)) {
+        table->collect_texts(version.data(), record.data(), dead_texts);
+      }
+    });
+  }
+  table->remove_texts(dead_texts);
+  stat_.versions_removed += versions;
+  stat_.bytes_reclaimed += version_bytes;
+  reclaimed += versions;
+
+  // 扫描时拿着页面锁，不能删除记录，先把可以回收的记录收集起来
+  // 这些记录的删除已经提交，并且没有事务能看到，所以在真正删除之前也不会再被修改
+  vector<Record> dead_records;
+  long scanned = 0;
+  RecordFileScanner scanner;
+  RC rc = table->get_record_scanner(scanner, nullptr /*trx*/, true /*readonly*/);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open scanner for vacuum. table=%s, rc=%s", table->name(), strrc(rc));
+    return rc;
+  }
+
+  Record record;
+  while (scanner.has_next()) {
+    rc = scanner.next(record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to scan record for vacuum. table=%s, rc=%s", table->name(), strrc(rc));
+      break;
+    }
+
+    scanned++;
+    if (version_dead(end_xid_field, record, oldest_active_trx_id)) {
+      char *data = (char *)malloc(record.len());
+      ASSERT(nullptr != data, "failed to allocate memory. size=%d", record.len());
+      memcpy(data, record.data(), record.len());
+
+      Record dead_record;
+      dead_record.set_rid(record.rid());
+      dead_record.set_data_owner(data, record.len());
+      dead_records.push_back(dead_record);
+    }
+  }
+  scanner.close_scan();
+  stat_.records_scanned += scanned;
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  for (const Record &dead_record : dead_records) {
+    // 槽位可能会被新的记录重用，要先把旧版本删掉
+    const int removed_versions = version_store_.remove(table->table_id(), dead_record.rid(),
+        [table, &dead_record, &dead_texts](Record &version) {
+          table->collect_texts(version.data(), dead_record.data(), dead_texts);
+        });
+    table->remove_texts(dead_texts);
+    stat_.versions_removed += removed_versions;
+    stat_.bytes_reclaimed += static_cast<long>(removed_versions) * table_meta.record_size();
+
+    rc = table->delete_record(dead_record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to remove dead record. table=%s, rid=%s, rc=%s",
+               table->name(), dead_record.rid().to_string().c_str(), strrc(rc));
+      return rc;
+    }
+
+    stat_.records_removed++;
+    stat_.bytes_reclaimed += dead_record.len();
+    reclaimed += 1 + removed_versions;
+  }
+
+  stat_.tables_vacuumed++;
+  if (reclaimed > 0) {
+    LOG_INFO("vacuum table done. table=%s, oldest active trx=%d, scanned=%ld, removed records=%d, removed versions=%d",
+             table->name(), oldest_active_trx_id, scanned, static_cast<int>(dead_records.size()), versions);
+  }
+  return RC::SUCCESS;
+}
+
+void MvccVacuum::finish_pass(int32_t oldest_active_trx_id)
+{
+  stat_.oldest_active_trx_id = oldest_active_trx_id;
+  stat_.passes++;
+}
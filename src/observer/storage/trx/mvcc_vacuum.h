@@ -0,0 +1,81 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/rc.h"
+
+class Table;
+class MvccVersionStore;
+
+namespace common {
+class Metric;
+}
+
+/**
+ * @brief 垃圾回收的统计信息
+ * @ingroup Transaction
+ * @details 会注册到 common::MetricsRegistry 中，名字以 mvcc.vacuum. 开头
+ */
+struct MvccVacuumStat
+{
+  std::atomic<long> passes{0};               ///< 完成的回收轮数
+  std::atomic<long> tables_vacuumed{0};      ///< 回收过的表的次数
+  std::atomic<long> records_scanned{0};      ///< 扫描过的记录数
+  std::atomic<long> records_removed{0};      ///< 物理删除的记录数
+  std::atomic<long> versions_removed{0};     ///< 回收的旧版本数
+  std::atomic<long> bytes_reclaimed{0};      ///< 回收的空间，包括记录和旧版本
+  std::atomic<long> oldest_active_trx_id{0}; ///< 最近一次回收时最老的活跃事务
+};
+
+/**
+ * @brief 回收多版本数据中已经没有事务能访问的数据
+ * @ingroup Transaction
+ * @details 有两类数据需要回收：
+ * - 删除已经提交，并且结束事务号比所有活跃事务都小的记录。从表文件和索引中物理删除，
+ *   记录所在页面会还给 RecordFileHandler 的空闲页面列表；
+ * - 版本链上结束事务号比所有活跃事务都小的旧版本。
+ * 由 MvccTrxKit 在后台定期调用。
+ */
+class MvccVacuum
+{
+public:
+  explicit MvccVacuum(MvccVersionStore &version_store);
+  ~MvccVacuum();
+
+  /**
+   * @brief 回收一张表上的垃圾数据
+   * @param oldest_active_trx_id 最老的活跃事务号，结束事务号比它小的数据都可以回收
+   * @param[out] reclaimed 回收的记录和旧版本数
+   */
+  RC vacuum_table(Table *table, int32_t oldest_active_trx_id, long &reclaimed);
+
+  /**
+   * @brief 一轮回收结束
+   */
+  void finish_pass(int32_t oldest_active_trx_id);
+
+  const MvccVacuumStat &stat() const { return stat_; }
+
+private:
+  void register_metrics();
+  void unregister_metrics();
+
+private:
+  MvccVersionStore &version_store_;
+  MvccVacuumStat    stat_;
+
+  std::vector<std::pair<std::string, std::unique_ptr<common::Metric>>> metrics_;
+};
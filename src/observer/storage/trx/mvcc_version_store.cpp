@@ -0,0 +1,177 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+
+#include "storage/trx/mvcc_version_store.h"
+#include "common/log/log.h"
+
+using namespace std;
+using namespace common;
+
+RC MvccVersionStore::push(int32_t table_id, const RID &rid, const char *data, int len)
+{
+  RecordVersion version;
+  version.data.reset(new char[len]);
+  version.len = len;
+  memcpy(version.data.get(), data, len);
+
+  lock_guard<mutex> guard(lock_);
+  chains_[VersionKey{table_id, rid}].push_back(std::move(version));
+  return RC::SUCCESS;
+}
+
+RC MvccVersionStore::pop(int32_t table_id, const RID &rid, Record &record)
+{
+  lock_guard<mutex> guard(lock_);
+  auto iter = chains_.find(VersionKey{table_id, rid});
+  if (iter == chains_.end() || iter->second.empty()) {
+    LOG_WARN("no version to pop. table id=%d, rid=%s", table_id, rid.to_string().c_str());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  RecordVersion &version = iter->second.back();
+  char *data = (char *)malloc(version.len);
+  ASSERT(nullptr != data, "failed to allocate memory. size=%d", version.len);
+  memcpy(data, version.data.get(), version.len);
+  record.set_data_owner(data, version.len);
+  record.set_rid(rid);
+  iter->second.pop_back();
+  if (iter->second.empty()) {
+    chains_.erase(iter);
+  }
+  return RC::SUCCESS;
+}
+
+RC MvccVersionStore::update_latest(int32_t table_id, const RID &rid, const function<void(Record &)> &updater)
+{
+  lock_guard<mutex> guard(lock_);
+  auto iter = chains_.find(VersionKey{table_id, rid});
+  if (iter == chains_.end() || iter->second.empty()) {
+    LOG_WARN("no version to update. table id=%d, rid=%s", table_id, rid.to_string().c_str());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  RecordVersion &version = iter->second.back();
+  Record record;
+  record.set_rid(rid);
+  record.set_data(version.data.get(), version.len);
+  updater(record);
+  return RC::SUCCESS;
+}
+
+RC MvccVersionStore::find_visible(
+    int32_t table_id, const RID &rid, const function<bool(Record &)> &visible, Record &record)
+{
+  lock_guard<mutex> guard(lock_);
+  auto iter = chains_.find(VersionKey{table_id, rid});
+  if (iter == chains_.end()) {
+    return RC::RECORD_INVISIBLE;
+  }
+
+  const VersionChain &chain = iter->second;
+  for (auto version_iter = chain.rbegin(); version_iter != chain.rend(); ++version_iter) {
+    Record version;
+    version.set_rid(rid);
+    version.set_data(version_iter->data.get(), version_iter->len);
+    if (!visible(version)) {
+      continue;
+    }
+
+    // 版本链上的数据可能随时被修改或回收，需要复制一份
+    char *data = (char *)malloc(version_iter->len);
+    ASSERT(nullptr != data, "failed to allocate memory. size=%d", version_iter->len);
+    memcpy(data, version_iter->data.get(), version_iter->len);
+    record.set_data_owner(data, version_iter->len);
+    record.set_rid(rid);
+    return RC::SUCCESS;
+  }
+  return RC::RECORD_INVISIBLE;
+}
+
+bool MvccVersionStore::has_versions(int32_t table_id, const RID &rid)
+{
+  lock_guard<mutex> guard(lock_);
+  return chains_.find(VersionKey{table_id, rid}) != chains_.end();
+}
+
+int MvccVersionStore::remove(int32_t table_id, const RID &rid, const function<void(Record &)> &removed)
+{
+  lock_guard<mutex> guard(lock_);
+  auto iter = chains_.find(VersionKey{table_id, rid});
+  if (iter == chains_.end()) {
+    return 0;
+  }
+
+  if (removed) {
+    for (RecordVersion &version : iter->second) {
+      Record record;
+      record.set_rid(rid);
+      record.set_data(version.data.get(), version.len);
+      removed(record);
+    }
+  }
+
+  const int count = static_cast<int>(iter->second.size());
+  chains_.erase(iter);
+  return count;
+}
+
+int MvccVersionStore::purge(int32_t table_id, const function<bool(Record &)> &dead, long &bytes,
+                            const function<void(Record &version, Record *newer)> &removed)
+{
+  int count = 0;
+  bytes = 0;
+
+  lock_guard<mutex> guard(lock_);
+  for (auto iter = chains_.begin(); iter != chains_.end();) {
+    if (iter->first.table_id != table_id) {
+      ++iter;
+      continue;
+    }
+
+    VersionChain &chain = iter->second;
+    size_t dead_num = 0;
+    for (; dead_num < chain.size(); dead_num++) {
+      Record version;
+      version.set_rid(iter->first.rid);
+      version.set_data(chain[dead_num].data.get(), chain[dead_num].len);
+      if (!dead(version)) {
+        break;
+      }
+      bytes += chain[dead_num].len;
+    }
+
+    if (removed) {
+      for (size_t i = 0; i < dead_num; i++) {
+        Record version;
+        version.set_rid(iter->first.rid);
+        version.set_data(chain[i].data.get(), chain[i].len);
+        if (i + 1 < chain.size()) {
+          Record newer;
+          newer.set_rid(iter->first.rid);
+          newer.set_data(chain[i + 1].data.get(), chain[i + 1].len);
+          removed(version, &newer);
+        } else {
+          removed(version, nullptr);
+        }
+      }
+    }
+
+    count += static_cast<int>(dead_num);
+    if (dead_num == chain.size()) {
+      iter = chains_.erase(iter);
+    } else {
+      chain.erase(chain.begin(), chain.begin() + dead_num);
+      ++iter;
+    }
+  }
+  return count;
+}
@@ -0,0 +1,112 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/rc.h"
+#include "storage/record/record.h"
+
+/**
+ * @brief 多版本数据的旧版本存储(undo)
+ * @ingroup Transaction
+ * @details 表文件中只存放记录的最新版本，更新记录时，会把更新前的完整记录(包括事务字段)保存在这里，
+ * 按照表和RID组织成一条版本链，从新到旧排列。读事务在最新版本不可见时，沿着版本链找到对自己可见的版本。
+ * 旧版本只在内存中保存：重启后不会再有活跃的读事务需要访问它们，恢复时需要的旧版本由UPDATE日志提供。
+ */
+class MvccVersionStore
+{
+public:
+  MvccVersionStore() = default;
+  ~MvccVersionStore() = default;
+
+  /**
+   * @brief 保存记录的一个旧版本，作为版本链上最新的旧版本
+   */
+  RC push(int32_t table_id, const RID &rid, const char *data, int len);
+
+  /**
+   * @brief 移除版本链上最新的旧版本，并将它的数据返回。回滚更新时使用
+   */
+  RC pop(int32_t table_id, const RID &rid, Record &record);
+
+  /**
+   * @brief 修改版本链上最新的旧版本，比如提交时设置它的结束事务号
+   */
+  RC update_latest(int32_t table_id, const RID &rid, const std::function<void(Record &)> &updater);
+
+  /**
+   * @brief 从新到旧遍历版本链，找到第一个可见的版本
+   * @param visible 判断某个版本是否可见
+   * @param record  返回找到的版本，数据由record自己管理
+   * @return RC::RECORD_INVISIBLE 没有可见的版本
+   */
+  RC find_visible(int32_t table_id, const RID &rid, const std::function<bool(Record &)> &visible, Record &record);
+
+  /**
+   * @brief 记录是否有旧版本
+   */
+  bool has_versions(int32_t table_id, const RID &rid);
+
+  /**
+   * @brief 删除记录的整条版本链。记录被物理删除前调用，避免槽位重用后访问到不相关的旧版本
+   * @param removed 不为空时，对每个删除的版本调用一次
+   * @return 删除的版本数
+   */
+  int remove(int32_t table_id, const RID &rid, const std::function<void(Record &)> &removed = nullptr);
+
+  /**
+   * @brief 回收某张表上已经没有事务能访问的旧版本
+   * @details 版本链上越旧的版本结束得越早，所以从最旧的版本开始回收，遇到第一个不能回收的版本就停止
+   * @param dead 判断某个版本是否可以回收
+   * @param[out] bytes 回收的空间
+   * @param removed 不为空时，对每个回收的版本调用一次，同时给出比它新的下一个旧版本。
+   *                整条版本链都被回收时，最新的旧版本没有更新的旧版本，给出的是 nullptr，下一个版本就是表中的记录
+   * @return 回收的版本数
+   */
+  int purge(int32_t table_id, const std::function<bool(Record &)> &dead, long &bytes,
+            const std::function<void(Record &version, Record *newer)> &removed = nullptr);
+
+private:
+  struct VersionKey
+  {
+    int32_t table_id;
+    RID     rid;
+
+    bool operator==(const VersionKey &other) const { return table_id == other.table_id && rid == other.rid; }
+  };
+
+  struct VersionKeyHasher
+  {
+    size_t operator()(const VersionKey &key) const
+    {
+      return ((static_cast<size_t>(key.table_id) << 48) ^ (static_cast<size_t>(key.rid.page_num) << 16)) +
+             static_cast<size_t>(key.rid.slot_num);
+    }
+  };
+
+  struct RecordVersion
+  {
+    std::unique_ptr<char[]> data;
+    int                     len = 0;
+  };
+
+  /// 版本链，最新的旧版本放在最后面
+  using VersionChain = std::vector<RecordVersion>;
+
+private:
+  std::mutex                                                    lock_;  ///< 并行扫描时多个线程会同时查找旧版本
+  std::unordered_map<VersionKey, VersionChain, VersionKeyHasher> chains_;
+};
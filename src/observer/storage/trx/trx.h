@@ -70,7 +70,7 @@ public:
   SlotNum slot_num() const { return slot_num_; }
 
 private:
-  ///< 操作的哪张表。这里直接使用表其实并不准确，因为表中的索引也可能有日志
+  ///< 操作的哪张表。表中索引的修改不在这里记录，索引有自己的物理逻辑日志(参考 BplusTreeLogger)
   Type type_;
   
   Table * table_ = nullptr;
@@ -128,6 +128,12 @@ public:
 
   virtual void destroy_trx(Trx *trx) = 0;
 
+  /**
+   * @brief 回收指定表上已经没有事务能访问的数据
+   * @details 由后台线程定期调用，不需要回收的事务模型可以不实现
+   */
+  virtual RC vacuum(const std::vector<Table *> &tables) { return RC::SUCCESS; }
+
 public:
   static TrxKit *create(const char *name);
   static RC init_global(const char *name);
@@ -146,12 +152,45 @@ public:
 
   virtual RC insert_record(Table *table, Record &record) = 0;
   virtual RC delete_record(Table *table, Record &record) = 0;
+
+  /**
+   * @brief 更新一条记录
+   * @param record   要更新的记录，数据指向页面上的内存，调用者持有页面的写锁
+   * @param new_data 新的记录数据
+   */
+  virtual RC update_record(Table *table, Record &record, const char *new_data) = 0;
   virtual RC visit_record(Table *table, Record &record, bool readonly) = 0;
 
+  /**
+   * @brief 等待 visit_record 返回 RC::LOCKED_NEED_WAIT 时申请的锁
+   * @details 调用前要释放持有的页面锁，否则持有锁的事务可能因为拿不到页面锁而无法结束。
+   * 等到锁之后，需要重新读取记录并再次调用 visit_record
+   */
+  virtual RC wait_lock() { return RC::SUCCESS; }
+
+  /**
+   * @brief 修改数据时访问过，但是被过滤条件过滤掉的记录
+   * @details 事务可以释放 visit_record 时为这条记录加的锁
+   */
+  virtual void skip_record(Table *table, const Record &record) {}
+
+  /**
+   * @brief 开始事务，已经开始时什么都不做
+   * @details 事务已经被中止时返回中止的原因，在回滚之前不能再执行语句
+   */
   virtual RC start_if_need() = 0;
+
+  /**
+   * @brief 提交事务。事务已经被中止时回滚，并返回中止的原因
+   */
   virtual RC commit() = 0;
   virtual RC rollback() = 0;
 
+  /**
+   * @brief 事务是否已经被中止，比如等待行锁时被选为死锁的牺牲者或者等待超时。中止的事务只能回滚
+   */
+  virtual bool aborted() const { return false; }
+
   virtual RC redo(Db *db, const CLogRecord &log_record);
 
   virtual int32_t id() const = 0;
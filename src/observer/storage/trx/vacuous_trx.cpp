@@ -61,6 +61,11 @@ RC VacuousTrx::delete_record(Table *table, Record &record)
   return table->delete_record(record);
 }
 
+RC VacuousTrx::update_record(Table *table, Record &record, const char *new_data)
+{
+  return table->update_record(record, new_data);
+}
+
 RC VacuousTrx::visit_record(Table *table, Record &record, bool readonly)
 {
   return RC::SUCCESS;
@@ -0,0 +1,94 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string>
+#include <vector>
+
+#include "sql/operator/aggr_hash_table.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+static int find_or_insert(AggrHashTable &table, const vector<Value> &keys, bool expect_created)
+{
+  bool      created = !expect_created;
+  const int group   = table.find_or_insert(keys, created);
+  EXPECT_EQ(expect_created, created);
+  return group;
+}
+
+TEST(test_aggr_hash_table, test_groups)
+{
+  AggrHashTable table(2);
+  for (int i = 0; i < 10000; i++) {
+    const int  key   = i % 1000;
+    const int  group = find_or_insert(table, {Value(key), Value(to_string(key % 7).c_str())}, i < 1000);
+    AggrState *state = table.states(group);
+    ASSERT_EQ(key, group);  // 按照出现的顺序编号
+    state[0].i_val += 1;
+    state[1].i_val += i;
+  }
+  ASSERT_EQ(1000, table.size());
+
+  vector<Value> keys;
+  for (int group = 0; group < table.size(); group++) {
+    ASSERT_EQ(10, table.states(group)[0].i_val);
+    ASSERT_EQ(group * 10 + 1000 * 45, table.states(group)[1].i_val);
+
+    table.keys(group, keys);
+    ASSERT_EQ(2u, keys.size());
+    ASSERT_EQ(INTS, keys[0].attr_type());
+    ASSERT_EQ(group, keys[0].get_int());
+    ASSERT_EQ(to_string(group % 7), keys[1].to_string());
+  }
+}
+
+TEST(test_aggr_hash_table, test_special_keys)
+{
+  AggrHashTable table(1);
+
+  // NULL 都属于同一个分组，和其它的值不同
+  const int null_group = find_or_insert(table, {Value(NULLS)}, true);
+  ASSERT_EQ(null_group, find_or_insert(table, {Value(NULLS)}, false));
+  ASSERT_NE(null_group, find_or_insert(table, {Value(0)}, true));
+
+  // 0 和 -0 相等
+  const int zero_group = find_or_insert(table, {Value(0.0f)}, true);
+  ASSERT_EQ(zero_group, find_or_insert(table, {Value(-0.0f)}, false));
+
+  // 空字符串
+  const int empty_group = find_or_insert(table, {Value("")}, true);
+  ASSERT_EQ(empty_group, find_or_insert(table, {Value("")}, false));
+  ASSERT_NE(empty_group, find_or_insert(table, {Value("a")}, true));
+
+  // 比一块内存还长的键
+  const string long_key(100 * 1024, 'x');
+  const int    long_group = find_or_insert(table, {Value(long_key.c_str())}, true);
+  ASSERT_EQ(long_group, find_or_insert(table, {Value(long_key.c_str())}, false));
+
+  vector<Value> keys;
+  table.keys(null_group, keys);
+  ASSERT_EQ(NULLS, keys[0].attr_type());
+  table.keys(empty_group, keys);
+  ASSERT_EQ(CHARS, keys[0].attr_type());
+  ASSERT_EQ("", keys[0].to_string());
+  table.keys(long_group, keys);
+  ASSERT_EQ(long_key, keys[0].to_string());
+
+  table.clear();
+  ASSERT_EQ(0, table.size());
+  find_or_insert(table, {Value(NULLS)}, true);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -65,6 +65,15 @@ TEST(test_bitmap, test_bitmap)
   buf3[1] = 0;
   ASSERT_EQ(8, bitmap3.next_unsetted_bit(0));
   ASSERT_EQ(16, bitmap3.next_setted_bit(8));
+
+  // 从字节中间开始查找，后面的字节要从第0位开始查找
+  buf3[0] = 0;
+  buf3[1] = 0x01;
+  buf3[2] = 0;
+  ASSERT_EQ(8, bitmap3.next_setted_bit(3));
+  buf3[0] = -1;
+  buf3[1] = static_cast<char>(0xFE);
+  ASSERT_EQ(8, bitmap3.next_unsetted_bit(3));
 }
 
 int main(int argc, char **argv)
@@ -12,6 +12,11 @@ See the Mulan PSL v2 for more details. */
 // Created by wangyunlai.wyl on 2021
 //
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
 #include "storage/buffer/disk_buffer_pool.h"
 #include "gtest/gtest.h"
 
@@ -125,6 +130,95 @@ TEST(test_frame_manager, test_frame_manager_simple_lru)
   frame_manager.cleanup();
 }
 
+TEST(test_buffer_pool, test_page_groups)
+{
+  const char *file_name = "bp_page_groups.bp";
+  const int   group_page_num = BPFileHeader::GROUP_PAGE_NUM;
+  ::remove(file_name);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(file_name));
+
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+  for (int i = 1; i <= 3; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+    ASSERT_EQ(i, frame->page_num());
+    ASSERT_EQ(RC::SUCCESS, bp->unpin_page(frame));
+  }
+  ASSERT_EQ(4, bp->allocated_page_num());
+  ASSERT_EQ(RC::SUCCESS, bpm.close_file(file_name));
+
+  // 文件中预分配了还没有使用的页面
+  struct stat st;
+  ASSERT_EQ(0, stat(file_name, &st));
+  ASSERT_GE(st.st_size, 4 * BP_PAGE_SIZE);
+
+  // 直接修改文件头，模拟第0组页面差一个就分配满了，不需要真的写这么多页面
+  {
+    int fd = ::open(file_name, O_RDWR);
+    ASSERT_GE(fd, 0);
+    Page page;
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(page)), pread(fd, &page, sizeof(page), 0));
+    BPFileHeader *header = reinterpret_cast<BPFileHeader *>(page.data);
+    header->page_count = group_page_num - 1;
+    header->allocated_pages = group_page_num - 1;
+    memset(header->bitmap, 0xFF, group_page_num / 8);
+    header->bitmap[group_page_num / 8 - 1] &= 0x7F;
+    ASSERT_EQ(static_cast<ssize_t>(sizeof(page)), pwrite(fd, &page, sizeof(page), 0));
+    ASSERT_EQ(0, ftruncate(fd, static_cast<off_t>(group_page_num - 1) * BP_PAGE_SIZE));
+    ::close(fd);
+  }
+
+  // 第0组的最后一个页面，然后是新的一组，第一个页面是这一组的位图
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+  const PageNum expected_pages[] = {group_page_num - 1, group_page_num + 1, group_page_num + 2};
+  for (PageNum expected : expected_pages) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+    ASSERT_EQ(expected, frame->page_num());
+    memset(frame->data(), static_cast<char>(expected), BP_PAGE_DATA_SIZE);
+    frame->mark_dirty();
+    ASSERT_EQ(RC::SUCCESS, bp->unpin_page(frame));
+  }
+  ASSERT_EQ(group_page_num + 3, bp->allocated_page_num());
+
+  // 释放的页面会被重新分配
+  ASSERT_EQ(RC::SUCCESS, bp->dispose_page(group_page_num + 1));
+  ASSERT_EQ(group_page_num + 2, bp->allocated_page_num());
+  Frame *frame = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+  ASSERT_EQ(group_page_num + 1, frame->page_num());
+  memset(frame->data(), static_cast<char>(group_page_num + 1), BP_PAGE_DATA_SIZE);
+  frame->mark_dirty();
+  ASSERT_EQ(RC::SUCCESS, bp->unpin_page(frame));
+  ASSERT_EQ(RC::SUCCESS, bpm.close_file(file_name));
+
+  // 重新打开之后分配信息和数据都还在，遍历时跳过位图页面
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+  ASSERT_EQ(group_page_num + 3, bp->allocated_page_num());
+
+  BufferPoolIterator iterator;
+  iterator.init(*bp, group_page_num - 3);
+  std::vector<PageNum> pages;
+  while (iterator.has_next()) {
+    pages.push_back(iterator.next());
+  }
+  const std::vector<PageNum> all_pages{group_page_num - 2, group_page_num - 1, group_page_num + 1, group_page_num + 2};
+  ASSERT_EQ(all_pages, pages);
+
+  for (PageNum page_num : expected_pages) {
+    ASSERT_EQ(RC::SUCCESS, bp->get_this_page(page_num, &frame));
+    ASSERT_EQ(page_num, frame->page_num());
+    ASSERT_EQ(static_cast<char>(page_num), frame->data()[BP_PAGE_DATA_SIZE - 1]);
+    ASSERT_EQ(RC::SUCCESS, bp->unpin_page(frame));
+  }
+  ASSERT_EQ(RC::SUCCESS, bpm.close_file(file_name));
+
+  ::remove(file_name);
+}
+
 int main(int argc, char **argv)
 {
 
@@ -14,8 +14,10 @@ See the Mulan PSL v2 for more details. */
 
 #include <list>
 #include <iostream>
+#include <fstream>
 
 #include "storage/index/bplus_tree.h"
+#include "storage/clog/clog.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "common/log/log.h"
 #include "sql/parser/parse_defs.h"
@@ -737,6 +739,94 @@ TEST(test_bplus_tree, test_bplus_tree_insert)
   handler = nullptr;
 }
 
+void replay_bplus_tree_log(BplusTreeHandler &tree, const char *log_path)
+{
+  CLogFile log_file;
+  ASSERT_EQ(RC::SUCCESS, log_file.init(log_path));
+
+  CLogRecordIterator log_record_iterator;
+  ASSERT_EQ(RC::SUCCESS, log_record_iterator.init(log_file));
+
+  RC rc = RC::SUCCESS;
+  int replayed = 0;
+  for (rc = log_record_iterator.next(); OB_SUCC(rc) && log_record_iterator.valid(); rc = log_record_iterator.next()) {
+    const CLogRecord &log_record = log_record_iterator.log_record();
+    ASSERT_TRUE(clog_type_is_index(log_record.log_type()));
+
+    const CLogRecordData &data_record = log_record.data_record();
+    const int header_size = static_cast<int>(sizeof(BplusTreeLogHeader));
+    ASSERT_EQ(RC::SUCCESS,
+        tree.redo(log_record.header().lsn_, data_record.data_ + header_size, data_record.data_len_ - header_size));
+    replayed++;
+  }
+  ASSERT_EQ(RC::RECORD_EOF, rc);
+  ASSERT_GT(replayed, 0);
+}
+
+void check_redo_result(BplusTreeHandler &tree, int num)
+{
+  ASSERT_EQ(true, tree.validate_tree());
+  for (int i = 0; i < num; i++) {
+    std::list<RID> rids;
+    ASSERT_EQ(RC::SUCCESS, tree.get_entry((const char *)&i, sizeof(i), rids));
+    if (i % 3 == 0) {
+      ASSERT_EQ(0, static_cast<int>(rids.size()));
+    } else {
+      ASSERT_EQ(1, static_cast<int>(rids.size()));
+      ASSERT_EQ(i, rids.front().slot_num);
+    }
+  }
+}
+
+TEST(test_bplus_tree, test_bplus_tree_redo)
+{
+  const char *redo_index_name = "test_redo.btree";
+  const char *replay_index_name = "test_redo_replay.btree";
+  const char *log_path = ".";
+  const char *clog_file = "./clog";
+  ::remove(redo_index_name);
+  ::remove(replay_index_name);
+  ::remove(clog_file);
+
+  // 一个空的索引文件，通过重做日志恢复成与原始索引一样的数据
+  BplusTreeHandler tree;
+  ASSERT_EQ(RC::SUCCESS, tree.create(redo_index_name, INTS, sizeof(int), ORDER, ORDER));
+  ASSERT_EQ(RC::SUCCESS, tree.close());
+  {
+    std::ifstream src(redo_index_name, std::ios::binary);
+    std::ofstream dst(replay_index_name, std::ios::binary);
+    dst << src.rdbuf();
+  }
+
+  CLogManager log_manager;
+  ASSERT_EQ(RC::SUCCESS, log_manager.init(log_path));
+
+  const int num = 200;
+  ASSERT_EQ(RC::SUCCESS, tree.open(redo_index_name));
+  tree.set_log_manager(&log_manager, 1 /*table_id*/, 0 /*index_id*/);
+  for (int i = 0; i < num; i++) {
+    RID rid(1, i);
+    ASSERT_EQ(RC::SUCCESS, tree.insert_entry((const char *)&i, &rid));
+  }
+  for (int i = 0; i < num; i += 3) {
+    RID rid(1, i);
+    ASSERT_EQ(RC::SUCCESS, tree.delete_entry((const char *)&i, &rid));
+  }
+  check_redo_result(tree, num);
+  ASSERT_EQ(RC::SUCCESS, log_manager.sync());
+  tree.close();
+
+  BplusTreeHandler replay_tree;
+  ASSERT_EQ(RC::SUCCESS, replay_tree.open(replay_index_name));
+  replay_bplus_tree_log(replay_tree, log_path);
+  check_redo_result(replay_tree, num);
+
+  // 页面的LSN已经是最新的，再次重做不会有任何修改
+  replay_bplus_tree_log(replay_tree, log_path);
+  check_redo_result(replay_tree, num);
+  replay_tree.close();
+}
+
 int main(int argc, char **argv)
 {
 
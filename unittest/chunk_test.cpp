@@ -0,0 +1,176 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <memory>
+#include <vector>
+
+#include "sql/expr/chunk.h"
+#include "sql/expr/expression.h"
+#include "sql/expr/tuple.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+/**
+ * @brief 一个整数列和一个字符串列，第 i 行是 i 和 "s<i>"，能被3整除的行字符串是 NULL
+ */
+static void init_chunk(Chunk &chunk, int rows)
+{
+  auto ids   = make_shared<Column>(INTS, 4);
+  auto names = make_shared<Column>(CHARS, 4);
+  for (int i = 0; i < rows; i++) {
+    ids->append_value(Value(i));
+    if (i % 3 == 0) {
+      names->append_null();
+    } else {
+      string name = "s" + to_string(i);
+      names->append_value(Value(name.c_str()));
+    }
+  }
+  chunk.add_column(ids, TupleCellSpec("t", "id", "id"));
+  chunk.add_column(names, TupleCellSpec("t", "name", "name"));
+  chunk.set_rows(rows);
+}
+
+TEST(test_chunk, test_column)
+{
+  Column column(INTS, 2);
+  for (int i = 0; i < 10; i++) {
+    column.append_value(Value(i * 10));
+  }
+  column.append_null();
+  // 追加时按照列的类型转换
+  column.append_value(Value(2.6f));
+
+  ASSERT_EQ(12, column.count());
+  ASSERT_TRUE(column.has_null());
+  ASSERT_TRUE(column.is_null(10));
+  ASSERT_FALSE(column.is_null(9));
+  ASSERT_EQ(90, column.values<int32_t>()[9]);
+  ASSERT_EQ(90, column.get_value(9).get_int());
+  ASSERT_EQ(NULLS, column.get_value(10).attr_type());
+  ASSERT_EQ(INTS, column.get_value(11).attr_type());
+
+  column.reset();
+  ASSERT_EQ(0, column.count());
+  ASSERT_FALSE(column.has_null());
+
+  Column strings(CHARS, 1);
+  strings.append_value(Value("hello"));
+  strings.append_value(Value(3));
+  ASSERT_EQ(2, strings.count());
+  ASSERT_EQ("hello", strings.string_at(0));
+  ASSERT_EQ("3", strings.get_value(1).to_string());
+}
+
+TEST(test_chunk, test_constant_column)
+{
+  Column column;
+  column.init_constant(Value(7), 100);
+  ASSERT_TRUE(column.constant());
+  ASSERT_EQ(100, column.count());
+  ASSERT_EQ(7, column.get_value(99).get_int());
+  ASSERT_FALSE(column.is_null(50));
+
+  Column null_column;
+  null_column.init_constant(Value(NULLS), 3);
+  ASSERT_TRUE(null_column.is_null(2));
+}
+
+TEST(test_chunk, test_filter)
+{
+  Chunk chunk;
+  init_chunk(chunk, 10);
+
+  vector<uint8_t> select(10, 0);
+  select[1] = select[3] = select[4] = select[9] = 1;
+  chunk.filter(select);
+
+  ASSERT_EQ(4, chunk.rows());
+  const Column &ids   = chunk.column(0);
+  const Column &names = chunk.column(1);
+  ASSERT_EQ(4, ids.count());
+  ASSERT_EQ(4, names.count());
+
+  const int expected[] = {1, 3, 4, 9};
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(expected[i], ids.get_value(i).get_int());
+    ASSERT_EQ(expected[i] % 3 == 0, names.is_null(i));
+  }
+  ASSERT_EQ("s1", names.string_at(0));
+  ASSERT_EQ("s4", names.string_at(2));
+
+  // 清空数据之后列还在，可以继续追加
+  chunk.reset_data();
+  ASSERT_EQ(0, chunk.rows());
+  ASSERT_EQ(2, chunk.column_num());
+  ASSERT_EQ(0, chunk.column(0).count());
+}
+
+TEST(test_chunk, test_find_spec)
+{
+  Chunk chunk;
+  init_chunk(chunk, 3);
+  chunk.add_column(make_shared<Column>(INTS, 1), TupleCellSpec("t", "id", "SUM(id)"));
+
+  // 普通字段不关心别名
+  ASSERT_EQ(0, chunk.column_index(TupleCellSpec("t", "id")));
+  ASSERT_EQ(1, chunk.column_index(TupleCellSpec("t", "name", "n")));
+  // 聚合的结果按别名区分
+  ASSERT_EQ(2, chunk.column_index(TupleCellSpec("t", "id", "SUM(id)")));
+  ASSERT_EQ(-1, chunk.column_index(TupleCellSpec("t", "score")));
+  ASSERT_EQ(-1, chunk.column_index(TupleCellSpec("u", "id")));
+}
+
+TEST(test_chunk, test_chunk_tuple)
+{
+  Chunk chunk;
+  init_chunk(chunk, 5);
+
+  ChunkTuple tuple;
+  tuple.set_row(&chunk, 2);
+  ASSERT_EQ(2, tuple.cell_num());
+
+  Value cell;
+  ASSERT_EQ(RC::SUCCESS, tuple.find_cell(TupleCellSpec("t", "name"), cell));
+  ASSERT_EQ("s2", cell.to_string());
+  ASSERT_EQ(RC::NOTFOUND, tuple.find_cell(TupleCellSpec("t", "score"), cell));
+
+  // 复制出来的元组不依赖 chunk 中的数据
+  unique_ptr<Tuple> copy(tuple.clone());
+  chunk.reset();
+  init_chunk(chunk, 1);
+
+  ASSERT_EQ(RC::SUCCESS, copy->find_cell(TupleCellSpec("t", "id"), cell));
+  ASSERT_EQ(2, cell.get_int());
+  ASSERT_EQ(RC::SUCCESS, copy->cell_at(1, cell));
+  ASSERT_EQ("s2", cell.to_string());
+}
+
+TEST(test_chunk, test_comparison_eval)
+{
+  Chunk chunk;
+  chunk.set_rows(4);
+
+  vector<uint8_t> select;
+  ComparisonExpr  less(LESS_THAN, make_unique<ValueExpr>(Value(1)), make_unique<ValueExpr>(Value(2)));
+  ASSERT_EQ(RC::SUCCESS, less.eval(chunk, select));
+  ASSERT_EQ(vector<uint8_t>(4, 1), vector<uint8_t>(select.begin(), select.begin() + 4));
+
+  ComparisonExpr greater(GREAT_THAN, make_unique<ValueExpr>(Value(1)), make_unique<ValueExpr>(Value(2)));
+  ASSERT_EQ(RC::SUCCESS, greater.eval(chunk, select));
+  ASSERT_EQ(vector<uint8_t>(4, 0), vector<uint8_t>(select.begin(), select.begin() + 4));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
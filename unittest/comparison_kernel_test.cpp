@@ -0,0 +1,166 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdlib.h>
+#include <memory>
+#include <vector>
+
+#include "sql/expr/chunk.h"
+#include "sql/expr/comparison_kernel.h"
+#include "sql/expr/expression.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+static const CompOp COMPS[] = {EQUAL_TO, NOT_EQUAL, LESS_THAN, LESS_EQUAL, GREAT_THAN, GREAT_EQUAL};
+static const ComparisonKernel::Mode MODES[] = {ComparisonKernel::Mode::SCALAR, ComparisonKernel::Mode::SIMD};
+
+/**
+ * @brief 与 Value::compare 的结果对照
+ */
+static bool expected(CompOp comp, const Value &left, const Value &right)
+{
+  int cmp = left.compare(right);
+  switch (comp) {
+    case EQUAL_TO: return cmp == 0;
+    case NOT_EQUAL: return cmp != 0;
+    case LESS_THAN: return cmp < 0;
+    case LESS_EQUAL: return cmp <= 0;
+    case GREAT_THAN: return cmp > 0;
+    case GREAT_EQUAL: return cmp >= 0;
+    default: return false;
+  }
+}
+
+/**
+ * @brief 两列值逐一比较，也把每个右值当作常量和整列比较
+ * @details 行数不是8的倍数，覆盖 SIMD 之后剩下的部分
+ */
+static void check(AttrType type, const vector<Value> &left, const vector<Value> &right)
+{
+  Column left_column(type, 1);
+  Column right_column(type, 1);
+  for (size_t i = 0; i < left.size(); i++) {
+    left_column.append_value(left[i]);
+    right_column.append_value(right[i]);
+  }
+
+  const int       rows = static_cast<int>(left.size());
+  vector<uint8_t> select(rows);
+  for (CompOp comp : COMPS) {
+    for (ComparisonKernel::Mode mode : MODES) {
+      ComparisonKernel::compare(comp, type, left_column.data(), right_column.data(), rows, select.data(), mode);
+      for (int i = 0; i < rows; i++) {
+        ASSERT_EQ(expected(comp, left[i], right[i]), select[i] != 0)
+            << "comp=" << comp << ", left=" << left[i].to_string() << ", right=" << right[i].to_string();
+      }
+
+      for (int r = 0; r < rows; r += 7) {
+        ComparisonKernel::compare(comp, type, left_column.data(), right[r], rows, select.data(), mode);
+        for (int i = 0; i < rows; i++) {
+          ASSERT_EQ(expected(comp, left[i], right[r]), select[i] != 0)
+              << "comp=" << comp << ", left=" << left[i].to_string() << ", right=" << right[r].to_string();
+        }
+      }
+    }
+  }
+}
+
+TEST(test_comparison_kernel, test_ints)
+{
+  srand(1);
+  vector<Value> left, right;
+  for (int i = 0; i < 203; i++) {
+    left.push_back(Value(rand() % 20 - 10));
+    right.push_back(Value(rand() % 20 - 10));
+  }
+  check(INTS, left, right);
+}
+
+TEST(test_comparison_kernel, test_floats)
+{
+  srand(2);
+  vector<Value> left, right;
+  for (int i = 0; i < 203; i++) {
+    float value = (rand() % 20 - 10) / 4.0f;
+    left.push_back(Value(value));
+    // 一部分值只差一点点，按照 EPSILON 认为相等
+    switch (rand() % 4) {
+      case 0: right.push_back(Value(value + 1e-7f)); break;
+      case 1: right.push_back(Value(value - 1e-5f)); break;
+      default: right.push_back(Value((rand() % 20 - 10) / 4.0f)); break;
+    }
+  }
+  check(FLOATS, left, right);
+}
+
+TEST(test_comparison_kernel, test_dates)
+{
+  srand(3);
+  vector<Value> left, right;
+  for (int i = 0; i < 203; i++) {
+    // 日期按照无符号数比较
+    left.push_back(Value(static_cast<date>(20200101 + rand() % 5)));
+    right.push_back(Value(static_cast<date>(i % 10 == 0 ? 0x80000000u : 20200101 + rand() % 5)));
+  }
+  check(DATES, left, right);
+}
+
+TEST(test_comparison_kernel, test_support)
+{
+  ASSERT_TRUE(ComparisonKernel::support(LESS_THAN, INTS, INTS));
+  ASSERT_TRUE(ComparisonKernel::support(EQUAL_TO, FLOATS, INTS));
+  ASSERT_TRUE(ComparisonKernel::support(GREAT_EQUAL, DATES, DATES));
+  ASSERT_FALSE(ComparisonKernel::support(LESS_THAN, INTS, FLOATS));
+  ASSERT_FALSE(ComparisonKernel::support(EQUAL_TO, CHARS, CHARS));
+  ASSERT_FALSE(ComparisonKernel::support(IS, INTS, NULLS));
+
+  ASSERT_EQ(GREAT_THAN, ComparisonKernel::swap(LESS_THAN));
+  ASSERT_EQ(LESS_EQUAL, ComparisonKernel::swap(GREAT_EQUAL));
+  ASSERT_EQ(NOT_EQUAL, ComparisonKernel::swap(NOT_EQUAL));
+}
+
+TEST(test_comparison_kernel, test_expression)
+{
+  Chunk chunk;
+  auto  column = make_shared<Column>(INTS, 1);
+  for (int i = 0; i < 20; i++) {
+    if (i % 5 == 0) {
+      column->append_null();
+    } else {
+      column->append_value(Value(i));
+    }
+  }
+  chunk.add_column(column, TupleCellSpec("t", "id", "id"));
+  chunk.set_rows(20);
+
+  // 常量在左边时交换比较的方向，NULL 的行不满足条件
+  class ColumnExpr : public ValueExpr
+  {
+  public:
+    RC get_column(Chunk &chunk, shared_ptr<Column> &column) const override
+    {
+      column = chunk.column_ptr(0);
+      return RC::SUCCESS;
+    }
+  };
+  ComparisonExpr  expr(LESS_THAN, make_unique<ValueExpr>(Value(12)), make_unique<ColumnExpr>());
+  vector<uint8_t> select;
+  ASSERT_EQ(RC::SUCCESS, expr.eval(chunk, select));
+  for (int i = 0; i < 20; i++) {
+    ASSERT_EQ(i > 12 && i % 5 != 0, select[i] != 0) << i;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
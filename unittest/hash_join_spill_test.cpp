@@ -0,0 +1,230 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdio.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "sql/operator/hash_join_physical_operator.h"
+#include "sql/operator/spill_file.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+/**
+ * @brief 按顺序输出给定的行
+ */
+class RowsPhysicalOperator : public PhysicalOperator
+{
+public:
+  RowsPhysicalOperator(const Table &table, const vector<vector<Value>> &rows) : rows_(rows)
+  {
+    auto             speces     = make_shared<vector<TupleCellSpec>>();
+    const TableMeta &table_meta = table.table_meta();
+    for (int i = table_meta.sys_field_num(); i < table_meta.field_num(); i++) {
+      speces->emplace_back(table.name(), table_meta.field(i)->name(), table_meta.field(i)->name());
+    }
+    speces_ = speces;
+  }
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::STRING_LIST; }
+
+  RC open(Trx *) override
+  {
+    index_ = -1;
+    return RC::SUCCESS;
+  }
+  RC next() override
+  {
+    if (++index_ >= static_cast<int>(rows_.size())) {
+      return RC::RECORD_EOF;
+    }
+    tuple_.set_values(speces_, rows_[index_]);
+    return RC::SUCCESS;
+  }
+  RC     close() override { return RC::SUCCESS; }
+  Tuple *current_tuple() override { return &tuple_; }
+
+private:
+  vector<vector<Value>>                   rows_;
+  shared_ptr<const vector<TupleCellSpec>> speces_;
+  int                                     index_ = -1;
+  ChunkTuple                              tuple_;
+};
+
+class HashJoinSpillTest : public testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    BufferPoolManager::set_instance(&bpm_);
+    ASSERT_EQ(RC::SUCCESS, TrxKit::init_global("vacuous"));
+    create_table(left_table_, 1, "hash_join_spill_t", "v");
+    create_table(right_table_, 2, "hash_join_spill_u", "w");
+  }
+
+  static void TearDownTestSuite()
+  {
+    for (const char *name : {"hash_join_spill_t", "hash_join_spill_u"}) {
+      ::remove((string(name) + ".table").c_str());
+      ::remove((string(name) + ".data").c_str());
+    }
+  }
+
+  static void create_table(Table &table, int32_t table_id, const char *table_name, const char *value_field)
+  {
+    const string meta_file = string(table_name) + ".table";
+    ::remove(meta_file.c_str());
+    ::remove((string(table_name) + ".data").c_str());
+
+    vector<AttrInfoSqlNode> attrs(2);
+    attrs[0] = AttrInfoSqlNode{INTS, "id", sizeof(int32_t), true};
+    attrs[1] = AttrInfoSqlNode{CHARS, value_field, 8, false};
+    ASSERT_EQ(RC::SUCCESS, table.create(table_id, meta_file.c_str(), table_name, ".", 2, attrs.data()));
+  }
+
+  static vector<Field> fields(const Table &table)
+  {
+    vector<Field>    result;
+    const TableMeta &table_meta = table.table_meta();
+    for (int i = table_meta.sys_field_num(); i < table_meta.field_num(); i++) {
+      result.emplace_back(&table, table_meta.field(i));
+    }
+    return result;
+  }
+
+  /**
+   * @brief 执行连接，每行结果转换成字符串，排序后返回
+   */
+  static vector<string> join(
+      const vector<vector<Value>> &left_rows, const vector<vector<Value>> &right_rows, bool build_left, int64_t limit)
+  {
+    vector<unique_ptr<Expression>> left_keys;
+    vector<unique_ptr<Expression>> right_keys;
+    left_keys.emplace_back(new FieldExpr(&left_table_, left_table_.table_meta().field("id")));
+    right_keys.emplace_back(new FieldExpr(&right_table_, right_table_.table_meta().field("id")));
+
+    HashJoinPhysicalOperator join_oper(std::move(left_keys), std::move(right_keys), fields(left_table_),
+        fields(right_table_), build_left, limit);
+    join_oper.add_child(make_unique<RowsPhysicalOperator>(left_table_, left_rows));
+    join_oper.add_child(make_unique<RowsPhysicalOperator>(right_table_, right_rows));
+
+    const TupleCellSpec speces[] = {TupleCellSpec(left_table_.name(), "id"),
+        TupleCellSpec(left_table_.name(), "v"),
+        TupleCellSpec(right_table_.name(), "id"),
+        TupleCellSpec(right_table_.name(), "w")};
+
+    vector<string> result;
+    EXPECT_EQ(RC::SUCCESS, join_oper.open(nullptr));
+    RC rc = RC::SUCCESS;
+    while (RC::SUCCESS == (rc = join_oper.next())) {
+      Tuple *tuple = join_oper.current_tuple();
+      string row;
+      for (const TupleCellSpec &spec : speces) {
+        Value value;
+        EXPECT_EQ(RC::SUCCESS, tuple->find_cell(spec, value));
+        row += value.to_string() + ",";
+      }
+      result.push_back(row);
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    EXPECT_EQ(RC::SUCCESS, join_oper.close());
+
+    sort(result.begin(), result.end());
+    return result;
+  }
+
+  static vector<vector<Value>> make_rows(int row_num, int key_mod, const char *prefix)
+  {
+    vector<vector<Value>> rows;
+    for (int i = 0; i < row_num; i++) {
+      Value key = (i % 37 == 0) ? Value(NULLS) : Value(i % key_mod);
+      rows.push_back({key, Value((prefix + to_string(i)).c_str())});
+    }
+    return rows;
+  }
+
+protected:
+  static BufferPoolManager bpm_;
+  static Table             left_table_;
+  static Table             right_table_;
+};
+
+BufferPoolManager HashJoinSpillTest::bpm_{16};
+Table             HashJoinSpillTest::left_table_;
+Table             HashJoinSpillTest::right_table_;
+
+TEST(test_spill_file, test_values)
+{
+  vector<vector<Value>> rows;
+  for (int i = 0; i < 10000; i++) {
+    rows.push_back({Value(i), Value(i * 0.5f), Value(string(i % 50, 'a' + i % 26).c_str()), Value(NULLS),
+        Value(i % 2 == 0)});
+  }
+
+  SpillStats stats;
+  SpillFile  file(&stats);
+  ASSERT_EQ(RC::SUCCESS, file.open());
+  for (const vector<Value> &row : rows) {
+    ASSERT_EQ(RC::SUCCESS, file.write_values(row));
+  }
+  ASSERT_EQ(RC::SUCCESS, file.rewind());
+  ASSERT_EQ(static_cast<int64_t>(rows.size()), file.row_num());
+  ASSERT_EQ(stats.bytes_written, file.size());
+
+  vector<Value> values;
+  for (const vector<Value> &row : rows) {
+    ASSERT_EQ(RC::SUCCESS, file.read_values(values));
+    ASSERT_EQ(row.size(), values.size());
+    for (size_t i = 0; i < row.size(); i++) {
+      ASSERT_EQ(row[i].attr_type(), values[i].attr_type());
+      ASSERT_EQ(row[i].to_string(), values[i].to_string());
+    }
+  }
+  ASSERT_EQ(RC::RECORD_EOF, file.read_values(values));
+  ASSERT_EQ(stats.bytes_written, stats.bytes_read);
+  ASSERT_EQ(1, stats.file_num);
+}
+
+TEST_F(HashJoinSpillTest, test_spill)
+{
+  vector<vector<Value>> left_rows  = make_rows(3000, 500, "t");
+  vector<vector<Value>> right_rows = make_rows(2000, 700, "u");
+
+  vector<string> expected = join(left_rows, right_rows, false /*build_left*/, 1L << 30);
+  ASSERT_FALSE(expected.empty());
+  for (bool build_left : {false, true}) {
+    // 分区需要递归多层才能放到内存中
+    ASSERT_EQ(expected, join(left_rows, right_rows, build_left, 4096));
+    ASSERT_EQ(expected, join(left_rows, right_rows, build_left, 64 * 1024));
+  }
+}
+
+TEST_F(HashJoinSpillTest, test_same_key)
+{
+  // 连接键都相同，再分区也没有用，超过最大层数之后不再溢出
+  vector<vector<Value>> left_rows  = make_rows(300, 1, "t");
+  vector<vector<Value>> right_rows = make_rows(200, 2, "u");
+
+  vector<string> expected = join(left_rows, right_rows, false /*build_left*/, 1L << 30);
+  ASSERT_EQ(expected, join(left_rows, right_rows, false /*build_left*/, 1024));
+  ASSERT_EQ(expected, join(left_rows, right_rows, true /*build_left*/, 1024));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,403 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/global_context.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/delete_physical_operator.h"
+#include "sql/operator/index_join_physical_operator.h"
+#include "sql/operator/join_logical_operator.h"
+#include "sql/operator/predicate_logical_operator.h"
+#include "sql/operator/table_get_logical_operator.h"
+#include "sql/optimizer/physical_plan_generator.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/clog/clog.h"
+#include "storage/db/db.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+/**
+ * @brief 按顺序输出给定的行
+ */
+class RowsPhysicalOperator : public PhysicalOperator
+{
+public:
+  RowsPhysicalOperator(const Table &table, const vector<vector<Value>> &rows) : rows_(rows)
+  {
+    auto             speces     = make_shared<vector<TupleCellSpec>>();
+    const TableMeta &table_meta = table.table_meta();
+    for (int i = table_meta.sys_field_num(); i < table_meta.field_num(); i++) {
+      speces->emplace_back(table.name(), table_meta.field(i)->name(), table_meta.field(i)->name());
+    }
+    speces_ = speces;
+  }
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::STRING_LIST; }
+
+  RC open(Trx *) override
+  {
+    index_ = -1;
+    return RC::SUCCESS;
+  }
+  RC next() override
+  {
+    if (++index_ >= static_cast<int>(rows_.size())) {
+      return RC::RECORD_EOF;
+    }
+    tuple_.set_values(speces_, rows_[index_]);
+    return RC::SUCCESS;
+  }
+  RC     close() override { return RC::SUCCESS; }
+  Tuple *current_tuple() override { return &tuple_; }
+
+private:
+  vector<vector<Value>>                   rows_;
+  shared_ptr<const vector<TupleCellSpec>> speces_;
+  int                                     index_ = -1;
+  ChunkTuple                              tuple_;
+};
+
+/**
+ * @brief 外表 s(id, v) 的行由测试给出，内表 t(id, name) 在 id 和 name 上有索引
+ * @details t 中有重复的连接键、连接键是 NULL 的行、提交删除的行和没有提交的事务插入的行。
+ * u(id, name) 与 t 的数据相同但是没有索引
+ */
+class IndexJoinTest : public testing::Test
+{
+protected:
+  static constexpr const char *DB_PATH = "index_join_db";
+
+  static constexpr int INNER_ROWS    = 40000;
+  static constexpr int INNER_KEYS    = 100;
+  static constexpr int DELETED_ID    = 500;
+  static constexpr int UNCOMMITTED_ID = 501;
+
+  static void SetUpTestSuite()
+  {
+    BufferPoolManager::set_instance(&bpm_);
+    ASSERT_EQ(RC::SUCCESS, TrxKit::init_global("mvcc"));
+    GCTX.trx_kit_ = TrxKit::instance();
+
+    filesystem::remove_all(DB_PATH);
+    filesystem::create_directory(DB_PATH);
+    db_ = make_unique<Db>();
+    ASSERT_EQ(RC::SUCCESS, db_->init("index_join", DB_PATH));
+
+    create_table("s", "v", 8);
+    create_table("t", "name", 4);
+    create_table("u", "name", 4);
+    outer_table_ = db_->find_table("s");
+    inner_table_ = db_->find_table("t");
+    ASSERT_EQ(RC::SUCCESS, inner_table_->create_index(nullptr, inner_table_->table_meta().field("id"), "t_id", false));
+    ASSERT_EQ(RC::SUCCESS, inner_table_->create_index(nullptr, inner_table_->table_meta().field("name"), "t_name", false));
+
+    // 每个连接键有多行，NULL 在字段中保存成全0，在索引中和 0、空字符串放在一起
+    for (int i = 0; i < INNER_ROWS; i++) {
+      inner_rows_.push_back({Value(i % INNER_KEYS), Value(key_name(i % INNER_KEYS).c_str())});
+    }
+    inner_rows_.push_back({Value(NULLS), Value(NULLS)});
+    inner_rows_.push_back({Value(NULLS), Value(NULLS)});
+    inner_rows_.push_back({Value(7), Value("abcd")});
+    insert_rows(inner_table_, inner_rows_, true /*commit*/);
+    insert_rows(db_->find_table("u"), inner_rows_, true /*commit*/);
+    insert_rows(outer_table_, {{Value(1), Value("k1")}, {Value(2), Value("k2")}}, true /*commit*/);
+
+    // 提交删除的行，索引中还有它的记录
+    insert_rows(inner_table_, {{Value(DELETED_ID), Value("del")}}, true /*commit*/);
+    Trx *trx = TrxKit::instance()->create_trx(db_->clog_manager());
+    ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+    unique_ptr<IndexScanPhysicalOperator> scan_oper = create_index_scan("id", false /*readonly*/);
+    scan_oper->set_key(Value(DELETED_ID));
+    DeletePhysicalOperator delete_oper(inner_table_);
+    delete_oper.add_child(std::move(scan_oper));
+    ASSERT_EQ(RC::SUCCESS, delete_oper.open(trx));
+    ASSERT_EQ(RC::RECORD_EOF, delete_oper.next());
+    ASSERT_EQ(RC::SUCCESS, delete_oper.close());
+    ASSERT_EQ(RC::SUCCESS, trx->commit());
+    TrxKit::instance()->destroy_trx(trx);
+
+    // 没有提交的插入，只有插入的事务自己能看到
+    writer_trx_ = insert_rows(inner_table_, {{Value(UNCOMMITTED_ID), Value("new")}}, false /*commit*/);
+  }
+
+  static void TearDownTestSuite()
+  {
+    if (writer_trx_ != nullptr) {
+      writer_trx_->rollback();
+      TrxKit::instance()->destroy_trx(writer_trx_);
+      writer_trx_ = nullptr;
+    }
+    db_.reset();
+    filesystem::remove_all(DB_PATH);
+  }
+
+  static string key_name(int key) { return "k" + to_string(key); }
+
+  static void create_table(const char *table_name, const char *chars_field, size_t chars_len)
+  {
+    vector<AttrInfoSqlNode> attrs(2);
+    attrs[0] = AttrInfoSqlNode{INTS, "id", sizeof(int32_t), true};
+    attrs[1] = AttrInfoSqlNode{CHARS, chars_field, chars_len, true};
+    ASSERT_EQ(RC::SUCCESS, db_->create_table(table_name, 2, attrs.data()));
+  }
+
+  /**
+   * @brief 用一个事务插入数据
+   * @return 不提交时返回插入数据的事务
+   */
+  static Trx *insert_rows(Table *table, const vector<vector<Value>> &rows, bool commit)
+  {
+    Trx *trx = TrxKit::instance()->create_trx(db_->clog_manager());
+    EXPECT_EQ(RC::SUCCESS, trx->start_if_need());
+    for (const vector<Value> &row : rows) {
+      Record record;
+      EXPECT_EQ(RC::SUCCESS, table->make_record(static_cast<int>(row.size()), row.data(), record));
+      EXPECT_EQ(RC::SUCCESS, trx->insert_record(table, record));
+    }
+    if (!commit) {
+      return trx;
+    }
+    EXPECT_EQ(RC::SUCCESS, trx->commit());
+    TrxKit::instance()->destroy_trx(trx);
+    return nullptr;
+  }
+
+  static unique_ptr<IndexScanPhysicalOperator> create_index_scan(const char *field_name, bool readonly)
+  {
+    const FieldMeta *field_meta = inner_table_->table_meta().field(field_name);
+    Index           *index      = inner_table_->find_index_by_field(field_meta->name());
+    return make_unique<IndexScanPhysicalOperator>(inner_table_, index, readonly,
+        nullptr /*left_value*/, true /*left_inclusive*/, nullptr /*right_value*/, true /*right_inclusive*/);
+  }
+
+  /**
+   * @brief 执行索引嵌套循环连接，每行结果转换成字符串返回，外表的列在前
+   * @param outer_field s 中的连接字段
+   * @param inner_field t 中的连接字段
+   * @param trx         读取内表的事务，nullptr 时使用新的事务
+   */
+  static vector<string> join(const vector<vector<Value>> &outer_rows, const char *outer_field, const char *inner_field,
+      bool inner_left, Trx *trx = nullptr)
+  {
+    IndexNestedLoopJoinPhysicalOperator join_oper(
+        make_unique<FieldExpr>(outer_table_, outer_table_->table_meta().field(outer_field)),
+        make_unique<FieldExpr>(inner_table_, inner_table_->table_meta().field(inner_field)),
+        inner_left);
+    unique_ptr<PhysicalOperator> outer_oper = make_unique<RowsPhysicalOperator>(*outer_table_, outer_rows);
+    unique_ptr<PhysicalOperator> inner_oper = create_index_scan(inner_field, true /*readonly*/);
+    join_oper.add_child(std::move(inner_left ? inner_oper : outer_oper));
+    join_oper.add_child(std::move(inner_left ? outer_oper : inner_oper));
+
+    Trx *reader_trx = trx;
+    if (reader_trx == nullptr) {
+      reader_trx = TrxKit::instance()->create_trx(db_->clog_manager());
+      EXPECT_EQ(RC::SUCCESS, reader_trx->start_if_need());
+    }
+
+    vector<string> result;
+    EXPECT_EQ(RC::SUCCESS, join_oper.open(reader_trx));
+    RC rc = RC::SUCCESS;
+    while (RC::SUCCESS == (rc = join_oper.next())) {
+      Tuple *tuple = join_oper.current_tuple();
+      string row;
+      for (const TupleCellSpec &spec : {TupleCellSpec("s", "id"), TupleCellSpec("s", "v"), TupleCellSpec("t", "id"),
+               TupleCellSpec("t", "name")}) {
+        Value value;
+        EXPECT_EQ(RC::SUCCESS, tuple->find_cell(spec, value));
+        row += value.to_string() + ",";
+      }
+      result.push_back(row);
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    EXPECT_EQ(RC::SUCCESS, join_oper.close());
+
+    if (trx == nullptr) {
+      EXPECT_EQ(RC::SUCCESS, reader_trx->commit());
+      TrxKit::instance()->destroy_trx(reader_trx);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  /**
+   * @brief 用嵌套循环计算期望的结果
+   * @param key_index 连接键是第几列
+   */
+  static vector<string> expected_join(const vector<vector<Value>> &outer_rows, int key_index)
+  {
+    vector<string> result;
+    for (const vector<Value> &outer : outer_rows) {
+      for (const vector<Value> &inner : inner_rows_) {
+        const Value &outer_key = outer[key_index];
+        const Value &inner_key = inner[key_index];
+        if (outer_key.attr_type() != NULLS && inner_key.attr_type() != NULLS && outer_key.compare(inner_key) == 0) {
+          result.push_back(outer[0].to_string() + "," + outer[1].to_string() + "," + inner[0].to_string() + "," +
+                           inner[1].to_string() + ",");
+        }
+      }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  static unique_ptr<LogicalOperator> create_join(Table *left_table, Table *right_table)
+  {
+    unique_ptr<LogicalOperator> join_oper(new JoinLogicalOperator);
+    for (Table *table : {left_table, right_table}) {
+      vector<Field> fields;
+      for (const char *field_name : {"id", "name", "v"}) {
+        if (table->table_meta().field(field_name) != nullptr) {
+          fields.emplace_back(table, table->table_meta().field(field_name));
+        }
+      }
+      join_oper->add_child(make_unique<TableGetLogicalOperator>(table, fields, true /*readonly*/));
+    }
+
+    const Field left_key(left_table, left_table->table_meta().field("id"));
+    const Field right_key(right_table, right_table->table_meta().field("id"));
+    unique_ptr<LogicalOperator> predicate_oper(new PredicateLogicalOperator(
+        make_unique<ComparisonExpr>(EQUAL_TO, make_unique<FieldExpr>(left_key), make_unique<FieldExpr>(right_key))));
+    predicate_oper->add_child(std::move(join_oper));
+    return predicate_oper;
+  }
+
+protected:
+  static BufferPoolManager     bpm_;
+  static unique_ptr<Db>        db_;
+  static Table                *outer_table_;
+  static Table                *inner_table_;
+  static vector<vector<Value>> inner_rows_;  ///< t 中对其它事务可见的行
+  static Trx                  *writer_trx_;
+};
+
+BufferPoolManager     IndexJoinTest::bpm_{64};
+unique_ptr<Db>        IndexJoinTest::db_;
+Table                *IndexJoinTest::outer_table_ = nullptr;
+Table                *IndexJoinTest::inner_table_ = nullptr;
+vector<vector<Value>> IndexJoinTest::inner_rows_;
+Trx                  *IndexJoinTest::writer_trx_ = nullptr;
+
+TEST_F(IndexJoinTest, test_duplicate_keys)
+{
+  // 外表也有重复的键，以及 NULL 和内表中没有的键
+  vector<vector<Value>> outer_rows;
+  for (int i = 0; i < 30; i++) {
+    const Value key = (i % 7 == 0) ? Value(NULLS) : Value((i * 13) % (INNER_KEYS + 20));
+    outer_rows.push_back({key, Value(("s" + to_string(i)).c_str())});
+  }
+
+  const vector<string> expected = expected_join(outer_rows, 0);
+  ASSERT_FALSE(expected.empty());
+  for (bool inner_left : {false, true}) {
+    ASSERT_EQ(expected, join(outer_rows, "id", "id", inner_left));
+  }
+
+  // 每个内表的键有 INNER_ROWS / INNER_KEYS 行
+  ASSERT_EQ(static_cast<size_t>(INNER_ROWS / INNER_KEYS), join({{Value(3), Value("a")}}, "id", "id", false).size());
+}
+
+TEST_F(IndexJoinTest, test_null_and_missing_keys)
+{
+  // NULL 不与任何值相等，包括内表中的 NULL
+  ASSERT_TRUE(join({{Value(NULLS), Value("a")}}, "id", "id", false).empty());
+  ASSERT_TRUE(join({{Value(NULLS), Value(NULLS)}}, "v", "name", false).empty());
+
+  // 内表中 NULL 的字段保存成 0，索引能找到这些记录，需要再比较一次排除掉
+  ASSERT_EQ(static_cast<size_t>(INNER_ROWS / INNER_KEYS), join({{Value(0), Value("a")}}, "id", "id", false).size());
+
+  // 内表中没有的键
+  ASSERT_TRUE(join({{Value(INNER_KEYS), Value("a")}, {Value(-1), Value("b")}}, "id", "id", true).empty());
+}
+
+TEST_F(IndexJoinTest, test_chars_keys)
+{
+  // t.name 是 char(4)，索引中的键只有4个字符，外表的键可以更长
+  vector<vector<Value>> outer_rows = {{Value(1), Value("abcd")},
+      {Value(2), Value("abcd1")},
+      {Value(3), Value("abc")},
+      {Value(4), Value("")},
+      {Value(5), Value("k5")},
+      {Value(6), Value("k55x")},
+      {Value(7), Value("k555")}};
+
+  const vector<string> expected = expected_join(outer_rows, 1);
+  for (bool inner_left : {false, true}) {
+    ASSERT_EQ(expected, join(outer_rows, "v", "name", inner_left));
+  }
+
+  // 前缀相同但是更长的键不能匹配。NULL 在索引中的键是全0，与空字符串相同，要靠再比较一次排除掉
+  ASSERT_EQ(1, static_cast<int>(join({{Value(1), Value("abcd")}}, "v", "name", false).size()));
+  ASSERT_TRUE(join({{Value(2), Value("abcd1")}}, "v", "name", false).empty());
+  ASSERT_TRUE(join({{Value(4), Value("")}}, "v", "name", false).empty());
+}
+
+TEST_F(IndexJoinTest, test_invisible_records)
+{
+  // 删除已经提交的行和其它事务没有提交的行都看不到
+  const vector<vector<Value>> outer_rows = {{Value(DELETED_ID), Value("a")}, {Value(UNCOMMITTED_ID), Value("b")}};
+  ASSERT_TRUE(join(outer_rows, "id", "id", false).empty());
+  ASSERT_TRUE(join(outer_rows, "id", "id", true).empty());
+
+  // 插入的事务自己能看到
+  const vector<string> result = join(outer_rows, "id", "id", false, writer_trx_);
+  ASSERT_EQ(1, static_cast<int>(result.size()));
+  ASSERT_EQ(to_string(UNCOMMITTED_ID) + ",b," + to_string(UNCOMMITTED_ID) + ",new,", result.front());
+}
+
+TEST_F(IndexJoinTest, test_choose_index_join)
+{
+  PhysicalPlanGenerator generator;
+
+  // 外表很小，内表的连接键上有索引
+  unique_ptr<LogicalOperator>  logical_oper = create_join(outer_table_, inner_table_);
+  unique_ptr<PhysicalOperator> physical_oper;
+  ASSERT_EQ(RC::SUCCESS, generator.create(*logical_oper, physical_oper));
+  ASSERT_EQ(PhysicalOperatorType::INDEX_NESTED_LOOP_JOIN, physical_oper->type());
+  ASSERT_EQ(PhysicalOperatorType::INDEX_SCAN, physical_oper->children()[1]->type());
+
+  Trx *trx = TrxKit::instance()->create_trx(db_->clog_manager());
+  ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+  ASSERT_EQ(RC::SUCCESS, physical_oper->open(trx));
+  int rows = 0;
+  RC  rc   = RC::SUCCESS;
+  while (RC::SUCCESS == (rc = physical_oper->next())) {
+    rows++;
+  }
+  ASSERT_EQ(RC::RECORD_EOF, rc);
+  ASSERT_EQ(RC::SUCCESS, physical_oper->close());
+  ASSERT_EQ(RC::SUCCESS, trx->commit());
+  TrxKit::instance()->destroy_trx(trx);
+  ASSERT_EQ(2 * INNER_ROWS / INNER_KEYS, rows);
+
+  // 内表在左边时也可以
+  logical_oper = create_join(inner_table_, outer_table_);
+  ASSERT_EQ(RC::SUCCESS, generator.create(*logical_oper, physical_oper));
+  ASSERT_EQ(PhysicalOperatorType::INDEX_NESTED_LOOP_JOIN, physical_oper->type());
+  ASSERT_EQ(PhysicalOperatorType::INDEX_SCAN, physical_oper->children()[0]->type());
+
+  // 外表很大时逐行查找索引比哈希连接慢
+  logical_oper = create_join(db_->find_table("u"), inner_table_);
+  ASSERT_EQ(RC::SUCCESS, generator.create(*logical_oper, physical_oper));
+  ASSERT_EQ(PhysicalOperatorType::HASH_JOIN, physical_oper->type());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
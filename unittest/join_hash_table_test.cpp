@@ -0,0 +1,94 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <memory>
+#include <vector>
+
+#include "sql/operator/join_hash_table.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+static void add_row(JoinHashTable &table, vector<Value> keys, int id)
+{
+  auto tuple = make_unique<ValueListTuple>();
+  tuple->set_cells({Value(id)});
+  const size_t hash = JoinHashTable::hash(keys);
+  table.add(std::move(tuple), keys, hash);
+}
+
+/**
+ * @brief 返回连接键相同的所有行的 id
+ */
+static vector<int> find(const JoinHashTable &table, const vector<Value> &keys)
+{
+  vector<int>  ids;
+  const size_t hash = JoinHashTable::hash(keys);
+  int          row  = -1;
+  for (int64_t pos = table.probe(table.start_pos(hash), hash, keys, row); pos >= 0;
+       pos         = table.probe(pos, hash, keys, row)) {
+    Value id;
+    table.tuple(row)->cell_at(0, id);
+    ids.push_back(id.get_int());
+  }
+  return ids;
+}
+
+TEST(test_join_hash_table, test_duplicate_keys)
+{
+  JoinHashTable table;
+  for (int i = 0; i < 1000; i++) {
+    add_row(table, {Value(i % 100)}, i);
+  }
+  table.build();
+  ASSERT_EQ(1000, table.size());
+
+  // 相同的键按照放入的顺序返回
+  vector<int> ids = find(table, {Value(7)});
+  ASSERT_EQ(10u, ids.size());
+  for (int i = 0; i < 10; i++) {
+    ASSERT_EQ(7 + i * 100, ids[i]);
+  }
+  ASSERT_TRUE(find(table, {Value(100)}).empty());
+}
+
+TEST(test_join_hash_table, test_multiple_keys)
+{
+  JoinHashTable table;
+  add_row(table, {Value(1), Value("a")}, 1);
+  add_row(table, {Value(1), Value("b")}, 2);
+  add_row(table, {Value(2), Value("a")}, 3);
+  table.build();
+
+  ASSERT_EQ(vector<int>{2}, find(table, {Value(1), Value("b")}));
+  ASSERT_EQ(vector<int>{3}, find(table, {Value(2), Value("a")}));
+  ASSERT_TRUE(find(table, {Value(2), Value("b")}).empty());
+}
+
+TEST(test_join_hash_table, test_empty)
+{
+  JoinHashTable table;
+  ASSERT_TRUE(find(table, {Value(1)}).empty());
+
+  table.build();
+  ASSERT_TRUE(find(table, {Value(1)}).empty());
+
+  add_row(table, {Value(1)}, 1);
+  table.clear();
+  table.build();
+  ASSERT_EQ(0, table.size());
+  ASSERT_TRUE(find(table, {Value(1)}).empty());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
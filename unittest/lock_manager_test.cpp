@@ -0,0 +1,131 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <chrono>
+#include <thread>
+
+#include "storage/trx/lock_manager.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+static RowLockKey lock_key(int slot)
+{
+  return RowLockKey{1, RID(1, slot)};
+}
+
+TEST(test_lock_manager, test_shared_exclusive)
+{
+  LockManager lock_manager;
+  ASSERT_EQ(RC::SUCCESS, lock_manager.init(100 /*wait_timeout_ms*/, 0 /*detect_interval_ms*/));
+
+  LockOwner owner1{1};
+  LockOwner owner2{2};
+  LockOwner owner3{3};
+
+  ASSERT_EQ(RC::SUCCESS, lock_manager.try_lock(owner1, lock_key(1), LockMode::SHARED));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.try_lock(owner2, lock_key(1), LockMode::SHARED));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.try_lock(owner2, lock_key(1), LockMode::SHARED));
+  ASSERT_EQ(1, static_cast<int>(owner2.keys.size()));
+
+  // 有其它事务持有共享锁，不能升级
+  ASSERT_EQ(RC::LOCKED_NEED_WAIT, lock_manager.try_lock(owner1, lock_key(1), LockMode::EXCLUSIVE));
+  ASSERT_EQ(RC::LOCKED_WAIT_TIMEOUT, lock_manager.wait(owner1, lock_key(1)));
+
+  // 排在等待的排它锁后面，先来先服务
+  ASSERT_EQ(RC::LOCKED_NEED_WAIT, lock_manager.try_lock(owner3, lock_key(1), LockMode::EXCLUSIVE));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.try_lock(owner1, lock_key(2), LockMode::SHARED));
+  ASSERT_EQ(RC::LOCKED_NEED_WAIT, lock_manager.try_lock(owner2, lock_key(2), LockMode::EXCLUSIVE));
+
+  lock_manager.unlock_all(owner1);
+  ASSERT_TRUE(owner1.keys.empty());
+  ASSERT_EQ(RC::LOCKED_WAIT_TIMEOUT, lock_manager.wait(owner3, lock_key(1)));
+
+  // owner2 等待 slot 2 的排它锁，owner1 释放后拿到
+  ASSERT_EQ(RC::SUCCESS, lock_manager.wait(owner2, lock_key(2)));
+
+  // 只有自己持有共享锁，可以直接升级
+  ASSERT_EQ(RC::SUCCESS, lock_manager.try_lock(owner2, lock_key(1), LockMode::EXCLUSIVE));
+  ASSERT_EQ(RC::LOCKED_NEED_WAIT, lock_manager.try_lock(owner3, lock_key(1), LockMode::SHARED));
+  lock_manager.unlock(owner2, lock_key(1));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.wait(owner3, lock_key(1)));
+
+  lock_manager.unlock_all(owner2);
+  lock_manager.unlock_all(owner3);
+  ASSERT_EQ(2, lock_manager.stat().timeouts.load());
+}
+
+TEST(test_lock_manager, test_wait_queue)
+{
+  LockManager lock_manager;
+  ASSERT_EQ(RC::SUCCESS, lock_manager.init(5000 /*wait_timeout_ms*/, 0 /*detect_interval_ms*/));
+
+  LockOwner owner1{1};
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(owner1, lock_key(1), LockMode::EXCLUSIVE));
+
+  // 多个事务依次排队，按照申请的顺序拿到锁
+  vector<int32_t> grant_order;
+  mutex           order_mutex;
+  vector<thread>  threads;
+  for (int32_t trx_id = 2; trx_id <= 4; trx_id++) {
+    LockOwner owner{trx_id};
+    ASSERT_EQ(RC::LOCKED_NEED_WAIT, lock_manager.try_lock(owner, lock_key(1), LockMode::EXCLUSIVE));
+    threads.emplace_back([&, owner]() mutable {
+      ASSERT_EQ(RC::SUCCESS, lock_manager.wait(owner, lock_key(1)));
+      {
+        lock_guard<mutex> guard(order_mutex);
+        grant_order.push_back(owner.trx_id);
+      }
+      lock_manager.unlock_all(owner);
+    });
+  }
+
+  this_thread::sleep_for(chrono::milliseconds(50));
+  lock_manager.unlock_all(owner1);
+  for (thread &t : threads) {
+    t.join();
+  }
+  ASSERT_EQ((vector<int32_t>{2, 3, 4}), grant_order);
+}
+
+TEST(test_lock_manager, test_deadlock)
+{
+  LockManager lock_manager;
+  ASSERT_EQ(RC::SUCCESS, lock_manager.init(5000 /*wait_timeout_ms*/, 10 /*detect_interval_ms*/));
+
+  LockOwner owner1{1};
+  LockOwner owner2{2};
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(owner1, lock_key(1), LockMode::EXCLUSIVE));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(owner2, lock_key(2), LockMode::EXCLUSIVE));
+
+  RC rc1 = RC::SUCCESS;
+  thread t1([&]() {
+    rc1 = lock_manager.lock(owner1, lock_key(2), LockMode::EXCLUSIVE);
+    lock_manager.unlock_all(owner1);
+  });
+
+  this_thread::sleep_for(chrono::milliseconds(20));
+
+  // 事务2比较年轻，被选为牺牲者
+  const auto begin = chrono::steady_clock::now();
+  ASSERT_EQ(RC::LOCKED_DEADLOCK, lock_manager.lock(owner2, lock_key(1), LockMode::EXCLUSIVE));
+  ASSERT_LT(chrono::steady_clock::now() - begin, chrono::seconds(5));
+  lock_manager.unlock_all(owner2);
+
+  t1.join();
+  ASSERT_EQ(RC::SUCCESS, rc1);
+  ASSERT_EQ(1, lock_manager.stat().deadlocks.load());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
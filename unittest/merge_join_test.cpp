@@ -0,0 +1,258 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdio.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "sql/operator/merge_join_physical_operator.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+/**
+ * @brief 按顺序输出给定的行
+ */
+class RowsPhysicalOperator : public PhysicalOperator
+{
+public:
+  RowsPhysicalOperator(const Table &table, const vector<vector<Value>> &rows) : rows_(rows)
+  {
+    auto             speces     = make_shared<vector<TupleCellSpec>>();
+    const TableMeta &table_meta = table.table_meta();
+    for (int i = table_meta.sys_field_num(); i < table_meta.field_num(); i++) {
+      speces->emplace_back(table.name(), table_meta.field(i)->name(), table_meta.field(i)->name());
+    }
+    speces_ = speces;
+  }
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::STRING_LIST; }
+
+  RC open(Trx *) override
+  {
+    index_ = -1;
+    return RC::SUCCESS;
+  }
+  RC next() override
+  {
+    if (++index_ >= static_cast<int>(rows_.size())) {
+      return RC::RECORD_EOF;
+    }
+    tuple_.set_values(speces_, rows_[index_]);
+    return RC::SUCCESS;
+  }
+  RC     close() override { return RC::SUCCESS; }
+  Tuple *current_tuple() override { return &tuple_; }
+
+private:
+  vector<vector<Value>>                   rows_;
+  shared_ptr<const vector<TupleCellSpec>> speces_;
+  int                                     index_ = -1;
+  ChunkTuple                              tuple_;
+};
+
+class MergeJoinTest : public testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    BufferPoolManager::set_instance(&bpm_);
+    ASSERT_EQ(RC::SUCCESS, TrxKit::init_global("vacuous"));
+    create_table(left_table_, 1, "merge_join_t", "v");
+    create_table(right_table_, 2, "merge_join_u", "w");
+  }
+
+  static void TearDownTestSuite()
+  {
+    for (const char *name : {"merge_join_t", "merge_join_u"}) {
+      ::remove((string(name) + ".table").c_str());
+      ::remove((string(name) + ".data").c_str());
+    }
+  }
+
+  static void create_table(Table &table, int32_t table_id, const char *table_name, const char *value_field)
+  {
+    const string meta_file = string(table_name) + ".table";
+    ::remove(meta_file.c_str());
+    ::remove((string(table_name) + ".data").c_str());
+
+    vector<AttrInfoSqlNode> attrs(2);
+    attrs[0] = AttrInfoSqlNode{INTS, "id", sizeof(int32_t), true};
+    attrs[1] = AttrInfoSqlNode{CHARS, value_field, 8, false};
+    ASSERT_EQ(RC::SUCCESS, table.create(table_id, meta_file.c_str(), table_name, ".", 2, attrs.data()));
+  }
+
+  static vector<Field> fields(const Table &table)
+  {
+    vector<Field>    result;
+    const TableMeta &table_meta = table.table_meta();
+    for (int i = table_meta.sys_field_num(); i < table_meta.field_num(); i++) {
+      result.emplace_back(&table, table_meta.field(i));
+    }
+    return result;
+  }
+
+  /**
+   * @brief 执行连接，每行结果转换成字符串返回。检查输出按照连接键有序
+   */
+  static vector<string> join(
+      const vector<vector<Value>> &left_rows, const vector<vector<Value>> &right_rows, bool sort_left, bool sort_right)
+  {
+    MergeJoinPhysicalOperator join_oper(make_unique<FieldExpr>(&left_table_, left_table_.table_meta().field("id")),
+        make_unique<FieldExpr>(&right_table_, right_table_.table_meta().field("id")),
+        fields(left_table_),
+        fields(right_table_),
+        sort_left,
+        sort_right);
+    join_oper.add_child(make_unique<RowsPhysicalOperator>(left_table_, left_rows));
+    join_oper.add_child(make_unique<RowsPhysicalOperator>(right_table_, right_rows));
+
+    const TupleCellSpec speces[] = {TupleCellSpec(left_table_.name(), "id"),
+        TupleCellSpec(left_table_.name(), "v"),
+        TupleCellSpec(right_table_.name(), "id"),
+        TupleCellSpec(right_table_.name(), "w")};
+
+    vector<string> result;
+    Value          last_key;
+    EXPECT_EQ(RC::SUCCESS, join_oper.open(nullptr));
+    RC rc = RC::SUCCESS;
+    while (RC::SUCCESS == (rc = join_oper.next())) {
+      Tuple *tuple = join_oper.current_tuple();
+      string row;
+      for (const TupleCellSpec &spec : speces) {
+        Value value;
+        EXPECT_EQ(RC::SUCCESS, tuple->find_cell(spec, value));
+        row += value.to_string() + ",";
+      }
+
+      Value key;
+      EXPECT_EQ(RC::SUCCESS, tuple->find_cell(speces[0], key));
+      EXPECT_TRUE(result.empty() || key.compare(last_key) >= 0);
+      last_key = key;
+      result.push_back(row);
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    EXPECT_EQ(RC::SUCCESS, join_oper.close());
+    return result;
+  }
+
+  /**
+   * @brief 用嵌套循环计算期望的结果
+   */
+  static vector<string> expected_join(const vector<vector<Value>> &left_rows, const vector<vector<Value>> &right_rows)
+  {
+    vector<string> result;
+    for (const vector<Value> &left : left_rows) {
+      for (const vector<Value> &right : right_rows) {
+        if (left[0].attr_type() != NULLS && right[0].attr_type() != NULLS && left[0].compare(right[0]) == 0) {
+          result.push_back(left[0].to_string() + "," + left[1].to_string() + "," + right[0].to_string() + "," +
+                           right[1].to_string() + ",");
+        }
+      }
+    }
+    return result;
+  }
+
+  static vector<vector<Value>> make_rows(int row_num, int key_mod, const char *prefix)
+  {
+    vector<vector<Value>> rows;
+    for (int i = 0; i < row_num; i++) {
+      Value key = (i % 37 == 0) ? Value(NULLS) : Value((i * 7) % key_mod);
+      rows.push_back({key, Value((prefix + to_string(i)).c_str())});
+    }
+    return rows;
+  }
+
+  /**
+   * @brief 按照连接键排序，NULL 放在任意位置都可以
+   */
+  static vector<vector<Value>> sorted(vector<vector<Value>> rows)
+  {
+    std::stable_sort(rows.begin(), rows.end(), [](const vector<Value> &left, const vector<Value> &right) {
+      if (left[0].attr_type() == NULLS || right[0].attr_type() == NULLS) {
+        return left[0].attr_type() == NULLS && right[0].attr_type() != NULLS;
+      }
+      return left[0].compare(right[0]) < 0;
+    });
+    return rows;
+  }
+
+protected:
+  static BufferPoolManager bpm_;
+  static Table             left_table_;
+  static Table             right_table_;
+};
+
+BufferPoolManager MergeJoinTest::bpm_{16};
+Table             MergeJoinTest::left_table_;
+Table             MergeJoinTest::right_table_;
+
+TEST_F(MergeJoinTest, test_duplicate_keys)
+{
+  vector<vector<Value>> left_rows  = make_rows(600, 50, "t");
+  vector<vector<Value>> right_rows = make_rows(400, 70, "u");
+
+  vector<string> expected = expected_join(left_rows, right_rows);
+  std::sort(expected.begin(), expected.end());
+  ASSERT_FALSE(expected.empty());
+
+  // 输入已经有序，或者在算子中排序
+  const vector<vector<Value>> sorted_left  = sorted(left_rows);
+  const vector<vector<Value>> sorted_right = sorted(right_rows);
+  for (int sort_flags = 0; sort_flags < 4; sort_flags++) {
+    const bool     sort_left  = (sort_flags & 1) != 0;
+    const bool     sort_right = (sort_flags & 2) != 0;
+    vector<string> result     = join(sort_left ? left_rows : sorted_left, sort_right ? right_rows : sorted_right,
+        sort_left, sort_right);
+    std::sort(result.begin(), result.end());
+    ASSERT_EQ(expected, result);
+  }
+}
+
+TEST_F(MergeJoinTest, test_empty)
+{
+  vector<vector<Value>> rows = sorted(make_rows(100, 10, "t"));
+  ASSERT_TRUE(join({}, rows, false, false).empty());
+  ASSERT_TRUE(join(rows, {}, false, true).empty());
+  ASSERT_TRUE(join({{Value(NULLS), Value("a")}}, {{Value(NULLS), Value("b")}}, false, false).empty());
+}
+
+TEST_F(MergeJoinTest, test_unordered_input)
+{
+  MergeJoinPhysicalOperator join_oper(make_unique<FieldExpr>(&left_table_, left_table_.table_meta().field("id")),
+      make_unique<FieldExpr>(&right_table_, right_table_.table_meta().field("id")),
+      fields(left_table_),
+      fields(right_table_),
+      false /*sort_left*/,
+      false /*sort_right*/);
+  join_oper.add_child(make_unique<RowsPhysicalOperator>(
+      left_table_, vector<vector<Value>>{{Value(2), Value("a")}, {Value(1), Value("b")}}));
+  join_oper.add_child(make_unique<RowsPhysicalOperator>(
+      right_table_, vector<vector<Value>>{{Value(1), Value("c")}, {Value(2), Value("d")}}));
+
+  // 输入不是有序的时报错，不能返回错误的结果
+  ASSERT_EQ(RC::SUCCESS, join_oper.open(nullptr));
+  RC rc = RC::SUCCESS;
+  while (RC::SUCCESS == (rc = join_oper.next())) {
+  }
+  ASSERT_EQ(RC::INTERNAL, rc);
+  ASSERT_EQ(RC::SUCCESS, join_oper.close());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,232 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+#include "common/global_context.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/delete_physical_operator.h"
+#include "sql/operator/table_scan_physical_operator.h"
+#include "sql/operator/update_physical_operator.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/clog/clog.h"
+#include "storage/db/db.h"
+#include "storage/table/table.h"
+#include "storage/trx/mvcc_trx.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+/**
+ * @brief 两个事务通过 UPDATE/DELETE 语句互相等待对方的行锁
+ * @details 表 t(id, v) 中有 id 为 1、2、3 的三行，v = id
+ */
+class MvccDeadlockTest : public testing::Test
+{
+protected:
+  static constexpr const char *DB_PATH = "mvcc_deadlock_db";
+
+  static void SetUpTestSuite()
+  {
+    BufferPoolManager::set_instance(&bpm_);
+    ASSERT_EQ(RC::SUCCESS, TrxKit::init_global("mvcc"));
+    GCTX.trx_kit_ = TrxKit::instance();
+  }
+
+  void SetUp() override
+  {
+    filesystem::remove_all(DB_PATH);
+    filesystem::create_directory(DB_PATH);
+    db_ = make_unique<Db>();
+    ASSERT_EQ(RC::SUCCESS, db_->init("deadlock", DB_PATH));
+
+    vector<AttrInfoSqlNode> attrs(2);
+    attrs[0] = AttrInfoSqlNode{INTS, "id", sizeof(int32_t), false};
+    attrs[1] = AttrInfoSqlNode{INTS, "v", sizeof(int32_t), false};
+    ASSERT_EQ(RC::SUCCESS, db_->create_table("t", 2, attrs.data()));
+    table_ = db_->find_table("t");
+
+    Trx *trx = create_trx();
+    ASSERT_EQ(RC::SUCCESS, trx->start_if_need());
+    for (int id = 1; id <= 3; id++) {
+      Value  values[2] = {Value(id), Value(id)};
+      Record record;
+      ASSERT_EQ(RC::SUCCESS, table_->make_record(2, values, record));
+      ASSERT_EQ(RC::SUCCESS, trx->insert_record(table_, record));
+    }
+    ASSERT_EQ(RC::SUCCESS, trx->commit());
+    TrxKit::instance()->destroy_trx(trx);
+  }
+
+  void TearDown() override
+  {
+    db_.reset();
+    filesystem::remove_all(DB_PATH);
+  }
+
+  Trx *create_trx() { return TrxKit::instance()->create_trx(db_->clog_manager()); }
+
+  unique_ptr<PhysicalOperator> create_scan(int id)
+  {
+    const Field id_field(table_, table_->table_meta().field("id"));
+
+    vector<unique_ptr<Expression>> predicates;
+    predicates.emplace_back(
+        new ComparisonExpr(EQUAL_TO, make_unique<FieldExpr>(id_field), make_unique<ValueExpr>(Value(id))));
+    auto scan_oper = make_unique<TableScanPhysicalOperator>(table_, false /*readonly*/);
+    scan_oper->set_predicates(std::move(predicates));
+    return scan_oper;
+  }
+
+  /**
+   * @brief 执行 update t set v = value where id = id
+   */
+  RC update(Trx *trx, int id, int value)
+  {
+    Value                  new_value(value);
+    UpdatePhysicalOperator update_oper(table_, &new_value, "v");
+    update_oper.add_child(create_scan(id));
+    return execute(trx, update_oper);
+  }
+
+  /**
+   * @brief 执行 delete from t where id = id
+   */
+  RC remove(Trx *trx, int id)
+  {
+    DeletePhysicalOperator delete_oper(table_);
+    delete_oper.add_child(create_scan(id));
+    return execute(trx, delete_oper);
+  }
+
+  static RC execute(Trx *trx, PhysicalOperator &oper)
+  {
+    RC rc = trx->start_if_need();
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    rc = oper.open(trx);
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+    rc = oper.next();
+    oper.close();
+    return rc == RC::RECORD_EOF ? RC::SUCCESS : rc;
+  }
+
+  /**
+   * @brief 用一个新的事务读取每一行的 v，行不存在时是 -1
+   */
+  vector<int> read_values()
+  {
+    Trx *trx = create_trx();
+    EXPECT_EQ(RC::SUCCESS, trx->start_if_need());
+
+    vector<int>               values(3, -1);
+    TableScanPhysicalOperator scan_oper(table_, true /*readonly*/);
+    EXPECT_EQ(RC::SUCCESS, scan_oper.open(trx));
+    RC rc = RC::SUCCESS;
+    while (RC::SUCCESS == (rc = scan_oper.next())) {
+      Tuple *tuple = scan_oper.current_tuple();
+      Value  id;
+      Value  value;
+      EXPECT_EQ(RC::SUCCESS, tuple->find_cell(TupleCellSpec("t", "id"), id));
+      EXPECT_EQ(RC::SUCCESS, tuple->find_cell(TupleCellSpec("t", "v"), value));
+      values[id.get_int() - 1] = value.get_int();
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    scan_oper.close();
+
+    EXPECT_EQ(RC::SUCCESS, trx->commit());
+    TrxKit::instance()->destroy_trx(trx);
+    return values;
+  }
+
+  /**
+   * @brief 等待有一个新的请求开始等锁
+   */
+  static void wait_for_lock_waits(const LockManager &lock_manager, long waits)
+  {
+    while (lock_manager.stat().waits.load() <= waits) {
+      this_thread::sleep_for(chrono::milliseconds(1));
+    }
+  }
+
+  /**
+   * @brief 事务 A 持有第2行的锁，等待事务 B 持有的第3行的锁；事务 B 再去修改第2行时形成死锁
+   * @param b_oper 事务 B 修改第2行的语句
+   */
+  void run_deadlock(const function<RC(Trx *)> &b_oper)
+  {
+    Trx *trx_a = create_trx();
+    Trx *trx_b = create_trx();
+    ASSERT_EQ(RC::SUCCESS, trx_a->start_if_need());
+    ASSERT_EQ(RC::SUCCESS, trx_b->start_if_need());
+    ASSERT_LT(trx_a->id(), trx_b->id());
+
+    ASSERT_EQ(RC::SUCCESS, update(trx_b, 3, 30));
+
+    LockManager &lock_manager = static_cast<MvccTrxKit *>(TrxKit::instance())->lock_manager();
+    const long   waits        = lock_manager.stat().waits.load();
+    RC           rc_a         = RC::SUCCESS;
+    thread       thread_a([&]() { rc_a = update(trx_a, 2, 20); });
+    wait_for_lock_waits(lock_manager, waits);
+
+    // 事务 B 比较年轻，被选为牺牲者。语句要返回错误，不能当作没有数据要修改
+    ASSERT_EQ(RC::LOCKED_DEADLOCK, b_oper(trx_b));
+    ASSERT_TRUE(trx_b->aborted());
+
+    // 中止的事务不能再执行语句，也不能提交。提交时回滚并释放锁，事务 A 可以继续
+    ASSERT_EQ(RC::LOCKED_DEADLOCK, update(trx_b, 1, 10));
+    ASSERT_EQ(RC::LOCKED_DEADLOCK, trx_b->commit());
+    ASSERT_FALSE(trx_b->aborted());
+
+    thread_a.join();
+    ASSERT_EQ(RC::SUCCESS, rc_a);
+    ASSERT_EQ(RC::SUCCESS, trx_a->commit());
+
+    // 事务 B 对第3行的修改已经回滚
+    ASSERT_EQ((vector<int>{1, 20, 3}), read_values());
+
+    // 回滚之后可以开始新的事务
+    ASSERT_EQ(RC::SUCCESS, update(trx_b, 1, 10));
+    ASSERT_EQ(RC::SUCCESS, trx_b->commit());
+    ASSERT_EQ((vector<int>{10, 20, 3}), read_values());
+
+    TrxKit::instance()->destroy_trx(trx_a);
+    TrxKit::instance()->destroy_trx(trx_b);
+  }
+
+protected:
+  static BufferPoolManager bpm_;
+
+  unique_ptr<Db> db_;
+  Table         *table_ = nullptr;
+};
+
+BufferPoolManager MvccDeadlockTest::bpm_;
+
+TEST_F(MvccDeadlockTest, test_update_victim)
+{
+  run_deadlock([this](Trx *trx) { return update(trx, 2, 200); });
+}
+
+TEST_F(MvccDeadlockTest, test_delete_victim)
+{
+  run_deadlock([this](Trx *trx) { return remove(trx, 2); });
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,102 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/trx/mvcc_read_view.h"
+#include "gtest/gtest.h"
+
+TEST(test_mvcc_read_view, test_active_set)
+{
+  MvccActiveTrxSet active_set;
+  ASSERT_EQ(1, active_set.horizon());
+
+  const int32_t trx1 = active_set.add_next();
+  const int32_t trx2 = active_set.add_next();
+  ASSERT_EQ(1, trx1);
+  ASSERT_EQ(2, trx2);
+
+  // trx2 开始提交，提交事务号是活跃的
+  const int32_t commit2 = active_set.add_next();
+  std::shared_ptr<const MvccReadView> view = active_set.read_view();
+  ASSERT_EQ(1, view->low());
+  ASSERT_EQ(4, view->high());
+  ASSERT_TRUE(view->active(trx1));
+  ASSERT_FALSE(view->visible(commit2));
+
+  active_set.remove({trx2, commit2});
+  const int32_t trx3 = active_set.add_next();
+  std::shared_ptr<const MvccReadView> view3 = active_set.read_view(trx3, 0 /*hint*/);
+  ASSERT_TRUE(view3->visible(commit2));
+  ASSERT_FALSE(view3->visible(trx3 + 1));
+
+  // 已经获取的视图不受影响
+  ASSERT_FALSE(view->visible(commit2));
+  ASSERT_EQ(1, active_set.horizon());
+
+  // trx3 开始时 trx1 还是活跃的，所以 trx1 结束后 horizon 仍然由 trx3 的视图决定
+  active_set.remove({trx1});
+  ASSERT_EQ(trx1, active_set.horizon());
+  active_set.remove({trx3});
+  ASSERT_EQ(trx3 + 1, active_set.horizon());
+  ASSERT_TRUE(active_set.read_view()->visible(trx3));
+
+  active_set.advance_to(100);
+  ASSERT_EQ(101, active_set.add_next());
+}
+
+TEST(test_mvcc_read_view, test_wide_window)
+{
+  MvccActiveTrxSet active_set;
+  const int32_t oldest = active_set.add_next();
+  for (int i = 0; i < 1000; i++) {
+    active_set.remove({active_set.add_next()});
+  }
+  const int32_t commit_xid = active_set.add_next();
+
+  std::shared_ptr<const MvccReadView> view = active_set.read_view();
+  ASSERT_EQ(oldest, view->low());
+  ASSERT_TRUE(view->active(oldest));
+  ASSERT_FALSE(view->visible(commit_xid));
+  for (int32_t xid = oldest + 1; xid < commit_xid; xid++) {
+    ASSERT_TRUE(view->visible(xid));
+  }
+}
+
+TEST(test_mvcc_read_view, test_lazy_view)
+{
+  MvccActiveTrxSet active_set;
+  const int32_t trx1 = active_set.add_next(1 /*hint*/);
+  const int32_t trx2 = active_set.add_next(2 /*hint*/);
+
+  // 集合没有变化时复用同一个视图
+  std::shared_ptr<const MvccReadView> view = active_set.read_view(trx1, 1 /*hint*/);
+  ASSERT_EQ(view, active_set.read_view(trx2, 2 /*hint*/));
+  ASSERT_EQ(view, active_set.read_view());
+  ASSERT_TRUE(view->active(trx2));
+
+  const int32_t commit2 = active_set.add_next(2 /*hint*/);
+  active_set.remove({trx2, commit2}, 2 /*hint*/);
+  std::shared_ptr<const MvccReadView> view2 = active_set.read_view();
+  ASSERT_NE(view, view2);
+  ASSERT_TRUE(view2->visible(commit2));
+  ASSERT_FALSE(view->visible(commit2));
+
+  // 还没有获取视图的事务不会让 horizon 更小
+  const int32_t trx3 = active_set.add_next(3 /*hint*/);
+  active_set.remove({trx1}, 1 /*hint*/);
+  ASSERT_EQ(trx3, active_set.horizon());
+  active_set.remove({trx3}, 3 /*hint*/);
+  ASSERT_EQ(trx3 + 1, active_set.horizon());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,105 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+
+#include "storage/trx/mvcc_version_store.h"
+#include "gtest/gtest.h"
+
+// 测试用的版本数据：前4个字节是版本号
+static int version_of(const Record &record)
+{
+  int value = 0;
+  memcpy(&value, record.data(), sizeof(value));
+  return value;
+}
+
+TEST(test_mvcc_version_store, test_version_chain)
+{
+  MvccVersionStore store;
+  const int32_t table_id = 1;
+  const RID rid(1, 2);
+
+  Record record;
+  ASSERT_FALSE(store.has_versions(table_id, rid));
+  ASSERT_EQ(RC::RECORD_INVISIBLE, store.find_visible(table_id, rid, [](Record &) { return true; }, record));
+
+  for (int version = 1; version <= 3; version++) {
+    char data[8] = {0};
+    memcpy(data, &version, sizeof(version));
+    ASSERT_EQ(RC::SUCCESS, store.push(table_id, rid, data, sizeof(data)));
+  }
+  ASSERT_TRUE(store.has_versions(table_id, rid));
+  ASSERT_FALSE(store.has_versions(table_id, RID(1, 3)));
+  ASSERT_FALSE(store.has_versions(table_id + 1, rid));
+
+  // 从新到旧遍历
+  ASSERT_EQ(RC::SUCCESS, store.find_visible(table_id, rid, [](Record &) { return true; }, record));
+  ASSERT_EQ(3, version_of(record));
+  ASSERT_EQ(RC::SUCCESS, store.find_visible(table_id, rid, [](Record &v) { return version_of(v) < 3; }, record));
+  ASSERT_EQ(2, version_of(record));
+  ASSERT_EQ(rid, record.rid());
+  ASSERT_EQ(RC::RECORD_INVISIBLE, store.find_visible(table_id, rid, [](Record &) { return false; }, record));
+
+  // 修改最新的旧版本
+  ASSERT_EQ(RC::SUCCESS, store.update_latest(table_id, rid, [](Record &v) {
+    int value = 30;
+    memcpy(v.data(), &value, sizeof(value));
+  }));
+
+  for (int expect : {30, 2, 1}) {
+    Record popped;
+    ASSERT_EQ(RC::SUCCESS, store.pop(table_id, rid, popped));
+    ASSERT_EQ(expect, version_of(popped));
+  }
+  ASSERT_FALSE(store.has_versions(table_id, rid));
+  ASSERT_EQ(RC::RECORD_NOT_EXIST, store.pop(table_id, rid, record));
+}
+
+TEST(test_mvcc_version_store, test_purge)
+{
+  MvccVersionStore store;
+  const int32_t table_id = 1;
+
+  // 每条记录有3个旧版本，版本号越大越新
+  for (int slot = 0; slot < 4; slot++) {
+    for (int version = 1; version <= 3; version++) {
+      char data[8] = {0};
+      memcpy(data, &version, sizeof(version));
+      ASSERT_EQ(RC::SUCCESS, store.push(table_id, RID(1, slot), data, sizeof(data)));
+      ASSERT_EQ(RC::SUCCESS, store.push(table_id + 1, RID(1, slot), data, sizeof(data)));
+    }
+  }
+
+  long bytes = 0;
+  ASSERT_EQ(8, store.purge(table_id, [](Record &v) { return version_of(v) <= 2; }, bytes));
+  ASSERT_EQ(64, bytes);
+
+  Record record;
+  ASSERT_EQ(RC::SUCCESS, store.find_visible(table_id, RID(1, 0), [](Record &) { return true; }, record));
+  ASSERT_EQ(3, version_of(record));
+  ASSERT_EQ(RC::RECORD_INVISIBLE, store.find_visible(table_id, RID(1, 0), [](Record &v) { return version_of(v) < 3; }, record));
+
+  // 旧的版本不能回收时，新的版本也不会回收
+  ASSERT_EQ(0, store.purge(table_id + 1, [](Record &v) { return version_of(v) != 1; }, bytes));
+  ASSERT_EQ(0, bytes);
+
+  ASSERT_EQ(4, store.purge(table_id, [](Record &) { return true; }, bytes));
+  ASSERT_FALSE(store.has_versions(table_id, RID(1, 0)));
+  ASSERT_EQ(3, store.remove(table_id + 1, RID(1, 0)));
+  ASSERT_EQ(0, store.remove(table_id + 1, RID(1, 0)));
+  ASSERT_TRUE(store.has_versions(table_id + 1, RID(1, 1)));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
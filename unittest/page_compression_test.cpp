@@ -0,0 +1,154 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <vector>
+
+#include "common/io/lz4.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "gtest/gtest.h"
+
+using namespace common;
+
+static void check_round_trip(const std::vector<char> &src)
+{
+  const int        src_size = static_cast<int>(src.size());
+  std::vector<char> compressed(src_size + src_size / 255 + 16);
+  const int compressed_size = lz4_compress(src.data(), src_size, compressed.data(), static_cast<int>(compressed.size()));
+  ASSERT_GT(compressed_size, 0);
+
+  std::vector<char> decompressed(src_size + 1);
+  ASSERT_EQ(src_size, lz4_decompress(compressed.data(), compressed_size, decompressed.data(), src_size));
+  ASSERT_EQ(0, memcmp(src.data(), decompressed.data(), src_size));
+
+  // 空间不够或者数据被截断时不能越界
+  if (src_size > 0) {
+    ASSERT_EQ(-1, lz4_decompress(compressed.data(), compressed_size, decompressed.data(), src_size - 1));
+  }
+  for (int len = 0; len < compressed_size; len += 5) {
+    lz4_decompress(compressed.data(), len, decompressed.data(), src_size);
+  }
+}
+
+TEST(test_lz4, test_lz4_round_trip)
+{
+  srand(1);
+  check_round_trip(std::vector<char>());
+
+  for (int size : {1, 12, 13, 100, 4096, BP_PAGE_SIZE, 60000}) {
+    std::vector<char> random_data(size);
+    std::vector<char> repeated_data(size);
+    std::vector<char> sparse_data(size, 0);
+    for (int i = 0; i < size; i++) {
+      random_data[i]   = static_cast<char>(rand());
+      repeated_data[i] = static_cast<char>("abcdefg"[i / 10 % 7]);
+      if (i % 37 == 0) {
+        sparse_data[i] = static_cast<char>(rand());
+      }
+    }
+    check_round_trip(random_data);
+    check_round_trip(repeated_data);
+    check_round_trip(sparse_data);
+  }
+
+  // 重复的数据压缩之后应该明显变小
+  std::vector<char> zeros(BP_PAGE_SIZE, 0);
+  std::vector<char> compressed(BP_PAGE_SIZE);
+  ASSERT_LT(lz4_compress(zeros.data(), BP_PAGE_SIZE, compressed.data(), BP_PAGE_SIZE), 100);
+
+  // 不可压缩的数据放不下时返回0
+  std::vector<char> random_data(BP_PAGE_SIZE);
+  for (char &c : random_data) {
+    c = static_cast<char>(rand());
+  }
+  ASSERT_EQ(0, lz4_compress(random_data.data(), BP_PAGE_SIZE, compressed.data(), BP_PAGE_SIZE / 2));
+}
+
+/**
+ * @brief 填充页面的数据，偶数页可以压缩，奇数页是随机数据
+ */
+static void fill_page(PageNum page_num, char *data)
+{
+  srand(page_num);
+  for (int i = 0; i < BP_PAGE_DATA_SIZE; i++) {
+    data[i] = (page_num % 2 == 0) ? static_cast<char>(page_num + i / 64) : static_cast<char>(rand());
+  }
+}
+
+TEST(test_page_compression, test_compressed_pages)
+{
+  const char *file_name = "page_compression.bp";
+  const int   page_num  = 20;
+  ::remove(file_name);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(file_name));
+
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+  bp->set_page_compression(true);
+
+  for (int i = 1; i <= page_num; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bp->allocate_page(&frame));
+    ASSERT_EQ(i, frame->page_num());
+    fill_page(i, frame->data());
+    frame->mark_dirty();
+    ASSERT_EQ(RC::SUCCESS, bp->unpin_page(frame));
+  }
+  ASSERT_EQ(RC::SUCCESS, bp->flush_all_pages());
+
+  // 只有偶数页压缩了，写入的数据量比原来少
+  const BPIoStats &write_stats = bp->io_stats();
+  ASSERT_GE(write_stats.compressed_write_count, page_num / 2);
+  ASSERT_LT(write_stats.write_bytes, static_cast<int64_t>(write_stats.write_count) * BP_PAGE_SIZE);
+  ASSERT_EQ(RC::SUCCESS, bpm.close_file(file_name));
+
+  // 文件长度仍然包括所有的页面，还可能有预分配的页面
+  struct stat st;
+  ASSERT_EQ(0, stat(file_name, &st));
+  ASSERT_LE(static_cast<int64_t>(page_num + 1) * BP_PAGE_SIZE, st.st_size);
+
+  // 开启和关闭压缩时都可以读取文件中压缩过的页面
+  for (bool compression : {true, false}) {
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(file_name, bp));
+    bp->set_page_compression(compression);
+    bp->reset_io_stats();
+
+    std::vector<char> expected(BP_PAGE_DATA_SIZE);
+    for (int i = 1; i <= page_num; i++) {
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, bp->get_this_page(i, &frame));
+      ASSERT_EQ(i, frame->page_num());
+      fill_page(i, expected.data());
+      ASSERT_EQ(0, memcmp(expected.data(), frame->data(), BP_PAGE_DATA_SIZE));
+      ASSERT_EQ(RC::SUCCESS, bp->unpin_page(frame));
+    }
+
+    const BPIoStats &read_stats = bp->io_stats();
+    ASSERT_EQ(page_num, read_stats.read_count);
+    if (compression) {
+      ASSERT_LT(read_stats.read_bytes, static_cast<int64_t>(page_num) * BP_PAGE_SIZE);
+    } else {
+      ASSERT_EQ(read_stats.read_bytes, static_cast<int64_t>(page_num) * BP_PAGE_SIZE);
+    }
+    ASSERT_EQ(RC::SUCCESS, bpm.close_file(file_name));
+  }
+
+  ::remove(file_name);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,556 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/worker_pool.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/aggr_physical_operator.h"
+#include "sql/operator/chunk_to_row_physical_operator.h"
+#include "sql/operator/gather_physical_operator.h"
+#include "sql/operator/hash_join_physical_operator.h"
+#include "sql/operator/morsel_queue.h"
+#include "sql/operator/parallel_hash_join_physical_operator.h"
+#include "sql/operator/table_scan_physical_operator.h"
+#include "sql/stmt/group_stmt.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/table/table.h"
+#include "storage/trx/vacuous_trx.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+TEST(test_morsel_queue, test_concurrent_next)
+{
+  for (int morsel_pages : {1, 3, 16}) {
+    const PageNum page_count = 1000;
+    MorselQueue   queue(page_count, morsel_pages);
+
+    // 每个线程记录自己领取到的页面，合起来每个页面只出现一次
+    vector<vector<PageNum>> thread_pages(4);
+    vector<thread>          threads;
+    for (vector<PageNum> &pages : thread_pages) {
+      threads.emplace_back([&queue, &pages]() {
+        PageNum begin = 0;
+        PageNum end   = 0;
+        while (queue.next(begin, end)) {
+          for (PageNum page = begin; page < end; page++) {
+            pages.push_back(page);
+          }
+        }
+      });
+    }
+    for (thread &t : threads) {
+      t.join();
+    }
+
+    vector<PageNum> all_pages;
+    for (const vector<PageNum> &pages : thread_pages) {
+      all_pages.insert(all_pages.end(), pages.begin(), pages.end());
+    }
+    std::sort(all_pages.begin(), all_pages.end());
+    ASSERT_EQ(static_cast<size_t>(page_count), all_pages.size());
+    for (PageNum page = 0; page < page_count; page++) {
+      ASSERT_EQ(page, all_pages[page]);
+    }
+
+    PageNum begin = 0;
+    PageNum end   = 0;
+    ASSERT_FALSE(queue.next(begin, end));
+  }
+}
+
+TEST(test_worker_pool, test_run)
+{
+  // 任务之间互相等待也不会死锁
+  atomic<int> arrived{0};
+  const int   task_num = 8;
+  RC rc = WorkerPool::instance().run(task_num, [&arrived](int) {
+    arrived++;
+    while (arrived.load() < task_num) {
+      this_thread::yield();
+    }
+    return RC::SUCCESS;
+  });
+  ASSERT_EQ(RC::SUCCESS, rc);
+  ASSERT_GE(WorkerPool::instance().thread_num(), task_num - 1);
+
+  rc = WorkerPool::instance().run(task_num, [](int i) { return i == 5 ? RC::INTERNAL : RC::SUCCESS; });
+  ASSERT_EQ(RC::INTERNAL, rc);
+}
+
+TEST(test_worker_pool, test_max_thread_num)
+{
+  // 线程个数达到上限后，还没有开始的任务由调用者执行，嵌套的 run 也不会死锁
+  WorkerPool  pool(2 /*max_thread_num*/);
+  atomic<int> count{0};
+  RC rc = pool.run(8, [&pool, &count](int) {
+    return pool.run(8, [&count](int) {
+      count++;
+      this_thread::sleep_for(chrono::milliseconds(1));
+      return RC::SUCCESS;
+    });
+  });
+  ASSERT_EQ(RC::SUCCESS, rc);
+  ASSERT_EQ(64, count.load());
+  ASSERT_LE(pool.thread_num(), 2);
+
+  // 提交的任务排队等待空闲的线程
+  mutex              lock;
+  condition_variable cond;
+  int                done = 0;
+  for (int i = 0; i < 8; i++) {
+    pool.submit([&]() {
+      lock_guard<mutex> guard(lock);
+      done++;
+      cond.notify_all();
+    });
+  }
+  unique_lock<mutex> guard(lock);
+  cond.wait(guard, [&done]() { return done == 8; });
+  ASSERT_LE(pool.thread_num(), 2);
+}
+
+TEST(test_worker_pool, test_idle_timeout)
+{
+  WorkerPool pool(WorkerPool::DEFAULT_MAX_THREAD_NUM, chrono::milliseconds(10) /*idle_timeout*/);
+  ASSERT_EQ(RC::SUCCESS, pool.run(4, [](int) {
+    this_thread::sleep_for(chrono::milliseconds(5));
+    return RC::SUCCESS;
+  }));
+  ASSERT_GT(pool.thread_num(), 0);
+
+  // 空闲的线程超时后退出
+  for (int i = 0; i < 1000 && pool.thread_num() > 0; i++) {
+    this_thread::sleep_for(chrono::milliseconds(10));
+  }
+  ASSERT_EQ(0, pool.thread_num());
+}
+
+/**
+ * @brief 表 t(id, g)，id 从 0 开始递增，g = id % GROUP_NUM。压缩表的数据相同，页面在磁盘上是压缩的
+ */
+class ParallelScanTest : public testing::Test
+{
+protected:
+  static constexpr int RECORD_NUM  = 20000;
+  static constexpr int GROUP_NUM   = 13;
+  static constexpr int MORSEL_PAGE = 2;
+
+  static void SetUpTestSuite()
+  {
+    BufferPoolManager::set_instance(&bpm_);
+    ASSERT_EQ(RC::SUCCESS, TrxKit::init_global("vacuous"));
+
+    TearDownTestSuite();
+    vector<AttrInfoSqlNode> attrs(2);
+    attrs[0] = AttrInfoSqlNode{INTS, "id", sizeof(int32_t), false};
+    attrs[1] = AttrInfoSqlNode{INTS, "g", sizeof(int32_t), false};
+    ASSERT_EQ(RC::SUCCESS, table_.create(1, "parallel_t.table", "parallel_t", ".", 2, attrs.data()));
+    ASSERT_EQ(RC::SUCCESS,
+        compressed_table_.create(
+            2, "parallel_c.table", "parallel_c", ".", 2, attrs.data(), StorageFormat::ROW, PageCompression::LZ4));
+
+    for (Table *table : {&table_, &compressed_table_}) {
+      for (int i = 0; i < RECORD_NUM; i++) {
+        Value  values[2] = {Value(i), Value(i % GROUP_NUM)};
+        Record record;
+        ASSERT_EQ(RC::SUCCESS, table->make_record(2, values, record));
+        ASSERT_EQ(RC::SUCCESS, table->insert_record(record));
+      }
+      ASSERT_GT(table->data_buffer_pool()->page_count(), 4 * MORSEL_PAGE);
+    }
+  }
+
+  static void TearDownTestSuite()
+  {
+    for (const char *name : {"parallel_t", "parallel_c"}) {
+      ::remove((string(name) + ".table").c_str());
+      ::remove((string(name) + ".data").c_str());
+    }
+  }
+
+  /**
+   * @brief 把表的数据页面都从内存中淘汰，之后的扫描都要从磁盘加载页面
+   * @details 每组的位图页面一直留在内存中，不能淘汰
+   */
+  static void evict_pages(Table &table)
+  {
+    DiskBufferPool *bp = table.data_buffer_pool();
+    for (PageNum page_num = 1; page_num < bp->page_count(); page_num++) {
+      if (page_num % BPFileHeader::GROUP_PAGE_NUM != 0) {
+        ASSERT_EQ(RC::SUCCESS, bp->purge_page(page_num));
+      }
+    }
+  }
+
+  /**
+   * @brief 创建 dop 个共享同一个 MorselQueue 的扫描算子
+   * @param filter 为 true 时只扫描 id <= max_id 的记录，并且只读取 id 列
+   */
+  static vector<unique_ptr<PhysicalOperator>> create_scans(
+      int dop, bool filter = false, int max_id = 0, Table &table = table_)
+  {
+    auto morsel_queue = make_shared<MorselQueue>(table.data_buffer_pool()->page_count(), MORSEL_PAGE);
+
+    vector<unique_ptr<PhysicalOperator>> scans;
+    for (int i = 0; i < dop; i++) {
+      auto scan_oper = make_unique<TableScanPhysicalOperator>(&table, true /*readonly*/);
+      if (filter) {
+        const Field id_field(&table, table.table_meta().field("id"));
+
+        vector<unique_ptr<Expression>> predicates;
+        predicates.emplace_back(new ComparisonExpr(
+            LESS_EQUAL, make_unique<FieldExpr>(id_field), make_unique<ValueExpr>(Value(max_id))));
+        scan_oper->set_predicates(std::move(predicates));
+        scan_oper->set_projection({id_field});
+      }
+      scan_oper->set_morsel_queue(morsel_queue);
+      scans.push_back(std::move(scan_oper));
+    }
+    return scans;
+  }
+
+  static vector<int> gather_ids(int dop, int limit, bool chunk)
+  {
+    GatherPhysicalOperator gather_oper;
+    gather_oper.set_limit(limit);
+    for (unique_ptr<PhysicalOperator> &scan_oper : create_scans(dop)) {
+      gather_oper.add_child(std::move(scan_oper));
+    }
+
+    VacuousTrx          trx;
+    const TupleCellSpec id_spec(table_.name(), "id");
+    vector<int>         ids;
+    EXPECT_EQ(RC::SUCCESS, gather_oper.open(&trx));
+    RC rc = RC::SUCCESS;
+    if (chunk) {
+      Chunk result;
+      while (RC::SUCCESS == (rc = gather_oper.next(result))) {
+        for (int i = 0; i < result.rows(); i++) {
+          ids.push_back(result.column(0).get_value(i).get_int());
+        }
+      }
+    } else {
+      while (RC::SUCCESS == (rc = gather_oper.next())) {
+        Value id;
+        EXPECT_EQ(RC::SUCCESS, gather_oper.current_tuple()->find_cell(id_spec, id));
+        ids.push_back(id.get_int());
+      }
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    EXPECT_EQ(RC::SUCCESS, gather_oper.close());
+    return ids;
+  }
+
+  /**
+   * @brief select g, count(id), sum(id), max(id) from t group by g
+   */
+  static map<int, vector<int>> aggregate(int dop, Table &table = table_)
+  {
+    const Field id_field(&table, table.table_meta().field("id"));
+    const Field g_field(&table, table.table_meta().field("g"));
+
+    GroupUnit group_unit;
+    group_unit.set_field(g_field);
+    vector<Expression *> aggr_exprs{new AggregationExpr(id_field, COUNT_AGGR_T),
+        new AggregationExpr(id_field, SUM_AGGR_T),
+        new AggregationExpr(id_field, MAX_AGGR_T)};
+    AggrPhysicalOperator aggr_oper(aggr_exprs, {g_field}, {&group_unit});
+    for (unique_ptr<PhysicalOperator> &scan_oper : create_scans(dop, false /*filter*/, 0 /*max_id*/, table)) {
+      aggr_oper.add_child(std::move(scan_oper));
+    }
+
+    VacuousTrx            trx;
+    map<int, vector<int>> groups;
+    EXPECT_EQ(RC::SUCCESS, aggr_oper.open(&trx));
+    RC rc = RC::SUCCESS;
+    while (RC::SUCCESS == (rc = aggr_oper.next())) {
+      Tuple      *tuple = aggr_oper.current_tuple();
+      vector<int> row;
+      for (int i = 0; i < tuple->cell_num(); i++) {
+        Value value;
+        EXPECT_EQ(RC::SUCCESS, tuple->cell_at(i, value));
+        row.push_back(value.get_int());
+      }
+      EXPECT_EQ(0, groups.count(row[0]));
+      groups[row[0]] = vector<int>(row.begin() + 1, row.end());
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    EXPECT_EQ(RC::SUCCESS, aggr_oper.close());
+    return groups;
+  }
+
+  /**
+   * @brief 批量执行 select count(id), sum(id) from t where id <= max_id
+   */
+  static vector<int> aggregate_chunks(int dop, int max_id)
+  {
+    const Field id_field(&table_, table_.table_meta().field("id"));
+
+    vector<Expression *> aggr_exprs{
+        new AggregationExpr(id_field, COUNT_AGGR_T), new AggregationExpr(id_field, SUM_AGGR_T)};
+    auto aggr_oper = make_unique<AggrPhysicalOperator>(aggr_exprs, vector<Field>(), vector<GroupUnit *>());
+    for (unique_ptr<PhysicalOperator> &scan_oper : create_scans(dop, true /*filter*/, max_id)) {
+      aggr_oper->add_child(std::move(scan_oper));
+    }
+    EXPECT_TRUE(aggr_oper->support_chunk());
+
+    ChunkToRowPhysicalOperator chunk_to_row_oper;
+    chunk_to_row_oper.add_child(std::move(aggr_oper));
+
+    VacuousTrx  trx;
+    vector<int> result;
+    EXPECT_EQ(RC::SUCCESS, chunk_to_row_oper.open(&trx));
+    RC rc = RC::SUCCESS;
+    while (RC::SUCCESS == (rc = chunk_to_row_oper.next())) {
+      Tuple *tuple = chunk_to_row_oper.current_tuple();
+      for (int i = 0; i < tuple->cell_num(); i++) {
+        Value value;
+        EXPECT_EQ(RC::SUCCESS, tuple->cell_at(i, value));
+        result.push_back(value.get_int());
+      }
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    EXPECT_EQ(RC::SUCCESS, chunk_to_row_oper.close());
+    return result;
+  }
+
+  /**
+   * @brief select b.id, p.id from t b, probe_table p where b.id = p.id(或者 p.g) and b.id <= max_id
+   * @details 构建端和探测端都按照 morsel 并行读取，探测端的各个流水线由 Gather 汇总
+   */
+  static vector<pair<int, int>> hash_join(int dop, bool join_group, int max_id, Table &probe_table = table_)
+  {
+    const Field id_field(&table_, table_.table_meta().field("id"));
+    const Field probe_id_field(&probe_table, probe_table.table_meta().field("id"));
+    const Field probe_g_field(&probe_table, probe_table.table_meta().field("g"));
+
+    vector<unique_ptr<Expression>> build_keys;
+    build_keys.emplace_back(new FieldExpr(id_field));
+    auto build = make_shared<ParallelHashJoinBuild>(std::move(build_keys), vector<Field>{id_field}, 1LL << 30);
+
+    vector<unique_ptr<PhysicalOperator>> build_scans = create_scans(dop, true /*filter*/, max_id);
+    vector<unique_ptr<PhysicalOperator>> probe_scans = create_scans(dop, false /*filter*/, 0 /*max_id*/, probe_table);
+
+    GatherPhysicalOperator gather_oper;
+    for (size_t i = 0; i < probe_scans.size(); i++) {
+      vector<unique_ptr<Expression>> probe_keys;
+      probe_keys.emplace_back(new FieldExpr(join_group ? probe_g_field : probe_id_field));
+      auto join_oper = make_unique<ParallelHashJoinPhysicalOperator>(std::move(probe_keys), build, true /*build_left*/);
+      join_oper->add_child(std::move(probe_scans[i]));
+      for (size_t j = 0; i == 0 && j < build_scans.size(); j++) {
+        join_oper->add_child(std::move(build_scans[j]));
+      }
+      gather_oper.add_child(std::move(join_oper));
+    }
+
+    VacuousTrx             trx;
+    vector<pair<int, int>> result;
+    EXPECT_EQ(RC::SUCCESS, gather_oper.open(&trx));
+    RC rc = RC::SUCCESS;
+    while (RC::SUCCESS == (rc = gather_oper.next())) {
+      Tuple *tuple = gather_oper.current_tuple();
+      Value  build_id;
+      Value  probe_id;
+      EXPECT_EQ(RC::SUCCESS, tuple->cell_at(0, build_id));
+      EXPECT_EQ(RC::SUCCESS, tuple->cell_at(1, probe_id));
+      result.emplace_back(build_id.get_int(), probe_id.get_int());
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    EXPECT_EQ(RC::SUCCESS, gather_oper.close());
+    EXPECT_EQ(min(max_id + 1, static_cast<int>(RECORD_NUM)), build->row_num());
+    EXPECT_EQ(dop, build->pipeline_num());
+    return result;
+  }
+
+  /**
+   * @brief 与 hash_join 相同的连接，使用串行的 HashJoinPhysicalOperator 执行，结果排好序
+   */
+  static vector<pair<int, int>> serial_hash_join(bool join_group, int max_id, Table &probe_table)
+  {
+    const Field id_field(&table_, table_.table_meta().field("id"));
+    const Field probe_id_field(&probe_table, probe_table.table_meta().field("id"));
+    const Field probe_g_field(&probe_table, probe_table.table_meta().field("g"));
+
+    vector<unique_ptr<Expression>> build_keys;
+    vector<unique_ptr<Expression>> probe_keys;
+    build_keys.emplace_back(new FieldExpr(id_field));
+    probe_keys.emplace_back(new FieldExpr(join_group ? probe_g_field : probe_id_field));
+    HashJoinPhysicalOperator join_oper(std::move(build_keys), std::move(probe_keys), {id_field},
+        {probe_id_field, probe_g_field}, true /*build_left*/, 1LL << 30);
+    join_oper.add_child(std::move(create_scans(1, true /*filter*/, max_id)[0]));
+    join_oper.add_child(std::move(create_scans(1, false /*filter*/, 0 /*max_id*/, probe_table)[0]));
+
+    const TupleCellSpec build_id_spec(table_.name(), "id");
+    const TupleCellSpec probe_id_spec(probe_table.name(), "id");
+
+    VacuousTrx             trx;
+    vector<pair<int, int>> result;
+    EXPECT_EQ(RC::SUCCESS, join_oper.open(&trx));
+    RC rc = RC::SUCCESS;
+    while (RC::SUCCESS == (rc = join_oper.next())) {
+      Tuple *tuple = join_oper.current_tuple();
+      Value  build_id;
+      Value  probe_id;
+      EXPECT_EQ(RC::SUCCESS, tuple->find_cell(build_id_spec, build_id));
+      EXPECT_EQ(RC::SUCCESS, tuple->find_cell(probe_id_spec, probe_id));
+      result.emplace_back(build_id.get_int(), probe_id.get_int());
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    EXPECT_EQ(RC::SUCCESS, join_oper.close());
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+protected:
+  static BufferPoolManager bpm_;
+  static Table             table_;
+  static Table             compressed_table_;
+};
+
+BufferPoolManager ParallelScanTest::bpm_{64};
+Table             ParallelScanTest::table_;
+Table             ParallelScanTest::compressed_table_;
+
+TEST_F(ParallelScanTest, test_gather)
+{
+  vector<int> expected(RECORD_NUM);
+  for (int i = 0; i < RECORD_NUM; i++) {
+    expected[i] = i;
+  }
+
+  for (int dop : {1, 2, 4, 7}) {
+    for (bool chunk : {false, true}) {
+      // 输出的顺序是不确定的
+      vector<int> ids = gather_ids(dop, -1 /*limit*/, chunk);
+      std::sort(ids.begin(), ids.end());
+      ASSERT_EQ(expected, ids) << "dop=" << dop << ", chunk=" << chunk;
+    }
+  }
+}
+
+TEST_F(ParallelScanTest, test_gather_limit)
+{
+  for (int limit : {0, 1, 100, RECORD_NUM, RECORD_NUM + 1}) {
+    vector<int> ids = gather_ids(4, limit, false /*chunk*/);
+    ASSERT_EQ(static_cast<size_t>(min(limit, RECORD_NUM)), ids.size());
+    std::sort(ids.begin(), ids.end());
+    ASSERT_TRUE(std::unique(ids.begin(), ids.end()) == ids.end());
+  }
+}
+
+TEST_F(ParallelScanTest, test_aggregate)
+{
+  map<int, vector<int>> expected;
+  for (int i = 0; i < RECORD_NUM; i++) {
+    vector<int> &group = expected[i % GROUP_NUM];
+    if (group.empty()) {
+      group = {0, 0, 0};
+    }
+    group[0]++;
+    group[1] += i;
+    group[2] = max(group[2], i);
+  }
+
+  for (int dop : {1, 2, 4, 7}) {
+    ASSERT_EQ(expected, aggregate(dop)) << "dop=" << dop;
+  }
+}
+
+TEST_F(ParallelScanTest, test_cold_cache)
+{
+  for (Table *table : {&table_, &compressed_table_}) {
+    evict_pages(*table);
+    const map<int, vector<int>> expected = aggregate(1, *table);
+    ASSERT_EQ(static_cast<size_t>(GROUP_NUM), expected.size());
+
+    // 页面都不在内存中，多个线程同时缺页，会同时加载相同或者不同的页面
+    for (int i = 0; i < 5; i++) {
+      for (int dop : {2, 4, 8}) {
+        evict_pages(*table);
+        ASSERT_EQ(expected, aggregate(dop, *table)) << "table=" << table->name() << ", dop=" << dop << ", round=" << i;
+      }
+    }
+  }
+}
+
+TEST_F(ParallelScanTest, test_aggregate_chunks)
+{
+  for (int max_id : {RECORD_NUM / 3, RECORD_NUM - 1}) {
+    const vector<int> expected{max_id + 1, max_id * (max_id + 1) / 2};
+    for (int dop : {1, 2, 4, 7}) {
+      ASSERT_EQ(expected, aggregate_chunks(dop, max_id)) << "dop=" << dop << ", max_id=" << max_id;
+    }
+  }
+
+  // 没有数据时不输出结果
+  ASSERT_TRUE(aggregate_chunks(4, -10).empty());
+}
+
+TEST_F(ParallelScanTest, test_hash_join)
+{
+  for (bool join_group : {false, true}) {
+    const int max_id = join_group ? GROUP_NUM / 2 : RECORD_NUM / 3;
+
+    vector<pair<int, int>> expected;
+    for (int i = 0; i < RECORD_NUM; i++) {
+      const int key = join_group ? i % GROUP_NUM : i;
+      if (key <= max_id) {
+        expected.emplace_back(key, i);
+      }
+    }
+    std::sort(expected.begin(), expected.end());
+
+    for (int dop : {1, 2, 4, 7}) {
+      vector<pair<int, int>> result = hash_join(dop, join_group, max_id);
+      std::sort(result.begin(), result.end());
+      ASSERT_EQ(expected, result) << "dop=" << dop << ", join_group=" << join_group;
+    }
+  }
+}
+
+TEST_F(ParallelScanTest, test_hash_join_cold_cache)
+{
+  // 构建端和探测端是两个文件，两边的线程同时缺页，还会淘汰对方文件的页面
+  for (bool join_group : {false, true}) {
+    const int max_id = join_group ? GROUP_NUM / 2 : RECORD_NUM / 3;
+
+    evict_pages(table_);
+    evict_pages(compressed_table_);
+    const vector<pair<int, int>> expected = serial_hash_join(join_group, max_id, compressed_table_);
+    ASSERT_FALSE(expected.empty());
+
+    for (int i = 0; i < 3; i++) {
+      for (int dop : {2, 4, 8}) {
+        evict_pages(table_);
+        evict_pages(compressed_table_);
+        vector<pair<int, int>> result = hash_join(dop, join_group, max_id, compressed_table_);
+        std::sort(result.begin(), result.end());
+        ASSERT_EQ(expected, result) << "dop=" << dop << ", join_group=" << join_group << ", round=" << i;
+      }
+    }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -13,11 +13,16 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include <string.h>
+#include <algorithm>
+#include <functional>
 #include <sstream>
+#include <string>
+#include <thread>
 
 #include "gtest/gtest.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/record/record_manager.h"
+#include "storage/record/overflow_file_handler.h"
 #include "storage/trx/vacuous_trx.h"
 
 using namespace common;
@@ -109,6 +114,109 @@ TEST(test_record_page_handler, test_record_page_handler)
   delete bpm;
 }
 
+TEST(test_record_page_handler, test_slotted_record_page)
+{
+  const char *record_manager_file = "record_manager.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool *bp = nullptr;
+  RC rc = bpm->create_file(record_manager_file);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  rc = bpm->open_file(record_manager_file, bp);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  Frame *frame = nullptr;
+  rc = bp->allocate_page(&frame);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  RecordPageHandler record_page_handle;
+  rc = record_page_handle.init_empty_page(*bp, frame->page_num(), 0, RecordPageFormat::SLOTTED);
+  ASSERT_EQ(rc, RC::SUCCESS);
+  ASSERT_TRUE(record_page_handle.is_slotted());
+
+  // 记录i的长度是 i % 50 + 1，内容都是字符 'a' + i % 26
+  auto make_data = [](int i, int len) { return std::string(len, static_cast<char>('a' + i % 26)); };
+  std::vector<RID>         rids;
+  std::vector<std::string> datas;
+  while (true) {
+    const int   i    = static_cast<int>(rids.size());
+    std::string data = make_data(i, i % 50 + 1);
+    RID         rid;
+    rc = record_page_handle.insert_record(data.data(), static_cast<int>(data.size()), &rid);
+    if (rc == RC::RECORD_NOMEM) {
+      break;
+    }
+    ASSERT_EQ(rc, RC::SUCCESS);
+    ASSERT_EQ(rid.slot_num, i);
+    rids.push_back(rid);
+    datas.push_back(data);
+  }
+  ASSERT_GT(rids.size(), 100);
+  ASSERT_FALSE(record_page_handle.has_space(100));
+
+  auto check_records = [&]() {
+    Record record;
+    for (size_t i = 0; i < rids.size(); i++) {
+      if (datas[i].empty()) {
+        ASSERT_EQ(record_page_handle.get_record(&rids[i], &record), RC::RECORD_NOT_EXIST);
+        continue;
+      }
+      ASSERT_EQ(record_page_handle.get_record(&rids[i], &record), RC::SUCCESS);
+      ASSERT_EQ(std::string(record.data(), record.len()), datas[i]);
+    }
+  };
+
+  // 删除一部分记录，空出来的槽位会被重用
+  for (size_t i = 1; i < rids.size(); i += 3) {
+    ASSERT_EQ(record_page_handle.delete_record(&rids[i]), RC::SUCCESS);
+    datas[i].clear();
+  }
+  check_records();
+
+  RID rid;
+  std::string data = make_data(0, 30);
+  ASSERT_EQ(record_page_handle.insert_record(data.data(), static_cast<int>(data.size()), &rid), RC::SUCCESS);
+  ASSERT_EQ(rid.slot_num, 1);
+  datas[1] = data;
+
+  // 记录变长时需要在页面内移动，空洞不连续时会整理页面，RID 保持不变
+  for (size_t i = 0; i < rids.size(); i += 3) {
+    data = make_data(static_cast<int>(i) + 1, 60);
+    rc = record_page_handle.update_record(rids[i], data.data(), static_cast<int>(data.size()));
+    if (rc == RC::RECORD_NOMEM) {
+      break;
+    }
+    ASSERT_EQ(rc, RC::SUCCESS);
+    datas[i] = data;
+  }
+  check_records();
+
+  // 变短之后再恢复原来的长度一定能成功
+  data = make_data(7, 1);
+  ASSERT_EQ(record_page_handle.update_record(rids[0], data.data(), 1), RC::SUCCESS);
+  data = make_data(8, 60);
+  ASSERT_EQ(record_page_handle.update_record(rids[0], data.data(), 60), RC::SUCCESS);
+  datas[0] = data;
+  check_records();
+
+  int count = 0;
+  RecordPageIterator iterator;
+  iterator.init(record_page_handle);
+  Record record;
+  while (iterator.has_next()) {
+    ASSERT_EQ(iterator.next(record), RC::SUCCESS);
+    ASSERT_EQ(std::string(record.data(), record.len()), datas[record.rid().slot_num]);
+    count++;
+  }
+  ASSERT_EQ(count, std::count_if(datas.begin(), datas.end(), [](const std::string &s) { return !s.empty(); }));
+
+  record_page_handle.cleanup();
+  bpm->close_file(record_manager_file);
+  delete bpm;
+}
+
 TEST(test_record_page_handler, test_record_file_iterator)
 {
   const char *record_manager_file = "record_manager.bp";
@@ -184,12 +292,346 @@ TEST(test_record_page_handler, test_record_file_iterator)
   delete bpm;
 }
 
+TEST(test_record_page_handler, test_pinned_record_cursor)
+{
+  const char *record_manager_file = "record_manager.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager bpm;
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(record_manager_file, bp));
+
+  RecordFileHandler file_handler;
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(bp));
+
+  const int record_insert_num = 1000;
+  char record_data[20];
+  for (int i = 0; i < record_insert_num; i++) {
+    memcpy(record_data, &i, sizeof(i));
+    RID rid;
+    ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(record_data, sizeof(record_data), &rid));
+  }
+
+  auto pin_count = [bp](PageNum page_num) {
+    Frame *frame = nullptr;
+    EXPECT_EQ(RC::SUCCESS, bp->get_this_page(page_num, &frame));
+    const int count = frame->pin_count() - 1;
+    bp->unpin_page(frame);
+    return count;
+  };
+
+  VacuousTrx trx;
+  RecordFileScanner file_scanner;
+  ASSERT_EQ(RC::SUCCESS, file_scanner.open_scan(nullptr/*table*/, *bp, &trx, true/*readonly*/, nullptr));
+
+  // 记录直接指向页面，扫描已经读到下一个页面时，上一条记录所在的页面仍然 pin 着
+  int     count     = 0;
+  int     page_num  = 0;
+  PageNum last_page = BP_INVALID_PAGE_NUM;
+  Record  record;
+  while (file_scanner.has_next()) {
+    ASSERT_EQ(RC::SUCCESS, file_scanner.next(record));
+    if (last_page != BP_INVALID_PAGE_NUM && record.rid().page_num != last_page) {
+      ASSERT_EQ(0, pin_count(last_page));
+      page_num++;
+    }
+    last_page = record.rid().page_num;
+    ASSERT_GE(pin_count(last_page), 1);
+
+    int value = -1;
+    memcpy(&value, record.data(), sizeof(value));
+    ASSERT_EQ(count, value);
+    count++;
+  }
+  ASSERT_EQ(record_insert_num, count);
+  ASSERT_GT(page_num, 0);
+
+  file_scanner.close_scan();
+  ASSERT_EQ(0, pin_count(last_page));
+
+  bpm.close_file(record_manager_file);
+}
+
+TEST(test_record_page_handler, test_pax_record_file)
+{
+  const char *record_manager_file = "record_manager.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool *bp = nullptr;
+  RC rc = bpm->create_file(record_manager_file);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  rc = bpm->open_file(record_manager_file, bp);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  // 记录由3列组成：int32 a | int64 b | int32 c
+  struct Row
+  {
+    int32_t a;
+    int64_t b;
+    int32_t c;
+  } __attribute__((packed));
+  const std::vector<PaxColumn> columns = {{0, 4, 0}, {4, 8, 0}, {12, 4, 0}};
+
+  RecordFileHandler file_handler;
+  rc = file_handler.init(bp, RecordPageFormat::PAX, columns);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  const int record_insert_num = 3000;
+  std::vector<RID> rids;
+  for (int i = 0; i < record_insert_num; i++) {
+    Row row{i, i * 10LL, -i};
+    RID rid;
+    rc = file_handler.insert_record(reinterpret_cast<const char *>(&row), sizeof(row), &rid);
+    ASSERT_EQ(rc, RC::SUCCESS);
+    rids.push_back(rid);
+  }
+  ASSERT_GT(rids.back().page_num, rids.front().page_num);
+
+  VacuousTrx trx;
+  RecordFileScanner file_scanner;
+  auto scan = [&](const std::vector<int> &projection, std::function<void(const Row &)> checker) {
+    file_scanner.set_projection(projection);
+    ASSERT_EQ(file_scanner.open_scan(nullptr/*table*/, *bp, &trx, true/*readonly*/, nullptr), RC::SUCCESS);
+    Record record;
+    int last_a = -1;
+    while (file_scanner.has_next()) {
+      ASSERT_EQ(file_scanner.next(record), RC::SUCCESS);
+      ASSERT_EQ(record.len(), static_cast<int>(sizeof(Row)));
+      const Row &row = *reinterpret_cast<const Row *>(record.data());
+      checker(row);
+
+      // 记录是按照插入的顺序读出来的。扫描器预读下一条记录时不能覆盖返回的记录
+      ASSERT_GT(row.a, last_a);
+      last_a = row.a;
+    }
+    file_scanner.close_scan();
+  };
+
+  int count = 0;
+  scan({}, [&count](const Row &row) {
+    ASSERT_EQ(row.b, row.a * 10LL);
+    ASSERT_EQ(row.c, -row.a);
+    count++;
+  });
+  ASSERT_EQ(count, record_insert_num);
+
+  // 只读取第0列和第2列，第1列没有读取
+  count = 0;
+  scan({0, 2}, [&count](const Row &row) {
+    ASSERT_EQ(row.b, 0);
+    ASSERT_EQ(row.c, -row.a);
+    count++;
+  });
+  ASSERT_EQ(count, record_insert_num);
+
+  // 修改和删除之后重新读取
+  for (int i = 0; i < record_insert_num; i += 2) {
+    ASSERT_EQ(file_handler.delete_record(&rids[i]), RC::SUCCESS);
+  }
+  Row row{1, 1, 1};
+  ASSERT_EQ(file_handler.update_record(rids[1], reinterpret_cast<const char *>(&row), sizeof(row)), RC::SUCCESS);
+  ASSERT_EQ(file_handler.visit_record(rids[3], false /*readonly*/,
+                                      [](Record &record) { reinterpret_cast<Row *>(record.data())->b = 3; }),
+            RC::SUCCESS);
+
+  count = 0;
+  scan({}, [&count](const Row &row) {
+    ASSERT_EQ(row.a % 2, 1);
+    if (row.a == 1 || row.a == 3) {
+      ASSERT_EQ(row.b, row.a);
+    } else {
+      ASSERT_EQ(row.b, row.a * 10LL);
+    }
+    count++;
+  });
+  ASSERT_EQ(count, record_insert_num / 2);
+
+  // 删除记录空出来的位置会被重用
+  RID rid;
+  ASSERT_EQ(file_handler.insert_record(reinterpret_cast<const char *>(&row), sizeof(row), &rid), RC::SUCCESS);
+  ASSERT_EQ(std::count(rids.begin(), rids.end(), rid), 1);
+
+  file_handler.close();
+  bpm->close_file(record_manager_file);
+  delete bpm;
+}
+
+TEST(test_record_page_handler, test_visit_record_after_flush)
+{
+  const char *record_manager_file = "record_manager.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool *bp = nullptr;
+  RC rc = bpm->create_file(record_manager_file);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  rc = bpm->open_file(record_manager_file, bp);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  RecordFileHandler file_handler;
+  rc = file_handler.init(bp);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  int32_t value = 1;
+  RID rid;
+  ASSERT_EQ(file_handler.insert_record(reinterpret_cast<const char *>(&value), sizeof(value), &rid), RC::SUCCESS);
+
+  // 页面已经刷过盘，之后直接修改页面中的数据，淘汰页面时也要写回
+  ASSERT_EQ(bp->flush_all_pages(), RC::SUCCESS);
+  ASSERT_EQ(file_handler.visit_record(rid, false /*readonly*/,
+                                      [](Record &record) { *reinterpret_cast<int32_t *>(record.data()) = 2; }),
+            RC::SUCCESS);
+  ASSERT_EQ(bp->purge_all_pages(), RC::SUCCESS);
+
+  value = 0;
+  ASSERT_EQ(file_handler.visit_record(rid, true /*readonly*/,
+                                      [&value](Record &record) { value = *reinterpret_cast<int32_t *>(record.data()); }),
+            RC::SUCCESS);
+  ASSERT_EQ(value, 2);
+
+  file_handler.close();
+  bpm->close_file(record_manager_file);
+  delete bpm;
+}
+
+TEST(test_record_page_handler, test_free_space_map)
+{
+  const char *record_manager_file = "record_manager.bp";
+  ::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(record_manager_file, bp));
+
+  // 并发插入时每个线程领取不同的页面，所有记录都能插入，并且不会重复
+  // 页面锁和空闲空间表的锁在 CONCURRENCY 模式下才生效，否则只用一个线程
+#ifdef CONCURRENCY
+  const int thread_num = 8;
+#else
+  const int thread_num = 1;
+#endif
+  const int record_num = 2000;
+  std::vector<std::vector<RID>> thread_rids(thread_num);
+  {
+    RecordFileHandler file_handler;
+    ASSERT_EQ(RC::SUCCESS, file_handler.init(bp));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_num; t++) {
+      threads.emplace_back([&file_handler, &thread_rids, t]() {
+        char record_data[40];
+        for (int i = 0; i < record_num; i++) {
+          snprintf(record_data, sizeof(record_data), "%d-%d", t, i);
+          RID rid;
+          ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(record_data, sizeof(record_data), &rid));
+          thread_rids[t].push_back(rid);
+        }
+      });
+    }
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+    file_handler.close();
+  }
+
+  std::vector<RID> all_rids;
+  for (const std::vector<RID> &rids : thread_rids) {
+    all_rids.insert(all_rids.end(), rids.begin(), rids.end());
+  }
+  std::sort(all_rids.begin(), all_rids.end(), [](const RID &a, const RID &b) { return RID::compare(&a, &b) < 0; });
+  ASSERT_EQ(all_rids.end(), std::adjacent_find(all_rids.begin(), all_rids.end()));
+  ASSERT_EQ(static_cast<size_t>(thread_num * record_num), all_rids.size());
+
+  // 重新打开时不遍历文件，插入时才检查已有的页面，删除记录后页面可以再次使用
+  RecordFileHandler file_handler;
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(bp));
+  ASSERT_EQ(0, file_handler.free_space_map().free_page_num());
+
+  const RID deleted_rid = all_rids[all_rids.size() / 2];
+  ASSERT_EQ(RC::SUCCESS, file_handler.delete_record(&deleted_rid));
+  ASSERT_EQ(1, file_handler.free_space_map().free_page_num());
+
+  char record_data[40] = "reinsert";
+  RID  rid;
+  ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(record_data, sizeof(record_data), &rid));
+  ASSERT_EQ(deleted_rid.page_num, rid.page_num);
+
+  file_handler.close();
+  bpm->close_file(record_manager_file);
+  delete bpm;
+}
+
+TEST(test_record_page_handler, test_overflow_file_handler)
+{
+  const char *overflow_file = "overflow.bp";
+  ::remove(overflow_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  DiskBufferPool *bp = nullptr;
+  RC rc = bpm->create_file(overflow_file);
+  ASSERT_EQ(rc, RC::SUCCESS);
+  rc = bpm->open_file(overflow_file, bp);
+  ASSERT_EQ(rc, RC::SUCCESS);
+
+  OverflowFileHandler handler;
+  ASSERT_EQ(RC::SUCCESS, handler.init(bp));
+
+  // 空数据不占用页面，正好一页、跨多页的数据都可以完整读回来
+  const std::vector<int> lengths = {0, 10, OverflowFileHandler::PAGE_DATA_CAPACITY, 30000};
+  std::vector<std::string> datas;
+  std::vector<PageNum> first_pages;
+  for (size_t i = 0; i < lengths.size(); i++) {
+    std::string data(lengths[i], ' ');
+    for (int j = 0; j < lengths[i]; j++) {
+      data[j] = 'a' + (i + j) % 26;
+    }
+
+    PageNum first_page = BP_INVALID_PAGE_NUM;
+    ASSERT_EQ(RC::SUCCESS, handler.insert(data.data(), static_cast<int>(data.size()), first_page));
+    ASSERT_EQ(data.empty(), first_page == BP_INVALID_PAGE_NUM);
+    datas.push_back(data);
+    first_pages.push_back(first_page);
+  }
+
+  for (size_t i = 0; i < datas.size(); i++) {
+    std::string data;
+    ASSERT_EQ(RC::SUCCESS, handler.read(first_pages[i], static_cast<int>(datas[i].size()), data));
+    ASSERT_EQ(datas[i], data);
+  }
+
+  // 释放的页面可以被新的数据重用
+  ASSERT_EQ(RC::SUCCESS, handler.remove(first_pages[3]));
+  PageNum first_page = BP_INVALID_PAGE_NUM;
+  ASSERT_EQ(RC::SUCCESS, handler.insert(datas[3].data(), static_cast<int>(datas[3].size()), first_page));
+  ASSERT_LE(first_page, first_pages[3] + 30000 / OverflowFileHandler::PAGE_DATA_CAPACITY);
+  std::string data;
+  ASSERT_EQ(RC::SUCCESS, handler.read(first_page, static_cast<int>(datas[3].size()), data));
+  ASSERT_EQ(datas[3], data);
+  ASSERT_EQ(RC::SUCCESS, handler.read(first_pages[2], static_cast<int>(datas[2].size()), data));
+  ASSERT_EQ(datas[2], data);
+
+  handler.close();
+  bpm->close_file(overflow_file);
+  delete bpm;
+}
+
 int main(int argc, char **argv)
 {
   // 分析gtest程序的命令行参数
   testing::InitGoogleTest(&argc, argv);
 
   // 调用RUN_ALL_TESTS()运行所有测试用例
+  int result = RUN_ALL_TESTS();
+
+  // 测试用例失败时可能没有走到最后，统一删除测试用例创建的文件，不留在当前目录中
+  ::remove("record_manager.bp");
+  ::remove("overflow.bp");
+
   // main函数返回RUN_ALL_TESTS()的运行结果
-  return RUN_ALL_TESTS();
+  return result;
 }
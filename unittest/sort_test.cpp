@@ -0,0 +1,279 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "sql/operator/order_physical_operator.h"
+#include "sql/operator/sort_key.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+/**
+ * @brief NULL 最小，其它按照 Value::compare 比较
+ */
+static int compare_value(const Value &left, const Value &right)
+{
+  if (left.attr_type() == NULLS || right.attr_type() == NULLS) {
+    return (left.attr_type() == NULLS ? 0 : 1) - (right.attr_type() == NULLS ? 0 : 1);
+  }
+  const int result = left.compare(right);
+  return result < 0 ? -1 : (result > 0 ? 1 : 0);
+}
+
+static int compare_key(const vector<Value> &left, const vector<Value> &right, const vector<bool> &descs)
+{
+  string left_key;
+  string right_key;
+  for (size_t i = 0; i < left.size(); i++) {
+    SortKey::append(left[i], descs[i], left_key);
+    SortKey::append(right[i], descs[i], right_key);
+  }
+
+  const int result = SortKey::compare(left_key.data(), left_key.size(), right_key.data(), right_key.size());
+  const uint64_t left_prefix  = SortKey::prefix(left_key.data(), left_key.size());
+  const uint64_t right_prefix = SortKey::prefix(right_key.data(), right_key.size());
+  if (left_prefix != right_prefix) {
+    EXPECT_EQ(left_prefix < right_prefix, result < 0);
+  }
+  return result < 0 ? -1 : (result > 0 ? 1 : 0);
+}
+
+static Value random_value(AttrType type)
+{
+  if (rand() % 10 == 0) {
+    return Value(NULLS);
+  }
+
+  switch (type) {
+    case INTS: return Value(rand() % 2000 - 1000 + (rand() % 50 == 0 ? 2000000000 : 0));
+    case FLOATS: return Value(static_cast<float>(rand() % 2000 - 1000) / 4);
+    case DATES: {
+      Value value;
+      value.set_date(static_cast<date>(19700101 + rand() % 500000));
+      return value;
+    }
+    default: {
+      static const char *strings[] = {"", "a", "ab", "abc", "b", "ba", "z", "zz"};
+      return Value(strings[rand() % (sizeof(strings) / sizeof(strings[0]))]);
+    }
+  }
+}
+
+TEST(test_sort_key, test_single_column)
+{
+  srand(1);
+  for (AttrType type : {INTS, FLOATS, DATES, CHARS}) {
+    for (int i = 0; i < 5000; i++) {
+      const Value left  = random_value(type);
+      const Value right = random_value(type);
+      const int   expected = compare_value(left, right);
+      ASSERT_EQ(expected, compare_key({left}, {right}, {false})) << left.to_string() << ", " << right.to_string();
+      ASSERT_EQ(-expected, compare_key({left}, {right}, {true})) << left.to_string() << ", " << right.to_string();
+    }
+  }
+
+  // 0 和 -0 相等，负数之间按照绝对值反向排列
+  ASSERT_EQ(0, compare_key({Value(0.0f)}, {Value(-0.0f)}, {false}));
+  ASSERT_EQ(-1, compare_key({Value(-2.5f)}, {Value(-1.5f)}, {false}));
+  ASSERT_EQ(-1, compare_key({Value(-2147483647 - 1)}, {Value(2147483647)}, {false}));
+  ASSERT_EQ(-1, compare_key({Value(false)}, {Value(true)}, {false}));
+}
+
+TEST(test_sort_key, test_multiple_columns)
+{
+  srand(2);
+  const vector<bool> descs = {false, true, false};
+  for (int i = 0; i < 20000; i++) {
+    // 第一列是字符串，前缀相同的字符串不能影响后面的列
+    const vector<Value> left  = {random_value(CHARS), random_value(INTS), random_value(FLOATS)};
+    const vector<Value> right = {random_value(CHARS), random_value(INTS), random_value(FLOATS)};
+
+    int expected = 0;
+    for (size_t j = 0; j < left.size() && expected == 0; j++) {
+      expected = compare_value(left[j], right[j]);
+      if (descs[j]) {
+        expected = -expected;
+      }
+    }
+    ASSERT_EQ(expected, compare_key(left, right, descs));
+  }
+}
+
+/**
+ * @brief 按顺序输出给定的行
+ */
+class RowsPhysicalOperator : public PhysicalOperator
+{
+public:
+  RowsPhysicalOperator(const Table &table, const vector<vector<Value>> &rows) : rows_(rows)
+  {
+    auto             speces     = make_shared<vector<TupleCellSpec>>();
+    const TableMeta &table_meta = table.table_meta();
+    for (int i = table_meta.sys_field_num(); i < table_meta.field_num(); i++) {
+      speces->emplace_back(table.name(), table_meta.field(i)->name(), table_meta.field(i)->name());
+    }
+    speces_ = speces;
+  }
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::STRING_LIST; }
+
+  RC open(Trx *) override
+  {
+    index_ = -1;
+    return RC::SUCCESS;
+  }
+  RC next() override
+  {
+    if (++index_ >= static_cast<int>(rows_.size())) {
+      return RC::RECORD_EOF;
+    }
+    tuple_.set_values(speces_, rows_[index_]);
+    return RC::SUCCESS;
+  }
+  RC     close() override { return RC::SUCCESS; }
+  Tuple *current_tuple() override { return &tuple_; }
+
+private:
+  vector<vector<Value>>                   rows_;
+  shared_ptr<const vector<TupleCellSpec>> speces_;
+  int                                     index_ = -1;
+  ChunkTuple                              tuple_;
+};
+
+class OrderTest : public testing::Test
+{
+protected:
+  static void SetUpTestSuite()
+  {
+    BufferPoolManager::set_instance(&bpm_);
+    ASSERT_EQ(RC::SUCCESS, TrxKit::init_global("vacuous"));
+
+    ::remove("order_t.table");
+    ::remove("order_t.data");
+    vector<AttrInfoSqlNode> attrs(3);
+    attrs[0] = AttrInfoSqlNode{INTS, "id", sizeof(int32_t), false};
+    attrs[1] = AttrInfoSqlNode{INTS, "k", sizeof(int32_t), true};
+    attrs[2] = AttrInfoSqlNode{CHARS, "s", 8, true};
+    ASSERT_EQ(RC::SUCCESS, table_.create(1, "order_t.table", "order_t", ".", 3, attrs.data()));
+
+    // 按照 k 降序、s 升序排列
+    k_order_.set_type(DESC);
+    k_order_.set_field(Field(&table_, table_.table_meta().field("k")));
+    s_order_.set_type(ASC);
+    s_order_.set_field(Field(&table_, table_.table_meta().field("s")));
+  }
+
+  static void TearDownTestSuite()
+  {
+    ::remove("order_t.table");
+    ::remove("order_t.data");
+  }
+
+  static vector<vector<Value>> make_rows(int row_num)
+  {
+    srand(3);
+    vector<vector<Value>> rows;
+    for (int i = 0; i < row_num; i++) {
+      rows.push_back({Value(i), random_value(INTS), random_value(CHARS)});
+    }
+    return rows;
+  }
+
+  /**
+   * @brief 排序后每行的 id，排序键相同的行保持原来的顺序
+   */
+  static vector<int> expected_ids(vector<vector<Value>> rows, int limit)
+  {
+    std::stable_sort(rows.begin(), rows.end(), [](const vector<Value> &left, const vector<Value> &right) {
+      const int result = compare_value(right[1], left[1]);
+      return result < 0 || (result == 0 && compare_value(left[2], right[2]) < 0);
+    });
+
+    vector<int> ids;
+    for (const vector<Value> &row : rows) {
+      if (limit >= 0 && static_cast<int>(ids.size()) >= limit) {
+        break;
+      }
+      ids.push_back(row[0].get_int());
+    }
+    return ids;
+  }
+
+  static vector<int> sort(const vector<vector<Value>> &rows, int limit, int64_t memory_limit)
+  {
+    OrderPhysicalOperator order_oper({&k_order_, &s_order_}, limit, memory_limit);
+    order_oper.add_child(make_unique<RowsPhysicalOperator>(table_, rows));
+
+    const TupleCellSpec id_spec(table_.name(), "id");
+    vector<int>         ids;
+    EXPECT_EQ(RC::SUCCESS, order_oper.open(nullptr));
+    RC rc = RC::SUCCESS;
+    while (RC::SUCCESS == (rc = order_oper.next())) {
+      Value id;
+      EXPECT_EQ(RC::SUCCESS, order_oper.current_tuple()->find_cell(id_spec, id));
+      ids.push_back(id.get_int());
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    EXPECT_EQ(RC::SUCCESS, order_oper.close());
+    return ids;
+  }
+
+protected:
+  static BufferPoolManager bpm_;
+  static Table             table_;
+  static OrderUnit         k_order_;
+  static OrderUnit         s_order_;
+};
+
+BufferPoolManager OrderTest::bpm_{16};
+Table             OrderTest::table_;
+OrderUnit         OrderTest::k_order_;
+OrderUnit         OrderTest::s_order_;
+
+TEST_F(OrderTest, test_in_memory)
+{
+  const vector<vector<Value>> rows = make_rows(5000);
+  ASSERT_EQ(expected_ids(rows, -1), sort(rows, -1, 64 * 1024 * 1024));
+  ASSERT_TRUE(sort({}, -1, 64 * 1024 * 1024).empty());
+}
+
+TEST_F(OrderTest, test_spill)
+{
+  // 每个文件只有几十行，文件个数超过一次归并的个数，需要多次归并
+  const vector<vector<Value>> rows = make_rows(10000);
+  ASSERT_EQ(expected_ids(rows, -1), sort(rows, -1, 8 * 1024));
+  ASSERT_EQ(expected_ids(rows, 100), sort(rows, 100, 8 * 1024));
+}
+
+TEST_F(OrderTest, test_limit)
+{
+  const vector<vector<Value>> rows = make_rows(5000);
+  for (int limit : {0, 1, 10, 4999, 5000, 10000}) {
+    ASSERT_EQ(expected_ids(rows, limit), sort(rows, limit, 64 * 1024 * 1024));
+  }
+
+  // 保留的行超过内存限制时改为全部排序
+  ASSERT_EQ(expected_ids(rows, 3000), sort(rows, 3000, 64 * 1024));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,180 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stddef.h>
+#include <string.h>
+#include <vector>
+
+#include "storage/record/zone_map.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+/**
+ * @brief 测试用的记录: 一个整数字段、一个浮点数字段和一个字节的 NULL 位图
+ */
+struct TestRecord
+{
+  int   id;
+  float score;
+  char  null_bitmap;
+};
+
+static const int ID_INDEX    = 1;
+static const int SCORE_INDEX = 2;
+
+static void init_zone_map(ZoneMap &zone_map)
+{
+  vector<ZoneColumn> columns{
+      ZoneColumn{ID_INDEX, INTS, static_cast<int>(offsetof(TestRecord, id))},
+      ZoneColumn{SCORE_INDEX, FLOATS, static_cast<int>(offsetof(TestRecord, score))},
+  };
+  zone_map.init(columns, static_cast<int>(offsetof(TestRecord, null_bitmap)));
+}
+
+static TestRecord make_record(int id, float score, bool score_null = false)
+{
+  TestRecord record;
+  memset(&record, 0, sizeof(record));
+  record.id    = id;
+  record.score = score;
+  if (score_null) {
+    record.null_bitmap |= 1 << SCORE_INDEX;
+  }
+  return record;
+}
+
+static bool can_skip(ZoneMap &zone_map, PageNum page_num, int field_index, CompOp op, const Value &value)
+{
+  return zone_map.can_skip(page_num, vector<ZoneFilter>{ZoneFilter{field_index, op, value}});
+}
+
+TEST(test_zone_map, test_comparison)
+{
+  ZoneMap zone_map;
+  init_zone_map(zone_map);
+
+  // 页面 1 上的 id 在 [10, 20] 之间
+  zone_map.init_page(1);
+  for (int id = 10; id <= 20; id++) {
+    TestRecord record = make_record(id, id * 1.5f);
+    zone_map.update(1, reinterpret_cast<const char *>(&record));
+  }
+
+  ASSERT_TRUE(can_skip(zone_map, 1, ID_INDEX, EQUAL_TO, Value(9)));
+  ASSERT_FALSE(can_skip(zone_map, 1, ID_INDEX, EQUAL_TO, Value(10)));
+  ASSERT_FALSE(can_skip(zone_map, 1, ID_INDEX, EQUAL_TO, Value(20)));
+  ASSERT_TRUE(can_skip(zone_map, 1, ID_INDEX, EQUAL_TO, Value(21)));
+
+  ASSERT_TRUE(can_skip(zone_map, 1, ID_INDEX, LESS_THAN, Value(10)));
+  ASSERT_FALSE(can_skip(zone_map, 1, ID_INDEX, LESS_EQUAL, Value(10)));
+  ASSERT_TRUE(can_skip(zone_map, 1, ID_INDEX, LESS_EQUAL, Value(9)));
+  ASSERT_TRUE(can_skip(zone_map, 1, ID_INDEX, GREAT_THAN, Value(20)));
+  ASSERT_FALSE(can_skip(zone_map, 1, ID_INDEX, GREAT_EQUAL, Value(20)));
+  ASSERT_TRUE(can_skip(zone_map, 1, ID_INDEX, GREAT_EQUAL, Value(21)));
+  ASSERT_FALSE(can_skip(zone_map, 1, ID_INDEX, NOT_EQUAL, Value(15)));
+
+  // 整数和浮点数可以相互比较
+  ASSERT_TRUE(can_skip(zone_map, 1, ID_INDEX, GREAT_THAN, Value(20.5f)));
+  ASSERT_FALSE(can_skip(zone_map, 1, ID_INDEX, GREAT_THAN, Value(19.5f)));
+  ASSERT_TRUE(can_skip(zone_map, 1, SCORE_INDEX, LESS_THAN, Value(15)));
+
+  // 不能比较的类型和没有区间信息的字段、页面都不能跳过
+  ASSERT_FALSE(can_skip(zone_map, 1, ID_INDEX, EQUAL_TO, Value("abc")));
+  ASSERT_FALSE(can_skip(zone_map, 1, 0, EQUAL_TO, Value(100)));
+  ASSERT_FALSE(can_skip(zone_map, 2, ID_INDEX, EQUAL_TO, Value(100)));
+
+  // 多个条件是 AND 的关系，有一个条件不满足就可以跳过
+  vector<ZoneFilter> filters{
+      ZoneFilter{ID_INDEX, GREAT_THAN, Value(12)},
+      ZoneFilter{SCORE_INDEX, GREAT_THAN, Value(100.0f)},
+  };
+  ASSERT_TRUE(zone_map.can_skip(1, filters));
+  filters.pop_back();
+  ASSERT_FALSE(zone_map.can_skip(1, filters));
+
+  // 区间只会扩大
+  TestRecord record = make_record(100, 0);
+  zone_map.update(1, reinterpret_cast<const char *>(&record));
+  ASSERT_FALSE(can_skip(zone_map, 1, ID_INDEX, EQUAL_TO, Value(100)));
+  ASSERT_FALSE(can_skip(zone_map, 1, ID_INDEX, EQUAL_TO, Value(10)));
+  zone_map.touch(1);
+  ASSERT_FALSE(can_skip(zone_map, 1, ID_INDEX, EQUAL_TO, Value(100)));
+
+  ASSERT_EQ(1, zone_map.zoned_page_num());
+  ASSERT_EQ(1, zone_map.prunable_page_num(vector<ZoneFilter>{ZoneFilter{ID_INDEX, GREAT_THAN, Value(100)}}));
+}
+
+TEST(test_zone_map, test_null)
+{
+  ZoneMap zone_map;
+  init_zone_map(zone_map);
+
+  Value null_value(NULLS);
+
+  // 空页面上任何条件都不成立
+  zone_map.init_page(1);
+  ASSERT_TRUE(can_skip(zone_map, 1, SCORE_INDEX, IS, null_value));
+  ASSERT_TRUE(can_skip(zone_map, 1, SCORE_INDEX, IS_NOT, null_value));
+  ASSERT_TRUE(can_skip(zone_map, 1, SCORE_INDEX, NOT_EQUAL, Value(1.0f)));
+
+  // 只有 NULL 的页面
+  TestRecord record = make_record(1, 0, true /*score_null*/);
+  zone_map.update(1, reinterpret_cast<const char *>(&record));
+  ASSERT_FALSE(can_skip(zone_map, 1, SCORE_INDEX, IS, null_value));
+  ASSERT_TRUE(can_skip(zone_map, 1, SCORE_INDEX, IS_NOT, null_value));
+  ASSERT_TRUE(can_skip(zone_map, 1, SCORE_INDEX, LESS_THAN, Value(100.0f)));
+  ASSERT_TRUE(can_skip(zone_map, 1, ID_INDEX, IS, null_value));
+
+  record = make_record(2, 3.0f);
+  zone_map.update(1, reinterpret_cast<const char *>(&record));
+  ASSERT_FALSE(can_skip(zone_map, 1, SCORE_INDEX, IS, null_value));
+  ASSERT_FALSE(can_skip(zone_map, 1, SCORE_INDEX, IS_NOT, null_value));
+  ASSERT_FALSE(can_skip(zone_map, 1, SCORE_INDEX, EQUAL_TO, Value(3.0f)));
+}
+
+TEST(test_zone_map, test_build)
+{
+  ZoneMap zone_map;
+  init_zone_map(zone_map);
+
+  // 打开文件时已经存在的页面，第一次扫描时构建区间
+  ASSERT_TRUE(zone_map.need_build(1));
+  ZoneMap::PageZone zone = zone_map.new_zone();
+  for (int id = 0; id < 10; id++) {
+    TestRecord record = make_record(id, 0);
+    zone_map.add_record(zone, reinterpret_cast<const char *>(&record));
+  }
+  zone_map.build(1, std::move(zone));
+  ASSERT_FALSE(zone_map.need_build(1));
+  ASSERT_TRUE(can_skip(zone_map, 1, ID_INDEX, EQUAL_TO, Value(10)));
+
+  // 构建之前修改过的页面可能有旧版本不在页面上，不能再构建
+  TestRecord record = make_record(5, 0);
+  zone_map.update(2, reinterpret_cast<const char *>(&record));
+  ASSERT_FALSE(zone_map.need_build(2));
+  zone_map.touch(3);
+  ASSERT_FALSE(zone_map.need_build(3));
+  zone_map.build(3, zone_map.new_zone());
+  ASSERT_FALSE(can_skip(zone_map, 3, ID_INDEX, EQUAL_TO, Value(10)));
+  ASSERT_EQ(1, zone_map.zoned_page_num());
+
+  // 清理之后所有的页面都可以重新构建
+  zone_map.clear();
+  ASSERT_TRUE(zone_map.need_build(1));
+  ASSERT_TRUE(zone_map.need_build(2));
+  ASSERT_EQ(0, zone_map.zoned_page_num());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}